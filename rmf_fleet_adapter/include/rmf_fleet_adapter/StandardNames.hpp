@@ -40,6 +40,7 @@ const std::string DoorSupervisorHeartbeatTopicName =
 const std::string FinalLiftRequestTopicName = "lift_requests";
 const std::string AdapterLiftRequestTopicName = "adapter_lift_requests";
 const std::string LiftStateTopicName = "lift_states";
+const std::string LiftWaitEstimatesTopicName = "lift_wait_estimates";
 
 const std::string DispenserRequestTopicName = "dispenser_requests";
 const std::string DispenserResultTopicName = "dispenser_results";
@@ -65,6 +66,7 @@ const std::string LaneClosureRequestTopicName = "lane_closure_requests";
 const std::string ClosedLaneTopicName = "closed_lanes";
 const std::string SpeedLimitRequestTopicName = "speed_limit_requests";
 const std::string LaneStatesTopicName = "lane_states";
+const std::string LaneStateChangesTopicName = "lane_state_changes";
 
 const std::string InterruptRequestTopicName = "robot_interrupt_request";
 
@@ -86,11 +88,19 @@ const std::string ReservationClaimTopicName = "rmf/reservations/claim";
 const std::string ReservationAllocationTopicName =
   "rmf/reservations/allocation";
 const std::string ReservationReleaseTopicName = "rmf/reservations/release";
+const std::string ReservationFreedSpotsTopicName =
+  "rmf/reservations/freed_parking_spots";
+const std::string ReservationTakenSpotsTopicName =
+  "rmf/reservations/taken_parking_spots";
 
 const std::string DynamicEventBeginTopicBase = "rmf/dynamic_event/begin";
 const std::string DynamicEventStatusTopicBase = "rmf/dynamic_event/status";
 const std::string DynamicEventActionName = "rmf/dynamic_event/command";
 
+/// Fleet adapters publish statistics_msgs/MetricsMessage about the jobs on
+/// their rxcpp workers to this topic when job_diagnostics_period is set
+const std::string JobDiagnosticsTopicName = "rmf/fleet_adapter/job_diagnostics";
+
 const uint64_t Unclaimed = (uint64_t)(-1);
 
 } // namespace rmf_fleet_adapter
@@ -53,6 +53,23 @@ public:
     const std::string& node_name,
     std::optional<rmf_traffic::Duration> discovery_timeout = std::nullopt);
 
+  /// Make an adapter instance that shares the rclcpp::Node of another adapter.
+  /// The new adapter uses the same schedule connection and the same
+  /// subscriptions to door, lift, dispenser, ingestor, mutex group, and
+  /// reservation topics, so each of those messages only gets deserialized once
+  /// no matter how many fleets are being adapted in the process. Fleets that
+  /// are added to the new adapter are kept separate from the fleets of the
+  /// other adapter.
+  ///
+  /// The node keeps spinning until every adapter that shares it has been
+  /// stopped.
+  ///
+  /// \param[in] other
+  ///   The adapter whose node will be shared. If this is a nullptr then a
+  ///   nullptr will be returned.
+  static std::shared_ptr<Adapter> make_sharing(
+    const std::shared_ptr<Adapter>& other);
+
   /// Make an adapter instance. This will instantiate an rclcpp::Node and allow
   /// you to add fleets to be adapted.
   ///
@@ -172,7 +189,8 @@ public:
   /// in another thread, so this function is non-blocking.
   Adapter& start();
 
-  /// Stop the event loop if it is running.
+  /// Stop the event loop if it is running. If other adapters share the node of
+  /// this adapter, the event loop keeps running until all of them have stopped.
   Adapter& stop();
 
   /// Wait until the adapter is done spinning.
@@ -67,6 +67,7 @@ public:
   // Nested class declarations
   class EasyRobotUpdateHandle;
   class RobotState;
+  class RobotStateUpdate;
   class RobotConfiguration;
   class RobotCallbacks;
   class Destination;
@@ -126,6 +127,17 @@ public:
     RobotConfiguration configuration,
     RobotCallbacks callbacks);
 
+  /// Update the states of many robots of this fleet at once. This gives the
+  /// same result as calling EasyRobotUpdateHandle::update for each of them,
+  /// but all of the updates are handled together in one job of the fleet
+  /// adapter instead of one job per robot, which saves a lot of scheduling
+  /// when a large fleet reports its states all at once.
+  ///
+  /// \param[in] updates
+  ///   The new state of each robot. Robots that do not belong to this fleet
+  ///   will be ignored.
+  void update_all(std::vector<RobotStateUpdate> updates);
+
   /// Get the FleetUpdateHandle that this adapter will be using.
   /// This may be used to perform more specialized customizations using the
   /// base FleetUpdateHandle API.
@@ -241,6 +253,39 @@ private:
   rmf_utils::impl_ptr<Implementation> _pimpl;
 };
 
+/// The state of one robot, passed into EasyFullControl::update_all
+class EasyFullControl::RobotStateUpdate
+{
+public:
+  /// Constructor
+  ///
+  /// \param[in] robot
+  ///   The update handle of the robot
+  ///
+  /// \param[in] state
+  ///   The current state of the robot
+  ///
+  /// \param[in] current_activity
+  ///   The activity that the robot is currently executing
+  RobotStateUpdate(
+    std::shared_ptr<EasyRobotUpdateHandle> robot,
+    RobotState state,
+    ConstActivityIdentifierPtr current_activity = nullptr);
+
+  /// The update handle of the robot
+  const std::shared_ptr<EasyRobotUpdateHandle>& robot() const;
+
+  /// The current state of the robot
+  const RobotState& state() const;
+
+  /// The activity that the robot is currently executing
+  const ConstActivityIdentifierPtr& current_activity() const;
+
+  class Implementation;
+private:
+  rmf_utils::impl_ptr<Implementation> _pimpl;
+};
+
 /// The configuration of a robot. These are parameters that typically do not
 /// change over time.
 class EasyFullControl::RobotConfiguration
@@ -21,6 +21,8 @@
 #include <rmf_fleet_adapter/agv/Waypoint.hpp>
 #include <rmf_traffic/schedule/ParticipantDescription.hpp>
 
+#include <variant>
+
 namespace rmf_fleet_adapter {
 namespace agv {
 
@@ -152,6 +154,53 @@ public:
   EasyTrafficLight& fleet_state_publish_period(
     std::optional<rmf_traffic::Duration> value);
 
+  /// A report of the progress of one robot, to be given to update_all().
+  class Progress
+  {
+  public:
+
+    /// The robot is moving, as reported by moving_from().
+    static Progress moving_from(
+      std::shared_ptr<EasyTrafficLight> traffic_light,
+      std::size_t checkpoint,
+      Eigen::Vector3d location);
+
+    /// The robot is waiting at a checkpoint, as reported by waiting_at().
+    static Progress waiting_at(
+      std::shared_ptr<EasyTrafficLight> traffic_light,
+      std::size_t checkpoint);
+
+    /// The robot is waiting after a checkpoint, as reported by
+    /// waiting_after().
+    static Progress waiting_after(
+      std::shared_ptr<EasyTrafficLight> traffic_light,
+      std::size_t checkpoint,
+      Eigen::Vector3d location);
+
+    /// Also update the battery level of the robot, as update_battery_soc()
+    /// would.
+    Progress& battery_soc(double value);
+
+    class Implementation;
+  private:
+    Progress();
+    rmf_utils::impl_ptr<Implementation> _pimpl;
+  };
+
+  /// The instruction for one robot given by update_all(). This holds a
+  /// MovingInstruction if the robot was reported as moving, and a
+  /// WaitingInstruction otherwise.
+  using Instruction = std::variant<MovingInstruction, WaitingInstruction>;
+
+  /// Report the progress of many robots at once. This gives the same
+  /// instructions as calling moving_from(), waiting_at(), or waiting_after()
+  /// for each robot, in the same order as the reports. The fleet states of
+  /// all the robots are published together, in one message per fleet, and
+  /// their own periodic fleet state messages are skipped until they stop
+  /// being included in batches.
+  static std::vector<Instruction> update_all(
+    const std::vector<Progress>& progress);
+
   /// This class will be provided to the deadlock_callback when a deadlock has
   /// occurred due to an unresolvable conflict. Human intervention may be
   /// required at this point, because the RMF traffic negotiation system does
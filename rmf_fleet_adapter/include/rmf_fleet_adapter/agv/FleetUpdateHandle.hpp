@@ -385,6 +385,55 @@ public:
   FleetUpdateHandle& fleet_state_update_period(
     std::optional<rmf_traffic::Duration> value);
 
+  /// Only send a fleet state update when a robot's state has changed, or when
+  /// a heartbeat is due. A robot's state counts as changed when its status,
+  /// task, issues, commission, or mutex groups change, or when it moves or its
+  /// battery drains by more than the given thresholds. Robots that have not
+  /// changed reuse their previous entry in the update.
+  ///
+  /// Passing in std::nullopt for the heartbeat period disables the change
+  /// detection, so that every update is sent in full. This is the default.
+  ///
+  /// \param[in] heartbeat_period
+  ///   The longest time to go without sending an update.
+  ///
+  /// \param[in] position_threshold
+  ///   How far in meters a robot needs to move to count as a change.
+  ///
+  /// \param[in] yaw_threshold
+  ///   How far in radians a robot needs to turn to count as a change.
+  ///
+  /// \param[in] battery_threshold
+  ///   How much the battery state of charge, in the range [0, 1], needs to
+  ///   change to count as a change.
+  FleetUpdateHandle& fleet_state_update_change_detection(
+    std::optional<rmf_traffic::Duration> heartbeat_period,
+    double position_threshold = 0.05,
+    double yaw_threshold = 0.05,
+    double battery_threshold = 0.01);
+
+  /// Refresh the states of robots that are idle or charging less often than
+  /// the states of robots that are working or using a lift. Until its refresh
+  /// is due, a robot reuses its previous entry in the fleet state update and
+  /// in the fleet state topic. The fleet state topic is not published at all
+  /// when no robot is due for a refresh, so the state traffic of the fleet
+  /// grows with the number of active robots rather than the size of the
+  /// fleet. Combine this with fleet_state_update_change_detection() to also
+  /// hold back fleet state updates while only idle robots would change.
+  ///
+  /// By default every robot is refreshed every time.
+  ///
+  /// \param[in] idle_period
+  ///   How often to refresh robots that are idle. Passing std::nullopt
+  ///   refreshes them every time.
+  ///
+  /// \param[in] charging_period
+  ///   How often to refresh robots that are charging. Passing std::nullopt
+  ///   refreshes them every time.
+  FleetUpdateHandle& fleet_state_activity_periods(
+    std::optional<rmf_traffic::Duration> idle_period,
+    std::optional<rmf_traffic::Duration> charging_period);
+
   /// Set a callback for listening to update messages (e.g. fleet states and
   /// task updates). This will not receive any update messages that happened
   /// before the listener was set.
@@ -421,6 +470,308 @@ public:
   /// cache (this is the default behavior).
   void set_planner_cache_reset_size(std::optional<std::size_t> max_size);
 
+  /// Keep a record of the planning problems that this fleet solves in the
+  /// given file, so that the planner cache can be warmed up again the next
+  /// time the fleet adapter starts. If the file already holds a record for the
+  /// same navigation graph and vehicle traits, those problems will be solved
+  /// in the background right away to fill the cache. The record is saved
+  /// during the periodic cache audit and when the fleet shuts down.
+  ///
+  /// Pass in std::nullopt to stop keeping a record (this is the default
+  /// behavior).
+  void set_planner_warm_start_file(std::optional<std::string> filename);
+
+  /// Fill the planner cache in the background with the routes towards the
+  /// goals that this fleet is most likely to need, so that the first plans
+  /// after startup, after lanes are opened or closed, or after the cache is
+  /// reset do not have to wait for the cache to build up. The goals are the
+  /// ones that the robots have planned towards most often recently, followed
+  /// by the chargers and then the parking spots. The warm up runs at the
+  /// lowest thread priority.
+  ///
+  /// \param[in] max_goals
+  ///   The most goals to warm up each time. Pass in 0 to turn this off (this
+  ///   is the default behavior).
+  void set_planner_goal_warmup(std::size_t max_goals);
+
+  /// Plan across the floors of a multi-floor graph in two levels. First the
+  /// floors and lifts that a robot will use are chosen from a coarse graph of
+  /// the floors, where riding a lift costs the time that the lift is expected
+  /// to need to arrive, based on its latest lift state, plus the time to move
+  /// between the floors. Then the path is searched for with the lanes of every
+  /// other floor and every other lift closed, so the search does not expand
+  /// through the whole building. If no path is found that way, the search is
+  /// repeated over the whole graph.
+  ///
+  /// \param[in] max_planners
+  ///   The most planners for different sets of floors and lifts to keep warm
+  ///   at once. Pass in 0 to always plan over the whole graph (this is the
+  ///   default behavior).
+  void set_floor_restricted_planning(std::size_t max_planners);
+
+  /// Cap the records of this fleet that would otherwise keep growing for as
+  /// long as the fleet adapter runs. Once a cap is reached, the oldest entries
+  /// are dropped first. The sizes of these records are logged every five
+  /// minutes along with the planner cache, whose size can be capped with
+  /// set_planner_cache_reset_size().
+  ///
+  /// \param[in] max_bid_assignments
+  ///   The most bids whose assignments are kept while waiting for the task to
+  ///   be awarded. A bid is dropped when the dispatcher never awards or
+  ///   cancels it. Pass in std::nullopt to keep every bid until it is awarded
+  ///   or cancelled (this is the default behavior).
+  ///
+  /// \param[in] max_executed_tasks
+  ///   The most IDs of started tasks that each robot remembers, which are used
+  ///   to make sure that reassigned tasks have not already started. The
+  ///   default is 100.
+  ///
+  /// \param[in] max_unsent_log_entries
+  ///   The most log entries that each robot keeps while its log updates
+  ///   cannot be sent because the websocket server is not keeping up. Pass in
+  ///   std::nullopt to keep all of them until they can be sent (this is the
+  ///   default behavior).
+  void set_memory_caps(
+    std::optional<std::size_t> max_bid_assignments,
+    std::size_t max_executed_tasks = 100,
+    std::optional<std::size_t> max_unsent_log_entries = std::nullopt);
+
+  /// Prepare the next custom action of each robot while its current action
+  /// runs. When a robot has actions that run back to back at the same
+  /// waypoint, a single hold that lasts for all of them is put on the traffic
+  /// schedule when the first one starts, so the actions that follow can start
+  /// without updating the itinerary of the robot. While an action runs, the
+  /// action that will follow it can be found with
+  /// RobotUpdateHandle::ActionExecution::next_action() so the robot can get
+  /// ready for it.
+  ///
+  /// \param[in] enabled
+  ///   Whether to pipeline the actions. This is off by default.
+  void set_action_pipelining(bool enabled);
+
+  /// Back up the task queues of the robots in this fleet to the given file, so
+  /// that the tasks can be restored the next time the fleet adapter starts
+  /// instead of being dispatched and bid on again. If the file already holds
+  /// a backup, each robot gets its tasks back when it is added to the fleet,
+  /// or right away if it has already been added. A task that was in progress
+  /// gets started over from the beginning. Automatic tasks like charging are
+  /// not backed up since the fleet creates them again as needed.
+  ///
+  /// Only tasks that arrive after this is called can be backed up, so this
+  /// should be called before robots are added and after the task planner
+  /// parameters are set.
+  ///
+  /// \param[in] filename
+  ///   The file to restore from and back up to. Pass in std::nullopt to stop
+  ///   backing up the task queues (this is the default behavior).
+  ///
+  /// \param[in] period
+  ///   How often to save the backup. It is only written when a queue has
+  ///   changed.
+  void set_task_queue_backup_file(
+    std::optional<std::string> filename,
+    rmf_traffic::Duration period = std::chrono::seconds(5));
+
+  /// Follow the charger rotation in a schedule file, using the same format as
+  /// rmf_charging_schedule. Each robot in the schedule is switched to its next
+  /// charger when its entry comes up, and task planning gives every robot the
+  /// charger that the schedule assigns to it at the time it will be free, so
+  /// bids already account for upcoming charger changes.
+  ///
+  /// \param[in] filename
+  ///   The schedule file. Pass in std::nullopt to stop following a schedule
+  ///   (this is the default behavior).
+  void set_charging_schedule_file(std::optional<std::string> filename);
+
+  /// Set the parameters that decide when the planning jobs of a negotiation
+  /// should be given up on. A job is abandoned once its cost reaches the
+  /// smaller of (ideal_cost + max_cost_threshold) and
+  /// (compliant_leeway_multiplier * ideal_cost + compliant_leeway_base).
+  /// The defaults are 30, 2, 1.5, and 120, which suit small to medium sized
+  /// graphs.
+  ///
+  /// \param[in] compliant_leeway_base
+  ///   Additive leeway, in seconds, for the cost of a compliant plan.
+  ///
+  /// \param[in] compliant_leeway_multiplier
+  ///   Multiplicative leeway for the cost of a compliant plan.
+  ///
+  /// \param[in] estimate_leeway
+  ///   How far beyond the best cost estimate a job may search before it
+  ///   yields to other jobs.
+  ///
+  /// \param[in] max_cost_threshold
+  ///   The most, in seconds, that a plan may cost beyond its ideal cost.
+  ///
+  /// \param[in] adaptive
+  ///   If true, the fleet adapter will learn how much the accepted plans of
+  ///   this fleet cost beyond their ideal costs, and tune
+  ///   compliant_leeway_base and max_cost_threshold to match, within a factor
+  ///   of four of the values given here.
+  void set_negotiation_evaluator_params(
+    double compliant_leeway_base,
+    double compliant_leeway_multiplier,
+    double estimate_leeway,
+    double max_cost_threshold,
+    bool adaptive = false);
+
+  /// Let robots start moving on the best feasible plan that has been found
+  /// once the planner has been searching for this long, instead of waiting
+  /// for the search for a schedule-compliant plan to finish. The search
+  /// will keep going in the background, and if it finds a compliant plan
+  /// before the robot has moved past the point where the two plans diverge,
+  /// the robot will switch over to the compliant plan.
+  ///
+  /// Pass in std::nullopt to always wait for the search to finish (this is the
+  /// default behavior).
+  void set_anytime_planning_deadline(
+    std::optional<rmf_traffic::Duration> deadline);
+
+  /// Set how robots of this fleet report their delays to the traffic schedule
+  /// while they follow a path. Robots that send frequent position updates
+  /// would otherwise push a new delay to the schedule for nearly every update.
+  ///
+  /// \param[in] threshold
+  ///   The delay of a robot needs to change by more than this before the
+  ///   schedule is told about it. The default is 100ms.
+  ///
+  /// \param[in] min_period
+  ///   The shortest time between two delay reports from the same robot. A
+  ///   change that arrives sooner is reported with the first update after the
+  ///   period has passed. When a robot finishes its path, its final delay is
+  ///   always reported. Pass in std::nullopt to report every change beyond the
+  ///   threshold right away (this is the default behavior).
+  void set_delay_reporting(
+    rmf_traffic::Duration threshold,
+    std::optional<rmf_traffic::Duration> min_period = std::nullopt);
+
+  /// Precompute the travel times between every pair of named waypoints,
+  /// chargers, parking spots, and holding points in the background, so that
+  /// task bids and estimates do not have to wait for the planner. The table
+  /// is computed again whenever lanes are opened or closed or their speed
+  /// limits change. This uses a background thread and memory that grows with
+  /// the square of the number of those waypoints, so it is disabled by
+  /// default.
+  void set_travel_time_precomputation(bool enabled);
+
+  /// Prepare emergency pullovers ahead of time. The emergency planner is kept
+  /// up to date even while there is no emergency, and a background thread
+  /// finds the parking spots that can be reached most quickly from each
+  /// waypoint, which also warms up the planner's caches for every parking
+  /// spot. When an emergency is signaled, each robot only searches for a
+  /// pullover among the closest parking spots to where it is, and if none of
+  /// those can be used it searches all of them on its next attempt.
+  ///
+  /// \param[in] max_candidates
+  ///   How many of the closest parking spots to search from each waypoint.
+  ///   Pass in std::nullopt to only make the emergency planner once an
+  ///   emergency happens and to search every parking spot (this is the
+  ///   default behavior).
+  void set_emergency_pullover_precomputation(
+    std::optional<std::size_t> max_candidates);
+
+  /// Set how many bids this fleet may calculate at the same time. Bid notices
+  /// that arrive while every slot is busy wait in a queue until a slot frees
+  /// up, and each one gets its own response. The default is 1, which
+  /// calculates bids one at a time in the order that they arrive.
+  void set_max_concurrent_bids(std::size_t max_bids);
+
+  /// Set how many threads each task allocation may use. Before the task
+  /// planner runs, the pending requests are estimated from every robot's
+  /// expected state across this many threads, which fills the planner cache
+  /// with the routes that the task planner will need. The assignments that
+  /// come out are the same for any number of threads. The default is 1, which
+  /// leaves all of the work to the task planner.
+  void set_allocation_threads(std::size_t threads);
+
+  /// Reassign dispatched tasks incrementally instead of replanning the whole
+  /// fleet. When tasks need to be reassigned, e.g. because a robot stopped
+  /// accepting tasks or a task was cancelled, only the robots whose queues
+  /// were affected are replanned, along with the most lightly loaded robots
+  /// when there are unassigned tasks that need a new home. The queues of all
+  /// other robots are kept as they are.
+  ///
+  /// \param[in] max_robots
+  ///   The number of robots to bring into each reassignment for unassigned
+  ///   tasks. Affected robots are always included. Pass in std::nullopt to
+  ///   replan the whole fleet every time (this is the default behavior).
+  ///
+  /// \param[in] time_budget
+  ///   How long to search for the optimal assignment before settling for the
+  ///   greedy assignment.
+  void set_incremental_reassignment(
+    std::optional<std::size_t> max_robots,
+    rmf_traffic::Duration time_budget = std::chrono::seconds(5));
+
+  /// Validate only a sample of the messages that this fleet sends out, such as
+  /// fleet states, task states, logs, and API responses. One out of every
+  /// sample_period messages will be validated against its schema. Incoming
+  /// requests are always validated, and debug builds always validate every
+  /// message.
+  ///
+  /// The default sample period is 1, which validates every message. A sample
+  /// period of 0 turns off validation of outgoing messages.
+  void set_outgoing_validation_sample_period(std::size_t sample_period);
+
+  /// Set the shortest time between two task state updates for a robot when
+  /// only the progress of its task has changed. Progress updates that arrive
+  /// in between are coalesced into the next task state update. Transitions,
+  /// such as a task starting, finishing, being cancelled, or failing, are
+  /// still published right away.
+  ///
+  /// Pass in std::nullopt to publish every change (this is the default).
+  void set_task_state_publish_interval(
+    std::optional<rmf_traffic::Duration> interval);
+
+  /// Remember the planners for up to this many other sets of closed lanes.
+  /// Closing or opening lanes normally makes a new planner whose caches start
+  /// out cold. With this enabled, going back to a set of closed lanes that was
+  /// used recently, e.g. reopening lanes that were closed for a short while,
+  /// brings back the planner that already has warm caches. Each remembered
+  /// planner keeps its caches in memory. Changing a speed limit forgets them.
+  ///
+  /// The default size is 0, which remembers none.
+  void set_lane_closure_planner_cache_size(std::size_t size);
+
+  /// An object to maintain an interruption of several robots of this fleet.
+  /// When this object is destroyed, all of the robots will resume.
+  class Interruption
+  {
+  public:
+    /// Call this function to resume all of the interrupted robots at once
+    /// while providing labels for resuming.
+    void resume(std::vector<std::string> labels);
+
+    class Implementation;
+  private:
+    Interruption();
+    rmf_utils::unique_impl_ptr<Implementation> _pimpl;
+  };
+
+  /// Interrupt (pause) several robots of this fleet at once, e.g. for a
+  /// fleet-wide hold. This behaves like RobotUpdateHandle::interrupt() for
+  /// each robot, except that every robot is interrupted, and later resumed,
+  /// together in a single job, so their schedule updates and state updates
+  /// go out together instead of one robot at a time.
+  ///
+  /// \param[in] labels
+  ///   Labels that will be assigned to this interruption. It is recommended to
+  ///   include information about why the interruption is happening.
+  ///
+  /// \param[in] robot_names
+  ///   The names of the robots to interrupt. Pass in an empty vector to
+  ///   interrupt every robot of the fleet.
+  ///
+  /// \param[in] robots_are_interrupted
+  ///   Triggered once every one of the robots has been interrupted.
+  ///
+  /// 
+eturn a handle for this interruption.
+  Interruption interrupt_robots(
+    std::vector<std::string> labels,
+    std::vector<std::string> robot_names,
+    std::function<void()> robots_are_interrupted);
+
   /// Get the rclcpp::Node that this fleet update handle will be using for
   /// communication.
   std::shared_ptr<rclcpp::Node> node();
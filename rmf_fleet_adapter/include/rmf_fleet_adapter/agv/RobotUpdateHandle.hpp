@@ -260,6 +260,12 @@ public:
     /// wind-down or cleanup is finished.
     void set_automatic_cancel(bool on);
 
+    /// If action pipelining is enabled for the fleet, get the category and
+    /// description of the action that will run right after this one at the
+    /// same waypoint, so the robot can get ready for it while this action
+    /// runs. Returns std::nullopt if no such action is known.
+    std::optional<std::pair<std::string, nlohmann::json>> next_action() const;
+
     /// Activity identifier for this action. Used by the EasyFullControl API.
     ConstActivityIdentifierPtr identifier() const;
 
@@ -585,9 +591,25 @@ public:
 
     /// Set a callback that can be used to check whether the robot is clear to
     /// enter the lift.
+    ///
+    /// The fleet adapter asks the watchdog for a decision as soon as the robot
+    /// starts waiting for the lift, and asks again whenever the decision has
+    /// become older than decision_time_to_live. That way a decision is usually
+    /// ready by the time the lift doors open.
+    ///
+    /// \param[in] watchdog
+    ///   The callback that decides whether the robot may enter the lift.
+    ///
+    /// \param[in] wait_duration
+    ///   How long to wait before trying again after a Crowded decision.
+    ///
+    /// \param[in] decision_time_to_live
+    ///   How long a decision that arrived before the lift doors opened can be
+    ///   used for.
     void set_lift_entry_watchdog(
       Watchdog watchdog,
-      rmf_traffic::Duration wait_duration = std::chrono::seconds(10));
+      rmf_traffic::Duration wait_duration = std::chrono::seconds(10),
+      rmf_traffic::Duration decision_time_to_live = std::chrono::seconds(5));
 
     /// Turn on/off a debug dump of how position updates are being processed
     void debug_positions(bool on);
@@ -62,6 +62,15 @@ public:
   /// Apply the inverse of this transformation to an (x, y, yaw) position
   Eigen::Vector3d apply_inverse(const Eigen::Vector3d& position) const;
 
+  /// Apply this transformation to many (x, y, yaw) positions at once, where
+  /// each column is one position. This is faster than calling apply() on each
+  /// position, e.g. for every waypoint of a path.
+  Eigen::Matrix3Xd apply_all(const Eigen::Matrix3Xd& positions) const;
+
+  /// Apply the inverse of this transformation to many (x, y, yaw) positions
+  /// at once, where each column is one position.
+  Eigen::Matrix3Xd apply_inverse_all(const Eigen::Matrix3Xd& positions) const;
+
   class Implementation;
 private:
   rmf_utils::impl_ptr<Implementation> _pimpl;
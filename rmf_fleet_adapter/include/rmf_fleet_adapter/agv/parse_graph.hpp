@@ -34,6 +34,30 @@ rmf_traffic::agv::Graph parse_graph(
   const std::string& filename,
   const rmf_traffic::agv::VehicleTraits& vehicle_traits);
 
+/// Parse the graph described by a yaml file, using a binary cache of the file
+/// to skip the yaml parsing whenever the file has not changed since the cache
+/// was written. The cache is checked against a hash of the yaml file, and it
+/// is rewritten whenever it is missing, stale, or unreadable. It is
+/// independent of the vehicle traits, so fleets that share a nav graph may
+/// share a cache.
+///
+/// \param[in] filename
+///   The yaml file describing the graph.
+///
+/// \param[in] vehicle_traits
+///   The traits of the vehicles that will use the graph.
+///
+/// \param[in] cache_file
+///   Where the binary cache should be kept. If this is empty, no cache is used.
+///   Failing to write the cache only prints a warning.
+///
+/// \warning This will throw a std::runtime_error if the file has a syntax
+/// error.
+rmf_traffic::agv::Graph parse_graph(
+  const std::string& filename,
+  const rmf_traffic::agv::VehicleTraits& vehicle_traits,
+  const std::string& cache_file);
+
 } // namespace agv
 } // namespace rmf_fleet_adapter
 
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef RMF_RXCPP__JOBSTATS_HPP
+#define RMF_RXCPP__JOBSTATS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+namespace rmf_rxcpp {
+
+//==============================================================================
+/// Statistics about one type of job that runs on an rxcpp worker: how many are
+/// waiting in the queue of their worker, how long they waited there, and how
+/// long they took to run.
+class JobStats
+{
+public:
+
+  using Clock = std::chrono::steady_clock;
+
+  /// The upper bounds of the histogram buckets in seconds. The last bucket
+  /// holds everything that took longer than the last bound.
+  static constexpr std::array<double, 7> BucketBounds = {
+    1e-5, 1e-4, 1e-3, 1e-2, 1e-1, 1.0, 10.0
+  };
+
+  struct Histogram
+  {
+    std::array<std::size_t, BucketBounds.size() + 1> buckets = {};
+    std::size_t count = 0;
+    double total = 0.0;
+    double max = 0.0;
+
+    double mean() const
+    {
+      return count > 0 ? total / count : 0.0;
+    }
+
+    void add(Clock::duration duration)
+    {
+      const double seconds = std::chrono::duration<double>(duration).count();
+      const auto bucket = std::lower_bound(
+        BucketBounds.begin(), BucketBounds.end(), seconds);
+      ++buckets[bucket - BucketBounds.begin()];
+      ++count;
+      total += seconds;
+      max = std::max(max, seconds);
+    }
+  };
+
+  /// What happened to this type of job since the last window was taken
+  struct Window
+  {
+    std::string type;
+    std::size_t queued;
+    Histogram wait;
+    Histogram execution;
+  };
+
+  explicit JobStats(std::string type)
+  : _type(std::move(type))
+  {
+    // Do nothing
+  }
+
+  const std::string& type() const
+  {
+    return _type;
+  }
+
+  /// A job of this type was put in the queue of a worker
+  void queued()
+  {
+    _queued.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// A job of this type was taken out of the queue of its worker
+  void started(Clock::duration wait)
+  {
+    _queued.fetch_sub(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(_mutex);
+    _wait.add(wait);
+  }
+
+  /// A job of this type finished running
+  void finished(Clock::duration execution)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _execution.add(execution);
+  }
+
+  /// Get the statistics since the last time this was called and start over
+  Window take_window()
+  {
+    Window window;
+    window.type = _type;
+    window.queued = _queued.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(_mutex);
+    window.wait = std::exchange(_wait, Histogram());
+    window.execution = std::exchange(_execution, Histogram());
+    return window;
+  }
+
+  /// Get the statistics of a type of job, creating them the first time that
+  /// the type is seen.
+  static JobStats& get(const std::string& type)
+  {
+    auto& registry = _registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto& stats = registry.stats[type];
+    if (!stats)
+      stats = std::make_shared<JobStats>(type);
+
+    return *stats;
+  }
+
+  /// Get the statistics of a type of job action, named after the class of the
+  /// action without its namespace.
+  template<typename Action>
+  static JobStats& of()
+  {
+    static JobStats& stats = get(_short_name(typeid(Action)));
+    return stats;
+  }
+
+  /// Take a window of every type of job that has been seen so far
+  static std::vector<Window> take_windows()
+  {
+    std::vector<std::shared_ptr<JobStats>> all;
+    {
+      auto& registry = _registry();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      for (const auto& [_, stats] : registry.stats)
+        all.push_back(stats);
+    }
+
+    std::vector<Window> windows;
+    windows.reserve(all.size());
+    for (const auto& stats : all)
+      windows.push_back(stats->take_window());
+
+    return windows;
+  }
+
+private:
+
+  struct Registry
+  {
+    std::mutex mutex;
+    std::map<std::string, std::shared_ptr<JobStats>> stats;
+  };
+
+  static Registry& _registry()
+  {
+    static Registry registry;
+    return registry;
+  }
+
+  static std::string _short_name(const std::type_info& info)
+  {
+    std::string name = info.name();
+#if defined(__GNUG__)
+    int status = 0;
+    char* demangled =
+      abi::__cxa_demangle(info.name(), nullptr, nullptr, &status);
+    if (status == 0 && demangled)
+      name = demangled;
+    std::free(demangled);
+#endif
+
+    // Drop template arguments and namespaces
+    name = name.substr(0, name.find('<'));
+    const auto scope = name.rfind("::");
+    if (scope != std::string::npos)
+      name = name.substr(scope + 2);
+
+    return name;
+  }
+
+  std::string _type;
+  std::atomic_size_t _queued{0};
+  std::mutex _mutex;
+  Histogram _wait;
+  Histogram _execution;
+};
+
+} // namespace rmf_rxcpp
+
+#endif // RMF_RXCPP__JOBSTATS_HPP
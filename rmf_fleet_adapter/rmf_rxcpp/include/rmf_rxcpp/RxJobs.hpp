@@ -31,6 +31,21 @@ inline auto make_job(const std::shared_ptr<Action>& action)
   return detail::make_observable<T>(action);
 }
 
+/// Run jobs on a dedicated pool of threads instead of the event loop that is
+/// shared with everything else in the process. Passing in zero goes back to
+/// the shared event loop. Jobs that have already started will stay where they
+/// are, so this should be called before any jobs are made.
+inline void set_job_threads(std::size_t num_threads)
+{
+  auto scheduler = num_threads == 0 ?
+    detail::get_event_loop() :
+    rxcpp::schedulers::make_scheduler<detail::job_event_loop>(num_threads);
+
+  auto& storage = detail::get_job_scheduler_storage();
+  std::lock_guard<std::mutex> lock(storage.mutex);
+  storage.scheduler = std::move(scheduler);
+}
+
 template<typename Job0, typename... Jobs>
 inline auto merge_jobs(const Job0& o0, Jobs&&... os)
 {
@@ -18,11 +18,21 @@
 #ifndef RMF_RXCPP__TRANSPORT_HPP
 #define RMF_RXCPP__TRANSPORT_HPP
 
+#include <rmf_rxcpp/detail/MpscQueue.hpp>
+#include <rmf_rxcpp/JobStats.hpp>
 #include <rmf_rxcpp/detail/TransportDetail.hpp>
 #include <rmf_rxcpp/RxJobs.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <rxcpp/rx.hpp>
+
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace rmf_rxcpp {
 
@@ -38,11 +48,24 @@ public:
     _worker{std::move(worker)},
     _started{false},
     _stopping{false},
-    _work_scheduled{false}
+    _work_scheduled{false},
+    _use_work_queue{false},
+    _drain_scheduled{false}
   {
     // Do nothing
   }
 
+  /// Choose how ready work is handed to the worker. By default the spin thread
+  /// schedules a spin_some() on the worker and blocks until it is finished. If
+  /// this is set to true, the spin thread instead takes each ready executable
+  /// itself and pushes it into a lock-free queue that the worker drains, so
+  /// there is no mutex or condition variable handshake between them. This only
+  /// takes effect the next time spin() begins.
+  void use_work_queue(bool value)
+  {
+    _use_work_queue = value;
+  }
+
   void spin() override
   {
     {
@@ -53,16 +76,57 @@ public:
 
     _started_cv.notify_all();
 
-    const auto keep_spinning = [&]()
-      {
-        return !_stopping && rclcpp::ok(context_);
-      };
+    if (_use_work_queue)
+      _spin_with_work_queue();
+    else
+      _spin_with_handshake();
+
+    _started = false;
+    _stopping = false;
+  }
+
+  void stop()
+  {
+    _stopping = true;
+    _cv.notify_all();
+  }
+
+  void wait_until_started()
+  {
+    while (!_started)
+    {
+      std::unique_lock<std::mutex> lock(_starting_mutex);
+      _started_cv.wait(lock, [&]() { return _started.load(); });
+    }
+  }
+
+private:
+
+  /// Statistics of the batches of ROS callbacks that run on the worker
+  static JobStats& _callback_stats()
+  {
+    static JobStats& stats = JobStats::get("callbacks");
+    return stats;
+  }
+
+  bool _keep_spinning()
+  {
+    return !_stopping && rclcpp::ok(context_);
+  }
+
+  void _spin_with_handshake()
+  {
+    const auto keep_spinning = [&]() { return _keep_spinning(); };
 
     while (keep_spinning())
     {
       _work_scheduled = true;
-      _worker.schedule([w = weak_from_this()](const auto&)
+      _callback_stats().queued();
+      _worker.schedule(
+        [w = weak_from_this(), queued_at = JobStats::Clock::now()](const auto&)
         {
+          const auto start = JobStats::Clock::now();
+          _callback_stats().started(start - queued_at);
           if (const auto& self = w.lock())
           {
             self->spin_some();
@@ -74,6 +138,7 @@ public:
 
             self->_cv.notify_all();
           }
+          _callback_stats().finished(JobStats::Clock::now() - start);
         });
 
       {
@@ -97,27 +162,47 @@ public:
       if (keep_spinning())
         wait_for_work(std::chrono::milliseconds(50));
     }
-
-    _started = false;
-    _stopping = false;
   }
 
-  void stop()
+  void _spin_with_work_queue()
   {
-    _stopping = true;
-    _cv.notify_all();
-  }
-
-  void wait_until_started()
-  {
-    while (!_started)
+    while (_keep_spinning())
     {
-      std::unique_lock<std::mutex> lock(_starting_mutex);
-      _started_cv.wait(lock, [&]() { return _started.load(); });
+      // Taking an executable marks its mutually exclusive callback group as
+      // busy until execute_any_executable() is finished with it, so the wait
+      // set will not hand out the same work twice while it sits in the queue.
+      rclcpp::AnyExecutable executable;
+      if (!get_next_executable(executable, std::chrono::milliseconds(50)))
+        continue;
+
+      _work_queue.push(std::move(executable));
+      if (_drain_scheduled.exchange(true))
+        continue;
+
+      _callback_stats().queued();
+      _worker.schedule(
+        [w = weak_from_this(), queued_at = JobStats::Clock::now()](const auto&)
+        {
+          const auto start = JobStats::Clock::now();
+          _callback_stats().started(start - queued_at);
+          if (const auto& self = w.lock())
+          {
+            // Clear the flag before draining so that anything pushed after the
+            // last pop schedules another drain.
+            self->_drain_scheduled = false;
+
+            rclcpp::AnyExecutable next;
+            while (self->_work_queue.pop(next))
+            {
+              self->execute_any_executable(next);
+              next = rclcpp::AnyExecutable();
+            }
+          }
+          _callback_stats().finished(JobStats::Clock::now() - start);
+        });
     }
   }
 
-private:
   rxcpp::schedulers::worker _worker;
 
   std::atomic_bool _started;
@@ -129,6 +214,10 @@ private:
   bool _work_scheduled;
   std::mutex _mutex;
   std::condition_variable _cv;
+
+  std::atomic_bool _use_work_queue;
+  std::atomic_bool _drain_scheduled;
+  detail::MpscQueue<rclcpp::AnyExecutable> _work_queue;
 };
 
 template<typename Message>
@@ -169,6 +258,174 @@ private:
 
 };
 
+/// A subscription bridge that groups the messages which arrive during one turn
+/// of the worker into a single batch, so subscribers of a high rate topic see
+/// one event per turn instead of one event per message.
+template<typename Message>
+class BatchingSubscriptionBridge
+{
+public:
+
+  using MessagePtr = typename Message::SharedPtr;
+  using Batch = std::vector<MessagePtr>;
+
+  /// Gives the identity of a message, e.g. the name of the door whose state it
+  /// describes, for the Latest mode.
+  using KeyFn = std::function<std::string(const Message&)>;
+
+  enum class Mode
+  {
+    /// Deliver every message that arrived, oldest first
+    All,
+
+    /// Deliver only the newest message. When a key function is given, deliver
+    /// the newest message of each key instead, in the order that the keys
+    /// first appeared.
+    Latest
+  };
+
+  struct Options
+  {
+    Mode mode = Mode::All;
+
+    /// In the All mode, the most messages that a batch may hold. When more
+    /// messages than this arrive before the batch is delivered, the oldest
+    /// ones are dropped. A value of zero means there is no limit.
+    std::size_t max_batch_size = 0;
+
+    /// Used by the Latest mode. May be left empty.
+    KeyFn key;
+  };
+
+  BatchingSubscriptionBridge(
+    rclcpp::Node::SharedPtr node,
+    rxcpp::schedulers::worker worker,
+    const std::string& topic_name,
+    const rclcpp::QoS& qos,
+    Options options)
+  : _shared(std::make_shared<Shared>(std::move(worker), std::move(options)))
+  {
+    _subscription = node->create_subscription<Message>(
+      topic_name, qos,
+      [w = std::weak_ptr<Shared>(_shared)](MessagePtr msg)
+      {
+        if (const auto shared = w.lock())
+          Shared::receive(shared, std::move(msg));
+      });
+
+    _observable = _shared->publisher.get_observable();
+  }
+
+  const rxcpp::observable<Batch>& observe() const
+  {
+    return _observable;
+  }
+
+  /// The number of messages that have been dropped because a batch was full
+  std::size_t dropped() const
+  {
+    std::lock_guard<std::mutex> lock(_shared->mutex);
+    return _shared->dropped;
+  }
+
+  ~BatchingSubscriptionBridge()
+  {
+    _shared->publisher.get_subscriber().on_completed();
+  }
+
+private:
+
+  struct Shared
+  {
+    Shared(rxcpp::schedulers::worker worker_, Options options_)
+    : worker(std::move(worker_)),
+      options(std::move(options_))
+    {
+      // Do nothing
+    }
+
+    static void receive(const std::shared_ptr<Shared>& self, MessagePtr msg)
+    {
+      std::lock_guard<std::mutex> lock(self->mutex);
+      self->add(std::move(msg));
+      if (self->flush_scheduled)
+        return;
+
+      // Anything that the worker is busy with right now, such as the rest of
+      // the current spin, runs before this, so the batch collects everything
+      // that arrives in the meantime.
+      self->flush_scheduled = true;
+      self->worker.schedule(
+        [w = std::weak_ptr<Shared>(self)](const auto&)
+        {
+          if (const auto shared = w.lock())
+            shared->flush();
+        });
+    }
+
+    void add(MessagePtr msg)
+    {
+      if (options.mode == Mode::Latest)
+      {
+        if (!options.key)
+        {
+          pending.clear();
+          pending.push_back(std::move(msg));
+          return;
+        }
+
+        const auto insertion =
+          key_index.insert({options.key(*msg), pending.size()});
+        if (insertion.second)
+          pending.push_back(std::move(msg));
+        else
+          pending[insertion.first->second] = std::move(msg);
+
+        return;
+      }
+
+      if (options.max_batch_size > 0
+        && pending.size() >= options.max_batch_size)
+      {
+        pending.pop_front();
+        ++dropped;
+      }
+
+      pending.push_back(std::move(msg));
+    }
+
+    void flush()
+    {
+      Batch batch;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        batch.reserve(pending.size());
+        std::move(pending.begin(), pending.end(), std::back_inserter(batch));
+        pending.clear();
+        key_index.clear();
+        flush_scheduled = false;
+      }
+
+      if (!batch.empty())
+        publisher.get_subscriber().on_next(batch);
+    }
+
+    rxcpp::schedulers::worker worker;
+    Options options;
+    rxcpp::subjects::subject<Batch> publisher;
+
+    mutable std::mutex mutex;
+    std::deque<MessagePtr> pending;
+    std::unordered_map<std::string, std::size_t> key_index;
+    std::size_t dropped = 0;
+    bool flush_scheduled = false;
+  };
+
+  std::shared_ptr<Shared> _shared;
+  rxcpp::observable<Batch> _observable;
+  typename rclcpp::Subscription<Message>::SharedPtr _subscription;
+};
+
 // TODO(MXG): We define all the member functions of this class inline so that we
 // don't need to export/install rmf_rxcpp as its own shared library (linking to
 // it as a static library results in linking errors related to symbols not being
@@ -181,11 +438,15 @@ public:
   template<typename Message>
   using Bridge = std::shared_ptr<SubscriptionBridge<Message>>;
 
+  template<typename Message>
+  using BatchingBridge = std::shared_ptr<BatchingSubscriptionBridge<Message>>;
+
   explicit Transport(
     rxcpp::schedulers::worker worker,
     const std::string& node_name,
     const rclcpp::NodeOptions& options = rclcpp::NodeOptions())
   : rclcpp::Node{node_name, options},
+    _worker{worker},
     _executor{std::make_shared<RxCppExecutor>(
         worker, _make_exec_args(options))}
   {
@@ -197,6 +458,13 @@ public:
     _executor->add_node(node);
   }
 
+  /// Hand ready work to the worker through a lock-free queue instead of
+  /// blocking on each spin. This takes effect the next time start() is called.
+  void use_executor_work_queue(bool value)
+  {
+    _executor->use_work_queue(value);
+  }
+
   void start()
   {
     std::unique_lock<std::mutex> lock(_stopping_mutex);
@@ -263,6 +531,22 @@ public:
       SubscriptionBridge<Message>>(shared_from_this(), topic_name, qos);
   }
 
+  /**
+   * Like create_observable, except the messages that arrive during one turn of
+   * the worker are delivered together as a single vector. With the Latest
+   * mode only the newest message (or the newest message of each key) is kept,
+   * which suits state topics where older messages have been superseded.
+   */
+  template<typename Message>
+  BatchingBridge<Message> create_batching_observable(
+    const std::string& topic_name,
+    const rclcpp::QoS& qos,
+    typename BatchingSubscriptionBridge<Message>::Options options = {})
+  {
+    return std::make_shared<BatchingSubscriptionBridge<Message>>(
+      shared_from_this(), _worker, topic_name, qos, std::move(options));
+  }
+
   ~Transport()
   {
     stop();
@@ -273,6 +557,7 @@ private:
   bool _stopped = true;
   std::condition_variable _stopped_cv;
 
+  rxcpp::schedulers::worker _worker;
   std::shared_ptr<RxCppExecutor> _executor;
   bool _node_added = false;
   std::thread _spin_thread;
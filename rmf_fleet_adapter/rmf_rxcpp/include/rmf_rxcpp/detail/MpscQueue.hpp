@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef RMF_RXCPP__DETAIL__MPSCQUEUE_HPP
+#define RMF_RXCPP__DETAIL__MPSCQUEUE_HPP
+
+#include <atomic>
+#include <utility>
+
+namespace rmf_rxcpp {
+namespace detail {
+
+//==============================================================================
+/// An unbounded lock-free queue that any number of threads may push into while
+/// a single thread pops from it. Pushing never blocks and never fails. Popping
+/// may briefly report an empty queue while a push is halfway done, in which
+/// case the value will be available to the next pop.
+template<typename T>
+class MpscQueue
+{
+public:
+
+  MpscQueue()
+  : _head{new Node},
+    _tail{_head.load(std::memory_order_relaxed)}
+  {
+    // Do nothing
+  }
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  /// Push a value into the queue. This may be called from any thread.
+  void push(T value)
+  {
+    Node* const node = new Node{std::move(value)};
+    Node* const prev = _head.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  /// Pop the oldest value from the queue. This must only be called by one
+  /// thread at a time. Returns false if nothing was available.
+  bool pop(T& output)
+  {
+    Node* const next = _tail->next.load(std::memory_order_acquire);
+    if (!next)
+      return false;
+
+    output = std::move(next->value);
+    delete _tail;
+    _tail = next;
+    return true;
+  }
+
+  ~MpscQueue()
+  {
+    while (_tail)
+    {
+      Node* const next = _tail->next.load(std::memory_order_relaxed);
+      delete _tail;
+      _tail = next;
+    }
+  }
+
+private:
+
+  struct Node
+  {
+    T value = T();
+    std::atomic<Node*> next{nullptr};
+  };
+
+  // Producers append at the head while the consumer removes from the tail. The
+  // tail always points at a node whose value has already been consumed.
+  std::atomic<Node*> _head;
+  Node* _tail;
+};
+
+} // namespace detail
+} // namespace rmf_rxcpp
+
+#endif // RMF_RXCPP__DETAIL__MPSCQUEUE_HPP
@@ -18,8 +18,13 @@
 #ifndef RMF_RXCPP__RXJOBSDETAIL_HPP
 #define RMF_RXCPP__RXJOBSDETAIL_HPP
 
+#include <rmf_rxcpp/JobStats.hpp>
 #include <rxcpp/rx.hpp>
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 namespace rmf_rxcpp {
 namespace detail {
 template<typename Action, typename Subscriber>
@@ -34,11 +39,16 @@ void schedule_job(
   const rxcpp::schedulers::worker& w,
   typename std::enable_if_t<IsAsyncAction<Action, Subscriber>::value>* = 0)
 {
+  auto& stats = JobStats::of<Action>();
+  stats.queued();
   w.schedule(
-    [a, s, w](const auto&)
+    [a, s, w, &stats, queued_at = JobStats::Clock::now()](const auto&)
     {
+      const auto start = JobStats::Clock::now();
+      stats.started(start - queued_at);
       if (const auto action = a.lock())
         (*action)(s, w);
+      stats.finished(JobStats::Clock::now() - start);
     });
 }
 
@@ -49,11 +59,16 @@ void schedule_job(
   const rxcpp::schedulers::worker& w,
   typename std::enable_if_t<!IsAsyncAction<Action, Subscriber>::value>* = 0)
 {
+  auto& stats = JobStats::of<Action>();
+  stats.queued();
   w.schedule(
-    [a, s](const auto&)
+    [a, s, &stats, queued_at = JobStats::Clock::now()](const auto&)
     {
+      const auto start = JobStats::Clock::now();
+      stats.started(start - queued_at);
       if (const auto action = a.lock())
         (*action)(s);
+      stats.finished(JobStats::Clock::now() - start);
     });
 }
 
@@ -63,6 +78,135 @@ inline auto get_event_loop()
   return event_loop;
 }
 
+/// An event loop with a chosen number of threads. Unlike the rxcpp event loop,
+/// which hands out its threads in a round robin, each new worker goes to the
+/// thread that currently has the fewest live workers, so that one long job
+/// does not keep stalling the jobs that happen to land behind it.
+class job_event_loop : public rxcpp::schedulers::scheduler_interface
+{
+public:
+
+  explicit job_event_loop(std::size_t num_threads)
+  : _newthread(rxcpp::schedulers::make_new_thread()),
+    _loads(std::make_shared<Loads>(num_threads))
+  {
+    for (std::size_t i = 0; i < num_threads; ++i)
+      _loops.push_back(_newthread.create_worker(_loops_lifetime));
+  }
+
+  ~job_event_loop()
+  {
+    _loops_lifetime.unsubscribe();
+  }
+
+  clock_type::time_point now() const override
+  {
+    return clock_type::now();
+  }
+
+  rxcpp::schedulers::worker create_worker(
+    rxcpp::composite_subscription cs) const override
+  {
+    std::size_t chosen = 0;
+    for (std::size_t i = 1; i < _loops.size(); ++i)
+    {
+      if (_loads->counts[i] < _loads->counts[chosen])
+        chosen = i;
+    }
+
+    return rxcpp::schedulers::worker(
+      cs,
+      std::make_shared<loop_worker>(
+        cs, _loops[chosen], _loads, chosen, shared_from_this()));
+  }
+
+private:
+
+  struct Loads
+  {
+    Loads(std::size_t n)
+    : counts(n)
+    {
+      // Do nothing
+    }
+
+    std::vector<std::atomic<std::size_t>> counts;
+  };
+
+  struct loop_worker : public rxcpp::schedulers::worker_interface
+  {
+    loop_worker(
+      rxcpp::composite_subscription cs,
+      rxcpp::schedulers::worker controller_,
+      std::shared_ptr<Loads> loads_,
+      std::size_t index_,
+      std::shared_ptr<const rxcpp::schedulers::scheduler_interface> alive_)
+    : lifetime(cs),
+      controller(std::move(controller_)),
+      loads(std::move(loads_)),
+      index(index_),
+      alive(std::move(alive_))
+    {
+      ++loads->counts[index];
+      auto token = controller.add(cs);
+      cs.add([token, w = controller]() { w.remove(token); });
+    }
+
+    ~loop_worker()
+    {
+      --loads->counts[index];
+    }
+
+    clock_type::time_point now() const override
+    {
+      return clock_type::now();
+    }
+
+    void schedule(const rxcpp::schedulers::schedulable& scbl) const override
+    {
+      controller.schedule(lifetime, scbl.get_action());
+    }
+
+    void schedule(
+      clock_type::time_point when,
+      const rxcpp::schedulers::schedulable& scbl) const override
+    {
+      controller.schedule(when, lifetime, scbl.get_action());
+    }
+
+    rxcpp::composite_subscription lifetime;
+    rxcpp::schedulers::worker controller;
+    std::shared_ptr<Loads> loads;
+    std::size_t index;
+    std::shared_ptr<const rxcpp::schedulers::scheduler_interface> alive;
+  };
+
+  rxcpp::schedulers::scheduler _newthread;
+  rxcpp::composite_subscription _loops_lifetime;
+  std::vector<rxcpp::schedulers::worker> _loops;
+  std::shared_ptr<Loads> _loads;
+};
+
+struct job_scheduler_storage
+{
+  std::mutex mutex;
+  rxcpp::schedulers::scheduler scheduler = get_event_loop();
+};
+
+inline job_scheduler_storage& get_job_scheduler_storage()
+{
+  static job_scheduler_storage storage;
+  return storage;
+}
+
+/// Get the scheduler that jobs should be run on
+inline rxcpp::schedulers::scheduler get_job_scheduler()
+{
+  auto& storage = get_job_scheduler_storage();
+  std::lock_guard<std::mutex> lock(storage.mutex);
+  return storage.scheduler;
+}
+
 /**
  * Creates an observable from a job, the observable runs the job in an event loop until it has
  * completed or cancelled. Each progress update on a job is queued at the back of the event loop
@@ -79,7 +223,7 @@ auto make_observable(const std::shared_ptr<Action>& action)
   return rxcpp::observable<>::create<T>(
     [a = std::weak_ptr<Action>(action)](const auto& s)
     {
-      auto worker = get_event_loop().create_worker();
+      auto worker = get_job_scheduler().create_worker();
       detail::schedule_job(a, s, worker);
     });
 }
@@ -91,7 +235,7 @@ auto make_leaky_observable(const std::shared_ptr<Action>& action)
   return rxcpp::observable<>::create<T>(
     [a = std::move(action)](const auto& s)
     {
-      auto worker = get_event_loop().create_worker();
+      auto worker = get_job_scheduler().create_worker();
       detail::schedule_job(a, s, worker);
     });
 }
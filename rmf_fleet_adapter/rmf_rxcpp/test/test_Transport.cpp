@@ -22,7 +22,9 @@
 
 #include <rclcpp/contexts/default_context.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <mutex>
 #include <thread>
 
 using namespace std::chrono_literals;
@@ -134,3 +136,95 @@ TEST_CASE("publish subscribe loopback", "[Transport]")
     subscription.unsubscribe();
   }
 }
+
+//==============================================================================
+TEST_CASE("batching subscriptions", "[Transport]")
+{
+  auto context = std::make_shared<rclcpp::Context>();
+  context->init(0, nullptr);
+
+  auto transport = std::make_shared<rmf_rxcpp::Transport>(
+    rxcpp::schedulers::make_event_loop().create_worker(),
+    "test_transport_" + std::to_string(node_counter++),
+    rclcpp::NodeOptions().context(context));
+
+  transport->start();
+
+  const std::string topic_name = "test_topic_" +
+    std::to_string(topic_counter++);
+  auto publisher = transport->create_publisher<std_msgs::msg::String>(
+    topic_name, 10);
+
+  using Bridge = rmf_rxcpp::BatchingSubscriptionBridge<std_msgs::msg::String>;
+  Bridge::Options options;
+
+  SECTION("latest mode keeps the newest message of each key")
+  {
+    options.mode = Bridge::Mode::Latest;
+    options.key = [](const std_msgs::msg::String& msg)
+      {
+        return msg.data.substr(0, 1);
+      };
+  }
+
+  auto bridge = transport->create_batching_observable<std_msgs::msg::String>(
+    topic_name, 10, options);
+
+  std::mutex mutex;
+  std::vector<std::string> received;
+  rxcpp::composite_subscription subscription;
+  bridge->observe().subscribe(
+    subscription,
+    [&](const Bridge::Batch& batch)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (const auto& msg : batch)
+      {
+        REQUIRE(msg);
+        received.push_back(msg->data);
+      }
+    });
+
+  int loop_count = 10;
+  while (transport->count_subscribers(topic_name) == 0 && loop_count > 0)
+  {
+    std::this_thread::sleep_for(100ms);
+    --loop_count;
+  }
+  REQUIRE(transport->count_subscribers(topic_name) == 1);
+
+  for (const auto& data : {"a1", "b1", "a2"})
+  {
+    std_msgs::msg::String msg;
+    msg.data = data;
+    publisher->publish(msg);
+  }
+
+  loop_count = 20;
+  while (loop_count > 0)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (std::find(received.begin(), received.end(), "a2") != received.end())
+        break;
+    }
+
+    std::this_thread::sleep_for(100ms);
+    --loop_count;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  if (options.mode == Bridge::Mode::All)
+  {
+    CHECK(received == std::vector<std::string>({"a1", "b1", "a2"}));
+  }
+  else
+  {
+    // Whether a1 was conflated depends on how the messages were split across
+    // turns of the worker, but b1 and a2 must always arrive.
+    CHECK(std::find(received.begin(), received.end(), "b1") != received.end());
+    CHECK(std::find(received.begin(), received.end(), "a2") != received.end());
+  }
+
+  subscription.unsubscribe();
+}
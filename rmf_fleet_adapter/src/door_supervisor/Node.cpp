@@ -49,6 +49,22 @@ Node::Node()
 
   _door_heartbeat_pub = create_publisher<Heartbeat>(
     DoorSupervisorHeartbeatTopicName, default_qos);
+
+  // Sessions whose requester has gone quiet for this many seconds will be
+  // closed, e.g. because the fleet adapter that opened them crashed. Leave
+  // this at 0 to keep sessions until they are closed, which is the safe
+  // choice unless every robot renews its request for as long as it is using
+  // the door.
+  const double session_timeout =
+    declare_parameter<double>("session_timeout", 0.0);
+  if (session_timeout > 0.0)
+  {
+    _session_timeout = rclcpp::Duration::from_seconds(session_timeout);
+    _expiration_timer = create_wall_timer(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(std::min(session_timeout / 2.0, 1.0))),
+      [&]() { _expire_sessions(); });
+  }
 }
 
 //==============================================================================
@@ -68,15 +84,22 @@ void Node::_process_open_request(
   const std::string& requester_id,
   const builtin_interfaces::msg::Time& time)
 {
+  const auto now = get_clock()->now();
   auto& open_requests = _log[door_name];
-  auto insertion = open_requests.insert(std::make_pair(requester_id, time));
+  auto insertion = open_requests.insert(
+    std::make_pair(requester_id, Session{time, now}));
   if (!insertion.second)
   {
     // Use the latest time in the log
-    auto& logged_request_time = insertion.first->second;
-    logged_request_time = std::max(logged_request_time, rclcpp::Time(time));
+    auto& session = insertion.first->second;
+    session.request_time = std::max(session.request_time, rclcpp::Time(time));
+    session.last_heard = now;
   }
 
+  if (_session_timeout.has_value())
+    _expirations.push({now, door_name, requester_id});
+
+  _update_heartbeat(door_name);
   _send_open_request(door_name);
   _publish_heartbeat();
 }
@@ -107,7 +130,7 @@ void Node::_process_close_request(
   if (request_it == door_log.end())
     return _publish_heartbeat();
 
-  auto& logged_request_time = request_it->second;
+  auto& logged_request_time = request_it->second.request_time;
   const auto new_request_time = rclcpp::Time(time);
   if (new_request_time < logged_request_time)
     return _publish_heartbeat();
@@ -116,11 +139,16 @@ void Node::_process_close_request(
   door_log.erase(request_it);
 
   if (!door_log.empty())
+  {
+    _update_heartbeat(door_name);
     return _publish_heartbeat();
+  }
 
   // If all the open requests have been erased for this door, then we can
-  // safely close it.
-  // TODO(MXG): Consider whether the door_it should be erased from _log
+  // safely close it. A door without sessions is treated the same as a door
+  // that is not in the log, so its entry is dropped.
+  _log.erase(door_it);
+  _update_heartbeat(door_name);
   _send_close_request(door_name);
   _publish_heartbeat();
 }
@@ -168,23 +196,102 @@ void Node::_door_state_update(DoorState::UniquePtr msg)
 //==============================================================================
 void Node::_publish_heartbeat()
 {
-  rmf_door_msgs::msg::SupervisorHeartbeat msg;
-  for (const auto& door : _log)
+  _door_heartbeat_pub->publish(_heartbeat);
+}
+
+//==============================================================================
+void Node::_update_heartbeat(const std::string& door_name)
+{
+  const auto door_it = _log.find(door_name);
+  const auto index_it = _heartbeat_index.find(door_name);
+  auto& all_sessions = _heartbeat.all_sessions;
+
+  if (door_it == _log.end())
+  {
+    if (index_it == _heartbeat_index.end())
+      return;
+
+    // Move the last entry into the place of the one being removed
+    const std::size_t index = index_it->second;
+    _heartbeat_index.erase(index_it);
+    if (index + 1 < all_sessions.size())
+    {
+      all_sessions[index] = std::move(all_sessions.back());
+      _heartbeat_index[all_sessions[index].door_name] = index;
+    }
+
+    all_sessions.pop_back();
+    return;
+  }
+
+  std::size_t index;
+  if (index_it == _heartbeat_index.end())
   {
-    rmf_door_msgs::msg::DoorSessions sessions;
-    sessions.door_name = door.first;
-    for (const auto& session : door.second)
+    index = all_sessions.size();
+    _heartbeat_index[door_name] = index;
+    all_sessions.emplace_back();
+    all_sessions.back().door_name = door_name;
+  }
+  else
+  {
+    index = index_it->second;
+  }
+
+  auto& sessions = all_sessions[index].sessions;
+  sessions.clear();
+  for (const auto& session : door_it->second)
+  {
+    rmf_door_msgs::msg::Session s;
+    s.request_time = session.second.request_time;
+    s.requester_id = session.first;
+    sessions.emplace_back(std::move(s));
+  }
+}
+
+//==============================================================================
+void Node::_expire_sessions()
+{
+  const auto now = get_clock()->now();
+  bool changed = false;
+  while (!_expirations.empty()
+    && now - _expirations.top().last_heard > *_session_timeout)
+  {
+    const auto expiration = _expirations.top();
+    _expirations.pop();
+
+    const auto door_it = _log.find(expiration.door_name);
+    if (door_it == _log.end())
+      continue;
+
+    auto& door_log = door_it->second;
+    const auto request_it = door_log.find(expiration.requester_id);
+    if (request_it == door_log.end()
+      || request_it->second.last_heard != expiration.last_heard)
+    {
+      continue;
+    }
+
+    RCLCPP_WARN(
+      get_logger(),
+      "Closing the session of [%s] for door [%s] because it has not been "
+      "renewed in %.1f seconds",
+      expiration.requester_id.c_str(),
+      expiration.door_name.c_str(),
+      _session_timeout->seconds());
+
+    door_log.erase(request_it);
+    changed = true;
+    if (door_log.empty())
     {
-      rmf_door_msgs::msg::Session s;
-      s.request_time = session.second;
-      s.requester_id = session.first;
-      sessions.sessions.emplace_back(std::move(s));
+      _log.erase(door_it);
+      _send_close_request(expiration.door_name);
     }
 
-    msg.all_sessions.emplace_back(std::move(sessions));
+    _update_heartbeat(expiration.door_name);
   }
 
-  _door_heartbeat_pub->publish(msg);
+  if (changed)
+    _publish_heartbeat();
 }
 
 } // namespace door_supervisor
@@ -22,8 +22,12 @@
 #include <rmf_door_msgs/msg/door_request.hpp>
 #include <rmf_door_msgs/msg/supervisor_heartbeat.hpp>
 
+#include <functional>
+#include <optional>
+#include <queue>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace rmf_fleet_adapter {
 namespace door_supervisor {
@@ -71,11 +75,51 @@ private:
   HeartbeatPub::SharedPtr _door_heartbeat_pub;
   void _publish_heartbeat();
 
+  /// Rebuild the heartbeat entry of one door after its sessions changed.
+  void _update_heartbeat(const std::string& door_name);
+
+  /// Close the sessions that have not been renewed within _session_timeout.
+  void _expire_sessions();
+
+  struct Session
+  {
+    /// The latest request time that the requester has given
+    rclcpp::Time request_time;
+
+    /// When the supervisor last heard from the requester
+    rclcpp::Time last_heard;
+  };
+
   using OpenRequestLog =
     std::unordered_map<
     std::string,
-    std::unordered_map<std::string, rclcpp::Time>>;
+    std::unordered_map<std::string, Session>>;
   OpenRequestLog _log;
+
+  // The heartbeat message is kept up to date as sessions change, so that
+  // publishing it does not require visiting every door.
+  Heartbeat _heartbeat;
+  std::unordered_map<std::string, std::size_t> _heartbeat_index;
+
+  struct Expiration
+  {
+    rclcpp::Time last_heard;
+    std::string door_name;
+    std::string requester_id;
+
+    bool operator>(const Expiration& other) const
+    {
+      return last_heard > other.last_heard;
+    }
+  };
+
+  // A session may appear here several times, but only the entry that
+  // matches its last_heard time counts.
+  std::priority_queue<Expiration, std::vector<Expiration>,
+    std::greater<Expiration>> _expirations;
+
+  std::optional<rclcpp::Duration> _session_timeout;
+  rclcpp::TimerBase::SharedPtr _expiration_timer;
 };
 
 } // namespace door_supervisor
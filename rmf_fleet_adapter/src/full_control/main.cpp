@@ -18,6 +18,8 @@
 // Internal implementation-specific headers
 #include "../rmf_fleet_adapter/ParseArgs.hpp"
 #include "../rmf_fleet_adapter/load_param.hpp"
+#include "../rmf_fleet_adapter/services/ProgressEvaluator.hpp"
+#include "../rmf_fleet_adapter/services/ProposalCache.hpp"
 
 // Public rmf_fleet_adapter API headers
 #include <rmf_fleet_adapter/agv/Adapter.hpp>
@@ -54,6 +56,7 @@
 // Public rmf_traffic API headers
 #include <rmf_traffic/agv/Interpolate.hpp>
 #include <rmf_traffic/Route.hpp>
+#include <rmf_traffic/geometry/Circle.hpp>
 
 #include <rmf_battery/agv/BatterySystem.hpp>
 #include <rmf_battery/agv/SimpleMotionPowerSink.hpp>
@@ -62,6 +65,13 @@
 #include <Eigen/Geometry>
 #include <nlohmann/json.hpp>
 
+#include <rcl/arguments.h>
+#include <rcl_yaml_param_parser/parser.h>
+#include <rclcpp/parameter_map.hpp>
+
+#include <chrono>
+#include <future>
+#include <sstream>
 #include <unordered_set>
 #include <optional>
 
@@ -207,6 +217,7 @@ public:
 
     _travel_info.target_plan_index = std::nullopt;
     _travel_info.waypoints = waypoints;
+    _travel_info.next_graph_index.clear();
     _travel_info.next_arrival_estimator = std::move(next_arrival_estimator);
     _travel_info.path_finished_callback = std::move(path_finished_callback);
     _interrupted = false;
@@ -768,6 +779,10 @@ struct Connections : public std::enable_shared_from_this<Connections>
   rclcpp::Client<rmf_fleet_msgs::srv::LiftClearance>::SharedPtr
     lift_watchdog_client;
 
+  /// How long a lift clearance decision that was asked for ahead of time can
+  /// be used for
+  rmf_traffic::Duration lift_watchdog_decision_ttl = std::chrono::seconds(5);
+
   /// The topic subscription for listening for lane closure requests
   rclcpp::Subscription<rmf_fleet_msgs::msg::LaneRequest>::SharedPtr
     lane_closure_request_sub;
@@ -905,7 +920,9 @@ struct Connections : public std::enable_shared_from_this<Connections>
                   const auto r = response.get();
                   decide(convert_decision(r->decision));
                 });
-            });
+            },
+            std::chrono::seconds(10),
+            connections->lift_watchdog_decision_ttl);
         }
 
         command->set_updater(updater);
@@ -926,9 +943,190 @@ struct Connections : public std::enable_shared_from_this<Connections>
   }
 };
 
+//==============================================================================
+/// Keeps track of how long each step of starting up the fleet adapter takes
+class StartupReport
+{
+public:
+
+  using Clock = std::chrono::steady_clock;
+
+  /// Mark the end of a step that started when the previous step ended
+  void step(const std::string& name, const std::string& note = "")
+  {
+    const auto now = Clock::now();
+    _steps.push_back({name, note, now - _last});
+    _last = now;
+  }
+
+  std::string str() const
+  {
+    std::stringstream ss;
+    ss << "Startup took " << seconds(_last - _start) << "s:";
+    for (const auto& step : _steps)
+    {
+      ss << "\n -- " << step.name << ": " << seconds(step.duration) << "s";
+      if (!step.note.empty())
+        ss << " (" << step.note << ")";
+    }
+    return ss.str();
+  }
+
+private:
+
+  static double seconds(Clock::duration d)
+  {
+    return std::chrono::duration<double>(d).count();
+  }
+
+  struct Step
+  {
+    std::string name;
+    std::string note;
+    Clock::duration duration;
+  };
+
+  Clock::time_point _start = Clock::now();
+  Clock::time_point _last = _start;
+  std::vector<Step> _steps;
+};
+
+//==============================================================================
+/// Look for the value that a string parameter of the fleet adapter node was
+/// given on the command line or in a parameter file, before the node exists.
+std::optional<std::string> find_string_parameter_override(
+  const std::string& node_name,
+  const std::string& param_name)
+{
+  rcl_params_t* params = nullptr;
+  const auto context = rclcpp::contexts::get_global_default_context();
+  if (rcl_arguments_get_param_overrides(
+      &context->get_rcl_context()->global_arguments, &params) != RCL_RET_OK
+    || !params)
+  {
+    return std::nullopt;
+  }
+
+  rclcpp::ParameterMap map;
+  try
+  {
+    map = rclcpp::parameter_map_from(params);
+  }
+  catch (const std::exception&)
+  {
+    // Leave it to the node to report malformed parameters
+  }
+  rcl_yaml_node_struct_fini(params);
+
+  // A value given to this node by name wins over a value given to every node
+  std::optional<std::string> found;
+  for (const auto& [node, values] : map)
+  {
+    const bool by_name = node == "/" + node_name;
+    if (!by_name && node != "/**" && node != "/*")
+      continue;
+
+    for (const auto& value : values)
+    {
+      if (value.get_name() != param_name
+        || value.get_type() != rclcpp::ParameterType::PARAMETER_STRING)
+      {
+        continue;
+      }
+
+      if (by_name || !found.has_value())
+        found = value.as_string();
+    }
+  }
+
+  return found;
+}
+
+//==============================================================================
+/// A nav graph that gets parsed in the background while the adapter is busy
+/// with discovery
+struct GraphPrefetch
+{
+  std::string graph_file;
+  std::string cache_file;
+  std::future<std::optional<rmf_traffic::agv::Graph>> graph;
+
+  static GraphPrefetch start(const std::string& node_name)
+  {
+    GraphPrefetch prefetch;
+    const auto graph_file =
+      find_string_parameter_override(node_name, "nav_graph_file");
+    if (!graph_file.has_value() || graph_file->empty())
+      return prefetch;
+
+    prefetch.graph_file = *graph_file;
+    prefetch.cache_file =
+      find_string_parameter_override(node_name, "nav_graph_cache_file")
+      .value_or("");
+
+    prefetch.graph = std::async(
+      std::launch::async,
+      [graph_file = prefetch.graph_file, cache_file = prefetch.cache_file]()
+      -> std::optional<rmf_traffic::agv::Graph>
+      {
+        try
+        {
+          return rmf_fleet_adapter::agv::parse_graph(
+            graph_file, default_graph_traits(), cache_file);
+        }
+        catch (const std::exception&)
+        {
+          // The graph will be parsed again in the foreground, which will
+          // report the error.
+          return std::nullopt;
+        }
+      });
+
+    return prefetch;
+  }
+
+  /// The nav graph only depends on the vehicle traits through the forward
+  /// direction of the vehicle, which the fleet adapter leaves at its default.
+  static rmf_traffic::agv::VehicleTraits default_graph_traits()
+  {
+    return rmf_traffic::agv::VehicleTraits{
+      {1.0, 1.0},
+      {1.0, 1.0},
+      rmf_traffic::Profile{
+        rmf_traffic::geometry::make_final_convex<
+          rmf_traffic::geometry::Circle>(1.0)
+      }
+    };
+  }
+
+  /// Get the graph if it was parsed from the same file with the same traits
+  std::optional<rmf_traffic::agv::Graph> take(
+    const std::string& file,
+    const std::string& cache,
+    const rmf_traffic::agv::VehicleTraits& traits)
+  {
+    if (!graph.valid())
+      return std::nullopt;
+
+    auto parsed = graph.get();
+    const auto forward = traits.get_differential()->get_forward();
+    const auto default_forward =
+      default_graph_traits().get_differential()->get_forward();
+    if (file != graph_file || cache != cache_file
+      || !forward.isApprox(default_forward))
+    {
+      return std::nullopt;
+    }
+
+    return parsed;
+  }
+};
+
 //==============================================================================
 std::shared_ptr<Connections> make_fleet(
-  const rmf_fleet_adapter::agv::AdapterPtr& adapter)
+  const rmf_fleet_adapter::agv::AdapterPtr& adapter,
+  GraphPrefetch& graph_prefetch,
+  StartupReport& report)
 {
   const auto& node = adapter->node();
   node->declare_parameter("enable_responsive_wait", true);
@@ -991,9 +1189,25 @@ std::shared_ptr<Connections> make_fleet(
     return nullptr;
   }
 
+  // Keep a binary copy of the nav graph here so that the YAML does not need
+  // to be parsed again on the next startup. An empty string disables this.
+  const std::string graph_cache_file =
+    node->declare_parameter("nav_graph_cache_file", std::string());
+
+  report.step("parameters");
+  auto graph = graph_prefetch.take(
+    graph_file, graph_cache_file, *connections->traits);
+  const bool prefetched = graph.has_value();
+  if (!prefetched)
+  {
+    graph = rmf_fleet_adapter::agv::parse_graph(
+      graph_file, *connections->traits, graph_cache_file);
+  }
+
   connections->graph =
-    std::make_shared<rmf_traffic::agv::Graph>(
-    rmf_fleet_adapter::agv::parse_graph(graph_file, *connections->traits));
+    std::make_shared<rmf_traffic::agv::Graph>(std::move(*graph));
+  report.step(
+    "nav graph", prefetched ? "parsed in the background during discovery" : "");
 
   std::cout << "The fleet [" << fleet_name
             << "] has the following named waypoints:\n";
@@ -1014,6 +1228,7 @@ std::shared_ptr<Connections> make_fleet(
 
   connections->fleet = adapter->add_fleet(
     fleet_name, *connections->traits, *connections->graph, server_uri);
+  report.step("fleet");
 
   // We disable fleet state publishing for this fleet adapter because we expect
   // the fleet drivers to publish these messages.
@@ -1356,6 +1571,250 @@ std::shared_ptr<Connections> make_fleet(
         *node, "delay_threshold", 10.0));
   }
 
+  // Reuse the plans that were proposed for recurring negotiation subproblems
+  // for this many seconds. Zero disables the cache.
+  rmf_fleet_adapter::services::ProposalCache::get().lifetime(
+    rmf_fleet_adapter::get_parameter_or_default_time(
+      *node, "negotiation_proposal_cache_lifetime", 0.0));
+
+  // Tune when the planning jobs of negotiations get given up on. The defaults
+  // suit small to medium sized graphs.
+  const bool adaptive_evaluator =
+    node->declare_parameter<bool>("negotiation_adaptive_leeway", false);
+  const double compliant_leeway_base = node->declare_parameter<double>(
+    "negotiation_compliant_leeway_base",
+    rmf_fleet_adapter::services::ProgressEvaluator::DefaultCompliantLeewayBase);
+  const double compliant_leeway_multiplier = node->declare_parameter<double>(
+    "negotiation_compliant_leeway_multiplier",
+    rmf_fleet_adapter::services::ProgressEvaluator::
+    DefaultCompliantLeewayMultiplier);
+  const double estimate_leeway = node->declare_parameter<double>(
+    "negotiation_estimate_leeway",
+    rmf_fleet_adapter::services::ProgressEvaluator::DefaultEstimateLeeway);
+  const double max_cost_threshold = node->declare_parameter<double>(
+    "negotiation_max_cost_threshold",
+    rmf_fleet_adapter::services::ProgressEvaluator::DefaultMaxCostThreshold);
+  connections->fleet->set_negotiation_evaluator_params(
+    compliant_leeway_base, compliant_leeway_multiplier, estimate_leeway,
+    max_cost_threshold, adaptive_evaluator);
+
+  // Start moving on the best feasible plan after planning for this many
+  // seconds, and switch to a schedule-compliant plan if one turns up in time.
+  // Zero disables this.
+  const auto anytime_planning_deadline =
+    rmf_fleet_adapter::get_parameter_or_default_time(
+    *node, "anytime_planning_deadline", 0.0);
+  if (anytime_planning_deadline > rmf_traffic::Duration(0))
+  {
+    connections->fleet->set_anytime_planning_deadline(
+      anytime_planning_deadline);
+  }
+
+  // Only tell the traffic schedule about a change in a robot's delay once it
+  // exceeds delay_report_threshold seconds, and at most once every
+  // delay_report_period seconds. A period of zero reports every change.
+  const auto delay_report_threshold =
+    rmf_fleet_adapter::get_parameter_or_default_time(
+    *node, "delay_report_threshold", 0.1);
+  const auto delay_report_period =
+    rmf_fleet_adapter::get_parameter_or_default_time(
+    *node, "delay_report_period", 0.0);
+  std::optional<rmf_traffic::Duration> delay_report_min_period;
+  if (delay_report_period > rmf_traffic::Duration(0))
+    delay_report_min_period = delay_report_period;
+
+  connections->fleet->set_delay_reporting(
+    delay_report_threshold, delay_report_min_period);
+
+  // Precompute the travel times between task-relevant waypoints in the
+  // background so that task bids come back quickly.
+  if (node->declare_parameter<bool>("precompute_travel_times", false))
+  {
+    connections->fleet->set_travel_time_precomputation(true);
+  }
+
+  // Keep an emergency planner warm and find the closest parking spots to each
+  // waypoint ahead of time so that robots can pull over right away during an
+  // emergency. Zero disables this.
+  const auto emergency_pullover_candidates =
+    node->declare_parameter<int>("emergency_pullover_candidates", 0);
+  if (emergency_pullover_candidates > 0)
+  {
+    connections->fleet->set_emergency_pullover_precomputation(
+      static_cast<std::size_t>(emergency_pullover_candidates));
+  }
+
+  // Calculate up to this many task bids at the same time
+  const auto max_concurrent_bids =
+    node->declare_parameter<int>("max_concurrent_bids", 1);
+  if (max_concurrent_bids > 1)
+  {
+    connections->fleet->set_max_concurrent_bids(max_concurrent_bids);
+  }
+
+  // Use up to this many threads for each task allocation
+  const auto allocation_threads =
+    node->declare_parameter<int>("allocation_threads", 1);
+  if (allocation_threads > 1)
+  {
+    connections->fleet->set_allocation_threads(allocation_threads);
+  }
+
+  // Reassign tasks among only this many robots at a time, searching for the
+  // optimal assignment for up to the given number of seconds. Zero replans
+  // the whole fleet every time.
+  const auto incremental_reassignment_robots =
+    node->declare_parameter<int>("incremental_reassignment_robots", 0);
+  if (incremental_reassignment_robots > 0)
+  {
+    connections->fleet->set_incremental_reassignment(
+      incremental_reassignment_robots,
+      rmf_fleet_adapter::get_parameter_or_default_time(
+        *node, "incremental_reassignment_budget", 5.0));
+  }
+
+  // Validate one out of every this many outgoing messages. Zero turns off
+  // validation of outgoing messages.
+  const auto outgoing_validation_sample_period =
+    node->declare_parameter<int>("outgoing_validation_sample_period", 1);
+  if (outgoing_validation_sample_period >= 0
+    && outgoing_validation_sample_period != 1)
+  {
+    connections->fleet->set_outgoing_validation_sample_period(
+      outgoing_validation_sample_period);
+  }
+
+  // Publish the progress of each robot's task at most once per this many
+  // seconds. Zero publishes every change.
+  const double task_state_publish_interval =
+    node->declare_parameter<double>("task_state_publish_interval", 0.0);
+  if (task_state_publish_interval > 0.0)
+  {
+    connections->fleet->set_task_state_publish_interval(
+      rmf_traffic::time::from_seconds(task_state_publish_interval));
+  }
+
+  // Keep the planners for this many recently used sets of closed lanes
+  const auto lane_closure_planner_cache_size =
+    node->declare_parameter<int>("lane_closure_planner_cache_size", 0);
+  if (lane_closure_planner_cache_size > 0)
+  {
+    connections->fleet->set_lane_closure_planner_cache_size(
+      lane_closure_planner_cache_size);
+  }
+
+  // Only send fleet state updates when a robot has changed, or at least once
+  // every this many seconds. Zero sends every update.
+  const double fleet_state_heartbeat_period =
+    node->declare_parameter<double>("fleet_state_heartbeat_period", 0.0);
+  if (fleet_state_heartbeat_period > 0.0)
+  {
+    connections->fleet->fleet_state_update_change_detection(
+      rmf_traffic::time::from_seconds(fleet_state_heartbeat_period));
+  }
+
+  // Refresh the states of idle and charging robots only this often, in
+  // seconds. Zero refreshes them as often as the robots that are working.
+  const double idle_state_period =
+    node->declare_parameter<double>("idle_state_period", 0.0);
+  const double charging_state_period =
+    node->declare_parameter<double>("charging_state_period", 0.0);
+  if (idle_state_period > 0.0 || charging_state_period > 0.0)
+  {
+    const auto period = [](double value)
+      -> std::optional<rmf_traffic::Duration>
+      {
+        if (value > 0.0)
+          return rmf_traffic::time::from_seconds(value);
+        return std::nullopt;
+      };
+
+    connections->fleet->fleet_state_activity_periods(
+      period(idle_state_period), period(charging_state_period));
+  }
+
+  // Keep a record of the planning problems in this file so that the planner
+  // cache can be warmed up after a restart. An empty string disables this.
+  const auto planner_warm_start_file =
+    node->declare_parameter<std::string>("planner_warm_start_file", "");
+  if (!planner_warm_start_file.empty())
+  {
+    connections->fleet->set_planner_warm_start_file(planner_warm_start_file);
+  }
+
+  // Warm up the planner cache in the background towards up to this many of
+  // the goals that the fleet uses most. Zero disables this.
+  const auto planner_goal_warmup =
+    node->declare_parameter<int>("planner_goal_warmup", 0);
+  if (planner_goal_warmup > 0)
+  {
+    connections->fleet->set_planner_goal_warmup(
+      static_cast<std::size_t>(planner_goal_warmup));
+  }
+
+  // Plan through multi-floor graphs by first choosing the floors and lifts to
+  // use, and keep up to this many planners for different choices. Zero
+  // disables this.
+  const auto floor_restricted_planners =
+    node->declare_parameter<int>("floor_restricted_planners", 0);
+  if (floor_restricted_planners > 0)
+  {
+    connections->fleet->set_floor_restricted_planning(
+      static_cast<std::size_t>(floor_restricted_planners));
+  }
+
+  // Cap the bids that wait for an award, the started task IDs that each robot
+  // remembers, and the log entries that each robot keeps while they cannot be
+  // sent, so that the memory of the fleet adapter stays bounded. Zero disables
+  // the caps on bids and log entries.
+  const auto max_bid_assignments =
+    node->declare_parameter<int>("max_bid_assignments", 0);
+  const auto max_executed_tasks =
+    node->declare_parameter<int>("max_executed_tasks", 100);
+  const auto max_unsent_log_entries =
+    node->declare_parameter<int>("max_unsent_log_entries", 0);
+  if (max_bid_assignments > 0 || max_executed_tasks != 100
+    || max_unsent_log_entries > 0)
+  {
+    const auto optional_cap = [](int value) -> std::optional<std::size_t>
+      {
+        if (value > 0)
+          return static_cast<std::size_t>(value);
+        return std::nullopt;
+      };
+
+    connections->fleet->set_memory_caps(
+      optional_cap(max_bid_assignments),
+      static_cast<std::size_t>(std::max(max_executed_tasks, 1)),
+      optional_cap(max_unsent_log_entries));
+  }
+
+  // Prepare the next custom action of each robot while its current action
+  // runs, so that back-to-back actions start without updating the schedule.
+  if (node->declare_parameter<bool>("action_pipelining", false))
+    connections->fleet->set_action_pipelining(true);
+
+  // Back up the task queues of the robots to this file every
+  // task_queue_backup_period seconds so that they can be restored after a
+  // restart. An empty string disables this.
+  const auto task_queue_backup_file =
+    node->declare_parameter<std::string>("task_queue_backup_file", "");
+  const double task_queue_backup_period =
+    node->declare_parameter<double>("task_queue_backup_period", 5.0);
+  if (!task_queue_backup_file.empty() && task_queue_backup_period > 0.0)
+  {
+    connections->fleet->set_task_queue_backup_file(
+      task_queue_backup_file,
+      rmf_traffic::time::from_seconds(task_queue_backup_period));
+  }
+
+  // Follow the charger rotation in this rmf_charging_schedule file. An empty
+  // string disables this.
+  const auto charging_schedule_file =
+    node->declare_parameter<std::string>("charging_schedule_file", "");
+  if (!charging_schedule_file.empty())
+    connections->fleet->set_charging_schedule_file(charging_schedule_file);
+
   connections->path_request_pub = node->create_publisher<
     rmf_fleet_msgs::msg::PathRequest>(
     rmf_fleet_adapter::PathRequestTopicName,
@@ -1408,8 +1867,15 @@ std::shared_ptr<Connections> make_fleet(
     connections->lift_watchdog_client =
       node->create_client<rmf_fleet_msgs::srv::LiftClearance>(
       lift_clearance_srv);
+
+    // Lift clearance is asked for while the robot waits for the lift, and the
+    // answer can be used for this many seconds once it arrives.
+    connections->lift_watchdog_decision_ttl = rmf_traffic::time::from_seconds(
+      node->declare_parameter<double>(
+        "experimental_lift_watchdog_decision_ttl", 5.0));
   }
 
+  report.step("configuration");
   return connections;
 }
 
@@ -1417,14 +1883,23 @@ std::shared_ptr<Connections> make_fleet(
 int main(int argc, char* argv[])
 {
   rclcpp::init(argc, argv);
-  const auto adapter = rmf_fleet_adapter::agv::Adapter::make("fleet_adapter");
+  StartupReport report;
+  const std::string node_name = "fleet_adapter";
+
+  // Discovery can take a while, so parse the nav graph in the meantime
+  auto graph_prefetch = GraphPrefetch::start(node_name);
+
+  const auto adapter = rmf_fleet_adapter::agv::Adapter::make(node_name);
   if (!adapter)
     return 1;
 
-  const auto fleet_connections = make_fleet(adapter);
+  report.step("discovery");
+
+  const auto fleet_connections = make_fleet(adapter, graph_prefetch, report);
   if (!fleet_connections)
     return 1;
 
+  RCLCPP_INFO(adapter->node()->get_logger(), "%s", report.str().c_str());
   RCLCPP_INFO(adapter->node()->get_logger(), "Starting Fleet Adapter");
 
   // Start running the adapter and wait until it gets stopped by SIGINT
@@ -20,6 +20,10 @@
 #include <rmf_fleet_adapter/StandardNames.hpp>
 #include <rmf_traffic_ros2/StandardNames.hpp>
 
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+
 namespace rmf_fleet_adapter {
 namespace lift_supervisor {
 
@@ -47,6 +51,22 @@ Node::Node()
     {
       _lift_state_update(std::move(msg));
     });
+
+  _wait_estimates_pub = create_publisher<std_msgs::msg::String>(
+    LiftWaitEstimatesTopicName, transient_qos);
+
+  // Requests that arrive while their lift is in use wait in a queue. Adapters
+  // repeat their requests while they wait, so a request that has not been
+  // heard from for this many seconds is dropped from the queue.
+  _queue_timeout = rclcpp::Duration::from_seconds(
+    declare_parameter<double>("lift_queue_timeout", 5.0));
+
+  // When a lift becomes free, a request waiting at the floor where the lift
+  // already is may be served before older requests, so that the lift does not
+  // travel empty. This is how many times any one request may be passed over
+  // that way. The default of 0 serves requests strictly in order.
+  _max_overtakes = static_cast<std::size_t>(std::max<int64_t>(0,
+    declare_parameter<int64_t>("lift_queue_max_overtakes", 0)));
 }
 
 //==============================================================================
@@ -57,7 +77,11 @@ void Node::_adapter_lift_request_update(LiftRequest::UniquePtr msg)
 
   if (curr_request)
   {
-    if (curr_request->session_id == msg->session_id)
+    if (curr_request->session_id != msg->session_id)
+    {
+      _enqueue(std::move(msg));
+    }
+    else
     {
       if (msg->request_type != LiftRequest::REQUEST_END_SESSION)
       {
@@ -85,6 +109,17 @@ void Node::_adapter_lift_request_update(LiftRequest::UniquePtr msg)
           msg->session_id.c_str()
         );
         curr_request = nullptr;
+
+        auto& lift = _lifts[msg->lift_name];
+        if (lift.session_start.has_value())
+        {
+          const double duration = (this->now() - *lift.session_start).seconds();
+          lift.mean_session_duration = lift.mean_session_duration.has_value() ?
+            0.8 * *lift.mean_session_duration + 0.2 * duration : duration;
+          lift.session_start = std::nullopt;
+        }
+
+        _start_next_session(msg->lift_name);
       }
     }
   }
@@ -97,13 +132,148 @@ void Node::_adapter_lift_request_update(LiftRequest::UniquePtr msg)
         "[%s] Received new adapter lift request to [%s] with request type [%d]",
         msg->session_id.c_str(), msg->destination_floor.c_str(), msg->request_type
       );
+      const std::string lift_name = msg->lift_name;
       curr_request = std::move(msg);
       curr_request->request_time = this->now();
       _lift_request_pub->publish(*curr_request);
+      _lifts[lift_name].session_start = curr_request->request_time;
+      _publish_wait_estimates(lift_name);
+    }
+  }
+}
+
+//==============================================================================
+void Node::_enqueue(LiftRequest::UniquePtr msg)
+{
+  const std::string lift_name = msg->lift_name;
+  auto& queue = _lifts[lift_name].queue;
+  const auto it = std::find_if(queue.begin(), queue.end(),
+      [&](const WaitingRequest& w)
+      {
+        return w.request->session_id == msg->session_id;
+      });
+
+  if (msg->request_type == LiftRequest::REQUEST_END_SESSION)
+  {
+    // The requester has given up before it got the lift
+    if (it != queue.end())
+    {
+      queue.erase(it);
+      _publish_wait_estimates(lift_name);
+    }
+
+    return;
+  }
+
+  if (it != queue.end())
+  {
+    it->request = std::move(msg);
+    it->last_heard = this->now();
+    return;
+  }
+
+  RCLCPP_INFO(
+    this->get_logger(),
+    "[%s] Queued adapter lift request for lift [%s] behind %lu other "
+    "request(s) because the lift is in use",
+    msg->session_id.c_str(), lift_name.c_str(), queue.size());
+
+  queue.push_back(WaitingRequest{std::move(msg), this->now()});
+  _publish_wait_estimates(lift_name);
+}
+
+//==============================================================================
+void Node::_start_next_session(const std::string& lift_name)
+{
+  auto& lift = _lifts[lift_name];
+  auto& queue = lift.queue;
+  const auto now = this->now();
+  queue.erase(
+    std::remove_if(queue.begin(), queue.end(),
+    [&](const WaitingRequest& w)
+    {
+      return now - w.last_heard > _queue_timeout;
+    }), queue.end());
+
+  if (queue.empty())
+    return _publish_wait_estimates(lift_name);
+
+  std::size_t next = 0;
+  for (std::size_t i = 0; i < queue.size(); ++i)
+  {
+    if (queue[i].request->destination_floor == lift.current_floor)
+    {
+      next = i;
+      break;
     }
+
+    // Nothing further back may overtake a request that has already been
+    // passed over as often as allowed.
+    if (queue[i].times_overtaken >= _max_overtakes)
+      break;
   }
 
-  // TODO(MXG): Make this more intelligent by scheduling the lift
+  for (std::size_t i = 0; i < next; ++i)
+    ++queue[i].times_overtaken;
+
+  auto& curr_request = _active_sessions[lift_name];
+  curr_request = std::move(queue[next].request);
+  queue.erase(queue.begin() + next);
+
+  RCLCPP_INFO(
+    this->get_logger(),
+    "[%s] Starting queued lift session for lift [%s] to [%s]",
+    curr_request->session_id.c_str(), lift_name.c_str(),
+    curr_request->destination_floor.c_str());
+
+  curr_request->request_time = now;
+  _lift_request_pub->publish(*curr_request);
+  lift.session_start = now;
+  _publish_wait_estimates(lift_name);
+}
+
+//==============================================================================
+void Node::_publish_wait_estimates(const std::string& lift_name)
+{
+  const auto& lift = _lifts[lift_name];
+  const auto& curr_request = _active_sessions[lift_name];
+
+  nlohmann::json estimates;
+  estimates["lift_name"] = lift_name;
+  estimates["active_session"] = curr_request ?
+    nlohmann::json(curr_request->session_id) : nlohmann::json();
+
+  // Until a session of this lift has been seen from start to end, there is
+  // nothing to base an estimate on.
+  std::optional<double> wait;
+  if (lift.mean_session_duration.has_value())
+  {
+    wait = 0.0;
+    if (lift.session_start.has_value())
+    {
+      const double elapsed = (this->now() - *lift.session_start).seconds();
+      wait = std::max(0.0, *lift.mean_session_duration - elapsed);
+    }
+  }
+
+  auto& queue = estimates["queue"];
+  queue = nlohmann::json::array();
+  for (const auto& w : lift.queue)
+  {
+    nlohmann::json entry;
+    entry["session_id"] = w.request->session_id;
+    entry["destination_floor"] = w.request->destination_floor;
+    entry["expected_wait"] = wait.has_value() ?
+      nlohmann::json(*wait) : nlohmann::json();
+    queue.push_back(std::move(entry));
+
+    if (wait.has_value())
+      *wait += *lift.mean_session_duration;
+  }
+
+  std_msgs::msg::String msg;
+  msg.data = estimates.dump();
+  _wait_estimates_pub->publish(msg);
 }
 
 //==============================================================================
@@ -112,6 +282,8 @@ void Node::_lift_state_update(LiftState::UniquePtr state)
   auto& lift_request = _active_sessions.insert(
     std::make_pair(state->lift_name, nullptr)).first->second;
 
+  _lifts[state->lift_name].current_floor = state->current_floor;
+
   if (lift_request)
   {
     const bool correct_floor = lift_request->destination_floor == state->destination_floor
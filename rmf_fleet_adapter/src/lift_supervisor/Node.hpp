@@ -22,9 +22,12 @@
 #include <rmf_lift_msgs/msg/lift_state.hpp>
 
 #include <std_msgs/msg/bool.hpp>
+#include <std_msgs/msg/string.hpp>
 
 #include <rclcpp/node.hpp>
 
+#include <deque>
+#include <optional>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -53,7 +56,46 @@ private:
   LiftStateSub::SharedPtr _lift_state_sub;
   void _lift_state_update(LiftState::UniquePtr msg);
 
+  /// Add a request to the queue of its lift, or refresh it if it is already
+  /// waiting there.
+  void _enqueue(LiftRequest::UniquePtr msg);
+
+  /// Give the lift to the next request in its queue, if there is one.
+  void _start_next_session(const std::string& lift_name);
+
+  void _publish_wait_estimates(const std::string& lift_name);
+
+  struct WaitingRequest
+  {
+    LiftRequest::UniquePtr request;
+    rclcpp::Time last_heard;
+    std::size_t times_overtaken = 0;
+  };
+
+  struct LiftRecord
+  {
+    /// Requests from other sessions that arrived while the lift was in use,
+    /// oldest first
+    std::deque<WaitingRequest> queue;
+
+    /// The floor that the lift was last seen at
+    std::string current_floor;
+
+    /// When the active session started
+    std::optional<rclcpp::Time> session_start;
+
+    /// A moving average of how long sessions of this lift last, in seconds
+    std::optional<double> mean_session_duration;
+  };
+
   std::unordered_map<std::string, LiftRequest::UniquePtr> _active_sessions;
+  std::unordered_map<std::string, LiftRecord> _lifts;
+
+  using WaitEstimatesPub = rclcpp::Publisher<std_msgs::msg::String>;
+  WaitEstimatesPub::SharedPtr _wait_estimates_pub;
+
+  rclcpp::Duration _queue_timeout = rclcpp::Duration::from_seconds(5.0);
+  std::size_t _max_overtakes = 0;
 };
 
 } // namespace lift_supervisor
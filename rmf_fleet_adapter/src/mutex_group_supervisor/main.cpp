@@ -24,9 +24,14 @@
 #include <rclcpp/node.hpp>
 #include <rclcpp/executors.hpp>
 
+#include <algorithm>
 #include <unordered_map>
+#include <unordered_set>
+#include <map>
 #include <queue>
 #include <chrono>
+#include <sstream>
+#include <vector>
 
 struct TimeStamps
 {
@@ -70,6 +75,16 @@ public:
     heartbeat_timer = create_wall_timer(
       std::chrono::seconds(2),
       [&]() { do_heartbeat(); });
+
+    // Changes to the assignments are published as soon as they happen, with
+    // only the groups that changed. Every assignment is published with this
+    // period in seconds, so that late subscribers can catch up.
+    const double snapshot_period = declare_parameter<double>(
+      "state_snapshot_period", 2.0);
+    snapshot_timer = create_wall_timer(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(std::max(snapshot_period, 0.1))),
+      [&]() { state_pub->publish(latest_states); });
   }
 
   void handle_request(const MutexGroupRequest& request)
@@ -86,8 +101,9 @@ public:
           if (c_it->second.claim_time <= request.claim_time)
           {
             g_it->second.erase(c_it);
+            forget_claim(request.group, request.claimant);
             pick_next(request.group);
-            state_pub->publish(latest_states);
+            publish_changes();
           }
         }
       }
@@ -98,15 +114,17 @@ public:
     auto claim_time = rclcpp::Time(request.claim_time);
     auto timestamps = TimeStamps { request.claim_time, now };
     claims.insert_or_assign(request.claimant, timestamps);
-    for (const auto& s : latest_states.assignments)
+    claimant_groups[request.claimant].insert(request.group);
+    expirations.push({now, request.group, request.claimant});
+    if (current_claimant(request.group) != Unclaimed)
     {
-      if (s.group == request.group && s.claimant != Unclaimed)
-      {
-        check_for_conflicts();
-        return;
-      }
+      check_for_conflicts();
     }
-    pick_next(request.group);
+    else
+    {
+      pick_next(request.group);
+    }
+    publish_changes();
   }
 
   void do_heartbeat()
@@ -114,45 +132,80 @@ public:
     const auto now = std::chrono::steady_clock::now();
     // TODO(MXG): Make this timeout configurable
     const auto timeout = std::chrono::seconds(10);
-    for (auto& [group, claims] : mutex_groups)
+
+    // Only the claims that have gone quiet are visited. Entries for claims
+    // that were renewed or released since are skipped.
+    std::unordered_set<std::string> need_next_pick;
+    while (!expirations.empty() && expirations.top().time + timeout < now)
     {
-      std::vector<uint64_t> remove_claims;
-      for (const auto& [claimant, timestamp] : claims)
+      const auto expiration = expirations.top();
+      expirations.pop();
+
+      const auto g_it = mutex_groups.find(expiration.group);
+      if (g_it == mutex_groups.end())
+        continue;
+
+      const auto c_it = g_it->second.find(expiration.claimant);
+      if (c_it == g_it->second.end()
+        || c_it->second.heartbeat_time != expiration.time)
       {
-        if (timestamp.heartbeat_time + timeout < now)
-        {
-          remove_claims.push_back(claimant);
-        }
+        continue;
       }
 
-      uint64_t current_claimer = Unclaimed;
-      for (const auto& assignment : latest_states.assignments)
+      if (current_claimant(expiration.group) == expiration.claimant)
       {
-        if (assignment.group == group)
-        {
-          current_claimer = assignment.claimant;
-          break;
-        }
+        need_next_pick.insert(expiration.group);
       }
 
-      bool need_next_pick = false;
-      for (const auto& remove_claim : remove_claims)
-      {
-        if (current_claimer == remove_claim)
-        {
-          need_next_pick = true;
-        }
+      g_it->second.erase(c_it);
+      forget_claim(expiration.group, expiration.claimant);
+    }
 
-        claims.erase(remove_claim);
-      }
+    for (const auto& group : need_next_pick)
+    {
+      pick_next(group);
+    }
 
-      if (need_next_pick)
-      {
-        pick_next(group);
-      }
+    publish_changes();
+  }
+
+  /// Publish the assignments that have changed since the last time
+  void publish_changes()
+  {
+    if (changed_groups.empty())
+      return;
+
+    auto changes = rmf_fleet_msgs::build<MutexGroupStates>()
+      .assignments({});
+    changes.assignments.reserve(changed_groups.size());
+    for (const auto& group : changed_groups)
+    {
+      changes.assignments.push_back(
+        latest_states.assignments[assignment_index.at(group)]);
     }
+    changed_groups.clear();
+
+    state_pub->publish(changes);
+  }
+
+  uint64_t current_claimant(const std::string& group) const
+  {
+    const auto it = assignment_index.find(group);
+    if (it == assignment_index.end())
+      return Unclaimed;
 
-    state_pub->publish(latest_states);
+    return latest_states.assignments[it->second].claimant;
+  }
+
+  void forget_claim(const std::string& group, uint64_t claimant)
+  {
+    const auto it = claimant_groups.find(claimant);
+    if (it == claimant_groups.end())
+      return;
+
+    it->second.erase(group);
+    if (it->second.empty())
+      claimant_groups.erase(it);
   }
 
   struct ClaimList
@@ -185,42 +238,52 @@ public:
 
   void check_for_conflicts()
   {
-    std::unordered_map<uint64_t, ClaimList> claims;
-    for (const auto& [group, group_claims] : mutex_groups)
+    // Claimants can only conflict if they want exactly the same combination
+    // of groups, so they are bucketed by their combination instead of being
+    // compared pairwise.
+    std::map<std::vector<std::string>, std::vector<uint64_t>> combinations;
+    for (const auto& [claimant, groups] : claimant_groups)
     {
-      for (const auto& [claimant, timestamps] : group_claims)
-      {
-        claims[claimant].insert(group, timestamps.claim_time);
-      }
+      if (groups.size() < 2)
+        continue;
+
+      std::vector<std::string> combination(groups.begin(), groups.end());
+      std::sort(combination.begin(), combination.end());
+      combinations[std::move(combination)].push_back(claimant);
     }
 
     std::unordered_set<std::string> normalized_groups;
-    for (auto i = claims.begin(); i != claims.end(); ++i)
+    for (const auto& [combination, claimants] : combinations)
     {
-      auto j = i;
-      ++j;
-      for (; j != claims.end(); ++j)
+      if (claimants.size() < 2)
+        continue;
+
+      std::stringstream ss;
+      for (const auto& group : combination)
       {
-        const auto& claim_i = i->second;
-        const auto& claim_j = j->second;
-        if (claim_i.groups == claim_j.groups && claim_i.groups.size() > 1)
-        {
-          claim_i.normalize(i->first, mutex_groups);
-          claim_j.normalize(j->first, mutex_groups);
+        normalized_groups.insert(group);
+        ss << "[" << group << "]";
+      }
 
-          std::stringstream ss;
-          for (const auto& group : claim_i.groups)
-          {
-            normalized_groups.insert(group);
-            ss << "[" << group << "]";
-          }
+      for (const auto claimant : claimants)
+      {
+        ClaimList claim;
+        for (const auto& group : combination)
+          claim.insert(group, mutex_groups[group][claimant].claim_time);
 
+        claim.normalize(claimant, mutex_groups);
+      }
+
+      for (std::size_t i = 0; i < claimants.size(); ++i)
+      {
+        for (std::size_t j = i + 1; j < claimants.size(); ++j)
+        {
           RCLCPP_INFO(
             get_logger(),
             "Resolving mutex conflict between claimants [%lu] and [%lu] which both "
             "want the mutex combination %s",
-            i->first,
-            j->first,
+            claimants[i],
+            claimants[j],
             ss.str().c_str());
         }
       }
@@ -250,31 +313,57 @@ public:
       claim_time = earliest->first;
       claimant = earliest->second;
     }
-    bool group_found = false;
-    for (auto& a : latest_states.assignments)
+    const auto index = assignment_index.find(group);
+    if (index != assignment_index.end())
     {
-      if (a.group == group)
+      auto& a = latest_states.assignments[index->second];
+      if (a.claimant != claimant || a.claim_time != claim_time)
       {
         a.claimant = claimant;
         a.claim_time = claim_time;
-        group_found = true;
-        break;
+        changed_groups.insert(group);
       }
     }
-    if (!group_found)
+    else
     {
+      assignment_index[group] = latest_states.assignments.size();
       latest_states.assignments.push_back(
         rmf_fleet_msgs::build<MutextGroupAssignment>()
         .group(group)
         .claimant(claimant)
         .claim_time(claim_time));
+      changed_groups.insert(group);
     }
   }
 
+  /// When a claim should be checked for having gone quiet. A claim may be
+  /// in here several times, and only the entry that matches its latest
+  /// heartbeat counts.
+  struct Expiration
+  {
+    std::chrono::steady_clock::time_point time;
+    std::string group;
+    uint64_t claimant;
+
+    bool operator>(const Expiration& other) const
+    {
+      return time > other.time;
+    }
+  };
+
   std::unordered_map<std::string, ClaimMap> mutex_groups;
+  /// The groups that each claimant is claiming
+  std::unordered_map<uint64_t, std::unordered_set<std::string>> claimant_groups;
+  /// Where each group is in latest_states.assignments
+  std::unordered_map<std::string, std::size_t> assignment_index;
+  /// Groups whose assignment has changed since it was last published
+  std::unordered_set<std::string> changed_groups;
+  std::priority_queue<Expiration, std::vector<Expiration>,
+    std::greater<Expiration>> expirations;
   rclcpp::Subscription<MutexGroupRequest>::SharedPtr request_sub;
   rclcpp::Publisher<MutexGroupStates>::SharedPtr state_pub;
   rclcpp::TimerBase::SharedPtr heartbeat_timer;
+  rclcpp::TimerBase::SharedPtr snapshot_timer;
   MutexGroupStates latest_states;
 };
 
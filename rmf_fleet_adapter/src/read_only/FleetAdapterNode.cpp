@@ -48,6 +48,15 @@ std::shared_ptr<FleetAdapterNode> FleetAdapterNode::make()
   node->_delay_threshold =
     get_parameter_or_default_time(*node, "delay_threshold", 5.0);
 
+  // Fleets whose robots are often held up, or whose path estimates jitter a
+  // little between reports, can raise these so that more of their updates
+  // are sent to the schedule as delays instead of new itineraries.
+  node->_max_cumulative_delay =
+    get_parameter_or_default_time(*node, "max_cumulative_delay", 5.0);
+
+  node->_path_tolerance =
+    get_parameter_or_default(*node, "path_tolerance", 1e-8);
+
   auto mirror_future = rmf_traffic_ros2::schedule::make_mirror(
     node, rmf_traffic::schedule::query_all());
 
@@ -266,8 +275,7 @@ bool FleetAdapterNode::handle_delay(
     const Eigen::Vector3d p_state{l_state.x, l_state.y, l_state.yaw};
     const Eigen::Vector3d p_entry{l_entry.x, l_entry.y, l_entry.yaw};
 
-    // TODO(MXG): Make this threshold configurable
-    if ((p_state - p_entry).norm() > 1e-8)
+    if ((p_state - p_entry).norm() > _path_tolerance)
       return false;
   }
 
@@ -306,10 +314,9 @@ bool FleetAdapterNode::handle_delay(
       *entry.route->trajectory().finish_time();
     if (delay > std::chrono::seconds(1))
     {
-      entry.cumulative_delay += delay;
-      if (entry.cumulative_delay >= MaxCumulativeDelay)
-        return false;
-
+      // The cumulative delay is not capped here. A sitting trajectory keeps
+      // its shape no matter how far it is pushed back, so there is nothing to
+      // be gained by replacing it.
       entry.route->trajectory().back().adjust_times(delay);
       entry.schedule->push_delay(delay);
     }
@@ -343,7 +350,7 @@ bool FleetAdapterNode::handle_delay(
   }
 
   entry.cumulative_delay += time_difference;
-  if (entry.cumulative_delay >= MaxCumulativeDelay)
+  if (entry.cumulative_delay >= _max_cumulative_delay)
     return false;
 
   // There was a considerable difference between the scheduled finishing time
@@ -59,6 +59,14 @@ private:
 
   rmf_traffic::Duration _delay_threshold;
 
+  // How much the cumulative delay on the schedule may differ from the
+  // original route before the route is replaced instead of delayed
+  rmf_traffic::Duration _max_cumulative_delay;
+
+  // How far a waypoint may move between two reports of the same path before
+  // the path is considered new
+  double _path_tolerance;
+
   using FleetState = rmf_fleet_msgs::msg::FleetState;
   rclcpp::Subscription<FleetState>::SharedPtr _fleet_state_subscription;
 
@@ -104,8 +112,6 @@ private:
   bool handle_delay(
     const RobotState& state,
     const ScheduleEntries::iterator& it);
-
-  const rmf_traffic::Duration MaxCumulativeDelay = std::chrono::seconds(5);
 };
 
 } // namespace read_only
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ActionPipeline.hpp"
+
+namespace rmf_fleet_adapter {
+
+namespace {
+//==============================================================================
+// How far apart the expected start of an action and the expected finish of
+// the action before it may be for the two to still count as back to back.
+const rmf_traffic::Duration BackToBackTolerance = std::chrono::seconds(5);
+
+// How far the robot may be from a hold for the hold to still count as being
+// at the robot's location.
+const double HoldPositionTolerance = 0.1;
+} // anonymous namespace
+
+//==============================================================================
+ActionPipeline::Ticket::Ticket(
+  std::weak_ptr<ActionPipeline> pipeline,
+  std::size_t key)
+: _pipeline(std::move(pipeline)),
+  _key(key)
+{
+  // Do nothing
+}
+
+//==============================================================================
+ActionPipeline::Ticket::~Ticket()
+{
+  if (const auto pipeline = _pipeline.lock())
+    pipeline->_withdraw(_key);
+}
+
+//==============================================================================
+std::shared_ptr<ActionPipeline> ActionPipeline::make()
+{
+  std::shared_ptr<ActionPipeline> pipeline(new ActionPipeline);
+  pipeline->_weak_self = pipeline;
+  return pipeline;
+}
+
+//==============================================================================
+auto ActionPipeline::prepare(Action action) -> std::shared_ptr<Ticket>
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto key = _next_key++;
+  _actions.insert({key, std::move(action)});
+  return std::shared_ptr<Ticket>(new Ticket(_weak_self, key));
+}
+
+//==============================================================================
+void ActionPipeline::start(const Ticket& ticket)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _actions.erase(_actions.begin(), _actions.lower_bound(ticket._key));
+}
+
+//==============================================================================
+auto ActionPipeline::next(const Ticket& ticket) const -> std::optional<Action>
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto it = _actions.find(ticket._key);
+  if (it == _actions.end())
+    return std::nullopt;
+
+  const auto next_it = std::next(it);
+  if (next_it == _actions.end() || !_back_to_back(it->second, next_it->second))
+    return std::nullopt;
+
+  return next_it->second;
+}
+
+//==============================================================================
+rmf_traffic::Duration ActionPipeline::following_duration(
+  const Ticket& ticket) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  rmf_traffic::Duration duration(0);
+  auto it = _actions.find(ticket._key);
+  if (it == _actions.end())
+    return duration;
+
+  for (auto next_it = std::next(it); next_it != _actions.end(); ++next_it)
+  {
+    if (!_back_to_back(it->second, next_it->second))
+      break;
+
+    duration += next_it->second.duration_estimate;
+    it = next_it;
+  }
+
+  return duration;
+}
+
+//==============================================================================
+void ActionPipeline::hold(
+  rmf_traffic::PlanId plan_id,
+  std::string map,
+  Eigen::Vector3d position,
+  rmf_traffic::Time until)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _hold = Hold{plan_id, std::move(map), position, until};
+}
+
+//==============================================================================
+bool ActionPipeline::hold_covers(
+  rmf_traffic::PlanId plan_id,
+  const std::string& map,
+  const Eigen::Vector3d& position,
+  rmf_traffic::Time finish) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_hold.has_value())
+    return false;
+
+  const Eigen::Vector2d p0 = _hold->position.block<2, 1>(0, 0);
+  const Eigen::Vector2d p1 = position.block<2, 1>(0, 0);
+  return _hold->plan_id == plan_id
+    && _hold->map == map
+    && (p1 - p0).norm() <= HoldPositionTolerance
+    && finish <= _hold->until;
+}
+
+//==============================================================================
+std::size_t ActionPipeline::size() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _actions.size();
+}
+
+//==============================================================================
+void ActionPipeline::_withdraw(std::size_t key)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _actions.erase(key);
+}
+
+//==============================================================================
+bool ActionPipeline::_back_to_back(
+  const Action& first,
+  const Action& second) const
+{
+  if (!first.waypoint.has_value() || first.waypoint != second.waypoint)
+    return false;
+
+  if (!first.start_time.has_value() || !second.start_time.has_value())
+    return false;
+
+  const auto expected_start = *first.start_time + first.duration_estimate;
+  const auto gap = *second.start_time - expected_start;
+  return -BackToBackTolerance <= gap && gap <= BackToBackTolerance;
+}
+
+} // namespace rmf_fleet_adapter
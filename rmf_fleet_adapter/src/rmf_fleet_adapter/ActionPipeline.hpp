@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__ACTIONPIPELINE_HPP
+#define SRC__RMF_FLEET_ADAPTER__ACTIONPIPELINE_HPP
+
+#include <rmf_traffic/Time.hpp>
+#include <rmf_traffic/schedule/Itinerary.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <Eigen/Geometry>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// Keeps track of the custom actions that a robot has been given but has not
+/// started yet, so that the next action can be prepared while the current one
+/// runs.
+///
+/// Actions are prepared in the order that they will run. Two actions are back
+/// to back when the second one is expected to start at the same waypoint, right
+/// after the first one finishes. A chain of back-to-back actions shares a
+/// single hold on the traffic schedule, so the robot does not need to update
+/// its itinerary between them.
+class ActionPipeline
+{
+public:
+
+  struct Action
+  {
+    std::string category;
+    nlohmann::json description;
+    rmf_traffic::Duration duration_estimate;
+
+    /// The waypoint where the action is expected to start, if known
+    std::optional<std::size_t> waypoint;
+
+    /// The time that the action is expected to start, if known
+    std::optional<rmf_traffic::Time> start_time;
+  };
+
+  /// An action that is in the pipeline. The action leaves the pipeline when
+  /// its ticket is destroyed.
+  class Ticket
+  {
+  public:
+    ~Ticket();
+
+  private:
+    friend class ActionPipeline;
+    Ticket(std::weak_ptr<ActionPipeline> pipeline, std::size_t key);
+    std::weak_ptr<ActionPipeline> _pipeline;
+    std::size_t _key;
+  };
+
+  static std::shared_ptr<ActionPipeline> make();
+
+  /// Add an action that will run after every action that was prepared before
+  /// it.
+  std::shared_ptr<Ticket> prepare(Action action);
+
+  /// The action of this ticket has started. Actions that were prepared before
+  /// it will never run, so they leave the pipeline. The action itself stays
+  /// until its ticket is destroyed.
+  void start(const Ticket& ticket);
+
+  /// Get the action that will run right after the action of this ticket, if
+  /// that action is back to back with it.
+  std::optional<Action> next(const Ticket& ticket) const;
+
+  /// Get the total duration estimate of the chain of back-to-back actions that
+  /// follow the action of this ticket.
+  rmf_traffic::Duration following_duration(const Ticket& ticket) const;
+
+  /// Remember that a hold was put on the schedule for a chain of actions.
+  void hold(
+    rmf_traffic::PlanId plan_id,
+    std::string map,
+    Eigen::Vector3d position,
+    rmf_traffic::Time until);
+
+  /// Check whether the last hold is still on the schedule under plan_id and
+  /// covers an action at the given location that finishes at the given time.
+  bool hold_covers(
+    rmf_traffic::PlanId plan_id,
+    const std::string& map,
+    const Eigen::Vector3d& position,
+    rmf_traffic::Time finish) const;
+
+  /// Get how many actions are in the pipeline
+  std::size_t size() const;
+
+private:
+
+  ActionPipeline() = default;
+
+  void _withdraw(std::size_t key);
+
+  bool _back_to_back(const Action& first, const Action& second) const;
+
+  struct Hold
+  {
+    rmf_traffic::PlanId plan_id;
+    std::string map;
+    Eigen::Vector3d position;
+    rmf_traffic::Time until;
+  };
+
+  std::weak_ptr<ActionPipeline> _weak_self;
+  std::map<std::size_t, Action> _actions;
+  std::size_t _next_key = 0;
+  std::optional<Hold> _hold;
+  mutable std::mutex _mutex;
+};
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__ACTIONPIPELINE_HPP
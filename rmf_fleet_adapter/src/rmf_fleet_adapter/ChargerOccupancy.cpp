@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ChargerOccupancy.hpp"
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+std::shared_ptr<ChargerOccupancy> ChargerOccupancy::make()
+{
+  return std::shared_ptr<ChargerOccupancy>(new ChargerOccupancy);
+}
+
+//==============================================================================
+void ChargerOccupancy::assign(const std::string& robot, std::size_t charger)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto [it, inserted] = _charger_of_robot.insert({robot, charger});
+  if (!inserted)
+  {
+    if (it->second == charger)
+      return;
+
+    const auto previous = _robots_at_charger.find(it->second);
+    if (previous != _robots_at_charger.end() && --previous->second == 0)
+      _robots_at_charger.erase(previous);
+
+    it->second = charger;
+  }
+
+  ++_robots_at_charger[charger];
+}
+
+//==============================================================================
+std::optional<std::size_t> ChargerOccupancy::charger_of(
+  const std::string& robot) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto it = _charger_of_robot.find(robot);
+  if (it == _charger_of_robot.end())
+    return std::nullopt;
+
+  return it->second;
+}
+
+//==============================================================================
+std::size_t ChargerOccupancy::assigned(std::size_t charger) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto it = _robots_at_charger.find(charger);
+  if (it == _robots_at_charger.end())
+    return 0;
+
+  return it->second;
+}
+
+//==============================================================================
+std::optional<double> ChargerOccupancy::retreat_drain(
+  const std::shared_ptr<const void>& planner,
+  std::size_t start,
+  std::size_t charger) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_is_drain_planner(planner))
+    return std::nullopt;
+
+  const auto it = _drains.find(_key(start, charger));
+  if (it == _drains.end())
+    return std::nullopt;
+
+  return it->second;
+}
+
+//==============================================================================
+void ChargerOccupancy::record_retreat_drain(
+  const std::shared_ptr<const void>& planner,
+  std::size_t start,
+  std::size_t charger,
+  double drain)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_is_drain_planner(planner))
+  {
+    _drains.clear();
+    _drain_planner = planner;
+  }
+
+  _drains[_key(start, charger)] = drain;
+}
+
+//==============================================================================
+bool ChargerOccupancy::_is_drain_planner(
+  const std::shared_ptr<const void>& planner) const
+{
+  return !_drain_planner.owner_before(planner)
+    && !planner.owner_before(_drain_planner);
+}
+
+//==============================================================================
+uint64_t ChargerOccupancy::_key(std::size_t start, std::size_t charger)
+{
+  return (static_cast<uint64_t>(start) << 32)
+    | static_cast<uint64_t>(charger & 0xFFFFFFFF);
+}
+
+} // namespace rmf_fleet_adapter
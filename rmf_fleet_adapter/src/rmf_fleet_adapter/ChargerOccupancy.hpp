@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__CHARGEROCCUPANCY_HPP
+#define SRC__RMF_FLEET_ADAPTER__CHARGEROCCUPANCY_HPP
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// Keeps track of the chargers of a fleet, so that charger decisions do not
+/// need to scan every robot of the fleet or plan the same trip again.
+///
+/// The model knows which charger each robot is assigned to and how many robots
+/// share each charger. It is updated one robot at a time whenever a charger
+/// gets assigned.
+///
+/// It also remembers how much battery it takes to get from a waypoint to a
+/// charger. Every robot of a fleet shares the same battery and motion models,
+/// so one robot's estimate is valid for the others too. The estimates belong to
+/// the planner that they were made with and are forgotten when a different
+/// planner asks for them.
+class ChargerOccupancy
+{
+public:
+
+  static std::shared_ptr<ChargerOccupancy> make();
+
+  /// Assign a robot to a charger, replacing its previous charger.
+  void assign(const std::string& robot, std::size_t charger);
+
+  /// Get the charger of a robot, if it has been assigned one.
+  std::optional<std::size_t> charger_of(const std::string& robot) const;
+
+  /// Get how many robots are assigned to a charger.
+  std::size_t assigned(std::size_t charger) const;
+
+  /// Get the battery fraction that it takes to get from a waypoint to a
+  /// charger, if it has already been estimated with this planner.
+  std::optional<double> retreat_drain(
+    const std::shared_ptr<const void>& planner,
+    std::size_t start,
+    std::size_t charger) const;
+
+  /// Remember the battery fraction that it takes to get from a waypoint to a
+  /// charger. Estimates made with any other planner are forgotten.
+  void record_retreat_drain(
+    const std::shared_ptr<const void>& planner,
+    std::size_t start,
+    std::size_t charger,
+    double drain);
+
+private:
+
+  ChargerOccupancy() = default;
+
+  static uint64_t _key(std::size_t start, std::size_t charger);
+
+  bool _is_drain_planner(const std::shared_ptr<const void>& planner) const;
+
+  std::unordered_map<std::string, std::size_t> _charger_of_robot;
+  std::unordered_map<std::size_t, std::size_t> _robots_at_charger;
+
+  // A weak pointer keeps the control block of the planner alive, so a new
+  // planner can never be mistaken for this one.
+  std::weak_ptr<const void> _drain_planner;
+  std::unordered_map<uint64_t, double> _drains;
+  mutable std::mutex _mutex;
+};
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__CHARGEROCCUPANCY_HPP
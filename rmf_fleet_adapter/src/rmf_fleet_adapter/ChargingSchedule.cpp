@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ChargingSchedule.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace rmf_fleet_adapter {
+
+namespace {
+//==============================================================================
+constexpr uint32_t MinutesPerDay = 24*60;
+
+//==============================================================================
+uint32_t parse_time_of_day(const std::string& text)
+{
+  const auto colon = text.find(':');
+  const auto fail = [&]()
+    {
+      return std::runtime_error(
+        "Charging schedule time [" + text + "] is not in the HH:MM format");
+    };
+
+  if (colon == std::string::npos || colon == 0 || colon + 1 == text.size())
+    throw fail();
+
+  std::size_t hh_end = 0;
+  std::size_t mm_end = 0;
+  int hh = 0;
+  int mm = 0;
+  try
+  {
+    hh = std::stoi(text.substr(0, colon), &hh_end);
+    mm = std::stoi(text.substr(colon + 1), &mm_end);
+  }
+  catch (const std::exception&)
+  {
+    throw fail();
+  }
+
+  if (hh_end != colon || mm_end != text.size() - colon - 1
+    || hh < 0 || 23 < hh || mm < 0 || 59 < mm)
+  {
+    throw fail();
+  }
+
+  return static_cast<uint32_t>(hh*60 + mm);
+}
+} // anonymous namespace
+
+//==============================================================================
+std::shared_ptr<ChargingSchedule> ChargingSchedule::make(
+  const YAML::Node& schedule,
+  const std::string& fleet_name,
+  const bool use_sim_time)
+{
+  std::shared_ptr<ChargingSchedule> output(
+    new ChargingSchedule(use_sim_time));
+
+  if (!schedule.IsMap())
+    throw std::runtime_error("Charging schedule must be a map of fleets");
+
+  std::unordered_set<std::string> parking;
+  if (const auto parking_yaml = schedule["parking"])
+  {
+    for (const auto& wp : parking_yaml)
+      parking.insert(wp.as<std::string>());
+  }
+
+  const auto fleet_yaml = schedule[fleet_name];
+  if (!fleet_yaml)
+    return output;
+
+  if (!fleet_yaml.IsMap())
+  {
+    throw std::runtime_error(
+            "Charging schedule of fleet [" + fleet_name + "] must be a map of "
+            "times to assignments");
+  }
+
+  for (const auto& change : fleet_yaml)
+  {
+    const auto minute = parse_time_of_day(change.first.as<std::string>());
+    for (const auto& assignment : change.second)
+    {
+      auto waypoint = assignment.second.as<std::string>();
+      const bool wait = parking.count(waypoint) > 0;
+      output->_entries[assignment.first.as<std::string>()].push_back(
+        Entry{minute, Assignment{std::move(waypoint), wait}});
+    }
+  }
+
+  for (auto& [_, entries] : output->_entries)
+  {
+    std::stable_sort(
+      entries.begin(), entries.end(),
+      [](const Entry& a, const Entry& b)
+      {
+        return a.minute < b.minute;
+      });
+  }
+
+  return output;
+}
+
+//==============================================================================
+auto ChargingSchedule::at(
+  const std::string& robot,
+  const rmf_traffic::Time time) const -> const Assignment*
+{
+  const auto it = _entries.find(robot);
+  if (it == _entries.end() || it->second.empty())
+    return nullptr;
+
+  const auto& entries = it->second;
+  const auto minute = minute_of_day(time);
+  const auto next = std::upper_bound(
+    entries.begin(), entries.end(), minute,
+    [](uint32_t m, const Entry& entry)
+    {
+      return m < entry.minute;
+    });
+
+  // Before the first entry of the day, the last entry of yesterday applies
+  if (next == entries.begin())
+    return &entries.back().assignment;
+
+  return &std::prev(next)->assignment;
+}
+
+//==============================================================================
+std::vector<std::string> ChargingSchedule::robots() const
+{
+  std::vector<std::string> output;
+  output.reserve(_entries.size());
+  for (const auto& [robot, _] : _entries)
+    output.push_back(robot);
+
+  return output;
+}
+
+//==============================================================================
+uint32_t ChargingSchedule::minute_of_day(const rmf_traffic::Time time) const
+{
+  const auto since_epoch = time.time_since_epoch();
+  if (_use_sim_time)
+  {
+    const auto minutes =
+      std::chrono::duration_cast<std::chrono::minutes>(since_epoch).count();
+    return static_cast<uint32_t>(
+      ((minutes % MinutesPerDay) + MinutesPerDay) % MinutesPerDay);
+  }
+
+  const std::time_t seconds = static_cast<std::time_t>(
+    std::chrono::duration_cast<std::chrono::seconds>(since_epoch).count());
+  std::tm local;
+  localtime_r(&seconds, &local);
+  return static_cast<uint32_t>(local.tm_hour*60 + local.tm_min);
+}
+
+//==============================================================================
+ChargingSchedule::ChargingSchedule(const bool use_sim_time)
+: _use_sim_time(use_sim_time)
+{
+  // Do nothing
+}
+
+} // namespace rmf_fleet_adapter
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__CHARGINGSCHEDULE_HPP
+#define SRC__RMF_FLEET_ADAPTER__CHARGINGSCHEDULE_HPP
+
+#include <rmf_traffic/Time.hpp>
+
+#include <yaml-cpp/yaml.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// The charger rotation of one fleet, loaded from the same schedule file that
+/// rmf_charging_schedule publishes assignments from. Knowing the whole
+/// rotation ahead of time lets the fleet plan tasks with the charger that a
+/// robot will have when it gets to them, instead of the charger it has now.
+///
+/// The schedule cycles every 24 hours. For each robot, the assignment of the
+/// latest entry at or before a time of day is in effect at that time. Before
+/// the first entry of the day, the last entry of the previous day is still in
+/// effect.
+class ChargingSchedule
+{
+public:
+
+  struct Assignment
+  {
+    std::string waypoint;
+
+    /// True if the waypoint is a parking spot where the robot waits for a
+    /// charger instead of charging
+    bool wait;
+  };
+
+  /// Make the schedule of one fleet.
+  ///
+  /// \param[in] schedule
+  ///   The root of the schedule file.
+  ///
+  /// \param[in] fleet_name
+  ///   The fleet whose entries should be loaded. Entries of other fleets are
+  ///   ignored.
+  ///
+  /// \param[in] use_sim_time
+  ///   If true, midnight is at time zero like in simulation. Otherwise times of
+  ///   day are in the local timezone.
+  ///
+  /// \throws std::runtime_error if an entry of the fleet is malformed.
+  static std::shared_ptr<ChargingSchedule> make(
+    const YAML::Node& schedule,
+    const std::string& fleet_name,
+    bool use_sim_time);
+
+  /// Get the assignment of a robot at a time, or nullptr if the schedule has
+  /// no entries for the robot.
+  const Assignment* at(const std::string& robot, rmf_traffic::Time time) const;
+
+  /// Get the names of the robots that have entries in the schedule.
+  std::vector<std::string> robots() const;
+
+  /// Get the minute of the day, from 0 to 1439, that a time falls on.
+  uint32_t minute_of_day(rmf_traffic::Time time) const;
+
+private:
+
+  ChargingSchedule(bool use_sim_time);
+
+  struct Entry
+  {
+    uint32_t minute;
+    Assignment assignment;
+  };
+
+  // The entries of each robot, sorted by minute
+  std::unordered_map<std::string, std::vector<Entry>> _entries;
+  bool _use_sim_time;
+};
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__CHARGINGSCHEDULE_HPP
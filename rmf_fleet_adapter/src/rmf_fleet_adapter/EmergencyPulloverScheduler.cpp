@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "EmergencyPulloverScheduler.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace rmf_fleet_adapter {
+
+namespace {
+//==============================================================================
+class PassageDetector : public rmf_traffic::agv::Graph::Lane::Executor
+{
+public:
+  bool passage = false;
+
+  void execute(const Dock&) final {}
+  void execute(const Wait&) final {}
+  void execute(const DoorOpen&) final { passage = true; }
+  void execute(const DoorClose&) final { passage = true; }
+  void execute(const LiftSessionBegin&) final { passage = true; }
+  void execute(const LiftMove&) final { passage = true; }
+  void execute(const LiftDoorOpen&) final { passage = true; }
+  void execute(const LiftSessionEnd&) final { passage = true; }
+};
+
+//==============================================================================
+/// True if the lane passes through a door or a lift
+bool is_passage(const rmf_traffic::agv::Graph::Lane& lane)
+{
+  PassageDetector detector;
+  if (const auto* event = lane.entry().event())
+    event->execute(detector);
+
+  if (const auto* event = lane.exit().event())
+    event->execute(detector);
+
+  return detector.passage;
+}
+
+//==============================================================================
+bool next_to_passage(
+  const rmf_traffic::agv::Graph& graph,
+  const std::size_t waypoint)
+{
+  for (const std::size_t lane : graph.lanes_from(waypoint))
+  {
+    if (is_passage(graph.get_lane(lane)))
+      return true;
+  }
+
+  for (const std::size_t lane : graph.lanes_into(waypoint))
+  {
+    if (is_passage(graph.get_lane(lane)))
+      return true;
+  }
+
+  return false;
+}
+} // anonymous namespace
+
+//==============================================================================
+auto EmergencyPulloverScheduler::assess(
+  const rmf_traffic::agv::Graph& graph,
+  const rmf_traffic::agv::Plan::StartSet& starts) -> Hazard
+{
+  // A robot that is on a waypoint also gets a start for each lane that leaves
+  // the waypoint, so a start without a lane takes precedence.
+  for (const auto& start : starts)
+  {
+    if (start.lane().has_value())
+      continue;
+
+    const std::size_t wp = start.waypoint();
+    if (wp >= graph.num_waypoints())
+      continue;
+
+    const auto& waypoint = graph.get_waypoint(wp);
+    if (waypoint.is_parking_spot())
+      return Hazard::Parked;
+
+    if (next_to_passage(graph, wp))
+      return Hazard::Doorway;
+
+    if (waypoint.is_holding_point())
+      return Hazard::Holding;
+
+    return Hazard::Waypoint;
+  }
+
+  if (starts.empty())
+    return Hazard::Waypoint;
+
+  for (const auto& start : starts)
+  {
+    const std::size_t lane = *start.lane();
+    if (lane < graph.num_lanes() && is_passage(graph.get_lane(lane)))
+      return Hazard::Doorway;
+
+    if (start.waypoint() < graph.num_waypoints()
+      && next_to_passage(graph, start.waypoint()))
+    {
+      return Hazard::Doorway;
+    }
+  }
+
+  return Hazard::Lane;
+}
+
+//==============================================================================
+std::shared_ptr<EmergencyPulloverScheduler> EmergencyPulloverScheduler::make(
+  rxcpp::schedulers::worker worker,
+  const std::size_t max_concurrent)
+{
+  return std::shared_ptr<EmergencyPulloverScheduler>(
+    new EmergencyPulloverScheduler(std::move(worker), max_concurrent));
+}
+
+//==============================================================================
+EmergencyPulloverScheduler::EmergencyPulloverScheduler(
+  rxcpp::schedulers::worker worker,
+  const std::size_t max_concurrent)
+: _worker(std::move(worker)),
+  _max_concurrent(max_concurrent)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void EmergencyPulloverScheduler::submit(const Hazard hazard, Start start)
+{
+  if (_max_concurrent == 0)
+  {
+    start(nullptr);
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  if (_running < _max_concurrent)
+  {
+    ++_running;
+    lock.unlock();
+    start(_make_ticket());
+    return;
+  }
+
+  _queue.push(Pending{_next_order++, hazard, std::move(start)});
+}
+
+//==============================================================================
+void EmergencyPulloverScheduler::claim(
+  const std::string& robot,
+  const std::size_t parking_spot)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _claims[robot] = parking_spot;
+}
+
+//==============================================================================
+void EmergencyPulloverScheduler::release(const std::string& robot)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _claims.erase(robot);
+}
+
+//==============================================================================
+void EmergencyPulloverScheduler::clear_claims()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _claims.clear();
+}
+
+//==============================================================================
+std::optional<std::vector<std::size_t>> EmergencyPulloverScheduler::unclaimed(
+  const rmf_traffic::agv::Graph& graph,
+  std::optional<std::vector<std::size_t>> candidates,
+  const std::string& robot) const
+{
+  std::unordered_set<std::size_t> claimed;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& [name, spot] : _claims)
+    {
+      if (name != robot)
+        claimed.insert(spot);
+    }
+  }
+
+  if (claimed.empty())
+    return candidates;
+
+  std::vector<std::size_t> remaining;
+  if (candidates.has_value())
+  {
+    for (const std::size_t spot : *candidates)
+    {
+      if (claimed.count(spot) == 0)
+        remaining.push_back(spot);
+    }
+  }
+  else
+  {
+    for (std::size_t i = 0; i < graph.num_waypoints(); ++i)
+    {
+      if (graph.get_waypoint(i).is_parking_spot() && claimed.count(i) == 0)
+        remaining.push_back(i);
+    }
+  }
+
+  if (remaining.empty())
+    return candidates;
+
+  return remaining;
+}
+
+//==============================================================================
+std::size_t EmergencyPulloverScheduler::max_concurrent() const
+{
+  return _max_concurrent;
+}
+
+//==============================================================================
+std::size_t EmergencyPulloverScheduler::running() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _running;
+}
+
+//==============================================================================
+std::size_t EmergencyPulloverScheduler::waiting() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _queue.size();
+}
+
+//==============================================================================
+auto EmergencyPulloverScheduler::_make_ticket() -> Ticket
+{
+  return Ticket(
+    nullptr,
+    [w = weak_from_this()](void*)
+    {
+      if (const auto self = w.lock())
+        self->_release();
+    });
+}
+
+//==============================================================================
+void EmergencyPulloverScheduler::_release()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  if (_queue.empty())
+  {
+    --_running;
+    return;
+  }
+
+  // Hand the slot directly to the most hazardous search that is waiting. It
+  // gets started on the worker because tickets are usually released while the
+  // search that held them is in the middle of delivering its result.
+  auto next = _queue.top().start;
+  _queue.pop();
+  lock.unlock();
+
+  _worker.schedule(
+    [start = std::move(next), ticket = _make_ticket()](const auto&)
+    {
+      start(ticket);
+    });
+}
+
+} // namespace rmf_fleet_adapter
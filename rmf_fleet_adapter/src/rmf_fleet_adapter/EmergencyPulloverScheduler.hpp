@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__EMERGENCYPULLOVERSCHEDULER_HPP
+#define SRC__RMF_FLEET_ADAPTER__EMERGENCYPULLOVERSCHEDULER_HPP
+
+#include <rmf_rxcpp/RxJobs.hpp>
+
+#include <rmf_traffic/agv/Planner.hpp>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// Decides the order that the robots of a fleet search for their emergency
+/// pullovers in. When an emergency begins, every robot of the fleet starts
+/// searching at the same moment. Instead of letting all of those searches
+/// compete for the processor, only a limited number of them run at once, and
+/// the robots in the most hazardous places, like doorways and lanes, go first.
+///
+/// The scheduler also keeps track of the parking spots that robots have
+/// already found pullovers to, so that robots which search later do not spend
+/// time on parking spots that are already taken.
+class EmergencyPulloverScheduler
+  : public std::enable_shared_from_this<EmergencyPulloverScheduler>
+{
+public:
+
+  /// How hazardous it is for a robot to stay where it is during an emergency.
+  /// Robots with a higher hazard search for their pullovers first.
+  enum class Hazard : uint8_t
+  {
+    /// The robot is already on a parking spot
+    Parked = 0,
+
+    /// The robot is on a holding point
+    Holding,
+
+    /// The robot is on any other waypoint
+    Waypoint,
+
+    /// The robot is in the middle of a lane
+    Lane,
+
+    /// The robot is on or next to a lane that passes through a door or lift
+    Doorway
+  };
+
+  /// Assess the hazard of a robot that is located at the given starts
+  static Hazard assess(
+    const rmf_traffic::agv::Graph& graph,
+    const rmf_traffic::agv::Plan::StartSet& starts);
+
+  /// Create a scheduler.
+  ///
+  /// \param[in] worker
+  ///   Searches that had to wait get started on this worker.
+  ///
+  /// \param[in] max_concurrent
+  ///   The maximum number of searches that can run at once. Zero means there
+  ///   is no limit.
+  static std::shared_ptr<EmergencyPulloverScheduler> make(
+    rxcpp::schedulers::worker worker,
+    std::size_t max_concurrent);
+
+  /// Held by a running search. The slot of the search is freed when the last
+  /// copy of its ticket is destroyed.
+  using Ticket = std::shared_ptr<void>;
+
+  /// Starts a search. The search must keep the ticket for as long as it is
+  /// running.
+  using Start = std::function<void(Ticket)>;
+
+  /// Submit a search. If there is a free slot it will be started right away,
+  /// before this function returns. Otherwise it waits in the queue behind
+  /// every search with a higher hazard.
+  void submit(Hazard hazard, Start start);
+
+  /// Record that a robot has found a pullover to a parking spot, replacing any
+  /// parking spot that it claimed before.
+  void claim(const std::string& robot, std::size_t parking_spot);
+
+  /// Forget the parking spot that a robot claimed, if it claimed any
+  void release(const std::string& robot);
+
+  /// Forget every claimed parking spot, e.g. because the emergency is over
+  void clear_claims();
+
+  /// Remove the parking spots that other robots have claimed from a set of
+  /// candidates.
+  ///
+  /// \param[in] graph
+  ///   The graph that the parking spots belong to.
+  ///
+  /// \param[in] candidates
+  ///   The parking spots that the robot would search, or std::nullopt to
+  ///   search every parking spot of the graph.
+  ///
+  /// \param[in] robot
+  ///   The robot that will search. Its own claim is not removed.
+  ///
+  /// \return the candidates without the claimed parking spots. If nothing was
+  /// claimed, or every candidate was claimed, the candidates are returned
+  /// unchanged, since a robot that shares a parking spot is still better off
+  /// than a robot with nowhere to go.
+  std::optional<std::vector<std::size_t>> unclaimed(
+    const rmf_traffic::agv::Graph& graph,
+    std::optional<std::vector<std::size_t>> candidates,
+    const std::string& robot) const;
+
+  /// Get the maximum number of searches that can run at once
+  std::size_t max_concurrent() const;
+
+  /// Get the number of searches that are currently running
+  std::size_t running() const;
+
+  /// Get the number of searches that are waiting to start
+  std::size_t waiting() const;
+
+private:
+
+  EmergencyPulloverScheduler(
+    rxcpp::schedulers::worker worker,
+    std::size_t max_concurrent);
+
+  struct Pending
+  {
+    uint64_t order;
+    Hazard hazard;
+    Start start;
+  };
+
+  struct ComparePending
+  {
+    // Returns true if a should go after b
+    bool operator()(const Pending& a, const Pending& b) const
+    {
+      if (a.hazard != b.hazard)
+        return a.hazard < b.hazard;
+
+      return b.order < a.order;
+    }
+  };
+
+  Ticket _make_ticket();
+  void _release();
+
+  rxcpp::schedulers::worker _worker;
+  const std::size_t _max_concurrent;
+
+  mutable std::mutex _mutex;
+  std::size_t _running = 0;
+  uint64_t _next_order = 0;
+  std::priority_queue<Pending, std::vector<Pending>, ComparePending> _queue;
+  std::unordered_map<std::string, std::size_t> _claims;
+};
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__EMERGENCYPULLOVERSCHEDULER_HPP
@@ -0,0 +1,389 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "FloorPlanner.hpp"
+
+#include <rmf_traffic/Time.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <unordered_set>
+
+namespace rmf_fleet_adapter {
+
+namespace {
+//==============================================================================
+/// Get the name of the lift that this lane moves through between two floors,
+/// or an empty string if the lane stays on one floor.
+std::string lift_between_floors(
+  const rmf_traffic::agv::Graph& graph,
+  const rmf_traffic::agv::Graph::Lane& lane)
+{
+  const auto& entry = graph.get_waypoint(lane.entry().waypoint_index());
+  const auto& exit = graph.get_waypoint(lane.exit().waypoint_index());
+  if (entry.get_map_name() == exit.get_map_name())
+    return "";
+
+  const auto entry_lift = entry.in_lift();
+  const auto exit_lift = exit.in_lift();
+  if (!entry_lift || !exit_lift || entry_lift->name() != exit_lift->name())
+    return "";
+
+  return entry_lift->name();
+}
+} // anonymous namespace
+
+//==============================================================================
+std::shared_ptr<FloorPlanner> FloorPlanner::make(std::size_t max_planners)
+{
+  return std::shared_ptr<FloorPlanner>(new FloorPlanner(max_planners));
+}
+
+//==============================================================================
+FloorPlanner::FloorPlanner(std::size_t max_planners)
+: _max_planners(max_planners)
+{
+  // Do nothing
+}
+
+//==============================================================================
+std::size_t FloorPlanner::max_planners() const
+{
+  return _max_planners;
+}
+
+//==============================================================================
+void FloorPlanner::update_lift(const LiftState& state, rmf_traffic::Time now)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  const bool moving =
+    state.motion_state == LiftState::MOTION_UP
+    || state.motion_state == LiftState::MOTION_DOWN;
+
+  const auto [it, inserted] = _lifts.insert({state.lift_name, Status()});
+  auto& status = it->second;
+  if (inserted)
+  {
+    status.floor = state.current_floor;
+    status.floor_time = now;
+  }
+  else if (state.current_floor != status.floor)
+  {
+    // Measure how long the lift takes per floor while it is moving
+    const auto s_it = _shafts.find(state.lift_name);
+    if (status.moving && s_it != _shafts.end())
+    {
+      const auto h_it =
+        s_it->second.hops.find({status.floor, state.current_floor});
+      if (h_it != s_it->second.hops.end() && h_it->second > 0)
+      {
+        const double sample =
+          rmf_traffic::time::to_seconds(now - status.floor_time)
+          / static_cast<double>(h_it->second);
+        status.seconds_per_floor = 0.8 * status.seconds_per_floor
+          + 0.2 * sample;
+      }
+    }
+
+    status.floor = state.current_floor;
+    status.floor_time = now;
+  }
+  else if (moving && !status.moving)
+  {
+    status.floor_time = now;
+  }
+
+  status.moving = moving;
+  status.busy = !state.session_id.empty();
+}
+
+//==============================================================================
+auto FloorPlanner::route(
+  const Graph& graph,
+  const std::string& from_floor,
+  const std::string& to_floor) -> std::optional<Route>
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _analyze(graph);
+  return _route(from_floor, to_floor);
+}
+
+//==============================================================================
+auto FloorPlanner::planner_for(
+  const std::shared_ptr<const Planner>& planner,
+  const std::string& from_floor,
+  const std::string& to_floor) -> std::shared_ptr<const Planner>
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_base.lock() != planner)
+  {
+    _planners.clear();
+    _base = planner;
+    _graph = nullptr;
+  }
+
+  const auto& graph = planner->get_configuration().graph();
+  _analyze(graph);
+  if (_floors.size() < 2)
+    return planner;
+
+  const auto route = _route(from_floor, to_floor);
+  if (!route.has_value())
+    return planner;
+
+  std::string key;
+  for (const auto& floor : route->floors)
+    key += floor + '\n';
+  key += '|';
+  for (const auto& lift : route->lifts)
+    key += '\n' + lift;
+
+  for (auto it = _planners.begin(); it != _planners.end(); ++it)
+  {
+    if (it->key == key)
+    {
+      _planners.splice(_planners.begin(), _planners, it);
+      return _planners.front().planner;
+    }
+  }
+
+  const std::unordered_set<std::string> floors(
+    route->floors.begin(), route->floors.end());
+  const std::unordered_set<std::string> lifts(
+    route->lifts.begin(), route->lifts.end());
+
+  auto config = planner->get_configuration();
+  auto& closures = config.lane_closures();
+  for (std::size_t i = 0; i < graph.num_lanes(); ++i)
+  {
+    const auto& lane = graph.get_lane(i);
+    const auto lift = lift_between_floors(graph, lane);
+    if (!lift.empty())
+    {
+      if (lifts.count(lift) == 0)
+        closures.close(i);
+
+      continue;
+    }
+
+    const auto& entry = graph.get_waypoint(lane.entry().waypoint_index());
+    const auto& exit = graph.get_waypoint(lane.exit().waypoint_index());
+    if (floors.count(entry.get_map_name()) == 0
+      || floors.count(exit.get_map_name()) == 0)
+    {
+      closures.close(i);
+    }
+  }
+
+  auto restricted = std::make_shared<const Planner>(
+    std::move(config), planner->get_default_options());
+
+  _planners.push_front(Restricted{std::move(key), restricted});
+  while (_planners.size() > _max_planners)
+    _planners.pop_back();
+
+  return restricted;
+}
+
+//==============================================================================
+std::size_t FloorPlanner::size() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _planners.size();
+}
+
+//==============================================================================
+void FloorPlanner::_analyze(const Graph& graph)
+{
+  if (_graph == &graph && _num_lanes == graph.num_lanes())
+    return;
+
+  _graph = &graph;
+  _num_lanes = graph.num_lanes();
+  _shafts.clear();
+  _floors.clear();
+
+  std::unordered_set<std::string> floors;
+  for (std::size_t i = 0; i < graph.num_waypoints(); ++i)
+  {
+    const auto& map = graph.get_waypoint(i).get_map_name();
+    if (floors.insert(map).second)
+      _floors.push_back(map);
+  }
+
+  // Which floors each lift goes to directly from each floor
+  std::unordered_map<std::string,
+    std::unordered_map<std::string, std::unordered_set<std::string>>> adjacent;
+  for (std::size_t i = 0; i < graph.num_lanes(); ++i)
+  {
+    const auto& lane = graph.get_lane(i);
+    const auto lift = lift_between_floors(graph, lane);
+    if (lift.empty())
+      continue;
+
+    adjacent[lift]
+    [graph.get_waypoint(lane.entry().waypoint_index()).get_map_name()]
+    .insert(graph.get_waypoint(lane.exit().waypoint_index()).get_map_name());
+  }
+
+  for (const auto& [lift, neighbors] : adjacent)
+  {
+    auto& shaft = _shafts[lift];
+    for (const auto& [start, _] : neighbors)
+    {
+      std::unordered_map<std::string, std::size_t> hops = {{start, 0}};
+      std::queue<std::string> queue;
+      queue.push(start);
+      while (!queue.empty())
+      {
+        const auto floor = queue.front();
+        queue.pop();
+        const auto n_it = neighbors.find(floor);
+        if (n_it == neighbors.end())
+          continue;
+
+        for (const auto& next : n_it->second)
+        {
+          if (hops.insert({next, hops.at(floor) + 1}).second)
+            queue.push(next);
+        }
+      }
+
+      for (const auto& [floor, h] : hops)
+      {
+        if (floor == start)
+          continue;
+
+        shaft.hops[{start, floor}] = h;
+        shaft.height = std::max(shaft.height, h);
+      }
+    }
+  }
+}
+
+//==============================================================================
+auto FloorPlanner::_route(
+  const std::string& from_floor,
+  const std::string& to_floor) const -> std::optional<Route>
+{
+  if (from_floor == to_floor)
+    return Route{{from_floor}, {}, 0.0};
+
+  struct Previous
+  {
+    std::string floor;
+    std::string lift;
+  };
+
+  using Entry = std::pair<double, std::string>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  std::unordered_map<std::string, double> cost = {{from_floor, 0.0}};
+  std::unordered_map<std::string, Previous> previous;
+  queue.push({0.0, from_floor});
+  while (!queue.empty())
+  {
+    const auto [c, floor] = queue.top();
+    queue.pop();
+    if (c > cost.at(floor))
+      continue;
+
+    if (floor == to_floor)
+      break;
+
+    for (const auto& [lift, shaft] : _shafts)
+    {
+      const auto l_it = _lifts.find(lift);
+      const double seconds_per_floor = l_it == _lifts.end() ?
+        DefaultSecondsPerFloor : l_it->second.seconds_per_floor;
+
+      std::optional<double> wait;
+      for (const auto& [floors, hops] : shaft.hops)
+      {
+        if (floors.first != floor)
+          continue;
+
+        if (!wait.has_value())
+          wait = _expected_wait(lift, floor);
+
+        const double next_cost = c + *wait + hops * seconds_per_floor;
+        const auto [it, inserted] = cost.insert({floors.second, next_cost});
+        if (!inserted && it->second <= next_cost)
+          continue;
+
+        it->second = next_cost;
+        previous[floors.second] = Previous{floor, lift};
+        queue.push({next_cost, floors.second});
+      }
+    }
+  }
+
+  const auto c_it = cost.find(to_floor);
+  if (c_it == cost.end())
+    return std::nullopt;
+
+  Route route;
+  route.lift_seconds = c_it->second;
+  std::string floor = to_floor;
+  route.floors.push_back(floor);
+  while (floor != from_floor)
+  {
+    const auto& p = previous.at(floor);
+    route.lifts.push_back(p.lift);
+    route.floors.push_back(p.floor);
+    floor = p.floor;
+  }
+
+  std::reverse(route.floors.begin(), route.floors.end());
+  std::reverse(route.lifts.begin(), route.lifts.end());
+  return route;
+}
+
+//==============================================================================
+double FloorPlanner::_expected_wait(
+  const std::string& lift,
+  const std::string& floor) const
+{
+  const auto s_it = _shafts.find(lift);
+  const double height =
+    s_it == _shafts.end() ? 0.0 : static_cast<double>(s_it->second.height);
+
+  const auto l_it = _lifts.find(lift);
+  if (l_it == _lifts.end())
+  {
+    // Without any state, assume that the lift is halfway up its shaft
+    return DefaultSecondsPerFloor * height / 2.0;
+  }
+
+  const auto& status = l_it->second;
+  double floors_away = height / 2.0;
+  if (status.floor == floor)
+  {
+    floors_away = 0.0;
+  }
+  else if (s_it != _shafts.end())
+  {
+    const auto h_it = s_it->second.hops.find({status.floor, floor});
+    if (h_it != s_it->second.hops.end())
+      floors_away = static_cast<double>(h_it->second);
+  }
+
+  return floors_away * status.seconds_per_floor
+    + (status.busy ? BusyLiftSeconds : 0.0);
+}
+
+} // namespace rmf_fleet_adapter
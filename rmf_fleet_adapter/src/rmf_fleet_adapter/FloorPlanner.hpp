@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__FLOORPLANNER_HPP
+#define SRC__RMF_FLEET_ADAPTER__FLOORPLANNER_HPP
+
+#include <rmf_traffic/agv/Planner.hpp>
+
+#include <rmf_lift_msgs/msg/lift_state.hpp>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// Plans across the floors of a building in two levels. A coarse graph of the
+/// floors, where each lift is an edge between every pair of floors that it
+/// serves, picks which floors and lifts a route will use. The cost of riding a
+/// lift is the time that the lift is expected to need to arrive, based on the
+/// latest state from its lift supervisor, plus the time to travel between the
+/// floors. Each search is then done with a planner whose lanes are closed on
+/// every other floor and in every other lift, which keeps the search and its
+/// heuristic from expanding through the whole building.
+///
+/// The restricted planners are kept for the most recently used routes so that
+/// their caches stay warm. They are forgotten when the fleet planner changes.
+class FloorPlanner
+{
+public:
+
+  using Planner = rmf_traffic::agv::Planner;
+  using Graph = rmf_traffic::agv::Graph;
+  using LiftState = rmf_lift_msgs::msg::LiftState;
+
+  /// How long each floor is assumed to take for a lift until the states of
+  /// the lift have shown how fast it is.
+  static constexpr double DefaultSecondsPerFloor = 5.0;
+
+  /// How much longer a lift is expected to take while it is serving someone
+  /// else.
+  static constexpr double BusyLiftSeconds = 30.0;
+
+  /// The floors and lifts that a route will use
+  struct Route
+  {
+    /// Every floor where the route travels on the floor itself, in order
+    std::vector<std::string> floors;
+
+    /// The lift that is ridden after each floor except the last one
+    std::vector<std::string> lifts;
+
+    /// The expected time spent waiting for and riding lifts in seconds
+    double lift_seconds = 0.0;
+  };
+
+  /// \param[in] max_planners
+  ///   The most restricted planners to keep at once.
+  static std::shared_ptr<FloorPlanner> make(std::size_t max_planners);
+
+  /// Get the most restricted planners that are kept at once.
+  std::size_t max_planners() const;
+
+  /// Update the expected wait for a lift.
+  void update_lift(const LiftState& state, rmf_traffic::Time now);
+
+  /// Find the floors and lifts that are quickest to get from one floor to
+  /// another. This returns std::nullopt if no lifts connect the floors.
+  std::optional<Route> route(
+    const Graph& graph,
+    const std::string& from_floor,
+    const std::string& to_floor);
+
+  /// Get a planner for going from one floor to another, whose lanes are closed
+  /// everywhere outside of the best route between the floors. This returns
+  /// the given planner itself if its graph only has one floor or if no route
+  /// could be found.
+  std::shared_ptr<const Planner> planner_for(
+    const std::shared_ptr<const Planner>& planner,
+    const std::string& from_floor,
+    const std::string& to_floor);
+
+  /// Get the number of restricted planners that are being kept.
+  std::size_t size() const;
+
+private:
+
+  FloorPlanner(std::size_t max_planners);
+
+  struct Shaft
+  {
+    // Number of floors between each pair of floors that the lift serves
+    std::map<std::pair<std::string, std::string>, std::size_t> hops;
+    std::size_t height = 0;
+  };
+
+  struct Status
+  {
+    std::string floor;
+    rmf_traffic::Time floor_time;
+    bool moving = false;
+    bool busy = false;
+    double seconds_per_floor = DefaultSecondsPerFloor;
+  };
+
+  struct Restricted
+  {
+    std::string key;
+    std::shared_ptr<const Planner> planner;
+  };
+
+  void _analyze(const Graph& graph);
+
+  std::optional<Route> _route(
+    const std::string& from_floor,
+    const std::string& to_floor) const;
+
+  double _expected_wait(
+    const std::string& lift,
+    const std::string& floor) const;
+
+  std::size_t _max_planners;
+  mutable std::mutex _mutex;
+
+  // What the shafts were analyzed from
+  const Graph* _graph = nullptr;
+  std::size_t _num_lanes = 0;
+  std::unordered_map<std::string, Shaft> _shafts;
+  std::vector<std::string> _floors;
+
+  std::unordered_map<std::string, Status> _lifts;
+
+  std::weak_ptr<const Planner> _base;
+  std::list<Restricted> _planners;
+};
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__FLOORPLANNER_HPP
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "GoalWarmup.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace rmf_fleet_adapter {
+
+namespace {
+//==============================================================================
+void lower_thread_priority()
+{
+#ifdef __linux__
+  // On Linux the nice value belongs to each thread, so this only affects the
+  // calling thread.
+  setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+#endif
+}
+} // anonymous namespace
+
+//==============================================================================
+std::shared_ptr<GoalWarmup> GoalWarmup::make(std::size_t max_goals)
+{
+  return std::shared_ptr<GoalWarmup>(new GoalWarmup(max_goals));
+}
+
+//==============================================================================
+std::size_t GoalWarmup::max_goals() const
+{
+  return _max_goals;
+}
+
+//==============================================================================
+void GoalWarmup::record(const std::size_t goal)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _counts[goal] += 1.0;
+}
+
+//==============================================================================
+std::vector<std::size_t> GoalWarmup::goals(const Graph& graph) const
+{
+  std::vector<std::pair<double, std::size_t>> recorded;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    recorded.reserve(_counts.size());
+    for (const auto& [goal, count] : _counts)
+    {
+      if (goal < graph.num_waypoints())
+        recorded.push_back({count, goal});
+    }
+  }
+
+  std::sort(recorded.begin(), recorded.end(),
+    [](const auto& a, const auto& b)
+    {
+      if (a.first != b.first)
+        return a.first > b.first;
+      return a.second < b.second;
+    });
+
+  std::vector<std::size_t> goals;
+  std::unordered_set<std::size_t> added;
+  const auto add = [&](std::size_t goal)
+    {
+      if (goals.size() < _max_goals && added.insert(goal).second)
+        goals.push_back(goal);
+    };
+
+  for (const auto& [_, goal] : recorded)
+    add(goal);
+
+  for (std::size_t i = 0; i < graph.num_waypoints(); ++i)
+  {
+    if (graph.get_waypoint(i).is_charger())
+      add(i);
+  }
+
+  for (std::size_t i = 0; i < graph.num_waypoints(); ++i)
+  {
+    if (graph.get_waypoint(i).is_parking_spot())
+      add(i);
+  }
+
+  return goals;
+}
+
+//==============================================================================
+void GoalWarmup::warm_up(
+  std::shared_ptr<const Planner> planner,
+  std::vector<std::size_t> starts)
+{
+  _stop_warm_up();
+
+  const auto goals = this->goals(planner->get_configuration().graph());
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& [_, count] : _counts)
+      count /= 2.0;
+  }
+
+  // Robots also tend to travel from one of these goals to another
+  starts.insert(starts.end(), goals.begin(), goals.end());
+  std::sort(starts.begin(), starts.end());
+  starts.erase(std::unique(starts.begin(), starts.end()), starts.end());
+
+  _stop = false;
+  _ready = false;
+  _thread = std::thread(
+    [this, planner = std::move(planner), goals, starts = std::move(starts)]()
+    {
+      lower_thread_priority();
+      const auto now = std::chrono::steady_clock::now();
+      for (const auto goal : goals)
+      {
+        for (const auto start : starts)
+        {
+          if (_stop)
+            return;
+
+          if (start == goal)
+            continue;
+
+          // Finding the ideal cost fills the heuristic cache of the
+          // differential drive planner for this goal
+          planner->setup(
+            Planner::Start(now, start, 0.0), Planner::Goal(goal)).ideal_cost();
+        }
+      }
+
+      _ready = true;
+    });
+}
+
+//==============================================================================
+bool GoalWarmup::ready() const
+{
+  return _ready;
+}
+
+//==============================================================================
+GoalWarmup::~GoalWarmup()
+{
+  _stop_warm_up();
+}
+
+//==============================================================================
+GoalWarmup::GoalWarmup(const std::size_t max_goals)
+: _max_goals(max_goals)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void GoalWarmup::_stop_warm_up()
+{
+  _stop = true;
+  if (_thread.joinable())
+    _thread.join();
+}
+
+} // namespace rmf_fleet_adapter
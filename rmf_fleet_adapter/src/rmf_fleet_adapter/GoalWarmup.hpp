@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__GOALWARMUP_HPP
+#define SRC__RMF_FLEET_ADAPTER__GOALWARMUP_HPP
+
+#include <rmf_traffic/agv/Planner.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// Fills the caches of a planner towards the goals that a fleet is most likely
+/// to plan for next, so that the first plans after startup or after the
+/// planner is replaced do not have to build their heuristics from scratch.
+///
+/// The goals are ranked by how often the robots of the fleet have planned
+/// towards them recently, followed by the chargers and then the parking spots
+/// of the graph. The heuristic towards each goal is filled from the given
+/// starts, e.g. where the robots currently are, and from the other goals. This
+/// runs on a background thread with the lowest scheduling priority so that it
+/// does not compete with planning that someone is waiting for.
+class GoalWarmup
+{
+public:
+
+  using Planner = rmf_traffic::agv::Planner;
+  using Graph = rmf_traffic::agv::Graph;
+
+  /// \param[in] max_goals
+  ///   The largest number of goals to warm up each time.
+  static std::shared_ptr<GoalWarmup> make(std::size_t max_goals);
+
+  /// Get the largest number of goals that are warmed up each time.
+  std::size_t max_goals() const;
+
+  /// Count a goal that a robot of the fleet has planned towards.
+  void record(std::size_t goal);
+
+  /// Get the goals that would be warmed up for this graph, most important
+  /// first.
+  std::vector<std::size_t> goals(const Graph& graph) const;
+
+  /// Start filling the caches of the planner towards the goals. Any previous
+  /// warm up is stopped first. Goals that were recorded before this call
+  /// count for half as much afterwards, so that the ranking follows recent
+  /// use.
+  ///
+  /// \param[in] planner
+  ///   The planner to warm up.
+  ///
+  /// \param[in] starts
+  ///   Waypoints that robots are likely to start from.
+  void warm_up(
+    std::shared_ptr<const Planner> planner,
+    std::vector<std::size_t> starts);
+
+  /// True once the latest warm up has gone through every goal.
+  bool ready() const;
+
+  /// Stop warming up.
+  ~GoalWarmup();
+
+private:
+
+  GoalWarmup(std::size_t max_goals);
+
+  void _stop_warm_up();
+
+  std::size_t _max_goals;
+  std::unordered_map<std::size_t, double> _counts;
+  mutable std::mutex _mutex;
+
+  std::atomic_bool _stop{false};
+  std::atomic_bool _ready{true};
+  std::thread _thread;
+};
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__GOALWARMUP_HPP
@@ -0,0 +1,344 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "GraphSpatialIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace rmf_fleet_adapter {
+
+namespace {
+//==============================================================================
+double distance_to_segment(
+  const Eigen::Vector2d& p,
+  const Eigen::Vector2d& p0,
+  const Eigen::Vector2d& p1)
+{
+  const Eigen::Vector2d d = p1 - p0;
+  const double length_squared = d.squaredNorm();
+  if (length_squared <= 0.0)
+    return (p - p0).norm();
+
+  const double t = std::clamp((p - p0).dot(d) / length_squared, 0.0, 1.0);
+  return (p - (p0 + t*d)).norm();
+}
+
+//==============================================================================
+void sort_unique(std::vector<std::size_t>& values)
+{
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+} // anonymous namespace
+
+//==============================================================================
+std::shared_ptr<const GraphSpatialIndex> GraphSpatialIndex::make(
+  const Graph& graph,
+  const double cell_size)
+{
+  std::shared_ptr<GraphSpatialIndex> index(
+    new GraphSpatialIndex(cell_size > 0.0 ? cell_size : DefaultCellSize));
+
+  index->_num_waypoints = graph.num_waypoints();
+  index->_num_lanes = graph.num_lanes();
+
+  for (std::size_t i = 0; i < graph.num_waypoints(); ++i)
+  {
+    const auto& wp = graph.get_waypoint(i);
+    const Eigen::Vector2d p = wp.get_location();
+    index->_waypoint_cells[wp.get_map_name()]
+    [index->_key(index->_coord(p.x()), index->_coord(p.y()))].push_back(i);
+  }
+
+  for (std::size_t i = 0; i < graph.num_lanes(); ++i)
+  {
+    const auto& lane = graph.get_lane(i);
+    const auto& wp0 = graph.get_waypoint(lane.entry().waypoint_index());
+    const auto& wp1 = graph.get_waypoint(lane.exit().waypoint_index());
+    const Eigen::Vector2d p0 = wp0.get_location();
+    const Eigen::Vector2d p1 = wp1.get_location();
+    index->_add_lane(wp0.get_map_name(), i, p0, p1);
+    if (wp1.get_map_name() != wp0.get_map_name())
+      index->_add_lane(wp1.get_map_name(), i, p0, p1);
+  }
+
+  return index;
+}
+
+//==============================================================================
+std::vector<std::size_t> GraphSpatialIndex::waypoints_near(
+  const std::string& map,
+  const Eigen::Vector2d& position,
+  const double radius) const
+{
+  std::vector<std::size_t> output;
+  const auto map_it = _waypoint_cells.find(map);
+  if (map_it == _waypoint_cells.end())
+    return output;
+
+  const Cells& cells = map_it->second;
+  const bool bounded = _for_each_cell(position, radius,
+      [&](const CellKey key)
+      {
+        const auto it = cells.find(key);
+        if (it != cells.end())
+          output.insert(output.end(), it->second.begin(), it->second.end());
+      });
+
+  if (!bounded)
+  {
+    // The radius covers so many cells that it is cheaper to take everything
+    output.clear();
+    for (const auto& [_, waypoints] : cells)
+      output.insert(output.end(), waypoints.begin(), waypoints.end());
+  }
+
+  sort_unique(output);
+  return output;
+}
+
+//==============================================================================
+std::vector<std::size_t> GraphSpatialIndex::lanes_near(
+  const std::string& map,
+  const Eigen::Vector2d& position,
+  const double radius) const
+{
+  std::vector<std::size_t> output;
+  const auto map_it = _lane_cells.find(map);
+  if (map_it == _lane_cells.end())
+    return output;
+
+  const Cells& cells = map_it->second;
+  const bool bounded = _for_each_cell(position, radius,
+      [&](const CellKey key)
+      {
+        const auto it = cells.find(key);
+        if (it != cells.end())
+          output.insert(output.end(), it->second.begin(), it->second.end());
+      });
+
+  if (!bounded)
+  {
+    output.clear();
+    for (const auto& [_, lanes] : cells)
+      output.insert(output.end(), lanes.begin(), lanes.end());
+  }
+
+  sort_unique(output);
+  return output;
+}
+
+//==============================================================================
+bool GraphSpatialIndex::Neighborhood::covers(
+  const std::string& map,
+  const Eigen::Vector2d& position,
+  const double radius) const
+{
+  return map == _map && (position - _center).norm() + radius <= _radius;
+}
+
+//==============================================================================
+auto GraphSpatialIndex::Neighborhood::compute_plan_starts(
+  const std::string& map_name,
+  const Eigen::Vector3d& pose,
+  const rmf_traffic::Time start_time,
+  const double max_merge_waypoint_distance,
+  const double max_merge_lane_distance,
+  const double min_lane_length) const -> StartSet
+{
+  if (_waypoints.empty())
+    return {};
+
+  const auto sub_starts = rmf_traffic::agv::compute_plan_starts(
+    _subgraph, map_name, pose, start_time, max_merge_waypoint_distance,
+    max_merge_lane_distance, min_lane_length);
+
+  StartSet starts;
+  starts.reserve(sub_starts.size());
+  for (const auto& start : sub_starts)
+  {
+    std::optional<std::size_t> lane;
+    if (start.lane().has_value())
+      lane = _lanes.at(*start.lane());
+
+    starts.emplace_back(
+      start.time(),
+      _waypoints.at(start.waypoint()),
+      start.orientation(),
+      start.location(),
+      lane);
+  }
+
+  return starts;
+}
+
+//==============================================================================
+auto GraphSpatialIndex::neighborhood(
+  const Graph& graph,
+  const std::string& map,
+  const Eigen::Vector2d& position,
+  const double radius) const -> std::shared_ptr<const Neighborhood>
+{
+  auto output = std::make_shared<Neighborhood>();
+  output->_map = map;
+  output->_center = position;
+  output->_radius = radius;
+  output->_lanes = lanes_near(map, position, radius);
+
+  auto& waypoints = output->_waypoints;
+  waypoints = waypoints_near(map, position, radius);
+  for (const std::size_t lane : output->_lanes)
+  {
+    const auto& l = graph.get_lane(lane);
+    waypoints.push_back(l.entry().waypoint_index());
+    waypoints.push_back(l.exit().waypoint_index());
+  }
+  sort_unique(waypoints);
+
+  // Copy the nearby part of the graph while keeping the relative order of its
+  // waypoints and lanes, so that rmf_traffic can decide the starts on this
+  // small graph. Anything that could have matched is in the copy, so the
+  // result is the same as it would have been for the whole graph.
+  std::unordered_map<std::size_t, std::size_t> to_subgraph;
+  for (const std::size_t wp : waypoints)
+  {
+    const auto& original = graph.get_waypoint(wp);
+    auto& copy = output->_subgraph.add_waypoint(
+      original.get_map_name(), original.get_location());
+    copy.set_merge_radius(original.merge_radius());
+    to_subgraph[wp] = copy.index();
+  }
+
+  for (const std::size_t lane : output->_lanes)
+  {
+    const auto& l = graph.get_lane(lane);
+    output->_subgraph.add_lane(
+      to_subgraph.at(l.entry().waypoint_index()),
+      to_subgraph.at(l.exit().waypoint_index())).properties() = l.properties();
+  }
+
+  return output;
+}
+
+//==============================================================================
+auto GraphSpatialIndex::compute_plan_starts(
+  const Graph& graph,
+  const std::string& map_name,
+  const Eigen::Vector3d& pose,
+  const rmf_traffic::Time start_time,
+  const double max_merge_waypoint_distance,
+  const double max_merge_lane_distance,
+  const double min_lane_length) const -> StartSet
+{
+  const double radius =
+    std::max(max_merge_waypoint_distance, max_merge_lane_distance);
+
+  return neighborhood(graph, map_name, pose.block<2, 1>(0, 0), radius)
+    ->compute_plan_starts(
+    map_name, pose, start_time, max_merge_waypoint_distance,
+    max_merge_lane_distance, min_lane_length);
+}
+
+//==============================================================================
+bool GraphSpatialIndex::matches(const Graph& graph) const
+{
+  return graph.num_waypoints() == _num_waypoints
+    && graph.num_lanes() == _num_lanes;
+}
+
+//==============================================================================
+GraphSpatialIndex::GraphSpatialIndex(const double cell_size)
+: _cell_size(cell_size)
+{
+  // Do nothing
+}
+
+//==============================================================================
+auto GraphSpatialIndex::_key(const std::int64_t x, const std::int64_t y) const
+-> CellKey
+{
+  return static_cast<CellKey>(
+    (static_cast<std::uint64_t>(x) << 32)
+    ^ (static_cast<std::uint64_t>(y) & 0xFFFFFFFF));
+}
+
+//==============================================================================
+std::int64_t GraphSpatialIndex::_coord(const double value) const
+{
+  return static_cast<std::int64_t>(std::floor(value / _cell_size));
+}
+
+//==============================================================================
+template<typename F>
+bool GraphSpatialIndex::_for_each_cell(
+  const Eigen::Vector2d& position,
+  const double radius,
+  F&& f) const
+{
+  const std::int64_t x0 = _coord(position.x() - radius);
+  const std::int64_t x1 = _coord(position.x() + radius);
+  const std::int64_t y0 = _coord(position.y() - radius);
+  const std::int64_t y1 = _coord(position.y() + radius);
+
+  // Visiting more cells than there are items in the graph would be slower
+  // than a plain scan.
+  const double num_cells =
+    static_cast<double>(x1 - x0 + 1) * static_cast<double>(y1 - y0 + 1);
+  if (num_cells > static_cast<double>(_num_waypoints + _num_lanes))
+    return false;
+
+  for (std::int64_t x = x0; x <= x1; ++x)
+  {
+    for (std::int64_t y = y0; y <= y1; ++y)
+      f(_key(x, y));
+  }
+
+  return true;
+}
+
+//==============================================================================
+void GraphSpatialIndex::_add_lane(
+  const std::string& map,
+  const std::size_t lane,
+  const Eigen::Vector2d& p0,
+  const Eigen::Vector2d& p1)
+{
+  // A lane is put in every cell whose center is close enough to the lane that
+  // the lane might pass through the cell. Half of the diagonal of a cell is
+  // about 0.71 of its width, so 0.75 leaves some room for rounding.
+  const double reach = 0.75 * _cell_size;
+  Cells& cells = _lane_cells[map];
+  const std::int64_t x0 = _coord(std::min(p0.x(), p1.x()));
+  const std::int64_t x1 = _coord(std::max(p0.x(), p1.x()));
+  const std::int64_t y0 = _coord(std::min(p0.y(), p1.y()));
+  const std::int64_t y1 = _coord(std::max(p0.y(), p1.y()));
+  for (std::int64_t x = x0; x <= x1; ++x)
+  {
+    for (std::int64_t y = y0; y <= y1; ++y)
+    {
+      const Eigen::Vector2d center(
+        (static_cast<double>(x) + 0.5) * _cell_size,
+        (static_cast<double>(y) + 0.5) * _cell_size);
+
+      if (distance_to_segment(center, p0, p1) <= reach)
+        cells[_key(x, y)].push_back(lane);
+    }
+  }
+}
+
+} // namespace rmf_fleet_adapter
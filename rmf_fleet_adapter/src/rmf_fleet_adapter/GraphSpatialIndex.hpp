@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__GRAPHSPATIALINDEX_HPP
+#define SRC__RMF_FLEET_ADAPTER__GRAPHSPATIALINDEX_HPP
+
+#include <rmf_traffic/agv/Planner.hpp>
+
+#include <Eigen/Geometry>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// A uniform grid over the waypoints and lanes of a navigation graph, so the
+/// parts of the graph that are near a position can be found without scanning
+/// the whole graph. The index only describes the geometry of the graph that it
+/// was made from, so it needs to be remade if that geometry changes.
+class GraphSpatialIndex
+{
+public:
+
+  using Graph = rmf_traffic::agv::Graph;
+  using StartSet = rmf_traffic::agv::Plan::StartSet;
+
+  /// The default width of the square cells of the grid, in meters
+  static constexpr double DefaultCellSize = 1.0;
+
+  static std::shared_ptr<const GraphSpatialIndex> make(
+    const Graph& graph,
+    double cell_size = DefaultCellSize);
+
+  /// Get the waypoints on a map that might be within radius of a position,
+  /// sorted by index. Every waypoint that is within the radius is included,
+  /// but some that are a little farther may be included too.
+  std::vector<std::size_t> waypoints_near(
+    const std::string& map,
+    const Eigen::Vector2d& position,
+    double radius) const;
+
+  /// Get the lanes touching a map that might pass within radius of a position,
+  /// sorted by index. Like waypoints_near, this may include extra lanes.
+  std::vector<std::size_t> lanes_near(
+    const std::string& map,
+    const Eigen::Vector2d& position,
+    double radius) const;
+
+  /// A copy of the part of a graph that is near some position, which can be
+  /// reused for as long as a robot stays near that position.
+  class Neighborhood
+  {
+  public:
+
+    /// True if this neighborhood contains everything on the map that is
+    /// within radius of the position.
+    bool covers(
+      const std::string& map,
+      const Eigen::Vector2d& position,
+      double radius) const;
+
+    /// Give the same result as rmf_traffic::agv::compute_plan_starts for the
+    /// whole graph, as long as covers() is true for the position of the pose
+    /// and the larger of the two merge distances.
+    StartSet compute_plan_starts(
+      const std::string& map_name,
+      const Eigen::Vector3d& pose,
+      rmf_traffic::Time start_time,
+      double max_merge_waypoint_distance,
+      double max_merge_lane_distance,
+      double min_lane_length) const;
+
+  private:
+    friend class GraphSpatialIndex;
+    std::string _map;
+    Eigen::Vector2d _center;
+    double _radius;
+    Graph _subgraph;
+    std::vector<std::size_t> _waypoints;
+    std::vector<std::size_t> _lanes;
+  };
+
+  /// Copy the part of the graph that is within radius of a position.
+  std::shared_ptr<const Neighborhood> neighborhood(
+    const Graph& graph,
+    const std::string& map,
+    const Eigen::Vector2d& position,
+    double radius) const;
+
+  /// Give the same result as rmf_traffic::agv::compute_plan_starts for the
+  /// graph that this index was made from, while only looking at the waypoints
+  /// and lanes that are near the pose.
+  StartSet compute_plan_starts(
+    const Graph& graph,
+    const std::string& map_name,
+    const Eigen::Vector3d& pose,
+    rmf_traffic::Time start_time,
+    double max_merge_waypoint_distance,
+    double max_merge_lane_distance,
+    double min_lane_length) const;
+
+  /// True if this index could have been made from the given graph
+  bool matches(const Graph& graph) const;
+
+private:
+
+  GraphSpatialIndex(double cell_size);
+
+  using CellKey = std::int64_t;
+  using Cells = std::unordered_map<CellKey, std::vector<std::size_t>>;
+
+  CellKey _key(std::int64_t x, std::int64_t y) const;
+  std::int64_t _coord(double value) const;
+
+  template<typename F>
+  bool _for_each_cell(
+    const Eigen::Vector2d& position, double radius, F&& f) const;
+
+  void _add_lane(const std::string& map, std::size_t lane,
+    const Eigen::Vector2d& p0, const Eigen::Vector2d& p1);
+
+  double _cell_size;
+  std::size_t _num_waypoints = 0;
+  std::size_t _num_lanes = 0;
+  std::unordered_map<std::string, Cells> _waypoint_cells;
+  std::unordered_map<std::string, Cells> _lane_cells;
+};
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__GRAPHSPATIALINDEX_HPP
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ItineraryDelta.hpp"
+
+#include <optional>
+
+namespace rmf_fleet_adapter {
+
+namespace {
+//==============================================================================
+/// If the next route is the current route shifted by a constant amount of
+/// time, get that amount of time.
+std::optional<rmf_traffic::Duration> shift_between(
+  const rmf_traffic::Route& current,
+  const rmf_traffic::Route& next)
+{
+  if (current.map() != next.map())
+    return std::nullopt;
+
+  if (!current.dependencies().empty() || !next.dependencies().empty())
+    return std::nullopt;
+
+  const auto& a = current.trajectory();
+  const auto& b = next.trajectory();
+  if (a.size() != b.size() || a.size() == 0)
+    return std::nullopt;
+
+  constexpr double tolerance = 1e-8;
+  const rmf_traffic::Duration shift = b.begin()->time() - a.begin()->time();
+  auto it_a = a.begin();
+  auto it_b = b.begin();
+  for (; it_a != a.end(); ++it_a, ++it_b)
+  {
+    if (it_b->time() - it_a->time() != shift)
+      return std::nullopt;
+
+    if ((it_b->position() - it_a->position()).norm() > tolerance)
+      return std::nullopt;
+
+    if ((it_b->velocity() - it_a->velocity()).norm() > tolerance)
+      return std::nullopt;
+  }
+
+  return shift;
+}
+
+//==============================================================================
+/// How far apart two stationary holds can be and still count as holding the
+/// robot at the same place. This absorbs the jitter of reported positions.
+const double HoldPositionTolerance = 0.05;
+
+//==============================================================================
+struct StationaryHold
+{
+  rmf_traffic::Time start;
+  rmf_traffic::Time finish;
+  Eigen::Vector3d position;
+};
+
+//==============================================================================
+/// If the route keeps the robot still at one place, get where and for how long
+std::optional<StationaryHold> stationary_hold_of(
+  const rmf_traffic::Route& route)
+{
+  if (!route.dependencies().empty())
+    return std::nullopt;
+
+  const auto& trajectory = route.trajectory();
+  if (trajectory.size() < 2)
+    return std::nullopt;
+
+  constexpr double tolerance = 1e-8;
+  const Eigen::Vector3d p = trajectory.begin()->position();
+  for (const auto& wp : trajectory)
+  {
+    if ((wp.position() - p).norm() > tolerance)
+      return std::nullopt;
+
+    if (wp.velocity().norm() > tolerance)
+      return std::nullopt;
+  }
+
+  return StationaryHold{
+    *trajectory.start_time(),
+    *trajectory.finish_time(),
+    p
+  };
+}
+
+//==============================================================================
+/// Refreshing a stationary hold only changes until when the robot stays where
+/// it is, so it can be sent as a delay as long as the delayed hold still
+/// covers all of the new hold.
+std::optional<rmf_traffic::Duration> hold_refresh_between(
+  const rmf_traffic::schedule::Itinerary& current,
+  const rmf_traffic::schedule::Itinerary& next)
+{
+  if (current.size() != 1 || next.size() != 1)
+    return std::nullopt;
+
+  if (current.front().map() != next.front().map())
+    return std::nullopt;
+
+  const auto a = stationary_hold_of(current.front());
+  const auto b = stationary_hold_of(next.front());
+  if (!a.has_value() || !b.has_value())
+    return std::nullopt;
+
+  if ((a->position - b->position).norm() > HoldPositionTolerance)
+    return std::nullopt;
+
+  const rmf_traffic::Duration shift = b->finish - a->finish;
+  if (b->start < a->start + shift)
+    return std::nullopt;
+
+  return shift;
+}
+} // anonymous namespace
+
+//==============================================================================
+ItineraryDelta ItineraryDelta::compute(
+  const rmf_traffic::schedule::Itinerary& current,
+  const rmf_traffic::schedule::Itinerary& next)
+{
+  ItineraryDelta delta;
+  if (current.empty() || next.size() < current.size())
+    return delta;
+
+  if (const auto refresh = hold_refresh_between(current, next))
+  {
+    if (*refresh == rmf_traffic::Duration(0))
+    {
+      delta.kind = Kind::Unchanged;
+      return delta;
+    }
+
+    delta.kind = Kind::Delay;
+    delta.delay = *refresh;
+    return delta;
+  }
+
+  std::optional<rmf_traffic::Duration> shift;
+  for (std::size_t i = 0; i < current.size(); ++i)
+  {
+    const auto route_shift = shift_between(current[i], next[i]);
+    if (!route_shift.has_value())
+      return delta;
+
+    if (shift.has_value() && *shift != *route_shift)
+      return delta;
+
+    shift = route_shift;
+  }
+
+  const bool extended = next.size() > current.size();
+  if (*shift != rmf_traffic::Duration(0))
+  {
+    // The schedule cannot delay some routes and add others in one change
+    if (extended)
+      return delta;
+
+    delta.kind = Kind::Delay;
+    delta.delay = *shift;
+    return delta;
+  }
+
+  if (!extended)
+  {
+    delta.kind = Kind::Unchanged;
+    return delta;
+  }
+
+  for (std::size_t i = current.size(); i < next.size(); ++i)
+  {
+    if (!next[i].dependencies().empty())
+      return delta;
+  }
+
+  delta.kind = Kind::Extend;
+  delta.additional_routes.assign(next.begin() + current.size(), next.end());
+  return delta;
+}
+
+} // namespace rmf_fleet_adapter
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__ITINERARYDELTA_HPP
+#define SRC__RMF_FLEET_ADAPTER__ITINERARYDELTA_HPP
+
+#include <rmf_traffic/schedule/Itinerary.hpp>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// The smallest change that turns the itinerary that is already in the
+/// schedule into a new itinerary for the same plan. Sending this instead of
+/// the whole itinerary saves the schedule node from replacing routes that have
+/// not changed, and keeps the updates that mirrors receive small.
+struct ItineraryDelta
+{
+  enum class Kind
+  {
+    /// The new itinerary is the same as the current one
+    Unchanged,
+
+    /// Every route of the new itinerary is a route of the current one shifted
+    /// by the same amount of time, or both itineraries are a stationary hold
+    /// at the same place and the current hold shifted to end when the new one
+    /// ends would still cover all of the new hold
+    Delay,
+
+    /// The new itinerary starts with every route of the current one and adds
+    /// more routes after them
+    Extend,
+
+    /// The whole itinerary needs to be set
+    Set
+  };
+
+  Kind kind = Kind::Set;
+
+  /// How much the routes were shifted by when kind is Delay
+  rmf_traffic::Duration delay = rmf_traffic::Duration(0);
+
+  /// The routes to add when kind is Extend
+  rmf_traffic::schedule::Itinerary additional_routes = {};
+
+  /// Compare the current itinerary to the next one. Routes that have
+  /// dependencies on other participants are always set in full, since their
+  /// dependencies may have changed even if their trajectories have not.
+  static ItineraryDelta compute(
+    const rmf_traffic::schedule::Itinerary& current,
+    const rmf_traffic::schedule::Itinerary& next);
+};
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__ITINERARYDELTA_HPP
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "JsonOutbox.hpp"
+
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace rmf_fleet_adapter {
+
+namespace {
+//==============================================================================
+// Each job normally takes well under a millisecond, so this many waiting jobs
+// means the outbox is not keeping up with the fleet.
+const std::size_t SaturationThreshold = 64;
+
+//==============================================================================
+void lower_thread_priority()
+{
+#ifdef __linux__
+  // On Linux the nice value belongs to each thread, so this only affects the
+  // calling thread.
+  setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+#endif
+}
+} // anonymous namespace
+
+//==============================================================================
+std::shared_ptr<JsonOutbox> JsonOutbox::make()
+{
+  auto outbox = std::shared_ptr<JsonOutbox>(new JsonOutbox);
+  outbox->_thread = std::thread([o = outbox.get()]() { o->_run(); });
+  return outbox;
+}
+
+//==============================================================================
+void JsonOutbox::push(Job job)
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _jobs.push_back(Entry{std::string(), std::move(job)});
+  }
+  _cv.notify_one();
+}
+
+//==============================================================================
+void JsonOutbox::push_latest(const std::string& key, Job job)
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& entry : _jobs)
+    {
+      if (entry.key == key)
+      {
+        entry.job = std::move(job);
+        return;
+      }
+    }
+
+    _jobs.push_back(Entry{key, std::move(job)});
+  }
+  _cv.notify_one();
+}
+
+//==============================================================================
+std::size_t JsonOutbox::pending() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _jobs.size();
+}
+
+//==============================================================================
+bool JsonOutbox::saturated() const
+{
+  return pending() >= SaturationThreshold;
+}
+
+//==============================================================================
+JsonOutbox::~JsonOutbox()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _cv.notify_one();
+
+  if (_thread.joinable())
+    _thread.join();
+}
+
+//==============================================================================
+void JsonOutbox::_run()
+{
+  lower_thread_priority();
+  while (true)
+  {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _cv.wait(lock, [this]() { return _stop || !_jobs.empty(); });
+      // Finish the jobs that were already pushed before stopping, so the
+      // final updates of the fleet still get published
+      if (_jobs.empty())
+        return;
+
+      job = std::move(_jobs.front().job);
+      _jobs.pop_front();
+    }
+
+    try
+    {
+      job();
+    }
+    catch (...)
+    {
+      // A job that fails must not stop the jobs after it
+    }
+  }
+}
+
+} // namespace rmf_fleet_adapter
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__JSONOUTBOX_HPP
+#define SRC__RMF_FLEET_ADAPTER__JSONOUTBOX_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// Validates, serializes and publishes the messages that a fleet sends to the
+/// API server. The worker of the fleet only builds each message and hands it
+/// over, so schema validation, dumping to strings and queuing for the websocket
+/// can never hold up robot updates or plan execution.
+///
+/// The jobs run one at a time in the order they were pushed, on a background
+/// thread with the lowest scheduling priority. A job must only use what it
+/// captured, since the objects that pushed it may be gone by the time it runs.
+class JsonOutbox
+{
+public:
+
+  using Job = std::function<void()>;
+
+  static std::shared_ptr<JsonOutbox> make();
+
+  /// Queue a job. This may be called from any thread.
+  void push(Job job);
+
+  /// Queue a job that is made obsolete by the next job with the same key,
+  /// such as a full state update. If a job with this key is still waiting, it
+  /// is replaced in place instead of growing the queue.
+  void push_latest(const std::string& key, Job job);
+
+  /// Get how many jobs are waiting to run.
+  std::size_t pending() const;
+
+  /// True if so many jobs are waiting that messages which can be held back,
+  /// like log updates, should be left for later.
+  bool saturated() const;
+
+  /// Stop the thread once every job that was already pushed has run.
+  ~JsonOutbox();
+
+private:
+
+  JsonOutbox() = default;
+
+  void _run();
+
+  struct Entry
+  {
+    std::string key;
+    Job job;
+  };
+
+  mutable std::mutex _mutex;
+  std::condition_variable _cv;
+  std::deque<Entry> _jobs;
+  bool _stop = false;
+  std::thread _thread;
+};
+
+using JsonOutboxPtr = std::shared_ptr<JsonOutbox>;
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__JSONOUTBOX_HPP
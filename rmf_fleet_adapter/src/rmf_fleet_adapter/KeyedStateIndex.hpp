@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__KEYEDSTATEINDEX_HPP
+#define SRC__RMF_FLEET_ADAPTER__KEYEDSTATEINDEX_HPP
+
+#include <rxcpp/rx.hpp>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// Splits a stream of device states into one stream per device, e.g. one per
+/// door name, and remembers the latest state of each device. Each message is
+/// handed only to the subscribers of its own device, so the cost of a message
+/// no longer grows with the number of phases that are watching other devices.
+template<typename Message>
+class KeyedStateIndex
+{
+public:
+
+  using MessagePtr = typename Message::SharedPtr;
+  using KeyFn = std::function<std::string(const Message&)>;
+
+  KeyedStateIndex(KeyFn key)
+  : _key(std::move(key))
+  {
+    // Do nothing
+  }
+
+  /// Pass a new message to the subscribers of its device.
+  void update(const MessagePtr& msg)
+  {
+    if (!msg)
+      return;
+
+    rxcpp::subscriber<MessagePtr> subscriber = [&]()
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto& entry = _entries[_key(*msg)];
+        entry.latest = msg;
+        return entry.subject.get_subscriber();
+      }();
+
+    subscriber.on_next(msg);
+  }
+
+  /// Get the stream of states of one device. Only states that arrive after
+  /// subscribing are delivered.
+  rxcpp::observable<MessagePtr> observe(const std::string& key)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries[key].subject.get_observable();
+  }
+
+  /// Get the latest state of one device, or nullptr if none has arrived yet.
+  MessagePtr latest(const std::string& key) const
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto it = _entries.find(key);
+    if (it == _entries.end())
+      return nullptr;
+
+    return it->second.latest;
+  }
+
+  ~KeyedStateIndex()
+  {
+    for (auto& [_, entry] : _entries)
+      entry.subject.get_subscriber().on_completed();
+  }
+
+private:
+
+  struct Entry
+  {
+    MessagePtr latest;
+    rxcpp::subjects::subject<MessagePtr> subject;
+  };
+
+  KeyFn _key;
+  std::unordered_map<std::string, Entry> _entries;
+  mutable std::mutex _mutex;
+};
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__KEYEDSTATEINDEX_HPP
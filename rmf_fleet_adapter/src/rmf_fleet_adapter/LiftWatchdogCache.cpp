@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+
+#include "LiftWatchdogCache.hpp"
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+std::shared_ptr<LiftWatchdogCache> LiftWatchdogCache::make(
+  Watchdog watchdog,
+  const Clock::duration time_to_live)
+{
+  return std::shared_ptr<LiftWatchdogCache>(
+    new LiftWatchdogCache(std::move(watchdog), time_to_live));
+}
+
+//==============================================================================
+void LiftWatchdogCache::prefetch(
+  const std::string& lift,
+  const std::string& level)
+{
+  const auto key = _key(lift, level);
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& entry = _entries[key];
+    if (entry.pending)
+      return;
+
+    if (entry.decision.has_value()
+      && Clock::now() - entry.received <= _time_to_live)
+    {
+      return;
+    }
+
+    entry.decision = std::nullopt;
+    entry.pending = true;
+  }
+
+  _ask(lift, key);
+}
+
+//==============================================================================
+void LiftWatchdogCache::request(
+  const std::string& lift,
+  const std::string& level,
+  Decide decide)
+{
+  const auto key = _key(lift, level);
+  std::optional<Decision> decision;
+  bool ask = false;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& entry = _entries[key];
+    if (entry.decision.has_value()
+      && Clock::now() - entry.received <= _time_to_live)
+    {
+      decision = entry.decision;
+      entry.decision = std::nullopt;
+    }
+    else
+    {
+      entry.decision = std::nullopt;
+      entry.waiting.push_back(std::move(decide));
+      ask = !entry.pending;
+      entry.pending = true;
+    }
+  }
+
+  if (decision.has_value())
+  {
+    decide(*decision);
+    return;
+  }
+
+  if (ask)
+    _ask(lift, key);
+}
+
+//==============================================================================
+auto LiftWatchdogCache::time_to_live() const -> Clock::duration
+{
+  return _time_to_live;
+}
+
+//==============================================================================
+LiftWatchdogCache::LiftWatchdogCache(
+  Watchdog watchdog,
+  const Clock::duration time_to_live)
+: _watchdog(std::move(watchdog)),
+  _time_to_live(time_to_live)
+{
+  // Do nothing
+}
+
+//==============================================================================
+std::string LiftWatchdogCache::_key(
+  const std::string& lift,
+  const std::string& level)
+{
+  return lift + "\n" + level;
+}
+
+//==============================================================================
+void LiftWatchdogCache::_ask(const std::string& lift, const std::string& key)
+{
+  _watchdog(
+    lift,
+    [w = weak_from_this(), key](Decision decision)
+    {
+      if (const auto self = w.lock())
+        self->_receive(key, decision);
+    });
+}
+
+//==============================================================================
+void LiftWatchdogCache::_receive(const std::string& key, Decision decision)
+{
+  std::vector<Decide> waiting;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& entry = _entries[key];
+    entry.pending = false;
+    waiting = std::move(entry.waiting);
+    entry.waiting.clear();
+    if (waiting.empty())
+    {
+      // Nobody needs this decision yet, so keep it for the next lift entry.
+      entry.decision = decision;
+      entry.received = Clock::now();
+    }
+  }
+
+  // Only one lift entry is waiting on a decision at a time, but if there are
+  // more they all get the same answer.
+  for (const auto& decide : waiting)
+    decide(decision);
+}
+
+} // namespace rmf_fleet_adapter
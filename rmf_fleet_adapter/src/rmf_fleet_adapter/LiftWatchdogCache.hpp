@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+
+#ifndef SRC__RMF_FLEET_ADAPTER__LIFTWATCHDOGCACHE_HPP
+#define SRC__RMF_FLEET_ADAPTER__LIFTWATCHDOGCACHE_HPP
+
+#include <rmf_fleet_adapter/agv/RobotUpdateHandle.hpp>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// Asks the lift entry watchdog of a robot for its decisions ahead of time, so
+/// that the robot does not have to wait for a round trip to the watchdog once
+/// the lift doors open.
+///
+/// A decision can be prefetched for a lift and level while the robot is still
+/// waiting for the lift to arrive. The decision is kept for a short time to
+/// live, after which it is considered stale and a new one gets requested. Each
+/// decision is only used for one lift entry.
+class LiftWatchdogCache
+  : public std::enable_shared_from_this<LiftWatchdogCache>
+{
+public:
+
+  using Unstable = agv::RobotUpdateHandle::Unstable;
+  using Decision = Unstable::Decision;
+  using Decide = Unstable::Decide;
+  using Watchdog = Unstable::Watchdog;
+  using Clock = std::chrono::steady_clock;
+
+  /// Make a cache for the decisions of a watchdog.
+  ///
+  /// \param[in] watchdog
+  ///   The watchdog to ask for decisions.
+  ///
+  /// \param[in] time_to_live
+  ///   How long a decision can be used for after it was received.
+  static std::shared_ptr<LiftWatchdogCache> make(
+    Watchdog watchdog,
+    Clock::duration time_to_live);
+
+  /// Ask the watchdog for a decision about entering the lift at this level,
+  /// unless a decision is already being requested or a fresh one is cached.
+  void prefetch(const std::string& lift, const std::string& level);
+
+  /// Get a decision about entering the lift at this level right now. If a
+  /// fresh decision is cached, decide will be triggered before this function
+  /// returns. Otherwise decide will be triggered when the watchdog answers the
+  /// request that is already pending or a new one. The decision is used up.
+  void request(
+    const std::string& lift,
+    const std::string& level,
+    Decide decide);
+
+  /// Get the time to live of the decisions.
+  Clock::duration time_to_live() const;
+
+private:
+
+  LiftWatchdogCache(Watchdog watchdog, Clock::duration time_to_live);
+
+  struct Entry
+  {
+    std::optional<Decision> decision;
+    Clock::time_point received;
+    bool pending = false;
+    std::vector<Decide> waiting;
+  };
+
+  static std::string _key(const std::string& lift, const std::string& level);
+
+  /// Send a request to the watchdog. The mutex must be unlocked.
+  void _ask(const std::string& lift, const std::string& key);
+
+  void _receive(const std::string& key, Decision decision);
+
+  Watchdog _watchdog;
+  Clock::duration _time_to_live;
+  std::unordered_map<std::string, Entry> _entries;
+  mutable std::mutex _mutex;
+};
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__LIFTWATCHDOGCACHE_HPP
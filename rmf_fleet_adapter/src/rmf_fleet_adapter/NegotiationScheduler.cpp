@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "NegotiationScheduler.hpp"
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+auto NegotiationScheduler::parse_priority(const std::string& value)
+-> std::optional<Priority>
+{
+  if (value == "age")
+    return Priority::Age;
+
+  if (value == "conflict_time")
+    return Priority::ConflictTime;
+
+  return std::nullopt;
+}
+
+//==============================================================================
+std::shared_ptr<NegotiationScheduler> NegotiationScheduler::make(
+  rxcpp::schedulers::worker worker,
+  const std::size_t max_concurrent,
+  const Priority priority)
+{
+  return std::shared_ptr<NegotiationScheduler>(
+    new NegotiationScheduler(std::move(worker), max_concurrent, priority));
+}
+
+//==============================================================================
+NegotiationScheduler::NegotiationScheduler(
+  rxcpp::schedulers::worker worker,
+  const std::size_t max_concurrent,
+  const Priority priority)
+: _worker(std::move(worker)),
+  _max_concurrent(max_concurrent),
+  _queue(ComparePending{priority})
+{
+  // Do nothing
+}
+
+//==============================================================================
+void NegotiationScheduler::submit(
+  const rmf_traffic::Time conflict_time,
+  Start start)
+{
+  if (_max_concurrent == 0)
+  {
+    start(nullptr);
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  if (_running < _max_concurrent)
+  {
+    ++_running;
+    lock.unlock();
+    start(_make_ticket());
+    return;
+  }
+
+  _queue.push(Pending{_next_order++, conflict_time, std::move(start)});
+}
+
+//==============================================================================
+std::size_t NegotiationScheduler::max_concurrent() const
+{
+  return _max_concurrent;
+}
+
+//==============================================================================
+std::size_t NegotiationScheduler::running() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _running;
+}
+
+//==============================================================================
+std::size_t NegotiationScheduler::waiting() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _queue.size();
+}
+
+//==============================================================================
+auto NegotiationScheduler::_make_ticket() -> Ticket
+{
+  return Ticket(
+    nullptr,
+    [w = weak_from_this()](void*)
+    {
+      if (const auto self = w.lock())
+        self->_release();
+    });
+}
+
+//==============================================================================
+void NegotiationScheduler::_release()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  if (_queue.empty())
+  {
+    --_running;
+    return;
+  }
+
+  // Hand the slot directly to the next negotiation. It gets started on the
+  // worker because tickets are usually released while the negotiator that
+  // held them is in the middle of cleaning up.
+  auto next = _queue.top().start;
+  _queue.pop();
+  lock.unlock();
+
+  _worker.schedule(
+    [start = std::move(next), ticket = _make_ticket()](const auto&)
+    {
+      start(ticket);
+    });
+}
+
+} // namespace rmf_fleet_adapter
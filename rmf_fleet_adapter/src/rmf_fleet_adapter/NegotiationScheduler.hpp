@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__NEGOTIATIONSCHEDULER_HPP
+#define SRC__RMF_FLEET_ADAPTER__NEGOTIATIONSCHEDULER_HPP
+
+#include <rmf_rxcpp/RxJobs.hpp>
+
+#include <rmf_traffic/Time.hpp>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// Limits how many negotiation services a fleet adapter runs at once. When
+/// congestion spikes, a fleet adapter can be a party to dozens of negotiations
+/// at the same time, and running all of their planning jobs together starves
+/// the handling of robot commands and state updates. Negotiations that arrive
+/// while the limit is reached wait in a priority queue until a running one
+/// finishes.
+class NegotiationScheduler
+  : public std::enable_shared_from_this<NegotiationScheduler>
+{
+public:
+
+  /// The order that waiting negotiations get started in
+  enum class Priority
+  {
+    /// The negotiation that has been waiting the longest goes first
+    Age,
+
+    /// The negotiation whose conflict happens soonest goes first
+    ConflictTime
+  };
+
+  /// Parse a priority from its parameter value: "age" or "conflict_time".
+  /// Returns std::nullopt for an unknown value.
+  static std::optional<Priority> parse_priority(const std::string& value);
+
+  /// Create a scheduler.
+  ///
+  /// \param[in] worker
+  ///   Negotiations that had to wait get started on this worker.
+  ///
+  /// \param[in] max_concurrent
+  ///   The maximum number of negotiations that can run at once. Zero means
+  ///   there is no limit.
+  ///
+  /// \param[in] priority
+  ///   The order that waiting negotiations get started in.
+  static std::shared_ptr<NegotiationScheduler> make(
+    rxcpp::schedulers::worker worker,
+    std::size_t max_concurrent,
+    Priority priority = Priority::Age);
+
+  /// Held by a running negotiation. The slot of the negotiation is freed when
+  /// the last copy of its ticket is destroyed.
+  using Ticket = std::shared_ptr<void>;
+
+  /// Starts a negotiation. The negotiation must keep the ticket for as long as
+  /// it is running.
+  using Start = std::function<void(Ticket)>;
+
+  /// Submit a negotiation. If there is a free slot it will be started right
+  /// away, before this function returns. Otherwise it waits in the queue.
+  ///
+  /// \param[in] conflict_time
+  ///   When the conflict that this negotiation is about begins. This is only
+  ///   used by Priority::ConflictTime.
+  ///
+  /// \param[in] start
+  ///   The function that starts the negotiation.
+  void submit(rmf_traffic::Time conflict_time, Start start);
+
+  /// Get the maximum number of negotiations that can run at once
+  std::size_t max_concurrent() const;
+
+  /// Get the number of negotiations that are currently running
+  std::size_t running() const;
+
+  /// Get the number of negotiations that are waiting to start
+  std::size_t waiting() const;
+
+private:
+
+  NegotiationScheduler(
+    rxcpp::schedulers::worker worker,
+    std::size_t max_concurrent,
+    Priority priority);
+
+  struct Pending
+  {
+    uint64_t order;
+    rmf_traffic::Time conflict_time;
+    Start start;
+  };
+
+  struct ComparePending
+  {
+    Priority priority;
+
+    // Returns true if a should go after b
+    bool operator()(const Pending& a, const Pending& b) const
+    {
+      if (priority == Priority::ConflictTime
+        && a.conflict_time != b.conflict_time)
+      {
+        return b.conflict_time < a.conflict_time;
+      }
+
+      return b.order < a.order;
+    }
+  };
+
+  Ticket _make_ticket();
+  void _release();
+
+  rxcpp::schedulers::worker _worker;
+  const std::size_t _max_concurrent;
+  mutable std::mutex _mutex;
+  std::size_t _running = 0;
+  uint64_t _next_order = 0;
+  std::priority_queue<Pending, std::vector<Pending>, ComparePending> _queue;
+};
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__NEGOTIATIONSCHEDULER_HPP
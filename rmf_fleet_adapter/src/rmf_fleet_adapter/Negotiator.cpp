@@ -17,6 +17,8 @@
 
 #include "Negotiator.hpp"
 
+#include <rmf_traffic_ros2/Tracing.hpp>
+
 namespace rmf_fleet_adapter {
 
 //==============================================================================
@@ -45,16 +47,88 @@ void Negotiator::respond(
     return;
   }
 
+  _context->node()->negotiation_scheduler()->submit(
+    conflict_time(*table_viewer, _context->now()),
+    [w = weak_from_this(), service, table_viewer](
+      NegotiationScheduler::Ticket ticket)
+    {
+      const auto self = w.lock();
+      if (!self)
+      {
+        service->responder()->forfeit({});
+        return;
+      }
+
+      self->_start(service, table_viewer, std::move(ticket));
+    });
+}
+
+//==============================================================================
+rmf_traffic::Time Negotiator::conflict_time(
+  const TableViewer& table_viewer,
+  const rmf_traffic::Time now)
+{
+  // If we are not accommodating anyone then the conflict is with our own
+  // current itinerary, so we treat it as imminent.
+  std::optional<rmf_traffic::Time> earliest;
+  for (const auto& proposal : table_viewer.base_proposals())
+  {
+    for (const auto& route : proposal.itinerary)
+    {
+      const auto* start = route.trajectory().start_time();
+      if (start && (!earliest.has_value() || *start < *earliest))
+        earliest = *start;
+    }
+  }
+
+  if (!earliest.has_value())
+    return now;
+
+  return std::max(now, *earliest);
+}
+
+//==============================================================================
+void Negotiator::_start(
+  const NegotiatePtr& service,
+  const TableViewerPtr& table_viewer,
+  NegotiationScheduler::Ticket ticket)
+{
+  if (service->discarded() || table_viewer->defunct())
+  {
+    // The negotiation moved on while this service was waiting for its turn
+    return;
+  }
+
+  const auto trace = std::make_shared<rmf_traffic_ros2::tracing::Span>(
+    rmf_traffic_ros2::tracing::Span::begin(
+      "negotiate", _context->copy_current_task_id()));
+  trace->arg("robot", _context->requester_id());
+
   auto negotiate_sub =
     rmf_rxcpp::make_job<services::Negotiate::Result>(service)
     .observe_on(rxcpp::identity_same_worker(_context->worker()))
     .subscribe(
-    [w = weak_from_this()](const auto& result)
+    [
+      w = weak_from_this(),
+      trace
+    ](const auto& result)
     {
+      trace->end();
       if (auto self = w.lock())
       {
         result.respond();
-        self->_negotiate_services.erase(result.service);
+
+        // Release the managers of the service outside of the lock
+        NegotiationManagers finished;
+        {
+          std::lock_guard<std::mutex> lock(self->_negotiate_services_mutex);
+          const auto it = self->_negotiate_services.find(result.service);
+          if (it != self->_negotiate_services.end())
+          {
+            finished = std::move(it->second);
+            self->_negotiate_services.erase(it);
+          }
+        }
       }
       else
       {
@@ -77,23 +151,32 @@ void Negotiator::respond(
         service->interrupt();
     });
 
+  std::lock_guard<std::mutex> lock(_negotiate_services_mutex);
   _negotiate_services[service] = NegotiationManagers{
     std::move(negotiate_sub),
-    std::move(negotiation_timer)
+    std::move(negotiation_timer),
+    std::move(ticket)
   };
 }
 
 //==============================================================================
 services::ProgressEvaluator Negotiator::make_evaluator(
-  const TableViewerPtr& table_viewer)
+  const TableViewerPtr& table_viewer,
+  const services::ProgressEvaluatorTuningPtr& tuning)
 {
-  services::ProgressEvaluator evaluator;
+  services::ProgressEvaluator evaluator = tuning ?
+    tuning->make_evaluator() : services::ProgressEvaluator();
+
   if (table_viewer->parent_id())
   {
+    // The default threshold is 120, and this grows it by a quarter of that
+    // for each rejected version of the parent's proposal.
+    const double threshold_step = evaluator.max_cost_threshold / 4.0;
     const auto& s = table_viewer->sequence();
     assert(s.size() >= 2);
     evaluator.compliant_leeway_base *= s[s.size()-2].version + 1;
-    evaluator.max_cost_threshold = 90.0 + 30.0*s[s.size()-2].version;
+    evaluator.max_cost_threshold =
+      3.0*threshold_step + threshold_step*s[s.size()-2].version;
   }
 
   return evaluator;
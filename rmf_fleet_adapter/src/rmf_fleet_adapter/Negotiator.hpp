@@ -23,6 +23,8 @@
 #include "agv/RobotContext.hpp"
 #include "services/Negotiate.hpp"
 
+#include <mutex>
+
 namespace rmf_fleet_adapter {
 
 //==============================================================================
@@ -45,7 +47,14 @@ public:
     const ResponderPtr& responder) final;
 
   static services::ProgressEvaluator make_evaluator(
-    const TableViewerPtr& table_viewer);
+    const TableViewerPtr& table_viewer,
+    const services::ProgressEvaluatorTuningPtr& tuning = nullptr);
+
+  /// Estimate when the conflict that a table is about begins, for the purpose
+  /// of prioritizing negotiations.
+  static rmf_traffic::Time conflict_time(
+    const TableViewer& table_viewer,
+    rmf_traffic::Time now);
 
   void clear_license();
 
@@ -57,10 +66,19 @@ private:
   {
     rmf_rxcpp::subscription_guard subscription;
     rclcpp::TimerBase::SharedPtr timer;
+    NegotiationScheduler::Ticket ticket;
   };
   using NegotiateServiceMap =
     std::unordered_map<NegotiatePtr, NegotiationManagers>;
   NegotiateServiceMap _negotiate_services;
+  // Negotiations may be answered on the ROS executor or the main worker while
+  // their results arrive on the worker of the robot.
+  std::mutex _negotiate_services_mutex;
+
+  void _start(
+    const NegotiatePtr& service,
+    const TableViewerPtr& table_viewer,
+    NegotiationScheduler::Ticket ticket);
 
   agv::RobotContextPtr _context;
   std::shared_ptr<void> _license;
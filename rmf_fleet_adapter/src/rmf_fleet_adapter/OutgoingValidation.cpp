@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "OutgoingValidation.hpp"
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+OutgoingValidation::OutgoingValidation(const std::size_t sample_period)
+: _sample_period(sample_period)
+{
+  // Do nothing
+}
+
+//==============================================================================
+bool OutgoingValidation::sample()
+{
+#ifndef NDEBUG
+  return true;
+#else
+  const std::size_t period = _sample_period.load(std::memory_order_relaxed);
+  if (period == 0)
+    return false;
+
+  if (period == 1)
+    return true;
+
+  return _count.fetch_add(1, std::memory_order_relaxed) % period == 0;
+#endif
+}
+
+//==============================================================================
+void OutgoingValidation::sample_period(const std::size_t value)
+{
+  _sample_period.store(value, std::memory_order_relaxed);
+}
+
+//==============================================================================
+std::size_t OutgoingValidation::sample_period() const
+{
+  return _sample_period.load(std::memory_order_relaxed);
+}
+
+} // namespace rmf_fleet_adapter
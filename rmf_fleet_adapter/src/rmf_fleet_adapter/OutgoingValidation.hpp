@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__OUTGOINGVALIDATION_HPP
+#define SRC__RMF_FLEET_ADAPTER__OUTGOINGVALIDATION_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// Decides which outgoing messages get validated against their schemas. The
+/// messages that the fleet adapter produces are valid by construction, so in
+/// production it is enough to check a sample of them to catch regressions.
+/// Incoming requests are always validated regardless of this setting.
+///
+/// Debug builds validate every outgoing message.
+class OutgoingValidation
+{
+public:
+
+  /// Validate one out of every sample_period outgoing messages. A
+  /// sample_period of 1 validates every message, which is the default, and
+  /// a sample_period of 0 validates none of them.
+  OutgoingValidation(std::size_t sample_period = 1);
+
+  /// Decide whether the next outgoing message should be validated.
+  bool sample();
+
+  /// Change the sample period.
+  void sample_period(std::size_t value);
+
+  /// Get the sample period.
+  std::size_t sample_period() const;
+
+private:
+  std::atomic_size_t _sample_period;
+  std::atomic_size_t _count{0};
+};
+
+using OutgoingValidationPtr = std::shared_ptr<OutgoingValidation>;
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__OUTGOINGVALIDATION_HPP
@@ -0,0 +1,295 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "PlannerRegistry.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <type_traits>
+
+namespace rmf_fleet_adapter {
+
+namespace {
+//==============================================================================
+/// Appends the exact bytes of values to a fingerprint. Doubles are written
+/// bit for bit so that values which only differ in their last digits are
+/// never treated as equal.
+class Fingerprint
+{
+public:
+
+  template<typename T>
+  Fingerprint& pod(const T& value)
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    _data.append(bytes, sizeof(T));
+    return *this;
+  }
+
+  Fingerprint& str(const std::string& value)
+  {
+    pod<uint64_t>(value.size());
+    _data.append(value);
+    return *this;
+  }
+
+  Fingerprint& vec(const Eigen::Vector2d& value)
+  {
+    return pod(value.x()).pod(value.y());
+  }
+
+  std::string release()
+  {
+    return std::move(_data);
+  }
+
+private:
+  std::string _data;
+};
+
+//==============================================================================
+class EventFingerprint : public rmf_traffic::agv::Graph::Lane::Executor
+{
+public:
+
+  EventFingerprint(Fingerprint& fp)
+  : _fp(fp)
+  {
+    // Do nothing
+  }
+
+  void execute(const Dock& dock) final
+  {
+    _fp.pod<uint8_t>(1).str(dock.dock_name()).pod(dock.duration().count());
+  }
+
+  void execute(const Wait& wait) final
+  {
+    _fp.pod<uint8_t>(2).pod(wait.duration().count());
+  }
+
+  void execute(const DoorOpen& open) final
+  {
+    _fp.pod<uint8_t>(3).str(open.name()).pod(open.duration().count());
+  }
+
+  void execute(const DoorClose& close) final
+  {
+    _fp.pod<uint8_t>(4).str(close.name()).pod(close.duration().count());
+  }
+
+  void execute(const LiftSessionBegin& e) final
+  {
+    _fp.pod<uint8_t>(5).str(e.lift_name()).str(e.floor_name())
+    .pod(e.duration().count());
+  }
+
+  void execute(const LiftMove& e) final
+  {
+    _fp.pod<uint8_t>(6).str(e.lift_name()).str(e.floor_name())
+    .pod(e.duration().count());
+  }
+
+  void execute(const LiftDoorOpen& e) final
+  {
+    _fp.pod<uint8_t>(7).str(e.lift_name()).str(e.floor_name())
+    .pod(e.duration().count());
+  }
+
+  void execute(const LiftSessionEnd& e) final
+  {
+    _fp.pod<uint8_t>(8).str(e.lift_name()).str(e.floor_name())
+    .pod(e.duration().count());
+  }
+
+private:
+  Fingerprint& _fp;
+};
+
+//==============================================================================
+void add_node(
+  Fingerprint& fp,
+  const rmf_traffic::agv::Graph::Lane::Node& node)
+{
+  fp.pod<uint64_t>(node.waypoint_index());
+
+  if (const auto* event = node.event())
+  {
+    EventFingerprint visitor(fp);
+    event->execute(visitor);
+  }
+  else
+  {
+    fp.pod<uint8_t>(0);
+  }
+
+  // Orientation constraints cannot be inspected directly, so record what
+  // they do to a few probe headings.
+  if (const auto* constraint = node.orientation_constraint())
+  {
+    fp.pod<uint8_t>(1);
+    for (const double yaw : {0.0, 1.0, -2.0})
+    {
+      Eigen::Vector3d position(0.0, 0.0, yaw);
+      const bool ok = constraint->apply(position, Eigen::Vector2d::UnitX());
+      fp.pod<uint8_t>(ok).pod(position[2]);
+    }
+  }
+  else
+  {
+    fp.pod<uint8_t>(0);
+  }
+}
+
+} // anonymous namespace
+
+//==============================================================================
+PlannerRegistry& PlannerRegistry::get()
+{
+  static PlannerRegistry registry;
+  return registry;
+}
+
+//==============================================================================
+std::shared_ptr<const rmf_traffic::agv::Planner> PlannerRegistry::share(
+  rmf_traffic::agv::Graph graph,
+  rmf_traffic::agv::VehicleTraits traits)
+{
+  auto key = fingerprint(graph, traits);
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto& entry = _planners[key];
+  if (auto planner = entry.lock())
+    return planner;
+
+  auto planner = std::make_shared<const Planner>(
+    Planner::Configuration(std::move(graph), std::move(traits)),
+    Planner::Options(nullptr));
+  entry = planner;
+
+  // Drop any entries whose planners have been released
+  for (auto it = _planners.begin(); it != _planners.end(); )
+  {
+    if (it->second.expired())
+      it = _planners.erase(it);
+    else
+      ++it;
+  }
+
+  return planner;
+}
+
+//==============================================================================
+std::string PlannerRegistry::fingerprint(
+  const rmf_traffic::agv::Graph& graph,
+  const rmf_traffic::agv::VehicleTraits& traits)
+{
+  Fingerprint fp;
+
+  fp.pod(traits.linear().get_nominal_velocity());
+  fp.pod(traits.linear().get_nominal_acceleration());
+  fp.pod(traits.rotational().get_nominal_velocity());
+  fp.pod(traits.rotational().get_nominal_acceleration());
+  fp.pod(traits.get_steering());
+  if (const auto* differential = traits.get_differential())
+  {
+    fp.vec(differential->get_forward());
+    fp.pod<uint8_t>(differential->is_reversible());
+  }
+
+  for (const auto& shape :
+    {traits.profile().footprint(), traits.profile().vicinity()})
+  {
+    fp.pod(shape ? shape->get_characteristic_length() : -1.0);
+  }
+
+  fp.pod<uint64_t>(graph.num_waypoints());
+  for (std::size_t i = 0; i < graph.num_waypoints(); ++i)
+  {
+    const auto& wp = graph.get_waypoint(i);
+    fp.str(wp.get_map_name());
+    fp.vec(wp.get_location());
+    fp.str(wp.name() ? *wp.name() : std::string());
+    fp.pod<uint8_t>(
+      (wp.is_parking_spot() ? 1 : 0)
+      | (wp.is_holding_point() ? 2 : 0)
+      | (wp.is_passthrough_point() ? 4 : 0)
+      | (wp.is_charger() ? 8 : 0)
+      | (wp.name() ? 16 : 0));
+    fp.str(wp.in_mutex_group());
+    fp.pod(wp.merge_radius().value_or(-1.0));
+    fp.str(wp.in_lift() ? wp.in_lift()->name() : std::string());
+  }
+
+  // Keys can point at waypoints other than the ones they name
+  fp.pod<uint64_t>(graph.keys().size());
+  std::map<std::string, std::size_t> keys(
+    graph.keys().begin(), graph.keys().end());
+  for (const auto& [key, index] : keys)
+    fp.str(key).pod<uint64_t>(index);
+
+  fp.pod<uint64_t>(graph.num_lanes());
+  for (std::size_t i = 0; i < graph.num_lanes(); ++i)
+  {
+    const auto& lane = graph.get_lane(i);
+    add_node(fp, lane.entry());
+    add_node(fp, lane.exit());
+    fp.pod(lane.properties().speed_limit().value_or(-1.0));
+    fp.str(lane.properties().in_mutex_group());
+  }
+
+  const auto lifts = graph.all_known_lifts();
+  fp.pod<uint64_t>(lifts.size());
+  for (const auto& lift : lifts)
+  {
+    fp.str(lift->name());
+    fp.vec(lift->location());
+    fp.pod(lift->orientation());
+    fp.vec(lift->dimensions());
+  }
+
+  const auto doors = graph.all_known_doors();
+  fp.pod<uint64_t>(doors.size());
+  for (const auto& door : doors)
+  {
+    fp.str(door->name());
+    fp.vec(door->start());
+    fp.vec(door->end());
+    fp.str(door->map());
+  }
+
+  return fp.release();
+}
+
+//==============================================================================
+std::size_t PlannerRegistry::size() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::size_t count = 0;
+  for (const auto& entry : _planners)
+  {
+    if (!entry.second.expired())
+      ++count;
+  }
+
+  return count;
+}
+
+} // namespace rmf_fleet_adapter
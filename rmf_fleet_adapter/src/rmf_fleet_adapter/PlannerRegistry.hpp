@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__PLANNERREGISTRY_HPP
+#define SRC__RMF_FLEET_ADAPTER__PLANNERREGISTRY_HPP
+
+#include <rmf_traffic/agv/Planner.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// A process-wide registry of the planners that fleets start out with. When
+/// several fleets in one process are given identical navigation graphs and
+/// vehicle traits, they are handed the same planner, so the graph and the
+/// heuristic caches of the planner are only kept in memory once, and every
+/// fleet benefits from the searches of the others.
+///
+/// Planners are matched on a fingerprint of everything in the graph and the
+/// traits that can affect planning, so two configurations are only shared if
+/// they are exactly equal, not merely similar. The registry only holds weak
+/// references, so a planner is freed as soon as no fleet uses it anymore.
+class PlannerRegistry
+{
+public:
+
+  using Planner = rmf_traffic::agv::Planner;
+
+  /// Get the registry for this process.
+  static PlannerRegistry& get();
+
+  /// Get a planner for this graph and these traits, reusing a planner that
+  /// was already made for an identical graph and traits if one is still in
+  /// use.
+  std::shared_ptr<const Planner> share(
+    rmf_traffic::agv::Graph graph,
+    rmf_traffic::agv::VehicleTraits traits);
+
+  /// Get the fingerprint that planners are matched on.
+  static std::string fingerprint(
+    const rmf_traffic::agv::Graph& graph,
+    const rmf_traffic::agv::VehicleTraits& traits);
+
+  /// Get the number of planners in the registry that are still in use.
+  std::size_t size() const;
+
+private:
+
+  mutable std::mutex _mutex;
+  std::unordered_map<std::string, std::weak_ptr<const Planner>> _planners;
+};
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__PLANNERREGISTRY_HPP
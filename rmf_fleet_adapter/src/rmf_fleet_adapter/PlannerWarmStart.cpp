@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "PlannerWarmStart.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
+namespace rmf_fleet_adapter {
+
+namespace {
+//==============================================================================
+const std::string FileHeader = "rmf_planner_warm_start 1";
+
+//==============================================================================
+template<typename T>
+void hash_combine(std::size_t& seed, const T& value)
+{
+  seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+} // anonymous namespace
+
+//==============================================================================
+std::shared_ptr<PlannerWarmStart> PlannerWarmStart::make(
+  std::string filename,
+  const Planner::Configuration& config,
+  const std::size_t max_entries)
+{
+  std::shared_ptr<PlannerWarmStart> warm_start(
+    new PlannerWarmStart(
+      std::move(filename),
+      key(config),
+      config.graph().num_waypoints(),
+      max_entries));
+
+  warm_start->_load();
+  return warm_start;
+}
+
+//==============================================================================
+std::string PlannerWarmStart::key(const Planner::Configuration& config)
+{
+  std::size_t seed = 0;
+
+  const auto& graph = config.graph();
+  hash_combine(seed, graph.num_waypoints());
+  for (std::size_t i = 0; i < graph.num_waypoints(); ++i)
+  {
+    const auto& wp = graph.get_waypoint(i);
+    hash_combine(seed, wp.get_map_name());
+    hash_combine(seed, wp.get_location().x());
+    hash_combine(seed, wp.get_location().y());
+  }
+
+  hash_combine(seed, graph.num_lanes());
+  for (std::size_t i = 0; i < graph.num_lanes(); ++i)
+  {
+    const auto& lane = graph.get_lane(i);
+    hash_combine(seed, lane.entry().waypoint_index());
+    hash_combine(seed, lane.exit().waypoint_index());
+  }
+
+  const auto& traits = config.vehicle_traits();
+  hash_combine(seed, traits.linear().get_nominal_velocity());
+  hash_combine(seed, traits.linear().get_nominal_acceleration());
+  hash_combine(seed, traits.rotational().get_nominal_velocity());
+  hash_combine(seed, traits.rotational().get_nominal_acceleration());
+  if (const auto* differential = traits.get_differential())
+    hash_combine(seed, differential->is_reversible());
+
+  if (const auto& footprint = traits.profile().footprint())
+    hash_combine(seed, footprint->get_characteristic_length());
+
+  std::stringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << seed;
+  return ss.str();
+}
+
+//==============================================================================
+void PlannerWarmStart::record(
+  const Planner::StartSet& starts,
+  const std::size_t goal)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  for (const auto& start : starts)
+  {
+    if (_entries.size() >= _max_entries)
+      return;
+
+    if (_entries.insert({start.waypoint(), goal}).second)
+      _dirty = true;
+  }
+}
+
+//==============================================================================
+auto PlannerWarmStart::entries() const -> std::vector<Entry>
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return std::vector<Entry>(_entries.begin(), _entries.end());
+}
+
+//==============================================================================
+std::size_t PlannerWarmStart::loaded() const
+{
+  return _loaded;
+}
+
+//==============================================================================
+bool PlannerWarmStart::save()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_dirty)
+    return true;
+
+  // Write to a temporary file first so that a crash while saving cannot leave
+  // behind a truncated record.
+  const std::string temp = _filename + ".tmp";
+  {
+    std::ofstream file(temp, std::ios::trunc);
+    if (!file)
+      return false;
+
+    file << FileHeader << "\n" << _key << "\n";
+    for (const auto& [start, goal] : _entries)
+      file << start << " " << goal << "\n";
+
+    if (!file)
+      return false;
+  }
+
+  if (std::rename(temp.c_str(), _filename.c_str()) != 0)
+    return false;
+
+  _dirty = false;
+  return true;
+}
+
+//==============================================================================
+void PlannerWarmStart::warm_up(std::shared_ptr<const Planner> planner)
+{
+  _stop_warm_up();
+  _stop_warming = false;
+
+  _warming_thread = std::thread(
+    [this, planner = std::move(planner), problems = entries()]()
+    {
+      const auto now = std::chrono::steady_clock::now();
+      for (const auto& [start, goal] : problems)
+      {
+        if (_stop_warming)
+          return;
+
+        // Finding the ideal cost fills the heuristic cache of the
+        // differential drive planner, and the quickest path fills the shortest
+        // path cache.
+        const Planner::Start s(now, start, 0.0);
+        planner->setup(s, Planner::Goal(goal)).ideal_cost();
+        planner->quickest_path({s}, goal);
+      }
+    });
+}
+
+//==============================================================================
+PlannerWarmStart::~PlannerWarmStart()
+{
+  _stop_warm_up();
+  save();
+}
+
+//==============================================================================
+PlannerWarmStart::PlannerWarmStart(
+  std::string filename,
+  std::string key,
+  const std::size_t num_waypoints,
+  const std::size_t max_entries)
+: _filename(std::move(filename)),
+  _key(std::move(key)),
+  _num_waypoints(num_waypoints),
+  _max_entries(max_entries)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void PlannerWarmStart::_load()
+{
+  std::ifstream file(_filename);
+  if (!file)
+    return;
+
+  std::string header;
+  std::string key;
+  if (!std::getline(file, header) || header != FileHeader)
+    return;
+
+  // A record for a different graph or vehicle would not speed anything up,
+  // and its waypoint indices might not even be valid.
+  if (!std::getline(file, key) || key != _key)
+    return;
+
+  std::size_t start;
+  std::size_t goal;
+  while (file >> start >> goal)
+  {
+    if (_entries.size() >= _max_entries)
+      break;
+
+    if (start >= _num_waypoints || goal >= _num_waypoints)
+      continue;
+
+    _entries.insert({start, goal});
+  }
+
+  _loaded = _entries.size();
+}
+
+//==============================================================================
+void PlannerWarmStart::_stop_warm_up()
+{
+  if (!_warming_thread.joinable())
+    return;
+
+  _stop_warming = true;
+  _warming_thread.join();
+}
+
+} // namespace rmf_fleet_adapter
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__PLANNERWARMSTART_HPP
+#define SRC__RMF_FLEET_ADAPTER__PLANNERWARMSTART_HPP
+
+#include <rmf_traffic/agv/Planner.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// Keeps a record on disk of the start and goal waypoints that a fleet has
+/// planned between, so that the planner caches can be warmed up again after
+/// the fleet adapter restarts.
+///
+/// The caches of rmf_traffic::agv::Planner are internal to rmf_traffic and
+/// cannot be serialized, so instead of saving the caches themselves we save
+/// the planning problems that filled them and solve those problems again in
+/// the background at startup. The record is keyed on a hash of the navigation
+/// graph and vehicle traits, and a record whose key does not match the current
+/// planner configuration is discarded.
+class PlannerWarmStart
+{
+public:
+
+  using Planner = rmf_traffic::agv::Planner;
+  using Entry = std::pair<std::size_t, std::size_t>;
+
+  /// Create a warm start record that will be saved to the given file. If the
+  /// file already exists and was saved for the same configuration, its
+  /// entries will be loaded.
+  ///
+  /// \param[in] filename
+  ///   The file to load from and save to.
+  ///
+  /// \param[in] config
+  ///   The configuration of the planner whose problems will be recorded.
+  ///
+  /// \param[in] max_entries
+  ///   The maximum number of start and goal pairs to keep. New pairs are
+  ///   ignored once this is reached.
+  static std::shared_ptr<PlannerWarmStart> make(
+    std::string filename,
+    const Planner::Configuration& config,
+    std::size_t max_entries = 10000);
+
+  /// Get the key that identifies a planner configuration.
+  static std::string key(const Planner::Configuration& config);
+
+  /// Record a planning problem.
+  void record(const Planner::StartSet& starts, std::size_t goal);
+
+  /// Get the start and goal waypoint pairs that have been recorded.
+  std::vector<Entry> entries() const;
+
+  /// Get how many entries were loaded from the file.
+  std::size_t loaded() const;
+
+  /// Save the entries to the file if any new ones have been recorded since
+  /// it was last saved. Returns false if the file could not be written.
+  bool save();
+
+  /// Solve every recorded planning problem on a background thread so that
+  /// the caches of the planner get filled. Any previous warm up is stopped
+  /// first.
+  void warm_up(std::shared_ptr<const Planner> planner);
+
+  /// Stop warming up, then save.
+  ~PlannerWarmStart();
+
+private:
+
+  PlannerWarmStart(
+    std::string filename,
+    std::string key,
+    std::size_t num_waypoints,
+    std::size_t max_entries);
+
+  void _load();
+  void _stop_warm_up();
+
+  std::string _filename;
+  std::string _key;
+  std::size_t _num_waypoints;
+  std::size_t _max_entries;
+  std::size_t _loaded = 0;
+  bool _dirty = false;
+  std::set<Entry> _entries;
+  mutable std::mutex _mutex;
+
+  std::atomic_bool _stop_warming{false};
+  std::thread _warming_thread;
+};
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__PLANNERWARMSTART_HPP
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "PulloverCandidates.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_set>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+std::shared_ptr<PulloverCandidates> PulloverCandidates::make(
+  std::shared_ptr<const Planner> planner,
+  std::size_t max_candidates)
+{
+  std::shared_ptr<PulloverCandidates> candidates(
+    new PulloverCandidates(std::move(planner), max_candidates));
+
+  candidates->_thread =
+    std::thread([c = candidates.get()]() { c->_fill(); });
+  return candidates;
+}
+
+//==============================================================================
+std::optional<std::vector<std::size_t>> PulloverCandidates::get(
+  const rmf_traffic::agv::Plan::StartSet& starts) const
+{
+  if (!ready() || starts.empty())
+    return std::nullopt;
+
+  std::vector<std::size_t> result;
+  std::unordered_set<std::size_t> included;
+  for (const auto& start : starts)
+  {
+    const std::size_t wp = start.waypoint();
+    if (wp >= _candidates.size())
+      return std::nullopt;
+
+    for (const std::size_t spot : _candidates[wp])
+    {
+      if (included.insert(spot).second)
+        result.push_back(spot);
+    }
+  }
+
+  if (result.empty())
+    return std::nullopt;
+
+  return result;
+}
+
+//==============================================================================
+auto PulloverCandidates::planner() const
+-> const std::shared_ptr<const Planner>&
+{
+  return _planner;
+}
+
+//==============================================================================
+bool PulloverCandidates::ready() const
+{
+  return _ready.load(std::memory_order_acquire);
+}
+
+//==============================================================================
+PulloverCandidates::~PulloverCandidates()
+{
+  _stop = true;
+  if (_thread.joinable())
+    _thread.join();
+}
+
+//==============================================================================
+PulloverCandidates::PulloverCandidates(
+  std::shared_ptr<const Planner> planner,
+  std::size_t max_candidates)
+: _planner(std::move(planner)),
+  _max_candidates(max_candidates)
+{
+  const auto& graph = _planner->get_configuration().graph();
+  for (std::size_t i = 0; i < graph.num_waypoints(); ++i)
+  {
+    if (graph.get_waypoint(i).is_parking_spot())
+      _parking_spots.push_back(i);
+  }
+}
+
+//==============================================================================
+void PulloverCandidates::_fill()
+{
+  const std::size_t N = _planner->get_configuration().graph().num_waypoints();
+  const std::size_t P = _parking_spots.size();
+  std::vector<double> costs(N * P, std::numeric_limits<double>::infinity());
+
+  // Go through one parking spot at a time so that each one gets its planner
+  // cache filled in once and then reused by every start.
+  const auto now = std::chrono::steady_clock::now();
+  for (std::size_t p = 0; p < P; ++p)
+  {
+    const Planner::Goal goal(_parking_spots[p]);
+    for (std::size_t wp = 0; wp < N; ++wp)
+    {
+      if (_stop)
+        return;
+
+      const auto ideal = _planner->setup(
+        Planner::Start(now, wp, 0.0), goal).ideal_cost();
+
+      if (ideal.has_value())
+        costs[wp * P + p] = *ideal;
+    }
+  }
+
+  _candidates.resize(N);
+  std::vector<std::size_t> order(P);
+  for (std::size_t wp = 0; wp < N; ++wp)
+  {
+    for (std::size_t p = 0; p < P; ++p)
+      order[p] = p;
+
+    const double* row = costs.data() + wp * P;
+    std::stable_sort(order.begin(), order.end(),
+      [row](std::size_t a, std::size_t b) { return row[a] < row[b]; });
+
+    auto& candidates = _candidates[wp];
+    for (const std::size_t p : order)
+    {
+      if (candidates.size() >= _max_candidates || std::isinf(row[p]))
+        break;
+
+      candidates.push_back(_parking_spots[p]);
+    }
+  }
+
+  _ready.store(true, std::memory_order_release);
+}
+
+} // namespace rmf_fleet_adapter
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__PULLOVERCANDIDATES_HPP
+#define SRC__RMF_FLEET_ADAPTER__PULLOVERCANDIDATES_HPP
+
+#include <rmf_traffic/agv/Planner.hpp>
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// For every waypoint of a navigation graph, the parking spots that a robot
+/// on that waypoint can reach most quickly, according to an emergency planner.
+///
+/// The candidates are found on a background thread. Finding them also fills
+/// the caches of the planner for every parking spot, so an emergency pullover
+/// search that uses the same planner does not have to start from cold caches.
+/// A set of candidates belongs to one planner, so a new one needs to be made
+/// whenever the planner is replaced.
+class PulloverCandidates
+{
+public:
+
+  using Planner = rmf_traffic::agv::Planner;
+
+  /// Make the candidates for the given planner and start finding them.
+  ///
+  /// \param[in] planner
+  ///   The planner that emergency pullovers will be searched with.
+  ///
+  /// \param[in] max_candidates
+  ///   The most parking spots to keep for each waypoint.
+  static std::shared_ptr<PulloverCandidates> make(
+    std::shared_ptr<const Planner> planner,
+    std::size_t max_candidates);
+
+  /// Get the parking spots that are worth searching for a robot that may start
+  /// from any of the given starts, ordered from the quickest to reach. This is
+  /// std::nullopt until every candidate has been found, or if no parking spot
+  /// can be reached from the starts, in which case every parking spot should
+  /// be searched instead.
+  std::optional<std::vector<std::size_t>> get(
+    const rmf_traffic::agv::Plan::StartSet& starts) const;
+
+  /// Get the planner that the candidates were found with.
+  const std::shared_ptr<const Planner>& planner() const;
+
+  /// True once the candidates of every waypoint have been found.
+  bool ready() const;
+
+  /// Stop finding candidates.
+  ~PulloverCandidates();
+
+private:
+
+  PulloverCandidates(
+    std::shared_ptr<const Planner> planner,
+    std::size_t max_candidates);
+
+  void _fill();
+
+  std::shared_ptr<const Planner> _planner;
+  std::size_t _max_candidates;
+  std::vector<std::size_t> _parking_spots;
+
+  // The candidates of each waypoint, only to be read once _ready is true
+  std::vector<std::vector<std::size_t>> _candidates;
+
+  std::atomic_bool _ready{false};
+  std::atomic_bool _stop{false};
+  std::thread _thread;
+};
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__PULLOVERCANDIDATES_HPP
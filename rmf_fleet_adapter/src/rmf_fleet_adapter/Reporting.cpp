@@ -16,6 +16,9 @@
 */
 
 #include "Reporting.hpp"
+#include "log_to_json.hpp"
+
+#include <chrono>
 
 namespace rmf_fleet_adapter {
 
@@ -26,6 +29,18 @@ Reporting::Upstream::Upstream(rxcpp::schedulers::worker worker_)
   // Do nothing
 }
 
+//==============================================================================
+void Reporting::Upstream::push(rmf_task::Log::Tier tier, std::string text)
+{
+  unsent.push(
+    log_to_json(
+      next_seq.fetch_add(1, std::memory_order_relaxed),
+      tier,
+      std::chrono::system_clock::now().time_since_epoch(),
+      text));
+  unsent_size.fetch_add(1, std::memory_order_relaxed);
+}
+
 //==============================================================================
 void Reporting::Ticket::resolve(nlohmann::json msg)
 {
@@ -50,7 +65,8 @@ void Reporting::Ticket::resolve(nlohmann::json msg)
       std::lock_guard<std::mutex> lock(upstream->mutex);
       if (upstream->open_issues.erase(issue) > 0)
       {
-        upstream->log.info(
+        upstream->push(
+          rmf_task::Log::Tier::Info,
           "Resolved issue [" + issue->category + "]: " + msg.dump());
       }
     });
@@ -81,7 +97,9 @@ Reporting::Ticket::~Ticket()
       std::lock_guard<std::mutex> lock(upstream->mutex);
 
       if (upstream->open_issues.erase(issue) > 0)
-        upstream->log.warn("Dropped issue [" + issue->category + "]");
+        upstream->push(
+          rmf_task::Log::Tier::Warning,
+          "Dropped issue [" + issue->category + "]");
     });
 }
 
@@ -115,11 +133,14 @@ std::unique_ptr<Reporting::Ticket> Reporting::create_issue(
   auto issue = std::make_shared<Issue>(
     Issue{std::move(category), std::move(detail)});
 
-  std::lock_guard<std::mutex> lock(_data->mutex);
-  _data->log.push(
+  _data->push(
     tier, "Opened issue [" + issue->category + "]: " + issue->detail.dump());
 
-  _data->open_issues.insert(issue);
+  {
+    std::lock_guard<std::mutex> lock(_data->mutex);
+    _data->open_issues.insert(issue);
+  }
+
   return std::unique_ptr<Ticket>(new Ticket(issue, _data));
 }
 
@@ -130,15 +151,41 @@ auto Reporting::open_issues() const -> const std::unordered_set<IssuePtr>&
 }
 
 //==============================================================================
-rmf_task::Log& Reporting::log()
+void Reporting::push(rmf_task::Log::Tier tier, std::string text)
+{
+  _data->push(tier, std::move(text));
+}
+
+//==============================================================================
+std::vector<nlohmann::json> Reporting::take_unsent()
+{
+  std::vector<nlohmann::json> unsent;
+  nlohmann::json entry;
+  while (_data->unsent.pop(entry))
+    unsent.push_back(std::move(entry));
+
+  _data->unsent_size.fetch_sub(unsent.size(), std::memory_order_relaxed);
+  return unsent;
+}
+
+//==============================================================================
+std::size_t Reporting::unsent_size() const
 {
-  return _data->log;
+  return _data->unsent_size.load(std::memory_order_relaxed);
 }
 
 //==============================================================================
-const rmf_task::Log& Reporting::log() const
+std::size_t Reporting::drop_oldest_unsent(std::size_t max_unsent)
 {
-  return _data->log;
+  std::size_t dropped = 0;
+  nlohmann::json entry;
+  while (unsent_size() > max_unsent && _data->unsent.pop(entry))
+  {
+    _data->unsent_size.fetch_sub(1, std::memory_order_relaxed);
+    ++dropped;
+  }
+
+  return dropped;
 }
 
 } // namespace rmf_fleet_adapter
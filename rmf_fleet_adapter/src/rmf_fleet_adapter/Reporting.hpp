@@ -23,8 +23,12 @@
 
 #include <rxcpp/rx-includes.hpp>
 
+#include <rmf_rxcpp/detail/MpscQueue.hpp>
+
+#include <atomic>
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 namespace rmf_fleet_adapter {
 
@@ -46,8 +50,16 @@ public:
   {
     Upstream(rxcpp::schedulers::worker worker_);
 
+    /// Serialize an entry for the next fleet log update. This does not lock
+    /// the mutex, so it may be called from any thread at any time.
+    void push(rmf_task::Log::Tier tier, std::string text);
+
+    // The mutex only protects open_issues. Log entries go through a lock-free
+    // queue so that frequent loggers never contend with each other.
     OpenIssues open_issues;
-    rmf_task::Log log;
+    std::atomic_uint64_t next_seq = 0;
+    rmf_rxcpp::detail::MpscQueue<nlohmann::json> unsent;
+    std::atomic_size_t unsent_size = 0;
     rxcpp::schedulers::worker worker;
     std::mutex mutex;
   };
@@ -73,6 +85,7 @@ public:
 
   Reporting(rxcpp::schedulers::worker worker);
 
+  /// The mutex that protects open_issues()
   std::mutex& mutex() const;
 
   std::unique_ptr<Ticket> create_issue(
@@ -82,9 +95,24 @@ public:
 
   const std::unordered_set<IssuePtr>& open_issues() const;
 
-  rmf_task::Log& log();
+  /// Push an entry into the log. This may be called from any thread without
+  /// locking the mutex.
+  void push(rmf_task::Log::Tier tier, std::string text);
+
+  /// Take the serialized log entries that have not been sent in a fleet log
+  /// update yet. Each entry is serialized when it gets pushed, so robots
+  /// without new entries cost nothing here. Only one thread may take the
+  /// entries of a robot at a time.
+  std::vector<nlohmann::json> take_unsent();
+
+  /// Get the number of log entries that have not been sent yet.
+  std::size_t unsent_size() const;
 
-  const rmf_task::Log& log() const;
+  /// Drop the oldest log entries that have not been sent yet until no more
+  /// than max_unsent are left, e.g. while the log updates cannot be sent.
+  /// This takes entries out of the queue, so it must not be called at the
+  /// same time as take_unsent(). Returns the number of dropped entries.
+  std::size_t drop_oldest_unsent(std::size_t max_unsent);
 
 private:
   std::shared_ptr<Upstream> _data;
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "TaskDescriptionCache.hpp"
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+TaskDescriptionCache::TaskDescriptionCache(std::size_t capacity)
+: _capacity(capacity)
+{
+  // Do nothing
+}
+
+//==============================================================================
+auto TaskDescriptionCache::find(
+  const std::string& category,
+  const nlohmann::json& description_msg) -> ConstDescriptionPtr
+{
+  if (_capacity == 0)
+    return nullptr;
+
+  const auto key = _key(category, description_msg);
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto it = _index.find(key);
+  if (it == _index.end())
+    return nullptr;
+
+  _entries.splice(_entries.begin(), _entries, it->second);
+  return it->second->second;
+}
+
+//==============================================================================
+void TaskDescriptionCache::insert(
+  const std::string& category,
+  const nlohmann::json& description_msg,
+  ConstDescriptionPtr description)
+{
+  if (_capacity == 0 || !description)
+    return;
+
+  auto key = _key(category, description_msg);
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto it = _index.find(key);
+  if (it != _index.end())
+  {
+    it->second->second = std::move(description);
+    _entries.splice(_entries.begin(), _entries, it->second);
+    return;
+  }
+
+  _entries.emplace_front(key, std::move(description));
+  _index.insert({std::move(key), _entries.begin()});
+  while (_entries.size() > _capacity)
+  {
+    _index.erase(_entries.back().first);
+    _entries.pop_back();
+  }
+}
+
+//==============================================================================
+void TaskDescriptionCache::clear()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _index.clear();
+  _entries.clear();
+}
+
+//==============================================================================
+std::size_t TaskDescriptionCache::size() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _entries.size();
+}
+
+//==============================================================================
+std::string TaskDescriptionCache::_key(
+  const std::string& category,
+  const nlohmann::json& description_msg)
+{
+  // The fields of JSON objects are kept sorted, so the dump is canonical
+  return category + '\n' + description_msg.dump();
+}
+
+} // namespace rmf_fleet_adapter
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__TASKDESCRIPTIONCACHE_HPP
+#define SRC__RMF_FLEET_ADAPTER__TASKDESCRIPTIONCACHE_HPP
+
+#include <rmf_task/Task.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// Remembers the task descriptions that were deserialized from JSON so that
+/// the same description does not get validated and deserialized again each
+/// time it shows up, e.g. when a task gets bid on more than once or when the
+/// same composed task is requested repeatedly.
+///
+/// Descriptions are keyed on their category and the canonical dump of their
+/// JSON, so requests that only differ in the order of their fields share an
+/// entry. Only descriptions that were deserialized successfully are kept. The
+/// least recently used description is forgotten once the capacity is reached.
+///
+/// The cache must be cleared whenever the deserializers or the callbacks that
+/// consider requests are changed, since those decide what a description turns
+/// into.
+class TaskDescriptionCache
+{
+public:
+
+  using ConstDescriptionPtr = std::shared_ptr<const rmf_task::Task::Description>;
+
+  /// \param[in] capacity
+  ///   The largest number of descriptions to keep. Nothing is kept when this
+  ///   is zero.
+  explicit TaskDescriptionCache(std::size_t capacity = 128);
+
+  /// Get the description that was deserialized from this JSON before, or a
+  /// nullptr if it is not cached.
+  ConstDescriptionPtr find(
+    const std::string& category,
+    const nlohmann::json& description_msg);
+
+  /// Remember the description that was deserialized from this JSON.
+  void insert(
+    const std::string& category,
+    const nlohmann::json& description_msg,
+    ConstDescriptionPtr description);
+
+  /// Forget all descriptions.
+  void clear();
+
+  /// The number of descriptions that are cached.
+  std::size_t size() const;
+
+private:
+
+  static std::string _key(
+    const std::string& category,
+    const nlohmann::json& description_msg);
+
+  using Entry = std::pair<std::string, ConstDescriptionPtr>;
+
+  std::size_t _capacity;
+  std::list<Entry> _entries;
+  std::unordered_map<std::string, std::list<Entry>::iterator> _index;
+  mutable std::mutex _mutex;
+};
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__TASKDESCRIPTIONCACHE_HPP
@@ -24,6 +24,7 @@
 #include <rmf_task/requests/Loop.hpp>
 
 #include <rmf_traffic_ros2/Time.hpp>
+#include <rmf_traffic_ros2/Tracing.hpp>
 
 #include <rmf_traffic/agv/Planner.hpp>
 
@@ -73,6 +74,30 @@
 
 namespace rmf_fleet_adapter {
 
+//==============================================================================
+class TaskManager::EstimateJob
+{
+public:
+
+  EstimateJob(EstimateInputs inputs, rclcpp::Logger logger)
+  : _inputs(std::move(inputs)),
+    _logger(std::move(logger))
+  {
+    // Do nothing
+  }
+
+  template<typename Subscriber>
+  void operator()(const Subscriber& s)
+  {
+    s.on_next(_estimate(_inputs, _logger));
+    s.on_completed();
+  }
+
+private:
+  EstimateInputs _inputs;
+  rclcpp::Logger _logger;
+};
+
 //==============================================================================
 TaskManagerPtr TaskManager::make(
   agv::RobotContextPtr context,
@@ -294,7 +319,7 @@ namespace {
 nlohmann::json& copy_phase_data(
   nlohmann::json& phases,
   const rmf_task::Phase::Active& snapshot,
-  rmf_task::Log::Reader& reader,
+  rmf_task::Log::Reader* reader,
   nlohmann::json& all_phase_logs,
   bool quiet_cancel = false)
 {
@@ -343,9 +368,13 @@ nlohmann::json& copy_phase_data(
     event_state["detail"] =
       *rmf_task::VersionedString::Reader().read(top->detail());
 
+    // Without a reader the new log entries are left for the next update
     std::vector<nlohmann::json> logs;
-    for (const auto& log : reader.read(top->log()))
-      logs.push_back(log_to_json(log));
+    if (reader)
+    {
+      for (const auto& log : reader->read(top->log()))
+        logs.push_back(log_to_json(log));
+    }
 
     if (!logs.empty())
       event_logs[std::to_string(top->id())] = std::move(logs);
@@ -399,10 +428,10 @@ void copy_booking_data(
     booking_json["unix_millis_request_time"] =
       to_millis(request_time.value().time_since_epoch()).count();
   }
-  const auto labels = booking.labels();
-  if (labels.size() != 0)
+  const auto& labels = booking.labels();
+  if (!labels.empty())
   {
-    booking_json["labels"] = booking.labels();
+    booking_json["labels"] = labels;
   }
   const auto priority = booking.priority();
   if (priority)
@@ -445,25 +474,29 @@ TaskManager::ActiveTask TaskManager::ActiveTask::start(
 //==============================================================================
 void TaskManager::ActiveTask::publish_task_state(TaskManager& mgr)
 {
-  auto task_state_update = mgr._task_state_update_json;
-
   const auto& booking = *_task->tag()->booking();
-  copy_booking_data(_state_msg["booking"], booking);
-  const auto& header = _task->tag()->header();
-  _state_msg["category"] = header.category();
-  _state_msg["detail"] = header.detail();
+  if (!_state_msg_initialized)
+  {
+    // These fields do not change while the task is active, so they only need
+    // to be filled in once.
+    copy_booking_data(_state_msg["booking"], booking);
+    const auto& header = _task->tag()->header();
+    _state_msg["category"] = header.category();
+    _state_msg["detail"] = header.detail();
+    _state_msg["unix_millis_start_time"] =
+      to_millis(_start_time.time_since_epoch()).count();
+    _state_msg["original_estimate_millis"] =
+      std::max(0l, to_millis(header.original_duration_estimate()).count());
+    copy_assignment(_state_msg["assigned_to"], *mgr._context);
+    _state_msg_initialized = true;
+  }
 
   const auto remaining_time_estimate = _task->estimate_remaining_time();
   const auto finish_estimate = mgr.context()->now()+remaining_time_estimate;
-  _state_msg["unix_millis_start_time"] =
-    to_millis(_start_time.time_since_epoch()).count();
   _state_msg["unix_millis_finish_time"] =
     to_millis(finish_estimate.time_since_epoch()).count();
-  _state_msg["original_estimate_millis"] =
-    std::max(0l, to_millis(header.original_duration_estimate()).count());
   _state_msg["estimate_millis"] =
     std::max(0l, to_millis(remaining_time_estimate).count());
-  copy_assignment(_state_msg["assigned_to"], *mgr._context);
   _state_msg["status"] =
     status_to_string(_task->status_overview());
   auto& phases = _state_msg["phases"];
@@ -472,13 +505,19 @@ void TaskManager::ActiveTask::publish_task_state(TaskManager& mgr)
   task_logs["task_id"] = booking.id();
   auto& phase_logs = task_logs["phases"];
 
+  // While the websocket server is not keeping up, hold on to new log entries
+  // instead of building log updates that would only be dropped. The final
+  // update of a task always carries its logs.
+  auto* const log_reader =
+    !is_finished() && mgr._broadcast_saturated() ? nullptr : &mgr._log_reader;
+
   std::vector<uint64_t> completed_ids;
   completed_ids.reserve(_task->completed_phases().size());
   for (const auto& completed : _task->completed_phases())
   {
     const auto& snapshot = completed->snapshot();
     auto& phase = copy_phase_data(
-      phases, *snapshot, mgr._log_reader, phase_logs, _quiet_cancel);
+      phases, *snapshot, log_reader, phase_logs, _quiet_cancel);
     phase["unix_millis_start_time"] =
       to_millis(completed->start_time().time_since_epoch()).count();
 
@@ -494,7 +533,7 @@ void TaskManager::ActiveTask::publish_task_state(TaskManager& mgr)
     return;
   auto& active =
     copy_phase_data(
-    phases, *active_phase, mgr._log_reader, phase_logs, _quiet_cancel);
+    phases, *active_phase, log_reader, phase_logs, _quiet_cancel);
   if (_task->active_phase_start_time().has_value())
   {
     active["unix_millis_start_time"] =
@@ -543,19 +582,29 @@ void TaskManager::ActiveTask::publish_task_state(TaskManager& mgr)
     _state_msg["status"] = status_to_string(rmf_task::Event::Status::Completed);
   }
 
+  // The update gets its own copy of the state message because the state keeps
+  // changing while the update waits to be validated and published.
+  auto task_state_update = mgr._task_state_update_json;
   task_state_update["data"] = _state_msg;
 
   static const auto task_update_validator =
     mgr._make_validator(rmf_api_msgs::schemas::task_state_update);
-  mgr._validate_and_publish_json(task_state_update, task_update_validator);
+  mgr._validate_and_publish_json(
+    std::move(task_state_update), task_update_validator);
+
+  // The log reader only gives back entries that have not been published yet,
+  // so there is nothing to send if none of the events have new entries.
+  if (mgr._retain_task_log(task_logs) == 0)
+    return;
 
   auto task_log_update = nlohmann::json();
   task_log_update["type"] = "task_log_update";
-  task_log_update["data"] = task_logs;
+  task_log_update["data"] = std::move(task_logs);
 
   static const auto log_update_validator =
     mgr._make_validator(rmf_api_msgs::schemas::task_log_update);
-  mgr._validate_and_publish_json(task_log_update, log_update_validator);
+  mgr._validate_and_publish_json(
+    std::move(task_log_update), log_update_validator);
 }
 
 //==============================================================================
@@ -626,6 +675,15 @@ bool TaskManager::ActiveTask::is_finished() const
   return true;
 }
 
+//==============================================================================
+rmf_task::Event::Status TaskManager::ActiveTask::status() const
+{
+  if (_task)
+    return _task->status_overview();
+
+  return rmf_task::Event::Status::Uninitialized;
+}
+
 //==============================================================================
 std::vector<std::string> TaskManager::ActiveTask::remove_interruption(
   std::vector<std::string> for_tokens,
@@ -798,6 +856,88 @@ std::vector<std::string> TaskManager::ActiveTask::remove_skips(
   return missing_tokens;
 }
 
+//==============================================================================
+TaskQueueBackup::TaskIds TaskManager::queued_task_ids() const
+{
+  std::lock_guard<std::recursive_mutex> lock(_mutex);
+  TaskQueueBackup::TaskIds ids;
+  ids.dispatched.reserve(_queue.size() + 1);
+  if (_active_task)
+    ids.dispatched.push_back(_active_task.id());
+
+  for (const auto& a : _queue)
+  {
+    const auto& booking = *a.request()->booking();
+    if (!booking.automatic())
+      ids.dispatched.push_back(booking.id());
+  }
+
+  ids.direct.reserve(_direct_queue.size());
+  for (const auto& d : _direct_queue)
+  {
+    const auto& booking = *d.assignment.request()->booking();
+    if (!booking.automatic())
+      ids.direct.push_back(booking.id());
+  }
+
+  return ids;
+}
+
+//==============================================================================
+void TaskManager::restore_queue(
+  const std::vector<rmf_task::ConstRequestPtr>& requests)
+{
+  if (requests.empty())
+    return;
+
+  const auto task_planner = _context->task_planner();
+  if (!task_planner)
+  {
+    RCLCPP_ERROR(
+      _context->node()->get_logger(),
+      "Unable to restore %lu tasks for [%s] because its fleet is not "
+      "configured for task planning",
+      requests.size(),
+      _context->requester_id().c_str());
+    return;
+  }
+
+  const auto& constraints = task_planner->configuration().constraints();
+  const auto& parameters = task_planner->configuration().parameters();
+
+  std::vector<Assignment> assignments;
+  {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    assignments = _queue;
+  }
+
+  auto state = assignments.empty() ?
+    expected_finish_state() : assignments.back().finish_state();
+  assignments.reserve(assignments.size() + requests.size());
+  for (const auto& request : requests)
+  {
+    const auto model = request->description()->make_model(
+      request->booking()->earliest_start_time(),
+      parameters);
+    const auto estimate = model->estimate_finish(
+      state, constraints, *_travel_estimator);
+
+    if (!estimate.has_value())
+    {
+      // Keep the task anyway, just like a direct task that cannot be
+      // estimated, so that it does not get lost by the restore.
+      assignments.emplace_back(
+        request, state, request->booking()->earliest_start_time());
+      continue;
+    }
+
+    state = estimate->finish_state();
+    assignments.emplace_back(request, state, estimate->wait_until());
+  }
+
+  set_queue(assignments);
+}
+
 //==============================================================================
 std::optional<std::string> TaskManager::current_task_id() const
 {
@@ -853,13 +993,21 @@ std::string TaskManager::robot_status() const
 auto TaskManager::expected_finish_state() const -> State
 {
   std::lock_guard<std::recursive_mutex> lock(_mutex);
+  if (_expected_finish_state_cache.has_value())
+    return *_expected_finish_state_cache;
+
   if (!_direct_queue.empty())
   {
-    return _direct_queue.rbegin()->assignment.finish_state();
+    _expected_finish_state_cache =
+      _direct_queue.rbegin()->assignment.finish_state();
+    return *_expected_finish_state_cache;
   }
 
   if (_active_task)
-    return _context->current_task_end_state();
+  {
+    _expected_finish_state_cache = _context->current_task_end_state();
+    return *_expected_finish_state_cache;
+  }
 
   rmf_task::State current_state =
     _context->make_get_state()()
@@ -981,9 +1129,23 @@ void TaskManager::set_queue(
     }
 
     _queue = assignments;
+    _invalidate_expectations();
     _publish_task_queue();
   }
 
+  // The fleet sets the queue from its own worker, so when robots are spread
+  // across their own threads, start the task on this robot's worker.
+  if (_context->node()->shards_robots())
+  {
+    _context->worker().schedule(
+      [w = weak_from_this()](const auto&)
+      {
+        if (const auto self = w.lock())
+          self->_begin_next_task();
+      });
+    return;
+  }
+
   _begin_next_task();
 }
 
@@ -991,8 +1153,11 @@ void TaskManager::set_queue(
 std::vector<rmf_task::ConstRequestPtr> TaskManager::dispatched_requests() const
 {
   using namespace rmf_task::requests;
-  std::vector<rmf_task::ConstRequestPtr> requests;
   std::lock_guard<std::recursive_mutex> lock(_mutex);
+  if (_dispatched_requests_cache.has_value())
+    return *_dispatched_requests_cache;
+
+  std::vector<rmf_task::ConstRequestPtr> requests;
   requests.reserve(_queue.size());
   for (const auto& task : _queue)
   {
@@ -1003,9 +1168,20 @@ std::vector<rmf_task::ConstRequestPtr> TaskManager::dispatched_requests() const
 
     requests.push_back(task.request());
   }
+
+  _dispatched_requests_cache = requests;
   return requests;
 }
 
+//==============================================================================
+void TaskManager::_invalidate_expectations()
+{
+  _expected_finish_state_cache = std::nullopt;
+  _dispatched_requests_cache = std::nullopt;
+  _queue_index_cache = std::nullopt;
+  ++_expectations_version;
+}
+
 //==============================================================================
 void TaskManager::reassign_dispatched_requests(
   std::function<void()> on_success,
@@ -1022,6 +1198,37 @@ void TaskManager::reassign_dispatched_requests(
     return;
   }
 
+  // The fleet's state belongs to the fleet worker, which is not the worker
+  // of this robot when robots are spread across their own threads.
+  if (_context->node()->shards_robots())
+  {
+    auto& fleet_impl = agv::FleetUpdateHandle::Implementation::get(*fleet);
+    fleet_impl.worker.schedule(
+      [
+        self = shared_from_this(),
+        fleet,
+        assignments = std::move(assignments),
+        on_success = std::move(on_success),
+        on_failure = std::move(on_failure)
+      ](const auto&)
+      {
+        self->_reassign_on_fleet(fleet, assignments, on_success, on_failure);
+      });
+    return;
+  }
+
+  _reassign_on_fleet(
+    fleet, std::move(assignments), std::move(on_success),
+    std::move(on_failure));
+}
+
+//==============================================================================
+void TaskManager::_reassign_on_fleet(
+  const std::shared_ptr<agv::FleetUpdateHandle>& fleet,
+  std::vector<Assignment> assignments,
+  std::function<void()> on_success,
+  std::function<void(std::vector<std::string>)> on_failure)
+{
   auto& fleet_impl = agv::FleetUpdateHandle::Implementation::get(*fleet);
   auto& unassigned = fleet_impl.unassigned_requests;
   for (const auto& a : assignments)
@@ -1121,16 +1328,69 @@ TaskManager::RobotModeMsg TaskManager::robot_mode() const
 }
 
 //==============================================================================
-std::vector<nlohmann::json> TaskManager::task_log_updates() const
+std::size_t TaskManager::_retain_task_log(const nlohmann::json& task_logs)
+{
+  const auto& task_id = task_logs["task_id"].get<std::string>();
+  auto& retained = _task_logs[task_id];
+  retained["task_id"] = task_id;
+
+  std::size_t new_entries = 0;
+  const auto phases_it = task_logs.find("phases");
+  if (phases_it == task_logs.end())
+    return new_entries;
+
+  for (auto p_it = phases_it->begin(); p_it != phases_it->end(); ++p_it)
+  {
+    const auto events_it = p_it->find("events");
+    if (events_it == p_it->end())
+      continue;
+
+    auto& retained_events = retained["phases"][p_it.key()]["events"];
+    for (auto e_it = events_it->begin(); e_it != events_it->end(); ++e_it)
+    {
+      const auto& entries = e_it.value();
+      if (entries.empty())
+        continue;
+
+      auto& retained_entries = retained_events[e_it.key()];
+      for (const auto& entry : entries)
+        retained_entries.push_back(entry);
+
+      new_entries += entries.size();
+
+      if (retained_entries.size() > MaxRetainedLogEntries)
+      {
+        retained_entries.erase(
+          retained_entries.begin(),
+          retained_entries.begin()
+          + (retained_entries.size() - MaxRetainedLogEntries));
+      }
+    }
+  }
+
+  return new_entries;
+}
+
+//==============================================================================
+std::vector<nlohmann::json> TaskManager::task_log_updates(
+  const nlohmann::json& last_seen) const
 {
+  static const auto log_update_validator =
+    _make_validator(rmf_api_msgs::schemas::task_log_update);
+
   std::vector<nlohmann::json> logs;
   for (const auto& it : _task_logs)
   {
     nlohmann::json update_msg = _task_log_update_msg;
     update_msg["data"] = it.second;
+
+    const auto seen_it = last_seen.find(it.first);
+    if (seen_it != last_seen.end()
+      && _drop_seen_log_entries(update_msg["data"], *seen_it) == 0)
+      continue;
     std::string error = "";
-    if (_validate_json(
-        update_msg, rmf_api_msgs::schemas::task_log_update, error))
+    if (!_should_validate_outgoing()
+      || _validate_json(update_msg, log_update_validator, error))
     {
       logs.push_back(update_msg);
     }
@@ -1144,11 +1404,70 @@ std::vector<nlohmann::json> TaskManager::task_log_updates() const
   return logs;
 }
 
+//==============================================================================
+std::size_t TaskManager::_drop_seen_log_entries(
+  nlohmann::json& task_logs,
+  const nlohmann::json& seen)
+{
+  std::size_t remaining = 0;
+  const auto phases_it = task_logs.find("phases");
+  if (phases_it == task_logs.end())
+    return remaining;
+
+  for (auto p_it = phases_it->begin(); p_it != phases_it->end(); ++p_it)
+  {
+    const auto events_it = p_it->find("events");
+    if (events_it == p_it->end())
+      continue;
+
+    const auto seen_phase_it = seen.find(p_it.key());
+    for (auto e_it = events_it->begin(); e_it != events_it->end(); ++e_it)
+    {
+      auto& entries = e_it.value();
+      if (seen_phase_it != seen.end())
+      {
+        const auto seen_event_it = seen_phase_it->find(e_it.key());
+        if (seen_event_it != seen_phase_it->end()
+          && seen_event_it->is_number_unsigned())
+        {
+          const auto last = seen_event_it->get<uint64_t>();
+          nlohmann::json kept = nlohmann::json::array();
+          for (auto& entry : entries)
+          {
+            if (entry.value("seq", uint64_t(0)) > last)
+              kept.push_back(std::move(entry));
+          }
+          entries = std::move(kept);
+        }
+      }
+
+      remaining += entries.size();
+    }
+  }
+
+  return remaining;
+}
+
 //==============================================================================
 nlohmann::json TaskManager::estimate_robot_task_request(
   const nlohmann::json& request,
   const nlohmann::json& initial_state,
   const std::string& request_id)
+{
+  auto inputs = _prepare_estimate(request, initial_state, request_id);
+  if (const auto* error = std::get_if<nlohmann::json>(&inputs))
+    return *error;
+
+  return _estimate(
+    std::get<EstimateInputs>(inputs), _context->node()->get_logger());
+}
+
+//==============================================================================
+std::variant<TaskManager::EstimateInputs, nlohmann::json>
+TaskManager::_prepare_estimate(
+  const nlohmann::json& request,
+  const nlohmann::json& initial_state,
+  const std::string& request_id)
 {
   auto fleet_handle = _fleet_handle.lock();
   if (!fleet_handle)
@@ -1157,7 +1476,6 @@ nlohmann::json TaskManager::estimate_robot_task_request(
       18, "Shutdown", "The fleet adapter is shutting down");
   }
   const auto& fleet = _context->group();
-  const auto& robot = _context->name();
   const auto& impl =
     agv::FleetUpdateHandle::Implementation::get(*fleet_handle);
   std::vector<std::string> errors;
@@ -1234,10 +1552,24 @@ nlohmann::json TaskManager::estimate_robot_task_request(
   const auto model = new_request->description()->make_model(
     new_request->booking()->earliest_start_time(),
     parameters);
-  const auto estimate = model->estimate_finish(
-    start_state,
+  return EstimateInputs{
+    model,
+    std::move(start_state),
     constraints,
-    *_travel_estimator);
+    _travel_estimator,
+    request_id
+  };
+}
+
+//==============================================================================
+nlohmann::json TaskManager::_estimate(
+  const EstimateInputs& inputs,
+  const rclcpp::Logger& logger)
+{
+  const auto estimate = inputs.model->estimate_finish(
+    inputs.start_state,
+    inputs.constraints,
+    *inputs.travel_estimator);
 
   rmf_task::State finish_state;
   rmf_traffic::Time deployment_time;
@@ -1245,10 +1577,10 @@ nlohmann::json TaskManager::estimate_robot_task_request(
   if (!estimate.has_value())
   {
     RCLCPP_WARN(
-      _context->node()->get_logger(),
+      logger,
       "Unable to estimate final state for direct task request [%s]. This may "
       "be due to insufficient resources to perform the task.",
-      request_id.c_str());
+      inputs.request_id.c_str());
     return _make_error_response(
       21, "Failed", "Failed Task Estimation");
   }
@@ -1411,6 +1743,7 @@ nlohmann::json TaskManager::submit_direct_request(
   {
     std::lock_guard<std::recursive_mutex> lock(_mutex);
     _direct_queue.insert(assignment);
+    _invalidate_expectations();
   }
 
   RCLCPP_INFO(
@@ -1461,31 +1794,24 @@ void TaskManager::Interruption::resume(std::vector<std::string> labels)
       token_map = std::move(token_map),
       labels = std::move(labels)](const auto&)
       {
-        const auto mgr = w.lock();
-        if (!mgr)
-          return;
-
-        const auto now = mgr->_context->now();
-        for (auto* task : {
-          &mgr->_active_task,
-          &mgr->_emergency_pullover,
-          &mgr->_waiting
-        })
-        {
-          if (*task)
-          {
-            const auto token_it = token_map.find(task->id());
-            if (token_it == token_map.end())
-              continue;
-
-            task->remove_interruption(
-              {token_it->second}, std::move(labels), now);
-          }
-        }
+        if (const auto mgr = w.lock())
+          mgr->_remove_robot_interruption(token_map, std::move(labels));
       });
   }
 }
 
+//==============================================================================
+void TaskManager::Interruption::resume_now(std::vector<std::string> labels)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (resumed)
+    return;
+
+  resumed = true;
+  if (const auto mgr = w_mgr.lock())
+    mgr->_remove_robot_interruption(token_map, std::move(labels));
+}
+
 //==============================================================================
 TaskManager::Interruption::~Interruption()
 {
@@ -1527,7 +1853,7 @@ bool TaskManager::cancel_task(
 {
   if (_active_task && _active_task.id() == task_id)
   {
-    _task_state_update_available = true;
+    _task_state_transition_pending = true;
     _active_task.cancel(std::move(labels), _context->now());
     return true;
   }
@@ -1551,7 +1877,7 @@ bool TaskManager::kill_task(
 {
   if (_active_task && _active_task.id() == task_id)
   {
-    _task_state_update_available = true;
+    _task_state_transition_pending = true;
     _active_task.kill(std::move(labels), _context->now());
     return true;
   }
@@ -1573,7 +1899,7 @@ bool TaskManager::quiet_cancel_task(
 {
   if (_active_task && _active_task.id() == task_id)
   {
-    _task_state_update_available = true;
+    _task_state_transition_pending = true;
     _active_task.quiet_cancel(std::move(labels), _context->now());
     return true;
   }
@@ -1651,6 +1977,9 @@ void TaskManager::_begin_next_task()
       id.c_str(),
       _context->requester_id().c_str());
 
+    auto trace = rmf_traffic_ros2::tracing::Span::begin("activate_task", id);
+    trace.arg("robot", _context->requester_id());
+
     _finished_waiting = false;
     _context->current_task_end_state(assignment.finish_state());
     _context->current_task_id(id);
@@ -1664,12 +1993,15 @@ void TaskManager::_begin_next_task()
         _phase_finished_cb(),
         _task_finished(id)),
       _context->now());
+    trace.end();
 
     if (is_next_task_direct)
       _direct_queue.erase(_direct_queue.begin());
     else
       _queue.erase(_queue.begin());
 
+    _invalidate_expectations();
+
     if (!_active_task)
     {
       const auto info = assignment.request()->description()->generate_info(
@@ -1702,6 +2034,8 @@ void TaskManager::_begin_next_task()
       _queue.size());
 
     _register_executed_task(_active_task.id());
+    _last_task_status = _active_task.status();
+    _task_state_transition_pending = true;
   }
   else
   {
@@ -1785,6 +2119,25 @@ void TaskManager::_process_robot_interrupts()
   _robot_interrupts.erase(remove_it, _robot_interrupts.end());
 }
 
+//==============================================================================
+void TaskManager::_remove_robot_interruption(
+  const std::unordered_map<std::string, std::string>& token_map,
+  std::vector<std::string> labels)
+{
+  const auto now = _context->now();
+  for (auto* task : {&_active_task, &_emergency_pullover, &_waiting})
+  {
+    if (*task)
+    {
+      const auto token_it = token_map.find(task->id());
+      if (token_it == token_map.end())
+        continue;
+
+      task->remove_interruption({token_it->second}, labels, now);
+    }
+  }
+}
+
 //==============================================================================
 std::function<void()> TaskManager::_robot_interruption_callback()
 {
@@ -2063,20 +2416,44 @@ void TaskManager::retreat_to_charger()
   const auto& parameters = task_planner->configuration().parameters();
   // TODO(YV): Expose the TravelEstimator in the TaskPlanner to benefit from
   // caching
-  const rmf_traffic::agv::Planner::Goal retreat_goal{charging_waypoint};
-  const auto result = _travel_estimator->estimate(
-    current_state.extract_plan_start().value(), retreat_goal);
-  if (!result.has_value())
+  const auto start = current_state.extract_plan_start().value();
+
+  // Every robot of the fleet that stands on this waypoint needs the same
+  // amount of battery to get to this charger, so the fleet remembers it
+  // instead of each robot planning the trip on every check.
+  const auto& occupancy = _context->charger_occupancy();
+  const bool shared = occupancy && !start.location().has_value();
+  std::optional<double> retreat_drain;
+  if (shared)
   {
-    RCLCPP_WARN(
-      _context->node()->get_logger(),
-      "Unable to compute estimate of journey back to charger for robot [%s]",
-      _context->name().c_str());
-    return;
+    retreat_drain = occupancy->retreat_drain(
+      parameters.planner(), start.waypoint(), charging_waypoint);
+  }
+
+  if (!retreat_drain.has_value())
+  {
+    const rmf_traffic::agv::Planner::Goal retreat_goal{charging_waypoint};
+    const auto result = _travel_estimator->estimate(start, retreat_goal);
+    if (!result.has_value())
+    {
+      RCLCPP_WARN(
+        _context->node()->get_logger(),
+        "Unable to compute estimate of journey back to charger for robot [%s]",
+        _context->name().c_str());
+      return;
+    }
+
+    retreat_drain = result->change_in_charge();
+    if (shared)
+    {
+      occupancy->record_retreat_drain(
+        parameters.planner(), start.waypoint(), charging_waypoint,
+        *retreat_drain);
+    }
   }
 
   const double battery_soc_after_retreat =
-    current_battery_soc - result->change_in_charge();
+    current_battery_soc - *retreat_drain;
 
   if ((battery_soc_after_retreat < retreat_threshold) &&
     (battery_soc_after_retreat > threshold_soc))
@@ -2112,6 +2489,7 @@ void TaskManager::retreat_to_charger()
     {
       std::lock_guard<std::recursive_mutex> lock(_mutex);
       _direct_queue.insert(assignment);
+      _invalidate_expectations();
     }
 
     RCLCPP_INFO(
@@ -2132,21 +2510,51 @@ void TaskManager::retreat_to_charger()
 }
 
 //==============================================================================
-const std::vector<std::string>& TaskManager::get_executed_tasks() const
+const std::deque<std::string>& TaskManager::get_executed_tasks() const
 {
   return _executed_task_registry;
 }
 
+//==============================================================================
+std::size_t TaskManager::max_executed_tasks() const
+{
+  return _max_executed_tasks;
+}
+
+//==============================================================================
+void TaskManager::set_max_executed_tasks(std::size_t max_tasks)
+{
+  _max_executed_tasks = std::max<std::size_t>(max_tasks, 1);
+  _drop_oldest_executed_tasks();
+}
+
+//==============================================================================
+bool TaskManager::has_executed_task(const std::string& task_id) const
+{
+  return _executed_task_ids.count(task_id) > 0;
+}
+
 //==============================================================================
 void TaskManager::_register_executed_task(const std::string& id)
 {
   // Currently the choice of storing 100 executed tasks is arbitrary.
   // TODO: Save a time stamp for when tasks are completed and cull entries after
   // a certain time window instead.
-  if (_executed_task_registry.size() >= 100)
-    _executed_task_registry.erase(_executed_task_registry.begin());
+  if (!_executed_task_ids.insert(id).second)
+    return;
 
   _executed_task_registry.push_back(id);
+  _drop_oldest_executed_tasks();
+}
+
+//==============================================================================
+void TaskManager::_drop_oldest_executed_tasks()
+{
+  while (_executed_task_registry.size() > _max_executed_tasks)
+  {
+    _executed_task_ids.erase(_executed_task_registry.front());
+    _executed_task_registry.pop_front();
+  }
 }
 
 //==============================================================================
@@ -2201,23 +2609,13 @@ void TaskManager::_schema_loader(
 
 //==============================================================================
 void TaskManager::_validate_and_publish_json(
-  const nlohmann::json& msg,
+  nlohmann::json msg,
   const nlohmann::json_schema::json_validator& validator) const
 {
-  std::string error = "";
-  if (!_validate_json(msg, validator, error))
-  {
-    RCLCPP_ERROR(
-      _context->node()->get_logger(),
-      "Failed to validate message [%s]: [%s]",
-      msg.dump().c_str(),
-      error.c_str());
-    return;
-  }
-
+  std::shared_ptr<rmf_websocket::BroadcastClient> client;
   if (_broadcast_client.has_value())
   {
-    const auto client = _broadcast_client->lock();
+    client = _broadcast_client->lock();
     if (!client)
     {
       RCLCPP_ERROR(
@@ -2226,21 +2624,53 @@ void TaskManager::_validate_and_publish_json(
         _context->name().c_str());
       return;
     }
-    client->publish(msg);
   }
 
-  if (msg["type"] == "task_state_update")
-  {
-    TaskStateUpdateMsg update_msg;
-    update_msg.data = msg.dump();
-    _task_state_update_pub->publish(update_msg);
-  }
-  else if (msg["type"] == "task_log_update")
-  {
-    TaskLogUpdateMsg update_msg;
-    update_msg.data = msg.dump();
-    _task_log_update_pub->publish(update_msg);
-  }
+  auto publish =
+    [
+      msg = std::move(msg),
+      validator = &validator,
+      validate = _should_validate_outgoing(),
+      client = std::move(client),
+      state_pub = _task_state_update_pub,
+      log_pub = _task_log_update_pub,
+      logger = _context->node()->get_logger()
+    ]()
+    {
+      std::string error = "";
+      if (validate && !_validate_json(msg, *validator, error))
+      {
+        RCLCPP_ERROR(
+          logger,
+          "Failed to validate message [%s]: [%s]",
+          msg.dump().c_str(),
+          error.c_str());
+        return;
+      }
+
+      if (client)
+        client->publish(msg);
+
+      if (msg["type"] == "task_state_update")
+      {
+        TaskStateUpdateMsg update_msg;
+        update_msg.data = msg.dump();
+        state_pub->publish(update_msg);
+      }
+      else if (msg["type"] == "task_log_update")
+      {
+        TaskLogUpdateMsg update_msg;
+        update_msg.data = msg.dump();
+        log_pub->publish(update_msg);
+      }
+    };
+
+  // Validating and serializing the message happens on the outbox thread when
+  // the fleet has one
+  if (const auto& outbox = _context->json_outbox())
+    outbox->push(std::move(publish));
+  else
+    publish();
 }
 
 //==============================================================================
@@ -2250,7 +2680,8 @@ void TaskManager::_validate_and_publish_api_response(
   const std::string& request_id)
 {
   std::string error;
-  if (!_validate_json(response, validator, error))
+  if (_should_validate_outgoing()
+    && !_validate_json(response, validator, error))
   {
     RCLCPP_ERROR(
       _context->node()->get_logger(),
@@ -2280,14 +2711,31 @@ void TaskManager::_consider_publishing_updates()
   const auto time_elapsed = now - _last_update_time;
   // TODO(MXG): Make max elapsed time configurable
   const auto max_time_elapsed = std::chrono::seconds(1);
-  if (_task_state_update_available || time_elapsed > max_time_elapsed)
+  bool publish = _task_state_transition_pending
+    || time_elapsed > max_time_elapsed;
+
+  if (!publish && _task_state_update_available)
+  {
+    publish = !_task_state_publish_interval.has_value()
+      || time_elapsed >= *_task_state_publish_interval;
+  }
+
+  if (publish)
   {
     _task_state_update_available = false;
+    _task_state_transition_pending = false;
     _last_update_time = now;
     _publish_task_state();
   }
 }
 
+//==============================================================================
+void TaskManager::set_task_state_publish_interval(
+  std::optional<rmf_traffic::Duration> interval)
+{
+  _task_state_publish_interval = interval;
+}
+
 //==============================================================================
 void TaskManager::_publish_task_state()
 {
@@ -2337,12 +2785,12 @@ rmf_task::State TaskManager::_publish_pending_task(
   pending_json["status"] = "queued";
 
   auto task_state_update = _task_state_update_json;
-  task_state_update["data"] = pending_json;
+  task_state_update["data"] = std::move(pending_json);
 
   static const auto validator =
     _make_validator(rmf_api_msgs::schemas::task_state_update);
 
-  _validate_and_publish_json(task_state_update, validator);
+  _validate_and_publish_json(std::move(task_state_update), validator);
 
   _pending_task_info[pending.request()] = cache;
   return pending.finish_state();
@@ -2404,12 +2852,12 @@ void TaskManager::_publish_canceled_pending_task(
   pending_json["cancellation"] = std::move(cancellation);
 
   auto task_state_update = _task_state_update_json;
-  task_state_update["data"] = pending_json;
+  task_state_update["data"] = std::move(pending_json);
 
   static const auto validator =
     _make_validator(rmf_api_msgs::schemas::task_state_update);
 
-  _validate_and_publish_json(task_state_update, validator);
+  _validate_and_publish_json(std::move(task_state_update), validator);
 }
 
 //==============================================================================
@@ -2427,6 +2875,7 @@ auto TaskManager::_drain_dispatched_assignments() -> std::vector<Assignment>
     assignments.push_back(a);
   }
   _queue.clear();
+  _invalidate_expectations();
 
   return assignments;
 }
@@ -2446,6 +2895,7 @@ auto TaskManager::_drain_direct_assignments() -> std::vector<Assignment>
     assignments.push_back(a.assignment);
   }
   _direct_queue.clear();
+  _invalidate_expectations();
 
   return assignments;
 }
@@ -2456,19 +2906,19 @@ bool TaskManager::_cancel_task_from_dispatch_queue(
   const std::vector<std::string>& labels)
 {
   std::lock_guard<std::recursive_mutex> lock(_mutex);
-  for (auto it = _queue.begin(); it != _queue.end(); ++it)
-  {
-    if (it->request()->booking()->id() == task_id)
-    {
-      _publish_canceled_pending_task(*it, labels);
-      _queue.erase(it);
+  const auto& index = _queue_index();
+  const auto found = index.dispatched.find(task_id);
+  if (found == index.dispatched.end())
+    return false;
 
-      // Count this as an executed task so we don't lose track of its existence
-      _register_executed_task(task_id);
-      return true;
-    }
-  }
-  return false;
+  const auto it = _queue.begin() + found->second;
+  _publish_canceled_pending_task(*it, labels);
+  _queue.erase(it);
+  _invalidate_expectations();
+
+  // Count this as an executed task so we don't lose track of its existence
+  _register_executed_task(task_id);
+  return true;
 }
 
 //==============================================================================
@@ -2476,23 +2926,63 @@ bool TaskManager::_cancel_task_from_direct_queue(
   const std::string& task_id,
   const std::vector<std::string>& labels)
 {
+  std::lock_guard<std::recursive_mutex> lock(_mutex);
+  const auto& index = _queue_index();
+  const auto found = index.direct.find(task_id);
+  if (found == index.direct.end())
+    return false;
+
+  const auto it = found->second;
+  _publish_canceled_pending_task(it->assignment, labels);
+  _direct_queue.erase(it);
+  _invalidate_expectations();
+  return true;
+}
+
+//==============================================================================
+auto TaskManager::_queue_index() const -> const QueueIndex&
+{
+  if (_queue_index_cache.has_value())
+    return *_queue_index_cache;
+
+  auto& index = _queue_index_cache.emplace();
+  index.dispatched.reserve(_queue.size());
+  for (std::size_t i = 0; i < _queue.size(); ++i)
+    index.dispatched.insert({_queue[i].request()->booking()->id(), i});
+
+  index.direct.reserve(_direct_queue.size());
   for (auto it = _direct_queue.begin(); it != _direct_queue.end(); ++it)
-  {
-    if (it->assignment.request()->booking()->id() == task_id)
-    {
-      _publish_canceled_pending_task(it->assignment, labels);
-      _direct_queue.erase(it);
-      return true;
-    }
-  }
-  return false;
+    index.direct.insert({it->assignment.request()->booking()->id(), it});
+
+  return index;
+}
+
+//==============================================================================
+bool TaskManager::_should_validate_outgoing() const
+{
+  const auto& validation = _context->outgoing_validation();
+  return !validation || validation->sample();
+}
+
+//==============================================================================
+bool TaskManager::_broadcast_saturated() const
+{
+  const auto& outbox = _context->json_outbox();
+  if (outbox && outbox->saturated())
+    return true;
+
+  if (!_broadcast_client.has_value())
+    return false;
+
+  const auto client = _broadcast_client->lock();
+  return client && client->saturated();
 }
 
 //==============================================================================
 bool TaskManager::_validate_json(
   const nlohmann::json& json,
   const nlohmann::json_schema::json_validator& validator,
-  std::string& error) const
+  std::string& error)
 {
   try
   {
@@ -2588,29 +3078,14 @@ void TaskManager::_send_simple_error_if_queued(
   const std::string& request_id,
   const std::string& type)
 {
-  // TODO(YV): We could cache the task_ids of direct and dispatched tasks in
-  // unordered_sets and perform a lookup to see which queue to iterate.
   std::lock_guard<std::recursive_mutex> lock(_mutex);
-  for (const auto& a : _queue)
-  {
-    if (a.request()->booking()->id() == task_id)
-    {
-      return _send_simple_error_response(
-        request_id, 6, "Invalid Circumstances",
-        type + " a task that is queued (not yet active) "
-        "is not currently supported");
-    }
-  }
-
-  for (const auto& a : _direct_queue)
+  const auto& index = _queue_index();
+  if (index.dispatched.count(task_id) > 0 || index.direct.count(task_id) > 0)
   {
-    if (a.assignment.request()->booking()->id() == task_id)
-    {
-      return _send_simple_error_response(
-        request_id, 6, "Invalid Circumstances",
-        type + " a task that is queued (not yet active) "
-        "is not currently supported");
-    }
+    return _send_simple_error_response(
+      request_id, 6, "Invalid Circumstances",
+      type + " a task that is queued (not yet active) "
+      "is not currently supported");
   }
 }
 
@@ -2644,6 +3119,18 @@ TaskManager::_update_cb()
         return;
 
       self->_task_state_update_available = true;
+
+      // A change in the overall status of the task is a transition that
+      // should not wait for the publish interval.
+      if (self->_active_task)
+      {
+        const auto status = self->_active_task.status();
+        if (status != self->_last_task_status)
+        {
+          self->_last_task_status = status;
+          self->_task_state_transition_pending = true;
+        }
+      }
       // TODO(MXG): Use this callback to make the state updates more efficient
     };
 }
@@ -2672,7 +3159,7 @@ TaskManager::_phase_finished_cb()
       if (!self)
         return;
 
-      self->_task_state_update_available = true;
+      self->_task_state_transition_pending = true;
       // TODO(MXG): Use this callback to make the state updates more efficient
     };
 }
@@ -2688,8 +3175,13 @@ std::function<void()> TaskManager::_task_finished(std::string id)
 
       // Publish the final state of the task before destructing it
       self->_publish_task_state();
+      self->_task_logs.erase(id);
       self->_active_task = ActiveTask();
       self->_context->current_task_id(std::nullopt);
+      {
+        std::lock_guard<std::recursive_mutex> lock(self->_mutex);
+        self->_invalidate_expectations();
+      }
 
       self->_context->worker().schedule(
         [w = self->weak_from_this()](const auto&)
@@ -2790,12 +3282,106 @@ void TaskManager::_handle_estimate_robot_task_request(
   const nlohmann::json& state = (request_json.find("state") == request_json.end()) ?
     nlohmann::json({}) : request_json["state"];
 
-  const auto response = estimate_robot_task_request(
-    task_request,
-    state,
-    request_id);
+  const auto key = task_request.dump() + state.dump();
+  const auto state_version = _estimate_state_version();
+  const auto cached = _estimate_cache.find(key);
+  if (cached != _estimate_cache.end()
+    && cached->second.state_version == state_version
+    && std::chrono::steady_clock::now() - cached->second.time
+    < EstimateCacheLifetime)
+  {
+    return _validate_and_publish_api_response(
+      cached->second.response, response_validator, request_id);
+  }
 
-  _validate_and_publish_api_response(response, response_validator, request_id);
+  const auto in_flight = _estimates_in_flight.find(key);
+  if (in_flight != _estimates_in_flight.end())
+  {
+    in_flight->second.request_ids.push_back(request_id);
+    return;
+  }
+
+  auto inputs = _prepare_estimate(task_request, state, request_id);
+  if (const auto* error = std::get_if<nlohmann::json>(&inputs))
+  {
+    return _validate_and_publish_api_response(
+      *error, response_validator, request_id);
+  }
+
+  // Estimating the task can take a while, so it is done on the job threads
+  // to keep this robot's worker free for handling its tasks.
+  auto job = std::make_shared<EstimateJob>(
+    std::get<EstimateInputs>(std::move(inputs)),
+    _context->node()->get_logger());
+
+  auto& estimate = _estimates_in_flight[key];
+  estimate.request_ids.push_back(request_id);
+  estimate.subscription = rmf_rxcpp::make_job<nlohmann::json>(job)
+    .observe_on(rxcpp::identity_same_worker(_context->worker()))
+    .subscribe(
+    [w = weak_from_this(), key, state_version](const nlohmann::json& response)
+    {
+      if (const auto self = w.lock())
+        self->_finish_background_estimate(key, state_version, response);
+    });
+}
+
+//==============================================================================
+void TaskManager::_finish_background_estimate(
+  const std::string& key,
+  std::size_t state_version,
+  const nlohmann::json& response)
+{
+  static auto response_validator =
+    _make_validator(rmf_api_msgs::schemas::estimate_robot_task_response);
+
+  const auto it = _estimates_in_flight.find(key);
+  if (it == _estimates_in_flight.end())
+    return;
+
+  auto request_ids = std::move(it->second.request_ids);
+
+  // Release the subscription after it has finished calling us
+  _context->worker().schedule(
+    [finished = std::make_shared<rmf_rxcpp::subscription_guard>(
+      std::move(it->second.subscription))](const auto&)
+    {
+      // Do nothing
+    });
+  _estimates_in_flight.erase(it);
+
+  if (response.value("success", false))
+  {
+    const auto now = std::chrono::steady_clock::now();
+    if (_estimate_cache.size() >= MaxCachedEstimates)
+    {
+      for (auto c = _estimate_cache.begin(); c != _estimate_cache.end(); )
+      {
+        if (now - c->second.time >= EstimateCacheLifetime)
+          c = _estimate_cache.erase(c);
+        else
+          ++c;
+      }
+
+      if (_estimate_cache.size() >= MaxCachedEstimates)
+        _estimate_cache.clear();
+    }
+
+    _estimate_cache[key] = CachedEstimate{state_version, now, response};
+  }
+
+  for (const auto& request_id : request_ids)
+  {
+    _validate_and_publish_api_response(
+      response, response_validator, request_id);
+  }
+}
+
+//==============================================================================
+std::size_t TaskManager::_estimate_state_version() const
+{
+  std::lock_guard<std::recursive_mutex> lock(_mutex);
+  return _expectations_version;
 }
 
 //==============================================================================
@@ -3008,7 +3594,7 @@ void TaskManager::_handle_interrupt_request(
 
   if (_active_task && _active_task.id() == task_id)
   {
-    _task_state_update_available = true;
+    _task_state_transition_pending = true;
     return _send_token_success_response(
       _active_task.add_interruption(
         get_labels(request_json), _context->now(), []() {}),
@@ -3033,7 +3619,7 @@ void TaskManager::_handle_resume_request(
 
   if (_active_task && _active_task.id() == task_id)
   {
-    _task_state_update_available = true;
+    _task_state_transition_pending = true;
     auto unknown_tokens = _active_task.remove_interruption(
       request_json["for_tokens"].get<std::vector<std::string>>(),
       get_labels(request_json),
@@ -3073,7 +3659,7 @@ void TaskManager::_handle_rewind_request(
 
   if (_active_task && _active_task.id() == task_id)
   {
-    _task_state_update_available = true;
+    _task_state_transition_pending = true;
     _active_task.rewind(request_json["phase_id"].get<uint64_t>());
     return _send_simple_success_response(request_id);
   }
@@ -3096,7 +3682,7 @@ void TaskManager::_handle_skip_phase_request(
 
   if (_active_task && _active_task.id() == task_id)
   {
-    _task_state_update_available = true;
+    _task_state_transition_pending = true;
     return _send_token_success_response(
       _active_task.skip(
         request_json["phase_id"].get<uint64_t>(),
@@ -3123,7 +3709,7 @@ void TaskManager::_handle_undo_skip_phase_request(
 
   if (_active_task && _active_task.id() == task_id)
   {
-    _task_state_update_available = true;
+    _task_state_transition_pending = true;
     auto unknown_tokens = _active_task.remove_skips(
       request_json["for_tokens"].get<std::vector<std::string>>(),
       get_labels(request_json),
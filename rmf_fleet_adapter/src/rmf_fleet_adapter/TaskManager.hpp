@@ -19,6 +19,7 @@
 #define SRC__RMF_FLEET_ADAPTER__TASKMANAGER_HPP
 
 #include "LegacyTask.hpp"
+#include "TaskQueueBackup.hpp"
 #include "agv/RobotContext.hpp"
 #include <rmf_websocket/BroadcastClient.hpp>
 
@@ -37,8 +38,13 @@
 #include <nlohmann/json.hpp>
 #include <nlohmann/json-schema.hpp>
 
+#include <chrono>
+#include <deque>
 #include <mutex>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
 
 namespace rmf_fleet_adapter {
 
@@ -142,6 +148,16 @@ public:
     std::function<void()> on_success,
     std::function<void(std::vector<std::string>)> on_failure);
 
+  /// Get the IDs of the tasks that this robot still has to perform, for
+  /// backing up its queues. The active task is put at the front of the
+  /// dispatched tasks so that it gets started over after a restore.
+  TaskQueueBackup::TaskIds queued_task_ids() const;
+
+  /// Add requests that were restored from a backup to the end of the queue of
+  /// dispatched tasks, estimating each of them from the finish state of the
+  /// one before it.
+  void restore_queue(const std::vector<rmf_task::ConstRequestPtr>& requests);
+
   std::optional<std::string> current_task_id() const;
 
   const std::vector<Assignment>& get_queue() const;
@@ -166,14 +182,46 @@ public:
   void configure_retreat_to_charger(
     std::optional<rmf_traffic::Duration> duration);
 
+  /// Set the shortest time between two publications of the active task state
+  /// when only the progress of the task has changed. Updates in between are
+  /// coalesced into the next publication. State transitions, such as the task
+  /// starting, finishing, changing status, or being cancelled, killed,
+  /// interrupted, or skipped, are still published on the next update tick.
+  /// Pass in std::nullopt to publish every change (this is the default).
+  void set_task_state_publish_interval(
+    std::optional<rmf_traffic::Duration> interval);
+
   /// Get the list of task ids for tasks that have started execution.
-  /// The list will contain upto 100 latest task ids only.
-  const std::vector<std::string>& get_executed_tasks() const;
+  /// The list will contain up to max_executed_tasks() latest task ids only.
+  const std::deque<std::string>& get_executed_tasks() const;
+
+  /// Get the most task ids that get_executed_tasks() keeps.
+  std::size_t max_executed_tasks() const;
+
+  /// Set the most task ids that get_executed_tasks() keeps, dropping the
+  /// oldest ones if there are already more. Tasks that were dropped are no
+  /// longer recognized as started when assignments are checked, so this
+  /// should stay well above the number of tasks in a queue. The default is
+  /// 100, and it is never less than 1.
+  void set_max_executed_tasks(std::size_t max_tasks);
+
+  /// Check whether a task with this ID has started execution, among the same
+  /// task ids that get_executed_tasks() keeps.
+  bool has_executed_task(const std::string& task_id) const;
 
   RobotModeMsg robot_mode() const;
 
-  /// Get a vector of task logs that are validated against the schema
-  std::vector<nlohmann::json> task_log_updates() const;
+  /// Get a vector of task logs that are validated against the schema. Each
+  /// regular task log update only carries the entries that are new since the
+  /// previous update, so these are used to bring a newly connected client up
+  /// to date with the logs of the tasks that are still running.
+  ///
+  /// \param[in] last_seen
+  ///   The highest log sequence number that the client already has for each
+  ///   event, as {task_id: {phase_id: {event_id: seq}}}. Entries up to those
+  ///   numbers are left out, along with tasks that have nothing new.
+  std::vector<nlohmann::json> task_log_updates(
+    const nlohmann::json& last_seen = nlohmann::json::object()) const;
 
   /// Submit a direct task request to this manager
   ///
@@ -213,6 +261,10 @@ public:
   public:
     void resume(std::vector<std::string> labels);
 
+    /// Resume right away instead of scheduling the resumption on the worker.
+    /// This must only be called from the worker of the task manager.
+    void resume_now(std::vector<std::string> labels);
+
     ~Interruption();
 
     std::mutex mutex;
@@ -305,6 +357,9 @@ private:
 
     bool is_finished() const;
 
+    /// The overall status of the task
+    rmf_task::Event::Status status() const;
+
     // Any unknown tokens that were included will be returned
     std::vector<std::string> remove_interruption(
       std::vector<std::string> for_tokens,
@@ -339,6 +394,7 @@ private:
     rmf_task::Task::ActivePtr _task;
     rmf_traffic::Time _start_time;
     nlohmann::json _state_msg;
+    bool _state_msg_initialized = false;
 
     std::unordered_map<std::string, nlohmann::json> _active_interruptions;
     std::unordered_map<std::string, nlohmann::json> _removed_interruptions;
@@ -410,10 +466,23 @@ private:
   // manager so that modifications of shared data only happen on designated
   // rxcpp worker
   mutable std::recursive_mutex _mutex;
+
+  // The fleet reads the expected finish state and dispatched requests of
+  // every robot for every bid, so they are kept until the queues or the
+  // active task change. An idle robot's finish state follows its live
+  // location and battery, so that is never cached.
+  mutable std::optional<State> _expected_finish_state_cache;
+  mutable std::optional<std::vector<rmf_task::ConstRequestPtr>>
+  _dispatched_requests_cache;
+  std::size_t _expectations_version = 0;
+
   rclcpp::TimerBase::SharedPtr _task_timer;
   rclcpp::TimerBase::SharedPtr _retreat_timer;
   rclcpp::TimerBase::SharedPtr _update_timer;
   bool _task_state_update_available = true;
+  bool _task_state_transition_pending = false;
+  std::optional<rmf_traffic::Duration> _task_state_publish_interval;
+  std::optional<rmf_task::Event::Status> _last_task_status;
   std::chrono::steady_clock::time_point _last_update_time;
 
   using TaskStateUpdateMsg = std_msgs::msg::String;
@@ -424,8 +493,19 @@ private:
   rclcpp::Publisher<TaskLogUpdateMsg>::SharedPtr _task_log_update_pub = nullptr;
 
   // Container to keep track of tasks that have been started by this TaskManager
-  // Use the _register_executed_task() to populate this container.
-  std::vector<std::string> _executed_task_registry;
+  // Use the _register_executed_task() to populate this container. The oldest
+  // entries are dropped once there are more than _max_executed_tasks.
+  std::deque<std::string> _executed_task_registry;
+  std::unordered_set<std::string> _executed_task_ids;
+  std::size_t _max_executed_tasks = 100;
+
+  // Where each queued task can be found, by task ID
+  struct QueueIndex
+  {
+    std::unordered_map<std::string, std::size_t> dispatched;
+    std::unordered_map<std::string, DirectQueue::const_iterator> direct;
+  };
+  mutable std::optional<QueueIndex> _queue_index_cache;
 
   // TravelEstimator for caching travel estimates for automatic charging
   // retreat. TODO(YV): Expose the TaskPlanner's TravelEstimator.
@@ -437,6 +517,44 @@ private:
 
   rmf_rxcpp::subscription_guard _task_request_api_sub;
 
+  /// Everything needed to estimate a task once the request has been converted
+  /// on the worker. This can be used on any thread.
+  struct EstimateInputs
+  {
+    rmf_task::Task::ConstModelPtr model;
+    rmf_task::State start_state;
+    rmf_task::Constraints constraints;
+    std::shared_ptr<rmf_task::TravelEstimator> travel_estimator;
+    std::string request_id;
+  };
+
+  /// Calculates a prepared estimate on the job threads
+  class EstimateJob;
+
+  // Estimate requests that are being calculated on the job threads, keyed by
+  // their request and initial state. Identical requests that arrive in the
+  // meantime are answered with the same result.
+  struct EstimateInFlight
+  {
+    std::vector<std::string> request_ids;
+    rmf_rxcpp::subscription_guard subscription;
+  };
+  std::unordered_map<std::string, EstimateInFlight> _estimates_in_flight;
+
+  // Recent estimate responses. They are reused until the robot's task state
+  // changes, or until they are older than EstimateCacheLifetime since the
+  // robot may have moved or drained its battery in the meantime.
+  struct CachedEstimate
+  {
+    std::size_t state_version;
+    std::chrono::steady_clock::time_point time;
+    nlohmann::json response;
+  };
+  std::unordered_map<std::string, CachedEstimate> _estimate_cache;
+  static constexpr std::size_t MaxCachedEstimates = 100;
+  static constexpr std::chrono::seconds EstimateCacheLifetime =
+    std::chrono::seconds(1);
+
   // Constant jsons with validated schemas for internal use
   // TODO(YV): Replace these with codegen tools
   const nlohmann::json _task_log_update_msg =
@@ -454,8 +572,20 @@ private:
 
   rmf_task::Log::Reader _log_reader;
 
-  // Map task_id to task_log.json for all tasks managed by this TaskManager
+  // Map task_id to task_log.json for the tasks that are still running. This
+  // keeps up to MaxRetainedLogEntries of the most recent entries per event.
   std::unordered_map<std::string, nlohmann::json> _task_logs = {};
+  static constexpr std::size_t MaxRetainedLogEntries = 100;
+
+  /// Add the new entries of a task log to _task_logs so they can be sent to
+  /// clients that connect later. Returns the number of new entries.
+  std::size_t _retain_task_log(const nlohmann::json& task_logs);
+
+  /// Remove the entries of a task log that a client has already seen, given
+  /// as {phase_id: {event_id: seq}}. Returns the number of entries left.
+  static std::size_t _drop_seen_log_entries(
+    nlohmann::json& task_logs,
+    const nlohmann::json& seen);
 
   /// Begin performing an emergency pullover. This should only be called when an
   /// emergency is active.
@@ -477,11 +607,23 @@ private:
 
   void _process_robot_interrupts();
 
+  void _remove_robot_interruption(
+    const std::unordered_map<std::string, std::string>& token_map,
+    std::vector<std::string> labels);
+
   std::function<void()> _robot_interruption_callback();
 
   /// Begin responsively waiting for the next task
   void _begin_waiting();
 
+  /// Hand drained assignments back to the fleet for reassignment. This must
+  /// be called on the fleet's worker.
+  void _reassign_on_fleet(
+    const std::shared_ptr<agv::FleetUpdateHandle>& fleet,
+    std::vector<Assignment> assignments,
+    std::function<void()> on_success,
+    std::function<void(std::vector<std::string>)> on_failure);
+
   /// Make the callback for resuming
   std::function<void()> _make_resume_from_emergency();
 
@@ -493,6 +635,39 @@ private:
   /// Get the current state of the robot
   rmf_task::State _get_state() const;
 
+  /// Convert an estimate request into the inputs for estimating it. If the
+  /// request cannot be estimated, this returns the error response instead.
+  std::variant<EstimateInputs, nlohmann::json> _prepare_estimate(
+    const nlohmann::json& task_request,
+    const nlohmann::json& initial_state,
+    const std::string& request_id);
+
+  /// Estimate a task that has been prepared by _prepare_estimate. This does
+  /// not touch the task manager, so it can run on the job threads.
+  static nlohmann::json _estimate(
+    const EstimateInputs& inputs,
+    const rclcpp::Logger& logger);
+
+  /// A value that changes whenever the robot's queue or active task changes.
+  /// Cached estimates are only reused while this stays the same.
+  std::size_t _estimate_state_version() const;
+
+  /// Drop the cached expected finish state, dispatched requests and queue
+  /// index. This must be called with _mutex locked whenever the queues or the
+  /// active task change.
+  void _invalidate_expectations();
+
+  /// Get the index of the queued tasks, building it if the queues changed
+  /// since it was last used. This must be called with _mutex locked.
+  const QueueIndex& _queue_index() const;
+
+  /// Respond to every request that was waiting on an estimate that was
+  /// calculated in the background, and cache the response.
+  void _finish_background_estimate(
+    const std::string& key,
+    std::size_t state_version,
+    const nlohmann::json& response);
+
   /// Check whether publishing should happen
   void _consider_publishing_updates();
 
@@ -534,12 +709,20 @@ private:
   void _schema_loader(
     const nlohmann::json_uri& id, nlohmann::json& value) const;
 
+  /// Returns true if the next outgoing message should be validated.
+  bool _should_validate_outgoing() const;
+
+  /// Returns true if the BroadcastClient is not keeping up with the server or
+  /// the JSON outbox is not keeping up with the fleet, in which case new log
+  /// entries are left for a later update.
+  bool _broadcast_saturated() const;
+
   /// Returns true if json is valid.
   // TODO: Move this into a utils?
-  bool _validate_json(
+  static bool _validate_json(
     const nlohmann::json& json,
     const nlohmann::json_schema::json_validator& validator,
-    std::string& error) const;
+    std::string& error);
 
   /// If the request message is valid this will return true. If it is not valid,
   /// this will publish an error message for this request and return false. The
@@ -579,9 +762,10 @@ private:
     std::string detail);
 
   /// Validate and publish a json. This can be used for task
-  /// state and log updates
+  /// state and log updates. The validator must outlive the TaskManager, since
+  /// the message may be validated later on the fleet's JSON outbox.
   void _validate_and_publish_json(
-    const nlohmann::json& msg,
+    nlohmann::json msg,
     const nlohmann::json_schema::json_validator& validator) const;
 
   /// Validate and publish a response message over the ROS2 API response topic
@@ -607,6 +791,8 @@ private:
   /// size of the registry is 100.
   void _register_executed_task(const std::string& id);
 
+  void _drop_oldest_executed_tasks();
+
   void _populate_task_summary(
     std::shared_ptr<LegacyTask> task,
     uint32_t task_summary_state,
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "TaskQueueBackup.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace rmf_fleet_adapter {
+
+namespace {
+//==============================================================================
+const std::string FileFormat = "rmf_task_queue_backup";
+const uint64_t FileVersion = 1;
+
+//==============================================================================
+std::vector<TaskQueueBackup::Task> read_tasks(const nlohmann::json& tasks)
+{
+  std::vector<TaskQueueBackup::Task> output;
+  if (!tasks.is_array())
+    return output;
+
+  output.reserve(tasks.size());
+  for (const auto& task : tasks)
+  {
+    const auto id_it = task.find("id");
+    const auto request_it = task.find("request");
+    if (id_it == task.end() || !id_it->is_string()
+      || request_it == task.end() || !request_it->is_object())
+    {
+      continue;
+    }
+
+    output.push_back({id_it->get<std::string>(), *request_it});
+  }
+
+  return output;
+}
+
+//==============================================================================
+nlohmann::json write_tasks(const std::vector<TaskQueueBackup::Task>& tasks)
+{
+  auto output = nlohmann::json::array();
+  for (const auto& task : tasks)
+    output.push_back({{"id", task.id}, {"request", task.request}});
+
+  return output;
+}
+
+} // anonymous namespace
+
+//==============================================================================
+std::shared_ptr<TaskQueueBackup> TaskQueueBackup::make(
+  std::string filename,
+  const Clock::duration unqueued_lifetime)
+{
+  std::shared_ptr<TaskQueueBackup> backup(
+    new TaskQueueBackup(std::move(filename), unqueued_lifetime));
+
+  backup->_load();
+  return backup;
+}
+
+//==============================================================================
+void TaskQueueBackup::record(
+  const std::string& task_id,
+  const nlohmann::json& request)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _requests[task_id] = Recorded{request, Clock::now()};
+}
+
+//==============================================================================
+auto TaskQueueBackup::take_loaded(const std::string& robot)
+-> std::optional<Queues>
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto it = _untaken.find(robot);
+  if (it == _untaken.end())
+    return std::nullopt;
+
+  auto queues = std::move(it->second);
+  _untaken.erase(it);
+  return queues;
+}
+
+//==============================================================================
+std::size_t TaskQueueBackup::loaded() const
+{
+  return _loaded;
+}
+
+//==============================================================================
+bool TaskQueueBackup::save(
+  const std::unordered_map<std::string, TaskIds>& robots)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto now = Clock::now();
+
+  const auto collect = [&](const std::vector<std::string>& ids)
+    {
+      std::vector<Task> tasks;
+      tasks.reserve(ids.size());
+      for (const auto& id : ids)
+      {
+        const auto it = _requests.find(id);
+        if (it == _requests.end())
+          continue;
+
+        it->second.last_used = now;
+        tasks.push_back({id, it->second.request});
+      }
+
+      return tasks;
+    };
+
+  auto robots_json = nlohmann::json::object();
+  for (const auto& [name, ids] : robots)
+  {
+    if (_untaken.count(name) > 0)
+      continue;
+
+    robots_json[name] = {
+      {"dispatched", write_tasks(collect(ids.dispatched))},
+      {"direct", write_tasks(collect(ids.direct))}
+    };
+  }
+
+  for (const auto& [name, queues] : _untaken)
+  {
+    robots_json[name] = {
+      {"dispatched", write_tasks(queues.dispatched)},
+      {"direct", write_tasks(queues.direct)}
+    };
+  }
+
+  // Requests of tasks that are in no queue are kept for a while because the
+  // task might still be awarded to this fleet.
+  for (auto it = _requests.begin(); it != _requests.end(); )
+  {
+    if (now - it->second.last_used > _unqueued_lifetime)
+      it = _requests.erase(it);
+    else
+      ++it;
+  }
+
+  nlohmann::json backup;
+  backup["format"] = FileFormat;
+  backup["version"] = FileVersion;
+  backup["robots"] = std::move(robots_json);
+  auto contents = backup.dump();
+  if (contents == _last_saved)
+    return true;
+
+  // Write to a temporary file first so that a crash while saving cannot leave
+  // behind a truncated backup.
+  const std::string temp = _filename + ".tmp";
+  {
+    std::ofstream file(temp, std::ios::trunc);
+    if (!file)
+      return false;
+
+    file << contents;
+    if (!file)
+      return false;
+  }
+
+  if (std::rename(temp.c_str(), _filename.c_str()) != 0)
+    return false;
+
+  _last_saved = std::move(contents);
+  return true;
+}
+
+//==============================================================================
+TaskQueueBackup::TaskQueueBackup(
+  std::string filename,
+  const Clock::duration unqueued_lifetime)
+: _filename(std::move(filename)),
+  _unqueued_lifetime(unqueued_lifetime)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void TaskQueueBackup::_load()
+{
+  std::ifstream file(_filename);
+  if (!file)
+    return;
+
+  std::stringstream ss;
+  ss << file.rdbuf();
+  const auto backup = nlohmann::json::parse(ss.str(), nullptr, false);
+  if (!backup.is_object())
+    return;
+
+  if (backup.value("format", std::string()) != FileFormat
+    || backup.value("version", uint64_t(0)) != FileVersion)
+  {
+    return;
+  }
+
+  const auto robots_it = backup.find("robots");
+  if (robots_it == backup.end() || !robots_it->is_object())
+    return;
+
+  for (const auto& [name, queues_json] : robots_it->items())
+  {
+    if (!queues_json.is_object())
+      continue;
+
+    Queues queues;
+    if (const auto it = queues_json.find("dispatched"); it != queues_json.end())
+      queues.dispatched = read_tasks(*it);
+
+    if (const auto it = queues_json.find("direct"); it != queues_json.end())
+      queues.direct = read_tasks(*it);
+
+    _loaded += queues.dispatched.size() + queues.direct.size();
+    _untaken[name] = std::move(queues);
+  }
+}
+
+} // namespace rmf_fleet_adapter
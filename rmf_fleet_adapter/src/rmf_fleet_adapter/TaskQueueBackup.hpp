@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__TASKQUEUEBACKUP_HPP
+#define SRC__RMF_FLEET_ADAPTER__TASKQUEUEBACKUP_HPP
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// Keeps a copy on disk of the tasks that each robot of a fleet still has to
+/// perform, so that the queues can be restored after the fleet adapter
+/// restarts instead of every task being dispatched and bid on again.
+///
+/// Tasks cannot be serialized once they have been deserialized into requests,
+/// so the original JSON request of each task gets recorded when the request
+/// is converted, and the backup stores those JSON requests in the order that
+/// each robot will perform them.
+class TaskQueueBackup
+{
+public:
+
+  using Clock = std::chrono::steady_clock;
+
+  /// The IDs of the tasks of one robot, in the order they will be performed
+  struct TaskIds
+  {
+    std::vector<std::string> dispatched;
+    std::vector<std::string> direct;
+  };
+
+  /// A task that was restored from the file
+  struct Task
+  {
+    std::string id;
+    nlohmann::json request;
+  };
+
+  /// The tasks of one robot that were restored from the file
+  struct Queues
+  {
+    std::vector<Task> dispatched;
+    std::vector<Task> direct;
+  };
+
+  /// Create a backup that will be saved to the given file. If the file
+  /// already exists, the queues in it will be loaded.
+  ///
+  /// \param[in] filename
+  ///   The file to load from and save to.
+  ///
+  /// \param[in] unqueued_lifetime
+  ///   How long to keep the request of a task that is not in any queue, e.g.
+  ///   because it is still being bid on.
+  static std::shared_ptr<TaskQueueBackup> make(
+    std::string filename,
+    Clock::duration unqueued_lifetime = std::chrono::minutes(10));
+
+  /// Record the JSON request that a task was created from.
+  void record(const std::string& task_id, const nlohmann::json& request);
+
+  /// Take the queues that were loaded from the file for a robot. The queues of
+  /// each robot can only be taken once.
+  std::optional<Queues> take_loaded(const std::string& robot);
+
+  /// Get how many tasks were loaded from the file.
+  std::size_t loaded() const;
+
+  /// Save the queues of the robots to the file if they have changed since it
+  /// was last saved. Tasks without a recorded request, such as automatic
+  /// charging tasks, are left out. Queues that were loaded for robots which
+  /// have not taken them yet are kept. Returns false if the file could not be
+  /// written.
+  bool save(const std::unordered_map<std::string, TaskIds>& robots);
+
+private:
+
+  TaskQueueBackup(std::string filename, Clock::duration unqueued_lifetime);
+
+  void _load();
+
+  struct Recorded
+  {
+    nlohmann::json request;
+    Clock::time_point last_used;
+  };
+
+  std::string _filename;
+  Clock::duration _unqueued_lifetime;
+  std::size_t _loaded = 0;
+  std::unordered_map<std::string, Recorded> _requests;
+  std::unordered_map<std::string, Queues> _untaken;
+  std::string _last_saved;
+  mutable std::mutex _mutex;
+};
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__TASKQUEUEBACKUP_HPP
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "TimerWheel.hpp"
+
+#include <stdexcept>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+void TimerWheel::Timer::cancel()
+{
+  _canceled = true;
+}
+
+//==============================================================================
+bool TimerWheel::Timer::is_canceled() const
+{
+  return _canceled;
+}
+
+//==============================================================================
+TimerWheel::Timer::Timer(rmf_traffic::Duration period, Callback callback)
+: _period(period),
+  _callback(std::move(callback))
+{
+  // Do nothing
+}
+
+//==============================================================================
+TimerWheel::TimerWheel(
+  const rmf_traffic::Duration resolution,
+  const Clock::time_point start)
+: _resolution(resolution),
+  _last_tick(start),
+  _slots(NumSlots)
+{
+  if (_resolution <= rmf_traffic::Duration(0))
+  {
+    throw std::invalid_argument(
+      "[rmf_fleet_adapter::TimerWheel] The resolution must be positive");
+  }
+}
+
+//==============================================================================
+auto TimerWheel::add(rmf_traffic::Duration period, Callback callback)
+-> TimerPtr
+{
+  TimerPtr timer(new Timer(period, std::move(callback)));
+  std::lock_guard<std::mutex> lock(_mutex);
+  _insert(timer, period);
+  return timer;
+}
+
+//==============================================================================
+void TimerWheel::advance(const Clock::time_point now)
+{
+  std::vector<TimerPtr> due;
+  while (true)
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (now < _last_tick + _resolution)
+        return;
+
+      _last_tick += _resolution;
+      _current_slot = (_current_slot + 1) % NumSlots;
+
+      auto& slot = _slots[_current_slot];
+      std::size_t kept = 0;
+      for (auto& entry : slot)
+      {
+        auto timer = entry.timer.lock();
+        if (!timer || timer->is_canceled())
+        {
+          --_size;
+          continue;
+        }
+
+        if (entry.rounds > 0)
+        {
+          --entry.rounds;
+          slot[kept++] = std::move(entry);
+          continue;
+        }
+
+        --_size;
+        due.push_back(std::move(timer));
+      }
+      slot.resize(kept);
+    }
+
+    // Trigger the callbacks without holding the lock, since they may add or
+    // drop timers of their own.
+    for (const auto& timer : due)
+    {
+      if (!timer->is_canceled())
+        timer->_callback();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      for (const auto& timer : due)
+      {
+        // If this is the last reference then the owner dropped the timer
+        // during its callback.
+        if (!timer->is_canceled() && timer.use_count() > 1)
+          _insert(timer, timer->_period);
+      }
+    }
+
+    due.clear();
+  }
+}
+
+//==============================================================================
+std::size_t TimerWheel::size() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _size;
+}
+
+//==============================================================================
+rmf_traffic::Duration TimerWheel::resolution() const
+{
+  return _resolution;
+}
+
+//==============================================================================
+void TimerWheel::_insert(
+  std::weak_ptr<Timer> timer,
+  const rmf_traffic::Duration period)
+{
+  std::size_t ticks = static_cast<std::size_t>(
+    (period + _resolution - rmf_traffic::Duration(1)) / _resolution);
+  if (ticks == 0)
+    ticks = 1;
+
+  const std::size_t slot = (_current_slot + ticks) % NumSlots;
+  _slots[slot].push_back(Entry{std::move(timer), (ticks - 1) / NumSlots});
+  ++_size;
+}
+
+} // namespace rmf_fleet_adapter
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__TIMERWHEEL_HPP
+#define SRC__RMF_FLEET_ADAPTER__TIMERWHEEL_HPP
+
+#include <rmf_traffic/Time.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// A hashed timer wheel that lets many coarse periodic timers share a single
+/// clock source. Timers are kept in slots by the tick that they are due on,
+/// and timers that are due more than one revolution away count down the
+/// number of revolutions they still need to wait, so adding, cancelling, and
+/// triggering a timer are all constant time no matter how many timers exist.
+///
+/// Timers fire on the thread that calls advance(), with a precision of one
+/// resolution. A timer keeps firing once per period until it is cancelled or
+/// its last TimerPtr is dropped, just like an rclcpp wall timer.
+class TimerWheel
+{
+public:
+
+  using Callback = std::function<void()>;
+  using Clock = std::chrono::steady_clock;
+
+  class Timer
+  {
+  public:
+
+    /// Stop the timer from firing again.
+    void cancel();
+
+    /// True if cancel() has been called.
+    bool is_canceled() const;
+
+  private:
+    friend class TimerWheel;
+    Timer(rmf_traffic::Duration period, Callback callback);
+
+    rmf_traffic::Duration _period;
+    Callback _callback;
+    std::atomic_bool _canceled{false};
+  };
+
+  using TimerPtr = std::shared_ptr<Timer>;
+
+  /// The number of slots in the wheel
+  static constexpr std::size_t NumSlots = 256;
+
+  /// The default time between ticks of the wheel
+  static constexpr rmf_traffic::Duration DefaultResolution =
+    std::chrono::milliseconds(100);
+
+  TimerWheel(
+    rmf_traffic::Duration resolution = DefaultResolution,
+    Clock::time_point start = Clock::now());
+
+  /// Add a timer that fires once every period. The timer stays active for as
+  /// long as the returned pointer, or a copy of it, is held.
+  TimerPtr add(rmf_traffic::Duration period, Callback callback);
+
+  /// Move the wheel forward to the given time, triggering every timer that
+  /// has come due along the way.
+  void advance(Clock::time_point now);
+
+  /// The number of timers in the wheel, including ones that have been dropped
+  /// or cancelled but not yet cleaned out.
+  std::size_t size() const;
+
+  /// The time between ticks of the wheel
+  rmf_traffic::Duration resolution() const;
+
+private:
+
+  struct Entry
+  {
+    std::weak_ptr<Timer> timer;
+    std::size_t rounds;
+  };
+
+  void _insert(std::weak_ptr<Timer> timer, rmf_traffic::Duration period);
+
+  rmf_traffic::Duration _resolution;
+  Clock::time_point _last_tick;
+  std::size_t _current_slot = 0;
+  std::size_t _size = 0;
+  std::vector<std::vector<Entry>> _slots;
+  mutable std::mutex _mutex;
+};
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__TIMERWHEEL_HPP
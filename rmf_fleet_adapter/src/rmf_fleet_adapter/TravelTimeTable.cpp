@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "TravelTimeTable.hpp"
+
+#include <limits>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+std::shared_ptr<TravelTimeTable> TravelTimeTable::make(
+  std::shared_ptr<const Planner> planner)
+{
+  std::shared_ptr<TravelTimeTable> table(
+    new TravelTimeTable(std::move(planner)));
+
+  table->_thread = std::thread([t = table.get()]() { t->_fill(); });
+  return table;
+}
+
+//==============================================================================
+std::optional<double> TravelTimeTable::get(
+  const std::size_t start,
+  const std::size_t goal) const
+{
+  if (start >= _row_of_waypoint.size() || goal >= _row_of_waypoint.size())
+    return std::nullopt;
+
+  const std::size_t row = _row_of_waypoint[start];
+  const std::size_t col = _row_of_waypoint[goal];
+  if (row == NotInTable || col == NotInTable)
+    return std::nullopt;
+
+  if (row >= _rows_done.load(std::memory_order_acquire))
+    return std::nullopt;
+
+  return _costs[row * _waypoints.size() + col];
+}
+
+//==============================================================================
+auto TravelTimeTable::planner() const -> const std::shared_ptr<const Planner>&
+{
+  return _planner;
+}
+
+//==============================================================================
+std::size_t TravelTimeTable::size() const
+{
+  return _waypoints.size();
+}
+
+//==============================================================================
+bool TravelTimeTable::ready() const
+{
+  return _rows_done.load(std::memory_order_acquire) == _waypoints.size();
+}
+
+//==============================================================================
+TravelTimeTable::~TravelTimeTable()
+{
+  _stop = true;
+  if (_thread.joinable())
+    _thread.join();
+}
+
+//==============================================================================
+TravelTimeTable::TravelTimeTable(std::shared_ptr<const Planner> planner)
+: _planner(std::move(planner))
+{
+  const auto& graph = _planner->get_configuration().graph();
+  _row_of_waypoint.resize(graph.num_waypoints(), NotInTable);
+  for (std::size_t i = 0; i < graph.num_waypoints(); ++i)
+  {
+    const auto& wp = graph.get_waypoint(i);
+    const bool relevant = wp.name() || wp.is_charger()
+      || wp.is_parking_spot() || wp.is_holding_point();
+
+    if (!relevant)
+      continue;
+
+    _row_of_waypoint[i] = _waypoints.size();
+    _waypoints.push_back(i);
+  }
+
+  _costs.resize(_waypoints.size() * _waypoints.size(),
+    std::numeric_limits<double>::infinity());
+}
+
+//==============================================================================
+void TravelTimeTable::_fill()
+{
+  const std::size_t n = _waypoints.size();
+  const auto now = std::chrono::steady_clock::now();
+  for (std::size_t row = 0; row < n; ++row)
+  {
+    const Planner::Start start(now, _waypoints[row], 0.0);
+    for (std::size_t col = 0; col < n; ++col)
+    {
+      if (_stop)
+        return;
+
+      double& cost = _costs[row * n + col];
+      if (row == col)
+      {
+        cost = 0.0;
+        continue;
+      }
+
+      const auto ideal = _planner->setup(
+        start, Planner::Goal(_waypoints[col])).ideal_cost();
+
+      if (ideal.has_value())
+        cost = *ideal;
+    }
+
+    _rows_done.store(row + 1, std::memory_order_release);
+  }
+}
+
+} // namespace rmf_fleet_adapter
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__TRAVELTIMETABLE_HPP
+#define SRC__RMF_FLEET_ADAPTER__TRAVELTIMETABLE_HPP
+
+#include <rmf_traffic/agv/Planner.hpp>
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// A table of the ideal travel time between every pair of task-relevant
+/// waypoints in a navigation graph, i.e. waypoints that have a name or that
+/// are chargers, parking spots, or holding points.
+///
+/// The table is filled in row by row on a background thread. Filling it also
+/// fills the caches of the planner, so the task planner, which estimates its
+/// travel costs with the same planner, will find its estimates already
+/// computed. A table belongs to one planner, so a new table needs to be made
+/// whenever the planner is replaced, e.g. because lanes were closed.
+class TravelTimeTable
+{
+public:
+
+  using Planner = rmf_traffic::agv::Planner;
+
+  /// Make a table for the given planner and start filling it in.
+  static std::shared_ptr<TravelTimeTable> make(
+    std::shared_ptr<const Planner> planner);
+
+  /// Get the ideal travel time in seconds from one waypoint to another. This
+  /// will be infinity if the goal cannot be reached from the start, and
+  /// std::nullopt if the pair is not in the table or has not been computed
+  /// yet, in which case the planner should be asked instead.
+  std::optional<double> get(std::size_t start, std::size_t goal) const;
+
+  /// Get the planner that the table was made for.
+  const std::shared_ptr<const Planner>& planner() const;
+
+  /// Get the number of waypoints that the table covers.
+  std::size_t size() const;
+
+  /// True once every pair in the table has been computed.
+  bool ready() const;
+
+  /// Stop filling in the table.
+  ~TravelTimeTable();
+
+private:
+
+  TravelTimeTable(std::shared_ptr<const Planner> planner);
+
+  void _fill();
+
+  static constexpr std::size_t NotInTable = std::size_t(-1);
+
+  std::shared_ptr<const Planner> _planner;
+  std::vector<std::size_t> _waypoints;
+  std::vector<std::size_t> _row_of_waypoint;
+  std::vector<double> _costs;
+
+  // Rows below this have been fully written and may be read
+  std::atomic_size_t _rows_done{0};
+  std::atomic_bool _stop{false};
+  std::thread _thread;
+};
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__TRAVELTIMETABLE_HPP
@@ -30,6 +30,7 @@
 #include "internal_EasyTrafficLight.hpp"
 
 #include "../load_param.hpp"
+#include "../PlannerRegistry.hpp"
 
 namespace rmf_fleet_adapter {
 namespace agv {
@@ -64,7 +65,8 @@ public:
   std::shared_ptr<rmf_traffic_ros2::schedule::Negotiation> negotiation;
   std::shared_ptr<ParticipantFactory> schedule_writer;
   std::shared_ptr<rmf_traffic_ros2::blockade::Writer> blockade_writer;
-  rmf_traffic_ros2::schedule::MirrorManager mirror_manager;
+  // Shared with any adapters that were made to share this node
+  std::shared_ptr<rmf_traffic_ros2::schedule::MirrorManager> mirror_manager;
 
   std::vector<std::shared_ptr<FleetUpdateHandle>> fleets = {};
 
@@ -88,6 +90,15 @@ public:
   // This mutex protects the initialization of traffic lights
   std::mutex _traffic_light_init_mutex;
 
+  // Adapters that share a node keep it spinning until the last of them stops
+  struct NodeUsers
+  {
+    std::mutex mutex;
+    std::size_t spinning = 0;
+  };
+  std::shared_ptr<NodeUsers> node_users = std::make_shared<NodeUsers>();
+  bool started = false;
+
   Implementation(
     rxcpp::schedulers::worker worker_,
     std::shared_ptr<Node> node_,
@@ -99,11 +110,48 @@ public:
     negotiation{std::move(negotiation_)},
     schedule_writer{std::move(writer_)},
     blockade_writer{rmf_traffic_ros2::blockade::Writer::make(*node)},
-    mirror_manager{std::move(mirror_manager_)}
+    mirror_manager{std::make_shared<rmf_traffic_ros2::schedule::MirrorManager>(
+        std::move(mirror_manager_))}
   {
     // Do nothing
   }
 
+  // Share the node, schedule connection, and infrastructure subscriptions of
+  // another adapter while keeping a separate set of fleets
+  Implementation(const Implementation& other)
+  : worker{other.worker},
+    node{other.node},
+    negotiation{other.negotiation},
+    schedule_writer{other.schedule_writer},
+    blockade_writer{other.blockade_writer},
+    mirror_manager{other.mirror_manager},
+    node_users{other.node_users}
+  {
+    // Do nothing
+  }
+
+  void start()
+  {
+    std::lock_guard<std::mutex> lock(node_users->mutex);
+    if (started)
+      return;
+
+    started = true;
+    if (node_users->spinning++ == 0)
+      node->start();
+  }
+
+  void stop()
+  {
+    std::lock_guard<std::mutex> lock(node_users->mutex);
+    if (!started)
+      return;
+
+    started = false;
+    if (--node_users->spinning == 0)
+      node->stop();
+  }
+
   static rmf_utils::unique_impl_ptr<Implementation> make(
     const std::string& node_name,
     const rclcpp::NodeOptions& node_options,
@@ -134,6 +182,27 @@ public:
 
     auto writer = rmf_traffic_ros2::schedule::Writer::make(node);
 
+    // Publish the itinerary changes of all the robots of this adapter together
+    // once per window instead of one at a time. Zero publishes each change
+    // immediately.
+    const double schedule_batch_window =
+      get_parameter_or_default(*node, "schedule_batch_window", 0.0);
+    if (schedule_batch_window > 0.0)
+    {
+      writer->batch_window(
+        rmf_traffic::time::from_seconds(schedule_batch_window));
+    }
+
+    // Only send the latest checkpoint that each robot has reached once per
+    // window. Zero sends every checkpoint as soon as it is reached.
+    const double schedule_reached_window =
+      get_parameter_or_default(*node, "schedule_reached_window", 0.0);
+    if (schedule_reached_window > 0.0)
+    {
+      writer->reached_window(
+        rmf_traffic::time::from_seconds(schedule_reached_window));
+    }
+
     using namespace std::chrono_literals;
 
     const auto stop_time =
@@ -162,6 +231,19 @@ public:
           *node, mirror_manager.view(),
           std::make_shared<WorkerWrapper>(worker));
 
+        // How long each of our negotiators has to respond to a negotiation
+        // table before it forfeits the table
+        negotiation->timeout_duration(
+          get_parameter_or_default_time(
+            *node, "negotiation_response_timeout", 15.0));
+
+        // Record the negotiation messages that this adapter receives so that
+        // slow negotiations can be replayed and profiled offline
+        const auto record_file = node->declare_parameter<std::string>(
+          "negotiation_record_file", "");
+        if (!record_file.empty())
+          negotiation->record(record_file);
+
         return rmf_utils::make_unique_impl<Implementation>(
           worker,
           std::move(node),
@@ -204,6 +286,18 @@ std::shared_ptr<Adapter> Adapter::make(
   return nullptr;
 }
 
+//==============================================================================
+std::shared_ptr<Adapter> Adapter::make_sharing(
+  const std::shared_ptr<Adapter>& other)
+{
+  if (!other)
+    return nullptr;
+
+  auto adapter = std::shared_ptr<Adapter>(new Adapter);
+  adapter->_pimpl = rmf_utils::make_unique_impl<Implementation>(*other->_pimpl);
+  return adapter;
+}
+
 namespace {
 class DuplicateDockFinder : public rmf_traffic::agv::Graph::Lane::Executor
 {
@@ -394,17 +488,16 @@ std::shared_ptr<FleetUpdateHandle> Adapter::add_fleet(
   rmf_traffic::agv::Graph navigation_graph,
   std::optional<std::string> server_uri)
 {
+  // Fleets in this process with the same graph and traits share a planner
   auto planner =
     std::make_shared<std::shared_ptr<const rmf_traffic::agv::Planner>>(
-    std::make_shared<rmf_traffic::agv::Planner>(
-      rmf_traffic::agv::Planner::Configuration(
-        std::move(navigation_graph),
-        std::move(traits)),
-      rmf_traffic::agv::Planner::Options(nullptr)));
+    PlannerRegistry::get().share(
+      std::move(navigation_graph),
+      std::move(traits)));
 
   auto fleet = FleetUpdateHandle::Implementation::make(
     fleet_name, std::move(planner), _pimpl->node, _pimpl->worker,
-    _pimpl->schedule_writer, _pimpl->mirror_manager.view(),
+    _pimpl->schedule_writer, _pimpl->mirror_manager->view(),
     _pimpl->negotiation, server_uri);
 
   _pimpl->fleets.push_back(fleet);
@@ -476,7 +569,7 @@ void Adapter::add_easy_traffic_light(
     handle_callback = std::move(handle_callback),
     blocker_callback = std::move(blocker_callback),
     blockade_writer = _pimpl->blockade_writer,
-    schedule = _pimpl->mirror_manager.view(),
+    schedule = _pimpl->mirror_manager->view(),
     worker = _pimpl->worker,
     handle_cb = std::move(handle_callback),
     negotiation = _pimpl->negotiation,
@@ -531,14 +624,14 @@ std::shared_ptr<const rclcpp::Node> Adapter::node() const
 //==============================================================================
 Adapter& Adapter::start()
 {
-  _pimpl->node->start();
+  _pimpl->start();
   return *this;
 }
 
 //==============================================================================
 Adapter& Adapter::stop()
 {
-  _pimpl->node->stop();
+  _pimpl->stop();
   return *this;
 }
 
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "DynamicEventServer.hpp"
+#include "RobotContext.hpp"
+
+#include <rmf_fleet_adapter/StandardNames.hpp>
+
+namespace rmf_fleet_adapter {
+namespace agv {
+
+//==============================================================================
+std::shared_ptr<DynamicEventServer> DynamicEventServer::make(
+  const std::shared_ptr<rclcpp::Node>& node,
+  const std::string& fleet_name)
+{
+  auto server = std::shared_ptr<DynamicEventServer>(new DynamicEventServer);
+
+  // The topic carries the latest status of every robot in the fleet, so it
+  // keeps more than one message for late joiners.
+  server->_status_pub = node->create_publisher<DynamicEventStatus>(
+    DynamicEventStatusTopicBase + "/" + fleet_name,
+    rclcpp::QoS(100).reliable().transient_local());
+
+  auto logger = rclcpp::get_logger("rmf.dynamic_event." + fleet_name);
+  auto handle_goal = [w = server->weak_from_this(), logger, fleet_name](
+    const rclcpp_action::GoalUUID&,
+    std::shared_ptr<const DynamicEventAction::Goal> goal)
+  {
+    const auto self = w.lock();
+    if (!self)
+    {
+      RCLCPP_ERROR(
+        logger,
+        "Rejecting dynamic event goal because the fleet adapter is winding down.");
+      return rclcpp_action::GoalResponse::REJECT;
+    }
+
+    const auto context = self->_find(goal->dynamic_event_seq);
+    if (!context)
+    {
+      RCLCPP_ERROR(
+        logger,
+        "Rejecting dynamic event goal because no robot of fleet [%s] is "
+        "running a dynamic event with dynamic_event_seq %d.",
+        fleet_name.c_str(),
+        goal->dynamic_event_seq);
+      return rclcpp_action::GoalResponse::REJECT;
+    }
+
+    return context->_handle_dynamic_event_goal(*goal);
+  };
+
+  auto handle_accepted = [w = server->weak_from_this()](
+    const std::shared_ptr<DynamicEventHandle> handle)
+  {
+    const auto self = w.lock();
+    const auto context =
+      self ? self->_find(handle->get_goal()->dynamic_event_seq) : nullptr;
+    if (!context)
+    {
+      handle->execute();
+      handle->abort(dynamic_event_execution_failure("shutting down"));
+      return;
+    }
+
+    context->_handle_dynamic_event_accepted(handle);
+  };
+
+  auto handle_cancel = [w = server->weak_from_this()](
+    const std::shared_ptr<DynamicEventHandle> handle)
+  {
+    const auto self = w.lock();
+    const auto context =
+      self ? self->_find(handle->get_goal()->dynamic_event_seq) : nullptr;
+    if (!context)
+    {
+      handle->canceled(
+        dynamic_event_execution_failure("cancelled while not running"));
+      return rclcpp_action::CancelResponse::ACCEPT;
+    }
+
+    return context->_handle_dynamic_event_cancel(handle);
+  };
+
+  server->_server = rclcpp_action::create_server<DynamicEventAction>(
+    node,
+    DynamicEventActionName + "/" + fleet_name,
+    handle_goal,
+    handle_cancel,
+    handle_accepted);
+
+  return server;
+}
+
+//==============================================================================
+uint32_t DynamicEventServer::begin(
+  const std::shared_ptr<RobotContext>& context,
+  const uint32_t previous_seq)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto previous = _robots.find(previous_seq);
+  if (previous != _robots.end() && previous->second.lock() == context)
+    _robots.erase(previous);
+
+  // Forget robots that have been removed from the fleet
+  for (auto it = _robots.begin(); it != _robots.end(); )
+  {
+    if (it->second.expired())
+      it = _robots.erase(it);
+    else
+      ++it;
+  }
+
+  // Zero is never used so that a robot that has not begun any dynamic event
+  // does not match any goal.
+  if (++_last_seq == 0)
+    ++_last_seq;
+
+  _robots[_last_seq] = context;
+  return _last_seq;
+}
+
+//==============================================================================
+const DynamicEventStatusPub& DynamicEventServer::status_publisher() const
+{
+  return _status_pub;
+}
+
+//==============================================================================
+std::shared_ptr<RobotContext> DynamicEventServer::_find(uint32_t seq) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto it = _robots.find(seq);
+  if (it == _robots.end())
+    return nullptr;
+
+  return it->second.lock();
+}
+
+} // namespace agv
+} // namespace rmf_fleet_adapter
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__AGV__DYNAMICEVENTSERVER_HPP
+#define SRC__RMF_FLEET_ADAPTER__AGV__DYNAMICEVENTSERVER_HPP
+
+#include <rmf_task_msgs/action/dynamic_event.hpp>
+#include <rmf_task_msgs/msg/dynamic_event_status.hpp>
+
+#include <rclcpp/node.hpp>
+#include <rclcpp_action/rclcpp_action.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace rmf_fleet_adapter {
+
+using DynamicEventAction = rmf_task_msgs::action::DynamicEvent;
+using DynamicEventHandle = rclcpp_action::ServerGoalHandle<DynamicEventAction>;
+using DynamicEventStatus = rmf_task_msgs::msg::DynamicEventStatus;
+using DynamicEventStatusPub = rclcpp::Publisher<DynamicEventStatus>::SharedPtr;
+
+namespace agv {
+
+class RobotContext;
+
+//==============================================================================
+/// A dynamic event action server that is shared by every robot of a fleet, so
+/// the fleet only needs one action server and one status topic instead of one
+/// of each for every robot.
+///
+/// The dynamic_event_seq of each dynamic event is unique across the fleet, so
+/// goals get routed to a robot by their dynamic_event_seq. Clients find out
+/// which robot a dynamic_event_seq belongs to from the fleet and robot names
+/// of the DynamicEventDescription that announced it on the general
+/// DynamicEventBeginTopicBase topic.
+class DynamicEventServer
+  : public std::enable_shared_from_this<DynamicEventServer>
+{
+public:
+
+  /// Create the server of a fleet. The action will be named
+  /// DynamicEventActionName/<fleet_name> and the statuses will be published
+  /// to DynamicEventStatusTopicBase/<fleet_name>.
+  static std::shared_ptr<DynamicEventServer> make(
+    const std::shared_ptr<rclcpp::Node>& node,
+    const std::string& fleet_name);
+
+  /// Begin a new dynamic event for a robot. Goals with the returned
+  /// dynamic_event_seq will be routed to the robot until it begins another
+  /// one.
+  ///
+  /// \param[in] context
+  ///   The robot that is beginning a dynamic event.
+  ///
+  /// \param[in] previous_seq
+  ///   The dynamic_event_seq of the previous dynamic event of the robot,
+  ///   which will no longer be routed to it.
+  uint32_t begin(
+    const std::shared_ptr<RobotContext>& context,
+    uint32_t previous_seq);
+
+  /// The publisher for the dynamic event statuses of every robot in the fleet
+  const DynamicEventStatusPub& status_publisher() const;
+
+private:
+
+  DynamicEventServer() = default;
+
+  std::shared_ptr<RobotContext> _find(uint32_t seq) const;
+
+  mutable std::mutex _mutex;
+  uint32_t _last_seq = 0;
+  std::unordered_map<uint32_t, std::weak_ptr<RobotContext>> _robots;
+  DynamicEventStatusPub _status_pub;
+  rclcpp_action::Server<DynamicEventAction>::SharedPtr _server;
+};
+
+} // namespace agv
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__AGV__DYNAMICEVENTSERVER_HPP
@@ -113,6 +113,49 @@ void EasyFullControl::RobotState::set_battery_state_of_charge(double value)
   _pimpl->battery_soc = value;
 }
 
+//==============================================================================
+class EasyFullControl::RobotStateUpdate::Implementation
+{
+public:
+  std::shared_ptr<EasyRobotUpdateHandle> robot;
+  RobotState state;
+  ConstActivityIdentifierPtr current_activity;
+};
+
+//==============================================================================
+EasyFullControl::RobotStateUpdate::RobotStateUpdate(
+  std::shared_ptr<EasyRobotUpdateHandle> robot,
+  RobotState state,
+  ConstActivityIdentifierPtr current_activity)
+: _pimpl(rmf_utils::make_impl<Implementation>(Implementation{
+      std::move(robot),
+      std::move(state),
+      std::move(current_activity)
+    }))
+{
+  // Do nothing
+}
+
+//==============================================================================
+auto EasyFullControl::RobotStateUpdate::robot() const
+-> const std::shared_ptr<EasyRobotUpdateHandle>&
+{
+  return _pimpl->robot;
+}
+
+//==============================================================================
+auto EasyFullControl::RobotStateUpdate::state() const -> const RobotState&
+{
+  return _pimpl->state;
+}
+
+//==============================================================================
+const ConstActivityIdentifierPtr&
+EasyFullControl::RobotStateUpdate::current_activity() const
+{
+  return _pimpl->current_activity;
+}
+
 //==============================================================================
 class EasyFullControl::RobotConfiguration::Implementation
 {
@@ -1218,6 +1261,61 @@ void EasyCommandHandle::follow_new_path(
     i0 = waypoints.size() - 2;
   }
 
+  // Transform every waypoint that could become a command target into robot
+  // coordinates up front, with one batch for each run of waypoints that are
+  // on the same map.
+  std::vector<std::string> target_maps(waypoints.size());
+  Eigen::Matrix3Xd robot_positions(3, waypoints.size());
+  {
+    std::string run_map = initial_map;
+    std::size_t run_start = i0 + 1;
+    const auto transform_run = [&](std::size_t run_end)
+      {
+        if (run_end <= run_start)
+          return;
+
+        const auto n = static_cast<Eigen::Index>(run_end - run_start);
+        const auto first = static_cast<Eigen::Index>(run_start);
+        Eigen::Matrix3Xd positions(3, n);
+        for (Eigen::Index k = 0; k < n; ++k)
+          positions.col(k) = waypoints[run_start + k].position();
+
+        auto transformed = nav_params->to_robot_coordinates(run_map, positions);
+        if (!transformed.has_value())
+        {
+          RCLCPP_WARN(
+            context->node()->get_logger(),
+            "[EasyFullControl] Unable to find robot transform for map [%s] for "
+            "robot [%s]. We will not apply a transform.",
+            run_map.c_str(),
+            context->requester_id().c_str());
+          transformed = std::move(positions);
+        }
+
+        robot_positions.middleCols(first, n) = *transformed;
+      };
+
+    for (std::size_t k = i0 + 1; k < waypoints.size(); ++k)
+    {
+      const auto& wp = waypoints[k];
+      if (wp.graph_index().has_value())
+      {
+        const auto& wp_map =
+          graph.get_waypoint(*wp.graph_index()).get_map_name();
+        if (wp_map != run_map)
+        {
+          transform_run(k);
+          run_map = wp_map;
+          run_start = k;
+        }
+      }
+
+      target_maps[k] = run_map;
+    }
+
+    transform_run(waypoints.size());
+  }
+
   std::size_t i1 = i0 + 1;
   while (i1 < waypoints.size())
   {
@@ -1327,7 +1425,9 @@ void EasyCommandHandle::follow_new_path(
       }
     }
 
-    const auto command_position = to_robot_coordinates(map, target_position);
+    const Eigen::Vector3d command_position = target_maps[target_index] == map ?
+      Eigen::Vector3d(robot_positions.col(target_index)) :
+      to_robot_coordinates(map, target_position);
     auto destination = EasyFullControl::Destination::Implementation::make(
       std::move(map),
       command_position,
@@ -2087,18 +2187,65 @@ public:
 
   std::shared_ptr<Updater> updater;
   rxcpp::schedulers::worker worker;
+  // Only used to tell which fleet the robot belongs to
+  const FleetUpdateHandle* fleet;
 
   static Implementation& get(EasyRobotUpdateHandle& handle)
   {
     return *handle._pimpl;
   }
 
+  static void apply(
+    const Updater& updater,
+    const RobotState& state,
+    const ConstActivityIdentifierPtr& current_activity)
+  {
+    if (!updater.handle)
+    {
+      return;
+    }
+
+    auto context = RobotUpdateHandle::Implementation
+    ::get(*updater.handle).get_context();
+
+    context->current_battery_soc(state.battery_state_of_charge());
+
+    const auto position = updater.to_rmf_coordinates(
+      state.map(), state.position(), *context);
+
+    *updater.reported_location = Location {
+      context->now(),
+      state.map(),
+      position
+    };
+
+    if (current_activity)
+    {
+      const auto update_fn =
+      ActivityIdentifier::Implementation::get(*current_activity).update_fn;
+      if (update_fn)
+      {
+        update_fn(
+          state.map(), position);
+        return;
+      }
+    }
+
+    if (context->debug_positions)
+    {
+      std::cout << "Searching for location from " << __FILE__ << "|" << __LINE__ << std::endl;
+    }
+    updater.nav_params->search_for_location(state.map(), position, *context);
+  }
+
   Implementation(
     std::shared_ptr<Location> reported_location_,
     std::shared_ptr<NavParams> params_,
-    rxcpp::schedulers::worker worker_)
+    rxcpp::schedulers::worker worker_,
+    const FleetUpdateHandle* fleet_)
   : updater(std::make_shared<Updater>(std::move(reported_location_), params_)),
-    worker(worker_)
+    worker(worker_),
+    fleet(fleet_)
   {
     // Do nothing
   }
@@ -2106,12 +2253,14 @@ public:
   static std::shared_ptr<EasyRobotUpdateHandle> make(
     std::shared_ptr<Location> reported_location_,
     std::shared_ptr<NavParams> params_,
-    rxcpp::schedulers::worker worker_)
+    rxcpp::schedulers::worker worker_,
+    const FleetUpdateHandle* fleet_)
   {
     auto handle = std::shared_ptr<EasyRobotUpdateHandle>(
       new EasyRobotUpdateHandle);
     handle->_pimpl = rmf_utils::make_unique_impl<Implementation>(
-      std::move(reported_location_), std::move(params_), std::move(worker_));
+      std::move(reported_location_), std::move(params_), std::move(worker_),
+      fleet_);
     return handle;
   }
 };
@@ -2129,42 +2278,7 @@ void EasyFullControl::EasyRobotUpdateHandle::update(
       updater = _pimpl->updater
     ](const auto&)
     {
-      if (!updater->handle)
-      {
-        return;
-      }
-
-      auto context = RobotUpdateHandle::Implementation
-      ::get(*updater->handle).get_context();
-
-      context->current_battery_soc(state.battery_state_of_charge());
-
-      const auto position = updater->to_rmf_coordinates(
-        state.map(), state.position(), *context);
-
-      *updater->reported_location = Location {
-        context->now(),
-        state.map(),
-        position
-      };
-
-      if (current_activity)
-      {
-        const auto update_fn =
-        ActivityIdentifier::Implementation::get(*current_activity).update_fn;
-        if (update_fn)
-        {
-          update_fn(
-            state.map(), position);
-          return;
-        }
-      }
-
-      if (context->debug_positions)
-      {
-        std::cout << "Searching for location from " << __FILE__ << "|" << __LINE__ << std::endl;
-      }
-      updater->nav_params->search_for_location(state.map(), position, *context);
+      Implementation::apply(*updater, state, current_activity);
     });
 }
 
@@ -2406,8 +2520,13 @@ EasyFullControl::FleetConfiguration::from_config_files(
       });
   traits->get_differential()->set_reversible(reversible);
 
-  // Graph
-  const auto graph = parse_graph(nav_graph_path, *traits);
+  // Graph, optionally loaded through a binary cache of the nav graph file
+  std::string nav_graph_cache;
+  if (rmf_fleet["nav_graph_cache"])
+  {
+    nav_graph_cache = rmf_fleet["nav_graph_cache"].as<std::string>();
+  }
+  const auto graph = parse_graph(nav_graph_path, *traits, nav_graph_cache);
 
   // Set up parameters required for task planner
   // Battery system
@@ -3443,6 +3562,48 @@ std::shared_ptr<const FleetUpdateHandle> EasyFullControl::more() const
   return _pimpl->fleet_handle;
 }
 
+//==============================================================================
+void EasyFullControl::update_all(std::vector<RobotStateUpdate> updates)
+{
+  struct Pending
+  {
+    std::shared_ptr<EasyRobotUpdateHandle::Implementation::Updater> updater;
+    RobotState state;
+    ConstActivityIdentifierPtr current_activity;
+  };
+
+  std::vector<Pending> pending;
+  pending.reserve(updates.size());
+  for (auto& update : updates)
+  {
+    if (!update.robot())
+      continue;
+
+    auto& impl = EasyRobotUpdateHandle::Implementation::get(*update.robot());
+    if (impl.fleet != _pimpl->fleet_handle.get())
+      continue;
+
+    pending.push_back(
+      Pending{impl.updater, update.state(), update.current_activity()});
+  }
+
+  if (pending.empty())
+    return;
+
+  // Every robot of this fleet has its updates handled by the fleet worker, so
+  // the whole batch can be handled by a single job on it.
+  FleetUpdateHandle::Implementation::get(*_pimpl->fleet_handle).worker
+  .schedule(
+    [pending = std::move(pending)](const auto&)
+    {
+      for (const auto& p : pending)
+      {
+        EasyRobotUpdateHandle::Implementation::apply(
+          *p.updater, p.state, p.current_activity);
+      }
+    });
+}
+
 //==============================================================================
 auto EasyFullControl::add_robot(
   std::string robot_name,
@@ -3464,7 +3625,7 @@ auto EasyFullControl::add_robot(
     FleetUpdateHandle::Implementation::get(*_pimpl->fleet_handle).worker;
   auto robot_nav_params = std::make_shared<NavParams>(_pimpl->nav_params);
   auto easy_updater = EasyRobotUpdateHandle::Implementation::make(
-    reported_location, robot_nav_params, worker);
+    reported_location, robot_nav_params, worker, _pimpl->fleet_handle.get());
 
   LocalizationRequest localization = nullptr;
   if (callbacks.localize())
@@ -18,6 +18,7 @@
 #include <rmf_traffic_ros2/Time.hpp>
 
 #include "internal_EasyTrafficLight.hpp"
+#include "publish_in_place.hpp"
 
 #include <rmf_utils/Modular.hpp>
 
@@ -313,10 +314,18 @@ void EasyTrafficLight::Implementation::Shared::follow_new_path(
     }
   }
 
+  state.planner = find_cached_planner(new_path);
+
   rmf_traffic::agv::Graph graph;
   for (std::size_t i = 0; i < new_path.size(); ++i)
   {
     const auto& wp = new_path[i];
+    state.checkpoints.push_back(
+      {wp.position().block<2, 1>(0, 0), wp.map_name(), wp.yield()});
+
+    if (state.planner)
+      continue;
+
     graph.add_waypoint(wp.map_name(), wp.position().block<2, 1>(0, 0))
     .set_passthrough_point(!wp.yield())
     .set_holding_point(wp.yield());
@@ -334,16 +343,20 @@ void EasyTrafficLight::Implementation::Shared::follow_new_path(
 
       graph.add_lane(rmf_traffic::agv::Graph::Lane::Node(i-1, event), i);
     }
-
-    state.checkpoints.push_back(
-      {wp.position().block<2, 1>(0, 0), wp.map_name(), wp.yield()});
   }
 
   state.blockade->set(state.checkpoints);
 
-  state.planner = std::make_shared<rmf_traffic::agv::Planner>(
-    rmf_traffic::agv::Plan::Configuration(graph, hooks.traits),
-    rmf_traffic::agv::Plan::Options(nullptr));
+  if (!state.planner)
+  {
+    state.planner = std::make_shared<rmf_traffic::agv::Planner>(
+      rmf_traffic::agv::Plan::Configuration(graph, hooks.traits),
+      rmf_traffic::agv::Plan::Options(nullptr));
+
+    planner_cache.push_front(CachedPlanner{new_path, state.planner});
+    if (planner_cache.size() > PlannerCacheSize)
+      planner_cache.pop_back();
+  }
 
   const auto now = rmf_traffic_ros2::convert(hooks.node->now());
   rmf_traffic::agv::Plan::Start start{now, 0, new_path.front().position()[2]};
@@ -351,6 +364,46 @@ void EasyTrafficLight::Implementation::Shared::follow_new_path(
   make_plan(path_version, std::move(start));
 }
 
+//==============================================================================
+std::shared_ptr<rmf_traffic::agv::Planner>
+EasyTrafficLight::Implementation::Shared::find_cached_planner(
+  const std::vector<Waypoint>& path)
+{
+  // Only the parts of a waypoint that go into the graph need to match. The
+  // yaw is only used for the start of the plan.
+  const auto same_graph = [&](const std::vector<Waypoint>& other)
+    {
+      if (other.size() != path.size())
+        return false;
+
+      for (std::size_t i = 0; i < path.size(); ++i)
+      {
+        const auto& a = path[i];
+        const auto& b = other[i];
+        if (a.map_name() != b.map_name()
+          || a.position().block<2, 1>(0, 0) != b.position().block<2, 1>(0, 0)
+          || a.yield() != b.yield()
+          || a.mandatory_delay() != b.mandatory_delay())
+        {
+          return false;
+        }
+      }
+
+      return true;
+    };
+
+  for (auto it = planner_cache.begin(); it != planner_cache.end(); ++it)
+  {
+    if (same_graph(it->path))
+    {
+      planner_cache.splice(planner_cache.begin(), planner_cache, it);
+      return planner_cache.front().planner;
+    }
+  }
+
+  return nullptr;
+}
+
 //==============================================================================
 void EasyTrafficLight::Implementation::Shared::make_plan(
   const std::size_t request_path_version,
@@ -1026,11 +1079,32 @@ void EasyTrafficLight::Implementation::Shared::respond(
 }
 
 //==============================================================================
-void EasyTrafficLight::Implementation::Shared::publish_fleet_state() const
+void EasyTrafficLight::Implementation::Shared::publish_fleet_state()
+{
+  const auto l = lock();
+  if (published_in_batch)
+  {
+    published_in_batch = false;
+    return;
+  }
+
+  auto robot_state = make_robot_state();
+  if (!robot_state.has_value())
+    return;
+
+  hooks.fleet_state_pub->publish(
+    rmf_fleet_msgs::build<FleetState>()
+    .name(state.itinerary->description().owner())
+    .robots({std::move(*robot_state)}));
+}
+
+//==============================================================================
+std::optional<rmf_fleet_msgs::msg::RobotState>
+EasyTrafficLight::Implementation::Shared::make_robot_state() const
 {
   const auto reported_location = state.location();
   if (!reported_location.has_value())
-    return;
+    return std::nullopt;
 
   auto robot_mode = [&]()
     {
@@ -1065,7 +1139,7 @@ void EasyTrafficLight::Implementation::Shared::publish_fleet_state() const
     .index(0);
 
   const auto& fleet_name = state.itinerary->description().owner();
-  auto robot_state = rmf_fleet_msgs::build<rmf_fleet_msgs::msg::RobotState>()
+  return rmf_fleet_msgs::build<rmf_fleet_msgs::msg::RobotState>()
     .name(state.itinerary->description().name())
     .model(fleet_name)
     // TODO(MXG): Have a way to fill this in
@@ -1297,6 +1371,173 @@ EasyTrafficLight& EasyTrafficLight::fleet_state_publish_period(
   return *this;
 }
 
+//==============================================================================
+class EasyTrafficLight::Progress::Implementation
+{
+public:
+
+  enum class Kind : uint8_t
+  {
+    MovingFrom,
+    WaitingAt,
+    WaitingAfter
+  };
+
+  EasyTrafficLightPtr traffic_light;
+  Kind kind;
+  std::size_t checkpoint;
+  Eigen::Vector3d location;
+  std::optional<double> battery_soc;
+
+  static Progress make(
+    EasyTrafficLightPtr traffic_light,
+    Kind kind,
+    std::size_t checkpoint,
+    Eigen::Vector3d location)
+  {
+    Progress output;
+    output._pimpl = rmf_utils::make_impl<Implementation>(
+      Implementation{
+        std::move(traffic_light),
+        kind,
+        checkpoint,
+        location,
+        std::nullopt
+      });
+
+    return output;
+  }
+
+  static const Implementation& get(const Progress& progress)
+  {
+    return *progress._pimpl;
+  }
+};
+
+//==============================================================================
+auto EasyTrafficLight::Progress::moving_from(
+  std::shared_ptr<EasyTrafficLight> traffic_light,
+  std::size_t checkpoint,
+  Eigen::Vector3d location) -> Progress
+{
+  return Implementation::make(
+    std::move(traffic_light), Implementation::Kind::MovingFrom,
+    checkpoint, location);
+}
+
+//==============================================================================
+auto EasyTrafficLight::Progress::waiting_at(
+  std::shared_ptr<EasyTrafficLight> traffic_light,
+  std::size_t checkpoint) -> Progress
+{
+  return Implementation::make(
+    std::move(traffic_light), Implementation::Kind::WaitingAt,
+    checkpoint, Eigen::Vector3d::Zero());
+}
+
+//==============================================================================
+auto EasyTrafficLight::Progress::waiting_after(
+  std::shared_ptr<EasyTrafficLight> traffic_light,
+  std::size_t checkpoint,
+  Eigen::Vector3d location) -> Progress
+{
+  return Implementation::make(
+    std::move(traffic_light), Implementation::Kind::WaitingAfter,
+    checkpoint, location);
+}
+
+//==============================================================================
+auto EasyTrafficLight::Progress::battery_soc(double value) -> Progress&
+{
+  _pimpl->battery_soc = value;
+  return *this;
+}
+
+//==============================================================================
+EasyTrafficLight::Progress::Progress()
+{
+  // Do nothing
+}
+
+//==============================================================================
+auto EasyTrafficLight::update_all(const std::vector<Progress>& progress)
+-> std::vector<Instruction>
+{
+  using Kind = Progress::Implementation::Kind;
+
+  std::vector<Instruction> instructions;
+  instructions.reserve(progress.size());
+
+  // Fleet states are collected per fleet and publisher, so each fleet gets one
+  // message for the whole batch.
+  using FleetState = rmf_fleet_msgs::msg::FleetState;
+  std::vector<std::pair<Implementation::Hooks*, FleetState>> fleet_states;
+
+  for (const auto& p : progress)
+  {
+    const auto& report = Progress::Implementation::get(p);
+    const auto& shared = report.traffic_light->_pimpl->shared;
+    const auto l = shared->lock();
+
+    if (report.battery_soc.has_value())
+      shared->battery_soc = *report.battery_soc;
+
+    switch (report.kind)
+    {
+      case Kind::MovingFrom:
+        instructions.push_back(
+          shared->moving_from(report.checkpoint, report.location));
+        break;
+      case Kind::WaitingAt:
+        instructions.push_back(shared->waiting_at(report.checkpoint));
+        break;
+      case Kind::WaitingAfter:
+        instructions.push_back(
+          shared->waiting_after(report.checkpoint, report.location));
+        break;
+    }
+
+    auto robot_state = shared->make_robot_state();
+    if (!robot_state.has_value())
+      continue;
+
+    const auto& fleet_name = shared->state.itinerary->description().owner();
+    const auto it = std::find_if(fleet_states.begin(), fleet_states.end(),
+        [&](const auto& f)
+        {
+          return f.second.name == fleet_name
+          && f.first->fleet_state_pub == shared->hooks.fleet_state_pub;
+        });
+
+    if (it == fleet_states.end())
+    {
+      fleet_states.push_back(
+        {&shared->hooks,
+          rmf_fleet_msgs::build<FleetState>()
+          .name(fleet_name)
+          .robots({std::move(*robot_state)})});
+    }
+    else
+    {
+      it->second.robots.push_back(std::move(*robot_state));
+    }
+
+    shared->published_in_batch = true;
+  }
+
+  for (auto& [hooks, fleet_state] : fleet_states)
+  {
+    publish_in_place<FleetState>(
+      hooks->fleet_state_pub,
+      [&fleet_state = fleet_state](FleetState& msg)
+      {
+        msg = std::move(fleet_state);
+      });
+  }
+
+  return instructions;
+}
+
 //==============================================================================
 class EasyTrafficLight::Blocker::Implementation
 {
@@ -20,12 +20,16 @@
 #include <rmf_fleet_msgs/msg/location.hpp>
 #include <rmf_fleet_msgs/msg/speed_limited_lane.hpp>
 
+#include <rmf_traffic/schedule/Query.hpp>
+
 #include <rmf_traffic_ros2/Time.hpp>
+#include <rmf_traffic_ros2/Tracing.hpp>
 #include <rmf_traffic_ros2/agv/Graph.hpp>
 
 #include "internal_FleetUpdateHandle.hpp"
 #include "internal_RobotUpdateHandle.hpp"
 #include "RobotContext.hpp"
+#include "publish_in_place.hpp"
 
 #include "../log_to_json.hpp"
 #include "../tasks/Delivery.hpp"
@@ -46,10 +50,21 @@
 
 #include <rmf_task_sequence/phases/SimplePhase.hpp>
 
+#include <rmf_utils/math.hpp>
+
+#include <rcutils/logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <memory_resource>
+#include <mutex>
 #include <sstream>
 #include <unordered_map>
 #include <unordered_set>
 #include <stdexcept>
+#include <thread>
 
 #include <rmf_fleet_adapter/schemas/place.hpp>
 #include <rmf_fleet_adapter/schemas/priority_description__binary.hpp>
@@ -121,6 +136,7 @@ TaskDeserialization::TaskDeserialization()
   task = std::make_shared<DeserializeJSON<DeserializedTask>>();
   phase = std::make_shared<DeserializeJSON<DeserializedPhase>>();
   event = std::make_shared<DeserializeJSON<DeserializedEvent>>();
+  description_cache = std::make_shared<TaskDescriptionCache>();
   consider_actions =
     std::make_shared<std::unordered_map<
         std::string, FleetUpdateHandle::ConsiderRequest>>();
@@ -161,9 +177,25 @@ void FleetUpdateHandle::Implementation::dock_summary_cb(
   {
     if (dock.fleet_name == name)
     {
-      dock_param_map->clear();
+      // Only touch the entries that actually changed
+      std::unordered_set<std::string> present;
       for (const auto& param : dock.params)
-        dock_param_map->insert({param.start, param});
+      {
+        present.insert(param.start);
+        const auto d_it = dock_param_map->find(param.start);
+        if (d_it == dock_param_map->end())
+          dock_param_map->insert({param.start, param});
+        else if (d_it->second != param)
+          d_it->second = param;
+      }
+
+      for (auto d_it = dock_param_map->begin(); d_it != dock_param_map->end(); )
+      {
+        if (present.count(d_it->first) == 0)
+          d_it = dock_param_map->erase(d_it);
+        else
+          ++d_it;
+      }
       break;
     }
   }
@@ -192,35 +224,44 @@ std::shared_ptr<rmf_task::Request> FleetUpdateHandle::Implementation::convert(
   const auto& description_msg = request_msg["description"];
   const auto& task_deser_handler = task_deser_it->second;
 
-  try
-  {
-    task_deser_handler.validator->validate(description_msg);
-  }
-  catch (const std::exception& e)
+  auto description =
+    deserialization.description_cache->find(category, description_msg);
+  if (!description)
   {
-    RCLCPP_ERROR(
-      node->get_logger(),
-      "Received a request description for [%s] with an invalid format. "
-      "Error: %s\nRequest:\n%s",
-      category.c_str(),
-      e.what(),
-      description_msg.dump(2, ' ').c_str());
+    try
+    {
+      task_deser_handler.validator->validate(description_msg);
+    }
+    catch (const std::exception& e)
+    {
+      RCLCPP_ERROR(
+        node->get_logger(),
+        "Received a request description for [%s] with an invalid format. "
+        "Error: %s\nRequest:\n%s",
+        category.c_str(),
+        e.what(),
+        description_msg.dump(2, ' ').c_str());
 
-    errors.push_back(make_error_str(5, "Invalid request format", e.what()));
-    return nullptr;
-  }
+      errors.push_back(make_error_str(5, "Invalid request format", e.what()));
+      return nullptr;
+    }
 
-  const auto deserialized_task =
-    task_deser_handler.deserializer(description_msg);
+    const auto deserialized_task =
+      task_deser_handler.deserializer(description_msg);
 
-  if (!deserialized_task.description)
-  {
-    errors = deserialized_task.errors;
-    for (auto& e : errors)
+    if (!deserialized_task.description)
     {
-      e = make_error_str(6, "Unable to deserialize", e);
+      errors = deserialized_task.errors;
+      for (auto& e : errors)
+      {
+        e = make_error_str(6, "Unable to deserialize", e);
+      }
+      return nullptr;
     }
-    return nullptr;
+
+    description = deserialized_task.description;
+    deserialization.description_cache->insert(
+      category, description_msg, description);
   }
 
   rmf_traffic::Time earliest_start_time = rmf_traffic_ros2::convert(
@@ -303,7 +344,24 @@ std::shared_ptr<rmf_task::Request> FleetUpdateHandle::Implementation::convert(
     labels);
   const auto new_request = std::make_shared<rmf_task::Request>(
     std::move(booking),
-    deserialized_task.description);
+    std::move(description));
+
+  if (const auto backup = task_queue_backup)
+  {
+    // Pin down the times that may have been filled in from the clock so that
+    // a restored task keeps the same booking.
+    const auto to_millis = [](rmf_traffic::Time t)
+      {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+          t.time_since_epoch()).count();
+      };
+
+    auto recorded = request_msg;
+    recorded["unix_millis_earliest_start_time"] =
+      to_millis(earliest_start_time);
+    recorded["unix_millis_request_time"] = to_millis(request_time);
+    backup->record(task_id, recorded);
+  }
 
   return new_request;
 }
@@ -316,20 +374,66 @@ public:
   template<typename Subscriber>
   void operator()(const Subscriber& s)
   {
+    auto trace = rmf_traffic_ros2::tracing::Span::begin(
+      "allocate_tasks", trace_key);
     std::vector<std::string> errors;
-    auto assignments = run(errors);
+    auto assignments = bid_deadline.has_value() ?
+      run_anytime(errors) : run(errors);
+    trace.arg("feasible", assignments.has_value() ? "true" : "false").end();
     s.on_next(Result{std::move(assignments), std::move(errors)});
     s.on_completed();
   }
 
+  /// Find a greedy assignment first, and then use whatever time is left
+  /// before bid_deadline to search for a better one. If the better search
+  /// does not finish in time, the greedy assignment is used, so a bid can
+  /// always be submitted before the auction closes.
+  std::optional<TaskAssignments> run_anytime(std::vector<std::string>& errors)
+  {
+    const auto base = options.value_or(task_planner.default_options());
+
+    auto greedy = base;
+    greedy.greedy(true);
+    options = greedy;
+    auto best = run(errors);
+    if (!best.has_value() || base.greedy())
+      return best;
+
+    const auto deadline = *bid_deadline;
+    if (std::chrono::steady_clock::now() >= deadline)
+      return best;
+
+    auto improve = base;
+    improve.interrupter(
+      [deadline, interrupter = base.interrupter()]()
+      {
+        return std::chrono::steady_clock::now() >= deadline
+        || (interrupter && interrupter());
+      });
+    options = std::move(improve);
+
+    std::vector<std::string> improve_errors;
+    auto improved = run(improve_errors);
+    if (improved.has_value())
+      return improved;
+
+    RCLCPP_INFO(
+      node->get_logger(),
+      "Using the greedy task assignment for this bid because a better one was "
+      "not found before the bid deadline");
+    return best;
+  }
+
   std::optional<TaskAssignments> run(std::vector<std::string>& errors)
   {
     std::string id = "";
 
-    if (new_request)
+    for (const auto& new_request : new_requests)
     {
-      expect.pending_requests.push_back(new_request);
-      id = new_request->booking()->id();
+      if (!id.empty())
+        id += ", ";
+
+      id += new_request->booking()->id();
     }
 
     RCLCPP_INFO(
@@ -338,7 +442,10 @@ public:
       expect.states.size(),
       expect.pending_requests.size());
 
-    std::unordered_map<std::size_t, RobotContextPtr> robot_indexes;
+    // Nothing from an earlier run is still using the scratch memory
+    scratch.release();
+    std::pmr::unordered_map<std::size_t, RobotContextPtr> robot_indexes(
+      &scratch);
     std::vector<rmf_task::State> states;
     for (const auto& [context, state] : expect.states)
     {
@@ -346,8 +453,20 @@ public:
       states.push_back(state);
     }
 
+    if (threads > 1 && !warmed_up)
+    {
+      warm_up_estimates(states);
+      warmed_up = true;
+    }
+
     // Generate new task assignments
-    const auto result = task_planner.plan(
+    const auto result = options.has_value() ?
+      task_planner.plan(
+      rmf_traffic_ros2::convert(node->now()),
+      states,
+      expect.pending_requests,
+      *options) :
+      task_planner.plan(
       rmf_traffic_ros2::convert(node->now()),
       states,
       expect.pending_requests);
@@ -437,28 +556,130 @@ public:
   };
 
   AllocateTasks(
-    rmf_task::ConstRequestPtr new_request_,
+    std::vector<rmf_task::ConstRequestPtr> new_requests_,
     Expectations expect_,
     rmf_task::TaskPlanner task_planner_,
     std::shared_ptr<Node> node_)
-  : new_request(std::move(new_request_)),
+  : new_requests(std::move(new_requests_)),
     expect(std::move(expect_)),
     task_planner(std::move(task_planner_)),
     node(std::move(node_))
   {
-    // Do nothing
+    expect.pending_requests.insert(
+      expect.pending_requests.end(), new_requests.begin(), new_requests.end());
   }
 
-  rmf_task::ConstRequestPtr new_request;
+  std::vector<rmf_task::ConstRequestPtr> new_requests;
   Expectations expect;
   rmf_task::TaskPlanner task_planner;
   std::shared_ptr<Node> node;
+
+  // Plan with these options instead of the default options of the planner
+  std::optional<rmf_task::TaskPlanner::Options> options;
+
+  // How many threads may be used to evaluate requests for each robot before
+  // the task planner runs
+  std::size_t threads = 1;
+  bool warmed_up = false;
+
+  // If this is set, plan greedily first and then improve on that until this
+  // time, as long as the planner is not already set to be greedy
+  std::optional<std::chrono::steady_clock::time_point> bid_deadline;
+
+  // The task ID that the time spent on this allocation is traced under
+  std::string trace_key;
+
+  // Bookkeeping that only lives while the allocation runs is taken from this
+  // arena, which is released all at once instead of freeing each piece, so a
+  // long stream of bids does not fragment the heap that the rest of the
+  // adapter shares. The task planner allocates its own states and
+  // assignments, and those outlive the bid when it wins, so they do not use
+  // it. Only the thread running the allocation may use it.
+  mutable std::pmr::monotonic_buffer_resource scratch{ScratchBytes};
+  static constexpr std::size_t ScratchBytes = 16*1024;
+
+  /// Estimate every pending request from the expected state of every robot,
+  /// spread across the allocation threads. This is the first step of the
+  /// greedy insertion that the task planner does one robot at a time. It does
+  /// not change the outcome of planning, but it fills the shared planner cache
+  /// with the routes that the task planner is about to ask for, so those
+  /// searches run in parallel instead of one after another.
+  void warm_up_estimates(const std::vector<rmf_task::State>& states) const
+  {
+    const auto& pending = expect.pending_requests;
+    if (pending.empty() || states.empty())
+      return;
+
+    const auto& config = task_planner.configuration();
+    const auto& parameters = config.parameters();
+    const auto& constraints = config.constraints();
+
+    std::pmr::vector<rmf_task::Task::ConstModelPtr> models(&scratch);
+    models.reserve(pending.size());
+    for (const auto& request : pending)
+    {
+      models.push_back(
+        request->description()->make_model(
+          request->booking()->earliest_start_time(),
+          parameters));
+    }
+
+    std::function<bool()> interrupter;
+    if (options.has_value())
+      interrupter = options->interrupter();
+
+    const std::size_t total = models.size() * states.size();
+    std::atomic_size_t next = 0;
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    const auto evaluate = [&]()
+      {
+        try
+        {
+          rmf_task::TravelEstimator estimator(parameters);
+          for (std::size_t i = next++; i < total; i = next++)
+          {
+            if (interrupter && interrupter())
+              return;
+
+            models[i % models.size()]->estimate_finish(
+              states[i / models.size()], constraints, estimator);
+          }
+        }
+        catch (...)
+        {
+          // An exception must not escape a helper thread, so keep the first
+          // one for the caller and stop handing out work.
+          next = total;
+          std::lock_guard<std::mutex> lock(error_mutex);
+          if (!error)
+            error = std::current_exception();
+        }
+      };
+
+    // These threads are spawned here instead of being scheduled as jobs
+    // because this allocation is itself running as a job. Waiting on other
+    // jobs from inside it could deadlock when every job thread is busy.
+    std::vector<std::thread> helpers;
+    const std::size_t num_helpers = std::min(threads, total) - 1;
+    helpers.reserve(num_helpers);
+    for (std::size_t i = 0; i < num_helpers; ++i)
+      helpers.emplace_back(evaluate);
+
+    evaluate();
+    for (auto& helper : helpers)
+      helper.join();
+
+    if (error)
+      std::rethrow_exception(error);
+  }
 };
 
 //==============================================================================
 void FleetUpdateHandle::Implementation::bid_notice_cb(
   const BidNoticeMsg& bid_notice,
-  rmf_task_ros2::bidding::AsyncBidder::Respond respond)
+  rmf_task_ros2::bidding::AsyncBidder::Respond respond,
+  rmf_task_ros2::bidding::AsyncBidder::IsCancelled is_cancelled)
 {
   // TODO(YV): Consider moving these checks into convert()
   const auto& task_id = bid_notice.task_id;
@@ -469,7 +690,9 @@ void FleetUpdateHandle::Implementation::bid_notice_cb(
       "Fleet [%s] does not have any robots to accept task [%s]. Use "
       "FleetUpdateHandle::add_robot(~) to add robots to this fleet. ",
       name.c_str(), task_id.c_str());
-    return;
+
+    // Decline explicitly so the auctioneer does not need to wait for us
+    return respond({std::nullopt, {}});
   }
 
   if (task_id.empty())
@@ -493,10 +716,69 @@ void FleetUpdateHandle::Implementation::bid_notice_cb(
       "Use FleetUpdateHandle::set_task_planner_params(~) to set the "
       "parameters required.", name.c_str());
 
-    return;
+    return respond({std::nullopt, {}});
+  }
+
+  std::vector<std::string> errors = {};
+  std::vector<rmf_task::ConstRequestPtr> requests;
+  const auto batch = rmf_task_ros2::bidding::read_batched_notice(bid_notice);
+  if (batch.has_value())
+  {
+    // The winner of a batch takes every task in it, so we can only bid if we
+    // are able to perform all of them.
+    for (const auto& task : *batch)
+    {
+      auto request = convert_bid_request(task.task_id, task.request, errors);
+      if (!request)
+        return respond({std::nullopt, errors});
+
+      requests.push_back(std::move(request));
+    }
+  }
+  else
+  {
+    auto request = convert_bid_request(task_id, bid_notice.request, errors);
+    if (!request)
+      return respond({std::nullopt, errors});
+
+    requests.push_back(std::move(request));
   }
 
-  const auto request_msg = nlohmann::json::parse(bid_notice.request);
+  worker.schedule(
+    [
+      w = weak_self,
+      bid = PendingBid{task_id, std::move(requests), respond,
+        bid_notice.dry_run, std::move(is_cancelled),
+        bid_deadline(bid_notice)}
+    ](const auto&)
+    {
+      if (const auto self = w.lock())
+        self->_pimpl->queue_bid(bid);
+    });
+}
+
+//==============================================================================
+std::chrono::steady_clock::time_point
+FleetUpdateHandle::Implementation::bid_deadline(const BidNoticeMsg& notice)
+{
+  // Leave some of the auction's time window for the response to reach the
+  // auctioneer
+  const auto time_window = rclcpp::Duration(notice.time_window)
+    .to_chrono<std::chrono::nanoseconds>();
+  const auto margin = std::min<std::chrono::nanoseconds>(
+    BidResponseMargin, time_window / 4);
+
+  return std::chrono::steady_clock::now() + time_window - margin;
+}
+
+//==============================================================================
+rmf_task::ConstRequestPtr
+FleetUpdateHandle::Implementation::convert_bid_request(
+  const std::string& task_id,
+  const std::string& request,
+  std::vector<std::string>& errors) const
+{
+  const auto request_msg = nlohmann::json::parse(request);
   static const auto request_validator =
     nlohmann::json_schema::json_validator(
     rmf_api_msgs::schemas::task_request);
@@ -513,11 +795,8 @@ void FleetUpdateHandle::Implementation::bid_notice_cb(
       e.what(),
       request_msg.dump(2, ' ').c_str());
 
-    return respond(
-      {
-        std::nullopt,
-        {make_error_str(5, "Invalid request format", e.what())}
-      });
+    errors.push_back(make_error_str(5, "Invalid request format", e.what()));
+    return nullptr;
   }
 
   // If a fleet_name was specified in the request, only proceed if the value matches
@@ -529,34 +808,133 @@ void FleetUpdateHandle::Implementation::bid_notice_cb(
       node->get_logger(),
       "Ignoring BidNotice request as it is for fleet [%s].",
       request_msg["fleet_name"].template get<std::string>().c_str());
+    return nullptr;
+  }
+
+  return convert(task_id, request_msg, errors);
+}
+
+//==============================================================================
+void FleetUpdateHandle::Implementation::queue_bid(PendingBid bid)
+{
+  if (calculating_bids.count(bid.task_id) > 0)
     return;
+
+  for (const auto& pending : pending_bids)
+  {
+    if (pending.task_id == bid.task_id)
+      return;
   }
 
-  std::vector<std::string> errors = {};
-  const auto new_request = convert(task_id, request_msg, errors);
-  if (!new_request)
+  if (pending_bids.size() >= MaxPendingBids)
+  {
+    RCLCPP_WARN(
+      node->get_logger(),
+      "Fleet [%s] is not bidding on task [%s] because %lu bids are already "
+      "waiting to be calculated",
+      name.c_str(),
+      bid.task_id.c_str(),
+      pending_bids.size());
+
+    return bid.respond(
+      {
+        std::nullopt,
+        {make_error_str(
+            9, "Not feasible",
+            "Fleet [" + name + "] has too many bids waiting to be calculated")}
+      });
+  }
+
+  pending_bids.push_back(std::move(bid));
+  start_pending_bids();
+}
+
+//==============================================================================
+void FleetUpdateHandle::Implementation::start_pending_bids()
+{
+  const std::size_t slots = std::max<std::size_t>(1, max_concurrent_bids);
+  while (!pending_bids.empty() && calculating_bids.size() < slots)
+  {
+    auto bid = std::move(pending_bids.front());
+    pending_bids.pop_front();
+
+    // The auction for this bid closed while it was waiting
+    if (bid.is_cancelled && bid.is_cancelled())
+    {
+      RCLCPP_DEBUG(
+        node->get_logger(),
+        "Fleet [%s] is skipping the bid for task [%s] because its auction has "
+        "closed",
+        name.c_str(),
+        bid.task_id.c_str());
+      continue;
+    }
+
+    start_bid_calculation(std::move(bid));
+  }
+}
+
+//==============================================================================
+void FleetUpdateHandle::Implementation::start_bid_calculation(PendingBid bid)
+{
+  if (!task_planner)
   {
-    return respond(
+    return bid.respond(
       {
         std::nullopt,
-        errors
+        {make_error_str(
+            9, "Not feasible",
+            "Fleet [" + name + "] is not configured for task planning")}
       });
   }
 
-  calculate_bid = std::make_shared<AllocateTasks>(
-    new_request,
+  // Each bid is calculated against the assignments that are in effect when
+  // its calculation starts. Bids that are still being calculated do not
+  // affect each other, just like bids that have been submitted but not
+  // awarded.
+  auto job = std::make_shared<AllocateTasks>(
+    bid.requests,
     aggregate_expectations(),
     *task_planner,
     node);
+  job->threads = allocation_threads;
+  job->bid_deadline = bid.deadline;
+  job->trace_key = bid.task_id;
+
+  // Stop planning as soon as the auction has no more use for this bid
+  if (bid.is_cancelled)
+  {
+    auto options = task_planner->default_options();
+    options.interrupter(bid.is_cancelled);
+    job->options = std::move(options);
+  }
 
   auto receive_allocation =
-    [w = weak_self, respond, task_id, dry_run = bid_notice.dry_run](
-    AllocateTasks::Result result)
+    [
+      w = weak_self,
+      respond = bid.respond,
+      task_id = bid.task_id,
+      requests = bid.requests,
+      dry_run = bid.dry_run
+    ](AllocateTasks::Result result)
     {
       const auto self = w.lock();
       if (!self)
         return;
 
+      // Free up this slot once we are done here, without tearing down the
+      // subscription that is currently calling us.
+      self->_pimpl->worker.schedule(
+        [w, task_id](const auto&)
+        {
+          const auto fleet = w.lock();
+          if (!fleet)
+            return;
+
+          fleet->_pimpl->calculating_bids.erase(task_id);
+          fleet->_pimpl->start_pending_bids();
+        });
+
       auto allocation_result = result.assignments;
       if (!allocation_result.has_value())
         return respond({std::nullopt, std::move(result.errors)});
@@ -565,55 +943,75 @@ void FleetUpdateHandle::Implementation::bid_notice_cb(
 
       const double cost = self->_pimpl->compute_cost(assignments);
 
-      // Display computed assignments for debugging
-      std::stringstream debug_stream;
-      debug_stream << "Cost: " << cost << std::endl;
-      for (const auto& [context, queue] : assignments)
+      // Display computed assignments for debugging. Formatting them allocates
+      // for every assignment, so skip it unless someone will see it.
+      const auto& logger = self->_pimpl->node->get_logger();
+      if (rcutils_logging_logger_is_enabled_for(
+          logger.get_name(), RCUTILS_LOG_SEVERITY_DEBUG))
       {
-        debug_stream << "--Agent: " << context->requester_id() << std::endl;
-        for (const auto& a : queue)
+        std::stringstream debug_stream;
+        debug_stream << "Cost: " << cost << std::endl;
+        for (const auto& [context, queue] : assignments)
         {
-          const auto& s = a.finish_state();
-          const double request_seconds =
-            a.request()->booking()->earliest_start_time().time_since_epoch().
-            count()
-            /1e9;
-          const double start_seconds =
-            a.deployment_time().time_since_epoch().count()/1e9;
-          const rmf_traffic::Time finish_time = s.time().value();
-          const double finish_seconds = finish_time.time_since_epoch().count()/
-            1e9;
-          debug_stream << "    <" << a.request()->booking()->id() << ": " <<
-            request_seconds
-                       << ", " << start_seconds
-                       << ", "<< finish_seconds << ", " <<
-            s.battery_soc().value()
-                       << "%>" << std::endl;
+          debug_stream << "--Agent: " << context->requester_id() << std::endl;
+          for (const auto& a : queue)
+          {
+            const auto& s = a.finish_state();
+            const double request_seconds =
+              a.request()->booking()->earliest_start_time().time_since_epoch().
+              count()
+              /1e9;
+            const double start_seconds =
+              a.deployment_time().time_since_epoch().count()/1e9;
+            const rmf_traffic::Time finish_time = s.time().value();
+            const double finish_seconds =
+              finish_time.time_since_epoch().count()/1e9;
+            debug_stream << "    <" << a.request()->booking()->id() << ": " <<
+              request_seconds
+                         << ", " << start_seconds
+                         << ", "<< finish_seconds << ", " <<
+              s.battery_soc().value()
+                         << "%>" << std::endl;
+          }
         }
-      }
-      debug_stream << " ----------------------" << std::endl;
+        debug_stream << " ----------------------" << std::endl;
 
-      RCLCPP_DEBUG(
-        self->_pimpl->node->get_logger(),
-        "%s",
-        debug_stream.str().c_str());
+        RCLCPP_DEBUG(logger, "%s", debug_stream.str().c_str());
+      }
 
+      // A batch is proposed as a whole. Its expected robot is the one that
+      // takes the first task, and it finishes when its last task finishes.
       std::optional<std::string> robot_name;
       std::optional<rmf_traffic::Time> finish_time;
-      for (const auto& [context, queue] : assignments)
+      std::size_t found = 0;
+      for (std::size_t i = 0; i < requests.size(); ++i)
       {
-        for (const auto& assignment : queue)
+        const auto& id = requests[i]->booking()->id();
+        for (const auto& [context, queue] : assignments)
         {
-          if (assignment.request()->booking()->id() == task_id)
-          {
-            finish_time = assignment.finish_state().time().value();
+          const auto a_it = std::find_if(
+            queue.begin(), queue.end(), [&id](const auto& assignment)
+            {
+              return assignment.request()->booking()->id() == id;
+            });
+
+          if (a_it == queue.end())
+            continue;
+
+          const auto t = a_it->finish_state().time().value();
+          if (!finish_time.has_value() || *finish_time < t)
+            finish_time = t;
+
+          if (i == 0)
             robot_name = context->name();
-            break;
-          }
+
+          ++found;
+          break;
         }
       }
 
-      if (!robot_name.has_value() || !finish_time.has_value())
+      if (!robot_name.has_value() || !finish_time.has_value()
+        || found < requests.size())
       {
         result.errors.push_back(
           make_error_str(
@@ -649,12 +1047,23 @@ void FleetUpdateHandle::Implementation::bid_notice_cb(
         return;
       }
 
-      // Store assignments in internal map
-      self->_pimpl->bid_notice_assignments.insert({task_id, assignments});
+      // Store assignments in internal map. Every task of a batch is awarded
+      // separately, so each of them keeps the assignments of the batch.
+      for (const auto& request : requests)
+      {
+        const auto& id = request->booking()->id();
+        if (self->_pimpl->bid_notice_assignments.insert({id, assignments})
+          .second && self->_pimpl->max_bid_assignments.has_value())
+        {
+          self->_pimpl->bid_notice_order.push_back(id);
+        }
+      }
+      self->_pimpl->trim_bid_notice_assignments();
     };
 
-  calculate_bid_subscription = rmf_rxcpp::make_job<AllocateTasks::Result>(
-    calculate_bid)
+  auto& calculation = calculating_bids[bid.task_id];
+  calculation.job = job;
+  calculation.subscription = rmf_rxcpp::make_job<AllocateTasks::Result>(job)
     .observe_on(rxcpp::identity_same_worker(worker))
     .subscribe(receive_allocation);
 }
@@ -677,7 +1086,17 @@ void FleetUpdateHandle::Implementation::dispatch_command_cb(
   dispatch_ack.dispatch_id = msg->dispatch_id;
   if (msg->type == DispatchCmdMsg::TYPE_AWARD)
   {
+    rmf_traffic_ros2::tracing::instant("award_received", task_id);
     last_bid_assignment = task_id;
+    if (assigned_with_batch.erase(task_id) > 0)
+    {
+      // This task was already given to a robot together with another task
+      // from the same batch.
+      dispatch_ack.success = true;
+      dispatch_ack_pub->publish(dispatch_ack);
+      return;
+    }
+
     const auto task_it = bid_notice_assignments.find(task_id);
     if (task_it == bid_notice_assignments.end())
     {
@@ -827,6 +1246,18 @@ void FleetUpdateHandle::Implementation::dispatch_command_cb(
         context->task_manager()->set_queue(queue);
       }
 
+      // Any other tasks from the same batch were assigned just now as well,
+      // so their awards will only need to be acknowledged.
+      for (const auto& [_, queue] : assignments)
+      {
+        for (const auto& a : queue)
+        {
+          const auto& id = a.request()->booking()->id();
+          if (id != task_id && bid_notice_assignments.erase(id) > 0)
+            assigned_with_batch.insert(id);
+        }
+      }
+
       // Any unassigned requests would have been collected by the aggregator and
       // given an assignment while calculating this bid. As long as
       // is_valid_assignments was able to pass, then all tasks have been
@@ -845,6 +1276,7 @@ void FleetUpdateHandle::Implementation::dispatch_command_cb(
   }
   else if (msg->type == DispatchCmdMsg::TYPE_REMOVE)
   {
+    assigned_with_batch.erase(task_id);
     const auto bid_it = bid_notice_assignments.find(task_id);
     if (bid_it != bid_notice_assignments.end())
     {
@@ -856,12 +1288,16 @@ void FleetUpdateHandle::Implementation::dispatch_command_cb(
     else
     {
       bool task_was_found = false;
+      RobotContextPtr affected_robot;
       // Make sure the task isn't running in any of the task managers
-      for (const auto& [_, tm] : task_managers)
+      for (const auto& [context, tm] : task_managers)
       {
         task_was_found = tm->cancel_task_if_present(task_id);
         if (task_was_found)
+        {
+          affected_robot = context;
           break;
+        }
       }
 
       if (task_was_found)
@@ -898,7 +1334,8 @@ void FleetUpdateHandle::Implementation::dispatch_command_cb(
             ss << "\n";
 
             RCLCPP_WARN(node->get_logger(), "%s", ss.str().c_str());
-          });
+          },
+          {affected_robot});
       }
     }
 
@@ -935,19 +1372,21 @@ auto FleetUpdateHandle::Implementation::is_valid_assignments(
   TaskAssignments& assignments,
   std::string* report_error) const -> bool
 {
-  std::unordered_set<std::string> executed_tasks;
-  for (const auto& [context, mgr] : task_managers)
-  {
-    const auto& tasks = mgr->get_executed_tasks();
-    executed_tasks.insert(tasks.begin(), tasks.end());
-  }
+  const auto already_executed = [&](const std::string& task_id)
+    {
+      for (const auto& [context, mgr] : task_managers)
+      {
+        if (mgr->has_executed_task(task_id))
+          return true;
+      }
+      return false;
+    };
 
   for (const auto& [context, queue] : assignments)
   {
     for (const auto& a : queue)
     {
-      if (executed_tasks.find(a.request()->booking()->id()) !=
-        executed_tasks.end())
+      if (already_executed(a.request()->booking()->id()))
       {
         if (report_error)
         {
@@ -992,9 +1431,13 @@ auto FleetUpdateHandle::Implementation::is_valid_assignments(
 //==============================================================================
 void FleetUpdateHandle::Implementation::reassign_dispatched_tasks(
   std::function<void()> on_success,
-  std::function<void(std::vector<std::string>)> on_failure)
+  std::function<void(std::vector<std::string>)> on_failure,
+  std::vector<RobotContextPtr> affected_robots)
 {
-  auto expectations = aggregate_expectations();
+  const bool incremental = incremental_reassignment_robots.has_value();
+  auto expectations = incremental ?
+    incremental_expectations(affected_robots) : aggregate_expectations();
+
   if (expectations.states.empty() && !expectations.pending_requests.empty())
   {
     // If there are no robots that can perform any tasks but there are pending
@@ -1007,9 +1450,32 @@ void FleetUpdateHandle::Implementation::reassign_dispatched_tasks(
     return;
   }
 
+  if (expectations.states.empty())
+  {
+    // Nothing is affected, so there is nothing to reassign
+    worker.schedule([on_success](const auto&) { on_success(); });
+    return;
+  }
+
+  std::optional<rmf_traffic::Duration> time_budget;
+  if (incremental)
+  {
+    time_budget = incremental_reassignment_budget;
+    RCLCPP_INFO(
+      node->get_logger(),
+      "Incrementally reassigning [%lu] request(s) among [%lu] of the [%lu] "
+      "robot(s) in fleet [%s]",
+      expectations.pending_requests.size(),
+      expectations.states.size(),
+      task_managers.size(),
+      name.c_str());
+  }
+
   auto on_plan_received = [
     on_success,
     on_failure,
+    affected_robots,
+    incremental,
     w = weak_self,
     initial_last_bid_assignment = last_bid_assignment
     ](TaskAssignments assignments)
@@ -1047,7 +1513,8 @@ void FleetUpdateHandle::Implementation::reassign_dispatched_tasks(
             error.c_str());
         }
 
-        self->_pimpl->reassign_dispatched_tasks(on_success, on_failure);
+        self->_pimpl->reassign_dispatched_tasks(
+          on_success, on_failure, affected_robots);
         return;
       }
 
@@ -1056,6 +1523,17 @@ void FleetUpdateHandle::Implementation::reassign_dispatched_tasks(
         context->task_manager()->set_queue(queue);
       }
 
+      if (incremental)
+      {
+        // The robots that were left out keep their queues, and they still
+        // count towards the cost of the fleet.
+        for (const auto& [context, mgr] : self->_pimpl->task_managers)
+        {
+          if (assignments.count(context) == 0)
+            assignments[context] = mgr->get_queue();
+        }
+      }
+
       // All requests should be assigned now, no matter which robot they were
       // originally assigned to, so we can clear this buffer.
       //
@@ -1076,14 +1554,44 @@ void FleetUpdateHandle::Implementation::reassign_dispatched_tasks(
       on_failure,
       expectations = std::move(expectations),
       task_planner = *task_planner,
+      time_budget,
+      threads = allocation_threads,
       node = node,
       worker = worker
     ](const auto&)
     {
       std::vector<std::string> errors;
-      const auto replan_results = AllocateTasks(
-        nullptr, expectations, task_planner, node)
-      .run(errors);
+      AllocateTasks allocate({}, expectations, task_planner, node);
+      allocate.threads = threads;
+      if (time_budget.has_value())
+      {
+        const auto deadline = std::chrono::steady_clock::now() + *time_budget;
+        auto options = task_planner.default_options();
+        options.interrupter(
+          [deadline]()
+          {
+            return std::chrono::steady_clock::now() >= deadline;
+          });
+        allocate.options = std::move(options);
+      }
+
+      auto replan_results = allocate.run(errors);
+      if (!replan_results.has_value() && time_budget.has_value())
+      {
+        // The optimal search ran out of time, so settle for the greedy
+        // assignment of the same robots.
+        RCLCPP_WARN(
+          node->get_logger(),
+          "Incremental task reassignment ran out of time. Falling back to a "
+          "greedy assignment.");
+
+        errors.clear();
+        auto options = task_planner.default_options();
+        options.greedy(true);
+        options.interrupter(nullptr);
+        allocate.options = std::move(options);
+        replan_results = allocate.run(errors);
+      }
 
       if (replan_results.has_value())
       {
@@ -1115,20 +1623,53 @@ get_nearest_charger(
   if (charging_waypoints.empty())
     return std::nullopt;
 
+  // Chargers that no robot is assigned to yet are preferred, so that robots
+  // which are added near each other do not all end up sharing one charger.
   double min_cost = std::numeric_limits<double>::max();
+  double min_free_cost = std::numeric_limits<double>::max();
   std::optional<std::size_t> nearest_charger = std::nullopt;
+  std::optional<std::size_t> nearest_free_charger = std::nullopt;
+  // The table only knows about starts that are exactly on a waypoint, and
+  // only about the planner that it was made for.
+  const auto* table = travel_time_table.get();
+  if (table && table->planner() != *planner)
+    table = nullptr;
+
+  if (start.lane().has_value() || start.location().has_value())
+    table = nullptr;
+
   for (const auto& wp : charging_waypoints)
   {
-    const rmf_traffic::agv::Planner::Goal goal{wp};
-    const auto& planner_result = (*planner)->setup(start, goal);
-    const auto ideal_cost = planner_result.ideal_cost();
-    if (ideal_cost.has_value() && ideal_cost.value() < min_cost)
+    std::optional<double> ideal_cost;
+    if (table)
+      ideal_cost = table->get(start.waypoint(), wp);
+
+    if (!ideal_cost.has_value())
+    {
+      const rmf_traffic::agv::Planner::Goal goal{wp};
+      ideal_cost = (*planner)->setup(start, goal).ideal_cost();
+    }
+
+    if (!ideal_cost.has_value())
+      continue;
+
+    if (ideal_cost.value() < min_cost)
     {
       min_cost = ideal_cost.value();
       nearest_charger = wp;
     }
+
+    if (ideal_cost.value() < min_free_cost
+      && charger_occupancy->assigned(wp) == 0)
+    {
+      min_free_cost = ideal_cost.value();
+      nearest_free_charger = wp;
+    }
   }
 
+  if (nearest_free_charger.has_value())
+    return nearest_free_charger;
+
   return nearest_charger;
 }
 
@@ -1212,30 +1753,257 @@ std::optional<rmf_fleet_msgs::msg::RobotState> convert_state(
 //==============================================================================
 void FleetUpdateHandle::Implementation::publish_fleet_state_topic() const
 {
-  std::vector<rmf_fleet_msgs::msg::RobotState> robot_states;
+  const bool adaptive =
+    idle_state_period.has_value() || charging_state_period.has_value();
+  const auto now = std::chrono::steady_clock::now();
+
+  // Decide which robots need a fresh state. If none of them do, then nothing
+  // would be different about this message, so skip it.
+  std::vector<bool> refresh;
+  refresh.reserve(task_managers.size());
+  bool any_refresh = !adaptive;
   for (const auto& [context, mgr] : task_managers)
   {
-    auto state = convert_state(*mgr);
-    if (!state.has_value())
-      continue;
+    bool due = true;
+    if (adaptive)
+    {
+      const auto period = refresh_period(*mgr);
+      const auto r_it = robot_state_refresh.find(context->name());
+      due = !period.has_value() || r_it == robot_state_refresh.end()
+        || !r_it->second.topic_time.has_value()
+        || *r_it->second.topic_time + *period <= now;
+    }
 
-    robot_states.emplace_back(std::move(*state));
+    refresh.push_back(due);
+    any_refresh |= due;
   }
 
-  auto fleet_state = rmf_fleet_msgs::build<rmf_fleet_msgs::msg::FleetState>()
-    .name(name)
-    .robots(std::move(robot_states));
+  if (!any_refresh)
+    return;
+
+  publish_in_place<rmf_fleet_msgs::msg::FleetState>(
+    fleet_state_pub,
+    [&](rmf_fleet_msgs::msg::FleetState& fleet_state)
+    {
+      fleet_state.name = name;
+      fleet_state.robots.reserve(task_managers.size());
+      std::size_t i = 0;
+      for (const auto& [context, mgr] : task_managers)
+      {
+        if (!refresh[i++])
+        {
+          fleet_state.robots.push_back(
+            robot_state_refresh.at(context->name()).topic_state);
+          continue;
+        }
+
+        auto state = convert_state(*mgr);
+        if (!state.has_value())
+          continue;
+
+        if (adaptive)
+        {
+          auto& record = robot_state_refresh[context->name()];
+          record.topic_time = now;
+          record.topic_state = *state;
+        }
 
-  fleet_state_pub->publish(std::move(fleet_state));
+        fleet_state.robots.emplace_back(std::move(*state));
+      }
+    });
 }
 
 //==============================================================================
-void FleetUpdateHandle::Implementation::update_fleet() const
+std::optional<rmf_traffic::Duration>
+FleetUpdateHandle::Implementation::refresh_period(const TaskManager& mgr) const
+{
+  if (mgr.context()->current_lift_destination())
+    return std::nullopt;
+
+  const auto status = mgr.robot_status();
+  if (status == "idle")
+    return idle_state_period;
+
+  if (status == "charging")
+    return charging_state_period;
+
+  return std::nullopt;
+}
+
+//==============================================================================
+void FleetUpdateHandle::Implementation::trim_bid_notice_assignments()
+{
+  if (!max_bid_assignments.has_value())
+  {
+    bid_notice_order.clear();
+    return;
+  }
+
+  while (bid_notice_assignments.size() > *max_bid_assignments
+    && !bid_notice_order.empty())
+  {
+    // Bids that were never awarded or cancelled would otherwise stay forever
+    const auto& oldest = bid_notice_order.front();
+    if (bid_notice_assignments.erase(oldest) > 0)
+    {
+      RCLCPP_INFO(
+        node->get_logger(),
+        "Forgetting the assignments of the bid for task [%s] of fleet [%s] "
+        "because more than %zu bids are waiting to be awarded",
+        oldest.c_str(),
+        name.c_str(),
+        *max_bid_assignments);
+    }
+    bid_notice_order.pop_front();
+  }
+
+  // Forget the tasks that were awarded or cancelled in the meantime
+  if (bid_notice_order.size() > 2 * bid_notice_assignments.size())
+  {
+    const auto remove_it = std::remove_if(
+      bid_notice_order.begin(), bid_notice_order.end(),
+      [&](const std::string& id)
+      {
+        return bid_notice_assignments.count(id) == 0;
+      });
+    bid_notice_order.erase(remove_it, bid_notice_order.end());
+  }
+}
+
+//==============================================================================
+void FleetUpdateHandle::Implementation::report_memory_footprint() const
+{
+  std::size_t executed_tasks = 0;
+  std::size_t unsent_log_entries = 0;
+  for (const auto& [context, mgr] : task_managers)
+  {
+    executed_tasks += mgr->get_executed_tasks().size();
+    unsent_log_entries += context->reporting().unsent_size();
+  }
+
+  std::size_t schedule_routes = 0;
+  std::size_t schedule_participants = 0;
+  if (mirror)
+  {
+    const auto snapshot = mirror->snapshot();
+    schedule_participants = snapshot->participant_ids().size();
+    for (const auto& element :
+      snapshot->query(rmf_traffic::schedule::query_all()))
+    {
+      (void)element;
+      ++schedule_routes;
+    }
+  }
+
+  RCLCPP_INFO(
+    node->get_logger(),
+    "Memory footprint of fleet [%s]: %zu bid assignments waiting for an "
+    "award, %zu executed task IDs, %zu unsent log entries (%zu dropped so "
+    "far), %zu planners for closed lanes, %zu schedule routes of %zu "
+    "participants",
+    name.c_str(),
+    bid_notice_assignments.size(),
+    executed_tasks,
+    unsent_log_entries,
+    dropped_log_entries,
+    closure_planners.size(),
+    schedule_routes,
+    schedule_participants);
+}
+
+//==============================================================================
+void FleetUpdateHandle::Implementation::update_fleet() const
 {
   update_fleet_state();
   update_fleet_logs();
 }
 
+namespace {
+//==============================================================================
+RobotStateSummary summarize_robot_state(
+  const agv::RobotContext& context,
+  const TaskManager& mgr)
+{
+  RobotStateSummary summary;
+  summary.status = mgr.robot_status();
+  summary.task_id = mgr.current_task_id().value_or("");
+  summary.battery = context.current_battery_soc();
+
+  if (const auto l = convert_location(context))
+  {
+    summary.location =
+      RobotStateSummary::Location{l->level_name, l->x, l->y, l->yaw};
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(context.reporting().mutex());
+    for (const auto& issue : context.reporting().open_issues())
+      summary.issues.push_back(issue.get());
+  }
+  std::sort(summary.issues.begin(), summary.issues.end());
+
+  const auto& commission = context.commission();
+  summary.commission = {
+    commission.is_accepting_dispatched_tasks(),
+    commission.is_accepting_direct_tasks(),
+    commission.is_performing_idle_behavior()
+  };
+
+  for (const auto& g : context.locked_mutex_groups())
+    summary.locked_mutex_groups.push_back(g.first);
+  std::sort(
+    summary.locked_mutex_groups.begin(), summary.locked_mutex_groups.end());
+
+  for (const auto& g : context.requesting_mutex_groups())
+    summary.requesting_mutex_groups.push_back(g.first);
+  std::sort(
+    summary.requesting_mutex_groups.begin(),
+    summary.requesting_mutex_groups.end());
+
+  return summary;
+}
+
+//==============================================================================
+bool robot_state_changed(
+  const RobotStateSummary& previous,
+  const RobotStateSummary& current,
+  const FleetStateChangeDetection& detection)
+{
+  if (previous.status != current.status
+    || previous.task_id != current.task_id
+    || previous.issues != current.issues
+    || previous.commission != current.commission
+    || previous.locked_mutex_groups != current.locked_mutex_groups
+    || previous.requesting_mutex_groups != current.requesting_mutex_groups)
+  {
+    return true;
+  }
+
+  if (std::abs(previous.battery - current.battery)
+    > detection.battery_threshold)
+  {
+    return true;
+  }
+
+  if (previous.location.has_value() != current.location.has_value())
+    return true;
+
+  if (!current.location.has_value())
+    return false;
+
+  const auto& p = *previous.location;
+  const auto& c = *current.location;
+  if (p.map != c.map)
+    return true;
+
+  if (std::hypot(p.x - c.x, p.y - c.y) > detection.position_threshold)
+    return true;
+
+  return std::abs(rmf_utils::wrap_to_pi(p.yaw - c.yaw))
+    > detection.yaw_threshold;
+}
+} // anonymous namespace
+
 //==============================================================================
 void FleetUpdateHandle::Implementation::update_fleet_state() const
 {
@@ -1245,8 +2013,55 @@ void FleetUpdateHandle::Implementation::update_fleet_state() const
   fleet_state_msg["name"] = name;
   auto& robots = fleet_state_msg["robots"];
   robots = std::unordered_map<std::string, nlohmann::json>();
+
+  const auto& detection = fleet_state_change_detection;
+  const bool adaptive =
+    idle_state_period.has_value() || charging_state_period.has_value();
+  const auto refresh_time = std::chrono::steady_clock::now();
+  bool any_changes = !detection.has_value();
   for (const auto& [context, mgr] : task_managers)
   {
+    if (adaptive)
+    {
+      const auto period = refresh_period(*mgr);
+      const auto r_it = robot_state_refresh.find(context->name());
+      if (period.has_value() && r_it != robot_state_refresh.end()
+        && r_it->second.update_time.has_value()
+        && refresh_time < *r_it->second.update_time + *period)
+      {
+        // This robot is not doing anything that needs to be reported this
+        // often, so reuse its previous entry with a fresh timestamp. That
+        // does not count as a change.
+        nlohmann::json& json = robots[context->name()];
+        json = r_it->second.update_json;
+        json["unix_millis_time"] =
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+          context->now().time_since_epoch()).count();
+        continue;
+      }
+    }
+
+    if (detection.has_value())
+    {
+      auto summary = summarize_robot_state(*context, *mgr);
+      const auto r_it = robot_state_records.find(context->name());
+      if (r_it != robot_state_records.end()
+        && !robot_state_changed(r_it->second.summary, summary, *detection))
+      {
+        // Nothing worth reporting has changed, so reuse the previous entry
+        // with a fresh timestamp.
+        nlohmann::json& json = robots[context->name()];
+        json = r_it->second.json;
+        json["unix_millis_time"] =
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+          context->now().time_since_epoch()).count();
+        continue;
+      }
+
+      any_changes = true;
+      robot_state_records[context->name()].summary = std::move(summary);
+    }
+
     const auto& name = context->name();
     nlohmann::json& json = robots[name];
     json["name"] = name;
@@ -1305,27 +2120,59 @@ void FleetUpdateHandle::Implementation::update_fleet_state() const
     mutex_groups_json["requesting"] = std::move(requesting_mutex_groups);
 
     json["mutex_groups"] = std::move(mutex_groups_json);
+
+    if (detection.has_value())
+      robot_state_records[name].json = json;
+
+    if (adaptive)
+    {
+      auto& record = robot_state_refresh[name];
+      record.update_time = refresh_time;
+      record.update_json = json;
+    }
   }
 
-  try
+  // Forget about robots that have left the fleet
+  for (auto r_it = robot_state_refresh.begin();
+    r_it != robot_state_refresh.end(); )
   {
-    std::unique_lock<std::mutex> lock(*update_callback_mutex);
-    if (update_callback)
-      update_callback(fleet_state_update_msg);
+    if (robots.contains(r_it->first))
+      ++r_it;
+    else
+      r_it = robot_state_refresh.erase(r_it);
+  }
 
-    // Publish to API server
-    if (broadcast_client)
+  if (detection.has_value())
+  {
+    // Forget about robots that have left the fleet
+    for (auto r_it = robot_state_records.begin();
+      r_it != robot_state_records.end(); )
     {
-      static const auto validator =
-        make_validator(rmf_api_msgs::schemas::fleet_state_update);
-      validator.validate(fleet_state_update_msg);
+      if (robots.contains(r_it->first))
+      {
+        ++r_it;
+        continue;
+      }
 
-      broadcast_client->publish(fleet_state_update_msg);
+      r_it = robot_state_records.erase(r_it);
+      any_changes = true;
     }
 
-    FleetStateUpdateMsg update_msg;
-    update_msg.data = fleet_state_update_msg.dump();
-    fleet_state_update_pub->publish(update_msg);
+    const auto now = std::chrono::steady_clock::now();
+    const bool heartbeat_due = !last_fleet_state_update.has_value()
+      || *last_fleet_state_update + detection->heartbeat_period <= now;
+
+    if (!any_changes && !heartbeat_due)
+      return;
+
+    last_fleet_state_update = now;
+  }
+
+  try
+  {
+    std::unique_lock<std::mutex> lock(*update_callback_mutex);
+    if (update_callback)
+      update_callback(fleet_state_update_msg);
   }
   catch (const std::exception& e)
   {
@@ -1335,11 +2182,70 @@ void FleetUpdateHandle::Implementation::update_fleet_state() const
       e.what(),
       fleet_state_update_msg.dump(2).c_str());
   }
+
+  // Validating and serializing the message happens on the outbox thread
+  static const auto validator =
+    make_validator(rmf_api_msgs::schemas::fleet_state_update);
+
+  // Only the newest fleet state matters, so a state that is still waiting
+  // gets replaced instead of queuing up behind a slow server.
+  json_outbox->push_latest(
+    "fleet_state_update",
+    [
+      msg = std::move(fleet_state_update_msg),
+      validate = broadcast_client && outgoing_validation->sample(),
+      broadcast_client = broadcast_client,
+      pub = fleet_state_update_pub,
+      logger = node->get_logger()
+    ]()
+    {
+      try
+      {
+        // Publish to API server
+        if (broadcast_client)
+        {
+          if (validate)
+            validator.validate(msg);
+
+          broadcast_client->publish(msg);
+        }
+
+        FleetStateUpdateMsg update_msg;
+        update_msg.data = msg.dump();
+        pub->publish(update_msg);
+      }
+      catch (const std::exception& e)
+      {
+        RCLCPP_ERROR(
+          logger,
+          "Malformed outgoing fleet state json message: %s\nMessage:\n%s",
+          e.what(),
+          msg.dump(2).c_str());
+      }
+    });
 }
 
 //==============================================================================
 void FleetUpdateHandle::Implementation::update_fleet_logs() const
 {
+  // While the websocket server or the outbox is not keeping up, leave new log
+  // entries with the robots instead of building an update that would only be
+  // dropped or queued. They will all be sent once both have caught up.
+  if ((broadcast_client && broadcast_client->saturated())
+    || json_outbox->saturated())
+  {
+    if (max_unsent_log_entries.has_value())
+    {
+      for (const auto& [context, _] : task_managers)
+      {
+        dropped_log_entries +=
+          context->reporting().drop_oldest_unsent(*max_unsent_log_entries);
+      }
+    }
+
+    return;
+  }
+
   nlohmann::json fleet_log_update_msg;
   fleet_log_update_msg["type"] = "fleet_log_update";
   auto& fleet_log_msg = fleet_log_update_msg["data"];
@@ -1349,13 +2255,7 @@ void FleetUpdateHandle::Implementation::update_fleet_logs() const
   robots_msg = std::unordered_map<std::string, nlohmann::json>();
   for (const auto& [context, _] : task_managers)
   {
-    auto robot_log_msg_array = std::vector<nlohmann::json>();
-
-    std::lock_guard<std::mutex> lock(context->reporting().mutex());
-    const auto& log = context->reporting().log();
-    for (const auto& entry : log_reader.read(log.view()))
-      robot_log_msg_array.push_back(log_to_json(entry));
-
+    auto robot_log_msg_array = context->reporting().take_unsent();
     if (!robot_log_msg_array.empty())
       robots_msg[context->name()] = std::move(robot_log_msg_array);
   }
@@ -1368,23 +2268,9 @@ void FleetUpdateHandle::Implementation::update_fleet_logs() const
 
   try
   {
-    static const auto validator =
-      make_validator(rmf_api_msgs::schemas::fleet_log_update);
-
-    validator.validate(fleet_log_update_msg);
-
     std::unique_lock<std::mutex> lock(*update_callback_mutex);
     if (update_callback)
       update_callback(fleet_log_update_msg);
-
-    if (broadcast_client)
-    {
-      broadcast_client->publish(fleet_log_update_msg);
-    }
-
-    FleetLogUpdateMsg update_msg;
-    update_msg.data = fleet_log_update_msg.dump();
-    fleet_log_update_pub->publish(update_msg);
   }
   catch (const std::exception& e)
   {
@@ -1394,6 +2280,43 @@ void FleetUpdateHandle::Implementation::update_fleet_logs() const
       e.what(),
       fleet_log_update_msg.dump(2).c_str());
   }
+
+  // Validating and serializing the message happens on the outbox thread
+  static const auto validator =
+    make_validator(rmf_api_msgs::schemas::fleet_log_update);
+
+  json_outbox->push(
+    [
+      msg = std::move(fleet_log_update_msg),
+      validate = outgoing_validation->sample(),
+      broadcast_client = broadcast_client,
+      pub = fleet_log_update_pub,
+      logger = node->get_logger()
+    ]()
+    {
+      try
+      {
+        if (validate)
+          validator.validate(msg);
+
+        if (broadcast_client)
+        {
+          broadcast_client->publish(msg);
+        }
+
+        FleetLogUpdateMsg update_msg;
+        update_msg.data = msg.dump();
+        pub->publish(update_msg);
+      }
+      catch (const std::exception& e)
+      {
+        RCLCPP_ERROR(
+          logger,
+          "Malformed outgoing fleet log json message: %s\nMessage:\n%s",
+          e.what(),
+          msg.dump(2).c_str());
+      }
+    });
 }
 
 //==============================================================================
@@ -1404,8 +2327,11 @@ void FleetUpdateHandle::Implementation::handle_emergency(
     return;
 
   emergency_active = emergency_signal;
-  if (emergency_signal)
+  emergency_pullover_scheduler->clear_claims();
+  if (emergency_signal && !pullover_candidates)
   {
+    // When pullover candidates are being precomputed, the emergency planner
+    // is already up to date and its caches are warm.
     update_emergency_planner();
   }
 
@@ -1534,88 +2460,363 @@ void FleetUpdateHandle::Implementation::update_emergency_planner()
 }
 
 //==============================================================================
-void FleetUpdateHandle::Implementation::update_charging_assignments(
-  const ChargingAssignments& charging)
+void FleetUpdateHandle::Implementation::refresh_emergency_planner()
 {
-  if (charging.fleet_name != name)
+  if (!max_pullover_candidates.has_value())
+  {
+    pullover_candidates = nullptr;
+    if (emergency_active)
+      update_emergency_planner();
+  }
+  else
+  {
+    update_emergency_planner();
+    pullover_candidates = PulloverCandidates::make(
+      *emergency_planner, *max_pullover_candidates);
+  }
+
+  for (const auto& [context, _] : task_managers)
+    context->pullover_candidates(pullover_candidates);
+}
+
+//==============================================================================
+void FleetUpdateHandle::Implementation::update_travel_time_table()
+{
+  if (!precompute_travel_times)
+  {
+    travel_time_table = nullptr;
     return;
+  }
 
+  travel_time_table = TravelTimeTable::make(*planner);
   RCLCPP_INFO(
     node->get_logger(),
-    "Fleet [%s] received new charging assignments",
+    "Precomputing travel times between %lu waypoints for fleet [%s]",
+    travel_time_table->size(),
     name.c_str());
+}
 
-  for (const ChargingAssignment& assignment : charging.assignments)
+//==============================================================================
+void FleetUpdateHandle::Implementation::warm_up_goals()
+{
+  if (!goal_warmup)
+    return;
+
+  std::vector<std::size_t> starts;
+  for (const auto& [context, _] : task_managers)
   {
-    bool found_robot = false;
-    for (const auto& [context, _] : task_managers)
-    {
-      if (context->name() != assignment.robot_name)
-        continue;
+    for (const auto& l : context->location())
+      starts.push_back(l.waypoint());
+  }
 
-      const rmf_traffic::agv::Graph& graph = context->navigation_graph();
-      const auto wp = graph.find_waypoint(assignment.waypoint_name);
-      if (!wp)
-      {
-        RCLCPP_ERROR(
-          node->get_logger(),
-          "Cannot change charging waypoint for [%s] to [%s] because it does "
-          "not exist in the graph",
-          context->requester_id().c_str(),
-          assignment.waypoint_name.c_str());
-      }
-      const bool wait_for_charger = assignment.mode == assignment.MODE_WAIT;
-      context->_set_charging(wp->index(), wait_for_charger);
-    }
+  goal_warmup->warm_up(*planner, std::move(starts));
+}
 
-    if (!found_robot)
-    {
-      unregistered_charging_assignments[assignment.robot_name] = assignment;
-    }
-  }
+//==============================================================================
+void FleetUpdateHandle::Implementation::planner_changed()
+{
+  update_travel_time_table();
+  warm_up_goals();
 }
 
 //==============================================================================
-nlohmann::json_schema::json_validator
-FleetUpdateHandle::Implementation::make_validator(
-  const nlohmann::json& schema) const
+std::vector<std::size_t>
+FleetUpdateHandle::Implementation::sorted_closed_lanes() const
 {
-  const auto loader =
-    [n = node, s = schema_dictionary](const nlohmann::json_uri& id,
-      nlohmann::json& value)
-    {
-      const auto it = s.find(id.url());
-      if (it == s.end())
-      {
-        RCLCPP_ERROR(
-          n->get_logger(),
-          "url: %s not found in schema dictionary", id.url().c_str());
-        return;
-      }
+  std::vector<std::size_t> lanes(closed_lanes.begin(), closed_lanes.end());
+  std::sort(lanes.begin(), lanes.end());
+  return lanes;
+}
 
-      value = it->second;
+//==============================================================================
+bool FleetUpdateHandle::Implementation::reuse_closure_planner(
+  std::vector<std::size_t> previous_closed_lanes)
+{
+  if (max_closure_planners == 0)
+    return false;
+
+  const auto find = [&](const std::vector<std::size_t>& lanes)
+    {
+      return std::find_if(
+        closure_planners.begin(), closure_planners.end(),
+        [&](const ClosurePlanner& c) { return c.closed_lanes == lanes; });
     };
 
-  return nlohmann::json_schema::json_validator(schema, loader);
+  const auto previous_it = find(previous_closed_lanes);
+  if (previous_it != closure_planners.end())
+    closure_planners.erase(previous_it);
+
+  closure_planners.push_front(
+    ClosurePlanner{
+      std::move(previous_closed_lanes),
+      *planner,
+      travel_time_table
+    });
+
+  const auto current_it = find(sorted_closed_lanes());
+  const bool found = current_it != closure_planners.end();
+  if (found)
+  {
+    *planner = current_it->planner;
+    travel_time_table = current_it->travel_time_table;
+    closure_planners.erase(current_it);
+    if (!precompute_travel_times)
+      travel_time_table = nullptr;
+    else if (!travel_time_table)
+      update_travel_time_table();
+  }
+
+  while (closure_planners.size() > max_closure_planners)
+    closure_planners.pop_back();
+
+  return found;
 }
 
-namespace {
 //==============================================================================
-PlaceDeserializer make_place_deserializer(
-  std::shared_ptr<const std::shared_ptr<const rmf_traffic::agv::Planner>>
-  planner)
+void FleetUpdateHandle::Implementation::update_charging_assignments(
+  const ChargingAssignments& charging)
 {
-  return [planner = std::move(planner)](const nlohmann::json& msg)
-    -> DeserializedPlace
+  if (charging.fleet_name != name)
+    return;
+
+  std::size_t changed = 0;
+  std::vector<std::pair<RobotContextPtr, const ChargingAssignment*>>
+  now_charging;
+  for (const ChargingAssignment& assignment : charging.assignments)
+  {
+    const auto r_it = robots_by_name.find(assignment.robot_name);
+    if (r_it == robots_by_name.end())
     {
-      std::optional<rmf_traffic::agv::Plan::Goal> place;
-      const auto& graph = (*planner)->get_configuration().graph();
-      if (msg.is_number() || (msg.is_object() && msg["waypoint"].is_number()))
-      {
-        const auto wp_index = msg.is_number() ?
-          msg.get<std::size_t>() : msg["waypoint"].get<std::size_t>();
+      unregistered_charging_assignments[assignment.robot_name] = assignment;
+      continue;
+    }
 
-        if (graph.num_waypoints() <= wp_index)
+    const auto& context = r_it->second;
+    const rmf_traffic::agv::Graph& graph = context->navigation_graph();
+    const auto wp = graph.find_waypoint(assignment.waypoint_name);
+    if (!wp)
+    {
+      RCLCPP_ERROR(
+        node->get_logger(),
+        "Cannot change charging waypoint for [%s] to [%s] because it does "
+        "not exist in the graph",
+        context->requester_id().c_str(),
+        assignment.waypoint_name.c_str());
+      continue;
+    }
+
+    // Only robots whose assignment actually changed get notified, otherwise
+    // every robot that is charging would react to every assignment message.
+    const bool wait_for_charger = assignment.mode == assignment.MODE_WAIT;
+    if (context->dedicated_charging_wp() == wp->index()
+      && context->waiting_for_charger() == wait_for_charger)
+      continue;
+
+    context->_set_charging(wp->index(), wait_for_charger);
+    charger_occupancy->assign(context->name(), wp->index());
+    if (!wait_for_charger)
+      now_charging.push_back({context, &assignment});
+
+    ++changed;
+  }
+
+  // Check for shared chargers only once every assignment of the message has
+  // been applied, since robots may be swapping chargers with each other.
+  for (const auto& [context, assignment] : now_charging)
+  {
+    const auto sharing =
+      charger_occupancy->assigned(context->dedicated_charging_wp());
+    if (sharing > 1)
+    {
+      RCLCPP_WARN(
+        node->get_logger(),
+        "Robot [%s] was assigned to charger [%s], which %lu robots of fleet "
+        "[%s] are now assigned to",
+        context->requester_id().c_str(),
+        assignment->waypoint_name.c_str(),
+        sharing,
+        name.c_str());
+    }
+  }
+
+  if (changed > 0)
+  {
+    RCLCPP_INFO(
+      node->get_logger(),
+      "Fleet [%s] changed the charging assignments of %lu robots",
+      name.c_str(),
+      changed);
+  }
+}
+
+//==============================================================================
+void FleetUpdateHandle::Implementation::apply_charging_schedule()
+{
+  if (!charging_schedule)
+    return;
+
+  const auto now = rmf_traffic_ros2::convert(node->now());
+  ChargingAssignments msg;
+  msg.fleet_name = name;
+  for (const auto& robot : charging_schedule->robots())
+  {
+    const auto* assignment = charging_schedule->at(robot, now);
+    if (!assignment)
+      continue;
+
+    ChargingAssignment a;
+    a.robot_name = robot;
+    a.waypoint_name = assignment->waypoint;
+    a.mode = assignment->wait ? a.MODE_WAIT : a.MODE_CHARGE;
+    msg.assignments.push_back(std::move(a));
+  }
+
+  update_charging_assignments(msg);
+}
+
+//==============================================================================
+void FleetUpdateHandle::Implementation::plan_charging(
+  ExpectedState& expected) const
+{
+  if (!charging_schedule)
+    return;
+
+  const auto time = expected.state.time();
+  if (!time.has_value())
+    return;
+
+  const auto* assignment =
+    charging_schedule->at(expected.context->name(), *time);
+  if (!assignment)
+    return;
+
+  const auto* wp =
+    expected.context->navigation_graph().find_waypoint(assignment->waypoint);
+  if (!wp)
+    return;
+
+  expected.state.dedicated_charging_waypoint(wp->index());
+}
+
+//==============================================================================
+void FleetUpdateHandle::Implementation::back_up_task_queues()
+{
+  if (!task_queue_backup)
+    return;
+
+  std::unordered_map<std::string, TaskQueueBackup::TaskIds> robots;
+  for (const auto& [context, mgr] : task_managers)
+    robots[context->name()] = mgr->queued_task_ids();
+
+  if (!task_queue_backup->save(robots))
+  {
+    RCLCPP_WARN(
+      node->get_logger(),
+      "Unable to save the task queue backup of fleet [%s]",
+      name.c_str());
+  }
+}
+
+//==============================================================================
+void FleetUpdateHandle::Implementation::restore_task_queue(
+  const TaskManagerPtr& mgr)
+{
+  if (!task_queue_backup)
+    return;
+
+  const auto& context = mgr->context();
+  const auto queues = task_queue_backup->take_loaded(context->name());
+  if (!queues.has_value())
+    return;
+
+  std::vector<rmf_task::ConstRequestPtr> dispatched;
+  dispatched.reserve(queues->dispatched.size());
+  for (const auto& task : queues->dispatched)
+  {
+    std::vector<std::string> errors;
+    auto request = convert(task.id, task.request, errors);
+    if (!request)
+    {
+      RCLCPP_ERROR(
+        node->get_logger(),
+        "Unable to restore task [%s] of robot [%s] from the task queue backup",
+        task.id.c_str(),
+        context->requester_id().c_str());
+      continue;
+    }
+
+    dispatched.push_back(std::move(request));
+  }
+
+  mgr->restore_queue(dispatched);
+
+  std::size_t direct = 0;
+  for (const auto& task : queues->direct)
+  {
+    const auto response = mgr->submit_direct_request(task.request, task.id);
+    if (response.value("success", false))
+    {
+      ++direct;
+      continue;
+    }
+
+    RCLCPP_ERROR(
+      node->get_logger(),
+      "Unable to restore direct task [%s] of robot [%s] from the task queue "
+      "backup",
+      task.id.c_str(),
+      context->requester_id().c_str());
+  }
+
+  RCLCPP_INFO(
+    node->get_logger(),
+    "Restored %lu dispatched and %lu direct tasks for robot [%s]",
+    dispatched.size(),
+    direct,
+    context->requester_id().c_str());
+}
+
+//==============================================================================
+nlohmann::json_schema::json_validator
+FleetUpdateHandle::Implementation::make_validator(
+  const nlohmann::json& schema) const
+{
+  const auto loader =
+    [n = node, s = schema_dictionary](const nlohmann::json_uri& id,
+      nlohmann::json& value)
+    {
+      const auto it = s.find(id.url());
+      if (it == s.end())
+      {
+        RCLCPP_ERROR(
+          n->get_logger(),
+          "url: %s not found in schema dictionary", id.url().c_str());
+        return;
+      }
+
+      value = it->second;
+    };
+
+  return nlohmann::json_schema::json_validator(schema, loader);
+}
+
+namespace {
+//==============================================================================
+PlaceDeserializer make_place_deserializer(
+  std::shared_ptr<const std::shared_ptr<const rmf_traffic::agv::Planner>>
+  planner)
+{
+  return [planner = std::move(planner)](const nlohmann::json& msg)
+    -> DeserializedPlace
+    {
+      std::optional<rmf_traffic::agv::Plan::Goal> place;
+      const auto& graph = (*planner)->get_configuration().graph();
+      if (msg.is_number() || (msg.is_object() && msg["waypoint"].is_number()))
+      {
+        const auto wp_index = msg.is_number() ?
+          msg.get<std::size_t>() : msg["waypoint"].get<std::size_t>();
+
+        if (graph.num_waypoints() <= wp_index)
         {
           return {
             std::nullopt,
@@ -1736,6 +2937,7 @@ FleetUpdateHandle& FleetUpdateHandle::add_performable_action(
 
   _pimpl->deserialization.consider_actions->insert_or_assign(
     category, consider);
+  _pimpl->deserialization.description_cache->clear();
 
   return *this;
 }
@@ -1756,6 +2958,7 @@ auto FleetUpdateHandle::Implementation::aggregate_expectations() const
         t.first,
         t.second->expected_finish_state()
       });
+    plan_charging(expect.states.back());
     const auto requests = t.second->dispatched_requests();
     expect.pending_requests.insert(
       expect.pending_requests.end(), requests.begin(), requests.end());
@@ -1769,6 +2972,93 @@ auto FleetUpdateHandle::Implementation::aggregate_expectations() const
   return expect;
 }
 
+//==============================================================================
+auto FleetUpdateHandle::Implementation::incremental_expectations(
+  const std::vector<RobotContextPtr>& affected_robots) const -> Expectations
+{
+  struct Candidate
+  {
+    RobotContextPtr context;
+    std::size_t load;
+    rmf_traffic::Time finish;
+  };
+
+  std::vector<Candidate> candidates;
+  std::unordered_set<RobotContextPtr> selected;
+  for (const auto& [context, mgr] : task_managers)
+  {
+    if (!context->commission().is_accepting_dispatched_tasks())
+      continue;
+
+    const bool affected = std::find(
+      affected_robots.begin(), affected_robots.end(), context)
+      != affected_robots.end();
+
+    if (affected)
+    {
+      selected.insert(context);
+      continue;
+    }
+
+    candidates.push_back(
+      {
+        context,
+        mgr->dispatched_requests().size(),
+        mgr->expected_finish_state().time().value_or(rmf_traffic::Time::max())
+      });
+  }
+
+  // The unassigned requests need somewhere to go, so bring in the robots that
+  // have the least work ahead of them.
+  if (!unassigned_requests.empty())
+  {
+    std::sort(
+      candidates.begin(), candidates.end(),
+      [](const Candidate& a, const Candidate& b)
+      {
+        if (a.load != b.load)
+          return a.load < b.load;
+
+        return a.finish < b.finish;
+      });
+
+    const std::size_t limit =
+      std::max<std::size_t>(1, incremental_reassignment_robots.value_or(1));
+    for (const auto& c : candidates)
+    {
+      if (selected.size() >= limit)
+        break;
+
+      selected.insert(c.context);
+    }
+  }
+
+  Expectations expect;
+  for (const auto& [context, mgr] : task_managers)
+  {
+    if (selected.count(context) == 0)
+      continue;
+
+    expect.states.push_back(
+      ExpectedState {
+        context,
+        mgr->expected_finish_state()
+      });
+    plan_charging(expect.states.back());
+
+    const auto requests = mgr->dispatched_requests();
+    expect.pending_requests.insert(
+      expect.pending_requests.end(), requests.begin(), requests.end());
+  }
+
+  expect.pending_requests.insert(
+    expect.pending_requests.end(),
+    unassigned_requests.begin(),
+    unassigned_requests.end());
+
+  return expect;
+}
+
 //==============================================================================
 const std::string& FleetUpdateHandle::fleet_name() const
 {
@@ -1837,10 +3127,12 @@ void FleetUpdateHandle::add_robot(
         fleet->_pimpl->activation.task,
         fleet->_pimpl->task_parameters,
         fleet->_pimpl->node,
-        fleet->_pimpl->worker,
+        fleet->_pimpl->node->assign_robot_worker(fleet->_pimpl->worker),
         fleet->_pimpl->default_maximum_delay,
         state,
         fleet->_pimpl->task_planner);
+      fleet->_pimpl->charger_occupancy->assign(
+        context->name(), charger_wp.value());
 
       // We schedule the following operations on the worker to make sure we do not
       // have a multiple read/write race condition on the FleetUpdateHandle.
@@ -1863,6 +3155,23 @@ void FleetUpdateHandle::add_robot(
             context->_set_emergency(true);
           }
 
+          context->planner_warm_start(fleet->_pimpl->planner_warm_start);
+          context->goal_warmup(fleet->_pimpl->goal_warmup);
+          context->floor_planner(fleet->_pimpl->floor_planner);
+          if (fleet->_pimpl->action_pipelining)
+            context->action_pipeline(ActionPipeline::make());
+          context->evaluator_tuning(fleet->_pimpl->evaluator_tuning);
+          context->anytime_planning_deadline(
+            fleet->_pimpl->anytime_planning_deadline);
+          context->delay_reporting(fleet->_pimpl->delay_reporting);
+          context->pullover_candidates(fleet->_pimpl->pullover_candidates);
+          context->emergency_pullover_scheduler(
+            fleet->_pimpl->emergency_pullover_scheduler);
+          context->charger_occupancy(fleet->_pimpl->charger_occupancy);
+          context->mutex_group_manager(fleet->_pimpl->mutex_group_manager);
+          context->outgoing_validation(fleet->_pimpl->outgoing_validation);
+          context->json_outbox(fleet->_pimpl->json_outbox);
+
           // TODO(MXG): We need to perform this test because we do not currently
           // support the distributed negotiation in unit test environments. We
           // should create an abstract NegotiationRoom interface in rmf_traffic and
@@ -1927,7 +3236,9 @@ void FleetUpdateHandle::add_robot(
             broadcast_client,
             std::weak_ptr<FleetUpdateHandle>(fleet));
 
+          mgr->set_max_executed_tasks(fleet->_pimpl->max_executed_tasks);
           fleet->_pimpl->task_managers.insert({context, mgr});
+          fleet->_pimpl->robots_by_name[context->name()] = context;
 
           const auto c_it = fleet->_pimpl
           ->unregistered_charging_assignments.find(context->name());
@@ -1950,12 +3261,17 @@ void FleetUpdateHandle::add_robot(
               context->_set_charging(
                 wp->index(),
                 charging.mode == charging.MODE_WAIT);
+              fleet->_pimpl->charger_occupancy->assign(
+                context->name(), wp->index());
             }
             fleet->_pimpl->unregistered_charging_assignments.erase(c_it);
           }
 
           mgr->set_idle_task(fleet->_pimpl->idle_task);
           mgr->configure_retreat_to_charger(fleet->retreat_to_charger_interval());
+          mgr->set_task_state_publish_interval(
+            fleet->_pimpl->task_state_publish_interval);
+          fleet->_pimpl->restore_task_queue(mgr);
 
           // -- Calling the handle_cb should always happen last --
           if (handle_cb)
@@ -2036,6 +3352,7 @@ FleetUpdateHandle& FleetUpdateHandle::consider_delivery_requests(
 {
   *_pimpl->deserialization.consider_pickup = std::move(consider_pickup);
   *_pimpl->deserialization.consider_dropoff = std::move(consider_dropoff);
+  _pimpl->deserialization.description_cache->clear();
   return *this;
 }
 
@@ -2044,6 +3361,7 @@ FleetUpdateHandle& FleetUpdateHandle::consider_cleaning_requests(
   ConsiderRequest consider)
 {
   *_pimpl->deserialization.consider_clean = std::move(consider);
+  _pimpl->deserialization.description_cache->clear();
   return *this;
 }
 
@@ -2052,6 +3370,7 @@ FleetUpdateHandle& FleetUpdateHandle::consider_patrol_requests(
   ConsiderRequest consider)
 {
   *_pimpl->deserialization.consider_patrol = std::move(consider);
+  _pimpl->deserialization.description_cache->clear();
   return *this;
 }
 
@@ -2060,6 +3379,7 @@ FleetUpdateHandle& FleetUpdateHandle::consider_composed_requests(
   ConsiderRequest consider)
 {
   *_pimpl->deserialization.consider_composed = std::move(consider);
+  _pimpl->deserialization.description_cache->clear();
   return *this;
 }
 
@@ -2073,44 +3393,47 @@ void FleetUpdateHandle::close_lanes(std::vector<std::size_t> lane_indices)
       if (!self)
         return;
 
-      bool any_changes = false;
+      auto previous_closed_lanes = self->_pimpl->sorted_closed_lanes();
+      Implementation::LaneStateChanges changes;
       for (const auto& lane : lane_indices)
       {
         if (self->_pimpl->closed_lanes.insert(lane).second)
         {
-          any_changes = true;
+          changes.closed.push_back(lane);
         }
       }
 
-      if (!any_changes)
+      if (changes.closed.empty())
       {
         // No changes are needed to the planner
         return;
       }
 
-      auto new_config = (*self->_pimpl->planner)->get_configuration();
-      auto& new_lane_closures = new_config.lane_closures();
-      for (const auto& lane : lane_indices)
+      if (!self->_pimpl->reuse_closure_planner(
+        std::move(previous_closed_lanes)))
       {
-        new_lane_closures.close(lane);
-      }
+        auto new_config = (*self->_pimpl->planner)->get_configuration();
+        auto& new_lane_closures = new_config.lane_closures();
+        for (const auto& lane : lane_indices)
+        {
+          new_lane_closures.close(lane);
+        }
 
-      *self->_pimpl->planner =
-      std::make_shared<const rmf_traffic::agv::Planner>(
-        new_config, rmf_traffic::agv::Planner::Options(nullptr));
+        *self->_pimpl->planner =
+        std::make_shared<const rmf_traffic::agv::Planner>(
+          new_config, rmf_traffic::agv::Planner::Options(nullptr));
 
-      if (self->_pimpl->emergency_active)
-      {
-        self->_pimpl->update_emergency_planner();
+        self->_pimpl->planner_changed();
       }
 
+      self->_pimpl->refresh_emergency_planner();
       self->_pimpl->task_parameters->planner(*self->_pimpl->planner);
-      self->_pimpl->publish_lane_states();
+      self->_pimpl->publish_lane_states(changes);
 
-      RobotContext::GraphChange changes{lane_indices};
+      RobotContext::GraphChange graph_change{lane_indices};
       for (auto& [ctx, _] : self->_pimpl->task_managers)
       {
-        ctx->notify_graph_change(changes);
+        ctx->notify_graph_change(graph_change);
       }
     });
 }
@@ -2130,39 +3453,42 @@ void FleetUpdateHandle::open_lanes(std::vector<std::size_t> lane_indices)
       // by the emergency_level_for_lift behavior. For now this is intentional,
       // but in future implementations we may want to allow users to decide if
       // that is desirable behavior.
-      bool any_changes = false;
+      auto previous_closed_lanes = self->_pimpl->sorted_closed_lanes();
+      Implementation::LaneStateChanges changes;
       for (const auto& lane : lane_indices)
       {
         if (self->_pimpl->closed_lanes.erase(lane) > 0)
         {
-          any_changes = true;
+          changes.opened.push_back(lane);
         }
       }
 
-      if (!any_changes)
+      if (changes.opened.empty())
       {
         // No changes are needed to the planner
         return;
       }
 
-      auto new_config = (*self->_pimpl->planner)->get_configuration();
-      auto& new_lane_closures = new_config.lane_closures();
-      for (const auto& lane : lane_indices)
+      if (!self->_pimpl->reuse_closure_planner(
+        std::move(previous_closed_lanes)))
       {
-        new_lane_closures.open(lane);
-      }
+        auto new_config = (*self->_pimpl->planner)->get_configuration();
+        auto& new_lane_closures = new_config.lane_closures();
+        for (const auto& lane : lane_indices)
+        {
+          new_lane_closures.open(lane);
+        }
 
-      *self->_pimpl->planner =
-      std::make_shared<const rmf_traffic::agv::Planner>(
-        new_config, rmf_traffic::agv::Planner::Options(nullptr));
+        *self->_pimpl->planner =
+        std::make_shared<const rmf_traffic::agv::Planner>(
+          new_config, rmf_traffic::agv::Planner::Options(nullptr));
 
-      if (self->_pimpl->emergency_active)
-      {
-        self->_pimpl->update_emergency_planner();
+        self->_pimpl->planner_changed();
       }
 
+      self->_pimpl->refresh_emergency_planner();
       self->_pimpl->task_parameters->planner(*self->_pimpl->planner);
-      self->_pimpl->publish_lane_states();
+      self->_pimpl->publish_lane_states(changes);
     });
 }
 
@@ -2173,6 +3499,18 @@ void FleetUpdateHandle::set_lift_emergency_level(
 {
   _pimpl->emergency_level_for_lift[std::move(lift_name)] =
     std::move(emergency_level_name);
+
+  _pimpl->worker.schedule(
+    [w = weak_from_this()](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      // The lift closures of the precomputed emergency planner have changed
+      if (self->_pimpl->max_pullover_candidates.has_value())
+        self->_pimpl->refresh_emergency_planner();
+    });
 }
 
 //==============================================================================
@@ -2222,6 +3560,7 @@ auto FleetUpdateHandle::limit_lane_speeds(
 
       auto new_config = (*self->_pimpl->planner)->get_configuration();
       auto& new_graph = new_config.graph();
+      Implementation::LaneStateChanges changes;
       for (const auto& request : requests)
       {
         // TODO: Check if planner supports negative speed limits.
@@ -2245,14 +3584,32 @@ auto FleetUpdateHandle::limit_lane_speeds(
         // Bookkeeping
         self->_pimpl->speed_limited_lanes[request.lane_index()] =
         request.speed_limit();
+        changes.speed_limited.emplace_back(
+          request.lane_index(), request.speed_limit());
       }
 
       *self->_pimpl->planner =
       std::make_shared<const rmf_traffic::agv::Planner>(
         new_config, rmf_traffic::agv::Planner::Options(nullptr));
 
+      // The remembered planners have the old speed limits
+      self->_pimpl->closure_planners.clear();
+
       self->_pimpl->task_parameters->planner(*self->_pimpl->planner);
-      self->_pimpl->publish_lane_states();
+      self->_pimpl->planner_changed();
+      if (self->_pimpl->max_pullover_candidates.has_value())
+        self->_pimpl->refresh_emergency_planner();
+      self->_pimpl->publish_lane_states(changes);
+
+      RobotContext::GraphChange graph_change{{}, {}};
+      for (const auto& [lane, _] : changes.speed_limited)
+        graph_change.speed_limited_lanes.push_back(lane);
+
+      if (graph_change.speed_limited_lanes.empty())
+        return;
+
+      for (auto& [ctx, _] : self->_pimpl->task_managers)
+        ctx->notify_graph_change(graph_change);
     });
 }
 
@@ -2270,6 +3627,7 @@ void FleetUpdateHandle::remove_speed_limits(std::vector<std::size_t> requests)
 
       auto new_config = (*self->_pimpl->planner)->get_configuration();
       auto& new_graph = new_config.graph();
+      Implementation::LaneStateChanges changes;
       for (const auto& request : requests)
       {
 
@@ -2281,14 +3639,28 @@ void FleetUpdateHandle::remove_speed_limits(std::vector<std::size_t> requests)
         properties.speed_limit(std::nullopt);
         // Bookkeeping
         self->_pimpl->speed_limited_lanes.erase(request);
+        changes.speed_limits_removed.push_back(request);
       }
 
       *self->_pimpl->planner =
       std::make_shared<const rmf_traffic::agv::Planner>(
         new_config, rmf_traffic::agv::Planner::Options(nullptr));
 
+      // The remembered planners have the old speed limits
+      self->_pimpl->closure_planners.clear();
+
       self->_pimpl->task_parameters->planner(*self->_pimpl->planner);
-      self->_pimpl->publish_lane_states();
+      self->_pimpl->planner_changed();
+      if (self->_pimpl->max_pullover_candidates.has_value())
+        self->_pimpl->refresh_emergency_planner();
+      self->_pimpl->publish_lane_states(changes);
+
+      if (changes.speed_limits_removed.empty())
+        return;
+
+      RobotContext::GraphChange graph_change{{}, changes.speed_limits_removed};
+      for (auto& [ctx, _] : self->_pimpl->task_managers)
+        ctx->notify_graph_change(graph_change);
     });
 }
 
@@ -2311,6 +3683,36 @@ void FleetUpdateHandle::Implementation::publish_lane_states() const
   }
   lane_states_pub->publish(std::move(msg));
 }
+
+//==============================================================================
+void FleetUpdateHandle::Implementation::publish_lane_states(
+  const LaneStateChanges& changes) const
+{
+  publish_lane_states();
+
+  if (lane_state_changes_pub == nullptr)
+    return;
+
+  if (lane_state_changes_pub->get_subscription_count() == 0
+    && lane_state_changes_pub->get_intra_process_subscription_count() == 0)
+    return;
+
+  nlohmann::json speed_limited = nlohmann::json::array();
+  for (const auto& [index, limit] : changes.speed_limited)
+    speed_limited.push_back({{"lane_index", index}, {"speed_limit", limit}});
+
+  const nlohmann::json delta = {
+    {"fleet_name", name},
+    {"closed_lanes", changes.closed},
+    {"opened_lanes", changes.opened},
+    {"speed_limits", std::move(speed_limited)},
+    {"removed_speed_limits", changes.speed_limits_removed}
+  };
+
+  LaneStateChangesMsg msg;
+  msg.data = delta.dump();
+  lane_state_changes_pub->publish(msg);
+}
 //==============================================================================
 FleetUpdateHandle& FleetUpdateHandle::accept_task_requests(
   AcceptTaskRequest check)
@@ -2552,6 +3954,43 @@ FleetUpdateHandle& FleetUpdateHandle::fleet_state_update_period(
   return *this;
 }
 
+//==============================================================================
+FleetUpdateHandle& FleetUpdateHandle::fleet_state_update_change_detection(
+  std::optional<rmf_traffic::Duration> heartbeat_period,
+  double position_threshold,
+  double yaw_threshold,
+  double battery_threshold)
+{
+  if (heartbeat_period.has_value())
+  {
+    _pimpl->fleet_state_change_detection = FleetStateChangeDetection{
+      *heartbeat_period,
+      position_threshold,
+      yaw_threshold,
+      battery_threshold
+    };
+  }
+  else
+  {
+    _pimpl->fleet_state_change_detection = std::nullopt;
+  }
+
+  _pimpl->robot_state_records.clear();
+  _pimpl->last_fleet_state_update = std::nullopt;
+  return *this;
+}
+
+//==============================================================================
+FleetUpdateHandle& FleetUpdateHandle::fleet_state_activity_periods(
+  std::optional<rmf_traffic::Duration> idle_period,
+  std::optional<rmf_traffic::Duration> charging_period)
+{
+  _pimpl->idle_state_period = idle_period;
+  _pimpl->charging_state_period = charging_period;
+  _pimpl->robot_state_refresh.clear();
+  return *this;
+}
+
 //==============================================================================
 FleetUpdateHandle& FleetUpdateHandle::set_update_listener(
   std::function<void(const nlohmann::json&)> listener)
@@ -2618,6 +4057,633 @@ void FleetUpdateHandle::set_planner_cache_reset_size(
   );
 }
 
+//==============================================================================
+void FleetUpdateHandle::set_negotiation_evaluator_params(
+  double compliant_leeway_base,
+  double compliant_leeway_multiplier,
+  double estimate_leeway,
+  double max_cost_threshold,
+  bool adaptive)
+{
+  services::ProgressEvaluatorTuning::Parameters parameters;
+  parameters.compliant_leeway_base = compliant_leeway_base;
+  parameters.compliant_leeway_multiplier = compliant_leeway_multiplier;
+  parameters.estimate_leeway = estimate_leeway;
+  parameters.max_cost_threshold = max_cost_threshold;
+  parameters.adaptive = adaptive;
+
+  _pimpl->worker.schedule(
+    [w = weak_from_this(), parameters](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      RCLCPP_INFO(
+        self->_pimpl->node->get_logger(),
+        "Setting negotiation evaluator parameters of fleet [%s]: "
+        "compliant_leeway_base [%f], compliant_leeway_multiplier [%f], "
+        "estimate_leeway [%f], max_cost_threshold [%f], adaptive [%s]",
+        self->_pimpl->name.c_str(),
+        parameters.compliant_leeway_base,
+        parameters.compliant_leeway_multiplier,
+        parameters.estimate_leeway,
+        parameters.max_cost_threshold,
+        parameters.adaptive ? "true" : "false");
+
+      auto tuning = services::ProgressEvaluatorTuning::make(parameters);
+      self->_pimpl->evaluator_tuning = tuning;
+      for (const auto& [context, _] : self->_pimpl->task_managers)
+        context->evaluator_tuning(tuning);
+    });
+}
+
+//==============================================================================
+void FleetUpdateHandle::set_max_concurrent_bids(std::size_t max_bids)
+{
+  _pimpl->worker.schedule(
+    [w = weak_from_this(), max_bids](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      self->_pimpl->max_concurrent_bids = std::max<std::size_t>(1, max_bids);
+      self->_pimpl->start_pending_bids();
+    });
+}
+
+//==============================================================================
+void FleetUpdateHandle::set_allocation_threads(std::size_t threads)
+{
+  _pimpl->worker.schedule(
+    [w = weak_from_this(), threads](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      self->_pimpl->allocation_threads = std::max<std::size_t>(1, threads);
+    });
+}
+
+//==============================================================================
+void FleetUpdateHandle::set_incremental_reassignment(
+  std::optional<std::size_t> max_robots,
+  rmf_traffic::Duration time_budget)
+{
+  _pimpl->worker.schedule(
+    [w = weak_from_this(), max_robots, time_budget](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      self->_pimpl->incremental_reassignment_robots = max_robots;
+      self->_pimpl->incremental_reassignment_budget = time_budget;
+    });
+}
+
+//==============================================================================
+void FleetUpdateHandle::set_outgoing_validation_sample_period(
+  std::size_t sample_period)
+{
+  // All the robots of the fleet share this object, so it can be changed in
+  // place without going through the worker.
+  _pimpl->outgoing_validation->sample_period(sample_period);
+}
+
+//==============================================================================
+void FleetUpdateHandle::set_task_state_publish_interval(
+  std::optional<rmf_traffic::Duration> interval)
+{
+  _pimpl->worker.schedule(
+    [w = weak_from_this(), interval](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      self->_pimpl->task_state_publish_interval = interval;
+      for (const auto& [_, mgr] : self->_pimpl->task_managers)
+        mgr->set_task_state_publish_interval(interval);
+    });
+}
+
+//==============================================================================
+void FleetUpdateHandle::set_lane_closure_planner_cache_size(std::size_t size)
+{
+  _pimpl->worker.schedule(
+    [w = weak_from_this(), size](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      self->_pimpl->max_closure_planners = size;
+      while (self->_pimpl->closure_planners.size() > size)
+        self->_pimpl->closure_planners.pop_back();
+    });
+}
+
+//==============================================================================
+class FleetUpdateHandle::Interruption::Implementation
+{
+public:
+  struct Robots
+  {
+    std::vector<std::shared_ptr<TaskManager::Interruption>> interruptions;
+    std::atomic_bool resumed = false;
+  };
+
+  std::weak_ptr<FleetUpdateHandle> w_fleet;
+  std::shared_ptr<Robots> robots;
+
+  static Interruption make(std::weak_ptr<FleetUpdateHandle> w_fleet)
+  {
+    Interruption output;
+    output._pimpl->w_fleet = std::move(w_fleet);
+    output._pimpl->robots = std::make_shared<Robots>();
+    return output;
+  }
+
+  static std::shared_ptr<Robots> get_robots(const Interruption& handle)
+  {
+    return handle._pimpl->robots;
+  }
+
+  void resume(std::vector<std::string> labels)
+  {
+    if (!robots || robots->resumed.exchange(true))
+      return;
+
+    const auto fleet = w_fleet.lock();
+    if (!fleet)
+    {
+      // Each robot gets released on its own once its interruption expires
+      return;
+    }
+
+    fleet->_pimpl->worker.schedule(
+      [w = w_fleet, robots = robots, labels = std::move(labels)](const auto&)
+      {
+        for (const auto& interruption : robots->interruptions)
+          interruption->resume_now(labels);
+
+        if (const auto self = w.lock())
+          self->_pimpl->update_fleet();
+      });
+  }
+
+  ~Implementation()
+  {
+    resume({"automatic release"});
+  }
+};
+
+//==============================================================================
+void FleetUpdateHandle::Interruption::resume(std::vector<std::string> labels)
+{
+  _pimpl->resume(std::move(labels));
+}
+
+//==============================================================================
+FleetUpdateHandle::Interruption::Interruption()
+: _pimpl(rmf_utils::make_unique_impl<Implementation>())
+{
+  // Do nothing
+}
+
+//==============================================================================
+auto FleetUpdateHandle::interrupt_robots(
+  std::vector<std::string> labels,
+  std::vector<std::string> robot_names,
+  std::function<void()> robots_are_interrupted)
+-> Interruption
+{
+  Interruption handle = Interruption::Implementation::make(weak_from_this());
+  _pimpl->worker.schedule(
+    [
+      w = weak_from_this(),
+      labels = std::move(labels),
+      robot_names = std::move(robot_names),
+      robots_are_interrupted = std::move(robots_are_interrupted),
+      robots = Interruption::Implementation::get_robots(handle)
+    ](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      std::vector<std::shared_ptr<TaskManager>> managers;
+      if (robot_names.empty())
+      {
+        for (const auto& [_, mgr] : self->_pimpl->task_managers)
+          managers.push_back(mgr);
+      }
+      else
+      {
+        for (const auto& name : robot_names)
+        {
+          const auto r_it = self->_pimpl->robots_by_name.find(name);
+          if (r_it == self->_pimpl->robots_by_name.end())
+          {
+            RCLCPP_WARN(
+              self->_pimpl->node->get_logger(),
+              "Unable to interrupt robot [%s] of fleet [%s] because it does "
+              "not exist",
+              name.c_str(),
+              self->_pimpl->name.c_str());
+            continue;
+          }
+
+          const auto m_it = self->_pimpl->task_managers.find(r_it->second);
+          if (m_it != self->_pimpl->task_managers.end())
+            managers.push_back(m_it->second);
+        }
+      }
+
+      if (managers.empty())
+      {
+        if (robots_are_interrupted)
+          robots_are_interrupted();
+        return;
+      }
+
+      // Count down the robots that still need to be interrupted so that the
+      // callback of the caller is only triggered once for all of them.
+      const auto remaining =
+        std::make_shared<std::size_t>(managers.size());
+      const auto robot_is_interrupted =
+        [remaining, robots_are_interrupted]()
+        {
+          if (*remaining == 0 || --(*remaining) > 0)
+            return;
+
+          if (robots_are_interrupted)
+            robots_are_interrupted();
+        };
+
+      robots->interruptions.reserve(managers.size());
+      for (const auto& mgr : managers)
+      {
+        auto interruption = std::make_shared<TaskManager::Interruption>();
+        interruption->w_mgr = mgr;
+        robots->interruptions.push_back(interruption);
+        mgr->interrupt_robot(
+          std::move(interruption), labels, robot_is_interrupted);
+      }
+
+      self->_pimpl->update_fleet();
+    });
+
+  return handle;
+}
+
+//==============================================================================
+void FleetUpdateHandle::set_anytime_planning_deadline(
+  std::optional<rmf_traffic::Duration> deadline)
+{
+  _pimpl->worker.schedule(
+    [w = weak_from_this(), deadline](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      self->_pimpl->anytime_planning_deadline = deadline;
+      for (const auto& [context, _] : self->_pimpl->task_managers)
+        context->anytime_planning_deadline(deadline);
+    });
+}
+
+//==============================================================================
+void FleetUpdateHandle::set_delay_reporting(
+  rmf_traffic::Duration threshold,
+  std::optional<rmf_traffic::Duration> min_period)
+{
+  _pimpl->worker.schedule(
+    [w = weak_from_this(), threshold, min_period](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      self->_pimpl->delay_reporting = DelayReporting{threshold, min_period};
+      for (const auto& [context, _] : self->_pimpl->task_managers)
+        context->delay_reporting(self->_pimpl->delay_reporting);
+    });
+}
+
+//==============================================================================
+void FleetUpdateHandle::set_emergency_pullover_precomputation(
+  std::optional<std::size_t> max_candidates)
+{
+  _pimpl->worker.schedule(
+    [w = weak_from_this(), max_candidates](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      if (self->_pimpl->max_pullover_candidates == max_candidates)
+        return;
+
+      self->_pimpl->max_pullover_candidates = max_candidates;
+      self->_pimpl->refresh_emergency_planner();
+    });
+}
+
+//==============================================================================
+void FleetUpdateHandle::set_travel_time_precomputation(bool enabled)
+{
+  _pimpl->worker.schedule(
+    [w = weak_from_this(), enabled](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      if (self->_pimpl->precompute_travel_times == enabled)
+        return;
+
+      self->_pimpl->precompute_travel_times = enabled;
+      self->_pimpl->update_travel_time_table();
+    });
+}
+
+//==============================================================================
+void FleetUpdateHandle::set_planner_warm_start_file(
+  std::optional<std::string> filename)
+{
+  _pimpl->worker.schedule(
+    [w = weak_from_this(), filename = std::move(filename)](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      auto& impl = *self->_pimpl;
+      std::shared_ptr<PlannerWarmStart> warm_start;
+      if (filename.has_value())
+      {
+        const auto& planner = *impl.planner;
+        warm_start = PlannerWarmStart::make(
+          *filename, planner->get_configuration());
+
+        RCLCPP_INFO(
+          impl.node->get_logger(),
+          "Warming up the planner cache of fleet [%s] with %lu planning "
+          "problems from [%s]",
+          impl.name.c_str(),
+          warm_start->loaded(),
+          filename->c_str());
+
+        warm_start->warm_up(planner);
+      }
+
+      impl.planner_warm_start = warm_start;
+      for (const auto& [context, _] : impl.task_managers)
+        context->planner_warm_start(warm_start);
+    }
+  );
+}
+
+//==============================================================================
+void FleetUpdateHandle::set_planner_goal_warmup(std::size_t max_goals)
+{
+  _pimpl->worker.schedule(
+    [w = weak_from_this(), max_goals](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      auto& impl = *self->_pimpl;
+      const auto& current = impl.goal_warmup;
+      if (current ? current->max_goals() == max_goals : max_goals == 0)
+        return;
+
+      impl.goal_warmup =
+        max_goals > 0 ? GoalWarmup::make(max_goals) : nullptr;
+      for (const auto& [context, _] : impl.task_managers)
+        context->goal_warmup(impl.goal_warmup);
+
+      impl.warm_up_goals();
+    });
+}
+
+//==============================================================================
+void FleetUpdateHandle::set_floor_restricted_planning(std::size_t max_planners)
+{
+  _pimpl->worker.schedule(
+    [w = weak_from_this(), max_planners](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      auto& impl = *self->_pimpl;
+      const auto& current = impl.floor_planner;
+      if (current ? current->max_planners() == max_planners : max_planners == 0)
+        return;
+
+      impl.floor_planner =
+        max_planners > 0 ? FloorPlanner::make(max_planners) : nullptr;
+      for (const auto& [context, _] : impl.task_managers)
+        context->floor_planner(impl.floor_planner);
+
+      if (!impl.floor_planner)
+      {
+        impl.floor_planner_lift_sub = rmf_rxcpp::subscription_guard();
+        return;
+      }
+
+      impl.floor_planner_lift_sub = impl.node->lift_state()
+      .observe_on(rxcpp::identity_same_worker(impl.worker))
+      .subscribe(
+        [w = std::weak_ptr<FloorPlanner>(impl.floor_planner),
+        n = std::weak_ptr<Node>(impl.node)](const auto& msg)
+        {
+          const auto floor_planner = w.lock();
+          const auto node = n.lock();
+          if (!floor_planner || !node)
+            return;
+
+          floor_planner->update_lift(
+            *msg, rmf_traffic_ros2::convert(node->now()));
+        });
+    });
+}
+
+//==============================================================================
+void FleetUpdateHandle::set_action_pipelining(bool enabled)
+{
+  _pimpl->worker.schedule(
+    [w = weak_from_this(), enabled](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      auto& impl = *self->_pimpl;
+      if (impl.action_pipelining == enabled)
+        return;
+
+      impl.action_pipelining = enabled;
+      for (const auto& [context, _] : impl.task_managers)
+        context->action_pipeline(enabled ? ActionPipeline::make() : nullptr);
+    });
+}
+
+//==============================================================================
+void FleetUpdateHandle::set_memory_caps(
+  std::optional<std::size_t> max_bid_assignments,
+  std::size_t max_executed_tasks,
+  std::optional<std::size_t> max_unsent_log_entries)
+{
+  _pimpl->worker.schedule(
+    [
+      w = weak_from_this(),
+      max_bid_assignments,
+      max_executed_tasks,
+      max_unsent_log_entries
+    ](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      auto& impl = *self->_pimpl;
+      if (max_bid_assignments.has_value() && !impl.max_bid_assignments)
+      {
+        // Start tracking the age of the bids that are already waiting
+        for (const auto& [id, _] : impl.bid_notice_assignments)
+          impl.bid_notice_order.push_back(id);
+      }
+
+      impl.max_bid_assignments = max_bid_assignments;
+      impl.trim_bid_notice_assignments();
+
+      impl.max_executed_tasks = max_executed_tasks;
+      for (const auto& [_, mgr] : impl.task_managers)
+        mgr->set_max_executed_tasks(max_executed_tasks);
+
+      impl.max_unsent_log_entries = max_unsent_log_entries;
+    });
+}
+
+//==============================================================================
+void FleetUpdateHandle::set_task_queue_backup_file(
+  std::optional<std::string> filename,
+  rmf_traffic::Duration period)
+{
+  _pimpl->worker.schedule(
+    [w = weak_from_this(), filename = std::move(filename), period](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      auto& impl = *self->_pimpl;
+      impl.task_queue_backup_timer = nullptr;
+      impl.task_queue_backup = nullptr;
+      if (!filename.has_value())
+        return;
+
+      impl.task_queue_backup = TaskQueueBackup::make(*filename);
+      RCLCPP_INFO(
+        impl.node->get_logger(),
+        "Restoring %lu tasks for fleet [%s] from [%s]",
+        impl.task_queue_backup->loaded(),
+        impl.name.c_str(),
+        filename->c_str());
+
+      for (const auto& [_, mgr] : impl.task_managers)
+        impl.restore_task_queue(mgr);
+
+      impl.task_queue_backup_timer = impl.node->try_create_wall_timer(
+        period,
+        [w]()
+        {
+          const auto self = w.lock();
+          if (!self)
+            return;
+
+          self->_pimpl->worker.schedule(
+            [w](const auto&)
+            {
+              if (const auto self = w.lock())
+                self->_pimpl->back_up_task_queues();
+            });
+        });
+    });
+}
+
+//==============================================================================
+void FleetUpdateHandle::set_charging_schedule_file(
+  std::optional<std::string> filename)
+{
+  _pimpl->worker.schedule(
+    [w = weak_from_this(), filename = std::move(filename)](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      auto& impl = *self->_pimpl;
+      impl.charging_schedule_timer = nullptr;
+      impl.charging_schedule = nullptr;
+      if (!filename.has_value())
+        return;
+
+      try
+      {
+        const bool use_sim_time =
+          impl.node->get_parameter("use_sim_time").as_bool();
+        impl.charging_schedule = ChargingSchedule::make(
+          YAML::LoadFile(*filename), impl.name, use_sim_time);
+      }
+      catch (const std::exception& e)
+      {
+        RCLCPP_ERROR(
+          impl.node->get_logger(),
+          "Unable to load the charging schedule of fleet [%s] from [%s]: %s",
+          impl.name.c_str(),
+          filename->c_str(),
+          e.what());
+        return;
+      }
+
+      RCLCPP_INFO(
+        impl.node->get_logger(),
+        "Fleet [%s] is following the charging schedule of %lu robots in [%s]",
+        impl.name.c_str(),
+        impl.charging_schedule->robots().size(),
+        filename->c_str());
+
+      impl.apply_charging_schedule();
+
+      // The schedule changes on the minute, so checking it a few times per
+      // minute is enough to switch chargers on time.
+      impl.charging_schedule_timer = impl.node->try_create_wall_timer(
+        std::chrono::seconds(5),
+        [w]()
+        {
+          const auto self = w.lock();
+          if (!self)
+            return;
+
+          self->_pimpl->worker.schedule(
+            [w](const auto&)
+            {
+              if (const auto self = w.lock())
+                self->_pimpl->apply_charging_schedule();
+            });
+        });
+    });
+}
+
 //==============================================================================
 std::shared_ptr<rclcpp::Node> FleetUpdateHandle::node()
 {
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "MutexGroupManager.hpp"
+#include "RobotContext.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace rmf_fleet_adapter {
+namespace agv {
+
+//==============================================================================
+std::shared_ptr<MutexGroupManager> MutexGroupManager::make(
+  const std::shared_ptr<Node>& node,
+  rxcpp::schedulers::worker worker)
+{
+  auto manager = std::shared_ptr<MutexGroupManager>(new MutexGroupManager);
+
+  manager->_states_subscription = node->mutex_group_states()
+    .observe_on(rxcpp::identity_same_worker(worker))
+    .subscribe([w = manager->weak_from_this()](const auto& msg)
+      {
+        if (const auto self = w.lock())
+          self->_check(*msg);
+      });
+
+  manager->_heartbeat_timer = node->try_create_wall_timer(
+    std::chrono::seconds(2),
+    [w = manager->weak_from_this()]()
+    {
+      if (const auto self = w.lock())
+        self->_heartbeat();
+    });
+
+  return manager;
+}
+
+//==============================================================================
+void MutexGroupManager::add(const std::shared_ptr<RobotContext>& context)
+{
+  _robots.push_back(context);
+}
+
+//==============================================================================
+void MutexGroupManager::_check(
+  const rmf_fleet_msgs::msg::MutexGroupStates& states)
+{
+  using Assignment = rmf_fleet_msgs::msg::MutexGroupAssignment;
+  std::unordered_map<uint64_t, std::vector<const Assignment*>> by_claimant;
+  std::unordered_map<std::string, const Assignment*> by_group;
+  for (const auto& assignment : states.assignments)
+  {
+    by_claimant[assignment.claimant].push_back(&assignment);
+    by_group[assignment.group] = &assignment;
+  }
+
+  const auto removed = std::remove_if(
+    _robots.begin(), _robots.end(),
+    [](const auto& robot) { return robot.expired(); });
+  _robots.erase(removed, _robots.end());
+
+  // Copy the list because a robot may react to its notification in ways that
+  // add robots to the fleet.
+  const auto robots = _robots;
+  for (const auto& robot : robots)
+  {
+    const auto context = robot.lock();
+    if (!context)
+      continue;
+
+    const auto& requesting = context->requesting_mutex_groups();
+    const auto& locked = context->locked_mutex_groups();
+    const auto own = by_claimant.find(context->participant_id());
+
+    // A robot that is not waiting for any mutex group only needs to hear about
+    // assignments that it does not know it has.
+    bool relevant = !requesting.empty();
+    if (!relevant && own != by_claimant.end())
+    {
+      for (const auto* assignment : own->second)
+      {
+        if (locked.count(assignment->group) == 0)
+        {
+          relevant = true;
+          break;
+        }
+      }
+    }
+
+    if (!relevant)
+      continue;
+
+    rmf_fleet_msgs::msg::MutexGroupStates filtered;
+    if (own != by_claimant.end())
+    {
+      for (const auto* assignment : own->second)
+        filtered.assignments.push_back(*assignment);
+    }
+
+    for (const auto& [group, _] : requesting)
+    {
+      const auto it = by_group.find(group);
+      if (it != by_group.end()
+        && it->second->claimant != context->participant_id())
+      {
+        filtered.assignments.push_back(*it->second);
+      }
+    }
+
+    context->_check_mutex_groups(filtered);
+  }
+}
+
+//==============================================================================
+void MutexGroupManager::_heartbeat()
+{
+  const auto robots = _robots;
+  for (const auto& robot : robots)
+  {
+    if (const auto context = robot.lock())
+      context->_publish_mutex_group_requests();
+  }
+}
+
+} // namespace agv
+} // namespace rmf_fleet_adapter
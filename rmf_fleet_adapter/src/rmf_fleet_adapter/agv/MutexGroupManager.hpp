@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__AGV__MUTEXGROUPMANAGER_HPP
+#define SRC__RMF_FLEET_ADAPTER__AGV__MUTEXGROUPMANAGER_HPP
+
+#include "Node.hpp"
+
+#include <rmf_rxcpp/Transport.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace rmf_fleet_adapter {
+namespace agv {
+
+class RobotContext;
+
+//==============================================================================
+/// Watches the mutex group states on behalf of every robot in a fleet. Each
+/// states message is indexed by claimant once, and only the robots that have
+/// something to do with it get notified: robots that are waiting to lock a
+/// mutex group, and robots that were assigned a mutex group they do not know
+/// about. The requests of every robot are also refreshed by a single heartbeat.
+class MutexGroupManager
+  : public std::enable_shared_from_this<MutexGroupManager>
+{
+public:
+
+  /// Make a manager that watches the mutex group states of the node on the
+  /// worker.
+  static std::shared_ptr<MutexGroupManager> make(
+    const std::shared_ptr<Node>& node,
+    rxcpp::schedulers::worker worker);
+
+  /// Begin managing the mutex groups of a robot. The robot will stop being
+  /// managed once its context is destroyed.
+  void add(const std::shared_ptr<RobotContext>& context);
+
+private:
+
+  MutexGroupManager() = default;
+
+  void _check(const rmf_fleet_msgs::msg::MutexGroupStates& states);
+  void _heartbeat();
+
+  std::vector<std::weak_ptr<RobotContext>> _robots;
+  rmf_rxcpp::subscription_guard _states_subscription;
+  rclcpp::TimerBase::SharedPtr _heartbeat_timer;
+};
+
+} // namespace agv
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__AGV__MUTEXGROUPMANAGER_HPP
@@ -22,6 +22,8 @@
 
 #include <rmf_traffic_ros2/Time.hpp>
 
+#include <sstream>
+
 namespace rmf_fleet_adapter {
 namespace agv {
 
@@ -32,7 +34,7 @@ std::shared_ptr<Node> Node::make(
   const rclcpp::NodeOptions& options)
 {
   auto node = std::shared_ptr<Node>(
-    new Node(std::move(worker), node_name, options));
+    new Node(worker, node_name, options));
 
   auto default_qos = rclcpp::SystemDefaultsQoS().keep_last(100);
   auto transient_qos = rclcpp::SystemDefaultsQoS()
@@ -42,6 +44,14 @@ std::shared_ptr<Node> Node::make(
     node->create_observable<DoorState>(
     DoorStateTopicName, default_qos);
 
+  node->_door_state_index = std::make_shared<KeyedStateIndex<DoorState>>(
+    [](const DoorState& state) { return state.door_name; });
+  node->_door_state_index_sub = node->door_state().subscribe(
+    [index = node->_door_state_index](const DoorState::SharedPtr& msg)
+    {
+      index->update(msg);
+    });
+
   node->_door_supervisor_obs =
     node->create_observable<DoorSupervisorState>(
     DoorSupervisorHeartbeatTopicName, default_qos);
@@ -54,6 +64,14 @@ std::shared_ptr<Node> Node::make(
     node->create_observable<LiftState>(
     LiftStateTopicName, default_qos);
 
+  node->_lift_state_index = std::make_shared<KeyedStateIndex<LiftState>>(
+    [](const LiftState& state) { return state.lift_name; });
+  node->_lift_state_index_sub = node->lift_state().subscribe(
+    [index = node->_lift_state_index](const LiftState::SharedPtr& msg)
+    {
+      index->update(msg);
+    });
+
   node->_lift_request_pub =
     node->create_publisher<LiftRequest>(
     AdapterLiftRequestTopicName, transient_qos);
@@ -147,6 +165,146 @@ std::shared_ptr<Node> Node::make(
     node->create_publisher<DynamicEventDescription>(
       DynamicEventBeginTopicBase, transient_local_qos);
 
+  // Give each fleet one dynamic event action server that all of its robots
+  // share, instead of one action server and status topic for every robot.
+  node->_share_dynamic_event_servers =
+    node->declare_parameter<bool>("shared_dynamic_event_server", false);
+
+  // Limit how many negotiations this adapter plans for at once so that robot
+  // commands and state updates do not get starved during congestion spikes.
+  // A value of zero means there is no limit.
+  const auto max_negotiations = static_cast<std::size_t>(
+    std::max<int64_t>(
+      0, node->declare_parameter<int>("max_concurrent_negotiations", 0)));
+
+  const auto priority_name = node->declare_parameter<std::string>(
+    "negotiation_priority", "age");
+  auto priority = NegotiationScheduler::parse_priority(priority_name);
+  if (!priority.has_value())
+  {
+    RCLCPP_WARN(
+      node->get_logger(),
+      "Unknown negotiation_priority [%s]. The options are [age] and "
+      "[conflict_time]. We will use [age].", priority_name.c_str());
+    priority = NegotiationScheduler::Priority::Age;
+  }
+
+  node->_negotiation_scheduler = NegotiationScheduler::make(
+    std::move(worker), max_negotiations, *priority);
+
+  // Number of threads dedicated to planning jobs. A value of zero means the
+  // planning jobs share the event loop that the rest of the fleet adapter
+  // runs on.
+  const auto planning_threads = static_cast<std::size_t>(
+    std::max<int64_t>(0, node->declare_parameter<int>("planning_threads", 0)));
+  rmf_rxcpp::set_job_threads(planning_threads);
+
+  // How often the timers for retries, resends, and timeouts are checked
+  const double timer_wheel_resolution = node->declare_parameter<double>(
+    "timer_wheel_resolution", 0.1);
+  node->_timer_wheel = std::make_shared<TimerWheel>(
+    timer_wheel_resolution > 0.0 ?
+    rmf_traffic::time::from_seconds(timer_wheel_resolution) :
+    TimerWheel::DefaultResolution);
+
+  // Number of threads that the robots of this adapter are spread across. A
+  // value of zero keeps each robot on the worker of its fleet.
+  const auto robot_worker_threads = static_cast<std::size_t>(
+    std::max<int64_t>(
+      0, node->declare_parameter<int>("robot_worker_threads", 0)));
+  for (std::size_t i = 0; i < robot_worker_threads; ++i)
+  {
+    node->_robot_workers.push_back(
+      rxcpp::schedulers::make_new_thread().create_worker());
+  }
+
+  // Answer negotiations on the worker of each robot. Tables that arrive over
+  // ROS are otherwise answered on the executor, and tables that other
+  // participants open up for us are answered on the main worker. This needs
+  // robot_worker_threads, because without it the worker of each robot is the
+  // main worker, which also runs robot commands.
+  node->_negotiate_on_robot_workers =
+    node->declare_parameter<bool>("negotiate_on_robot_workers", false);
+  if (node->_negotiate_on_robot_workers && robot_worker_threads == 0)
+  {
+    RCLCPP_WARN(
+      node->get_logger(),
+      "negotiate_on_robot_workers has no effect unless robot_worker_threads "
+      "is greater than zero; negotiations will be answered where they arrive");
+    node->_negotiate_on_robot_workers = false;
+  }
+
+  // Hand incoming work from the ROS executor to the event loop through a
+  // lock-free queue instead of blocking the executor on every spin.
+  node->use_executor_work_queue(
+    node->declare_parameter<bool>("executor_work_queue", false));
+
+  // Send task and fleet logs to the server over a second websocket connection
+  // so that large logs do not hold up fleet and task state updates.
+  node->_separate_log_channel =
+    node->declare_parameter<bool>("separate_log_channel", false);
+
+  // Only resend the task logs that the server is missing after reconnecting.
+  // The server needs to understand resync requests, like BroadcastServer.
+  node->_websocket_resync =
+    node->declare_parameter<bool>("websocket_resync", false);
+
+  // Ask the server for a binary encoding of the websocket messages. Servers
+  // that do not accept it are still sent JSON.
+  const auto encoding_name = node->declare_parameter<std::string>(
+    "websocket_encoding", "json");
+  if (encoding_name == "cbor")
+    node->_websocket_encoding = rmf_websocket::Encoding::Cbor;
+  else if (encoding_name == "msgpack")
+    node->_websocket_encoding = rmf_websocket::Encoding::MessagePack;
+  else if (encoding_name != "json")
+  {
+    RCLCPP_WARN(
+      node->get_logger(),
+      "Unknown websocket_encoding [%s]. The options are [json], [cbor] and "
+      "[msgpack]. We will use [json].", encoding_name.c_str());
+  }
+
+  // Publish statistics about the websocket clients with this period in
+  // seconds. Nothing is published when this is zero.
+  const double diagnostics_period =
+    node->declare_parameter<double>("websocket_diagnostics_period", 0.0);
+  if (diagnostics_period > 0.0)
+  {
+    node->_websocket_diagnostics_period =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double>(diagnostics_period));
+  }
+
+  // Publish statistics about the jobs that run on the rxcpp workers with this
+  // period in seconds. Nothing is published when this is zero.
+  const double job_diagnostics_period =
+    node->declare_parameter<double>("job_diagnostics_period", 0.0);
+  if (job_diagnostics_period > 0.0)
+  {
+    node->_job_diagnostics_pub =
+      node->create_publisher<statistics_msgs::msg::MetricsMessage>(
+      JobDiagnosticsTopicName,
+      rclcpp::SystemDefaultsQoS().reliable().keep_last(100));
+
+    node->_job_diagnostics_timer = node->create_wall_timer(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(job_diagnostics_period)),
+      [w = node->weak_from_this()]()
+      {
+        if (const auto self = std::static_pointer_cast<Node>(w.lock()))
+          self->_publish_job_diagnostics();
+      });
+  }
+
+  node->_timer_wheel_driver = node->create_wall_timer(
+    node->_timer_wheel->resolution(),
+    [w = std::weak_ptr<TimerWheel>(node->_timer_wheel)]()
+    {
+      if (const auto wheel = w.lock())
+        wheel->advance(TimerWheel::Clock::now());
+    });
+
   return node;
 }
 
@@ -181,6 +339,12 @@ auto Node::door_state() const -> const DoorStateObs&
   return _door_state_obs->observe();
 }
 
+//==============================================================================
+auto Node::door_state(const std::string& door_name) const -> DoorStateObs
+{
+  return _door_state_index->observe(door_name);
+}
+
 //==============================================================================
 auto Node::door_supervisor() const -> const DoorSupervisorObs&
 {
@@ -199,6 +363,12 @@ auto Node::lift_state() const -> const LiftStateObs&
   return _lift_state_obs->observe();
 }
 
+//==============================================================================
+auto Node::lift_state(const std::string& lift_name) const -> LiftStateObs
+{
+  return _lift_state_index->observe(lift_name);
+}
+
 //==============================================================================
 auto Node::lift_request() const -> const LiftRequestPub&
 {
@@ -332,5 +502,162 @@ const DynamicEventDescriptionPub& Node::all_dynamic_event_descriptions() const
   return _general_dynamic_event_description_pub;
 }
 
+//==============================================================================
+std::shared_ptr<DynamicEventServer> Node::shared_dynamic_event_server(
+  const std::string& fleet_name)
+{
+  if (!_share_dynamic_event_servers)
+    return nullptr;
+
+  std::lock_guard<std::mutex> lock(_dynamic_event_servers_mutex);
+  auto& server = _dynamic_event_servers[fleet_name];
+  if (!server)
+    server = DynamicEventServer::make(shared_from_this(), fleet_name);
+
+  return server;
+}
+
+//==============================================================================
+const std::shared_ptr<NegotiationScheduler>& Node::negotiation_scheduler()
+const
+{
+  return _negotiation_scheduler;
+}
+
+//==============================================================================
+TimerWheel::TimerPtr Node::create_wheel_timer(
+  rmf_traffic::Duration period,
+  TimerWheel::Callback callback)
+{
+  return _timer_wheel->add(period, std::move(callback));
+}
+
+//==============================================================================
+rxcpp::schedulers::worker Node::assign_robot_worker(
+  const rxcpp::schedulers::worker& fleet_worker)
+{
+  if (_robot_workers.empty())
+    return fleet_worker;
+
+  const auto index = _next_robot_worker.fetch_add(1) % _robot_workers.size();
+  return _robot_workers[index];
+}
+
+//==============================================================================
+bool Node::shards_robots() const
+{
+  return !_robot_workers.empty();
+}
+
+//==============================================================================
+bool Node::negotiate_on_robot_workers() const
+{
+  return _negotiate_on_robot_workers;
+}
+
+//==============================================================================
+bool Node::separate_log_channel() const
+{
+  return _separate_log_channel;
+}
+
+//==============================================================================
+bool Node::websocket_resync() const
+{
+  return _websocket_resync;
+}
+
+//==============================================================================
+rmf_websocket::Encoding Node::websocket_encoding() const
+{
+  return _websocket_encoding;
+}
+
+//==============================================================================
+std::optional<std::chrono::nanoseconds>
+Node::websocket_diagnostics_period() const
+{
+  return _websocket_diagnostics_period;
+}
+
+//==============================================================================
+void Node::_publish_job_diagnostics()
+{
+  using MetricsMsg = statistics_msgs::msg::MetricsMessage;
+  using DataType = statistics_msgs::msg::StatisticDataType;
+  using DataPoint = statistics_msgs::msg::StatisticDataPoint;
+  using Histogram = rmf_rxcpp::JobStats::Histogram;
+
+  const rclcpp::Time now = this->now();
+  const rclcpp::Time window_start = _job_diagnostics_window_start.value_or(now);
+  _job_diagnostics_window_start = now;
+
+  const auto publish = [&](
+    const std::string& source,
+    const std::string& unit,
+    const std::vector<std::pair<uint8_t, double>>& data)
+    {
+      MetricsMsg msg;
+      msg.measurement_source_name = get_fully_qualified_name();
+      msg.metrics_source = source;
+      msg.unit = unit;
+      msg.window_start = window_start;
+      msg.window_stop = now;
+      for (const auto& [type, value] : data)
+      {
+        DataPoint point;
+        point.data_type = type;
+        point.data = value;
+        msg.statistics.push_back(point);
+      }
+      _job_diagnostics_pub->publish(msg);
+    };
+
+  const auto publish_times = [&](
+    const std::string& source,
+    const Histogram& histogram)
+    {
+      if (histogram.count == 0)
+        return;
+
+      publish(source, "seconds", {
+          {DataType::STATISTICS_DATA_TYPE_AVERAGE, histogram.mean()},
+          {DataType::STATISTICS_DATA_TYPE_MAXIMUM, histogram.max},
+          {DataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT,
+            static_cast<double>(histogram.count)}
+        });
+    };
+
+  for (const auto& window : rmf_rxcpp::JobStats::take_windows())
+  {
+    publish(window.type + "/queue_depth", "jobs", {
+        {DataType::STATISTICS_DATA_TYPE_AVERAGE,
+          static_cast<double>(window.queued)}
+      });
+
+    publish_times(window.type + "/wait_time", window.wait);
+    publish_times(window.type + "/execution_time", window.execution);
+    if (window.execution.count == 0)
+      continue;
+
+    // Each bucket of the histogram counts the jobs that took no longer than
+    // its bound, and longer than the bound of the bucket before it.
+    const auto& bounds = rmf_rxcpp::JobStats::BucketBounds;
+    for (std::size_t i = 0; i < window.execution.buckets.size(); ++i)
+    {
+      std::ostringstream bound;
+      if (i < bounds.size())
+        bound << bounds[i];
+      else
+        bound << "inf";
+
+      publish(
+        window.type + "/execution_time/le_" + bound.str(), "count",
+        {{DataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT,
+          static_cast<double>(window.execution.buckets[i])}});
+    }
+  }
+}
+
 } // namespace agv
 } // namespace rmf_fleet_adapter
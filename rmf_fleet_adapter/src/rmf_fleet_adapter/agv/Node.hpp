@@ -42,6 +42,8 @@
 
 #include <std_msgs/msg/bool.hpp>
 
+#include <statistics_msgs/msg/metrics_message.hpp>
+
 #include <rmf_fleet_msgs/msg/fleet_state.hpp>
 #include <rmf_fleet_msgs/msg/mutex_group_request.hpp>
 #include <rmf_fleet_msgs/msg/mutex_group_states.hpp>
@@ -53,6 +55,20 @@
 
 #include <rmf_traffic/Time.hpp>
 
+#include <rmf_websocket/Encoding.hpp>
+
+#include "DynamicEventServer.hpp"
+#include "../KeyedStateIndex.hpp"
+#include "../NegotiationScheduler.hpp"
+#include "../TimerWheel.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
 namespace rmf_fleet_adapter {
 
 using DynamicEventDescription = rmf_task_msgs::msg::DynamicEventDescription;
@@ -80,6 +96,9 @@ public:
   using DoorStateObs = rxcpp::observable<DoorState::SharedPtr>;
   const DoorStateObs& door_state() const;
 
+  /// Get the states of only one door
+  DoorStateObs door_state(const std::string& door_name) const;
+
   using DoorSupervisorState = rmf_door_msgs::msg::SupervisorHeartbeat;
   using DoorSupervisorObs = rxcpp::observable<DoorSupervisorState::SharedPtr>;
   const DoorSupervisorObs& door_supervisor() const;
@@ -92,6 +111,9 @@ public:
   using LiftStateObs = rxcpp::observable<LiftState::SharedPtr>;
   const LiftStateObs& lift_state() const;
 
+  /// Get the states of only one lift
+  LiftStateObs lift_state(const std::string& lift_name) const;
+
   using LiftRequest = rmf_lift_msgs::msg::LiftRequest;
   using LiftRequestPub = rclcpp::Publisher<LiftRequest>::SharedPtr;
   const LiftRequestPub& lift_request() const;
@@ -180,6 +202,61 @@ public:
 
  const DynamicEventDescriptionPub& all_dynamic_event_descriptions() const;
 
+  /// Get the dynamic event server that is shared by every robot of a fleet,
+  /// creating it if needed. This is a nullptr unless the
+  /// shared_dynamic_event_server parameter is true, in which case each robot
+  /// runs its own dynamic event server.
+  std::shared_ptr<DynamicEventServer> shared_dynamic_event_server(
+    const std::string& fleet_name);
+
+  /// The scheduler that limits how many negotiations this adapter runs at once
+  const std::shared_ptr<NegotiationScheduler>& negotiation_scheduler() const;
+
+  /// Create a coarse periodic timer for retries, resends, and timeouts. All
+  /// of these timers share one wall timer of this node, so they do not each
+  /// wake up the executor. They fire on the executor with a precision of the
+  /// timer wheel resolution. The timer stops when the returned pointer is
+  /// dropped or cancelled.
+  TimerWheel::TimerPtr create_wheel_timer(
+    rmf_traffic::Duration period,
+    TimerWheel::Callback callback);
+
+  /// Pick the worker that a new robot should run its callbacks on. When the
+  /// robot_worker_threads parameter is positive, robots are spread across
+  /// that many dedicated threads so a slow callback for one robot does not
+  /// hold up the others. Each robot always stays on the same thread, so its
+  /// callbacks keep their order. Otherwise the robot shares the worker of its
+  /// fleet, which is given as fleet_worker.
+  rxcpp::schedulers::worker assign_robot_worker(
+    const rxcpp::schedulers::worker& fleet_worker);
+
+  /// True if robots are spread across their own threads instead of sharing
+  /// the worker of their fleet.
+  bool shards_robots() const;
+
+  /// True if robots should answer negotiations on their own worker instead
+  /// of on the thread that delivered the negotiation table. This is only ever
+  /// true when shards_robots() is true, so negotiations never get answered on
+  /// the main worker that runs robot commands.
+  bool negotiate_on_robot_workers() const;
+
+  /// True if the websocket clients of this adapter should send log updates
+  /// over their own connection so they cannot hold up state updates.
+  bool separate_log_channel() const;
+
+  /// True if the websocket clients of this adapter should ask the server
+  /// which log entries it already has after reconnecting, and only resend
+  /// the missing ones.
+  bool websocket_resync() const;
+
+  /// The encoding that the websocket clients of this adapter should ask the
+  /// server for.
+  rmf_websocket::Encoding websocket_encoding() const;
+
+  /// How often the websocket clients of this adapter should publish their
+  /// statistics, if at all.
+  std::optional<std::chrono::nanoseconds> websocket_diagnostics_period() const;
+
 
   template<typename DurationRepT, typename DurationT, typename CallbackT>
   rclcpp::TimerBase::SharedPtr try_create_wall_timer(
@@ -222,10 +299,18 @@ private:
     const std::string& node_name,
     const rclcpp::NodeOptions& options);
 
+  /// Publish what the jobs on the rxcpp workers of this process have been
+  /// doing since the last time this was called.
+  void _publish_job_diagnostics();
+
   Bridge<DoorState> _door_state_obs;
+  std::shared_ptr<KeyedStateIndex<DoorState>> _door_state_index;
+  rxcpp::subscription _door_state_index_sub;
   Bridge<DoorSupervisorState> _door_supervisor_obs;
   DoorRequestPub _door_request_pub;
   Bridge<LiftState> _lift_state_obs;
+  std::shared_ptr<KeyedStateIndex<LiftState>> _lift_state_index;
+  rxcpp::subscription _lift_state_index_sub;
   LiftRequestPub _lift_request_pub;
   TaskSummaryPub _task_summary_pub;
   DispenserRequestPub _dispenser_request_pub;
@@ -248,6 +333,24 @@ private:
   Bridge<ReservationAllocation> _reservation_alloc_obs;
   ReservationReleasePub _reservation_release_pub;
   DynamicEventDescriptionPub _general_dynamic_event_description_pub;
+  bool _share_dynamic_event_servers = false;
+  std::mutex _dynamic_event_servers_mutex;
+  std::unordered_map<std::string, std::shared_ptr<DynamicEventServer>>
+  _dynamic_event_servers;
+  std::shared_ptr<NegotiationScheduler> _negotiation_scheduler;
+  std::shared_ptr<TimerWheel> _timer_wheel;
+  rclcpp::TimerBase::SharedPtr _timer_wheel_driver;
+  std::vector<rxcpp::schedulers::worker> _robot_workers;
+  std::atomic_size_t _next_robot_worker{0};
+  bool _negotiate_on_robot_workers = false;
+  bool _separate_log_channel = false;
+  bool _websocket_resync = false;
+  std::optional<std::chrono::nanoseconds> _websocket_diagnostics_period;
+  rclcpp::Publisher<statistics_msgs::msg::MetricsMessage>::SharedPtr
+    _job_diagnostics_pub;
+  rclcpp::TimerBase::SharedPtr _job_diagnostics_timer;
+  std::optional<rclcpp::Time> _job_diagnostics_window_start;
+  rmf_websocket::Encoding _websocket_encoding = rmf_websocket::Encoding::Json;
 };
 
 } // namespace agv
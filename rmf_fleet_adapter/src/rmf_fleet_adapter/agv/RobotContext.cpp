@@ -26,6 +26,8 @@
 #include <rmf_door_msgs/msg/door_mode.hpp>
 
 #include <rmf_utils/math.hpp>
+
+#include <algorithm>
 #include <string>
 #include <unordered_set>
 
@@ -53,15 +55,30 @@ namespace agv {
 std::unordered_map<std::size_t, VertexStack> compute_stacked_vertices(
   const rmf_traffic::agv::Graph& graph,
   double max_merge_waypoint_distance)
+{
+  return compute_stacked_vertices(
+    graph, max_merge_waypoint_distance, *GraphSpatialIndex::make(graph));
+}
+
+//==============================================================================
+std::unordered_map<std::size_t, VertexStack> compute_stacked_vertices(
+  const rmf_traffic::agv::Graph& graph,
+  double max_merge_waypoint_distance,
+  const GraphSpatialIndex& index)
 {
   std::unordered_map<std::size_t, VertexStack> stacked_vertices;
-  for (std::size_t i = 0; i < graph.num_waypoints() - 1; ++i)
+  for (std::size_t i = 0; i < graph.num_waypoints(); ++i)
   {
     const auto& wp_i = graph.get_waypoint(i);
     const Eigen::Vector2d p_i = wp_i.get_location();
     const std::string& map_i = wp_i.get_map_name();
-    for (std::size_t j = i+1; j < graph.num_waypoints(); ++j)
+    const auto nearby =
+      index.waypoints_near(map_i, p_i, max_merge_waypoint_distance);
+    for (const std::size_t j : nearby)
     {
+      if (j <= i)
+        continue;
+
       const auto& wp_j = graph.get_waypoint(j);
       const Eigen::Vector2d p_j = wp_j.get_location();
       const std::string& map_j = wp_j.get_map_name();
@@ -170,11 +187,71 @@ rmf_traffic::agv::Plan::StartSet NavParams::compute_plan_starts(
   return {};
 }
 
+//==============================================================================
+rmf_traffic::agv::Plan::StartSet NavParams::unfiltered_compute_plan_starts(
+  const rmf_traffic::agv::Graph& graph,
+  const std::string& map_name,
+  const Eigen::Vector3d position,
+  const rmf_traffic::Time start_time) const
+{
+  if (!spatial_index || !spatial_index->matches(graph))
+  {
+    for (const double m : multipliers)
+    {
+      auto starts = rmf_traffic::agv::compute_plan_starts(
+        graph,
+        map_name,
+        position,
+        start_time,
+        max_merge_waypoint_distance,
+        m * max_merge_lane_distance,
+        min_lane_length);
+
+      if (!starts.empty())
+        return starts;
+    }
+
+    return {};
+  }
+
+  double radius = max_merge_waypoint_distance;
+  for (const double m : multipliers)
+    radius = std::max(radius, m * max_merge_lane_distance);
+
+  // Robots usually report positions close to their last one, so keep using
+  // the same part of the graph until the robot leaves it.
+  const Eigen::Vector2d p = position.block<2, 1>(0, 0);
+  if (!_last_neighborhood || _last_neighborhood_index != spatial_index
+    || !_last_neighborhood->covers(map_name, p, radius))
+  {
+    _last_neighborhood = spatial_index->neighborhood(
+      graph, map_name, p, radius + std::max(0.0, neighborhood_margin));
+    _last_neighborhood_index = spatial_index;
+  }
+
+  for (const double m : multipliers)
+  {
+    auto starts = _last_neighborhood->compute_plan_starts(
+      map_name,
+      position,
+      start_time,
+      max_merge_waypoint_distance,
+      m * max_merge_lane_distance,
+      min_lane_length);
+
+    if (!starts.empty())
+      return starts;
+  }
+
+  return {};
+}
+
 //==============================================================================
 void NavParams::find_stacked_vertices(const rmf_traffic::agv::Graph& graph)
 {
+  spatial_index = GraphSpatialIndex::make(graph);
   stacked_vertices = compute_stacked_vertices(
-    graph, max_merge_waypoint_distance);
+    graph, max_merge_waypoint_distance, *spatial_index);
 }
 
 //==============================================================================
@@ -810,6 +887,20 @@ RobotContext::observe_graph_change() const
 void RobotContext::notify_graph_change(GraphChange changes)
 {
   filter_closed_lanes();
+  if (_nav_params)
+  {
+    // The navigation parameters are used on the worker of this robot, so
+    // reindex the new graph there.
+    _worker.schedule([w = weak_from_this()](const auto&)
+      {
+        const auto self = w.lock();
+        if (!self || !self->_nav_params)
+          return;
+
+        self->_nav_params->find_stacked_vertices(self->navigation_graph());
+      });
+  }
+
   _graph_change_publisher.get_subscriber().on_next(std::move(changes));
 }
 
@@ -994,13 +1085,195 @@ auto RobotContext::task_planner(
   return *this;
 }
 
+//==============================================================================
+const std::shared_ptr<PlannerWarmStart>&
+RobotContext::planner_warm_start() const
+{
+  return _planner_warm_start;
+}
+
+//==============================================================================
+RobotContext& RobotContext::planner_warm_start(
+  std::shared_ptr<PlannerWarmStart> warm_start)
+{
+  _planner_warm_start = std::move(warm_start);
+  return *this;
+}
+
+//==============================================================================
+const std::shared_ptr<GoalWarmup>& RobotContext::goal_warmup() const
+{
+  return _goal_warmup;
+}
+
+//==============================================================================
+RobotContext& RobotContext::goal_warmup(std::shared_ptr<GoalWarmup> warmup)
+{
+  _goal_warmup = std::move(warmup);
+  return *this;
+}
+
+//==============================================================================
+const std::shared_ptr<FloorPlanner>& RobotContext::floor_planner() const
+{
+  return _floor_planner;
+}
+
+//==============================================================================
+RobotContext& RobotContext::floor_planner(
+  std::shared_ptr<FloorPlanner> floor_planner)
+{
+  _floor_planner = std::move(floor_planner);
+  return *this;
+}
+
+//==============================================================================
+const std::shared_ptr<ActionPipeline>& RobotContext::action_pipeline() const
+{
+  return _action_pipeline;
+}
+
+//==============================================================================
+RobotContext& RobotContext::action_pipeline(
+  std::shared_ptr<ActionPipeline> pipeline)
+{
+  _action_pipeline = std::move(pipeline);
+  return *this;
+}
+
+//==============================================================================
+const services::ProgressEvaluatorTuningPtr&
+RobotContext::evaluator_tuning() const
+{
+  return _evaluator_tuning;
+}
+
+//==============================================================================
+RobotContext& RobotContext::evaluator_tuning(
+  services::ProgressEvaluatorTuningPtr tuning)
+{
+  _evaluator_tuning = std::move(tuning);
+  return *this;
+}
+
+//==============================================================================
+std::optional<rmf_traffic::Duration>
+RobotContext::anytime_planning_deadline() const
+{
+  return _anytime_planning_deadline;
+}
+
+//==============================================================================
+RobotContext& RobotContext::anytime_planning_deadline(
+  std::optional<rmf_traffic::Duration> deadline)
+{
+  _anytime_planning_deadline = deadline;
+  return *this;
+}
+
+//==============================================================================
+const OutgoingValidationPtr& RobotContext::outgoing_validation() const
+{
+  return _outgoing_validation;
+}
+
+//==============================================================================
+RobotContext& RobotContext::outgoing_validation(
+  OutgoingValidationPtr validation)
+{
+  _outgoing_validation = std::move(validation);
+  return *this;
+}
+
+//==============================================================================
+const JsonOutboxPtr& RobotContext::json_outbox() const
+{
+  return _json_outbox;
+}
+
+//==============================================================================
+RobotContext& RobotContext::json_outbox(JsonOutboxPtr outbox)
+{
+  _json_outbox = std::move(outbox);
+  return *this;
+}
+
+//==============================================================================
+const DelayReporting& RobotContext::delay_reporting() const
+{
+  return _delay_reporting;
+}
+
+//==============================================================================
+RobotContext& RobotContext::delay_reporting(DelayReporting reporting)
+{
+  _delay_reporting = std::move(reporting);
+  return *this;
+}
+
+//==============================================================================
+const std::shared_ptr<const PulloverCandidates>&
+RobotContext::pullover_candidates() const
+{
+  return _pullover_candidates;
+}
+
+//==============================================================================
+RobotContext& RobotContext::pullover_candidates(
+  std::shared_ptr<const PulloverCandidates> candidates)
+{
+  _pullover_candidates = std::move(candidates);
+  return *this;
+}
+
+//==============================================================================
+const std::shared_ptr<EmergencyPulloverScheduler>&
+RobotContext::emergency_pullover_scheduler() const
+{
+  return _emergency_pullover_scheduler;
+}
+
+//==============================================================================
+RobotContext& RobotContext::emergency_pullover_scheduler(
+  std::shared_ptr<EmergencyPulloverScheduler> scheduler)
+{
+  _emergency_pullover_scheduler = std::move(scheduler);
+  return *this;
+}
+
+//==============================================================================
+const std::shared_ptr<ChargerOccupancy>&
+RobotContext::charger_occupancy() const
+{
+  return _charger_occupancy;
+}
+
+//==============================================================================
+RobotContext& RobotContext::charger_occupancy(
+  std::shared_ptr<ChargerOccupancy> occupancy)
+{
+  _charger_occupancy = std::move(occupancy);
+  return *this;
+}
+
+//==============================================================================
+RobotContext& RobotContext::mutex_group_manager(
+  const std::shared_ptr<MutexGroupManager>& manager)
+{
+  manager->add(shared_from_this());
+  return *this;
+}
+
 //==============================================================================
 void RobotContext::set_lift_entry_watchdog(
   RobotUpdateHandle::Unstable::Watchdog watchdog,
-  rmf_traffic::Duration wait_duration)
+  rmf_traffic::Duration wait_duration,
+  rmf_traffic::Duration decision_time_to_live)
 {
   _lift_watchdog = std::move(watchdog);
   _lift_rewait_duration = wait_duration;
+  _lift_watchdog_cache = _lift_watchdog ?
+    LiftWatchdogCache::make(_lift_watchdog, decision_time_to_live) : nullptr;
 }
 
 //==============================================================================
@@ -1010,6 +1283,13 @@ RobotContext::get_lift_watchdog() const
   return _lift_watchdog;
 }
 
+//==============================================================================
+const std::shared_ptr<LiftWatchdogCache>&
+RobotContext::get_lift_watchdog_cache() const
+{
+  return _lift_watchdog_cache;
+}
+
 //==============================================================================
 rmf_traffic::Duration RobotContext::get_lift_rewait_duration() const
 {
@@ -1026,6 +1306,28 @@ uint64_t RobotContext::last_reservation_request_id()
 void RobotContext::respond(
   const TableViewerPtr& table_viewer,
   const ResponderPtr& responder)
+{
+  if (_node->negotiate_on_robot_workers())
+  {
+    // The negotiator of this robot reads state that only changes on the
+    // worker of this robot, so answer the table there. If the robot goes away
+    // first, the responder will forfeit when it gets dropped.
+    _worker.schedule(
+      [w = weak_from_this(), table_viewer, responder](const auto&)
+      {
+        if (const auto self = w.lock())
+          self->_respond(table_viewer, responder);
+      });
+    return;
+  }
+
+  _respond(table_viewer, responder);
+}
+
+//==============================================================================
+void RobotContext::_respond(
+  const TableViewerPtr& table_viewer,
+  const ResponderPtr& responder)
 {
   if (_negotiator && !is_stubborn())
     return _negotiator->respond(table_viewer, responder);
@@ -1360,6 +1662,27 @@ void RobotContext::schedule_itinerary(
   std::shared_ptr<rmf_traffic::PlanId> plan_id,
   rmf_traffic::schedule::Itinerary new_itinerary)
 {
+  if (*plan_id == itinerary().current_plan_id())
+  {
+    // The plan is not changing, so only send the schedule what is different
+    // about its itinerary.
+    const auto delta =
+      ItineraryDelta::compute(itinerary().itinerary(), new_itinerary);
+    switch (delta.kind)
+    {
+      case ItineraryDelta::Kind::Unchanged:
+        return;
+      case ItineraryDelta::Kind::Delay:
+        itinerary().delay(delta.delay);
+        return;
+      case ItineraryDelta::Kind::Extend:
+        itinerary().extend(delta.additional_routes);
+        return;
+      case ItineraryDelta::Kind::Set:
+        break;
+    }
+  }
+
   bool scheduled = false;
   std::size_t attempts = 0;
   while (!scheduled)
@@ -1907,7 +2230,15 @@ uint32_t RobotContext::_begin_dynamic_event(
   std::string description,
   std::shared_ptr<DynamicEventCallbacks> callbacks)
 {
-  ++_dynamic_event_seq;
+  if (_shared_dynamic_event_server)
+  {
+    _dynamic_event_seq = _shared_dynamic_event_server->begin(
+      shared_from_this(), _dynamic_event_seq);
+  }
+  else
+  {
+    ++_dynamic_event_seq;
+  }
   _dynamic_event_goal.reset();
   _dynamic_event_callbacks = std::move(callbacks);
 
@@ -1918,9 +2249,12 @@ uint32_t RobotContext::_begin_dynamic_event(
     .description(std::move(description))
     .start_time(_node->now());
 
-  // We publish to both the general topic and the robot-specific topic
+  // We publish to both the general topic and the robot-specific topic. Robots
+  // that share the dynamic event server of their fleet only have the general
+  // topic.
   _node->all_dynamic_event_descriptions()->publish(msg);
-  _individual_dynamic_event_description_pub->publish(msg);
+  if (_individual_dynamic_event_description_pub)
+    _individual_dynamic_event_description_pub->publish(msg);
 
   return _dynamic_event_seq;
 }
@@ -2126,9 +2460,114 @@ void RobotContext::_handle_mutex_group_manual_release(
   retain_mutex_groups(retain);
 }
 
+//==============================================================================
+rclcpp_action::GoalResponse RobotContext::_handle_dynamic_event_goal(
+  const DynamicEventAction::Goal& goal)
+{
+  const auto logger = rclcpp::get_logger(
+    std::string("rmf.dynamic_event.") + group() + "." + name());
+
+  if (goal.dynamic_event_seq != _dynamic_event_seq)
+  {
+    RCLCPP_ERROR(
+      logger,
+      "Rejecting dynamic event goal because of dynamic_event_seq mismatch. "
+      "Expected %d, received %d.",
+      _dynamic_event_seq,
+      goal.dynamic_event_seq);
+    return rclcpp_action::GoalResponse::REJECT;
+  }
+
+  const auto callbacks = _dynamic_event_callbacks.lock();
+  if (!callbacks)
+  {
+    RCLCPP_ERROR(
+      logger,
+      "Rejecting dynamic event goal because there is no active dynamic event.");
+    return rclcpp_action::GoalResponse::REJECT;
+  }
+
+  const bool cancellation = goal.event_type ==
+    DynamicEventAction::Goal::EVENT_TYPE_CANCEL;
+
+  if (!_dynamic_event_goal.expired() && !cancellation)
+  {
+    // There is an ongoing goal and the request is not a cancellation, so we
+    // should reject it.
+    RCLCPP_ERROR(
+      logger,
+      "Rejecting dynamic event goal because there is an active child event, "
+      "and the goal was not a cancellation.");
+    return rclcpp_action::GoalResponse::REJECT;
+  }
+
+  if (goal.event_type == DynamicEventAction::Goal::EVENT_TYPE_NEXT)
+  {
+    if (!callbacks->validator(goal.category, goal.description))
+    {
+      RCLCPP_ERROR(
+        logger,
+        "Rejecting dynamic event goal because it failed validation.");
+      return rclcpp_action::GoalResponse::REJECT;
+    }
+  }
+
+  return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+}
+
+//==============================================================================
+void RobotContext::_handle_dynamic_event_accepted(
+  const std::shared_ptr<DynamicEventHandle>& handle)
+{
+  const auto callbacks = _dynamic_event_callbacks.lock();
+  const auto event_conflict = !_dynamic_event_goal.expired()
+    && handle->get_goal()->event_type != DynamicEventAction::Goal::EVENT_TYPE_CANCEL;
+
+  if (!callbacks || event_conflict)
+  {
+    handle->execute();
+    handle->abort(dynamic_event_execution_failure("race condition"));
+    return;
+  }
+
+  auto execution_raii = std::make_shared<rclcpp_action::GoalUUID>(handle->get_goal_id());
+  _dynamic_event_goal = execution_raii;
+  callbacks->executor(handle, execution_raii);
+}
+
+//==============================================================================
+rclcpp_action::CancelResponse RobotContext::_handle_dynamic_event_cancel(
+  const std::shared_ptr<DynamicEventHandle>& handle)
+{
+  const auto current_action_guid = _dynamic_event_goal.lock();
+  const auto callbacks = _dynamic_event_callbacks.lock();
+  if (!callbacks || !current_action_guid || *current_action_guid != handle->get_goal_id())
+  {
+    handle->canceled(
+      dynamic_event_execution_failure("cancelled while not running"));
+    return rclcpp_action::CancelResponse::ACCEPT;
+  }
+
+  callbacks->cancel(handle);
+
+  return rclcpp_action::CancelResponse::ACCEPT;
+}
+
 //==============================================================================
 void RobotContext::_initialize_dynamic_event_server()
 {
+  _dynamic_event_seq = 0;
+
+  _shared_dynamic_event_server = _node->shared_dynamic_event_server(group());
+  if (_shared_dynamic_event_server)
+  {
+    // Goals, cancellations, and statuses for this robot go through the server
+    // of its fleet.
+    _dynamic_event_status_pub =
+      _shared_dynamic_event_server->status_publisher();
+    return;
+  }
+
   const auto single_transient_local_qos = rclcpp::QoS(1).reliable().transient_local();
   _individual_dynamic_event_description_pub = _node
     ->create_publisher<DynamicEventDescription>(
@@ -2140,8 +2579,6 @@ void RobotContext::_initialize_dynamic_event_server()
         DynamicEventStatusTopicBase + "/" + requester_id(),
         single_transient_local_qos);
 
-  _dynamic_event_seq = 0;
-
   std::string logger_name = std::string("rmf.dynamic_event.") + group() + "." + name();
   auto logger = rclcpp::get_logger(logger_name);
   auto handle_goal = [w = weak_from_this(), logger](
@@ -2149,61 +2586,15 @@ void RobotContext::_initialize_dynamic_event_server()
     std::shared_ptr<const DynamicEventAction::Goal> goal)
   {
     const auto me = w.lock();
-    if (!me || goal->dynamic_event_seq != me->_dynamic_event_seq)
-    {
-      if (me)
-      {
-        RCLCPP_ERROR(
-          logger,
-          "Rejecting dynamic event goal because of dynamic_event_seq mismatch. "
-          "Expected %d, received %d.",
-          me->_dynamic_event_seq,
-          goal->dynamic_event_seq);
-      }
-      else
-      {
-        RCLCPP_ERROR(
-          logger,
-          "Rejecting dynamic event goal because the fleet adapter is winding down.");
-      }
-      return rclcpp_action::GoalResponse::REJECT;
-    }
-
-    const auto callbacks = me->_dynamic_event_callbacks.lock();
-    if (!callbacks)
-    {
-      RCLCPP_ERROR(
-        logger,
-        "Rejecting dynamic event goal because there is no active dynamic event.");
-      return rclcpp_action::GoalResponse::REJECT;
-    }
-
-    const bool cancellation = goal->event_type ==
-      DynamicEventAction::Goal::EVENT_TYPE_CANCEL;
-
-    if (!me->_dynamic_event_goal.expired() && !cancellation)
+    if (!me)
     {
-      // There is an ongoing goal and the request is not a cancellation, so we
-      // should reject it.
       RCLCPP_ERROR(
         logger,
-        "Rejecting dynamic event goal because there is an active child event, "
-        "and the goal was not a cancellation.");
+        "Rejecting dynamic event goal because the fleet adapter is winding down.");
       return rclcpp_action::GoalResponse::REJECT;
     }
 
-    if (goal->event_type == DynamicEventAction::Goal::EVENT_TYPE_NEXT)
-    {
-      if (!callbacks->validator(goal->category, goal->description))
-      {
-        RCLCPP_ERROR(
-          logger,
-          "Rejecting dynamic event goal because it failed validation.");
-        return rclcpp_action::GoalResponse::REJECT;
-      }
-    }
-
-    return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+    return me->_handle_dynamic_event_goal(*goal);
   };
 
   auto handle_accepted = [w = weak_from_this()](
@@ -2217,44 +2608,21 @@ void RobotContext::_initialize_dynamic_event_server()
       return;
     }
 
-    const auto callbacks = me->_dynamic_event_callbacks.lock();
-    const auto event_conflict = !me->_dynamic_event_goal.expired()
-      && handle->get_goal()->event_type != DynamicEventAction::Goal::EVENT_TYPE_CANCEL;
-
-    if (!callbacks || event_conflict)
-    {
-      handle->execute();
-      handle->abort(dynamic_event_execution_failure("race condition"));
-      return;
-    }
-
-    auto execution_raii = std::make_shared<rclcpp_action::GoalUUID>(handle->get_goal_id());
-    me->_dynamic_event_goal = execution_raii;
-    callbacks->executor(handle, execution_raii);
+    me->_handle_dynamic_event_accepted(handle);
   };
 
   auto handle_cancel = [w = weak_from_this()](
     const std::shared_ptr<DynamicEventHandle> handle)
   {
     const auto me = w.lock();
-    std::shared_ptr<rclcpp_action::GoalUUID> current_action_guid;
-    std::shared_ptr<DynamicEventCallbacks> callbacks;
-    if (me)
-    {
-      current_action_guid = me->_dynamic_event_goal.lock();
-      callbacks = me->_dynamic_event_callbacks.lock();
-    }
-
-    if (!callbacks || !current_action_guid || *current_action_guid != handle->get_goal_id())
+    if (!me)
     {
       handle->canceled(
         dynamic_event_execution_failure("cancelled while not running"));
       return rclcpp_action::CancelResponse::ACCEPT;
     }
 
-    callbacks->cancel(handle);
-
-    return rclcpp_action::CancelResponse::ACCEPT;
+    return me->_handle_dynamic_event_cancel(handle);
   };
 
   _dynamic_event_server = rclcpp_action::create_server<DynamicEventAction>(
@@ -48,9 +48,24 @@
 #include <rxcpp/rx-observable.hpp>
 
 #include "Node.hpp"
+#include "DynamicEventServer.hpp"
+#include "MutexGroupManager.hpp"
 #include "../Reporting.hpp"
 #include "ReservationManager.hpp"
 #include "../DeserializeJSON.hpp"
+#include "../GraphSpatialIndex.hpp"
+#include "../ItineraryDelta.hpp"
+#include "../OutgoingValidation.hpp"
+#include "../JsonOutbox.hpp"
+#include "../PlannerWarmStart.hpp"
+#include "../GoalWarmup.hpp"
+#include "../FloorPlanner.hpp"
+#include "../EmergencyPulloverScheduler.hpp"
+#include "../ChargerOccupancy.hpp"
+#include "../LiftWatchdogCache.hpp"
+#include "../PulloverCandidates.hpp"
+#include "../ActionPipeline.hpp"
+#include "../services/ProgressEvaluatorTuning.hpp"
 
 #include <unordered_set>
 
@@ -101,11 +116,6 @@ inline std::string status_to_string(rmf_task::Event::Status status)
 // Forward declaration
 class TaskManager;
 
-using DynamicEventAction = rmf_task_msgs::action::DynamicEvent;
-using DynamicEventHandle = rclcpp_action::ServerGoalHandle<DynamicEventAction>;
-using DynamicEventStatus = rmf_task_msgs::msg::DynamicEventStatus;
-using DynamicEventStatusPub = rclcpp::Publisher<DynamicEventStatus>::SharedPtr;
-
 //==============================================================================
 struct DynamicEventCallbacks {
   std::function<void(std::shared_ptr<DynamicEventHandle>, std::shared_ptr<void>)> executor;
@@ -320,6 +330,12 @@ std::unordered_map<std::size_t, VertexStack> compute_stacked_vertices(
   const rmf_traffic::agv::Graph& graph,
   double max_merge_waypoint_distance);
 
+/// Same as above, using an index that was already made for the graph
+std::unordered_map<std::size_t, VertexStack> compute_stacked_vertices(
+  const rmf_traffic::agv::Graph& graph,
+  double max_merge_waypoint_distance,
+  const GraphSpatialIndex& index);
+
 //==============================================================================
 struct NavParams
 {
@@ -367,6 +383,23 @@ struct NavParams
     return tf_it->second.apply(position);
   }
 
+  /// Same as above for many positions on the same map, one in each column
+  std::optional<Eigen::Matrix3Xd> to_robot_coordinates(
+    const std::string& map,
+    const Eigen::Matrix3Xd& positions)
+  {
+    if (!transforms_to_robot_coords)
+      return positions;
+
+    const auto tf_it = transforms_to_robot_coords->find(map);
+    if (tf_it == transforms_to_robot_coords->end())
+    {
+      return std::nullopt;
+    }
+
+    return tf_it->second.apply_all(positions);
+  }
+
   void search_for_location(
     const std::string& map,
     Eigen::Vector3d position,
@@ -378,32 +411,35 @@ struct NavParams
     const Eigen::Vector3d position,
     const rmf_traffic::Time start_time) const;
 
+  /// Find the starts for a position the way rmf_traffic would, trying each
+  /// multiplier on the lane merge distance until one finds a start.
   rmf_traffic::agv::Plan::StartSet unfiltered_compute_plan_starts(
     const rmf_traffic::agv::Graph& graph,
     const std::string& map_name,
     const Eigen::Vector3d position,
-    const rmf_traffic::Time start_time) const
-  {
-    for (const double m : multipliers)
-    {
-      auto starts = rmf_traffic::agv::compute_plan_starts(
-        graph,
-        map_name,
-        position,
-        start_time,
-        max_merge_waypoint_distance,
-        m * max_merge_lane_distance,
-        min_lane_length);
-
-      if (!starts.empty())
-        return starts;
-    }
-
-    return {};
-  }
+    const rmf_traffic::Time start_time) const;
 
   std::unordered_map<std::size_t, VertexStack> stacked_vertices = {};
 
+  /// Lets the plan starts be found without scanning the whole graph. This is
+  /// made by find_stacked_vertices and only used while it matches the graph.
+  std::shared_ptr<const GraphSpatialIndex> spatial_index = nullptr;
+
+  /// The part of the graph around the last position that starts were found
+  /// for reaches this much farther than the merge distances, so that the
+  /// next position reports of a robot can reuse it until the robot has moved
+  /// this far.
+  double neighborhood_margin = 2.0;
+
+  // The part of the graph near the last position that starts were found for,
+  // along with the index that it came from.
+  mutable std::shared_ptr<const GraphSpatialIndex::Neighborhood>
+  _last_neighborhood = nullptr;
+  mutable std::shared_ptr<const GraphSpatialIndex> _last_neighborhood_index =
+    nullptr;
+
+  /// Find the stacked vertices of the graph and index the graph for finding
+  /// plan starts. This needs to be called again if the graph changes.
   void find_stacked_vertices(const rmf_traffic::agv::Graph& graph);
 
   std::string get_vertex_name(
@@ -475,6 +511,19 @@ struct MutexGroupData
   TimeMsg claim_time;
 };
 
+//==============================================================================
+/// How a robot reports its delays to the traffic schedule while it is
+/// following a path.
+struct DelayReporting
+{
+  /// The delay needs to change by more than this before it gets reported
+  rmf_traffic::Duration threshold = std::chrono::milliseconds(100);
+
+  /// The shortest time between two delay reports. When this is std::nullopt,
+  /// every change beyond the threshold gets reported right away.
+  std::optional<rmf_traffic::Duration> min_period = std::nullopt;
+};
+
 //==============================================================================
 class RobotContext
   : public std::enable_shared_from_this<RobotContext>,
@@ -611,6 +660,9 @@ public:
   struct GraphChange
   {
     std::vector<std::size_t> closed_lanes;
+
+    /// Lanes whose speed limit was added, changed, or removed
+    std::vector<std::size_t> speed_limited_lanes = {};
   };
   const rxcpp::observable<GraphChange>& observe_graph_change() const;
 
@@ -700,12 +752,114 @@ public:
   RobotContext& task_planner(
     const std::shared_ptr<const rmf_task::TaskPlanner> task_planner);
 
+  /// Get the record of planning problems for warming up the planner after a
+  /// restart. This will be a nullptr if the fleet is not keeping a record.
+  const std::shared_ptr<PlannerWarmStart>& planner_warm_start() const;
+
+  /// Set the record of planning problems for this robot
+  RobotContext& planner_warm_start(
+    std::shared_ptr<PlannerWarmStart> warm_start);
+
+  /// Get the fleet-wide warm up of the planner towards frequently used goals.
+  /// This will be a nullptr if the fleet does not warm up its goals.
+  const std::shared_ptr<GoalWarmup>& goal_warmup() const;
+
+  /// Set the warm up of frequently used goals for this robot
+  RobotContext& goal_warmup(std::shared_ptr<GoalWarmup> warmup);
+
+  /// Get the fleet-wide planning across floors. This will be a nullptr if the
+  /// fleet plans over the whole graph at once.
+  const std::shared_ptr<FloorPlanner>& floor_planner() const;
+
+  /// Set the planning across floors for this robot
+  RobotContext& floor_planner(std::shared_ptr<FloorPlanner> floor_planner);
+
+  /// Get the custom actions that this robot has been given but has not
+  /// started yet. This will be a nullptr if action pipelining is disabled.
+  const std::shared_ptr<ActionPipeline>& action_pipeline() const;
+
+  /// Set the pipeline of custom actions for this robot
+  RobotContext& action_pipeline(std::shared_ptr<ActionPipeline> pipeline);
+
+  /// Get the fleet-wide tuning of negotiation progress evaluators. This will
+  /// be a nullptr if the fleet uses the default evaluators.
+  const services::ProgressEvaluatorTuningPtr& evaluator_tuning() const;
+
+  /// Set the tuning of negotiation progress evaluators for this robot
+  RobotContext& evaluator_tuning(services::ProgressEvaluatorTuningPtr tuning);
+
+  /// Get how long to search for a schedule-compliant plan before starting to
+  /// move on the best feasible plan found so far. This will be std::nullopt
+  /// if the robot should wait for the search to finish.
+  std::optional<rmf_traffic::Duration> anytime_planning_deadline() const;
+
+  /// Set the anytime planning deadline for this robot
+  RobotContext& anytime_planning_deadline(
+    std::optional<rmf_traffic::Duration> deadline);
+
+  /// Get the fleet-wide decision about which outgoing messages get validated.
+  /// When this is a nullptr, every outgoing message gets validated.
+  const OutgoingValidationPtr& outgoing_validation() const;
+
+  /// Set the outgoing validation for this robot
+  RobotContext& outgoing_validation(OutgoingValidationPtr validation);
+
+  /// Get the fleet-wide outbox that validates and publishes outgoing API
+  /// messages away from the worker. When this is a nullptr, messages are
+  /// published on the worker.
+  const JsonOutboxPtr& json_outbox() const;
+
+  /// Set the JSON outbox for this robot
+  RobotContext& json_outbox(JsonOutboxPtr outbox);
+
+  /// Get how this robot reports its delays while following a path
+  const DelayReporting& delay_reporting() const;
+
+  /// Set how this robot reports its delays while following a path
+  RobotContext& delay_reporting(DelayReporting reporting);
+
+  /// Get the precomputed emergency pullover candidates of the fleet. This will
+  /// be a nullptr if the fleet does not precompute them.
+  const std::shared_ptr<const PulloverCandidates>& pullover_candidates() const;
+
+  /// Set the precomputed emergency pullover candidates for this robot
+  RobotContext& pullover_candidates(
+    std::shared_ptr<const PulloverCandidates> candidates);
+
+  /// Get the scheduler that orders the emergency pullover searches of the
+  /// fleet. This may be a nullptr, in which case the search starts right away.
+  const std::shared_ptr<EmergencyPulloverScheduler>&
+  emergency_pullover_scheduler() const;
+
+  /// Set the scheduler for the emergency pullover searches of this robot
+  RobotContext& emergency_pullover_scheduler(
+    std::shared_ptr<EmergencyPulloverScheduler> scheduler);
+
+  /// Get the charger model of the fleet. This may be a nullptr, in which case
+  /// charger decisions are made without it.
+  const std::shared_ptr<ChargerOccupancy>& charger_occupancy() const;
+
+  /// Set the charger model of the fleet of this robot
+  RobotContext& charger_occupancy(
+    std::shared_ptr<ChargerOccupancy> occupancy);
+
+  /// Hand the mutex groups of this robot over to the manager of its fleet,
+  /// which watches the mutex group states and refreshes the requests of the
+  /// robot.
+  RobotContext& mutex_group_manager(
+    const std::shared_ptr<MutexGroupManager>& manager);
+
   void set_lift_entry_watchdog(
     RobotUpdateHandle::Unstable::Watchdog watchdog,
-    rmf_traffic::Duration wait_duration);
+    rmf_traffic::Duration wait_duration,
+    rmf_traffic::Duration decision_time_to_live);
 
   const RobotUpdateHandle::Unstable::Watchdog& get_lift_watchdog() const;
 
+  /// The cache that asks the lift watchdog for decisions ahead of time. This
+  /// is a nullptr if there is no lift watchdog.
+  const std::shared_ptr<LiftWatchdogCache>& get_lift_watchdog_cache() const;
+
   rmf_traffic::Duration get_lift_rewait_duration() const;
 
   /// Set the current mode of the robot. This mode should correspond to a
@@ -813,10 +967,16 @@ public:
   /// Retain only the mutex groups listed in the set. Release all others.
   void retain_mutex_groups(const std::unordered_set<std::string>& groups);
 
+  /// Put an itinerary in the schedule. If plan_id is the current plan of the
+  /// robot then only the difference from the current itinerary is sent when
+  /// possible. Otherwise, or if the plan_id has become outdated, the whole
+  /// itinerary is set with a new plan ID.
   void schedule_itinerary(
     std::shared_ptr<rmf_traffic::PlanId> plan_id,
     rmf_traffic::schedule::Itinerary itinerary);
 
+  /// Put a stationary hold in the schedule. Renewing the hold of the current
+  /// plan at the same place is sent to the schedule as a delay.
   void schedule_hold(
     std::shared_ptr<rmf_traffic::PlanId> plan_id,
     rmf_traffic::Time time,
@@ -912,6 +1072,29 @@ public:
     rmf_task::Event::State::Status status,
     uint64_t id);
 
+  /// Decide whether to accept a dynamic event goal for this robot. This
+  /// should only be used by dynamic event action servers.
+  rclcpp_action::GoalResponse _handle_dynamic_event_goal(
+    const DynamicEventAction::Goal& goal);
+
+  /// Begin executing an accepted dynamic event goal for this robot. This
+  /// should only be used by dynamic event action servers.
+  void _handle_dynamic_event_accepted(
+    const std::shared_ptr<DynamicEventHandle>& handle);
+
+  /// Cancel a dynamic event goal of this robot. This should only be used by
+  /// dynamic event action servers.
+  rclcpp_action::CancelResponse _handle_dynamic_event_cancel(
+    const std::shared_ptr<DynamicEventHandle>& handle);
+
+  /// Respond to the mutex group assignments that concern this robot. This
+  /// should only be used by the MutexGroupManager.
+  void _check_mutex_groups(const rmf_fleet_msgs::msg::MutexGroupStates& states);
+
+  /// Publish the mutex group requests of this robot again. This should only be
+  /// used by the MutexGroupManager.
+  void _publish_mutex_group_requests();
+
   template<typename... Args>
   static std::shared_ptr<RobotContext> make(Args&&... args)
   {
@@ -940,28 +1123,6 @@ public:
           self->_check_door_supervisor(*msg);
         });
 
-    context->_mutex_group_sanity_check = context->_node->mutex_group_states()
-      .observe_on(rxcpp::identity_same_worker(context->_worker))
-      .subscribe([w = context->weak_from_this()](const auto& msg)
-        {
-          const auto self = w.lock();
-          if (!self)
-            return;
-
-          self->_check_mutex_groups(*msg);
-        });
-
-    context->_mutex_group_heartbeat = context->_node->try_create_wall_timer(
-      std::chrono::seconds(2),
-      [w = context->weak_from_this()]()
-      {
-        const auto self = w.lock();
-        if (!self)
-          return;
-
-        self->_publish_mutex_group_requests();
-      });
-
     context->_mutex_group_manual_release_sub =
       context->_node->create_subscription<
       rmf_fleet_msgs::msg::MutexGroupManualRelease>(
@@ -1002,6 +1163,11 @@ private:
     rmf_task::State state,
     std::shared_ptr<const rmf_task::TaskPlanner> task_planner);
 
+  /// Respond to a negotiation table right away on the current thread
+  void _respond(
+    const TableViewerPtr& table_viewer,
+    const ResponderPtr& responder);
+
   std::weak_ptr<RobotCommandHandle> _command_handle;
   std::vector<rmf_traffic::agv::Plan::Start> _location;
   std::vector<rmf_traffic::agv::Plan::Start> _most_recent_valid_location;
@@ -1047,10 +1213,23 @@ private:
   std::unique_ptr<std::mutex> _current_task_id_mutex =
     std::make_unique<std::mutex>();
   std::shared_ptr<const rmf_task::TaskPlanner> _task_planner;
+  std::shared_ptr<PlannerWarmStart> _planner_warm_start;
+  std::shared_ptr<GoalWarmup> _goal_warmup;
+  std::shared_ptr<FloorPlanner> _floor_planner;
+  std::shared_ptr<ActionPipeline> _action_pipeline;
+  services::ProgressEvaluatorTuningPtr _evaluator_tuning;
+  std::optional<rmf_traffic::Duration> _anytime_planning_deadline;
+  OutgoingValidationPtr _outgoing_validation;
+  JsonOutboxPtr _json_outbox;
+  DelayReporting _delay_reporting;
+  std::shared_ptr<const PulloverCandidates> _pullover_candidates;
+  std::shared_ptr<EmergencyPulloverScheduler> _emergency_pullover_scheduler;
+  std::shared_ptr<ChargerOccupancy> _charger_occupancy;
   std::weak_ptr<TaskManager> _task_manager;
   bool _robot_finishing_request = false;
 
   RobotUpdateHandle::Unstable::Watchdog _lift_watchdog;
+  std::shared_ptr<LiftWatchdogCache> _lift_watchdog_cache;
   rmf_traffic::Duration _lift_rewait_duration = std::chrono::seconds(0);
   std::unique_ptr<std::mutex> _commission_mutex =
     std::make_unique<std::mutex>();
@@ -1084,20 +1263,16 @@ private:
   std::optional<std::string> _holding_door;
   rmf_rxcpp::subscription_guard _door_subscription;
 
-  void _check_mutex_groups(const rmf_fleet_msgs::msg::MutexGroupStates& states);
   void _retain_mutex_groups(
     const std::unordered_set<std::string>& retain,
     std::unordered_map<std::string, TimeMsg>& _groups);
   void _release_mutex_group(const MutexGroupData& data) const;
-  void _publish_mutex_group_requests();
   void _handle_mutex_group_manual_release(
     const rmf_fleet_msgs::msg::MutexGroupManualRelease& msg);
   std::unordered_map<std::string, TimeMsg> _requesting_mutex_groups;
   std::unordered_map<std::string, TimeMsg> _locked_mutex_groups;
   rxcpp::subjects::subject<std::string> _mutex_group_lock_subject;
   rxcpp::observable<std::string> _mutex_group_lock_obs;
-  rclcpp::TimerBase::SharedPtr _mutex_group_heartbeat;
-  rmf_rxcpp::subscription_guard _mutex_group_sanity_check;
   rclcpp::Subscription<rmf_fleet_msgs::msg::MutexGroupManualRelease>::SharedPtr
     _mutex_group_manual_release_sub;
   std::chrono::steady_clock::time_point _last_active_task_time;
@@ -1117,6 +1292,7 @@ private:
   DynamicEventStatusPub _dynamic_event_status_pub;
   uint32_t _dynamic_event_seq;
   rclcpp_action::Server<DynamicEventAction>::SharedPtr _dynamic_event_server;
+  std::shared_ptr<DynamicEventServer> _shared_dynamic_event_server;
 };
 
 using RobotContextPtr = std::shared_ptr<RobotContext>;
@@ -746,9 +746,7 @@ void RobotUpdateHandle::log_info(std::string text)
   if (!context)
     return;
 
-  auto& report = context->reporting();
-  std::lock_guard<std::mutex> lock(report.mutex());
-  report.log().info(std::move(text));
+  context->reporting().push(rmf_task::Log::Tier::Info, std::move(text));
 }
 
 //==============================================================================
@@ -758,9 +756,7 @@ void RobotUpdateHandle::log_warning(std::string text)
   if (!context)
     return;
 
-  auto& report = context->reporting();
-  std::lock_guard<std::mutex> lock(report.mutex());
-  report.log().warn(std::move(text));
+  context->reporting().push(rmf_task::Log::Tier::Warning, std::move(text));
 }
 
 //==============================================================================
@@ -770,9 +766,7 @@ void RobotUpdateHandle::log_error(std::string text)
   if (!context)
     return;
 
-  auto& report = context->reporting();
-  std::lock_guard<std::mutex> lock(report.mutex());
-  report.log().error(std::move(text));
+  context->reporting().push(rmf_task::Log::Tier::Error, std::move(text));
 }
 
 //==============================================================================
@@ -1087,14 +1081,17 @@ auto RobotUpdateHandle::Unstable::be_stubborn() -> Stubbornness
 //==============================================================================
 void RobotUpdateHandle::Unstable::set_lift_entry_watchdog(
   Watchdog watchdog,
-  rmf_traffic::Duration wait_duration)
+  rmf_traffic::Duration wait_duration,
+  rmf_traffic::Duration decision_time_to_live)
 {
   if (const auto context = _pimpl->get_context())
   {
     context->worker().schedule(
-      [context, watchdog = std::move(watchdog), wait_duration](const auto&)
+      [context, watchdog = std::move(watchdog), wait_duration,
+      decision_time_to_live](const auto&)
       {
-        context->set_lift_entry_watchdog(watchdog, wait_duration);
+        context->set_lift_entry_watchdog(
+          watchdog, wait_duration, decision_time_to_live);
       });
   }
 }
@@ -1261,6 +1258,16 @@ void RobotUpdateHandle::ActionExecution::set_automatic_cancel(bool on)
   }
 }
 
+//==============================================================================
+std::optional<std::pair<std::string, nlohmann::json>>
+RobotUpdateHandle::ActionExecution::next_action() const
+{
+  if (!_pimpl->data)
+    return std::nullopt;
+
+  return _pimpl->data->next_action;
+}
+
 //==============================================================================
 auto RobotUpdateHandle::ActionExecution::identifier() const
 -> ConstActivityIdentifierPtr
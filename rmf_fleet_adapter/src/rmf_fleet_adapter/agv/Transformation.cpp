@@ -104,5 +104,36 @@ Eigen::Vector3d Transformation::apply_inverse(
   return Eigen::Vector3d(p[0], p[1], angle);
 }
 
+//==============================================================================
+namespace {
+Eigen::Matrix3Xd apply_affine(
+  const Eigen::Affine2d& transform,
+  const double rotation,
+  const Eigen::Matrix3Xd& positions)
+{
+  Eigen::Matrix3Xd output(3, positions.cols());
+  output.topRows<2>().noalias() = transform.linear() * positions.topRows<2>();
+  output.topRows<2>().colwise() += transform.translation();
+  for (Eigen::Index i = 0; i < positions.cols(); ++i)
+    output(2, i) = rmf_utils::wrap_to_pi(positions(2, i) + rotation);
+
+  return output;
+}
+} // anonymous namespace
+
+//==============================================================================
+Eigen::Matrix3Xd Transformation::apply_all(
+  const Eigen::Matrix3Xd& positions) const
+{
+  return apply_affine(_pimpl->transform, _pimpl->rotation, positions);
+}
+
+//==============================================================================
+Eigen::Matrix3Xd Transformation::apply_inverse_all(
+  const Eigen::Matrix3Xd& positions) const
+{
+  return apply_affine(_pimpl->transform_inv, -_pimpl->rotation, positions);
+}
+
 } // namespace agv
 } // namespace rmf_fleet_adapter
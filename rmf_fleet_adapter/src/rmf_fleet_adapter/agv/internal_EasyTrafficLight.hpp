@@ -38,6 +38,8 @@
 
 #include <rmf_rxcpp/RxJobs.hpp>
 
+#include <list>
+
 #include "Node.hpp"
 
 namespace rmf_fleet_adapter {
@@ -161,10 +163,24 @@ public:
     std::recursive_mutex mutex;
     std::unique_lock<std::recursive_mutex> lock();
 
+    // Planners for the most recently followed paths, most recent first. Robots
+    // that drive the same loops keep getting the same graphs, so reusing the
+    // planner keeps its heuristic caches warm.
+    struct CachedPlanner
+    {
+      std::vector<Waypoint> path;
+      std::shared_ptr<rmf_traffic::agv::Planner> planner;
+    };
+    std::list<CachedPlanner> planner_cache;
+    static constexpr std::size_t PlannerCacheSize = 8;
+
     Shared(Hooks hooks);
 
     void follow_new_path(const std::vector<Waypoint>& new_path);
 
+    std::shared_ptr<rmf_traffic::agv::Planner> find_cached_planner(
+      const std::vector<Waypoint>& path);
+
     void make_plan(
       std::size_t request_path_version,
       rmf_traffic::agv::Plan::Start start);
@@ -218,7 +234,13 @@ public:
       const rmf_traffic::schedule::Negotiator::TableViewerPtr& table_viewer,
       const rmf_traffic::schedule::Negotiator::ResponderPtr& responder);
 
-    void publish_fleet_state() const;
+    void publish_fleet_state();
+
+    std::optional<rmf_fleet_msgs::msg::RobotState> make_robot_state() const;
+
+    // Set when the robot's state was published by update_all, so that the
+    // next periodic publication can be skipped.
+    bool published_in_batch = false;
   };
 
   class Negotiator : public rmf_traffic::schedule::Negotiator
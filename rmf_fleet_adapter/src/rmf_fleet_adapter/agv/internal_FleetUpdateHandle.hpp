@@ -23,6 +23,7 @@
 #include <rmf_task_msgs/msg/loop.hpp>
 
 #include <rmf_task_ros2/bidding/AsyncBidder.hpp>
+#include <rmf_task_ros2/bidding/BatchedNotice.hpp>
 
 #include <rmf_task_msgs/msg/dispatch_command.hpp>
 #include <rmf_task_msgs/msg/dispatch_ack.hpp>
@@ -38,6 +39,7 @@
 #include <rmf_fleet_msgs/msg/lane_states.hpp>
 #include <rmf_fleet_msgs/msg/charging_assignments.hpp>
 #include <rmf_fleet_msgs/msg/emergency_signal.hpp>
+#include <rmf_fleet_msgs/msg/robot_state.hpp>
 #include <std_msgs/msg/bool.hpp>
 
 #include <rmf_fleet_adapter/agv/FleetUpdateHandle.hpp>
@@ -45,7 +47,14 @@
 
 #include "Node.hpp"
 #include "RobotContext.hpp"
+#include "MutexGroupManager.hpp"
 #include "../TaskManager.hpp"
+#include "../TravelTimeTable.hpp"
+#include "../EmergencyPulloverScheduler.hpp"
+#include "../PulloverCandidates.hpp"
+#include "../TaskQueueBackup.hpp"
+#include "../ChargingSchedule.hpp"
+#include "../TaskDescriptionCache.hpp"
 #include <rmf_websocket/BroadcastClient.hpp>
 
 #include <rmf_traffic/schedule/Mirror.hpp>
@@ -70,9 +79,13 @@
 
 #include <rmf_fleet_adapter/schemas/event_description__perform_action.hpp>
 
+#include <array>
+#include <deque>
 #include <iostream>
+#include <list>
 #include <unordered_set>
 #include <optional>
+#include <thread>
 #include <malloc.h>
 
 namespace rmf_fleet_adapter {
@@ -115,6 +128,10 @@ struct TaskDeserialization
   std::shared_ptr<std::unordered_map<
       std::string, FleetUpdateHandle::ConsiderRequest>> consider_actions;
 
+  // Task descriptions that were already deserialized. This must be cleared
+  // whenever any of the deserializers or consider callbacks change.
+  std::shared_ptr<TaskDescriptionCache> description_cache;
+
   void add_schema(const nlohmann::json& schema);
 
   nlohmann::json_schema::json_validator make_validator(
@@ -214,6 +231,38 @@ struct Expectations
   std::vector<rmf_task::ConstRequestPtr> pending_requests;
 };
 
+//==============================================================================
+// The parts of a robot's state that decide whether its entry in the fleet
+// state update needs to be built again
+struct RobotStateSummary
+{
+  struct Location
+  {
+    std::string map;
+    double x;
+    double y;
+    double yaw;
+  };
+
+  std::string status;
+  std::string task_id;
+  double battery = 0.0;
+  std::optional<Location> location;
+  std::vector<const void*> issues;
+  std::array<bool, 3> commission = {false, false, false};
+  std::vector<std::string> locked_mutex_groups;
+  std::vector<std::string> requesting_mutex_groups;
+};
+
+//==============================================================================
+struct FleetStateChangeDetection
+{
+  rmf_traffic::Duration heartbeat_period;
+  double position_threshold;
+  double yaw_threshold;
+  double battery_threshold;
+};
+
 //==============================================================================
 // Map from the robot instance to its proposed assignment of tasks
 using TaskAssignments = std::unordered_map<
@@ -260,6 +309,9 @@ public:
   AcceptDeliveryRequest accept_delivery = nullptr;
   std::unordered_map<RobotContextPtr,
     std::shared_ptr<TaskManager>> task_managers = {};
+  // Index of the robots in task_managers by name, so that messages which refer
+  // to individual robots do not need to search the whole fleet.
+  std::unordered_map<std::string, RobotContextPtr> robots_by_name = {};
 
   std::shared_ptr<rmf_websocket::BroadcastClient> broadcast_client = nullptr;
 
@@ -278,6 +330,41 @@ public:
     fleet_state_pub = nullptr;
   rclcpp::TimerBase::SharedPtr fleet_state_topic_publish_timer = nullptr;
   rclcpp::TimerBase::SharedPtr fleet_state_update_timer = nullptr;
+
+  struct RobotStateRecord
+  {
+    RobotStateSummary summary;
+    nlohmann::json json;
+  };
+
+  // When change detection is on, robots whose state has not changed reuse
+  // their previous entry in the fleet state update, and updates where nothing
+  // has changed are only sent once per heartbeat period.
+  std::optional<FleetStateChangeDetection> fleet_state_change_detection;
+  mutable std::unordered_map<std::string, RobotStateRecord>
+  robot_state_records;
+  mutable std::optional<rmf_traffic::Time> last_fleet_state_update;
+
+  // Robots that are idle or charging get their state refreshed at these
+  // periods instead of every time the fleet state is published. Robots that
+  // are working or using a lift are always refreshed.
+  std::optional<rmf_traffic::Duration> idle_state_period;
+  std::optional<rmf_traffic::Duration> charging_state_period;
+
+  struct RobotStateRefresh
+  {
+    std::optional<rmf_traffic::Time> update_time;
+    nlohmann::json update_json;
+    std::optional<rmf_traffic::Time> topic_time;
+    rmf_fleet_msgs::msg::RobotState topic_state;
+  };
+  mutable std::unordered_map<std::string, RobotStateRefresh>
+  robot_state_refresh;
+
+  /// How long the state of a robot may go without being refreshed. This is
+  /// std::nullopt if it should be refreshed every time.
+  std::optional<rmf_traffic::Duration> refresh_period(
+    const TaskManager& mgr) const;
   rclcpp::TimerBase::SharedPtr memory_trim_timer = nullptr;
 
   rxcpp::subscription emergency_sub;
@@ -319,6 +406,19 @@ public:
   double current_assignment_cost = 0.0;
   // Map to store task id with assignments for BidNotice
   std::unordered_map<std::string, TaskAssignments> bid_notice_assignments = {};
+  // The tasks of bid_notice_assignments from oldest to newest, only kept while
+  // there is a cap on how many bids may wait for an award. It may still name
+  // tasks that were awarded or cancelled since.
+  std::optional<std::size_t> max_bid_assignments;
+  std::deque<std::string> bid_notice_order;
+
+  // Caps on the other records that grow with the lifetime of the fleet
+  std::size_t max_executed_tasks = 100;
+  std::optional<std::size_t> max_unsent_log_entries;
+  mutable std::size_t dropped_log_entries = 0;
+  // Tasks of a batched bid that were assigned when another task of their batch
+  // was awarded
+  std::unordered_set<std::string> assigned_with_batch = {};
 
   // This is checked before and after the task reassignment procedure to ensure
   // that no new task came in from the dispatcher while the reassignment was
@@ -327,6 +427,12 @@ public:
   std::vector<rmf_task::ConstRequestPtr> unassigned_requests;
   rxcpp::schedulers::worker reassignment_worker;
 
+  // When this has a value, reassignments only replan the affected robots and
+  // up to this many robots in total, within the time budget.
+  std::optional<std::size_t> incremental_reassignment_robots;
+  rmf_traffic::Duration incremental_reassignment_budget =
+    std::chrono::seconds(5);
+
   using BidNoticeMsg = rmf_task_msgs::msg::BidNotice;
 
   using DispatchCmdMsg = rmf_task_msgs::msg::DispatchCommand;
@@ -344,18 +450,93 @@ public:
   using GraphMsg = rmf_building_map_msgs::msg::Graph;
   rclcpp::Publisher<GraphMsg>::SharedPtr nav_graph_pub = nullptr;
 
-  mutable rmf_task::Log::Reader log_reader = {};
-
   using LaneStates = rmf_fleet_msgs::msg::LaneStates;
   rclcpp::Publisher<LaneStates>::SharedPtr lane_states_pub = nullptr;
+  using LaneStateChangesMsg = std_msgs::msg::String;
+  rclcpp::Publisher<LaneStateChangesMsg>::SharedPtr lane_state_changes_pub =
+    nullptr;
   std::unordered_map<std::size_t, double> speed_limited_lanes = {};
   std::unordered_set<std::size_t> closed_lanes = {};
 
-  std::shared_ptr<AllocateTasks> calculate_bid;
-  rmf_rxcpp::subscription_guard calculate_bid_subscription;
+  // A bid notice that is waiting for its allocation to be calculated
+  struct PendingBid
+  {
+    // For a batched bid notice, this is the ID of the batch
+    std::string task_id;
+    std::vector<rmf_task::ConstRequestPtr> requests;
+    rmf_task_ros2::bidding::AsyncBidder::Respond respond;
+    bool dry_run;
+    // Becomes true once the auction has no more use for this bid
+    rmf_task_ros2::bidding::AsyncBidder::IsCancelled is_cancelled;
+    // The bid needs to be calculated by this time to make it into the auction
+    std::chrono::steady_clock::time_point deadline;
+  };
+
+  // How long before the end of an auction's time window a bid should be ready
+  static constexpr std::chrono::milliseconds BidResponseMargin =
+    std::chrono::milliseconds(200);
+
+  /// Get the time that a bid for this notice needs to be ready by
+  static std::chrono::steady_clock::time_point bid_deadline(
+    const BidNoticeMsg& notice);
+
+  struct BidCalculation
+  {
+    std::shared_ptr<AllocateTasks> job;
+    rmf_rxcpp::subscription_guard subscription;
+  };
+
+  // Bids are only touched on the worker. Up to max_concurrent_bids of them
+  // are calculated at once, and the rest wait in pending_bids.
+  static constexpr std::size_t MaxPendingBids = 100;
+  std::size_t max_concurrent_bids = 1;
+  // Each task allocation may use up to this many threads
+  std::size_t allocation_threads = 1;
+  std::deque<PendingBid> pending_bids;
+  std::unordered_map<std::string, BidCalculation> calculating_bids;
 
   rclcpp::TimerBase::SharedPtr memory_utilization_timer;
   std::optional<std::size_t> planner_cache_reset_size;
+  std::shared_ptr<PlannerWarmStart> planner_warm_start;
+  std::shared_ptr<GoalWarmup> goal_warmup;
+  std::shared_ptr<FloorPlanner> floor_planner;
+  rmf_rxcpp::subscription_guard floor_planner_lift_sub;
+  bool action_pipelining = false;
+  std::shared_ptr<TaskQueueBackup> task_queue_backup;
+  rclcpp::TimerBase::SharedPtr task_queue_backup_timer;
+  std::shared_ptr<ChargingSchedule> charging_schedule;
+  rclcpp::TimerBase::SharedPtr charging_schedule_timer;
+  services::ProgressEvaluatorTuningPtr evaluator_tuning;
+  std::optional<rmf_traffic::Duration> anytime_planning_deadline;
+  DelayReporting delay_reporting;
+  bool precompute_travel_times = false;
+  std::shared_ptr<TravelTimeTable> travel_time_table;
+  std::optional<std::size_t> max_pullover_candidates;
+  std::shared_ptr<const PulloverCandidates> pullover_candidates;
+  std::shared_ptr<EmergencyPulloverScheduler> emergency_pullover_scheduler;
+  std::shared_ptr<ChargerOccupancy> charger_occupancy =
+    ChargerOccupancy::make();
+  std::shared_ptr<MutexGroupManager> mutex_group_manager;
+
+  // Planners that were made for other sets of closed lanes, most recently
+  // used first, so that opening or closing lanes can go back to a planner
+  // whose caches are already warm.
+  struct ClosurePlanner
+  {
+    std::vector<std::size_t> closed_lanes;
+    std::shared_ptr<const rmf_traffic::agv::Planner> planner;
+    std::shared_ptr<TravelTimeTable> travel_time_table;
+  };
+  std::size_t max_closure_planners = 0;
+  std::list<ClosurePlanner> closure_planners;
+
+  OutgoingValidationPtr outgoing_validation =
+    std::make_shared<OutgoingValidation>();
+
+  // Validates and publishes the fleet's outgoing API messages on a low
+  // priority thread so that reporting never delays the worker
+  JsonOutboxPtr json_outbox = JsonOutbox::make();
+  std::optional<rmf_traffic::Duration> task_state_publish_interval;
 
   template<typename... Args>
   static std::shared_ptr<FleetUpdateHandle> make(Args&&... args)
@@ -399,6 +580,17 @@ public:
     handle->_pimpl->emergency_planner =
       std::make_shared<std::shared_ptr<const rmf_traffic::agv::Planner>>(nullptr);
 
+    // Each emergency pullover search already spreads its parking spots across
+    // threads, so running more searches than there are cores only slows down
+    // the robots that need to get out of the way first.
+    handle->_pimpl->emergency_pullover_scheduler =
+      EmergencyPulloverScheduler::make(
+      handle->_pimpl->worker,
+      std::max(1u, std::thread::hardware_concurrency()));
+
+    handle->_pimpl->mutex_group_manager =
+      MutexGroupManager::make(handle->_pimpl->node, handle->_pimpl->worker);
+
     // TODO(MXG): This is a very crude implementation. We create a dummy set of
     // task planner parameters to stand in until the user sets the task planner
     // parameters. We'll distribute this shared_ptr to the robot contexts and
@@ -449,13 +641,17 @@ public:
       DispatchAckTopicName, reliable_transient_qos);
 
     // Make a dispatch bidder
-    handle->_pimpl->bidder = rmf_task_ros2::bidding::AsyncBidder::make(
+    handle->_pimpl->bidder =
+      rmf_task_ros2::bidding::AsyncBidder::make_cancellable(
       handle->_pimpl->node,
       [w = handle->weak_from_this()](
-        const auto& msg, auto respond)
+        const auto& msg, auto respond, auto is_cancelled)
       {
         if (const auto self = w.lock())
-          self->_pimpl->bid_notice_cb(msg, std::move(respond));
+        {
+          self->_pimpl->bid_notice_cb(
+            msg, std::move(respond), std::move(is_cancelled));
+        }
       });
 
     // Publisher for navigation graph
@@ -482,6 +678,13 @@ public:
       transient_qos);
     handle->_pimpl->publish_lane_states();
 
+    // Lane state changes only make sense to subscribers that already have
+    // the full lane states, so they are not kept for late subscribers.
+    handle->_pimpl->lane_state_changes_pub =
+      handle->_pimpl->node->create_publisher<LaneStateChangesMsg>(
+      LaneStateChangesTopicName,
+      rclcpp::QoS(10).reliable());
+
     // Populate charging waypoints
     const auto& graph = (*handle->_pimpl->planner)->get_configuration().graph();
     for (std::size_t i = 0; i < graph.num_waypoints(); ++i)
@@ -519,10 +722,44 @@ public:
           for (const auto& [conext, mgr] : handle->_pimpl->task_managers)
           {
             // Publish all task logs to the server
-            task_logs.push_back(mgr->task_log_updates());
+            auto logs = mgr->task_log_updates();
+            task_logs.insert(
+              task_logs.end(),
+              std::make_move_iterator(logs.begin()),
+              std::make_move_iterator(logs.end()));
           }
           return task_logs;
-        });
+        },
+        handle->_pimpl->node->websocket_encoding());
+
+      if (handle->_pimpl->node->separate_log_channel())
+        handle->_pimpl->broadcast_client->set_bulk_channel(true);
+
+      handle->_pimpl->broadcast_client->set_diagnostics_period(
+        handle->_pimpl->node->websocket_diagnostics_period());
+
+      if (handle->_pimpl->node->websocket_resync())
+      {
+        handle->_pimpl->broadcast_client->set_resync_callback(
+          [handle](const nlohmann::json& last_seen)
+          {
+            const auto seen_it = last_seen.find("task_logs");
+            const auto& task_logs_seen =
+              seen_it != last_seen.end() && seen_it->is_object() ?
+              *seen_it : nlohmann::json::object();
+
+            std::vector<nlohmann::json> task_logs;
+            for (const auto& [context, mgr] : handle->_pimpl->task_managers)
+            {
+              auto logs = mgr->task_log_updates(task_logs_seen);
+              task_logs.insert(
+                task_logs.end(),
+                std::make_move_iterator(logs.begin()),
+                std::make_move_iterator(logs.end()));
+            }
+            return task_logs;
+          });
+      }
     }
 
     handle->_pimpl->fleet_state_update_pub =
@@ -637,6 +874,24 @@ public:
           "%s",
           ss.str().c_str());
 
+        self->_pimpl->worker.schedule(
+          [w = self->weak_from_this()](const auto&)
+          {
+            if (const auto self = w.lock())
+              self->_pimpl->report_memory_footprint();
+          });
+
+        if (const auto& warm_start = self->_pimpl->planner_warm_start)
+        {
+          if (!warm_start->save())
+          {
+            RCLCPP_WARN(
+              self->_pimpl->node->get_logger(),
+              "Unable to save the planner warm start record of fleet [%s]",
+              self->_pimpl->name.c_str());
+          }
+        }
+
         const std::optional<std::size_t> reset_size = 
           self->_pimpl->planner_cache_reset_size;
         if (reset_size.has_value())
@@ -654,6 +909,9 @@ public:
               *reset_size);
             planner->clear_differential_drive_cache();
             planner->clear_inner_cache();
+
+            // Keep the goals that the fleet uses most ready to plan for
+            self->_pimpl->warm_up_goals();
           }
         }
       });
@@ -671,13 +929,33 @@ public:
     return *handle._pimpl;
   }
 
+  /// Publish the full navigation graph. This is only done once at startup on
+  /// a transient local topic. Lane closures and speed limits are published
+  /// through publish_lane_states instead of republishing the whole graph.
   void publish_nav_graph() const;
 
   void dock_summary_cb(const DockSummary::SharedPtr& msg);
 
   void bid_notice_cb(
     const BidNoticeMsg& msg,
-    rmf_task_ros2::bidding::AsyncBidder::Respond respond);
+    rmf_task_ros2::bidding::AsyncBidder::Respond respond,
+    rmf_task_ros2::bidding::AsyncBidder::IsCancelled is_cancelled = nullptr);
+
+  /// Parse and validate a single task request of a bid notice. This returns
+  /// nullptr if this fleet will not bid on it.
+  rmf_task::ConstRequestPtr convert_bid_request(
+    const std::string& task_id,
+    const std::string& request,
+    std::vector<std::string>& errors) const;
+
+  /// Queue up a bid to be calculated, unless the same task is already queued
+  /// or being calculated.
+  void queue_bid(PendingBid bid);
+
+  /// Start calculating queued bids until there are no free slots left.
+  void start_pending_bids();
+
+  void start_bid_calculation(PendingBid bid);
 
   void dispatch_command_cb(const DispatchCmdMsg::SharedPtr msg);
 
@@ -694,17 +972,49 @@ public:
     TaskAssignments& assignments,
     std::string* report_error = nullptr) const;
 
+  /// Reassign the dispatched tasks of the fleet. In the incremental mode,
+  /// only the affected robots and enough lightly loaded robots to take on the
+  /// unassigned requests will be replanned, and the queues of every other
+  /// robot are left as they are.
   void reassign_dispatched_tasks(
     std::function<void()> on_success,
     // argument is a vector of error messages from the planner
-    std::function<void(std::vector<std::string>)> on_failure);
+    std::function<void(std::vector<std::string>)> on_failure,
+    std::vector<RobotContextPtr> affected_robots = {});
+
+  /// Get the expectations of only the affected robots and the lightly loaded
+  /// robots that the incremental reassignment will replan.
+  Expectations incremental_expectations(
+    const std::vector<RobotContextPtr>& affected_robots) const;
 
   void publish_fleet_state_topic() const;
 
+  /// Publish the full lane states of the fleet. The lane states topic is
+  /// transient local, so late subscribers always get the latest full state.
   void publish_lane_states() const;
 
+  /// The lanes whose state was changed by one request
+  struct LaneStateChanges
+  {
+    std::vector<std::size_t> closed;
+    std::vector<std::size_t> opened;
+    std::vector<std::pair<std::size_t, double>> speed_limited;
+    std::vector<std::size_t> speed_limits_removed;
+  };
+
+  /// Publish the full lane states, and also publish only what changed on the
+  /// lane state changes topic, for subscribers that have already received the
+  /// full state and want to follow updates without processing it again.
+  void publish_lane_states(const LaneStateChanges& changes) const;
+
   void update_fleet() const;
 
+  /// Drop the assignments of the oldest bids beyond max_bid_assignments.
+  void trim_bid_notice_assignments();
+
+  /// Log the sizes of the records that grow while the fleet runs.
+  void report_memory_footprint() const;
+
   void update_fleet_state() const;
   void update_fleet_logs() const;
   void handle_emergency(const bool is_emergency);
@@ -712,8 +1022,50 @@ public:
     std::shared_ptr<rmf_fleet_msgs::msg::EmergencySignal> is_emergency);
   void update_emergency_planner();
 
+  /// Bring the emergency planner up to date after the planner or the lift
+  /// emergency levels have changed. When emergency pullovers are precomputed,
+  /// this always makes a new emergency planner and starts finding pullover
+  /// candidates with it, so that it is ready before any emergency happens.
+  /// Otherwise the emergency planner is only made during an emergency.
+  void refresh_emergency_planner();
+
+  /// Start filling a new travel time table for the current planner if travel
+  /// times are being precomputed. This needs to be called whenever the
+  /// planner is replaced.
+  void update_travel_time_table();
+
+  /// Start warming up the planner towards the goals that the fleet uses most,
+  /// if the fleet does that.
+  void warm_up_goals();
+
+  /// Refill the caches that belong to the planner after it was replaced.
+  void planner_changed();
+
+  /// Get the currently closed lanes in order
+  std::vector<std::size_t> sorted_closed_lanes() const;
+
+  /// Remember the current planner as the planner for previous_closed_lanes,
+  /// then switch to a remembered planner for the lanes that are closed now.
+  /// Returns false if no planner is remembered for them, in which case the
+  /// caller needs to make a new one.
+  bool reuse_closure_planner(std::vector<std::size_t> previous_closed_lanes);
+
   void update_charging_assignments(const ChargingAssignments& assignments);
 
+  /// Give every robot the charger that the charging schedule assigns to it
+  /// right now
+  void apply_charging_schedule();
+
+  /// Set the charger of an expected state to the one that the charging
+  /// schedule assigns to the robot at the time of the state
+  void plan_charging(ExpectedState& expected) const;
+
+  /// Save the queues of every robot to the task queue backup
+  void back_up_task_queues();
+
+  /// Give a robot the tasks that the task queue backup loaded for it
+  void restore_task_queue(const TaskManagerPtr& mgr);
+
   nlohmann::json_schema::json_validator make_validator(
     const nlohmann::json& schema) const;
 
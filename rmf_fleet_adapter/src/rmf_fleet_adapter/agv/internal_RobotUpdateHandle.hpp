@@ -159,6 +159,10 @@ public:
     bool automatic_cancel;
     std::optional<ScheduleOverride> schedule_override;
 
+    // The action that will run right after this one, if action pipelining
+    // knows of one
+    std::optional<std::pair<std::string, nlohmann::json>> next_action;
+
     void update_location(
       const std::string& map,
       Eigen::Vector3d location)
@@ -19,91 +19,142 @@
 #include <unordered_map>
 #include <yaml-cpp/yaml.h>
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <optional>
+#include <sstream>
+#include <type_traits>
+#include <vector>
 
 namespace rmf_fleet_adapter {
 namespace agv {
 
 using LiftPropertiesPtr = rmf_traffic::agv::Graph::LiftPropertiesPtr;
 
+namespace {
+
 //==============================================================================
-rmf_traffic::agv::Graph parse_graph(
-  const std::string& graph_file,
-  const rmf_traffic::agv::VehicleTraits& vehicle_traits)
+// Everything that parse_graph reads out of a nav graph file. Building the
+// graph from this is cheap compared to parsing the YAML, so this is what the
+// binary cache stores. It does not depend on the vehicle traits, so one cache
+// can be shared by fleets with different traits.
+struct GraphDescription
 {
-  const YAML::Node graph_config = YAML::LoadFile(graph_file);
-  if (!graph_config)
+  struct Lift
   {
-    throw std::runtime_error("Failed to load graph file [" + graph_file + "]");
-  }
+    std::string name;
+    double x, y, orientation;
+    double width, depth;
+  };
+
+  struct Door
+  {
+    std::string name;
+    double x0, y0, x1, y1;
+    std::string map;
+  };
+
+  struct Vertex
+  {
+    double x, y;
+    std::string name;
+    bool is_parking_spot = false;
+    bool is_holding_point = false;
+    bool is_passthrough_point = false;
+    bool is_charger = false;
+    std::string mutex;
+    std::string lift;
+    std::optional<double> merge_radius;
+  };
+
+  struct Lane
+  {
+    std::size_t begin, end;
+    std::optional<std::string> orientation_constraint;
+    std::optional<std::string> demo_mock_floor_name;
+    std::optional<std::string> demo_mock_lift_name;
+    std::optional<std::string> door_name;
+    std::string dock_name;
+    std::optional<double> speed_limit;
+    std::string mutex;
+  };
+
+  struct Level
+  {
+    std::string map_name;
+    std::vector<Vertex> vertices;
+    std::vector<Lane> lanes;
+  };
 
-  rmf_traffic::agv::Graph graph;
   bool has_lifts = false;
+  bool has_doors = false;
+  std::vector<Lift> lifts;
+  std::vector<Door> doors;
+  std::vector<Level> levels;
+};
+
+//==============================================================================
+template<typename T>
+std::optional<T> option(const YAML::Node& options, const char* key)
+{
+  if (const YAML::Node node = options[key])
+    return node.as<T>();
+
+  return std::nullopt;
+}
+
+//==============================================================================
+GraphDescription describe_graph(
+  const YAML::Node& graph_config,
+  const std::string& graph_file)
+{
+  GraphDescription desc;
   const YAML::Node lifts_yaml = graph_config["lifts"];
-  if (!lifts_yaml)
+  if (lifts_yaml)
   {
-    std::cout << "Your navigation graph does not provide lift information. "
-              <<
-      "This may cause problems with behaviors around lifts. Please consider "
-              <<
-      "regenerating your navigration graph with the latest version of "
-              << "rmf_building_map_tools (from the rmf_traffic_editor repo)."
-              << std::endl;
-  }
-  else
-  {
-    has_lifts = true;
+    desc.has_lifts = true;
     for (const auto& lift : lifts_yaml)
     {
-      const std::string& name = lift.first.as<std::string>();
       const YAML::Node& properties_yaml = lift.second;
-
       const YAML::Node& position_yaml = properties_yaml["position"];
-      const Eigen::Vector2d location(
-        position_yaml[0].as<double>(),
-        position_yaml[1].as<double>());
-      const double orientation = position_yaml[2].as<double>();
-
       const YAML::Node& dims_yaml = properties_yaml["dims"];
-      const Eigen::Vector2d dimensions(
-        dims_yaml[0].as<double>(),
-        dims_yaml[1].as<double>());
-
-      graph.set_known_lift(rmf_traffic::agv::Graph::LiftProperties(
-          name, location, orientation, dimensions));
+      desc.lifts.push_back(
+        {
+          lift.first.as<std::string>(),
+          position_yaml[0].as<double>(),
+          position_yaml[1].as<double>(),
+          position_yaml[2].as<double>(),
+          dims_yaml[0].as<double>(),
+          dims_yaml[1].as<double>()
+        });
     }
   }
 
   const YAML::Node doors_yaml = graph_config["doors"];
-  if (!doors_yaml)
-  {
-    std::cout << "Your navigation graph does not provide door information. "
-              <<
-      "This may cause problems with behaviors around doors. Please consider "
-              <<
-      "regenerating your navigration graph with the latest version of "
-              << "rmf_building_map_tools (from the rmf_traffic_editor repo)."
-              << std::endl;
-  }
-  else
+  if (doors_yaml)
   {
+    desc.has_doors = true;
     for (const auto& door : doors_yaml)
     {
-      const std::string& name = door.first.as<std::string>();
       const YAML::Node properties_yaml = door.second;
       const YAML::Node& endpoints_yaml = properties_yaml["endpoints"];
-      std::string map = properties_yaml["map"].as<std::string>();
-
       const YAML::Node& p0_yaml = endpoints_yaml[0];
-      const auto p0 = Eigen::Vector2d(
-        p0_yaml[0].as<double>(), p0_yaml[1].as<double>());
-
       const YAML::Node& p1_yaml = endpoints_yaml[1];
-      const auto p1 = Eigen::Vector2d(
-        p1_yaml[0].as<double>(), p1_yaml[1].as<double>());
-
-      graph.set_known_door(
-        rmf_traffic::agv::Graph::DoorProperties(name, p0, p1, std::move(map)));
+      desc.doors.push_back(
+        {
+          door.first.as<std::string>(),
+          p0_yaml[0].as<double>(), p0_yaml[1].as<double>(),
+          p1_yaml[0].as<double>(), p1_yaml[1].as<double>(),
+          properties_yaml["map"].as<std::string>()
+        });
     }
   }
 
@@ -125,6 +176,109 @@ rmf_traffic::agv::Graph parse_graph(
     // *INDENT-ON*
   }
 
+  for (const auto& level : levels)
+  {
+    auto& level_desc = desc.levels.emplace_back();
+    level_desc.map_name = level.first.as<std::string>();
+
+    const YAML::Node& vertices = level.second["vertices"];
+    for (const auto& vertex : vertices)
+    {
+      auto& v = level_desc.vertices.emplace_back();
+      v.x = vertex[0].as<double>();
+      v.y = vertex[1].as<double>();
+
+      const YAML::Node& options = vertex[2];
+      v.name = option<std::string>(options, "name").value_or("");
+      v.is_parking_spot =
+        option<bool>(options, "is_parking_spot").value_or(false);
+      v.is_holding_point =
+        option<bool>(options, "is_holding_point").value_or(false);
+      v.is_passthrough_point =
+        option<bool>(options, "is_passthrough_point").value_or(false);
+      v.is_charger = option<bool>(options, "is_charger").value_or(false);
+      v.mutex = option<std::string>(options, "mutex").value_or("");
+      v.lift = option<std::string>(options, "lift").value_or("");
+      v.merge_radius = option<double>(options, "merge_radius");
+    }
+
+    const YAML::Node& lanes = level.second["lanes"];
+    for (const auto& lane : lanes)
+    {
+      auto& l = level_desc.lanes.emplace_back();
+      l.begin = lane[0].as<std::size_t>();
+      l.end = lane[1].as<std::size_t>();
+
+      const YAML::Node& options = lane[2];
+      l.orientation_constraint =
+        option<std::string>(options, "orientation_constraint");
+      l.demo_mock_floor_name =
+        option<std::string>(options, "demo_mock_floor_name");
+      l.demo_mock_lift_name =
+        option<std::string>(options, "demo_mock_lift_name");
+      l.door_name = option<std::string>(options, "door_name");
+      l.dock_name = option<std::string>(options, "dock_name").value_or("");
+      l.speed_limit = option<double>(options, "speed_limit");
+      l.mutex = option<std::string>(options, "mutex").value_or("");
+    }
+  }
+
+  return desc;
+}
+
+//==============================================================================
+rmf_traffic::agv::Graph build_graph(
+  const GraphDescription& desc,
+  const rmf_traffic::agv::VehicleTraits& vehicle_traits,
+  const std::string& graph_file)
+{
+  rmf_traffic::agv::Graph graph;
+  const bool has_lifts = desc.has_lifts;
+  if (!has_lifts)
+  {
+    std::cout << "Your navigation graph does not provide lift information. "
+              <<
+      "This may cause problems with behaviors around lifts. Please consider "
+              <<
+      "regenerating your navigration graph with the latest version of "
+              << "rmf_building_map_tools (from the rmf_traffic_editor repo)."
+              << std::endl;
+  }
+  else
+  {
+    for (const auto& lift : desc.lifts)
+    {
+      graph.set_known_lift(rmf_traffic::agv::Graph::LiftProperties(
+          lift.name,
+          Eigen::Vector2d(lift.x, lift.y),
+          lift.orientation,
+          Eigen::Vector2d(lift.width, lift.depth)));
+    }
+  }
+
+  if (!desc.has_doors)
+  {
+    std::cout << "Your navigation graph does not provide door information. "
+              <<
+      "This may cause problems with behaviors around doors. Please consider "
+              <<
+      "regenerating your navigration graph with the latest version of "
+              << "rmf_building_map_tools (from the rmf_traffic_editor repo)."
+              << std::endl;
+  }
+  else
+  {
+    for (const auto& door : desc.doors)
+    {
+      graph.set_known_door(
+        rmf_traffic::agv::Graph::DoorProperties(
+          door.name,
+          Eigen::Vector2d(door.x0, door.y0),
+          Eigen::Vector2d(door.x1, door.y1),
+          door.map));
+    }
+  }
+
   using Constraint = rmf_traffic::agv::Graph::OrientationConstraint;
   using ConstraintPtr = rmf_utils::clone_ptr<Constraint>;
   using Lane = rmf_traffic::agv::Graph::Lane;
@@ -135,118 +289,78 @@ rmf_traffic::agv::Graph parse_graph(
   std::unordered_map<std::size_t, std::size_t> stacked_vertex;
   std::size_t vnum = 0;  // To increment lane endpoint ids
 
-  for (const auto& level : levels)
+  for (const auto& level : desc.levels)
   {
-    const std::string& map_name = level.first.as<std::string>();
+    const std::string& map_name = level.map_name;
     std::size_t vnum_temp = 0;
 
-    const YAML::Node& vertices = level.second["vertices"];
-    for (const auto& vertex : vertices)
+    for (const auto& vertex : level.vertices)
     {
-      const Eigen::Vector2d location{
-        vertex[0].as<double>(), vertex[1].as<double>()};
+      const Eigen::Vector2d location{vertex.x, vertex.y};
 
       auto& wp = graph.add_waypoint(map_name, location);
 
-      const YAML::Node& options = vertex[2];
-      const YAML::Node& name_option = options["name"];
-      if (name_option)
+      const std::string& name = vertex.name;
+      if (!name.empty())
       {
-        const std::string& name = name_option.as<std::string>();
-        if (!name.empty())
+        if (!graph.add_key(name, wp.index()))
         {
-          if (!graph.add_key(name, wp.index()))
-          {
-            // *INDENT-OFF*
-            throw std::runtime_error(
-              "Duplicated waypoint name [" + name + "] in graph ["
-              + graph_file + "]");
-            // *INDENT-ON*
-          }
+          // *INDENT-OFF*
+          throw std::runtime_error(
+            "Duplicated waypoint name [" + name + "] in graph ["
+            + graph_file + "]");
+          // *INDENT-ON*
         }
       }
       vnum_temp ++;
 
-      const YAML::Node& parking_spot_option = options["is_parking_spot"];
-      if (parking_spot_option)
-      {
-        const bool is_parking_spot = parking_spot_option.as<bool>();
-        if (is_parking_spot)
-          wp.set_parking_spot(true);
-      }
+      if (vertex.is_parking_spot)
+        wp.set_parking_spot(true);
 
-      const YAML::Node& holding_point_option = options["is_holding_point"];
-      if (holding_point_option)
-      {
-        const bool is_holding_point = holding_point_option.as<bool>();
-        if (is_holding_point)
-          wp.set_holding_point(true);
-      }
+      if (vertex.is_holding_point)
+        wp.set_holding_point(true);
 
-      const YAML::Node& passthrough_option = options["is_passthrough_point"];
-      if (passthrough_option)
-      {
-        const bool is_passthrough_point = passthrough_option.as<bool>();
-        if (is_passthrough_point)
-          wp.set_passthrough_point(true);
-      }
+      if (vertex.is_passthrough_point)
+        wp.set_passthrough_point(true);
 
-      const YAML::Node& charger_option = options["is_charger"];
-      if (charger_option)
-      {
-        const bool is_charger = charger_option.as<bool>();
-        if (is_charger)
-          wp.set_charger(true);
-      }
+      if (vertex.is_charger)
+        wp.set_charger(true);
 
-      const YAML::Node& mutex_yaml = options["mutex"];
-      if (mutex_yaml)
-      {
-        wp.set_in_mutex_group(mutex_yaml.as<std::string>());
-      }
+      if (!vertex.mutex.empty())
+        wp.set_in_mutex_group(vertex.mutex);
 
-      const YAML::Node& lift_option = options["lift"];
-      if (lift_option)
+      const std::string& lift_name = vertex.lift;
+      if (lift_name != "")
       {
-        const std::string lift_name = lift_option.as<std::string>();
-        if (lift_name != "")
+        wps_of_lift[lift_name].push_back(wp.index());
+        lift_of_wp[wp.index()] = lift_name;
+        if (has_lifts)
         {
-          wps_of_lift[lift_name].push_back(wp.index());
-          lift_of_wp[wp.index()] = lift_name;
-          if (has_lifts)
+          const auto lift = graph.find_known_lift(lift_name);
+          if (!lift)
           {
-            const auto lift = graph.find_known_lift(lift_name);
-            if (!lift)
-            {
-              throw std::runtime_error(
-                      "Lift properties for [" + lift_name + "] were not provided "
-                      "even though it is used by a vertex. This suggests that your "
-                      "nav graph was not generated correctly.");
-            }
-            wp.set_in_lift(lift);
+            throw std::runtime_error(
+                    "Lift properties for [" + lift_name + "] were not provided "
+                    "even though it is used by a vertex. This suggests that your "
+                    "nav graph was not generated correctly.");
           }
+          wp.set_in_lift(lift);
         }
       }
 
-      const YAML::Node& merge_radius_option = options["merge_radius"];
-      if (merge_radius_option)
+      if (vertex.merge_radius.has_value())
       {
-        wp.set_merge_radius(merge_radius_option.as<double>());
+        wp.set_merge_radius(*vertex.merge_radius);
       }
     }
 
-    const YAML::Node& lanes = level.second["lanes"];
-    for (const auto& lane : lanes)
+    for (const auto& lane : level.lanes)
     {
       ConstraintPtr constraint = nullptr;
 
-      const YAML::Node& options = lane[2];
-      const YAML::Node& orientation_constraint_option =
-        options["orientation_constraint"];
-      if (orientation_constraint_option)
+      if (lane.orientation_constraint.has_value())
       {
-        const std::string& constraint_label =
-          orientation_constraint_option.as<std::string>();
+        const std::string& constraint_label = *lane.orientation_constraint;
         if (constraint_label == "forward")
         {
           constraint = Constraint::make(
@@ -264,8 +378,8 @@ rmf_traffic::agv::Graph parse_graph(
           // *INDENT-OFF*
           throw std::runtime_error(
             "Unrecognized orientation constraint label given to lane ["
-            + std::to_string(lane[0].as<std::size_t>() + vnum) + ", "
-            + std::to_string(lane[1].as<std::size_t>() + vnum) + "]: ["
+            + std::to_string(lane.begin + vnum) + ", "
+            + std::to_string(lane.end + vnum) + "]: ["
             + constraint_label + "] in graph ["
             + graph_file + "]");
           // *INDENT-ON*
@@ -274,8 +388,8 @@ rmf_traffic::agv::Graph parse_graph(
 
       rmf_utils::clone_ptr<Event> entry_event;
       rmf_utils::clone_ptr<Event> exit_event;
-      std::size_t begin = lane[0].as<std::size_t>() + vnum;
-      std::size_t end = lane[1].as<std::size_t>() + vnum;
+      std::size_t begin = lane.begin + vnum;
+      std::size_t end = lane.end + vnum;
 
       const auto lift_of_begin = lift_of_wp.find(begin);
       const auto lift_of_end = lift_of_wp.find(end);
@@ -328,14 +442,13 @@ rmf_traffic::agv::Graph parse_graph(
       }
       else
       {
-        if (const YAML::Node mock_lift_option = options["demo_mock_floor_name"])
+        if (lane.demo_mock_floor_name.has_value())
         {
           // NOTE: This is specifically for cases where users want to have a
           // mock lift in the map. It should not be used for real lifts.
-          const std::string floor_name = mock_lift_option.as<std::string>();
-          const YAML::Node lift_name_option = options["demo_mock_lift_name"];
+          const std::string& floor_name = *lane.demo_mock_floor_name;
 
-          if (!lift_name_option)
+          if (!lane.demo_mock_lift_name.has_value())
           {
             // *INDENT-OFF*
             throw std::runtime_error(
@@ -350,7 +463,7 @@ rmf_traffic::agv::Graph parse_graph(
           //
           // We will need to rework this implementation if we ever need to do
           // a demo where multiple robots negotiate the use of a mock lift.
-          const std::string lift_name = lift_name_option.as<std::string>();
+          const std::string& lift_name = *lane.demo_mock_lift_name;
           const rmf_traffic::Duration duration = std::chrono::seconds(4);
           entry_event = Event::make(
             Lane::LiftSessionBegin(lift_name, floor_name, duration));
@@ -358,65 +471,62 @@ rmf_traffic::agv::Graph parse_graph(
             Lane::LiftSessionEnd(lift_name, floor_name,
             rmf_traffic::Duration(0)));
         }
-        else if (const YAML::Node door_name_option = options["door_name"])
+        else if (lane.door_name.has_value())
         {
-          const std::string name = door_name_option.as<std::string>();
+          const std::string& name = *lane.door_name;
           const rmf_traffic::Duration duration = std::chrono::seconds(4);
           entry_event = Event::make(Lane::DoorOpen(name, duration));
           exit_event = Event::make(Lane::DoorClose(name, duration));
         }
       }
 
-      if (const YAML::Node docking_option = options["dock_name"])
+      const std::string& dock_name = lane.dock_name;
+      if (!dock_name.empty())
       {
-        const std::string dock_name = docking_option.as<std::string>();
-        if (!dock_name.empty())
+        const rmf_traffic::Duration duration = std::chrono::seconds(5);
+        if (entry_event)
         {
-          const rmf_traffic::Duration duration = std::chrono::seconds(5);
-          if (entry_event)
+          // Add a waypoint and a lane leading to it for the dock maneuver
+          // to be done after the entry event
+          const auto entry_wp = graph.get_waypoint(begin);
+          auto& dock_wp =
+            graph.add_waypoint(map_name, entry_wp.get_location());
+          dock_wp.set_in_mutex_group(entry_wp.in_mutex_group());
+          dock_wp.set_merge_radius(0.0);
+
+          graph.add_lane(
+            {begin, entry_event},
+            {dock_wp.index(), rmf_utils::clone_ptr<Event>()});
+          stacked_vertex.insert({begin, dock_wp.index()});
+
+          if (const auto lift = graph.get_waypoint(begin).in_lift())
           {
-            // Add a waypoint and a lane leading to it for the dock maneuver
-            // to be done after the entry event
-            const auto entry_wp = graph.get_waypoint(begin);
-            auto& dock_wp =
-              graph.add_waypoint(map_name, entry_wp.get_location());
-            dock_wp.set_in_mutex_group(entry_wp.in_mutex_group());
-            dock_wp.set_merge_radius(0.0);
-
-            graph.add_lane(
-              {begin, entry_event},
-              {dock_wp.index(), rmf_utils::clone_ptr<Event>()});
-            stacked_vertex.insert({begin, dock_wp.index()});
-
-            if (const auto lift = graph.get_waypoint(begin).in_lift())
-            {
-              dock_wp.set_in_lift(lift);
-            }
-
-            // First lane from start -> dock, second lane from dock -> end
-            begin = dock_wp.index();
-
-            vnum_temp++;
+            dock_wp.set_in_lift(lift);
           }
-          entry_event = Event::make(Lane::Dock(dock_name, duration));
+
+          // First lane from start -> dock, second lane from dock -> end
+          begin = dock_wp.index();
+
+          vnum_temp++;
         }
+        entry_event = Event::make(Lane::Dock(dock_name, duration));
       }
 
       auto& graph_lane = graph.add_lane(
         {begin, entry_event},
         {end, exit_event, std::move(constraint)});
 
-      if (const YAML::Node speed_limit_option = options["speed_limit"])
+      if (lane.speed_limit.has_value())
       {
-        const double speed_limit = speed_limit_option.as<double>();
+        const double speed_limit = *lane.speed_limit;
         if (speed_limit > 0.0)
           graph_lane.properties().speed_limit(speed_limit);
       }
 
-      if (const YAML::Node mutex_yaml = options["mutex"])
+      if (!lane.mutex.empty())
       {
         graph_lane.properties()
-        .set_in_mutex_group(mutex_yaml.as<std::string>());
+        .set_in_mutex_group(lane.mutex);
       }
     }
     vnum += vnum_temp;
@@ -489,5 +599,426 @@ rmf_traffic::agv::Graph parse_graph(
   return graph;
 }
 
+//==============================================================================
+// The binary cache starts with this magic and version, followed by a hash of
+// the YAML file that it was made from. Bump CacheVersion whenever the layout
+// of GraphDescription or of the cache changes. Values are written with the
+// native byte order, so a cache should not be shared between machines with
+// different architectures; the magic check will not catch that.
+constexpr char CacheMagic[8] = {'R', 'M', 'F', 'N', 'A', 'V', 'G', '\0'};
+constexpr uint32_t CacheVersion = 1;
+
+//==============================================================================
+uint64_t fnv1a(const std::string& data)
+{
+  uint64_t hash = 14695981039346656037ull;
+  for (const char c : data)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ull;
+  }
+
+  return hash;
+}
+
+//==============================================================================
+class CacheWriter
+{
+public:
+
+  template<typename T>
+  void pod(const T& value)
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const auto* bytes = reinterpret_cast<const char*>(&value);
+    _data.insert(_data.end(), bytes, bytes + sizeof(T));
+  }
+
+  void str(const std::string& value)
+  {
+    pod<uint64_t>(value.size());
+    _data.insert(_data.end(), value.begin(), value.end());
+  }
+
+  void opt_str(const std::optional<std::string>& value)
+  {
+    pod<uint8_t>(value.has_value());
+    if (value.has_value())
+      str(*value);
+  }
+
+  void opt_double(const std::optional<double>& value)
+  {
+    pod<uint8_t>(value.has_value());
+    if (value.has_value())
+      pod<double>(*value);
+  }
+
+  const std::vector<char>& data() const
+  {
+    return _data;
+  }
+
+private:
+  std::vector<char> _data;
+};
+
+//==============================================================================
+class CacheReader
+{
+public:
+
+  CacheReader(const char* data, std::size_t size)
+  : _data(data),
+    _end(data + size)
+  {
+    // Do nothing
+  }
+
+  template<typename T>
+  T pod()
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    _require(sizeof(T));
+    T value;
+    std::memcpy(&value, _data, sizeof(T));
+    _data += sizeof(T);
+    return value;
+  }
+
+  std::string str()
+  {
+    const auto size = pod<uint64_t>();
+    _require(size);
+    std::string value(_data, size);
+    _data += size;
+    return value;
+  }
+
+  std::optional<std::string> opt_str()
+  {
+    if (pod<uint8_t>())
+      return str();
+
+    return std::nullopt;
+  }
+
+  std::optional<double> opt_double()
+  {
+    if (pod<uint8_t>())
+      return pod<double>();
+
+    return std::nullopt;
+  }
+
+  /// Read a count of elements that each take up at least min_size bytes. This
+  /// stops a corrupted count from reserving a huge amount of memory.
+  std::size_t count(std::size_t min_size)
+  {
+    const auto n = pod<uint64_t>();
+    if (n > static_cast<uint64_t>(_end - _data) / min_size)
+      throw std::runtime_error("corrupted element count");
+
+    return n;
+  }
+
+  bool done() const
+  {
+    return _data == _end;
+  }
+
+private:
+
+  void _require(uint64_t size) const
+  {
+    if (size > static_cast<uint64_t>(_end - _data))
+      throw std::runtime_error("unexpected end of data");
+  }
+
+  const char* _data;
+  const char* _end;
+};
+
+//==============================================================================
+std::vector<char> serialize(const GraphDescription& desc, uint64_t hash)
+{
+  CacheWriter w;
+  for (const char c : CacheMagic)
+    w.pod(c);
+
+  w.pod(CacheVersion);
+  w.pod(hash);
+
+  w.pod<uint8_t>(desc.has_lifts);
+  w.pod<uint64_t>(desc.lifts.size());
+  for (const auto& lift : desc.lifts)
+  {
+    w.str(lift.name);
+    w.pod(lift.x);
+    w.pod(lift.y);
+    w.pod(lift.orientation);
+    w.pod(lift.width);
+    w.pod(lift.depth);
+  }
+
+  w.pod<uint8_t>(desc.has_doors);
+  w.pod<uint64_t>(desc.doors.size());
+  for (const auto& door : desc.doors)
+  {
+    w.str(door.name);
+    w.pod(door.x0);
+    w.pod(door.y0);
+    w.pod(door.x1);
+    w.pod(door.y1);
+    w.str(door.map);
+  }
+
+  w.pod<uint64_t>(desc.levels.size());
+  for (const auto& level : desc.levels)
+  {
+    w.str(level.map_name);
+    w.pod<uint64_t>(level.vertices.size());
+    for (const auto& v : level.vertices)
+    {
+      w.pod(v.x);
+      w.pod(v.y);
+      w.str(v.name);
+      const uint8_t flags =
+        (v.is_parking_spot ? 1 : 0)
+        | (v.is_holding_point ? 2 : 0)
+        | (v.is_passthrough_point ? 4 : 0)
+        | (v.is_charger ? 8 : 0);
+      w.pod(flags);
+      w.str(v.mutex);
+      w.str(v.lift);
+      w.opt_double(v.merge_radius);
+    }
+
+    w.pod<uint64_t>(level.lanes.size());
+    for (const auto& l : level.lanes)
+    {
+      w.pod<uint64_t>(l.begin);
+      w.pod<uint64_t>(l.end);
+      w.opt_str(l.orientation_constraint);
+      w.opt_str(l.demo_mock_floor_name);
+      w.opt_str(l.demo_mock_lift_name);
+      w.opt_str(l.door_name);
+      w.str(l.dock_name);
+      w.opt_double(l.speed_limit);
+      w.str(l.mutex);
+    }
+  }
+
+  return w.data();
+}
+
+//==============================================================================
+/// Returns std::nullopt if the data is not a cache of the expected version
+/// for a file with the given hash.
+std::optional<GraphDescription> deserialize(
+  const char* data,
+  std::size_t size,
+  uint64_t hash)
+{
+  CacheReader r(data, size);
+  for (const char c : CacheMagic)
+  {
+    if (r.pod<char>() != c)
+      return std::nullopt;
+  }
+
+  if (r.pod<uint32_t>() != CacheVersion)
+    return std::nullopt;
+
+  if (r.pod<uint64_t>() != hash)
+    return std::nullopt;
+
+  GraphDescription desc;
+  desc.has_lifts = r.pod<uint8_t>();
+  desc.lifts.resize(r.count(48));
+  for (auto& lift : desc.lifts)
+  {
+    lift.name = r.str();
+    lift.x = r.pod<double>();
+    lift.y = r.pod<double>();
+    lift.orientation = r.pod<double>();
+    lift.width = r.pod<double>();
+    lift.depth = r.pod<double>();
+  }
+
+  desc.has_doors = r.pod<uint8_t>();
+  desc.doors.resize(r.count(48));
+  for (auto& door : desc.doors)
+  {
+    door.name = r.str();
+    door.x0 = r.pod<double>();
+    door.y0 = r.pod<double>();
+    door.x1 = r.pod<double>();
+    door.y1 = r.pod<double>();
+    door.map = r.str();
+  }
+
+  desc.levels.resize(r.count(24));
+  for (auto& level : desc.levels)
+  {
+    level.map_name = r.str();
+    level.vertices.resize(r.count(42));
+    for (auto& v : level.vertices)
+    {
+      v.x = r.pod<double>();
+      v.y = r.pod<double>();
+      v.name = r.str();
+      const auto flags = r.pod<uint8_t>();
+      v.is_parking_spot = flags & 1;
+      v.is_holding_point = flags & 2;
+      v.is_passthrough_point = flags & 4;
+      v.is_charger = flags & 8;
+      v.mutex = r.str();
+      v.lift = r.str();
+      v.merge_radius = r.opt_double();
+    }
+
+    level.lanes.resize(r.count(37));
+    for (auto& l : level.lanes)
+    {
+      l.begin = r.pod<uint64_t>();
+      l.end = r.pod<uint64_t>();
+      l.orientation_constraint = r.opt_str();
+      l.demo_mock_floor_name = r.opt_str();
+      l.demo_mock_lift_name = r.opt_str();
+      l.door_name = r.opt_str();
+      l.dock_name = r.str();
+      l.speed_limit = r.opt_double();
+      l.mutex = r.str();
+    }
+  }
+
+  if (!r.done())
+    throw std::runtime_error("trailing data");
+
+  return desc;
+}
+
+//==============================================================================
+/// Map the cache file into memory and decode it. Returns std::nullopt if the
+/// cache does not exist, is stale, or cannot be decoded.
+std::optional<GraphDescription> load_cache(
+  const std::string& cache_file,
+  uint64_t hash)
+{
+  const int fd = ::open(cache_file.c_str(), O_RDONLY);
+  if (fd < 0)
+    return std::nullopt;
+
+  struct stat info;
+  if (::fstat(fd, &info) != 0 || info.st_size <= 0)
+  {
+    ::close(fd);
+    return std::nullopt;
+  }
+
+  const std::size_t size = static_cast<std::size_t>(info.st_size);
+  void* const mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapped == MAP_FAILED)
+    return std::nullopt;
+
+  std::optional<GraphDescription> desc;
+  try
+  {
+    desc = deserialize(static_cast<const char*>(mapped), size, hash);
+  }
+  catch (const std::exception& e)
+  {
+    std::cout << "Ignoring corrupted nav graph cache [" << cache_file
+              << "]: " << e.what() << std::endl;
+  }
+
+  ::munmap(mapped, size);
+  return desc;
+}
+
+//==============================================================================
+void save_cache(
+  const std::string& cache_file,
+  const GraphDescription& desc,
+  uint64_t hash)
+{
+  // Write to a temporary file and move it into place so that a concurrent
+  // reader never sees a partially written cache.
+  const std::string tmp_file =
+    cache_file + ".tmp" + std::to_string(::getpid());
+  const auto data = serialize(desc, hash);
+  {
+    std::ofstream out(tmp_file, std::ios::binary | std::ios::trunc);
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if (out)
+    {
+      out.close();
+      if (out && std::rename(tmp_file.c_str(), cache_file.c_str()) == 0)
+        return;
+    }
+  }
+
+  std::remove(tmp_file.c_str());
+  std::cout << "Unable to write nav graph cache [" << cache_file
+            << "]. The graph will be parsed from YAML again next time."
+            << std::endl;
+}
+
+//==============================================================================
+std::string read_file(const std::string& filename)
+{
+  std::ifstream in(filename, std::ios::binary);
+  if (!in)
+    throw std::runtime_error("Failed to load graph file [" + filename + "]");
+
+  std::stringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+} // anonymous namespace
+
+//==============================================================================
+rmf_traffic::agv::Graph parse_graph(
+  const std::string& graph_file,
+  const rmf_traffic::agv::VehicleTraits& vehicle_traits)
+{
+  const YAML::Node graph_config = YAML::LoadFile(graph_file);
+  if (!graph_config)
+  {
+    throw std::runtime_error("Failed to load graph file [" + graph_file + "]");
+  }
+
+  return build_graph(
+    describe_graph(graph_config, graph_file), vehicle_traits, graph_file);
+}
+
+//==============================================================================
+rmf_traffic::agv::Graph parse_graph(
+  const std::string& graph_file,
+  const rmf_traffic::agv::VehicleTraits& vehicle_traits,
+  const std::string& cache_file)
+{
+  if (cache_file.empty())
+    return parse_graph(graph_file, vehicle_traits);
+
+  const std::string contents = read_file(graph_file);
+  const uint64_t hash = fnv1a(contents);
+  if (const auto cached = load_cache(cache_file, hash))
+    return build_graph(*cached, vehicle_traits, graph_file);
+
+  const YAML::Node graph_config = YAML::Load(contents);
+  if (!graph_config)
+  {
+    throw std::runtime_error("Failed to load graph file [" + graph_file + "]");
+  }
+
+  const auto desc = describe_graph(graph_config, graph_file);
+  save_cache(cache_file, desc, hash);
+  return build_graph(desc, vehicle_traits, graph_file);
+}
+
 } // namespace agv
 } // namespace rmf_fleet_adapter
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__AGV__PUBLISH_IN_PLACE_HPP
+#define SRC__RMF_FLEET_ADAPTER__AGV__PUBLISH_IN_PLACE_HPP
+
+#include <rclcpp/publisher.hpp>
+
+#include <memory>
+
+namespace rmf_fleet_adapter {
+namespace agv {
+
+//==============================================================================
+/// Publish a message that gets filled in where it will be sent from. When the
+/// middleware can loan messages, the message is built directly in its shared
+/// memory. Otherwise it is handed over as a unique_ptr so that intra-process
+/// subscribers receive it without a copy.
+///
+/// \param[in] publisher
+///   The publisher to send the message through
+///
+/// \param[in] fill
+///   A callback that fills in a default-constructed Message
+template<typename Message, typename Fill>
+void publish_in_place(
+  const typename rclcpp::Publisher<Message>::SharedPtr& publisher,
+  Fill&& fill)
+{
+  if (publisher->can_loan_messages())
+  {
+    auto loaned = publisher->borrow_loaned_message();
+    fill(loaned.get());
+    publisher->publish(std::move(loaned));
+    return;
+  }
+
+  auto msg = std::make_unique<Message>();
+  fill(*msg);
+  publisher->publish(std::move(msg));
+}
+
+} // namespace agv
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__AGV__PUBLISH_IN_PLACE_HPP
@@ -160,22 +160,24 @@ void estimate_midlane_state(
     }
   }
 
-  const std::optional<std::size_t> target_gi = [&]()
-    -> std::optional<std::size_t>
+  // At least one future waypoint must have a graph index. Looking it up in
+  // next_graph_index keeps this from scanning the rest of the plan on every
+  // update.
+  if (info.next_graph_index.size() != info.waypoints.size())
+  {
+    info.next_graph_index.assign(info.waypoints.size(), std::nullopt);
+    std::optional<std::size_t> next_gi;
+    for (std::size_t i = info.waypoints.size(); i > 0; --i)
     {
-      // At least one future waypoint must have a graph index
-      if (target_wp.graph_index())
-        return *target_wp.graph_index();
+      if (const auto gi = info.waypoints[i-1].graph_index())
+        next_gi = *gi;
 
-      for (std::size_t i = next_index+1; i < info.waypoints.size(); ++i)
-      {
-        const auto gi = info.waypoints[i].graph_index();
-        if (gi)
-          return *gi;
-      }
+      info.next_graph_index[i-1] = next_gi;
+    }
+  }
 
-      return std::nullopt;
-    } ();
+  const std::optional<std::size_t> target_gi =
+    info.next_graph_index[next_index];
 
   if (target_gi.has_value())
   {
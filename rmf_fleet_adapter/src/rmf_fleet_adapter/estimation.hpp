@@ -45,6 +45,11 @@ struct TravelInfo
   std::string robot_name;
 
   std::optional<std::size_t> target_plan_index = std::nullopt;
+
+  /// The graph index of the first waypoint at or after each waypoint of the
+  /// plan that has one. This gets filled in by the estimation functions the
+  /// first time they need it, and must be cleared whenever waypoints changes.
+  std::vector<std::optional<std::size_t>> next_graph_index = {};
 };
 
 //==============================================================================
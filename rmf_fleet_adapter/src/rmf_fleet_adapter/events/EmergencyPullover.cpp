@@ -228,6 +228,8 @@ auto EmergencyPullover::Active::interrupt(
   _negotiator->clear_license();
   _is_interrupted = true;
   _execution = std::nullopt;
+  if (const auto& scheduler = _context->emergency_pullover_scheduler())
+    scheduler->release(_context->name());
 
   _state->update_status(Status::Standby);
   _state->update_log().info("Going into standby for an interruption");
@@ -260,6 +262,9 @@ auto EmergencyPullover::Active::interrupt(
 void EmergencyPullover::Active::cancel()
 {
   _execution = std::nullopt;
+  if (const auto& scheduler = _context->emergency_pullover_scheduler())
+    scheduler->release(_context->name());
+
   _state->update_status(Status::Canceled);
   _state->update_log().info("Received signal to cancel");
   _finished();
@@ -269,6 +274,9 @@ void EmergencyPullover::Active::cancel()
 void EmergencyPullover::Active::kill()
 {
   _execution = std::nullopt;
+  if (const auto& scheduler = _context->emergency_pullover_scheduler())
+    scheduler->release(_context->name());
+
   _state->update_status(Status::Killed);
   _state->update_log().info("Received signal to kill");
   _finished();
@@ -285,63 +293,31 @@ void EmergencyPullover::Active::_find_plan()
 
   if (!_context->_parking_spot_manager_enabled())
   {
-    _find_pullover_service = std::make_shared<services::FindEmergencyPullover>(
-      _context->emergency_planner(), _context->location(),
-      _context->schedule()->snapshot(),
-      _context->itinerary().id(), _context->profile());
-
-    _pullover_subscription =
-      rmf_rxcpp::make_job<services::FindEmergencyPullover::Result>(
-      _find_pullover_service)
-      .observe_on(rxcpp::identity_same_worker(_context->worker()))
-      .subscribe(
-      [w = weak_from_this()](
-        const services::FindEmergencyPullover::Result& result)
+    const auto& scheduler = _context->emergency_pullover_scheduler();
+    if (!scheduler)
+    {
+      _search_for_pullover(nullptr);
+      return;
+    }
+
+    if (_awaiting_pullover_slot)
+      return;
+
+    // Robots in more hazardous places get to search for their pullovers
+    // first, and the pullovers that they find are excluded from the searches
+    // of the robots that come after them.
+    _awaiting_pullover_slot = true;
+    scheduler->submit(
+      EmergencyPulloverScheduler::assess(
+        _context->navigation_graph(), _context->location()),
+      [w = weak_from_this()](EmergencyPulloverScheduler::Ticket ticket)
       {
         const auto self = w.lock();
         if (!self)
           return;
 
-        if (!result)
-        {
-          // The planner could not find any pullover
-          self->_state->update_status(Status::Error);
-          self->_state->update_log().error("Failed to find a pullover");
-
-          self->_execution = std::nullopt;
-          self->_schedule_retry();
-
-          self->_context->worker().schedule(
-            [update = self->_update](const auto&) { update(); });
-
-          return;
-        }
-
-        self->_state->update_status(Status::Underway);
-        self->_state->update_log().info("Found an emergency pullover");
-
-        auto full_itinerary = result->get_itinerary();
-        self->_execute_plan(
-          self->_context->itinerary().assign_plan_id(),
-          *std::move(result),
-          std::move(full_itinerary));
-
-        self->_find_pullover_service = nullptr;
-        self->_retry_timer = nullptr;
-      });
-
-    _find_pullover_timeout = _context->node()->try_create_wall_timer(
-      std::chrono::seconds(10),
-      [
-        weak_service = _find_pullover_service->weak_from_this(),
-        weak_self = weak_from_this()
-      ]()
-      {
-        if (const auto service = weak_service.lock())
-          service->interrupt();
-
-        if (const auto self = weak_self.lock())
-          self->_find_pullover_timeout = nullptr;
+        self->_awaiting_pullover_slot = false;
+        self->_search_for_pullover(std::move(ticket));
       });
 
     _update();
@@ -409,7 +385,7 @@ void EmergencyPullover::Active::_find_plan()
         self->_retry_timer = nullptr;
       });
 
-    _find_path_timeout = _context->node()->try_create_wall_timer(
+    _find_path_timeout = _context->node()->create_wheel_timer(
       std::chrono::seconds(10),
       [
         weak_service = _find_path_service->weak_from_this(),
@@ -427,6 +403,100 @@ void EmergencyPullover::Active::_find_plan()
   }
 }
 
+//==============================================================================
+void EmergencyPullover::Active::_search_for_pullover(
+  EmergencyPulloverScheduler::Ticket ticket)
+{
+  if (_is_interrupted || _execution.has_value())
+    return;
+
+  // Only search the parking spots that are closest to the robot if the
+  // fleet has already found them with this same planner
+  std::optional<std::vector<std::size_t>> candidates;
+  const auto& precomputed = _context->pullover_candidates();
+  if (!_search_all_parking_spots && precomputed
+    && precomputed->planner() == _context->emergency_planner())
+  {
+    candidates = precomputed->get(_context->location());
+  }
+  const bool searching_candidates = candidates.has_value();
+
+  if (const auto& scheduler = _context->emergency_pullover_scheduler())
+  {
+    candidates = scheduler->unclaimed(
+      _context->emergency_planner()->get_configuration().graph(),
+      std::move(candidates), _context->name());
+  }
+
+  _pullover_ticket = std::move(ticket);
+  _find_pullover_service = std::make_shared<services::FindEmergencyPullover>(
+    _context->emergency_planner(), _context->location(),
+    _context->schedule()->snapshot(),
+    _context->itinerary().id(), _context->profile(),
+    std::move(candidates));
+
+  _pullover_subscription =
+    rmf_rxcpp::make_job<services::FindEmergencyPullover::Result>(
+    _find_pullover_service)
+    .observe_on(rxcpp::identity_same_worker(_context->worker()))
+    .subscribe(
+    [w = weak_from_this(), searching_candidates](
+      const services::FindEmergencyPullover::Result& result)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      // Let the next robot start its search
+      self->_pullover_ticket = nullptr;
+
+      if (!result)
+      {
+        // The planner could not find any pullover
+        self->_state->update_status(Status::Error);
+        self->_state->update_log().error("Failed to find a pullover");
+        if (searching_candidates)
+          self->_search_all_parking_spots = true;
+
+        self->_execution = std::nullopt;
+        self->_schedule_retry();
+
+        self->_context->worker().schedule(
+          [update = self->_update](const auto&) { update(); });
+
+        return;
+      }
+
+      self->_state->update_status(Status::Underway);
+      self->_state->update_log().info("Found an emergency pullover");
+
+      auto full_itinerary = result->get_itinerary();
+      self->_execute_plan(
+        self->_context->itinerary().assign_plan_id(),
+        *std::move(result),
+        std::move(full_itinerary));
+
+      self->_find_pullover_service = nullptr;
+      self->_retry_timer = nullptr;
+    });
+
+  _find_pullover_timeout = _context->node()->create_wheel_timer(
+    std::chrono::seconds(10),
+    [
+      weak_service = _find_pullover_service->weak_from_this(),
+      weak_self = weak_from_this()
+    ]()
+    {
+      if (const auto service = weak_service.lock())
+        service->interrupt();
+
+      if (const auto self = weak_self.lock())
+        self->_find_pullover_timeout = nullptr;
+    });
+
+  _update();
+}
+
 //==============================================================================
 void EmergencyPullover::Active::_schedule_retry()
 {
@@ -434,7 +504,7 @@ void EmergencyPullover::Active::_schedule_retry()
     return;
 
   // TODO(MXG): Make the retry timing configurable
-  _retry_timer = _context->node()->try_create_wall_timer(
+  _retry_timer = _context->node()->create_wheel_timer(
     std::chrono::seconds(5),
     [w = weak_from_this()]()
     {
@@ -459,8 +529,21 @@ void EmergencyPullover::Active::_execute_plan(
   if (_is_interrupted)
     return;
 
+  const auto& scheduler = _context->emergency_pullover_scheduler();
   if (plan.get_itinerary().empty() || plan.get_waypoints().empty())
   {
+    if (scheduler)
+    {
+      for (const auto& start : _context->location())
+      {
+        if (!start.lane().has_value())
+        {
+          scheduler->claim(_context->name(), start.waypoint());
+          break;
+        }
+      }
+    }
+
     _state->update_status(Status::Completed);
     _state->update_log().info(
       "The planner indicates that the robot is already in a pullover spot.");
@@ -487,6 +570,9 @@ void EmergencyPullover::Active::_execute_plan(
   auto goal = rmf_traffic::agv::Plan::Goal(
     plan.get_waypoints().back().graph_index().value());
 
+  if (scheduler)
+    scheduler->claim(_context->name(), goal.waypoint());
+
   _execution = ExecutePlan::make(
     _context, plan_id, std::move(plan), std::move(goal),
     std::move(full_itinerary), _assign_id, _state, _update,
@@ -522,7 +608,8 @@ Negotiator::NegotiatePtr EmergencyPullover::Active::_respond(
       return std::nullopt;
     };
 
-  const auto evaluator = Negotiator::make_evaluator(table_view);
+  const auto evaluator =
+    Negotiator::make_evaluator(table_view, _context->evaluator_tuning());
   return services::Negotiate::emergency_pullover(
     _context->itinerary().assign_plan_id(), _context->emergency_planner(),
     _context->location(), table_view,
@@ -103,6 +103,8 @@ public:
 
     void _find_plan();
 
+    void _search_for_pullover(EmergencyPulloverScheduler::Ticket ticket);
+
     void _execute_plan(
       rmf_traffic::PlanId plan_id,
       rmf_traffic::agv::Plan plan,
@@ -121,17 +123,23 @@ public:
     std::optional<ExecutePlan> _execution;
     std::shared_ptr<services::FindEmergencyPullover> _find_pullover_service;
     rmf_rxcpp::subscription_guard _pullover_subscription;
-    rclcpp::TimerBase::SharedPtr _find_pullover_timeout;
-    rclcpp::TimerBase::SharedPtr _retry_timer;
+    TimerWheel::TimerPtr _find_pullover_timeout;
+    EmergencyPulloverScheduler::Ticket _pullover_ticket;
+    bool _awaiting_pullover_slot = false;
+    TimerWheel::TimerPtr _retry_timer;
 
     std::shared_ptr<services::FindPath> _find_path_service;
     rmf_rxcpp::subscription_guard _plan_subscription;
-    rclcpp::TimerBase::SharedPtr _find_path_timeout;
+    TimerWheel::TimerPtr _find_path_timeout;
     std::optional<rmf_traffic::agv::Plan::Goal> _chosen_goal;
 
     std::shared_ptr<reservation::ReservationNodeNegotiator> _reservation_client;
 
     bool _is_interrupted = false;
+
+    // Set after a search among only the closest parking spots has failed, so
+    // that retries search all of them
+    bool _search_all_parking_spots = false;
   };
 
 private:
@@ -33,6 +33,10 @@
 
 #include <rmf_task_sequence/events/Bundle.hpp>
 
+#include <limits>
+#include <list>
+#include <mutex>
+
 namespace rmf_fleet_adapter {
 namespace events {
 
@@ -53,6 +57,104 @@ std::string print_plan_waypoints(
   return ss.str();
 }
 
+//==============================================================================
+// The minimum time between two progress updates of the same plan phase
+const rmf_traffic::Duration PlanProgressUpdatePeriod =
+  std::chrono::milliseconds(500);
+
+//==============================================================================
+/// Coalesces the updates that the phases of a plan send to the parent task.
+/// Every waypoint that a MoveRobot phase passes and every message of a legacy
+/// phase triggers an update, and each update makes the task manager copy and
+/// publish the whole task state. Updates that change the status of the plan or
+/// any of its phases are forwarded right away so that phase boundaries are
+/// never delayed. Any other update is forwarded at most once per
+/// PlanProgressUpdatePeriod, with the most recent progress folded into it.
+class UpdateCoalescer : public std::enable_shared_from_this<UpdateCoalescer>
+{
+public:
+
+  static UpdateFn make(
+    rxcpp::schedulers::worker worker,
+    rmf_task::events::SimpleEventStatePtr state,
+    UpdateFn update)
+  {
+    auto coalescer = std::shared_ptr<UpdateCoalescer>(new UpdateCoalescer);
+    coalescer->_worker = std::move(worker);
+    coalescer->_state = std::move(state);
+    coalescer->_update = std::move(update);
+    return [coalescer]()
+      {
+        coalescer->_request();
+      };
+  }
+
+private:
+
+  UpdateCoalescer() = default;
+
+  using Status = rmf_task::Event::Status;
+
+  std::vector<Status> _statuses() const
+  {
+    std::vector<Status> statuses;
+    statuses.push_back(_state->status());
+    for (const auto& dep : _state->dependencies())
+      statuses.push_back(dep->status());
+
+    return statuses;
+  }
+
+  void _request()
+  {
+    auto statuses = _statuses();
+    const auto now = std::chrono::steady_clock::now();
+    if (statuses != _last_statuses
+      || !_last_forward.has_value()
+      || *_last_forward + PlanProgressUpdatePeriod <= now)
+    {
+      _last_statuses = std::move(statuses);
+      _forward(now);
+      return;
+    }
+
+    _pending = true;
+    if (_flush_scheduled)
+      return;
+
+    // Flush the latest progress once the period has passed. If a boundary
+    // gets forwarded first then the flush will find nothing left to do.
+    _flush_scheduled = true;
+    _worker.schedule(
+      *_last_forward + PlanProgressUpdatePeriod,
+      [w = weak_from_this()](const auto&)
+      {
+        const auto self = w.lock();
+        if (!self)
+          return;
+
+        self->_flush_scheduled = false;
+        if (self->_pending)
+          self->_forward(std::chrono::steady_clock::now());
+      });
+  }
+
+  void _forward(std::chrono::steady_clock::time_point now)
+  {
+    _pending = false;
+    _last_forward = now;
+    _update();
+  }
+
+  rxcpp::schedulers::worker _worker;
+  rmf_task::events::SimpleEventStatePtr _state;
+  UpdateFn _update;
+  std::vector<Status> _last_statuses;
+  std::optional<std::chrono::steady_clock::time_point> _last_forward;
+  bool _pending = false;
+  bool _flush_scheduled = false;
+};
+
 //==============================================================================
 struct LegacyPhaseWrapper
 {
@@ -159,17 +261,19 @@ public:
     LegacyPhases& phases,
     const rmf_traffic::agv::Plan::Waypoint& initial_waypoint_,
     std::optional<rmf_traffic::agv::Plan::Waypoint> next_waypoint_,
+    std::optional<std::size_t> next_waypoint_index_,
     const PlanIdPtr plan_id,
     std::function<LockMutexGroup::Data(
       const std::unordered_set<std::string>&,
       const rmf_traffic::agv::Plan::Waypoint&)> make_current_mutex_groups,
     std::function<std::pair<bool, std::unordered_set<std::string>>(
-      const rmf_traffic::agv::Plan::Waypoint&)> get_new_mutex_groups,
+      std::size_t)> get_new_mutex_groups,
     std::shared_ptr<rmf_traffic::schedule::Itinerary>& previous_itinerary,
     const rmf_traffic::schedule::Itinerary& full_itinerary,
     bool& continuous)
   : initial_waypoint(initial_waypoint_),
     next_waypoint(std::move(next_waypoint_)),
+    next_waypoint_index(next_waypoint_index_),
     _context(std::move(context)),
     _phases(phases),
     _event_start_time(initial_waypoint_.time()),
@@ -185,6 +289,7 @@ public:
 
   rmf_traffic::agv::Plan::Waypoint initial_waypoint;
   std::optional<rmf_traffic::agv::Plan::Waypoint> next_waypoint;
+  std::optional<std::size_t> next_waypoint_index;
 
   void execute(const Dock& dock) final
   {
@@ -192,7 +297,7 @@ public:
     if (next_waypoint.has_value() && next_waypoint->graph_index().has_value())
     {
       const auto [mutex_group_change, new_mutex_groups] =
-        _get_new_mutex_group(*next_waypoint);
+        _get_new_mutex_group(*next_waypoint_index);
 
       if (mutex_group_change)
       {
@@ -354,7 +459,7 @@ private:
       const std::unordered_set<std::string>&,
       const rmf_traffic::agv::Plan::Waypoint&)> _make_current_mutex_groups;
   std::function<std::pair<bool, std::unordered_set<std::string>>(
-      const rmf_traffic::agv::Plan::Waypoint&)> _get_new_mutex_group;
+      std::size_t)> _get_new_mutex_group;
   std::shared_ptr<rmf_traffic::schedule::Itinerary>& _previous_itinerary;
   const rmf_traffic::schedule::Itinerary& _full_itinerary;
   bool& _continuous;
@@ -594,75 +699,195 @@ std::optional<EventGroupInfo> search_for_lift_group(
 } // anonymous namespace
 
 //==============================================================================
-class LiftFinder : public rmf_traffic::agv::Graph::Lane::Executor
+/// Collects the names of the lifts and doors that the events of a route use.
+class RouteEventNames : public rmf_traffic::agv::Graph::Lane::Executor
 {
 public:
-  LiftFinder(std::string current_name_)
-  : current_name(std::move(current_name_)),
-    still_using(false)
-  {
-    // Do nothing
-  }
-  std::string current_name;
-  bool still_using = false;
+  std::unordered_set<std::string> lifts;
+  std::unordered_set<std::string> doors;
 
-  void execute(const Dock& dock) final {}
+  void execute(const Dock&) final {}
   void execute(const Wait&) final {}
-  void execute(const DoorOpen&) final {}
-  void execute(const DoorClose&) final {}
+  void execute(const DoorOpen& open) final
+  {
+    doors.insert(open.name());
+  }
+  void execute(const DoorClose& close) final
+  {
+    doors.insert(close.name());
+  }
   void execute(const LiftSessionBegin& e) final
   {
-    // If we're going to re-begin using a lift, then we don't need to keep this
-    // one locked. The new LiftSessionBegin event will re-lock the session.
-    if (e.lift_name() == current_name)
-      still_using = true;
+    // If we're going to re-begin using a lift, then we don't need to keep
+    // another session with it locked. The new LiftSessionBegin event will
+    // re-lock the session.
+    lifts.insert(e.lift_name());
   }
   void execute(const LiftMove& e) final
   {
-    if (e.lift_name() == current_name)
-      still_using = true;
+    lifts.insert(e.lift_name());
   }
   void execute(const LiftDoorOpen& e) final
   {
-    if (e.lift_name() == current_name)
-      still_using = true;
+    lifts.insert(e.lift_name());
   }
   void execute(const LiftSessionEnd& e) final
   {
-    if (e.lift_name() == current_name)
-      still_using = true;
+    lifts.insert(e.lift_name());
   }
 };
 
 //==============================================================================
-class DoorFinder : public rmf_traffic::agv::Graph::Lane::Executor
+/// The parts of compiling a plan into phases that only depend on the route
+/// that the plan takes through the navigation graph. Repeated routes, like
+/// patrol loops, reuse these while only the timing of their phases gets
+/// recalculated.
+struct RouteAnalysis
+{
+  /// The mutex groups that each waypoint of the plan needs
+  std::vector<std::unordered_set<std::string>> mutex_groups;
+
+  /// The lifts that are used by the events along the route
+  std::unordered_set<std::string> lifts;
+
+  /// The doors that are used by the events along the route
+  std::unordered_set<std::string> doors;
+};
+
+using ConstRouteAnalysisPtr = std::shared_ptr<const RouteAnalysis>;
+
+//==============================================================================
+class RouteAnalysisCache
 {
 public:
-  DoorFinder(std::string current_name_)
-  : current_name(std::move(current_name_)),
-    still_using(false)
+
+  using Planner = rmf_traffic::agv::Planner;
+  using Waypoint = rmf_traffic::agv::Plan::Waypoint;
+
+  static ConstRouteAnalysisPtr get(
+    const std::shared_ptr<const Planner>& planner,
+    const std::vector<Waypoint>& waypoints)
   {
-    // Do nothing
+    auto route = route_key(waypoints);
+    const std::size_t hash = hash_route(route);
+
+    static RouteAnalysisCache cache;
+    {
+      std::lock_guard<std::mutex> lock(cache._mutex);
+      for (auto it = cache._entries.begin(); it != cache._entries.end(); ++it)
+      {
+        if (it->hash != hash || it->route != route)
+          continue;
+
+        // The analysis refers to lanes and waypoints of the planner's graph,
+        // so it cannot be used after the planner gets replaced.
+        if (it->planner.lock() != planner)
+          continue;
+
+        auto analysis = it->analysis;
+        cache._entries.splice(cache._entries.begin(), cache._entries, it);
+        return analysis;
+      }
+    }
+
+    ConstRouteAnalysisPtr analysis =
+      analyze(planner->get_configuration().graph(), waypoints);
+
+    std::lock_guard<std::mutex> lock(cache._mutex);
+    cache._entries.push_front(
+      Entry{planner, std::move(route), hash, analysis});
+
+    if (cache._entries.size() > MaxCachedRoutes)
+      cache._entries.pop_back();
+
+    return analysis;
   }
-  std::string current_name;
-  bool still_using;
 
-  void execute(const Dock& dock) final {}
-  void execute(const Wait&) final {}
-  void execute(const DoorOpen& open) final
+private:
+
+  static constexpr std::size_t MaxCachedRoutes = 64;
+
+  struct Entry
   {
-    if (open.name() == current_name)
-      still_using = true;
+    std::weak_ptr<const Planner> planner;
+    std::vector<std::size_t> route;
+    std::size_t hash;
+    ConstRouteAnalysisPtr analysis;
+  };
+
+  // Flatten the vertex and approach lanes of each waypoint into one sequence.
+  // The lanes also determine which events happen along the route.
+  static std::vector<std::size_t> route_key(
+    const std::vector<Waypoint>& waypoints)
+  {
+    std::vector<std::size_t> route;
+    route.reserve(3*waypoints.size());
+    for (const auto& wp : waypoints)
+    {
+      route.push_back(
+        wp.graph_index().value_or(std::numeric_limits<std::size_t>::max()));
+      route.push_back(wp.approach_lanes().size());
+      route.insert(
+        route.end(), wp.approach_lanes().begin(), wp.approach_lanes().end());
+    }
+
+    return route;
   }
-  void execute(const DoorClose& close) final
+
+  static std::size_t hash_route(const std::vector<std::size_t>& route)
+  {
+    std::size_t hash = route.size();
+    for (const auto v : route)
+      hash ^= std::hash<std::size_t>()(v) + 0x9e3779b9 + (hash << 6)
+        + (hash >> 2);
+
+    return hash;
+  }
+
+  static ConstRouteAnalysisPtr analyze(
+    const rmf_traffic::agv::Graph& graph,
+    const std::vector<Waypoint>& waypoints)
   {
-    if (close.name() == current_name)
-      still_using = true;
+    auto analysis = std::make_shared<RouteAnalysis>();
+    analysis->mutex_groups.reserve(waypoints.size());
+    RouteEventNames names;
+    for (const auto& wp : waypoints)
+    {
+      std::unordered_set<std::string> groups;
+      if (wp.graph_index().has_value())
+      {
+        const auto& group =
+          graph.get_waypoint(*wp.graph_index()).in_mutex_group();
+        if (!group.empty())
+        {
+          groups.insert(group);
+        }
+      }
+
+      for (const auto l : wp.approach_lanes())
+      {
+        const auto& lane = graph.get_lane(l);
+        const auto& group = lane.properties().in_mutex_group();
+        if (!group.empty())
+        {
+          groups.insert(group);
+          break;
+        }
+      }
+
+      analysis->mutex_groups.push_back(std::move(groups));
+
+      if (wp.event())
+        wp.event()->execute(names);
+    }
+
+    analysis->lifts = std::move(names.lifts);
+    analysis->doors = std::move(names.doors);
+    return analysis;
   }
-  void execute(const LiftSessionBegin& e) final {}
-  void execute(const LiftMove& e) final {}
-  void execute(const LiftDoorOpen& e) final {}
-  void execute(const LiftSessionEnd& e) final {}
+
+  std::mutex _mutex;
+  std::list<Entry> _entries;
 };
 
 //==============================================================================
@@ -700,6 +925,8 @@ std::optional<ExecutePlan> ExecutePlan::make(
 
   auto plan_id = std::make_shared<rmf_traffic::PlanId>(recommended_plan_id);
   const auto& graph = context->navigation_graph();
+  const auto route =
+    RouteAnalysisCache::get(context->planner(), plan.get_waypoints());
   LegacyPhases legacy_phases;
 
   rmf_traffic::agv::Graph::LiftPropertiesPtr release_lift;
@@ -707,18 +934,7 @@ std::optional<ExecutePlan> ExecutePlan::make(
     ->get_characteristic_length()/2.0;
   if (const auto* current_lift = context->current_lift_destination())
   {
-    LiftFinder finder(current_lift->lift_name);
-    for (const auto& wp : plan.get_waypoints())
-    {
-      if (wp.event())
-      {
-        wp.event()->execute(finder);
-        if (finder.still_using)
-          break;
-      }
-    }
-
-    if (!finder.still_using)
+    if (route->lifts.count(current_lift->lift_name) == 0)
     {
       const auto found_lift = graph.find_known_lift(current_lift->lift_name);
       if (found_lift)
@@ -830,18 +1046,7 @@ std::optional<ExecutePlan> ExecutePlan::make(
   if (context->holding_door().has_value())
   {
     const auto& current_door = *context->holding_door();
-    DoorFinder finder(current_door);
-    for (const auto& wp : plan.get_waypoints())
-    {
-      if (wp.event())
-      {
-        wp.event()->execute(finder);
-        if (finder.still_using)
-          break;
-      }
-    }
-
-    if (!finder.still_using)
+    if (route->doors.count(current_door) == 0)
     {
       RCLCPP_INFO(
         context->node()->get_logger(),
@@ -875,6 +1080,8 @@ std::optional<ExecutePlan> ExecutePlan::make(
 
   std::vector<rmf_traffic::agv::Plan::Waypoint> waypoints =
     plan.get_waypoints();
+  // The index within the plan of the first element of waypoints
+  std::size_t first_index = 0;
 
   std::vector<rmf_traffic::agv::Plan::Waypoint> move_through;
   std::optional<LockMutexGroup::Data> current_mutex_groups;
@@ -948,31 +1155,9 @@ std::optional<ExecutePlan> ExecutePlan::make(
       return data;
     };
 
-  const auto get_new_mutex_groups = [&](
-    const rmf_traffic::agv::Plan::Waypoint& wp)
+  const auto get_new_mutex_groups = [&](std::size_t plan_index)
     {
-      std::unordered_set<std::string> new_mutex_groups;
-      if (wp.graph_index().has_value())
-      {
-        const auto& group =
-          graph.get_waypoint(*wp.graph_index()).in_mutex_group();
-        if (!group.empty())
-        {
-          new_mutex_groups.insert(group);
-        }
-      }
-
-      for (const auto l : wp.approach_lanes())
-      {
-        const auto& lane = graph.get_lane(l);
-        const auto& group = lane.properties().in_mutex_group();
-        if (!group.empty())
-        {
-          new_mutex_groups.insert(group);
-          break;
-        }
-      }
-
+      const auto& new_mutex_groups = route->mutex_groups.at(plan_index);
       bool mutex_group_change =
         (!new_mutex_groups.empty() && remaining_mutex_groups.empty());
 
@@ -1007,7 +1192,7 @@ std::optional<ExecutePlan> ExecutePlan::make(
     for (; it != waypoints.end(); ++it)
     {
       const auto [mutex_group_change, new_mutex_groups] = get_new_mutex_groups(
-        *it);
+        first_index + (it - waypoints.begin()));
       if (mutex_group_change)
       {
         if (move_through.size() > 1)
@@ -1025,6 +1210,7 @@ std::optional<ExecutePlan> ExecutePlan::make(
           move_through.clear();
           // Repeat the last waypoint so that follow_new_path has continuity.
           move_through.push_back(last);
+          first_index += it - waypoints.begin();
           waypoints.erase(waypoints.begin(), it);
 
           current_mutex_groups = next_mutex_group;
@@ -1102,10 +1288,12 @@ std::optional<ExecutePlan> ExecutePlan::make(
         }
 
         std::optional<rmf_traffic::agv::Plan::Waypoint> next_waypoint;
+        std::optional<std::size_t> next_waypoint_index;
         auto next_it = it + 1;
         if (next_it != waypoints.end())
         {
           next_waypoint = *next_it;
+          next_waypoint_index = first_index + (next_it - waypoints.begin());
         }
 
         move_through.clear();
@@ -1113,7 +1301,8 @@ std::optional<ExecutePlan> ExecutePlan::make(
         if (it->event())
         {
           EventPhaseFactory factory(
-            context, legacy_phases, *it, next_waypoint, plan_id,
+            context, legacy_phases, *it, next_waypoint, next_waypoint_index,
+            plan_id,
             make_current_mutex_groups, get_new_mutex_groups,
             previous_itinerary, full_itinerary,
             continuous);
@@ -1161,6 +1350,7 @@ std::optional<ExecutePlan> ExecutePlan::make(
           move_through.push_back(*it);
         }
 
+        first_index += it + 1 - waypoints.begin();
         waypoints.erase(waypoints.begin(), it+1);
         event_occurred = true;
         break;
@@ -1184,6 +1374,7 @@ std::optional<ExecutePlan> ExecutePlan::make(
         move_through.clear();
         move_through.push_back(*it);
 
+        first_index += it + 1 - waypoints.begin();
         waypoints.erase(waypoints.begin(), it+1);
         event_occurred = true;
         break;
@@ -1333,7 +1524,9 @@ std::optional<ExecutePlan> ExecutePlan::make(
 
   auto sequence = rmf_task_sequence::events::Bundle::standby(
     rmf_task_sequence::events::Bundle::Type::Sequence,
-    standbys, state, std::move(update))->begin([]() {}, std::move(finished));
+    standbys, state,
+    UpdateCoalescer::make(context->worker(), state, std::move(update)))
+  ->begin([]() {}, std::move(finished));
 
   return ExecutePlan{
     std::move(plan),
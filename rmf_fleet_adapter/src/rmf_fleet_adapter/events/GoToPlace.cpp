@@ -21,16 +21,29 @@
 #include "internal_utilities.hpp"
 #include "PerformAction.hpp"
 
+#include <rmf_traffic_ros2/Tracing.hpp>
+
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <optional>
 #include <rmf_traffic/schedule/StubbornNegotiator.hpp>
 #include <rmf_traffic/agv/Planner.hpp>
 #include <string>
+#include <unordered_set>
 
 namespace rmf_fleet_adapter {
 namespace events {
 
+namespace {
+//==============================================================================
+// When a speed limit change would delay the robot by more than this, a
+// different route may have become faster, so the robot replans instead of
+// only shifting its schedule.
+const rmf_traffic::Duration speed_limit_replan_threshold =
+  std::chrono::seconds(20);
+} // anonymous namespace
+
 //==============================================================================
 void GoToPlace::add(rmf_task_sequence::Event::Initializer& initializer)
 {
@@ -219,23 +232,30 @@ auto GoToPlace::Active::make(
 
       if (self->_find_path_service)
       {
-        // If we're currently replanning, we should restart the replanning
-        // because the upcoming solution might involve a closed lane
-        RCLCPP_INFO(
-          self->_context->node()->get_logger(),
-          "Requesting replan for [%s] to account for a newly closed lane",
-          self->_context->requester_id().c_str());
-        self->_context->request_replan();
+        // The search that is underway might not need the closed lanes at all,
+        // so instead of restarting it we check its plan once it arrives.
+        self->_lanes_closed_during_search.insert(
+          changes.closed_lanes.begin(), changes.closed_lanes.end());
+        self->_lanes_speed_limited_during_search.insert(
+          changes.speed_limited_lanes.begin(),
+          changes.speed_limited_lanes.end());
         return;
       }
 
+      // An improvement that is still being searched for was planned for the
+      // old graph, so it can no longer be trusted.
+      self->_improving_service = nullptr;
+      self->_preliminary_plan_id = std::nullopt;
+
       if (self->_execution.has_value())
       {
-        // TODO(@mxgrey): Consider ignoring waypoints that have already been
-        // passed.
-        for (const auto& wp : self->_execution->plan.get_waypoints())
+        // Lanes that the robot has already passed through do not matter, so
+        // only the rest of the plan needs to be checked.
+        const auto& waypoints = self->_execution->plan.get_waypoints();
+        for (std::size_t i = self->_first_remaining_waypoint();
+          i < waypoints.size(); ++i)
         {
-          for (const std::size_t lane : wp.approach_lanes())
+          for (const std::size_t lane : waypoints[i].approach_lanes())
           {
             const auto closed = std::find(
               changes.closed_lanes.begin(),
@@ -254,8 +274,11 @@ auto GoToPlace::Active::make(
             }
           }
         }
+
+        if (!changes.speed_limited_lanes.empty())
+          self->_rescale_for_speed_limits(changes.speed_limited_lanes);
       }
-      else
+      else if (!changes.closed_lanes.empty())
       {
         // Strange that there isn't an execution and also isn't a
         // _find_path_service, but let's just request a replan.
@@ -525,23 +548,65 @@ std::optional<rmf_traffic::agv::Plan::Goal> GoToPlace::Active::_choose_goal(
   return std::nullopt;
 }
 
+//==============================================================================
+std::vector<rmf_traffic::agv::Plan::Goal>
+GoToPlace::Active::_goal_alternatives() const
+{
+  if (_context->_parking_spot_manager_enabled())
+    return {};
+
+  const auto& options = _description.one_of();
+  if (options.size() < 2)
+    return {};
+
+  if (_description.prefer_same_map())
+  {
+    const auto& graph = _context->navigation_graph();
+    std::vector<rmf_traffic::agv::Plan::Goal> same_map;
+    for (const auto& goal : options)
+    {
+      if (graph.get_waypoint(goal.waypoint()).get_map_name() == _context->map())
+        same_map.push_back(goal);
+    }
+
+    if (!same_map.empty())
+      return same_map;
+  }
+
+  return options;
+}
+
 //==============================================================================
 void GoToPlace::Active::_find_plan()
 {
   if (_is_interrupted)
     return;
 
-  if (!_chosen_goal.has_value() && _description.prefer_same_map() )
+  // When there are several destinations to choose from, search for all of
+  // them at once and go to whichever one the search finds best
+  std::vector<rmf_traffic::agv::Plan::Goal> alternatives;
+  if (!_chosen_goal.has_value() && !_skip_goal_alternatives)
+    alternatives = _goal_alternatives();
+  _skip_goal_alternatives = false;
+
+  if (alternatives.size() == 1)
+  {
+    _chosen_goal = alternatives.front();
+    alternatives.clear();
+  }
+
+  if (alternatives.empty() && !_chosen_goal.has_value()
+    && _description.prefer_same_map())
   {
     _chosen_goal = _choose_goal(true);
   }
 
-  if (!_chosen_goal.has_value())
+  if (alternatives.empty() && !_chosen_goal.has_value())
   {
     _chosen_goal = _choose_goal(false);
   }
 
-  if (!_chosen_goal.has_value())
+  if (alternatives.empty() && !_chosen_goal.has_value())
   {
     std::string error_msg = "Unable to find a path to any of the goal options ["
       + _description.destination_name(*_context->task_parameters())
@@ -558,7 +623,8 @@ void GoToPlace::Active::_find_plan()
     return;
   }
 
-  if (_context->location().size() == 0)
+  const auto starts = _seed_starts(_context->location());
+  if (starts.size() == 0)
   {
     RCLCPP_ERROR(
       _context->node()->get_logger(),
@@ -571,7 +637,9 @@ void GoToPlace::Active::_find_plan()
 
   _state->update_status(Status::Underway);
   const auto start_name = wp_name(*_context);
-  const auto goal_name = wp_name(*_context, *_chosen_goal);
+  const auto goal_name = _chosen_goal.has_value() ?
+    wp_name(*_context, *_chosen_goal) :
+    _description.destination_name(*_context->task_parameters());
   _state->update_log().info(
     "Generating plan to move from [" + start_name + "] to [" + goal_name + "]");
 
@@ -579,31 +647,126 @@ void GoToPlace::Active::_find_plan()
   std::stringstream ss;
   ss << "Planning for [" << _context->requester_id()
      << "] to [" << goal_name << "] from one of these locations:"
-     << agv::print_starts(_context->location(), graph);
+     << agv::print_starts(starts, graph);
 
   RCLCPP_INFO(
     _context->node()->get_logger(),
     "%s",
     ss.str().c_str());
 
+  if (_chosen_goal.has_value())
+  {
+    if (const auto& warm_start = _context->planner_warm_start())
+      warm_start->record(starts, _chosen_goal->waypoint());
+
+    if (const auto& warmup = _context->goal_warmup())
+      warmup->record(_chosen_goal->waypoint());
+  }
+
+  // A new search makes any improvement from an earlier search irrelevant
+  _improving_service = nullptr;
+  _preliminary_plan_id = std::nullopt;
+  _lanes_closed_during_search.clear();
+  _lanes_speed_limited_during_search.clear();
+
+  // Only search through the floors and lifts that the route between the start
+  // floor and the goal floor uses
+  auto planner = _context->planner();
+  const auto& floor_planner = _context->floor_planner();
+  if (floor_planner && !_skip_floor_restriction && _chosen_goal.has_value())
+  {
+    const auto& start_floor =
+      graph.get_waypoint(starts.front().waypoint()).get_map_name();
+    const bool one_start_floor = std::all_of(
+      starts.begin(), starts.end(), [&](const auto& start)
+      {
+        return graph.get_waypoint(start.waypoint()).get_map_name()
+        == start_floor;
+      });
+
+    if (one_start_floor)
+    {
+      planner = floor_planner->planner_for(
+        planner, start_floor,
+        graph.get_waypoint(_chosen_goal->waypoint()).get_map_name());
+    }
+  }
+  _skip_floor_restriction = false;
+  const bool floor_restricted = planner != _context->planner();
+
   // TODO(MXG): Make the planning time limit configurable
-  _find_path_service = std::make_shared<services::FindPath>(
-    _context->planner(), _context->location(), *_chosen_goal,
-    _context->schedule()->snapshot(), _context->itinerary().id(),
-    _context->profile(),
-    std::chrono::seconds(5));
+  std::optional<rmf_traffic::Duration> anytime_deadline;
+  if (_chosen_goal.has_value())
+  {
+    anytime_deadline = _context->anytime_planning_deadline();
+    _find_path_service = std::make_shared<services::FindPath>(
+      std::move(planner), starts, *_chosen_goal,
+      _context->schedule()->snapshot(), _context->itinerary().id(),
+      _context->profile(),
+      std::chrono::seconds(5),
+      anytime_deadline);
+  }
+  else
+  {
+    _find_path_service = std::make_shared<services::FindPath>(
+      std::move(planner), starts, std::move(alternatives),
+      _context->schedule()->snapshot(), _context->itinerary().id(),
+      _context->profile(),
+      std::chrono::seconds(5));
+  }
 
   _plan_subscription = rmf_rxcpp::make_job<services::FindPath::Result>(
     _find_path_service)
     .observe_on(rxcpp::identity_same_worker(_context->worker()))
     .subscribe(
-    [w = weak_from_this(), start_name, goal_name, goal = *_chosen_goal](
-      const services::FindPath::Result& result)
+    [
+      w = weak_from_this(),
+      start_name,
+      goal_name,
+      chosen_goal = _chosen_goal,
+      anytime = anytime_deadline.has_value(),
+      floor_restricted,
+      first = std::make_shared<bool>(true),
+      trace = std::make_shared<rmf_traffic_ros2::tracing::Span>(
+        rmf_traffic_ros2::tracing::Span::begin(
+          "plan_path", _context->copy_current_task_id()))
+    ](const services::FindPath::Result& result)
     {
       const auto self = w.lock();
       if (!self)
         return;
 
+      // When choosing between alternatives, the search decided on the goal
+      const auto goal = chosen_goal.value_or(result.get_goal());
+
+      if (!*first)
+      {
+        // An anytime search only sends a second result when it has found a
+        // schedule-compliant plan to improve on the one we started with.
+        self->_improving_service = nullptr;
+        if (result)
+          self->_swap_in_improved_plan(*result, goal);
+
+        return;
+      }
+      *first = false;
+      trace->arg("found", result ? "true" : "false").end();
+
+      if (!result && floor_restricted)
+      {
+        // The floors and lifts that were chosen might not connect the start
+        // to the goal, so search again over the whole graph
+        RCLCPP_INFO(
+          self->_context->node()->get_logger(),
+          "Requesting replan for [%s] over every floor because no plan was "
+          "found through the floors and lifts that were chosen",
+          self->_context->requester_id().c_str());
+        self->_skip_floor_restriction = true;
+        self->_find_path_service = nullptr;
+        self->_context->request_replan();
+        return;
+      }
+
       if (!result)
       {
         // The planner could not find a way to reach the goal
@@ -615,6 +778,7 @@ void GoToPlace::Active::_find_plan()
         // Reset the chosen goal in case this goal has become impossible to
         // reach
         self->_chosen_goal = std::nullopt;
+        self->_skip_goal_alternatives = !chosen_goal.has_value();
         self->_execution = std::nullopt;
         self->_schedule_retry();
 
@@ -624,10 +788,23 @@ void GoToPlace::Active::_find_plan()
         return;
       }
 
+      if (self->_uses_lane_closed_during_search(*result))
+      {
+        RCLCPP_INFO(
+          self->_context->node()->get_logger(),
+          "Requesting replan for [%s] because the plan that was found uses a "
+          "lane that closed during the search",
+          self->_context->requester_id().c_str());
+        self->_find_path_service = nullptr;
+        self->_context->request_replan();
+        return;
+      }
+
+      self->_chosen_goal = goal;
       self->_state->update_status(Status::Underway);
       self->_state->update_log().info(
         "Found a plan to move from ["
-        + start_name + "] to [" + goal_name + "]");
+        + start_name + "] to [" + wp_name(*self->_context, goal) + "]");
 
       auto full_itinerary = project_itinerary(
         *result, self->_description.expected_next_destinations(),
@@ -639,11 +816,28 @@ void GoToPlace::Active::_find_plan()
         std::move(full_itinerary),
         goal);
 
+      if (!self->_lanes_speed_limited_during_search.empty()
+        && self->_execution.has_value())
+      {
+        const std::vector<std::size_t> lanes(
+          self->_lanes_speed_limited_during_search.begin(),
+          self->_lanes_speed_limited_during_search.end());
+        self->_lanes_speed_limited_during_search.clear();
+        self->_rescale_for_speed_limits(lanes);
+      }
+
+      if (anytime && self->_execution.has_value())
+      {
+        // Keep the search going in case it finds a better plan
+        self->_improving_service = self->_find_path_service;
+        self->_preliminary_plan_id = *self->_execution->plan_id;
+      }
+
       self->_find_path_service = nullptr;
       self->_retry_timer = nullptr;
     });
 
-  _find_path_timeout = _context->node()->try_create_wall_timer(
+  _find_path_timeout = _context->node()->create_wheel_timer(
     std::chrono::seconds(10),
     [
       weak_service = _find_path_service->weak_from_this(),
@@ -660,6 +854,194 @@ void GoToPlace::Active::_find_plan()
   _update();
 }
 
+//==============================================================================
+bool GoToPlace::Active::_uses_lane_closed_during_search(
+  const rmf_traffic::agv::Plan& plan) const
+{
+  if (_lanes_closed_during_search.empty())
+    return false;
+
+  for (const auto& wp : plan.get_waypoints())
+  {
+    for (const std::size_t lane : wp.approach_lanes())
+    {
+      if (_lanes_closed_during_search.count(lane) > 0)
+        return true;
+    }
+  }
+
+  return false;
+}
+
+//==============================================================================
+void GoToPlace::Active::_rescale_for_speed_limits(
+  const std::vector<std::size_t>& lanes)
+{
+  const std::unordered_set<std::size_t> changed(lanes.begin(), lanes.end());
+  const auto& graph = _context->navigation_graph();
+  const double nominal_speed = std::max(
+    _context->planner()->get_configuration().vehicle_traits()
+    .linear().get_nominal_velocity(), 1e-3);
+
+  // Delays that were applied for an earlier plan do not carry over
+  const auto plan_id = *_execution->plan_id;
+  if (_speed_limit_plan_id != plan_id)
+  {
+    _speed_limit_plan_id = plan_id;
+    _speed_limit_delays.clear();
+  }
+
+  // Only the time spent on the lanes with new speed limits changes, so compare
+  // the time that the plan leaves for each of those stretches against how
+  // long the robot will need to drive them now. The plan's own times do not
+  // include any earlier speed limit delays, so only the difference from the
+  // delay that each stretch already has gets added.
+  rmf_traffic::Duration extra = rmf_traffic::Duration(0);
+  std::unordered_map<std::size_t, rmf_traffic::Duration> new_delays;
+  const auto& waypoints = _execution->plan.get_waypoints();
+  const std::size_t first =
+    std::max<std::size_t>(1, _first_remaining_waypoint());
+  for (std::size_t i = first; i < waypoints.size(); ++i)
+  {
+    const auto& approach = waypoints[i].approach_lanes();
+    const bool affected = std::any_of(
+      approach.begin(), approach.end(),
+      [&](std::size_t lane) { return changed.count(lane) > 0; });
+    if (!affected)
+      continue;
+
+    double seconds = 0.0;
+    for (const std::size_t l : approach)
+    {
+      if (l >= graph.num_lanes())
+        continue;
+
+      const auto& lane = graph.get_lane(l);
+      const Eigen::Vector2d p0 =
+        graph.get_waypoint(lane.entry().waypoint_index()).get_location();
+      const Eigen::Vector2d p1 =
+        graph.get_waypoint(lane.exit().waypoint_index()).get_location();
+
+      double speed = nominal_speed;
+      if (const auto limit = lane.properties().speed_limit())
+        speed = std::min(speed, *limit);
+
+      seconds += (p1 - p0).norm() / speed;
+    }
+
+    const auto needed = rmf_traffic::time::from_seconds(seconds);
+    const auto planned = waypoints[i].time() - waypoints[i-1].time();
+    const auto required =
+      std::max(needed - planned, rmf_traffic::Duration(0));
+
+    const auto applied_it = _speed_limit_delays.find(i);
+    const auto applied = applied_it == _speed_limit_delays.end() ?
+      rmf_traffic::Duration(0) : applied_it->second;
+
+    extra += required - applied;
+    new_delays[i] = required;
+  }
+
+  if (extra <= rmf_traffic::Duration(0))
+    return;
+
+  // Compare everything that speed limits are now costing the rest of this
+  // plan, so a series of small changes cannot add up to a large delay
+  // unnoticed. Stretches that the robot has already driven cannot be won back
+  // by replanning, so they are left out.
+  rmf_traffic::Duration total = extra;
+  for (const auto& [i, applied] : _speed_limit_delays)
+  {
+    if (i >= first)
+      total += applied;
+  }
+
+  if (total > speed_limit_replan_threshold)
+  {
+    RCLCPP_INFO(
+      _context->node()->get_logger(),
+      "Requesting replan for [%s] because speed limits would delay it by "
+      "%.1fs",
+      _context->requester_id().c_str(),
+      rmf_traffic::time::to_seconds(total));
+    _context->request_replan();
+    return;
+  }
+
+  for (const auto& [i, required] : new_delays)
+    _speed_limit_delays[i] = required;
+
+  // The route is still fine, so the schedule only needs to account for the
+  // robot taking longer to drive it.
+  auto& itinerary = _context->itinerary();
+  const auto delay = itinerary.cumulative_delay(plan_id)
+    .value_or(rmf_traffic::Duration(0));
+  itinerary.cumulative_delay(plan_id, delay + extra);
+
+  RCLCPP_INFO(
+    _context->node()->get_logger(),
+    "Delaying the schedule of [%s] by %.1fs for new speed limits instead of "
+    "replanning",
+    _context->requester_id().c_str(),
+    rmf_traffic::time::to_seconds(extra));
+}
+
+//==============================================================================
+std::size_t GoToPlace::Active::_first_remaining_waypoint() const
+{
+  const auto& waypoints = _execution->plan.get_waypoints();
+  auto progress_time = _context->now();
+  if (_execution->plan_id)
+  {
+    const auto& itin = _context->itinerary();
+    if (const auto delay = itin.cumulative_delay(*_execution->plan_id))
+      progress_time -= *delay;
+  }
+
+  // The robot is on its way to the first waypoint that it should not have
+  // reached yet, so it is still on the lane leading into that waypoint.
+  for (std::size_t i = 0; i < waypoints.size(); ++i)
+  {
+    if (progress_time < waypoints[i].time())
+      return i;
+  }
+
+  return waypoints.size();
+}
+
+//==============================================================================
+rmf_traffic::agv::Plan::StartSet GoToPlace::Active::_seed_starts(
+  rmf_traffic::agv::Plan::StartSet starts) const
+{
+  if (!_execution.has_value() || starts.size() < 2)
+    return starts;
+
+  std::unordered_set<std::size_t> remaining_waypoints;
+  std::unordered_set<std::size_t> remaining_lanes;
+  const auto& waypoints = _execution->plan.get_waypoints();
+  for (std::size_t i = _first_remaining_waypoint(); i < waypoints.size(); ++i)
+  {
+    const auto& wp = waypoints[i];
+    if (wp.graph_index().has_value())
+      remaining_waypoints.insert(*wp.graph_index());
+
+    for (const std::size_t lane : wp.approach_lanes())
+      remaining_lanes.insert(lane);
+  }
+
+  std::stable_partition(
+    starts.begin(), starts.end(),
+    [&](const rmf_traffic::agv::Plan::Start& start)
+    {
+      if (start.lane().has_value())
+        return remaining_lanes.count(*start.lane()) > 0;
+
+      return remaining_waypoints.count(start.waypoint()) > 0;
+    });
+
+  return starts;
+}
+
 //==============================================================================
 GoToPlace::Active::Active(Description description)
 : _description(std::move(description))
@@ -674,7 +1056,7 @@ void GoToPlace::Active::_schedule_retry()
     return;
 
   // TODO(MXG): Make the retry timing configurable
-  _retry_timer = _context->node()->try_create_wall_timer(
+  _retry_timer = _context->node()->create_wheel_timer(
     std::chrono::seconds(5),
     [w = weak_from_this()]()
     {
@@ -723,6 +1105,10 @@ void GoToPlace::Active::_execute_plan(
 
   const auto& graph = _context->navigation_graph();
 
+  // Making the execution puts the new itinerary into the schedule
+  auto trace = rmf_traffic_ros2::tracing::Span::begin(
+    "execute_plan", _context->copy_current_task_id());
+  trace.arg("robot", _context->requester_id());
 
   // If we use the parking spot manager, the goal may be the final destination
   // or some waiting point.
@@ -753,6 +1139,7 @@ void GoToPlace::Active::_execute_plan(
         _reached_waitpoint = true;
       }, _tail_period);
   }
+  trace.end();
 
 
   if (!_execution.has_value())
@@ -765,6 +1152,86 @@ void GoToPlace::Active::_execute_plan(
   }
 }
 
+//==============================================================================
+std::optional<std::size_t> GoToPlace::Active::_first_divergence(
+  const rmf_traffic::agv::Plan& plan) const
+{
+  const auto& current = _execution->plan.get_waypoints();
+  const auto& other = plan.get_waypoints();
+  const std::size_t n = std::min(current.size(), other.size());
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    const auto& a = current[i];
+    const auto& b = other[i];
+    if (a.graph_index() != b.graph_index())
+      return i;
+
+    if ((a.position() - b.position()).norm() > 1e-3)
+      return i;
+
+    const auto dt = a.time() > b.time() ?
+      a.time() - b.time() : b.time() - a.time();
+    if (dt > std::chrono::milliseconds(100))
+      return i;
+  }
+
+  if (current.size() == other.size())
+    return std::nullopt;
+
+  return n;
+}
+
+//==============================================================================
+void GoToPlace::Active::_swap_in_improved_plan(
+  rmf_traffic::agv::Plan plan,
+  rmf_traffic::agv::Plan::Goal goal)
+{
+  const auto preliminary_plan_id = _preliminary_plan_id;
+  _preliminary_plan_id = std::nullopt;
+  if (_is_interrupted || !preliminary_plan_id.has_value())
+    return;
+
+  // If the plan was replaced in the meantime, e.g. by a negotiation, then the
+  // improvement was found for a situation that no longer applies.
+  if (!_execution.has_value() || *_execution->plan_id != *preliminary_plan_id)
+    return;
+
+  const auto divergence = _first_divergence(plan);
+  if (!divergence.has_value())
+    return;
+
+  // Both plans leave from the same place at the same time, so the robot can
+  // switch over as long as it has not left the last waypoint that they share.
+  if (_first_remaining_waypoint() >= *divergence)
+  {
+    RCLCPP_INFO(
+      _context->node()->get_logger(),
+      "Found a schedule-compliant plan for [%s], but the robot has already "
+      "moved past the point where it diverges from the current plan",
+      _context->requester_id().c_str());
+    return;
+  }
+
+  RCLCPP_INFO(
+    _context->node()->get_logger(),
+    "Switching [%s] over to a schedule-compliant plan that diverges from its "
+    "current plan at waypoint %lu",
+    _context->requester_id().c_str(),
+    *divergence);
+
+  _state->update_log().info(
+    "Switching to an improved plan that complies with the traffic schedule");
+
+  auto full_itinerary = project_itinerary(
+    plan, _description.expected_next_destinations(), *_context->planner());
+
+  _execute_plan(
+    _context->itinerary().assign_plan_id(),
+    std::move(plan),
+    std::move(full_itinerary),
+    std::move(goal));
+}
+
 //==============================================================================
 void GoToPlace::Active::_stop_and_clear()
 {
@@ -807,7 +1274,8 @@ Negotiator::NegotiatePtr GoToPlace::Active::_respond(
       return std::nullopt;
     };
 
-  const auto evaluator = Negotiator::make_evaluator(table_view);
+  const auto evaluator =
+    Negotiator::make_evaluator(table_view, _context->evaluator_tuning());
   return services::Negotiate::path(
     _context->itinerary().assign_plan_id(), _context->planner(),
     _context->location(), *_chosen_goal,
@@ -28,6 +28,8 @@
 
 #include <cstdint>
 #include <optional>
+#include <unordered_map>
+#include <unordered_set>
 #include <rmf_task_sequence/Event.hpp>
 #include <rmf_task_sequence/events/GoToPlace.hpp>
 #include <rmf_task/events/SimpleEventState.hpp>
@@ -119,14 +121,60 @@ public:
     std::optional<rmf_traffic::agv::Plan::Goal> _choose_goal(
       bool only_same_map) const;
 
+    /// Get the destinations that a single search should choose between. This
+    /// is empty when there is only one destination or when the reservation
+    /// node chooses the destination. Destinations on other maps are left out
+    /// if the description prefers the same map and some destination is on the
+    /// robot's current map.
+    std::vector<rmf_traffic::agv::Plan::Goal> _goal_alternatives() const;
+
     void _find_plan();
 
+    /// Get the index of the first waypoint of the current plan that the robot
+    /// has not passed yet, based on the timing of the plan and the delay of
+    /// the itinerary. This must only be called while there is an execution.
+    std::size_t _first_remaining_waypoint() const;
+
+    /// Reorder the starts so that the ones that continue along the rest of the
+    /// current plan come first. The search for a new plan is seeded by the
+    /// first start, so this keeps a replan close to the route that the robot
+    /// was already following.
+    rmf_traffic::agv::Plan::StartSet _seed_starts(
+      rmf_traffic::agv::Plan::StartSet starts) const;
+
     void _execute_plan(
       rmf_traffic::PlanId plan_id,
       rmf_traffic::agv::Plan plan,
       rmf_traffic::schedule::Itinerary full_itinerary,
       rmf_traffic::agv::Plan::Goal goal);
 
+    /// Get the index of the first waypoint where the given plan stops matching
+    /// the plan that is currently being executed. This will be std::nullopt if
+    /// the plans are the same. This must only be called while there is an
+    /// execution.
+    std::optional<std::size_t> _first_divergence(
+      const rmf_traffic::agv::Plan& plan) const;
+
+    /// True if the plan uses any lane that closed while it was being searched
+    /// for.
+    bool _uses_lane_closed_during_search(
+      const rmf_traffic::agv::Plan& plan) const;
+
+    /// Account for new speed limits on the lanes that the rest of the current
+    /// plan uses. The schedule gets delayed to match, unless the delay is
+    /// large enough that a different route may be better, in which case a
+    /// replan is requested. Each stretch of the plan is only ever delayed by
+    /// what its current speed limits need, no matter how many times its limits
+    /// change.
+    void _rescale_for_speed_limits(const std::vector<std::size_t>& lanes);
+
+    /// Switch from the preliminary plan of an anytime search over to the
+    /// improved plan, as long as the robot has not already moved past the
+    /// point where the two plans diverge.
+    void _swap_in_improved_plan(
+      rmf_traffic::agv::Plan plan,
+      rmf_traffic::agv::Plan::Goal goal);
+
     void _stop_and_clear();
 
     void _on_reservation_node_allocate_final_destination(
@@ -151,8 +199,27 @@ public:
     std::optional<ExecutePlan> _execution;
     std::shared_ptr<services::FindPath> _find_path_service;
     rmf_rxcpp::subscription_guard _plan_subscription;
-    rclcpp::TimerBase::SharedPtr _find_path_timeout;
-    rclcpp::TimerBase::SharedPtr _retry_timer;
+
+    // Lanes that closed while _find_path_service was searching. The plan that
+    // it finds only gets thrown out if it uses one of them.
+    std::unordered_set<std::size_t> _lanes_closed_during_search;
+
+    // Lanes whose speed limits changed while _find_path_service was searching.
+    // The plan that it finds was timed with the old limits, so it gets
+    // rescaled once it starts executing.
+    std::unordered_set<std::size_t> _lanes_speed_limited_during_search;
+
+    // How much the schedule has been delayed for the speed limits on the lane
+    // leading into each waypoint of the plan _speed_limit_plan_id.
+    std::optional<rmf_traffic::PlanId> _speed_limit_plan_id;
+    std::unordered_map<std::size_t, rmf_traffic::Duration> _speed_limit_delays;
+
+    // While an anytime search keeps looking for a better plan, this keeps the
+    // search alive and remembers which plan the robot started moving on.
+    std::shared_ptr<services::FindPath> _improving_service;
+    std::optional<rmf_traffic::PlanId> _preliminary_plan_id;
+    TimerWheel::TimerPtr _find_path_timeout;
+    TimerWheel::TimerPtr _retry_timer;
 
     rmf_rxcpp::subscription_guard _replan_request_subscription;
     rmf_rxcpp::subscription_guard _graph_change_subscription;
@@ -161,6 +228,13 @@ public:
 
     bool _is_interrupted = false;
     bool _is_final_destination = true;
+    // Search over the whole graph on the next attempt because a search that
+    // was restricted to some of the floors could not find a plan
+    bool _skip_floor_restriction = false;
+
+    // Choose one destination before searching on the next attempt because a
+    // search over several alternative destinations could not find a plan
+    bool _skip_goal_alternatives = false;
     bool _reached_waitpoint = false;
   };
 };
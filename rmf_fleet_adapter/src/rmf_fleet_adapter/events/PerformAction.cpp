@@ -77,6 +77,18 @@ auto PerformAction::Standby::make(
     {},
     context->clock());
 
+  if (const auto& pipeline = context->action_pipeline())
+  {
+    standby->_pipeline_ticket = pipeline->prepare(
+      ActionPipeline::Action{
+        description.category(),
+        description.description(),
+        standby->_time_estimate,
+        state.waypoint(),
+        state.time()
+      });
+  }
+
   return standby;
 }
 
@@ -115,7 +127,8 @@ auto PerformAction::Standby::begin(
       _time_estimate,
       _state,
       _update,
-      std::move(finished));
+      std::move(finished),
+      _pipeline_ticket);
   }
 
   return _active;
@@ -130,7 +143,9 @@ auto PerformAction::Active::make(
   rmf_traffic::Duration time_estimate,
   rmf_task::events::SimpleEventStatePtr state,
   std::function<void()> update,
-  std::function<void()> finished) -> std::shared_ptr<Active>
+  std::function<void()> finished,
+  std::shared_ptr<ActionPipeline::Ticket> pipeline_ticket)
+-> std::shared_ptr<Active>
 {
   auto active = std::make_shared<Active>(
     Active(std::move(category), std::move(desc), time_estimate));
@@ -139,6 +154,7 @@ auto PerformAction::Active::make(
   active->_update = std::move(update);
   active->_finished = std::move(finished);
   active->_state = std::move(state);
+  active->_pipeline_ticket = std::move(pipeline_ticket);
   active->_execute_action();
   active->_expected_finish_time =
     active->_context->now() + time_estimate;
@@ -283,6 +299,16 @@ void PerformAction::Active::_execute_action()
     _context, std::move(finished), _state, std::nullopt);
   _execution_data = data;
 
+  const auto& pipeline = _context->action_pipeline();
+  if (pipeline && _pipeline_ticket)
+  {
+    pipeline->start(*_pipeline_ticket);
+    if (const auto next = pipeline->next(*_pipeline_ticket))
+      data->next_action = std::make_pair(next->category, next->description);
+
+    _hold_for_pipeline(*pipeline);
+  }
+
   auto action_execution =
     agv::RobotUpdateHandle::ActionExecution::Implementation::make(data);
 
@@ -293,5 +319,32 @@ void PerformAction::Active::_execute_action()
     std::move(action_execution));
 }
 
+//==============================================================================
+void PerformAction::Active::_hold_for_pipeline(ActionPipeline& pipeline)
+{
+  const auto now = _context->now();
+  const auto& map = _context->map();
+  const auto position = _context->position();
+  auto& itinerary = _context->itinerary();
+  if (pipeline.hold_covers(
+      itinerary.current_plan_id(), map, position, now + _time_estimate))
+  {
+    // The robot is still holding for the chain of actions that this one
+    // belongs to, so there is nothing to update.
+    return;
+  }
+
+  const auto until = now + _time_estimate
+    + pipeline.following_duration(*_pipeline_ticket);
+
+  rmf_traffic::Trajectory trajectory;
+  trajectory.insert(now, position, Eigen::Vector3d::Zero());
+  trajectory.insert(until, position, Eigen::Vector3d::Zero());
+
+  const auto plan_id = itinerary.assign_plan_id();
+  itinerary.set(plan_id, {{map, std::move(trajectory)}});
+  pipeline.hold(plan_id, map, position, until);
+}
+
 } // namespace events
 } // namespace rmf_fleet_adapter
@@ -71,6 +71,7 @@ public:
     rmf_traffic::Duration _time_estimate;
     std::function<void()> _update;
     rmf_task::events::SimpleEventStatePtr _state;
+    std::shared_ptr<ActionPipeline::Ticket> _pipeline_ticket;
     ActivePtr _active = nullptr;
   };
 
@@ -91,7 +92,8 @@ public:
       rmf_traffic::Duration _time_estimate,
       rmf_task::events::SimpleEventStatePtr state,
       std::function<void()> update,
-      std::function<void()> finished);
+      std::function<void()> finished,
+      std::shared_ptr<ActionPipeline::Ticket> pipeline_ticket = nullptr);
 
     ConstStatePtr state() const final;
 
@@ -114,6 +116,10 @@ public:
 
     void _execute_action();
 
+    // Put a hold for this action and the actions that follow it back to back
+    // on the schedule, unless the hold of an earlier action still covers it.
+    void _hold_for_pipeline(ActionPipeline& pipeline);
+
     AssignIDPtr _assign_id;
     agv::RobotContextPtr _context;
     std::string _action_category;
@@ -125,6 +131,7 @@ public:
     rmf_traffic::Time _expected_finish_time;
     std::shared_ptr<void> _be_stubborn;
     std::weak_ptr<ExecutionData> _execution_data;
+    std::shared_ptr<ActionPipeline::Ticket> _pipeline_ticket;
   };
 };
 
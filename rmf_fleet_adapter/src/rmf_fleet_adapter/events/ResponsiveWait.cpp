@@ -23,6 +23,8 @@
 
 #include <rmf_traffic_ros2/Time.hpp>
 
+#include <algorithm>
+
 namespace rmf_fleet_adapter {
 namespace events {
 
@@ -95,21 +97,24 @@ rmf_task::Task::ActivePtr ResponsiveWait::start(
 //==============================================================================
 auto ResponsiveWait::Description::make_indefinite(
   std::size_t waiting_point,
-  rmf_traffic::Duration update_period) -> ConstDescriptionPtr
+  rmf_traffic::Duration update_period,
+  rmf_traffic::Duration hold_horizon) -> ConstDescriptionPtr
 {
   return std::make_shared<Description>(
-    Description(waiting_point, update_period));
+    Description(waiting_point, update_period, hold_horizon));
 }
 
 //==============================================================================
 ResponsiveWait::Description::Description(
   std::size_t waiting_point_,
-  rmf_traffic::Duration period_)
+  rmf_traffic::Duration period_,
+  rmf_traffic::Duration horizon_)
 : rmf_task_sequence::events::Placeholder::Description(
     "Responsive Wait", "Waiting at a location without blocking traffic"),
   // TODO(MXG): Make the description specific to the description parameters.
   waiting_point(waiting_point_),
-  period(period_)
+  period(period_),
+  horizon(horizon_)
 {
   // Do nothing
 }
@@ -238,6 +243,12 @@ auto ResponsiveWait::Active::interrupt(
   if (_interrupted || !_go_to_place)
   {
     _interrupted = true;
+    if (_holding_negotiator)
+    {
+      _stop_holding();
+      _context->itinerary().clear();
+    }
+
     task_is_interrupted();
     return resume;
   }
@@ -260,7 +271,15 @@ void ResponsiveWait::Active::cancel()
   _state->update_log().info("Received signal to cancel");
   _cancelled = true;
   if (_go_to_place)
+  {
     _go_to_place->cancel();
+  }
+  else if (_holding_negotiator)
+  {
+    _stop_holding();
+    _context->itinerary().clear();
+    _finished();
+  }
 }
 
 //==============================================================================
@@ -270,7 +289,15 @@ void ResponsiveWait::Active::kill()
   _state->update_log().info("Received signal to kill");
   _cancelled = true;
   if (_go_to_place)
+  {
     _go_to_place->kill();
+  }
+  else if (_holding_negotiator)
+  {
+    _stop_holding();
+    _context->itinerary().clear();
+    _finished();
+  }
 }
 
 //==============================================================================
@@ -301,6 +328,14 @@ void ResponsiveWait::Active::_next_cycle()
     return;
   }
 
+  if (_at_waiting_point())
+  {
+    // The robot has arrived, so there is no need to keep planning for it
+    // until something gets in its way.
+    _hold();
+    return;
+  }
+
   RCLCPP_DEBUG(
     _context->node()->get_logger(),
     "Beginning next responsive wait cycle for [%s] and waypoint %lu",
@@ -330,5 +365,148 @@ void ResponsiveWait::Active::_begin_movement()
     });
 }
 
+//==============================================================================
+bool ResponsiveWait::Active::_at_waiting_point() const
+{
+  for (const auto& start : _context->location())
+  {
+    if (!start.lane().has_value()
+      && start.waypoint() == _description.waiting_point)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//==============================================================================
+void ResponsiveWait::Active::_hold()
+{
+  _go_to_place = nullptr;
+  RCLCPP_DEBUG(
+    _context->node()->get_logger(),
+    "Holding [%s] on waypoint %lu for its responsive wait",
+    _context->requester_id().c_str(),
+    _description.waiting_point);
+
+  if (!_holding_negotiator)
+  {
+    // Negotiations can arrive on any thread, so they get handed over on the
+    // worker. The response is submitted by the movement that takes over.
+    _holding_negotiator = Negotiator::make(
+      _context,
+      [w = weak_from_this()](
+        const auto& table_view,
+        const auto& responder) -> Negotiator::NegotiatePtr
+      {
+        const auto self = w.lock();
+        if (!self)
+        {
+          responder->forfeit({});
+          return nullptr;
+        }
+
+        self->_context->worker().schedule(
+          [w, table_view, responder](const auto&)
+          {
+            if (const auto self = w.lock())
+              self->_replan_for_conflict(table_view, responder);
+            else
+              responder->forfeit({});
+          });
+
+        return nullptr;
+      });
+
+    _hold_replan_subscription = _context->observe_replan_request()
+      .observe_on(rxcpp::identity_same_worker(_context->worker()))
+      .subscribe(
+      [w = weak_from_this()](const auto&)
+      {
+        const auto self = w.lock();
+        if (!self || !self->_holding_negotiator)
+          return;
+
+        self->_stop_holding();
+        self->_begin_movement();
+      });
+  }
+
+  _renew_hold();
+}
+
+//==============================================================================
+void ResponsiveWait::Active::_renew_hold()
+{
+  if (!_at_waiting_point())
+  {
+    // Something moved the robot away from its waiting point, so it needs to
+    // plan its way back.
+    _stop_holding();
+    _begin_movement();
+    return;
+  }
+
+  // Renewing the hold under the same plan lets the schedule receive it as a
+  // small delay instead of a whole new itinerary
+  if (!_hold_plan_id
+    || *_hold_plan_id != _context->itinerary().current_plan_id())
+  {
+    _hold_plan_id = std::make_shared<rmf_traffic::PlanId>(
+      _context->itinerary().assign_plan_id());
+  }
+
+  _context->schedule_hold(
+    _hold_plan_id,
+    _context->now(),
+    _description.horizon,
+    _context->position(),
+    _context->map());
+
+  const auto renew_after = std::max(
+    _description.horizon - _description.period, _description.horizon/2);
+
+  _hold_renewal_timer = _context->node()->create_wheel_timer(
+    renew_after,
+    [w = weak_from_this()]()
+    {
+      const auto self = w.lock();
+      if (!self || !self->_holding_negotiator)
+        return;
+
+      self->_renew_hold();
+    });
+}
+
+//==============================================================================
+void ResponsiveWait::Active::_stop_holding()
+{
+  _holding_negotiator = nullptr;
+  _hold_renewal_timer = nullptr;
+  _hold_plan_id = nullptr;
+  _hold_replan_subscription = rmf_rxcpp::subscription_guard();
+}
+
+//==============================================================================
+void ResponsiveWait::Active::_replan_for_conflict(
+  const Negotiator::TableViewerPtr& table_view,
+  const Negotiator::ResponderPtr& responder)
+{
+  if (_holding_negotiator && !_interrupted && !_cancelled)
+  {
+    RCLCPP_DEBUG(
+      _context->node()->get_logger(),
+      "Replanning the responsive wait of [%s] for a traffic conflict",
+      _context->requester_id().c_str());
+
+    _stop_holding();
+    _begin_movement();
+  }
+
+  // Whoever is responsible for the robot now will give the response
+  _context->respond(table_view, responder);
+}
+
 } // namespace events
 } // namespace rmf_fleet_adapter
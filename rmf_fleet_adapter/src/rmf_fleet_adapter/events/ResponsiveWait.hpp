@@ -19,6 +19,7 @@
 #define SRC__RMF_FLEET_ADAPTER__EVENTS__RESPONSIVEWAIT_HPP
 
 #include "../agv/RobotContext.hpp"
+#include "../Negotiator.hpp"
 
 #include <rmf_task/events/SimpleEventState.hpp>
 #include <rmf_task_sequence/Event.hpp>
@@ -48,10 +49,15 @@ public:
     /// Make an ActiveWait phase that has no deadline. The phase will continue
     /// until someone explicitly calls cancel() on it.
     ///
-    /// To avoid slamming the schedule with an unreasonably long waiting
-    /// prediction, the phase will only schedule a wait for the duration of
-    /// the update_period parameter. When that period has passed, the phase will
-    /// restart its scheduling for another duration equal to update_period.
+    /// While the robot is moving to the waiting point, the phase will only
+    /// schedule a wait for the duration of the update_period parameter.
+    ///
+    /// Once the robot has arrived, the phase holds it in place without any
+    /// further planning. The hold is scheduled for the duration of the
+    /// hold_horizon parameter and gets renewed one update_period before it
+    /// runs out. The robot only plans again when a traffic conflict involving
+    /// it is negotiated, when a replan is requested, or when it is found away
+    /// from the waiting point.
     ///
     /// The value of update_period may have a noticeable impact on how other
     /// traffic participants schedule around or through this robot. A small
@@ -67,18 +73,24 @@ public:
     ///
     /// \param[in] update_period
     ///   The scheduling period for the waiting
+    ///
+    /// \param[in] hold_horizon
+    ///   How far ahead the hold at the waiting point is scheduled
     static ConstDescriptionPtr make_indefinite(
       std::size_t waiting_point,
-      rmf_traffic::Duration update_period = std::chrono::seconds(30));
+      rmf_traffic::Duration update_period = std::chrono::seconds(30),
+      rmf_traffic::Duration hold_horizon = std::chrono::minutes(10));
 
     // TODO(MXG): Consider bringing back make_until(...)
 
     std::size_t waiting_point;
     rmf_traffic::Duration period;
+    rmf_traffic::Duration horizon;
 
     Description(
       std::size_t waiting_point_,
-      rmf_traffic::Duration period_);
+      rmf_traffic::Duration period_,
+      rmf_traffic::Duration horizon_);
   };
 
   class Standby : public rmf_task_sequence::Event::Standby
@@ -146,6 +158,22 @@ public:
 
     void _begin_movement();
 
+    /// True if the robot is resting on its waiting point
+    bool _at_waiting_point() const;
+
+    /// Hold the robot on its waiting point without planning
+    void _hold();
+
+    /// Schedule the hold for another horizon
+    void _renew_hold();
+
+    void _stop_holding();
+
+    /// Hand a negotiation that arrived while holding over to a new movement
+    void _replan_for_conflict(
+      const Negotiator::TableViewerPtr& table_view,
+      const Negotiator::ResponderPtr& responder);
+
     Description _description;
     std::shared_ptr<rmf_task_sequence::Event::Active> _go_to_place;
     AssignIDPtr _assign_id;
@@ -156,6 +184,12 @@ public:
     bool _interrupted = false;
     bool _cancelled = false;
     std::function<void()> _waiting_for_interruption;
+
+    // These are only set while the robot is holding on its waiting point
+    std::shared_ptr<Negotiator> _holding_negotiator;
+    TimerWheel::TimerPtr _hold_renewal_timer;
+    std::shared_ptr<rmf_traffic::PlanId> _hold_plan_id;
+    rmf_rxcpp::subscription_guard _hold_replan_subscription;
   };
 };
 
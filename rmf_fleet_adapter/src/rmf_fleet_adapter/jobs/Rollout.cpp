@@ -25,13 +25,56 @@ Rollout::Rollout(
   rmf_traffic::agv::Planner::Result result,
   rmf_traffic::schedule::ParticipantId blocker,
   rmf_traffic::Duration span,
-  rmf_utils::optional<std::size_t> max_rollouts)
-: _rollout(std::move(result)),
+  rmf_utils::optional<std::size_t> max_rollouts,
+  std::shared_ptr<std::atomic_bool> interrupt_flag,
+  std::optional<rmf_traffic::Duration> time_budget)
+: _options(result.options()),
+  _rollout(std::move(result)),
   _blocker(blocker),
   _span(span),
-  _max_rollouts(max_rollouts)
+  _max_rollouts(max_rollouts),
+  _interrupt_flag(std::move(interrupt_flag)),
+  _time_budget(time_budget)
 {
-  // Do nothing
+  if (!_interrupt_flag)
+    _interrupt_flag = std::make_shared<std::atomic_bool>(false);
+}
+
+//==============================================================================
+void Rollout::interrupt()
+{
+  *_interrupt_flag = true;
+}
+
+//==============================================================================
+std::function<bool()> Rollout::_make_interrupter() const
+{
+  const auto deadline = _time_budget.has_value() ?
+    std::make_optional(std::chrono::steady_clock::now() + *_time_budget) :
+    std::nullopt;
+
+  const auto counter = std::make_shared<uint32_t>(0);
+  return [interrupt_flag = _interrupt_flag, deadline, counter,
+      previous = _options.interrupter()]()
+    {
+      if (previous && previous())
+        return true;
+
+      ++*counter;
+      if (*counter > 20)
+      {
+        *counter = 0;
+        // Only check these once in a while to reduce planning overhead
+        if (*interrupt_flag)
+          return true;
+
+        const auto now = std::chrono::steady_clock::now();
+        if (deadline.has_value() && *deadline <= now)
+          return true;
+      }
+
+      return false;
+    };
 }
 
 } // namespace jobs
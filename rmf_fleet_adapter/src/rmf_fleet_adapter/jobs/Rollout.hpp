@@ -20,6 +20,10 @@
 
 #include <rmf_traffic/agv/Rollout.hpp>
 
+#include <atomic>
+#include <memory>
+#include <optional>
+
 namespace rmf_fleet_adapter {
 namespace jobs {
 
@@ -33,20 +37,42 @@ public:
     std::vector<rmf_traffic::schedule::Itinerary> alternatives;
   };
 
+  /// Expand alternatives for a blocked plan.
+  ///
+  /// \param[in] max_rollouts
+  ///   Stop expanding once this many alternatives have been found.
+  ///
+  /// \param[in] interrupt_flag
+  ///   If this flag gets set while the rollout is running, the expansion stops
+  ///   early and only the alternatives found so far are delivered.
+  ///
+  /// \param[in] time_budget
+  ///   The expansion stops early once this much time has passed since it
+  ///   began, and only the alternatives found so far are delivered.
   Rollout(
     rmf_traffic::agv::Planner::Result result,
     rmf_traffic::schedule::ParticipantId blocker,
     rmf_traffic::Duration span,
-    rmf_utils::optional<std::size_t> max_rollouts = rmf_utils::nullopt);
+    rmf_utils::optional<std::size_t> max_rollouts = rmf_utils::nullopt,
+    std::shared_ptr<std::atomic_bool> interrupt_flag = nullptr,
+    std::optional<rmf_traffic::Duration> time_budget = std::nullopt);
+
+  /// Stop the expansion early
+  void interrupt();
 
   template<typename Subscriber, typename Worker>
   void operator()(const Subscriber& s, const Worker& w);
 
 private:
+  std::function<bool()> _make_interrupter() const;
+
+  rmf_traffic::agv::Planner::Options _options;
   rmf_traffic::agv::Rollout _rollout;
   rmf_traffic::schedule::ParticipantId _blocker;
   rmf_traffic::Duration _span;
   rmf_utils::optional<std::size_t> _max_rollouts;
+  std::shared_ptr<std::atomic_bool> _interrupt_flag;
+  std::optional<rmf_traffic::Duration> _time_budget;
 };
 
 } // namespace jobs
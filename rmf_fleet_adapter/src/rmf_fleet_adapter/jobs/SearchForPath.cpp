@@ -59,7 +59,7 @@ SearchForPath::SearchForPath(
   _goal(std::move(goal)),
   _schedule(std::move(schedule)),
   _participant_id(participant_id),
-  _worker(rxcpp::schedulers::make_event_loop().create_worker())
+  _worker(rmf_rxcpp::detail::get_job_scheduler().create_worker())
 {
   if (planning_time_limit.has_value())
   {
@@ -129,5 +129,11 @@ void SearchForPath::set_cost_limit(double cost)
   _explicit_cost_limit = cost;
 }
 
+//==============================================================================
+void SearchForPath::report_greedy_early()
+{
+  _report_greedy_early = true;
+}
+
 } // namespace jobs
 } // namespace rmf_fleet_adapter
@@ -65,6 +65,11 @@ public:
 
   void set_cost_limit(double cost);
 
+  // Report the greedy plan as soon as it is found instead of holding it back
+  // until the compliant job is finished. The final result will still be
+  // reported once both jobs are finished.
+  void report_greedy_early();
+
   Planning& greedy();
   const Planning& greedy() const;
 
@@ -96,6 +101,7 @@ private:
   bool _compliant_finished = false;
 
   rmf_utils::optional<double> _explicit_cost_limit;
+  bool _report_greedy_early = false;
 
   rxcpp::schedulers::worker _worker;
   std::optional<rmf_traffic::Time> _deadline;
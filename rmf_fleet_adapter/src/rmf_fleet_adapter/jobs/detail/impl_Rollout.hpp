@@ -27,7 +27,12 @@ namespace jobs {
 template<typename Subscriber, typename Worker>
 void Rollout::operator()(const Subscriber& s, const Worker&)
 {
-  s.on_next(Result{_rollout.expand(_blocker, _span, _max_rollouts)});
+  // The planner checks the interrupter throughout each rollout, so the
+  // expansion stops soon after the negotiation no longer needs alternatives or
+  // the time budget runs out, with whatever alternatives were found by then.
+  auto options = _options;
+  options.interrupter(_make_interrupter());
+  s.on_next(Result{_rollout.expand(_blocker, _span, options, _max_rollouts)});
   s.on_completed();
 }
 
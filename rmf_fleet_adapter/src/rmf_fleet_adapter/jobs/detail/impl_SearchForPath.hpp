@@ -92,7 +92,7 @@ void SearchForPath::operator()(const Subscriber& s, const Worker&)
           s.on_completed();
           return;
         }
-        else if (search->_explicit_cost_limit)
+        else if (search->_explicit_cost_limit || search->_report_greedy_early)
         {
           s.on_next(next);
 
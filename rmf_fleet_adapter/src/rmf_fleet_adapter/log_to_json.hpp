@@ -22,6 +22,8 @@
 
 #include <nlohmann/json.hpp>
 #include <chrono>
+#include <cstdint>
+#include <string>
 
 namespace rmf_fleet_adapter {
 
@@ -49,18 +51,28 @@ inline std::string tier_to_string(rmf_task::Log::Tier tier)
 }
 
 //==============================================================================
-inline nlohmann::json log_to_json(const rmf_task::Log::Entry& entry)
+inline nlohmann::json log_to_json(
+  uint64_t seq,
+  rmf_task::Log::Tier tier,
+  std::chrono::nanoseconds time_since_epoch,
+  const std::string& text)
 {
   nlohmann::json output;
-  output["seq"] = entry.seq();
-  output["tier"] = tier_to_string(entry.tier());
-  output["unix_millis_time"] =
-    to_millis(entry.time().time_since_epoch()).count();
-  output["text"] = entry.text();
+  output["seq"] = seq;
+  output["tier"] = tier_to_string(tier);
+  output["unix_millis_time"] = to_millis(time_since_epoch).count();
+  output["text"] = text;
 
   return output;
 }
 
+//==============================================================================
+inline nlohmann::json log_to_json(const rmf_task::Log::Entry& entry)
+{
+  return log_to_json(
+    entry.seq(), entry.tier(), entry.time().time_since_epoch(), entry.text());
+}
+
 } // namespace rmf_fleet_adapter
 
 #endif // SRC__RMF_FLEET_ADAPTER__LOG_TO_JSON_HPP
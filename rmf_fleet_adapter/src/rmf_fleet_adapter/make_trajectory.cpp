@@ -35,6 +35,7 @@ rmf_traffic::Trajectory make_trajectory(
 
 
   std::vector<Eigen::Vector3d> positions;
+  positions.reserve(state.path.size() + 1);
   positions.push_back({state.location.x, state.location.y, state.location.yaw});
   for (const auto& location : state.path)
     positions.push_back({location.x, location.y, location.yaw});
@@ -71,6 +72,7 @@ rmf_traffic::Trajectory make_trajectory(
   const rmf_traffic::agv::VehicleTraits& traits)
 {
   std::vector<Eigen::Vector3d> positions;
+  positions.reserve(path.size());
   for (const auto& location : path)
     positions.push_back({location.x, location.y, location.yaw});
 
@@ -84,6 +86,7 @@ rmf_traffic::Trajectory make_timed_trajectory(
   const rmf_traffic::agv::VehicleTraits& traits)
 {
   rmf_traffic::Trajectory output;
+  std::vector<Eigen::Vector3d> positions(2);
   for (const auto& location : path)
   {
     if (output.size() == 0)
@@ -95,17 +98,24 @@ rmf_traffic::Trajectory make_timed_trajectory(
       continue;
     }
 
-    std::vector<Eigen::Vector3d> positions;
-    positions.reserve(2);
-    positions.push_back(output.back().position());
-    positions.push_back({location.x, location.y, location.yaw});
+    positions[0] = output.back().position();
+    positions[1] = Eigen::Vector3d(location.x, location.y, location.yaw);
+
+    // Locations that repeat the previous one only add waiting time
+    if (positions[0] != positions[1])
+    {
+      rmf_traffic::Trajectory extension =
+        rmf_traffic::agv::Interpolate::positions(traits,
+          output.back().time(), positions);
 
-    rmf_traffic::Trajectory extension =
-      rmf_traffic::agv::Interpolate::positions(traits,
-        output.back().time(), positions);
+      // The first waypoint of the extension is the one we already have
+      auto it = extension.begin();
+      if (it != extension.end())
+        ++it;
 
-    for (const auto& wp : extension)
-      output.insert(wp);
+      for (; it != extension.end(); ++it)
+        output.insert(*it);
+    }
 
     const auto wait_time = rmf_traffic_ros2::convert(location.t);
     const auto wait_duration = wait_time - output.back().time();
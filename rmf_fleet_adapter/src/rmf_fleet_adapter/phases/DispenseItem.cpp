@@ -122,7 +122,7 @@ void DispenseItem::ActivePhase::_init_obs()
 
         me->_do_publish();
         me->_timer =
-        node->try_create_wall_timer(std::chrono::milliseconds(1000), [weak]()
+        node->create_wheel_timer(std::chrono::milliseconds(1000), [weak]()
         {
           auto me = weak.lock();
           if (!me)
@@ -105,7 +105,7 @@ void DoorOpen::ActivePhase::_init_obs()
   using rmf_door_msgs::msg::SupervisorHeartbeat;
   using CombinedType = std::tuple<DoorState::SharedPtr,
       SupervisorHeartbeat::SharedPtr>;
-  _obs = transport->door_state().combine_latest(
+  _obs = transport->door_state(_door_name).combine_latest(
     rxcpp::observe_on_event_loop(),
     transport->door_supervisor())
     .lift<CombinedType>(on_subscribe([weak = weak_from_this(), transport]()
@@ -117,7 +117,7 @@ void DoorOpen::ActivePhase::_init_obs()
         me->_status.state = LegacyTask::StatusMsg::STATE_ACTIVE;
         me->_publish_open_door();
         me->_timer =
-        transport->try_create_wall_timer(std::chrono::milliseconds(1000),
+        transport->create_wheel_timer(std::chrono::milliseconds(1000),
         [weak, transport]()
         {
           auto me = weak.lock();
@@ -70,7 +70,7 @@ struct DoorOpen
       rxcpp::subjects::behavior<bool>(false);
     rxcpp::observable<LegacyTask::StatusMsg> _obs;
     std::string _description;
-    rclcpp::TimerBase::SharedPtr _timer;
+    TimerWheel::TimerPtr _timer;
     LegacyTask::StatusMsg _status;
     std::shared_ptr<DoorClose::ActivePhase> _door_close_phase;
 
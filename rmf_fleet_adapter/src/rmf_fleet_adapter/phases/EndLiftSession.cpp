@@ -91,7 +91,7 @@ void EndLiftSession::Active::_init_obs()
 {
   using rmf_lift_msgs::msg::LiftRequest;
   using rmf_lift_msgs::msg::LiftState;
-  _obs = _context->node()->lift_state()
+  _obs = _context->node()->lift_state(_lift_name)
     .map([weak = weak_from_this()](const LiftState::SharedPtr& state)
       {
         const auto me = weak.lock();
@@ -64,7 +64,7 @@ struct IngestItem
     std::vector<rmf_ingestor_msgs::msg::IngestorRequestItem> _items;
     std::string _description;
     rxcpp::observable<LegacyTask::StatusMsg> _obs;
-    rclcpp::TimerBase::SharedPtr _timer;
+    TimerWheel::TimerPtr _timer;
     bool _request_acknowledged = false;
     builtin_interfaces::msg::Time _last_msg;
 
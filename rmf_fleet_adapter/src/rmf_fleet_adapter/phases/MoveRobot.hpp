@@ -122,6 +122,7 @@ struct MoveRobot
     rmf_traffic::PlanId _plan_id;
     std::optional<rmf_traffic::Duration> _tail_period;
     std::optional<rmf_traffic::Time> _last_tail_bump;
+    std::optional<rmf_traffic::Time> _last_delay_report;
     std::size_t _next_path_index = 0;
     std::optional<std::size_t> _first_graph_index;
 
@@ -272,25 +273,47 @@ void MoveRobot::Action::operator()(const Subscriber& s)
 
             const auto context = self->_context;
             const auto plan_id = self->_plan_id;
-            context->itinerary().cumulative_delay(
-              plan_id, new_cumulative_delay, 100ms);
-
-            // This itinerary has been adjusted according to the latest delay
-            // information, so our position along the trajectory is given by `now`
-            const auto& itin = context->itinerary().itinerary();
-            for (std::size_t i = 0; i < itin.size(); ++i)
+            const auto& reporting = context->delay_reporting();
+            const bool report_now = !reporting.min_period.has_value()
+            || !self->_last_delay_report.has_value()
+            || *self->_last_delay_report + *reporting.min_period <= now;
+
+            // Robots that update their positions often would otherwise push
+            // a delay and progress to the schedule with nearly every update,
+            // so these get held back until the reporting period has passed.
+            if (report_now)
             {
-              const auto& traj = itin[i].trajectory();
-              const auto t_it = traj.find(now);
-              if (t_it != traj.end() && t_it != traj.begin())
+              const auto previous_delay =
+              context->itinerary().cumulative_delay(plan_id);
+              context->itinerary().cumulative_delay(
+                plan_id, new_cumulative_delay, reporting.threshold);
+
+              const auto delay_change = previous_delay.has_value() ?
+                new_cumulative_delay - *previous_delay : new_cumulative_delay;
+              if (reporting.threshold < delay_change
+              || delay_change < -reporting.threshold)
+              {
+                self->_last_delay_report = now;
+              }
+
+              // This itinerary has been adjusted according to the latest delay
+              // information, so our position along the trajectory is given by
+              // `now`
+              const auto& itin = context->itinerary().itinerary();
+              for (std::size_t i = 0; i < itin.size(); ++i)
               {
-                std::size_t index = t_it->index() - 1;
-                if (t_it->time() == now)
+                const auto& traj = itin[i].trajectory();
+                const auto t_it = traj.find(now);
+                if (t_it != traj.end() && t_it != traj.begin())
                 {
-                  index = t_it->index();
-                }
+                  std::size_t index = t_it->index() - 1;
+                  if (t_it->time() == now)
+                  {
+                    index = t_it->index();
+                  }
 
-                context->itinerary().reached(plan_id, i, index);
+                  context->itinerary().reached(plan_id, i, index);
+                }
               }
             }
 
@@ -175,7 +175,7 @@ void RequestLift::ActivePhase::_init_obs()
       _destination);
   }
 
-  _obs = _context->node()->lift_state()
+  _obs = _context->node()->lift_state(_lift_name)
     .observe_on(rxcpp::identity_same_worker(_context->worker()))
     .lift<LiftState::SharedPtr>(
     on_subscribe(
@@ -185,8 +185,9 @@ void RequestLift::ActivePhase::_init_obs()
         if (!me)
           return;
 
+        me->_prefetch_watchdog_decision();
         me->_do_publish();
-        me->_timer = me->_context->node()->try_create_wall_timer(
+        me->_timer = me->_context->node()->create_wheel_timer(
           std::chrono::milliseconds(1000),
           [weak]()
           {
@@ -279,7 +280,7 @@ void RequestLift::ActivePhase::_init_obs()
             if (me->_context->localize(*me->_data.localize_after,
             std::move(cmd)))
             {
-              me->_rewait_timer = me->_context->node()->try_create_wall_timer(
+              me->_rewait_timer = me->_context->node()->create_wheel_timer(
                 std::chrono::seconds(300),
                 [weak, s]
                 {
@@ -307,6 +308,19 @@ void RequestLift::ActivePhase::_init_obs()
         }));
 }
 
+//==============================================================================
+void RequestLift::ActivePhase::_prefetch_watchdog_decision()
+{
+  if (_data.located != Located::Outside)
+    return;
+
+  // The watchdog is asked while the robot waits for the lift so that the
+  // decision is ready when the doors open. This does nothing while a fresh
+  // decision is cached or a request is still pending.
+  if (const auto& watchdog = _context->get_lift_watchdog_cache())
+    watchdog->prefetch(_lift_name, _destination);
+}
+
 //==============================================================================
 LegacyTask::StatusMsg RequestLift::ActivePhase::_get_status(
   const rmf_lift_msgs::msg::LiftState::SharedPtr& lift_state)
@@ -327,7 +341,22 @@ LegacyTask::StatusMsg RequestLift::ActivePhase::_get_status(
       lift_state->current_floor.c_str(),
       lift_state->session_id.c_str());
     bool completed = false;
-    const auto& watchdog = _context->get_lift_watchdog();
+    const auto& watchdog = _context->get_lift_watchdog_cache();
+    if (!_watchdog_info && _data.located == Located::Outside && watchdog)
+    {
+      // The decision was most likely prefetched while the lift was on its way,
+      // in which case it gets handled right away below.
+      _watchdog_info = std::make_shared<WatchdogInfo>();
+      watchdog->request(
+        _lift_name,
+        _destination,
+        [info = _watchdog_info](
+          agv::RobotUpdateHandle::Unstable::Decision decision)
+        {
+          std::lock_guard<std::mutex> lock(info->mutex);
+          info->decision = decision;
+        });
+    }
 
     if (_watchdog_info)
     {
@@ -363,7 +392,7 @@ LegacyTask::StatusMsg RequestLift::ActivePhase::_get_status(
                   // Do nothing
                 });
 
-            _rewait_timer = _context->node()->try_create_wall_timer(
+            _rewait_timer = _context->node()->create_wheel_timer(
               _context->get_lift_rewait_duration(),
               [w = weak_from_this()]()
               {
@@ -382,18 +411,6 @@ LegacyTask::StatusMsg RequestLift::ActivePhase::_get_status(
         _watchdog_info.reset();
       }
     }
-    else if (_data.located == Located::Outside && watchdog)
-    {
-      _watchdog_info = std::make_shared<WatchdogInfo>();
-      watchdog(
-        _lift_name,
-        [info = _watchdog_info](
-          agv::RobotUpdateHandle::Unstable::Decision decision)
-        {
-          std::lock_guard<std::mutex> lock(info->mutex);
-          info->decision = decision;
-        });
-    }
     else
     {
       completed = true;
@@ -413,6 +430,7 @@ LegacyTask::StatusMsg RequestLift::ActivePhase::_get_status(
   }
   else if (lift_state->lift_name == _lift_name)
   {
+    _prefetch_watchdog_decision();
     // TODO(MXG): Make this a more human-friendly message
     status.status = "[" + _context->name() + "] still waiting for lift ["
       + _lift_name + "]  current state: "
@@ -79,7 +79,7 @@ struct RequestLift
       rxcpp::subjects::behavior<bool>(false);
     std::string _description;
     rxcpp::observable<LegacyTask::StatusMsg> _obs;
-    rclcpp::TimerBase::SharedPtr _timer;
+    TimerWheel::TimerPtr _timer;
     std::shared_ptr<EndLiftSession::Active> _lift_end_phase;
     rmf_rxcpp::subscription_guard _reset_session_subscription;
     std::shared_ptr<void> _destination_handle;
@@ -93,7 +93,7 @@ struct RequestLift
     };
 
     std::shared_ptr<WatchdogInfo> _watchdog_info;
-    rclcpp::TimerBase::SharedPtr _rewait_timer;
+    TimerWheel::TimerPtr _rewait_timer;
     bool _rewaiting = false;
 
     ActivePhase(
@@ -104,6 +104,8 @@ struct RequestLift
 
     void _init_obs();
 
+    void _prefetch_watchdog_decision();
+
     LegacyTask::StatusMsg _get_status(
       const rmf_lift_msgs::msg::LiftState::SharedPtr& lift_state);
 
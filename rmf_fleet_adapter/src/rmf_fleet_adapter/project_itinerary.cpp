@@ -17,6 +17,8 @@
 
 #include "project_itinerary.hpp"
 
+#include <optional>
+
 namespace rmf_fleet_adapter {
 
 //==============================================================================
@@ -26,33 +28,53 @@ rmf_traffic::schedule::Itinerary project_itinerary(
   const rmf_traffic::agv::Planner& with_planner)
 {
   auto itinerary = starting_from.get_itinerary();
-  auto last_plan = starting_from;
+  if (itinerary.empty())
+    return itinerary;
+
+  // The plans are only projections, so they share one set of options that
+  // skips validation. Only the most recent plan is kept, since all we need
+  // from it is where it ends.
+  auto options = with_planner.get_default_options();
+  options.validator(nullptr);
+  std::optional<rmf_traffic::agv::Plan> last_plan;
+  const auto* last_waypoints = &starting_from.get_waypoints();
   for (const auto& destination : through_destinations)
   {
-    if (last_plan.get_waypoints().empty())
+    if (last_waypoints->empty())
       break;
 
-    const auto& wp = last_plan.get_waypoints().back();
+    const auto& wp = last_waypoints->back();
     if (!wp.graph_index().has_value())
       break;
 
     rmf_traffic::agv::Plan::Start start(
       wp.time(), wp.graph_index().value(), wp.position()[2]);
 
-    auto options = with_planner.get_default_options();
-    options.validator(nullptr);
     auto result = with_planner.plan(start, destination, options);
     if (!result)
       break;
 
     last_plan = *std::move(result);
-    const auto& new_itinerary = last_plan.get_itinerary();
+    last_waypoints = &last_plan->get_waypoints();
+    const auto& new_itinerary = last_plan->get_itinerary();
+    if (new_itinerary.empty())
+      break;
+
     if (new_itinerary.front().map() == itinerary.back().map())
     {
       // We only look at the first route because we're not going to include
-      // any map switches for now.
+      // any map switches for now. The new plan starts where the projection so
+      // far finishes, so its waypoints can be appended without searching for
+      // their place.
+      auto& trajectory = itinerary.back().trajectory();
       for (const auto& wp : new_itinerary.front().trajectory())
-        itinerary.back().trajectory().insert(wp);
+      {
+        const auto* finish = trajectory.finish_time();
+        if (finish && wp.time() <= *finish)
+          continue;
+
+        trajectory.insert(wp);
+      }
     }
     else
     {
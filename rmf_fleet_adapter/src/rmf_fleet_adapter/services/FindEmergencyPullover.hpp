@@ -35,7 +35,8 @@ public:
     rmf_traffic::agv::Plan::StartSet starts,
     std::shared_ptr<const rmf_traffic::schedule::Snapshot> schedule,
     rmf_traffic::schedule::ParticipantId participant_id,
-    std::shared_ptr<const rmf_traffic::Profile> profile);
+    std::shared_ptr<const rmf_traffic::Profile> profile,
+    std::optional<std::vector<std::size_t>> candidates = std::nullopt);
 
   using Result = rmf_traffic::agv::Plan::Result;
 
@@ -54,6 +55,9 @@ private:
   rmf_traffic::schedule::ParticipantId _participant_id;
   std::shared_ptr<const rmf_traffic::Profile> _profile;
 
+  // The parking spots to search, or every parking spot if this is nullopt
+  std::optional<std::vector<std::size_t>> _candidates;
+
   std::vector<std::shared_ptr<jobs::SearchForPath>> _search_jobs;
   rmf_rxcpp::subscription_guard _search_sub;
 
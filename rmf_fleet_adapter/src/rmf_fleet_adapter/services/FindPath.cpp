@@ -28,8 +28,13 @@ FindPath::FindPath(
   std::shared_ptr<const rmf_traffic::schedule::Snapshot> schedule,
   rmf_traffic::schedule::ParticipantId participant_id,
   const std::shared_ptr<const rmf_traffic::Profile>& profile,
-  std::optional<rmf_traffic::Duration> planning_time_limit)
+  std::optional<rmf_traffic::Duration> planning_time_limit,
+  std::optional<rmf_traffic::Duration> anytime_deadline)
+: _worker(rxcpp::schedulers::make_event_loop().create_worker())
 {
+  if (anytime_deadline.has_value())
+    _anytime_deadline = std::chrono::steady_clock::now() + *anytime_deadline;
+
   _search_job = std::make_shared<jobs::SearchForPath>(
     std::move(planner),
     std::move(starts),
@@ -40,9 +45,46 @@ FindPath::FindPath(
     planning_time_limit);
 }
 
+//==============================================================================
+FindPath::FindPath(
+  std::shared_ptr<const rmf_traffic::agv::Planner> planner,
+  rmf_traffic::agv::Plan::StartSet starts,
+  std::vector<rmf_traffic::agv::Plan::Goal> goals,
+  std::shared_ptr<const rmf_traffic::schedule::Snapshot> schedule,
+  rmf_traffic::schedule::ParticipantId participant_id,
+  const std::shared_ptr<const rmf_traffic::Profile>& profile,
+  std::optional<rmf_traffic::Duration> planning_time_limit)
+: _worker(rxcpp::schedulers::make_event_loop().create_worker())
+{
+  // The search jobs are made when the service starts so that setting up every
+  // alternative does not hold up the caller
+  _alternatives = Alternatives{
+    std::move(planner),
+    std::move(starts),
+    std::move(goals),
+    std::move(schedule),
+    participant_id,
+    profile,
+    planning_time_limit,
+    {},
+    ProgressEvaluator(),
+    ProgressEvaluator(),
+    false
+  };
+}
+
 //==============================================================================
 void FindPath::interrupt()
 {
+  if (_alternatives.has_value())
+  {
+    _alternatives->interrupted = true;
+    for (const auto& job : _alternatives->search_jobs)
+      job->interrupt();
+
+    return;
+  }
+
   _search_job->interrupt();
 }
 
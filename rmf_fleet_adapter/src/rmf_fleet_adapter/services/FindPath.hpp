@@ -19,6 +19,7 @@
 #define SRC__RMF_FLEET_ADAPTER__SERVICES__FINDPATH_HPP
 
 #include "../jobs/SearchForPath.hpp"
+#include "ProgressEvaluator.hpp"
 
 namespace rmf_fleet_adapter {
 namespace services {
@@ -26,6 +27,14 @@ namespace services {
 //==============================================================================
 /// Find a path that gets from the start to the goal. It might or might not
 /// comply with the given schedule, depending on what is feasible.
+///
+/// If an anytime deadline is given, then once the deadline passes the best
+/// feasible plan found so far (the plan that ignores the schedule) will be
+/// published without waiting for the schedule-compliant search to finish. The
+/// search keeps going in the background, and if it finds a compliant plan
+/// before the planning time limit, that plan will be published as a second
+/// result. Subscribers that use the anytime deadline should be ready to
+/// receive up to two results.
 class FindPath : public std::enable_shared_from_this<FindPath>
 {
 public:
@@ -37,6 +46,22 @@ public:
     std::shared_ptr<const rmf_traffic::schedule::Snapshot> schedule,
     rmf_traffic::schedule::ParticipantId participant_id,
     const std::shared_ptr<const rmf_traffic::Profile>& profile,
+    std::optional<rmf_traffic::Duration> planning_time_limit,
+    std::optional<rmf_traffic::Duration> anytime_deadline = std::nullopt);
+
+  /// Find a path to whichever of the alternative goals is best to reach. The
+  /// searches for every goal run at the same time, and the best cost found so
+  /// far is used to stop the searches that cannot beat it. Use get_goal() on
+  /// the result to find out which goal was chosen.
+  ///
+  /// Searching for alternatives does not support an anytime deadline.
+  FindPath(
+    std::shared_ptr<const rmf_traffic::agv::Planner> planner,
+    rmf_traffic::agv::Plan::StartSet starts,
+    std::vector<rmf_traffic::agv::Plan::Goal> goals,
+    std::shared_ptr<const rmf_traffic::schedule::Snapshot> schedule,
+    rmf_traffic::schedule::ParticipantId participant_id,
+    const std::shared_ptr<const rmf_traffic::Profile>& profile,
     std::optional<rmf_traffic::Duration> planning_time_limit);
 
   using Result = rmf_traffic::agv::Plan::Result;
@@ -46,9 +71,49 @@ public:
 
   void interrupt();
 
+  /// When searching for alternatives, a compliant search is dropped once its
+  /// cost estimate is this many times the cost of the best greedy plan.
+  static constexpr double compliance_leeway = 3.0;
+
 private:
+
+  template<typename Subscriber>
+  void _search_anytime(const Subscriber& s);
+
+  template<typename Subscriber>
+  void _publish_preliminary(const Subscriber& s);
+
+  template<typename Subscriber>
+  void _search_alternatives(const Subscriber& s);
+
   std::shared_ptr<jobs::SearchForPath> _search_job;
   rmf_rxcpp::subscription_guard _search_sub;
+
+  // These are only used by the anytime mode, and only on _worker
+  std::optional<rmf_traffic::Time> _anytime_deadline;
+  rxcpp::schedulers::worker _worker;
+  std::optional<Result> _preliminary;
+  bool _deadline_passed = false;
+  bool _published_preliminary = false;
+  bool _finished = false;
+
+  // These are only used when searching for alternative goals
+  struct Alternatives
+  {
+    std::shared_ptr<const rmf_traffic::agv::Planner> planner;
+    rmf_traffic::agv::Plan::StartSet starts;
+    std::vector<rmf_traffic::agv::Plan::Goal> goals;
+    std::shared_ptr<const rmf_traffic::schedule::Snapshot> schedule;
+    rmf_traffic::schedule::ParticipantId participant_id;
+    std::shared_ptr<const rmf_traffic::Profile> profile;
+    std::optional<rmf_traffic::Duration> planning_time_limit;
+
+    std::vector<std::shared_ptr<jobs::SearchForPath>> search_jobs;
+    ProgressEvaluator greedy_evaluator;
+    ProgressEvaluator compliant_evaluator;
+    bool interrupted = false;
+  };
+  std::optional<Alternatives> _alternatives;
 };
 
 } // namespace services
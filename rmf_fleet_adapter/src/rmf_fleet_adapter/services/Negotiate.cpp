@@ -17,6 +17,9 @@
 
 #include "Negotiate.hpp"
 
+#include <algorithm>
+#include <thread>
+
 namespace rmf_fleet_adapter {
 namespace services {
 
@@ -114,6 +117,23 @@ void Negotiate::interrupt()
   *_interrupted = true;
 }
 
+//==============================================================================
+void Negotiate::_report_evaluation() const
+{
+  if (!_evaluator.tuning)
+    return;
+
+  const auto* best = _evaluator.best_result.progress;
+  const bool success = best && best->success();
+
+  // A search that was cut short without a result says nothing about whether
+  // the leeway is right.
+  if (!success && *_interrupted)
+    return;
+
+  _evaluator.tuning->observe(_evaluator);
+}
+
 //==============================================================================
 void Negotiate::discard()
 {
@@ -146,6 +166,83 @@ Negotiate::~Negotiate()
   *_interrupted = true;
 }
 
+//==============================================================================
+std::size_t Negotiate::max_concurrent_jobs()
+{
+  static const std::size_t limit =
+    std::max<std::size_t>(5, std::thread::hardware_concurrency());
+  return limit;
+}
+
+//==============================================================================
+std::function<void()> Negotiate::_make_submission(
+  rmf_traffic::agv::Plan::Result r)
+{
+  return [r = std::move(r),
+      initial_itinerary = std::move(_initial_itinerary),
+      followed_by = _followed_by,
+      planner = _planner,
+      approval = std::move(_approval),
+      responder = _responder,
+      viewer = _viewer,
+      plan_id = _plan_id]()
+  {
+    std::vector<rmf_traffic::Route> final_itinerary;
+    final_itinerary.reserve(
+      initial_itinerary.size() + r->get_itinerary().size());
+
+    for (const auto& it : {initial_itinerary, r->get_itinerary()})
+    {
+      for (const auto& route : it)
+      {
+        if (route.trajectory().size() > 1)
+          final_itinerary.push_back(route);
+      }
+    }
+
+    final_itinerary = project_itinerary(*r, followed_by, *planner);
+    for (const auto& parent : viewer->base_proposals())
+    {
+      // Make sure all parent dependencies are accounted for
+      // TODO(MXG): This is kind of a gross hack that we add to
+      // force the lookahead to work for patrols. This approach
+      // should be reworked in a future redesign of the traffic
+      // system.
+      for (auto& r : final_itinerary)
+      {
+        for (std::size_t i = 0; i < parent.itinerary.size(); ++i)
+        {
+          r.add_dependency(
+            r.trajectory().size(),
+            rmf_traffic::Dependency{
+              parent.participant,
+              parent.plan,
+              i,
+              parent.itinerary[i].trajectory().size()
+            });
+        }
+      }
+    }
+
+    responder->submit(
+      plan_id,
+      final_itinerary,
+      [
+        plan_id,
+        plan = *r,
+        approval = std::move(approval),
+        final_itinerary
+      ]()
+      -> UpdateVersion
+      {
+        if (approval)
+          return approval(plan_id, plan, final_itinerary);
+
+        return rmf_utils::nullopt;
+      });
+  };
+}
+
 //==============================================================================
 void Negotiate::_resume_next()
 {
@@ -22,6 +22,8 @@
 #include "../jobs/Planning.hpp"
 #include "../jobs/Rollout.hpp"
 #include "ProgressEvaluator.hpp"
+#include "ProgressEvaluatorTuning.hpp"
+#include "ProposalCache.hpp"
 
 namespace rmf_fleet_adapter {
 namespace services {
@@ -96,6 +98,12 @@ private:
 
   void _resume_next();
 
+  // Make the callback that submits a successful plan to the negotiation
+  std::function<void()> _make_submission(rmf_traffic::agv::Plan::Result r);
+
+  // Tell the tuning of the evaluator, if there is one, how this search went
+  void _report_evaluation() const;
+
   rmf_traffic::PlanId _plan_id;
   std::shared_ptr<const rmf_traffic::agv::Planner> _planner;
   rmf_traffic::agv::Plan::StartSet _starts;
@@ -139,7 +147,14 @@ private:
     std::make_shared<std::atomic_bool>(false);
   bool _discarded = false;
 
-  static constexpr std::size_t max_concurrent_jobs = 5;
+  // Identifies this subproblem in the ProposalCache, if it can be cached
+  std::optional<std::size_t> _cache_key;
+  std::optional<rmf_traffic::Time> _start_time;
+
+  // The planning jobs are resumed on rxcpp's event loop, which has one thread
+  // per hardware thread, so allow at least that many jobs to be searching at
+  // once. There is no benefit to resuming more jobs than there are threads.
+  static std::size_t max_concurrent_jobs();
 
   ProgressEvaluator _evaluator;
 };
@@ -20,9 +20,13 @@
 
 #include <rmf_traffic/agv/Planner.hpp>
 
+#include <memory>
+
 namespace rmf_fleet_adapter {
 namespace services {
 
+class ProgressEvaluatorTuning;
+
 //==============================================================================
 struct ProgressEvaluator
 {
@@ -66,6 +70,10 @@ struct ProgressEvaluator
   double estimate_leeway;
 
   double max_cost_threshold;
+
+  /// If this is set, the search that uses this evaluator should report back to
+  /// it once the search is finished.
+  std::shared_ptr<ProgressEvaluatorTuning> tuning;
 };
 
 
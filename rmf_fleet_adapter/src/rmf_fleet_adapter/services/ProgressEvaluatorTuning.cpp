@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ProgressEvaluatorTuning.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace rmf_fleet_adapter {
+namespace services {
+
+//==============================================================================
+std::shared_ptr<ProgressEvaluatorTuning> ProgressEvaluatorTuning::make(
+  Parameters parameters)
+{
+  return std::shared_ptr<ProgressEvaluatorTuning>(
+    new ProgressEvaluatorTuning(std::move(parameters)));
+}
+
+//==============================================================================
+ProgressEvaluator ProgressEvaluatorTuning::make_evaluator()
+{
+  const auto p = current();
+  ProgressEvaluator evaluator(
+    p.compliant_leeway_base,
+    p.compliant_leeway_multiplier,
+    p.estimate_leeway,
+    p.max_cost_threshold);
+
+  if (p.adaptive)
+    evaluator.tuning = shared_from_this();
+
+  return evaluator;
+}
+
+//==============================================================================
+void ProgressEvaluatorTuning::observe(const ProgressEvaluator& evaluator)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_configured.adaptive)
+    return;
+
+  const auto* best = evaluator.best_result.progress;
+  const bool success = best && best->success();
+  _outcomes.push_back(success);
+  if (_outcomes.size() > SampleWindow)
+    _outcomes.pop_front();
+
+  if (success && best->ideal_cost().has_value())
+  {
+    _excess_costs.push_back(
+      std::max(0.0, evaluator.best_result.cost - *best->ideal_cost()));
+
+    if (_excess_costs.size() > SampleWindow)
+      _excess_costs.pop_front();
+  }
+
+  _retune();
+}
+
+//==============================================================================
+auto ProgressEvaluatorTuning::current() const -> Parameters
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _current;
+}
+
+//==============================================================================
+ProgressEvaluatorTuning::ProgressEvaluatorTuning(Parameters parameters)
+: _configured(parameters),
+  _current(std::move(parameters))
+{
+  // Do nothing
+}
+
+//==============================================================================
+void ProgressEvaluatorTuning::_retune()
+{
+  if (_excess_costs.size() < MinimumSamples)
+    return;
+
+  std::vector<double> sorted(_excess_costs.begin(), _excess_costs.end());
+  const auto p90 = sorted.begin() + (sorted.size() * 9) / 10;
+  std::nth_element(sorted.begin(), p90, sorted.end());
+
+  // Give the searches twice as much room as the accepted plans have usually
+  // needed.
+  double margin = 2.0 * *p90;
+
+  // If most searches are failing, the leeway is more likely to be too tight
+  // than too loose, so never go below what was configured.
+  const auto failures = std::count(_outcomes.begin(), _outcomes.end(), false);
+  if (2 * static_cast<std::size_t>(failures) > _outcomes.size())
+    margin = std::max(margin, _configured.compliant_leeway_base);
+
+  const double base = std::clamp(
+    margin,
+    _configured.compliant_leeway_base / 4.0,
+    _configured.compliant_leeway_base * 4.0);
+
+  // The cost threshold keeps the same proportion to the base leeway that was
+  // configured.
+  const double ratio = _configured.compliant_leeway_base > 0.0 ?
+    _configured.max_cost_threshold / _configured.compliant_leeway_base : 1.0;
+
+  _current.compliant_leeway_base = base;
+  _current.max_cost_threshold = std::clamp(
+    base * ratio,
+    _configured.max_cost_threshold / 4.0,
+    _configured.max_cost_threshold * 4.0);
+}
+
+} // namespace services
+} // namespace rmf_fleet_adapter
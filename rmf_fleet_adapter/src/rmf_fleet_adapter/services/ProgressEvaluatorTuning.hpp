@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__SERVICES__PROGRESSEVALUATORTUNING_HPP
+#define SRC__RMF_FLEET_ADAPTER__SERVICES__PROGRESSEVALUATORTUNING_HPP
+
+#include "ProgressEvaluator.hpp"
+
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace rmf_fleet_adapter {
+namespace services {
+
+//==============================================================================
+/// Fleet-wide settings for the ProgressEvaluator of negotiations. When the
+/// tuning is adaptive, it learns how far above the ideal cost the accepted
+/// plans of this fleet tend to be, and scales the additive leeways to match.
+/// That keeps the evaluator from discarding good plans on very large graphs
+/// and from chasing hopeless plans on small ones.
+class ProgressEvaluatorTuning
+  : public std::enable_shared_from_this<ProgressEvaluatorTuning>
+{
+public:
+
+  struct Parameters
+  {
+    double compliant_leeway_base =
+      ProgressEvaluator::DefaultCompliantLeewayBase;
+
+    double compliant_leeway_multiplier =
+      ProgressEvaluator::DefaultCompliantLeewayMultiplier;
+
+    double estimate_leeway = ProgressEvaluator::DefaultEstimateLeeway;
+
+    double max_cost_threshold = ProgressEvaluator::DefaultMaxCostThreshold;
+
+    /// If true, compliant_leeway_base and max_cost_threshold will be tuned
+    /// online, starting from the values given here. They will stay within a
+    /// factor of four of these values.
+    bool adaptive = false;
+  };
+
+  /// The number of searches that need to be observed before the adaptive
+  /// tuning changes anything
+  static constexpr std::size_t MinimumSamples = 10;
+
+  /// The number of most recent searches that the adaptive tuning is based on
+  static constexpr std::size_t SampleWindow = 200;
+
+  static std::shared_ptr<ProgressEvaluatorTuning> make(Parameters parameters);
+
+  /// Make an evaluator that uses the current tuning and reports back to it.
+  ProgressEvaluator make_evaluator();
+
+  /// Learn from an evaluator whose search has finished.
+  void observe(const ProgressEvaluator& evaluator);
+
+  /// Get the parameters that new evaluators will currently be given.
+  Parameters current() const;
+
+private:
+
+  ProgressEvaluatorTuning(Parameters parameters);
+
+  void _retune();
+
+  Parameters _configured;
+  Parameters _current;
+  std::deque<double> _excess_costs;
+  std::deque<bool> _outcomes;
+  mutable std::mutex _mutex;
+};
+
+using ProgressEvaluatorTuningPtr = std::shared_ptr<ProgressEvaluatorTuning>;
+
+} // namespace services
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__SERVICES__PROGRESSEVALUATORTUNING_HPP
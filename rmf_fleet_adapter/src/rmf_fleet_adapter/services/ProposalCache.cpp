@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ProposalCache.hpp"
+
+#include <cmath>
+#include <functional>
+
+namespace rmf_fleet_adapter {
+namespace services {
+
+namespace {
+//==============================================================================
+template<typename T>
+void hash_combine(std::size_t& seed, const T& value)
+{
+  seed ^= std::hash<T>{}(value) + 0x9e3779b97f4a7c15ull
+    + (seed << 6) + (seed >> 2);
+}
+
+//==============================================================================
+// Positions are compared to the nearest centimeter or milliradian so that
+// floating point noise does not prevent plans from being reused.
+void hash_coordinate(std::size_t& seed, double value)
+{
+  hash_combine(seed, static_cast<int64_t>(std::llround(value * 100.0)));
+}
+
+//==============================================================================
+// Times are compared relative to the start of the subproblem, to the nearest
+// tenth of a second, so that the same situation can be recognized even if it
+// comes up a little later.
+void hash_time(
+  std::size_t& seed,
+  rmf_traffic::Time time,
+  rmf_traffic::Time reference)
+{
+  const auto relative = std::chrono::duration_cast<std::chrono::milliseconds>(
+    time - reference).count();
+  hash_combine(seed, static_cast<int64_t>(std::llround(relative / 100.0)));
+}
+} // anonymous namespace
+
+//==============================================================================
+ProposalCache& ProposalCache::get()
+{
+  static ProposalCache cache;
+  return cache;
+}
+
+//==============================================================================
+ProposalCache& ProposalCache::lifetime(rmf_traffic::Duration value)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _lifetime = value;
+  if (_lifetime <= rmf_traffic::Duration(0))
+    _entries.clear();
+
+  return *this;
+}
+
+//==============================================================================
+rmf_traffic::Duration ProposalCache::lifetime() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _lifetime;
+}
+
+//==============================================================================
+ProposalCache& ProposalCache::time_tolerance(rmf_traffic::Duration value)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _time_tolerance = value;
+  return *this;
+}
+
+//==============================================================================
+rmf_traffic::Duration ProposalCache::time_tolerance() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _time_tolerance;
+}
+
+//==============================================================================
+std::optional<rmf_traffic::Time> ProposalCache::start_time(
+  const rmf_traffic::agv::Plan::StartSet& starts)
+{
+  std::optional<rmf_traffic::Time> earliest;
+  for (const auto& start : starts)
+  {
+    if (!earliest.has_value() || start.time() < *earliest)
+      earliest = start.time();
+  }
+
+  return earliest;
+}
+
+//==============================================================================
+std::optional<std::size_t> ProposalCache::make_key(
+  const TableViewer& viewer,
+  const rmf_traffic::agv::Plan::StartSet& starts,
+  const std::vector<rmf_traffic::agv::Plan::Goal>& goals)
+{
+  const auto reference = start_time(starts);
+  if (!reference.has_value())
+    return std::nullopt;
+
+  std::size_t seed = 0;
+
+  // The versions of the tables in the sequence change whenever a table gets
+  // rejected, so a table that has received alternatives never matches a
+  // fresh one.
+  for (const auto& key : viewer.sequence())
+  {
+    hash_combine(seed, key.participant);
+    hash_combine(seed, key.version);
+  }
+
+  for (const auto& proposal : viewer.base_proposals())
+  {
+    hash_combine(seed, proposal.participant);
+    for (const auto& route : proposal.itinerary)
+    {
+      hash_combine(seed, route.map());
+      for (const auto& wp : route.trajectory())
+      {
+        hash_time(seed, wp.time(), *reference);
+        const Eigen::Vector3d p = wp.position();
+        hash_coordinate(seed, p[0]);
+        hash_coordinate(seed, p[1]);
+        hash_coordinate(seed, p[2]);
+      }
+    }
+  }
+
+  for (const auto& start : starts)
+  {
+    hash_combine(seed, start.waypoint());
+    hash_coordinate(seed, start.orientation());
+    hash_time(seed, start.time(), *reference);
+    if (const auto& location = start.location())
+    {
+      hash_coordinate(seed, (*location)[0]);
+      hash_coordinate(seed, (*location)[1]);
+    }
+  }
+
+  for (const auto& goal : goals)
+  {
+    hash_combine(seed, goal.waypoint());
+    if (const auto* orientation = goal.orientation())
+      hash_coordinate(seed, *orientation);
+  }
+
+  return seed;
+}
+
+//==============================================================================
+auto ProposalCache::find(
+  const std::size_t key,
+  const rmf_traffic::Time start_time) -> std::optional<Result>
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_lifetime <= rmf_traffic::Duration(0))
+    return std::nullopt;
+
+  _cull(std::chrono::steady_clock::now());
+
+  const auto it = _entries.find(key);
+  if (it == _entries.end())
+    return std::nullopt;
+
+  const auto difference = start_time - it->second.start_time;
+  if (std::chrono::abs(difference) > _time_tolerance)
+    return std::nullopt;
+
+  return it->second.result;
+}
+
+//==============================================================================
+void ProposalCache::insert(
+  const std::size_t key,
+  const rmf_traffic::Time start_time,
+  const Result& result)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_lifetime <= rmf_traffic::Duration(0))
+    return;
+
+  const auto now = std::chrono::steady_clock::now();
+  _cull(now);
+
+  if (_entries.size() >= max_entries)
+  {
+    // Make room by evicting the oldest entry
+    auto oldest = _entries.begin();
+    for (auto it = _entries.begin(); it != _entries.end(); ++it)
+    {
+      if (it->second.inserted < oldest->second.inserted)
+        oldest = it;
+    }
+    _entries.erase(oldest);
+  }
+
+  _entries.erase(key);
+  _entries.emplace(key, Entry{result, start_time, now});
+}
+
+//==============================================================================
+void ProposalCache::_cull(const std::chrono::steady_clock::time_point now)
+{
+  for (auto it = _entries.begin(); it != _entries.end(); )
+  {
+    if (now - it->second.inserted > _lifetime)
+      it = _entries.erase(it);
+    else
+      ++it;
+  }
+}
+
+} // namespace services
+} // namespace rmf_fleet_adapter
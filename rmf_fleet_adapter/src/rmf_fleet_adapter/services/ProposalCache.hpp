@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__SERVICES__PROPOSALCACHE_HPP
+#define SRC__RMF_FLEET_ADAPTER__SERVICES__PROPOSALCACHE_HPP
+
+#include <rmf_traffic/agv/Planner.hpp>
+#include <rmf_traffic/schedule/Negotiation.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace rmf_fleet_adapter {
+namespace services {
+
+//==============================================================================
+/// A process-wide cache of the plans that negotiators have proposed. When the
+/// same conflict comes up again, e.g. because a negotiation was refused and
+/// reopened or because two robots keep meeting at the same choke point, the
+/// negotiator can reuse the plan that it found last time instead of planning
+/// from scratch.
+///
+/// A cached plan is only reused for a table whose sequence, whose proposals
+/// and whose start and goal conditions are identical, and whose start time is
+/// within the time tolerance of the cached plan. The cache is disabled until
+/// it is given a lifetime greater than zero.
+class ProposalCache
+{
+public:
+
+  using Result = rmf_traffic::agv::Plan::Result;
+  using TableViewer = rmf_traffic::schedule::Negotiation::Table::Viewer;
+
+  /// Get the cache for this process.
+  static ProposalCache& get();
+
+  /// Set how long entries stay valid. Zero disables the cache.
+  ProposalCache& lifetime(rmf_traffic::Duration value);
+
+  /// Get how long entries stay valid.
+  rmf_traffic::Duration lifetime() const;
+
+  /// Set how far apart the start times of two otherwise identical subproblems
+  /// can be for a plan to be reused.
+  ProposalCache& time_tolerance(rmf_traffic::Duration value);
+
+  /// Get the start time tolerance.
+  rmf_traffic::Duration time_tolerance() const;
+
+  /// Make a key that identifies the subproblem that a negotiator is solving.
+  /// Returns std::nullopt if the subproblem cannot be cached.
+  static std::optional<std::size_t> make_key(
+    const TableViewer& viewer,
+    const rmf_traffic::agv::Plan::StartSet& starts,
+    const std::vector<rmf_traffic::agv::Plan::Goal>& goals);
+
+  /// Find a plan that was stored for this key, if it has not expired.
+  std::optional<Result> find(
+    std::size_t key,
+    rmf_traffic::Time start_time);
+
+  /// Store a successful plan for this key.
+  void insert(
+    std::size_t key,
+    rmf_traffic::Time start_time,
+    const Result& result);
+
+  /// Get the earliest start time of a set of starts.
+  static std::optional<rmf_traffic::Time> start_time(
+    const rmf_traffic::agv::Plan::StartSet& starts);
+
+private:
+
+  struct Entry
+  {
+    Result result;
+    rmf_traffic::Time start_time;
+    std::chrono::steady_clock::time_point inserted;
+  };
+
+  void _cull(std::chrono::steady_clock::time_point now);
+
+  mutable std::mutex _mutex;
+  rmf_traffic::Duration _lifetime = rmf_traffic::Duration(0);
+  rmf_traffic::Duration _time_tolerance = std::chrono::seconds(1);
+  std::unordered_map<std::size_t, Entry> _entries;
+
+  static constexpr std::size_t max_entries = 256;
+};
+
+} // namespace services
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__SERVICES__PROPOSALCACHE_HPP
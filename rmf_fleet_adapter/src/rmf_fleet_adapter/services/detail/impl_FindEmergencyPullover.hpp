@@ -28,29 +28,38 @@ template<typename Subscriber>
 void FindEmergencyPullover::operator()(const Subscriber& s)
 {
   const auto& graph = _planner->get_configuration().graph();
-  const std::size_t N = graph.num_waypoints();
-  _search_jobs.reserve(N);
-  for (std::size_t i = 0; i < N; ++i)
+  std::vector<std::size_t> parking_spots;
+  if (_candidates.has_value())
   {
-    const auto& wp = graph.get_waypoint(i);
-    if (wp.is_parking_spot())
+    parking_spots = *_candidates;
+  }
+  else
+  {
+    for (std::size_t i = 0; i < graph.num_waypoints(); ++i)
     {
-      // TODO(MXG): Make the timeout configurable
-      auto search = std::make_shared<jobs::SearchForPath>(
-        _planner, _starts, wp.index(), _schedule, _participant_id, _profile,
-        std::chrono::seconds(5));
+      if (graph.get_waypoint(i).is_parking_spot())
+        parking_spots.push_back(i);
+    }
+  }
 
-      // Be sure to initialize these individually and not in a single statement,
-      // otherwise the logic might short-circuit one of the initialize() calls
-      const bool keep_greedy =
-        _greedy_evaluator.initialize(search->greedy().progress());
+  _search_jobs.reserve(parking_spots.size());
+  for (const std::size_t i : parking_spots)
+  {
+    // TODO(MXG): Make the timeout configurable
+    auto search = std::make_shared<jobs::SearchForPath>(
+      _planner, _starts, i, _schedule, _participant_id, _profile,
+      std::chrono::seconds(5));
 
-      const bool keep_compliant =
-        _compliant_evaluator.initialize(search->compliant().progress());
+    // Be sure to initialize these individually and not in a single statement,
+    // otherwise the logic might short-circuit one of the initialize() calls
+    const bool keep_greedy =
+      _greedy_evaluator.initialize(search->greedy().progress());
 
-      if (keep_greedy || keep_compliant)
-        _search_jobs.emplace_back(std::move(search));
-    }
+    const bool keep_compliant =
+      _compliant_evaluator.initialize(search->compliant().progress());
+
+    if (keep_greedy || keep_compliant)
+      _search_jobs.emplace_back(std::move(search));
   }
 
   const std::size_t N_jobs = _search_jobs.size();
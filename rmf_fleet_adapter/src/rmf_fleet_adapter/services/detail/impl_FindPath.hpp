@@ -27,6 +27,18 @@ namespace services {
 template<typename Subscriber>
 void FindPath::operator()(const Subscriber& s)
 {
+  if (_alternatives.has_value())
+  {
+    _search_alternatives(s);
+    return;
+  }
+
+  if (_anytime_deadline.has_value())
+  {
+    _search_anytime(s);
+    return;
+  }
+
   _search_sub = rmf_rxcpp::make_job<jobs::SearchForPath::Result>(_search_job)
     .observe_on(rxcpp::observe_on_event_loop())
     .subscribe(
@@ -66,6 +78,226 @@ void FindPath::operator()(const Subscriber& s)
     });
 }
 
+//==============================================================================
+template<typename Subscriber>
+void FindPath::_search_anytime(const Subscriber& s)
+{
+  _search_job->report_greedy_early();
+
+  _worker.schedule(
+    *_anytime_deadline,
+    [w = weak_from_this(), s](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      self->_deadline_passed = true;
+      self->_publish_preliminary(s);
+    });
+
+  _search_sub = rmf_rxcpp::make_job<jobs::SearchForPath::Result>(_search_job)
+    .observe_on(rxcpp::identity_same_worker(_worker))
+    .subscribe(
+    [w = weak_from_this(), s](const jobs::SearchForPath::Result& result)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      // The search reports the greedy plan by itself while the compliant job
+      // is still running. Every other result is final.
+      const bool preliminary =
+      result.type == jobs::SearchForPath::Type::greedy
+      && !result.compliant_job
+      && result.greedy_job
+      && result.greedy_job->progress().success();
+
+      if (preliminary)
+      {
+        self->_preliminary = result.greedy_job->progress();
+        self->_publish_preliminary(s);
+        return;
+      }
+
+      self->_finished = true;
+      if (result.compliant_job && result.compliant_job->progress().success())
+      {
+        s.on_next(result.compliant_job->progress());
+        s.on_completed();
+      }
+      else if (self->_published_preliminary)
+      {
+        // The compliant job could not improve on the greedy plan that was
+        // already published, so there is nothing new to report.
+        s.on_completed();
+      }
+      else if (result.greedy_job)
+      {
+        s.on_next(result.greedy_job->progress());
+        s.on_completed();
+      }
+      else
+      {
+        s.on_error(std::make_exception_ptr(
+          std::runtime_error(
+            "[FindPath] Unexpected result from SearchForPath")));
+      }
+    },
+    [s](std::exception_ptr e)
+    {
+      s.on_error(e);
+    },
+    [s]()
+    {
+      s.on_completed();
+    });
+}
+
+//==============================================================================
+template<typename Subscriber>
+void FindPath::_publish_preliminary(const Subscriber& s)
+{
+  // Wait until the deadline has passed and there is a feasible plan. If the
+  // search finished in time, its final result has already been published.
+  if (_finished || _published_preliminary || !_deadline_passed)
+    return;
+
+  if (!_preliminary.has_value())
+    return;
+
+  _published_preliminary = true;
+  s.on_next(*_preliminary);
+}
+
+//==============================================================================
+template<typename Subscriber>
+void FindPath::_search_alternatives(const Subscriber& s)
+{
+  auto& alt = *_alternatives;
+  std::shared_ptr<jobs::SearchForPath> fallback;
+  alt.search_jobs.reserve(alt.goals.size());
+  for (const auto& goal : alt.goals)
+  {
+    auto search = std::make_shared<jobs::SearchForPath>(
+      alt.planner, alt.starts, goal, alt.schedule, alt.participant_id,
+      alt.profile, alt.planning_time_limit);
+
+    if (!fallback)
+      fallback = search;
+
+    // Be sure to initialize these individually and not in a single statement,
+    // otherwise the logic might short-circuit one of the initialize() calls
+    const bool keep_greedy =
+      alt.greedy_evaluator.initialize(search->greedy().progress());
+
+    const bool keep_compliant =
+      alt.compliant_evaluator.initialize(search->compliant().progress());
+
+    if (keep_greedy || keep_compliant)
+      alt.search_jobs.emplace_back(std::move(search));
+  }
+
+  if (alt.search_jobs.empty())
+  {
+    // None of the goals can be reached, so report the failure of the first one
+    if (fallback)
+      s.on_next(fallback->greedy().progress());
+
+    s.on_completed();
+    return;
+  }
+
+  // Every search shares one cost limit that is based on the most promising
+  // goal, so searches towards goals that are much farther away end early.
+  const double initial_max_cost =
+    ProgressEvaluator::DefaultEstimateLeeway
+    * alt.greedy_evaluator.best_estimate.cost;
+
+  for (const auto& job : alt.search_jobs)
+  {
+    job->set_cost_limit(initial_max_cost);
+    if (alt.interrupted)
+      job->interrupt();
+  }
+
+  const std::size_t N_jobs = alt.search_jobs.size();
+  _search_sub = rmf_rxcpp::make_job_from_action_list(alt.search_jobs)
+    .subscribe(
+    [w = weak_from_this(), s, N_jobs](
+      const jobs::SearchForPath::Result& progress)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      auto& alt = *self->_alternatives;
+      const auto& greedy = progress.greedy_job;
+      const auto& compliant = progress.compliant_job;
+
+      bool resume_compliant = static_cast<bool>(compliant);
+      if (compliant && alt.greedy_evaluator.best_result.progress)
+      {
+        auto& compliant_progress = compliant->progress();
+        if (!compliant_progress.success())
+        {
+          if (!compliant_progress.cost_estimate())
+          {
+            resume_compliant = false;
+            alt.compliant_evaluator.discard(compliant_progress);
+          }
+          else
+          {
+            const double best_greedy_cost =
+            (*alt.greedy_evaluator.best_result.progress)->get_cost();
+            const double compliant_cost = *compliant_progress.cost_estimate();
+
+            if (best_greedy_cost * compliance_leeway < compliant_cost)
+            {
+              resume_compliant = false;
+              alt.compliant_evaluator.discard(compliant_progress);
+            }
+          }
+        }
+      }
+
+      bool resume_greedy = false;
+      if (jobs::SearchForPath::Type::greedy == progress.type)
+      {
+        if (alt.greedy_evaluator.evaluate(greedy->progress()))
+          resume_greedy = true;
+      }
+
+      if (jobs::SearchForPath::Type::compliant == progress.type
+      && resume_compliant)
+      {
+        if (alt.compliant_evaluator.evaluate(compliant->progress()))
+          resume_compliant = true;
+      }
+
+      if ( (alt.compliant_evaluator.finished_count >= N_jobs
+      && alt.greedy_evaluator.finished_count >= N_jobs)
+      || alt.interrupted)
+      {
+        if (alt.compliant_evaluator.best_result.progress)
+          s.on_next(*alt.compliant_evaluator.best_result.progress);
+        else if (alt.greedy_evaluator.best_result.progress)
+          s.on_next(*alt.greedy_evaluator.best_result.progress);
+        else
+          s.on_next(alt.search_jobs.front()->greedy().progress());
+
+        s.on_completed();
+        return;
+      }
+
+      if (resume_greedy)
+        greedy->resume();
+
+      if (resume_compliant)
+        compliant->resume();
+    });
+}
+
 }
 }
 
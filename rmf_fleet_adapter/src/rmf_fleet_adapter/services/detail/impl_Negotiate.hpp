@@ -35,6 +35,25 @@ void Negotiate::operator()(const Subscriber& s)
         negotiate->discard();
     });
 
+  auto& cache = ProposalCache::get();
+  if (cache.lifetime() > rmf_traffic::Duration(0))
+  {
+    _start_time = ProposalCache::start_time(_starts);
+    _cache_key = ProposalCache::make_key(*_viewer, _starts, _goals);
+    if (_cache_key.has_value() && _start_time.has_value())
+    {
+      if (auto cached = cache.find(*_cache_key, *_start_time))
+      {
+        // This exact subproblem was solved recently, so we can propose the
+        // same plan again without searching for it.
+        _finished = true;
+        s.on_next(Result{shared_from_this(), _make_submission(*cached)});
+        s.on_completed();
+        return;
+      }
+    }
+  }
+
   auto validators =
     rmf_traffic::agv::NegotiatingRouteValidator::Generator(_viewer).all();
 
@@ -84,74 +103,17 @@ void Negotiate::operator()(const Subscriber& s)
           && self->_evaluator.best_result.progress->success())
         {
           self->_finished = true;
+          self->_report_evaluation();
           // This means we found a successful plan to submit to the negotiation.
+          const auto& best = *self->_evaluator.best_result.progress;
+          if (self->_cache_key.has_value() && self->_start_time.has_value())
+          {
+            ProposalCache::get().insert(
+              *self->_cache_key, *self->_start_time, best);
+          }
+
           s.on_next(
-            Result{
-              self->shared_from_this(),
-              [r = *self->_evaluator.best_result.progress,
-              initial_itinerary = std::move(self->_initial_itinerary),
-              followed_by = self->_followed_by,
-              planner = self->_planner,
-              approval = std::move(self->_approval),
-              responder = self->_responder,
-              viewer = self->_viewer,
-              plan_id = self->_plan_id]()
-              {
-                std::vector<rmf_traffic::Route> final_itinerary;
-                final_itinerary.reserve(
-                  initial_itinerary.size() + r->get_itinerary().size());
-
-                for (const auto& it : {initial_itinerary, r->get_itinerary()})
-                {
-                  for (const auto& route : it)
-                  {
-                    if (route.trajectory().size() > 1)
-                      final_itinerary.push_back(route);
-                  }
-                }
-
-                final_itinerary = project_itinerary(*r, followed_by, *planner);
-                for (const auto& parent : viewer->base_proposals())
-                {
-                  // Make sure all parent dependencies are accounted for
-                  // TODO(MXG): This is kind of a gross hack that we add to
-                  // force the lookahead to work for patrols. This approach
-                  // should be reworked in a future redesign of the traffic
-                  // system.
-                  for (auto& r : final_itinerary)
-                  {
-                    for (std::size_t i = 0; i < parent.itinerary.size(); ++i)
-                    {
-                      r.add_dependency(
-                        r.trajectory().size(),
-                        rmf_traffic::Dependency{
-                          parent.participant,
-                          parent.plan,
-                          i,
-                          parent.itinerary[i].trajectory().size()
-                        });
-                    }
-                  }
-                }
-
-                responder->submit(
-                  plan_id,
-                  final_itinerary,
-                  [
-                    plan_id,
-                    plan = *r,
-                    approval = std::move(approval),
-                    final_itinerary
-                  ]()
-                  -> UpdateVersion
-                  {
-                    if (approval)
-                      return approval(plan_id, plan, final_itinerary);
-
-                    return rmf_utils::nullopt;
-                  });
-              }
-            });
+            Result{self->shared_from_this(), self->_make_submission(best)});
 
           s.on_completed();
           self->interrupt();
@@ -160,6 +122,7 @@ void Negotiate::operator()(const Subscriber& s)
         else if (self->_alternatives && !self->_alternatives->empty())
         {
           self->_finished = true;
+          self->_report_evaluation();
           // This means we could not find a successful plan, but we have some
           // alternatives to offer the parent in the negotiation.
           s.on_next(
@@ -178,6 +141,7 @@ void Negotiate::operator()(const Subscriber& s)
         else if (!self->_attempting_rollout)
         {
           self->_finished = true;
+          self->_report_evaluation();
           // This means we could not find any plan or any alternatives to offer
           // the parent, so all we can do is forfeit.
           s.on_next(
@@ -245,7 +209,8 @@ void Negotiate::operator()(const Subscriber& s)
 
             n->_rollout_job = std::make_shared<jobs::Rollout>(
               std::move(rollout_source), parent_id,
-              std::chrono::seconds(15), 5);
+              std::chrono::seconds(15), 5, n->_interrupted,
+              std::chrono::seconds(5));
 
             n->_rollout_sub =
             rmf_rxcpp::make_job<jobs::Rollout::Result>(n->_rollout_job)
@@ -293,7 +258,7 @@ void Negotiate::operator()(const Subscriber& s)
           n->_current_jobs.erase(job);
         }
 
-        while (n->_current_jobs.size() < max_concurrent_jobs
+        while (n->_current_jobs.size() < max_concurrent_jobs()
         && !n->_resume_jobs.empty())
         {
           n->_resume_next();
@@ -189,18 +189,25 @@ void add_patrol(
       if (rounds_json_it != msg.end())
         rounds = rounds_json_it->get<std::size_t>();
 
+      // Every round visits the same places, so the phases of one round are
+      // made once and shared by all the rounds. Descriptions cannot be changed
+      // after they are built, and each round still gets activated separately.
+      std::vector<rmf_task_sequence::Phase::ConstDescriptionPtr> round;
+      round.reserve(places.size());
+      for (std::size_t j = 0; j < places.size(); ++j)
+      {
+        auto go_to_place = GoToPlace::Description::make(places[j]);
+        go_to_place->expected_next_destinations(
+          std::vector<rmf_traffic::agv::Plan::Goal>(
+            places.begin() + j + 1, places.end()));
+        round.push_back(Phase::Description::make(std::move(go_to_place)));
+      }
+
       rmf_task_sequence::Task::Builder builder;
       for (std::size_t i = 0; i < rounds; ++i)
       {
-        for (std::size_t j = 0; j < places.size(); ++j)
-        {
-          const auto& place = places[j];
-          auto go_to_place = GoToPlace::Description::make(place);
-          auto next = places;
-          next.erase(next.begin(), next.begin() + j + 1);
-          go_to_place->expected_next_destinations(std::move(next));
-          builder.add_phase(Phase::Description::make(go_to_place), {});
-        }
+        for (const auto& phase : round)
+          builder.add_phase(phase, {});
       }
 
       return {builder.build("Patrol", ""), std::move(errors)};
@@ -211,16 +218,17 @@ void add_patrol(
   auto loop_unfolder =
     [](const Loop::Description& loop)
     {
+      const auto go_to_start = Phase::Description::make(
+        GoToPlace::Description::make(loop.start_waypoint()));
+      const auto go_to_finish = Phase::Description::make(
+        GoToPlace::Description::make(loop.finish_waypoint()));
+
       rmf_task_sequence::Task::Builder builder;
       for (std::size_t i = 0; i < loop.num_loops(); ++i)
       {
         builder
-        .add_phase(
-          Phase::Description::make(
-            GoToPlace::Description::make(loop.start_waypoint())), {})
-        .add_phase(
-          Phase::Description::make(
-            GoToPlace::Description::make(loop.finish_waypoint())), {});
+        .add_phase(go_to_start, {})
+        .add_phase(go_to_finish, {});
       }
 
       // TODO(MXG): Consider making the category and detail more details
@@ -23,6 +23,9 @@
 
 #include <rmf_fleet_adapter/StandardNames.hpp>
 
+#include <unordered_map>
+#include <unordered_set>
+
 #ifdef FAILOVER_MODE
 #include "stubborn_buddies_msgs/msg/status.hpp"
 #endif
@@ -112,6 +115,32 @@ public:
 
     this->_prefix = std::move(prefix);
     this->_fleet_name = std::move(fleet_name);
+
+    // By default a fleet state is published for every robot state that comes
+    // in. With a publish period, the robot states are aggregated and
+    // published at that rate instead, or sooner if max_pending_updates robot
+    // states have come in since the last fleet state.
+    const double publish_period =
+      this->declare_parameter("publish_period", 0.0);
+    const auto max_pending_updates =
+      this->declare_parameter("max_pending_updates", 0);
+    _max_pending_updates = max_pending_updates > 0 ?
+      static_cast<std::size_t>(max_pending_updates) : 0;
+
+    // Only include the robots whose states have been updated since the last
+    // fleet state was published
+    _only_updated_robots =
+      this->declare_parameter("only_updated_robots", false);
+
+    if (publish_period > 0.0)
+    {
+      _publish_timer = create_wall_timer(
+        std::chrono::duration<double>(publish_period),
+        [this]()
+        {
+          _publish_fleet_state();
+        });
+    }
   }
 
 private:
@@ -126,7 +155,14 @@ private:
   std::string _namespace;
 #endif
 
+  // When _only_updated_robots is true, this only holds the states that have
+  // not been published yet.
   std::unordered_map<std::string, std::unique_ptr<RobotState>> _latest_states;
+  std::unordered_map<std::string, rclcpp::Time> _latest_times;
+  std::unordered_set<std::string> _updated_robots;
+  bool _only_updated_robots = false;
+  std::size_t _max_pending_updates = 0;
+  rclcpp::TimerBase::SharedPtr _publish_timer;
 
   rclcpp::Publisher<FleetState>::SharedPtr _fleet_state_pub;
   rclcpp::Subscription<RobotState>::SharedPtr _robot_state_sub;
@@ -142,35 +178,58 @@ private:
     if (name.size() < _prefix.size())
       return;
 
-    if (name.substr(0, _prefix.size()) != _prefix)
+    if (name.compare(0, _prefix.size(), _prefix) != 0)
       return;
 
-    const auto insertion = _latest_states.insert(std::make_pair(name, nullptr));
-    const auto it = insertion.first;
-    bool updated = false;
-    if (insertion.second)
+    const rclcpp::Time time(msg->location.t);
+    const auto insertion = _latest_times.insert(std::make_pair(name, time));
+    if (!insertion.second)
     {
-      it->second = std::move(msg);
-      updated = true;
+      if (!(insertion.first->second < time))
+        return;
+
+      insertion.first->second = time;
     }
-    else
+
+    // The key stays valid after msg is moved, since it belongs to the map
+    const auto& key = insertion.first->first;
+    _latest_states[key] = std::move(msg);
+    _updated_robots.insert(key);
+
+    const bool budget_reached = _max_pending_updates > 0
+      && _updated_robots.size() >= _max_pending_updates;
+
+    if (!_publish_timer || budget_reached)
+      _publish_fleet_state();
+  }
+
+  void _publish_fleet_state()
+  {
+    if (_updated_robots.empty())
+      return;
+
+    FleetState fleet;
+    fleet.name = _fleet_name;
+    if (_only_updated_robots)
     {
-      if (rclcpp::Time(it->second->location.t) < rclcpp::Time(msg->location.t) )
+      // These states will not be needed again, so move them into the message
+      fleet.robots.reserve(_updated_robots.size());
+      for (const auto& name : _updated_robots)
       {
-        it->second = std::move(msg);
-        updated = true;
+        const auto it = _latest_states.find(name);
+        fleet.robots.emplace_back(std::move(*it->second));
+        _latest_states.erase(it);
       }
     }
-
-    if (updated)
+    else
     {
-      FleetState fleet;
-      fleet.name = _fleet_name;
+      fleet.robots.reserve(_latest_states.size());
       for (const auto& robot_state : _latest_states)
         fleet.robots.emplace_back(*robot_state.second);
-
-      _fleet_state_pub->publish(fleet);
     }
+
+    _updated_robots.clear();
+    _fleet_state_pub->publish(fleet);
   }
 
 };
@@ -23,20 +23,33 @@
 #include <rmf_task_msgs/msg/tasks.hpp>
 #include <rmf_task_msgs/msg/task_summary.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
 
 class TaskAggregator : public rclcpp::Node
 {
 
   using TaskSummary = rmf_task_msgs::msg::TaskSummary;
   using Tasks = rmf_task_msgs::msg::Tasks;
+  using Clock = std::chrono::steady_clock;
 
 public:
   TaskAggregator(
     std::string node_name,
     std::string input_topic,
-    double rate)
+    double rate,
+    double eviction_window,
+    std::size_t max_tasks)
   : Node(node_name),
-    _rate(rate)
+    _rate(rate),
+    _eviction_window(
+      std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::ratio<1>>(eviction_window))),
+    _max_tasks(max_tasks),
+    _last_full_publish(Clock::now())
   {
     // Create a wall timer to periodically publish Tasks msg
     const double period = 1.0/_rate;
@@ -50,6 +63,11 @@ public:
       "/tasks",
       rclcpp::ServicesQoS());
 
+    // Create publisher for the summaries that changed since the last period
+    _task_updates_pub = this->create_publisher<Tasks>(
+      "/task_updates",
+      rclcpp::ServicesQoS());
+
     // Create subscription to receive TaskSummary msgs from fleet adapters
     _cb_group_task_summary = this->create_callback_group(
       rclcpp::CallbackGroupType::MutuallyExclusive);
@@ -73,34 +91,131 @@ public:
 
 private:
 
+  struct Entry
+  {
+    TaskSummary summary;
+    Clock::time_point last_update;
+    // When the task reached a terminal state, if it has
+    std::optional<Clock::time_point> finished;
+  };
+
+  static bool is_finished(const TaskSummary& summary)
+  {
+    return summary.state == TaskSummary::STATE_COMPLETED
+      || summary.state == TaskSummary::STATE_FAILED
+      || summary.state == TaskSummary::STATE_CANCELED;
+  }
+
   void timer_callback()
   {
-    Tasks tasks;
+    const auto now = Clock::now();
+    evict(now);
+
+    // Only the summaries that changed go out every period. The full list goes
+    // out when it has changed, and at least every full_publish_period so that
+    // late joiners catch up.
+    if (!_changed.empty())
+    {
+      Tasks updates;
+      updates.tasks.reserve(_changed.size());
+      for (const auto& task_id : _changed)
+      {
+        const auto it = _db.find(task_id);
+        if (it != _db.end())
+          updates.tasks.push_back(it->second.summary);
+      }
+
+      _task_updates_pub->publish(updates);
+      _changed.clear();
+      _full_changed = true;
+    }
+
+    if (!_full_changed && now - _last_full_publish < full_publish_period)
+      return;
 
+    Tasks tasks;
+    tasks.tasks.reserve(_db.size());
     for (const auto& t : _db)
-      tasks.tasks.push_back(t.second);
+      tasks.tasks.push_back(t.second.summary);
 
     _tasks_pub->publish(tasks);
+    _last_full_publish = now;
+    _full_changed = false;
   }
 
   void task_summary_cb(const TaskSummary::SharedPtr msg)
   {
-    if (_db.find(msg->task_id) != _db.end())
+    const auto now = Clock::now();
+    auto& entry = _db[msg->task_id];
+    if (!is_finished(*msg))
+      entry.finished = std::nullopt;
+    else if (!entry.finished.has_value())
+      entry.finished = now;
+
+    entry.summary = *msg;
+    entry.last_update = now;
+    _changed.insert(msg->task_id);
+  }
+
+  void evict(const Clock::time_point now)
+  {
+    const std::size_t initial_size = _db.size();
+    if (_eviction_window > Clock::duration::zero())
     {
-      _db[msg->task_id] = *msg;
+      for (auto it = _db.begin(); it != _db.end(); )
+      {
+        const auto& finished = it->second.finished;
+        if (finished.has_value() && *finished + _eviction_window <= now)
+          it = _db.erase(it);
+        else
+          ++it;
+      }
     }
-    else
+
+    if (_max_tasks > 0 && _db.size() > _max_tasks)
     {
-      _db.insert(std::make_pair(msg->task_id, *msg));
+      // Drop finished tasks before active ones, and older ones before newer
+      // ones.
+      std::vector<std::unordered_map<std::string, Entry>::iterator> order;
+      order.reserve(_db.size());
+      for (auto it = _db.begin(); it != _db.end(); ++it)
+        order.push_back(it);
+
+      const std::size_t excess = _db.size() - _max_tasks;
+      std::nth_element(
+        order.begin(), order.begin() + (excess - 1), order.end(),
+        [](const auto& a, const auto& b)
+        {
+          const bool a_finished = a->second.finished.has_value();
+          const bool b_finished = b->second.finished.has_value();
+          if (a_finished != b_finished)
+            return a_finished;
+
+          return a->second.last_update < b->second.last_update;
+        });
+
+      for (std::size_t i = 0; i < excess; ++i)
+        _db.erase(order[i]);
     }
+
+    if (_db.size() != initial_size)
+      _full_changed = true;
   }
 
+  static constexpr auto full_publish_period = std::chrono::seconds(10);
+
   double _rate;
+  Clock::duration _eviction_window;
+  std::size_t _max_tasks;
 
-  std::unordered_map<std::string, TaskSummary> _db;
+  std::unordered_map<std::string, Entry> _db;
+  std::unordered_set<std::string> _changed;
+  bool _full_changed = false;
+  Clock::time_point _last_full_publish;
 
   rclcpp::TimerBase::SharedPtr _timer;
   rclcpp::Publisher<Tasks>::SharedPtr _tasks_pub;
+  rclcpp::Publisher<Tasks>::SharedPtr _task_updates_pub;
   rclcpp::Subscription<TaskSummary>::SharedPtr _task_summary_sub;
   rclcpp::CallbackGroup::SharedPtr _cb_group_task_summary;
 };
@@ -148,10 +263,25 @@ int main(int argc, char* argv[])
   get_arg(args, "-r", rate_string, "rate", false);
   double rate = rate_string.empty() ? 1.0 : std::stod(rate_string);
 
+  // Seconds to keep reporting a task after it has completed, failed, or been
+  // canceled. Zero keeps finished tasks until the maximum is reached.
+  std::string eviction_string;
+  get_arg(args, "-e", eviction_string, "eviction window", false);
+  double eviction_window =
+    eviction_string.empty() ? 600.0 : std::stod(eviction_string);
+
+  // The most tasks to keep track of at once. Zero means no limit.
+  std::string max_tasks_string;
+  get_arg(args, "-m", max_tasks_string, "maximum number of tasks", false);
+  std::size_t max_tasks =
+    max_tasks_string.empty() ? 10000 : std::stoul(max_tasks_string);
+
   auto task_aggregator_node = std::make_shared<TaskAggregator>(
     node_name,
     input_topic,
-    rate);
+    rate,
+    eviction_window,
+    max_tasks);
 
   rclcpp::spin(task_aggregator_node);
 
@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef TEST__BENCHMARK__ALLOCATIONS_HPP
+#define TEST__BENCHMARK__ALLOCATIONS_HPP
+
+#include <cstddef>
+
+namespace rmf_fleet_adapter_test {
+
+// The number of heap allocations that the benchmark executable has made so far.
+// Every thread is counted, so this includes the allocations of worker threads.
+std::size_t allocation_count();
+
+} // namespace rmf_fleet_adapter_test
+
+#endif // TEST__BENCHMARK__ALLOCATIONS_HPP
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <rmf_rxcpp/Transport.hpp>
+
+#include <std_msgs/msg/empty.hpp>
+
+#include <rmf_utils/catch.hpp>
+
+#include <atomic>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace {
+//==============================================================================
+/// A Transport node that subscribes to its own topic, so the time from
+/// publishing a message to its callback running on the worker can be measured
+/// for either way that RxCppExecutor hands work to the worker.
+class LatencyProbe
+{
+public:
+
+  LatencyProbe(bool use_work_queue)
+  {
+    _context = std::make_shared<rclcpp::Context>();
+    _context->init(0, nullptr);
+
+    _node = std::make_shared<rmf_rxcpp::Transport>(
+      rxcpp::schedulers::make_event_loop().create_worker(),
+      "benchmark_executor",
+      rclcpp::NodeOptions().context(_context));
+    _node->use_executor_work_queue(use_work_queue);
+
+    const auto qos = rclcpp::QoS(1000).reliable();
+    _sub = _node->create_subscription<std_msgs::msg::Empty>(
+      "benchmark_executor", qos,
+      [this](std_msgs::msg::Empty::SharedPtr)
+      {
+        _received.fetch_add(1, std::memory_order_release);
+      });
+    _pub = _node->create_publisher<std_msgs::msg::Empty>(
+      "benchmark_executor", qos);
+
+    _node->start();
+
+    // Wait for discovery so the first samples do not include it
+    const auto give_up = std::chrono::steady_clock::now() + 5s;
+    while (_pub->get_subscription_count() == 0
+      && std::chrono::steady_clock::now() < give_up)
+    {
+      std::this_thread::sleep_for(10ms);
+    }
+  }
+
+  /// Publish count messages and wait until all of their callbacks have run.
+  /// Returns false if they did not all arrive in time.
+  bool round_trip(const std::size_t count)
+  {
+    const auto target = _received.load(std::memory_order_acquire) + count;
+    for (std::size_t i = 0; i < count; ++i)
+      _pub->publish(std_msgs::msg::Empty());
+
+    const auto give_up = std::chrono::steady_clock::now() + 1s;
+    while (_received.load(std::memory_order_acquire) < target)
+    {
+      if (give_up < std::chrono::steady_clock::now())
+        return false;
+
+      std::this_thread::yield();
+    }
+
+    return true;
+  }
+
+  ~LatencyProbe()
+  {
+    _node->stop();
+    _sub.reset();
+    _pub.reset();
+    _node.reset();
+    _context->shutdown("benchmark finished");
+  }
+
+private:
+  std::shared_ptr<rclcpp::Context> _context;
+  std::shared_ptr<rmf_rxcpp::Transport> _node;
+  rclcpp::Subscription<std_msgs::msg::Empty>::SharedPtr _sub;
+  rclcpp::Publisher<std_msgs::msg::Empty>::SharedPtr _pub;
+  std::atomic_size_t _received{0};
+};
+} // anonymous namespace
+
+//==============================================================================
+TEST_CASE("Benchmark RxCppExecutor callback latency", "[benchmark]")
+{
+  for (const bool use_work_queue : {false, true})
+  {
+    const std::string mode = use_work_queue ? "work queue" : "handshake";
+    LatencyProbe probe(use_work_queue);
+    REQUIRE(probe.round_trip(1));
+
+    // The time from publishing one message until its callback has run
+    BENCHMARK("Callback latency " + mode)
+    {
+      return probe.round_trip(1);
+    };
+
+    // The time for a burst of messages to all be handled, which is where the
+    // handshake pays for its extra thread handoffs
+    BENCHMARK("Callback burst of 100 " + mode)
+    {
+      return probe.round_trip(100);
+    };
+  }
+}
@@ -0,0 +1,308 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <services/FindEmergencyPullover.hpp>
+#include <services/FindPath.hpp>
+
+#include <rmf_fleet_adapter/agv/parse_graph.hpp>
+
+#include <rmf_utils/catch.hpp>
+
+#include "allocations.hpp"
+#include "../services/NegotiationRoom.hpp"
+
+using namespace rmf_fleet_adapter_test;
+using namespace std::chrono_literals;
+
+namespace {
+//==============================================================================
+struct Scenario
+{
+  std::string name;
+  rmf_traffic::agv::Graph graph;
+  rmf_traffic::agv::VehicleTraits traits;
+
+  // The robot that is being planned for
+  rmf_traffic::agv::Plan::StartSet starts;
+  rmf_traffic::agv::Plan::Goal goal;
+
+  // A robot that comes the opposite way, used for negotiations
+  rmf_traffic::agv::Plan::StartSet other_starts;
+  rmf_traffic::agv::Plan::Goal other_goal;
+};
+
+//==============================================================================
+const rmf_traffic::Profile profile{
+  rmf_traffic::geometry::make_final_convex<
+    rmf_traffic::geometry::Circle>(1.0)
+};
+
+//==============================================================================
+Scenario office_scenario()
+{
+  const rmf_traffic::agv::VehicleTraits traits{
+    {0.5, 0.75},
+    {0.6, 2.0},
+    profile
+  };
+
+  const auto now = std::chrono::steady_clock::now();
+  return Scenario{
+    "office",
+    rmf_fleet_adapter::agv::parse_graph(
+      TEST_RESOURCES_DIR "/office_nav.yaml", traits),
+    traits,
+    {{now, 17, 2.7496, Eigen::Vector2d(7.75515, -5.7033)}},
+    rmf_traffic::agv::Plan::Goal(10),
+    {{now, 10, 0.0}},
+    rmf_traffic::agv::Plan::Goal(17)
+  };
+}
+
+//==============================================================================
+/// A square grid of n x n waypoints that are 5m apart, with parking spots in
+/// its corners. The robots cross the grid along its middle row in opposite
+/// directions.
+Scenario grid_scenario(const std::size_t n)
+{
+  const std::string map = "test_map";
+  const auto index = [n](std::size_t row, std::size_t col)
+    {
+      return row*n + col;
+    };
+
+  rmf_traffic::agv::Graph graph;
+  for (std::size_t row = 0; row < n; ++row)
+  {
+    for (std::size_t col = 0; col < n; ++col)
+    {
+      const bool corner = (row == 0 || row == n-1) && (col == 0 || col == n-1);
+      graph.add_waypoint(map, {5.0*col, 5.0*row}).set_parking_spot(corner);
+    }
+  }
+
+  for (std::size_t row = 0; row < n; ++row)
+  {
+    for (std::size_t col = 0; col < n; ++col)
+    {
+      if (col + 1 < n)
+      {
+        graph.add_lane(index(row, col), index(row, col+1));
+        graph.add_lane(index(row, col+1), index(row, col));
+      }
+
+      if (row + 1 < n)
+      {
+        graph.add_lane(index(row, col), index(row+1, col));
+        graph.add_lane(index(row+1, col), index(row, col));
+      }
+    }
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  const std::size_t middle = n/2;
+  return Scenario{
+    "grid " + std::to_string(n) + "x" + std::to_string(n),
+    std::move(graph),
+    rmf_traffic::agv::VehicleTraits{{0.7, 0.3}, {1.0, 0.45}, profile},
+    {{now, index(middle, 0), 0.0}},
+    rmf_traffic::agv::Plan::Goal(index(middle, n-1)),
+    {{now, index(middle, n-1), M_PI}},
+    rmf_traffic::agv::Plan::Goal(index(middle, 0))
+  };
+}
+
+//==============================================================================
+std::vector<Scenario> all_scenarios()
+{
+  std::vector<Scenario> scenarios;
+  scenarios.push_back(office_scenario());
+  for (const std::size_t n : {8, 16, 32})
+    scenarios.push_back(grid_scenario(n));
+
+  return scenarios;
+}
+
+//==============================================================================
+std::shared_ptr<rmf_traffic::agv::Planner> make_planner(
+  const Scenario& scenario)
+{
+  return std::make_shared<rmf_traffic::agv::Planner>(
+    rmf_traffic::agv::Planner::Configuration{scenario.graph, scenario.traits},
+    rmf_traffic::agv::Planner::Options{nullptr});
+}
+
+//==============================================================================
+template<typename Service>
+typename Service::Result run(std::shared_ptr<Service> service)
+{
+  return rmf_rxcpp::make_job<typename Service::Result>(std::move(service))
+    .as_blocking().last();
+}
+
+//==============================================================================
+rmf_traffic::agv::Plan::Result find_path(
+  const std::shared_ptr<rmf_traffic::agv::Planner>& planner,
+  const Scenario& scenario)
+{
+  const auto database = std::make_shared<rmf_traffic::schedule::Database>();
+  return run(std::make_shared<rmf_fleet_adapter::services::FindPath>(
+      planner, scenario.starts, scenario.goal, database->snapshot(), 0,
+      std::make_shared<rmf_traffic::Profile>(profile), std::nullopt));
+}
+
+//==============================================================================
+rmf_traffic::agv::Plan::Result find_pullover(
+  const std::shared_ptr<rmf_traffic::agv::Planner>& planner,
+  const Scenario& scenario)
+{
+  const auto database = std::make_shared<rmf_traffic::schedule::Database>();
+  using rmf_fleet_adapter::services::FindEmergencyPullover;
+  return run(std::make_shared<FindEmergencyPullover>(
+      planner, scenario.starts, database->snapshot(), 0,
+      std::make_shared<rmf_traffic::Profile>(profile)));
+}
+
+//==============================================================================
+/// Two robots whose current plans run into each other, ready to negotiate.
+struct Conflict
+{
+  std::shared_ptr<rmf_traffic::schedule::Database> database;
+  std::vector<rmf_traffic::schedule::Participant> participants;
+  std::shared_ptr<TestPathNegotiationRoom> room;
+
+  explicit Conflict(const Scenario& scenario)
+  : database(std::make_shared<rmf_traffic::schedule::Database>())
+  {
+    const auto planner = make_planner(scenario);
+    TestPathNegotiator::Intentions intentions;
+    const auto add = [&](
+      const std::string& name,
+      const rmf_traffic::agv::Plan::StartSet& starts,
+      const rmf_traffic::agv::Plan::Goal& goal)
+      {
+        auto participant = rmf_traffic::schedule::make_participant(
+          rmf_traffic::schedule::ParticipantDescription{
+            name,
+            "benchmark",
+            rmf_traffic::schedule::ParticipantDescription::Rx::Responsive,
+            profile
+          },
+          database);
+
+        const auto plan = planner->plan(starts, goal);
+        if (plan)
+          participant.set(participant.assign_plan_id(), plan->get_itinerary());
+
+        intentions.insert({participant.id(), {starts, goal, planner}});
+        participants.push_back(std::move(participant));
+      };
+
+    add("p0", scenario.starts, scenario.goal);
+    add("p1", scenario.other_starts, scenario.other_goal);
+    room = std::make_shared<TestPathNegotiationRoom>(
+      database->snapshot(), std::move(intentions));
+  }
+
+  TestPathNegotiationRoom::OptProposal solve()
+  {
+    return room->solve().get();
+  }
+};
+
+//==============================================================================
+template<typename F>
+void report_allocations(const std::string& name, const F& f)
+{
+  const auto before = allocation_count();
+  f();
+  std::cout << name << ": " << allocation_count() - before
+            << " allocations" << std::endl;
+}
+} // anonymous namespace
+
+//==============================================================================
+TEST_CASE("Benchmark FindPath", "[benchmark]")
+{
+  for (const auto& scenario : all_scenarios())
+  {
+    report_allocations(
+      "FindPath " + scenario.name,
+      [&]() { find_path(make_planner(scenario), scenario); });
+
+    // A new planner has to fill its heuristic cache during the search
+    BENCHMARK_ADVANCED("FindPath cold " + scenario.name)(
+      Catch::Benchmark::Chronometer meter)
+    {
+      std::vector<std::shared_ptr<rmf_traffic::agv::Planner>> planners;
+      for (int i = 0; i < meter.runs(); ++i)
+        planners.push_back(make_planner(scenario));
+
+      meter.measure([&](int i) { return find_path(planners[i], scenario); });
+    };
+
+    const auto planner = make_planner(scenario);
+    find_path(planner, scenario);
+    BENCHMARK("FindPath warm " + scenario.name)
+    {
+      return find_path(planner, scenario);
+    };
+  }
+}
+
+//==============================================================================
+TEST_CASE("Benchmark FindEmergencyPullover", "[benchmark]")
+{
+  for (const auto& scenario : all_scenarios())
+  {
+    report_allocations(
+      "FindEmergencyPullover " + scenario.name,
+      [&]() { find_pullover(make_planner(scenario), scenario); });
+
+    BENCHMARK_ADVANCED("FindEmergencyPullover " + scenario.name)(
+      Catch::Benchmark::Chronometer meter)
+    {
+      std::vector<std::shared_ptr<rmf_traffic::agv::Planner>> planners;
+      for (int i = 0; i < meter.runs(); ++i)
+        planners.push_back(make_planner(scenario));
+
+      meter.measure(
+        [&](int i) { return find_pullover(planners[i], scenario); });
+    };
+  }
+}
+
+//==============================================================================
+TEST_CASE("Benchmark Negotiate", "[benchmark]")
+{
+  for (const auto& scenario : all_scenarios())
+  {
+    report_allocations(
+      "Negotiate " + scenario.name,
+      [&]() { Conflict(scenario).solve(); });
+
+    BENCHMARK_ADVANCED("Negotiate " + scenario.name)(
+      Catch::Benchmark::Chronometer meter)
+    {
+      std::vector<std::unique_ptr<Conflict>> conflicts;
+      for (int i = 0; i < meter.runs(); ++i)
+        conflicts.push_back(std::make_unique<Conflict>(scenario));
+
+      meter.measure([&](int i) { return conflicts[i]->solve(); });
+    };
+  }
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#define CATCH_CONFIG_RUNNER
+#include <rmf_utils/catch.hpp>
+
+#include "allocations.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic_size_t allocations{0};
+} // anonymous namespace
+
+namespace rmf_fleet_adapter_test {
+//==============================================================================
+std::size_t allocation_count()
+{
+  return allocations.load(std::memory_order_relaxed);
+}
+} // namespace rmf_fleet_adapter_test
+
+//==============================================================================
+void* operator new(std::size_t size)
+{
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    return ptr;
+
+  throw std::bad_alloc();
+}
+
+//==============================================================================
+void* operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+//==============================================================================
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+//==============================================================================
+void operator delete[](void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+//==============================================================================
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+//==============================================================================
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,350 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// This harness finds how many robots one fleet adapter can keep up with. It
+// runs a MockAdapter, whose traffic schedule lives in the same process, with
+// a fleet of mock robots that keep patrolling. While they patrol it reports
+// how much CPU the process uses per robot, how long jobs wait on the worker of
+// the fleet, and how the memory of the process grows.
+//
+// Usage: scale_rmf_fleet_adapter [robots=100] [duration_s=120] [period_s=5]
+
+#include "../mock/MockRobotCommand.hpp"
+
+#include <agv/internal_FleetUpdateHandle.hpp>
+
+#include <rmf_fleet_adapter/agv/test/MockAdapter.hpp>
+#include <rmf_websocket/BroadcastServer.hpp>
+
+#include <rmf_traffic/geometry/Circle.hpp>
+#include <rmf_traffic_ros2/Time.hpp>
+
+#include <rmf_battery/agv/BatterySystem.hpp>
+#include <rmf_battery/agv/SimpleMotionPowerSink.hpp>
+#include <rmf_battery/agv/SimpleDevicePowerSink.hpp>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace {
+//==============================================================================
+std::string bottom(std::size_t i)
+{
+  return "bottom_" + std::to_string(i);
+}
+
+//==============================================================================
+std::string top(std::size_t i)
+{
+  return "top_" + std::to_string(i);
+}
+
+//==============================================================================
+/// A ladder with one rung per robot. Each robot patrols its own rung, so the
+/// robots do not get in each other's way and the harness measures the adapter
+/// rather than traffic negotiations. The rails keep the graph connected so
+/// the task planner still considers every robot for every task.
+rmf_traffic::agv::Graph make_ladder(std::size_t robots)
+{
+  const std::string map = "test_map";
+  rmf_traffic::agv::Graph graph;
+  for (std::size_t i = 0; i < robots; ++i)
+  {
+    graph.add_waypoint(map, {5.0*i, 0.0}).set_charger(true);
+    graph.add_key(bottom(i), 2*i);
+    graph.add_waypoint(map, {5.0*i, 10.0});
+    graph.add_key(top(i), 2*i+1);
+
+    graph.add_lane(2*i, 2*i+1);
+    graph.add_lane(2*i+1, 2*i);
+    if (i > 0)
+    {
+      for (const std::size_t rail : {0, 1})
+      {
+        graph.add_lane(2*(i-1) + rail, 2*i + rail);
+        graph.add_lane(2*i + rail, 2*(i-1) + rail);
+      }
+    }
+  }
+
+  return graph;
+}
+
+//==============================================================================
+double cpu_seconds()
+{
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  const auto seconds = [](const timeval& t)
+    {
+      return static_cast<double>(t.tv_sec) + 1e-6*t.tv_usec;
+    };
+
+  return seconds(usage.ru_utime) + seconds(usage.ru_stime);
+}
+
+//==============================================================================
+double resident_megabytes()
+{
+  std::ifstream statm("/proc/self/statm");
+  std::size_t size = 0;
+  std::size_t resident = 0;
+  statm >> size >> resident;
+  return static_cast<double>(resident * sysconf(_SC_PAGESIZE)) / (1024*1024);
+}
+
+//==============================================================================
+/// Measures how long jobs wait in the queue of a worker before they run.
+class LagProbe : public std::enable_shared_from_this<LagProbe>
+{
+public:
+
+  void sample(const rxcpp::schedulers::worker& worker)
+  {
+    worker.schedule(
+      [
+        self = shared_from_this(),
+        sent = std::chrono::steady_clock::now()
+      ](const auto&)
+      {
+        const auto lag = std::chrono::steady_clock::now() - sent;
+        std::lock_guard<std::mutex> lock(self->_mutex);
+        self->_total += lag;
+        self->_max = std::max(self->_max, lag);
+        ++self->_count;
+      });
+  }
+
+  /// Get the average and the maximum lag since the last report, in ms
+  std::pair<double, double> report()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto to_ms = [](std::chrono::steady_clock::duration d)
+      {
+        return std::chrono::duration<double, std::milli>(d).count();
+      };
+
+    const auto result = std::make_pair(
+      _count > 0 ? to_ms(_total) / _count : 0.0,
+      to_ms(_max));
+    _total = _max = std::chrono::steady_clock::duration(0);
+    _count = 0;
+    return result;
+  }
+
+private:
+  std::mutex _mutex;
+  std::chrono::steady_clock::duration _total{0};
+  std::chrono::steady_clock::duration _max{0};
+  std::size_t _count = 0;
+};
+} // anonymous namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  const std::size_t n_robots = argc > 1 ? std::stoul(argv[1]) : 100;
+  const auto duration =
+    std::chrono::seconds(argc > 2 ? std::stoul(argv[2]) : 120);
+  const auto period =
+    std::chrono::seconds(argc > 3 ? std::stoul(argv[3]) : 5);
+  const uint16_t port = 27879;
+  const std::size_t rounds = 5;
+
+  const auto graph = make_ladder(n_robots);
+  rmf_traffic::Profile profile{
+    rmf_traffic::geometry::make_final_convex<
+      rmf_traffic::geometry::Circle>(1.0)
+  };
+  const rmf_traffic::agv::VehicleTraits traits{
+    {0.7, 0.3},
+    {1.0, 0.45},
+    profile
+  };
+
+  auto rcl_context = std::make_shared<rclcpp::Context>();
+  rcl_context->init(0, nullptr);
+  rmf_fleet_adapter::agv::test::MockAdapter adapter(
+    "scale_rmf_fleet_adapter", rclcpp::NodeOptions().context(rcl_context));
+
+  // Patrols that have been completed and whose robots need a new one
+  std::mutex finished_mutex;
+  std::vector<std::size_t> finished;
+  std::atomic_size_t completed_patrols{0};
+
+  using WebsocketServer = rmf_websocket::BroadcastServer;
+  const auto ws_server = WebsocketServer::make(
+    port,
+    [&](const nlohmann::json& data)
+    {
+      if (data.at("status") != "completed")
+        return;
+
+      // Task IDs look like patrol_<robot>_<count>
+      const std::string id = data.at("booking").at("id");
+      const auto first = id.find('_');
+      const auto last = id.rfind('_');
+      if (first == std::string::npos || first == last)
+        return;
+
+      ++completed_patrols;
+      std::lock_guard<std::mutex> lock(finished_mutex);
+      finished.push_back(std::stoul(id.substr(first + 1, last - first - 1)));
+    },
+    WebsocketServer::ApiMsgType::TaskStateUpdate);
+
+  const auto fleet = adapter.add_fleet(
+    "scale_fleet", traits, graph,
+    "ws://localhost:" + std::to_string(port));
+
+  using BatterySystem = rmf_battery::agv::BatterySystem;
+  using PowerSystem = rmf_battery::agv::PowerSystem;
+  using MechanicalSystem = rmf_battery::agv::MechanicalSystem;
+  using SimpleMotionPowerSink = rmf_battery::agv::SimpleMotionPowerSink;
+  using SimpleDevicePowerSink = rmf_battery::agv::SimpleDevicePowerSink;
+
+  auto battery_system = std::make_shared<BatterySystem>(
+    *BatterySystem::make(24.0, 40.0, 8.8));
+  auto mechanical_system = MechanicalSystem::make(70.0, 40.0, 0.22);
+  auto motion_sink = std::make_shared<SimpleMotionPowerSink>(
+    *battery_system, *mechanical_system);
+  auto ambient_power_system = PowerSystem::make(20.0);
+  auto ambient_sink = std::make_shared<SimpleDevicePowerSink>(
+    *battery_system, *ambient_power_system);
+  auto tool_power_system = PowerSystem::make(10.0);
+  auto tool_sink = std::make_shared<SimpleDevicePowerSink>(
+    *battery_system, *tool_power_system);
+
+  fleet->set_task_planner_params(
+    battery_system, motion_sink, ambient_sink, tool_sink, 0.2, 1.0, false);
+
+  fleet->consider_patrol_requests(
+    [](
+      const nlohmann::json&,
+      rmf_fleet_adapter::agv::FleetUpdateHandle::Confirmation& confirm)
+    {
+      confirm.accept();
+    });
+
+  const auto now = rmf_traffic_ros2::convert(adapter.node()->now());
+  std::vector<std::shared_ptr<rmf_fleet_adapter_test::MockRobotCommand>>
+  commands;
+  for (std::size_t i = 0; i < n_robots; ++i)
+  {
+    auto command = std::make_shared<rmf_fleet_adapter_test::MockRobotCommand>(
+      adapter.node(), graph);
+    fleet->add_robot(
+      command, "robot_" + std::to_string(i), profile, {{now, 2*i, 0.0}},
+      [w = std::weak_ptr(command)](
+        rmf_fleet_adapter::agv::RobotUpdateHandlePtr updater)
+      {
+        updater->update_battery_soc(1.0);
+        if (const auto command = w.lock())
+          command->updater = std::move(updater);
+      });
+    commands.push_back(std::move(command));
+  }
+
+  adapter.start();
+  ws_server->start();
+
+  // Give the robots time to be added before tasks arrive
+  std::this_thread::sleep_for(1s);
+
+  std::vector<std::size_t> patrol_count(n_robots, 0);
+  const auto dispatch_patrol = [&](std::size_t robot)
+    {
+      nlohmann::json request;
+      request["category"] = "patrol";
+      auto& description = request["description"];
+      description["places"] = {top(robot), bottom(robot)};
+      description["rounds"] = rounds;
+      adapter.dispatch_task(
+        "patrol_" + std::to_string(robot) + "_"
+        + std::to_string(patrol_count[robot]++),
+        request);
+    };
+
+  for (std::size_t i = 0; i < n_robots; ++i)
+    dispatch_patrol(i);
+
+  auto& worker =
+    rmf_fleet_adapter::agv::FleetUpdateHandle::Implementation::get(*fleet)
+    .worker;
+  const auto lag = std::make_shared<LagProbe>();
+
+  std::cout << "time_s,robots,completed_patrols,cpu_percent_per_robot,"
+            << "worker_lag_avg_ms,worker_lag_max_ms,rss_mb,rss_growth_mb"
+            << std::endl;
+
+  const auto start = std::chrono::steady_clock::now();
+  const double start_rss = resident_megabytes();
+  auto last_report = start;
+  double last_cpu = cpu_seconds();
+  while (std::chrono::steady_clock::now() - start < duration)
+  {
+    std::this_thread::sleep_for(100ms);
+    lag->sample(worker);
+
+    std::vector<std::size_t> ready;
+    {
+      std::lock_guard<std::mutex> lock(finished_mutex);
+      ready.swap(finished);
+    }
+
+    for (const auto robot : ready)
+    {
+      if (robot < n_robots)
+        dispatch_patrol(robot);
+    }
+
+    const auto time = std::chrono::steady_clock::now();
+    if (time - last_report < period)
+      continue;
+
+    const double cpu = cpu_seconds();
+    const double wall =
+      std::chrono::duration<double>(time - last_report).count();
+    const auto [lag_avg, lag_max] = lag->report();
+    const double rss = resident_megabytes();
+    std::cout << std::fixed << std::setprecision(2)
+              << std::chrono::duration<double>(time - start).count() << ","
+              << n_robots << ","
+              << completed_patrols.load() << ","
+              << 100.0 * (cpu - last_cpu) / wall / n_robots << ","
+              << lag_avg << ","
+              << lag_max << ","
+              << rss << ","
+              << rss - start_rss << std::endl;
+
+    last_report = time;
+    last_cpu = cpu;
+  }
+
+  adapter.stop();
+  ws_server->stop();
+  return 0;
+}
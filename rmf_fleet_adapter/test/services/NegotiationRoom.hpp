@@ -0,0 +1,870 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef TEST__SERVICES__NEGOTIATIONROOM_HPP
+#define TEST__SERVICES__NEGOTIATIONROOM_HPP
+
+#include <services/Negotiate.hpp>
+
+#include <rmf_traffic/geometry/Circle.hpp>
+#include <rmf_traffic/schedule/Database.hpp>
+#include <rmf_traffic/DetectConflict.hpp>
+
+#include <cassert>
+#include <future>
+#include <iostream>
+#include <unordered_set>
+
+// These helpers let a set of negotiators settle a traffic conflict among
+// themselves without a schedule node. They are shared by the negotiation tests
+// and the service benchmarks.
+namespace rmf_fleet_adapter_test {
+
+// Helper Definitions
+//==============================================================================
+using VertexId = std::string;
+using IsHoldingSpot = bool;
+using VertexMap = std::unordered_map<VertexId, std::pair<Eigen::Vector2d,
+    IsHoldingSpot>>;
+
+using EdgeId = std::string;
+using EdgeVertices = std::pair<VertexId, VertexId>;
+using IsBidirectional = bool;
+using EdgeMap = std::unordered_map<EdgeId, std::pair<EdgeVertices,
+    IsBidirectional>>;
+
+using VertexIdtoIdxMap = std::unordered_map<VertexId, size_t>;
+
+using ParticipantName = std::string;
+using ParticipantIndex = size_t;
+
+struct ParticipantConfig
+{
+  const rmf_traffic::Profile profile;
+  const rmf_traffic::agv::VehicleTraits traits;
+  const rmf_traffic::schedule::ParticipantDescription description;
+};
+
+// Helper Functions
+//==============================================================================
+// Makes graph using text ids, and returns bookkeeping that maps ids to indices
+// TODO(BH): Perhaps some sort of book keeping can be introduced in Graph itself?
+inline std::pair<rmf_traffic::agv::Graph, VertexIdtoIdxMap>
+generate_test_graph_data(std::string map_name, VertexMap vertices,
+  EdgeMap edges)
+{
+  rmf_traffic::agv::Graph graph;
+  // Maps vertex id to its corresponding id in the rmf_traffic::agv::Graph
+  VertexIdtoIdxMap vertex_id_to_idx;
+  size_t current_idx = 0; // vertex idxes are added in monotonic increments
+
+  for (auto it = vertices.cbegin(); it != vertices.cend(); it++)
+  {
+    // Adding to rmf_traffic::agv::Graph
+    graph.add_waypoint(map_name, it->second.first)
+    .set_holding_point(it->second.second);
+
+    // Book keeping
+    vertex_id_to_idx.insert({it->first, current_idx});
+    current_idx++;
+  }
+
+  for (auto it = edges.cbegin(); it != edges.cend(); it++)
+  {
+    auto source_vtx = vertex_id_to_idx[it->second.first.first];
+    auto sink_vtx = vertex_id_to_idx[it->second.first.second];
+    graph.add_lane(source_vtx, sink_vtx);
+    if (it->second.second)
+    {
+      graph.add_lane(sink_vtx, source_vtx);
+    }
+  }
+  return std::pair<rmf_traffic::agv::Graph, VertexIdtoIdxMap>(graph,
+      vertex_id_to_idx);
+}
+
+//==============================================================================
+inline rmf_utils::optional<rmf_traffic::schedule::Itinerary>
+get_participant_itinerary(
+  rmf_traffic::schedule::Negotiation::Proposal proposal,
+  rmf_traffic::schedule::ParticipantId participant_id)
+{
+  for (auto submission : proposal)
+  {
+    if (submission.participant == participant_id)
+    {
+      return submission.itinerary;
+    }
+  }
+  return rmf_utils::nullopt;
+}
+
+//==============================================================================
+inline bool no_conflicts(
+  const rmf_traffic::Profile& p0,
+  const rmf_traffic::schedule::Itinerary& i0,
+  const rmf_traffic::Profile& p1,
+  const rmf_traffic::schedule::Itinerary& i1)
+{
+  for (const auto& r0 : i0)
+  {
+    for (const auto& r1 : i1)
+    {
+      if (r0.map() != r1.map())
+        continue;
+
+      if (rmf_traffic::DetectConflict::between(
+          p0, r0.trajectory(), nullptr,
+          p1, r1.trajectory(), nullptr))
+        return false;
+    }
+  }
+
+  return true;
+}
+
+//==============================================================================
+inline bool no_conflicts(
+  const rmf_traffic::schedule::Participant& p0,
+  const rmf_traffic::schedule::Itinerary& i0,
+  const rmf_traffic::schedule::Participant& p1,
+  const rmf_traffic::schedule::Itinerary& i1)
+{
+  return no_conflicts(
+    p0.description().profile(), i0,
+    p1.description().profile(), i1);
+}
+
+//==============================================================================
+inline rmf_traffic::Time print_start(const rmf_traffic::Route& route)
+{
+  assert(route.trajectory().size() > 0);
+  std::cout << "(start) --> ";
+  std::cout << "(" << 0.0 << "; "
+            << route.trajectory().front().position().transpose()
+            << ") --> ";
+
+  return *route.trajectory().start_time();
+}
+
+//==============================================================================
+inline void print_route(
+  const rmf_traffic::Route& route,
+  const rmf_traffic::Time start_time)
+{
+  assert(route.trajectory().size() > 0);
+  for (auto it = ++route.trajectory().begin(); it
+    != route.trajectory().end(); ++it)
+  {
+    const auto& wp = *it;
+    if (wp.velocity().norm() > 1e-3)
+      continue;
+
+    const auto rel_time = wp.time() - start_time;
+    std::cout << "(" << rmf_traffic::time::to_seconds(rel_time) << "; "
+              << wp.position().transpose() << ") --> ";
+  }
+}
+
+//==============================================================================
+inline void print_itinerary(const std::vector<rmf_traffic::Route>& itinerary)
+{
+  if (itinerary.empty())
+  {
+    std::cout << "No plan needed!" << std::endl;
+  }
+  else
+  {
+    auto start_time = print_start(itinerary.front());
+    for (const auto& r : itinerary)
+      print_route(r, start_time);
+
+    std::cout << "(end)" << std::endl;
+  }
+}
+
+// Preset Robot Configurations
+// Agent a(i) generates participant p(i), instantiated in tests
+//==============================================================================
+// a0
+const rmf_traffic::Profile a0_profile{
+  rmf_traffic::geometry::make_final_convex<
+    rmf_traffic::geometry::Circle>(1.0)
+};
+
+const rmf_traffic::agv::VehicleTraits a0_traits{
+  {0.7, 0.3},
+  {1.0, 0.45},
+  a0_profile
+};
+
+const rmf_traffic::schedule::ParticipantDescription a0_description = {
+  "p0",
+  "test_Negotiator",
+  rmf_traffic::schedule::ParticipantDescription::Rx::Responsive,
+  a0_profile
+};
+
+const ParticipantConfig a0_config = {
+  a0_profile, a0_traits, a0_description
+};
+
+// a1
+const rmf_traffic::Profile a1_profile{
+  rmf_traffic::geometry::make_final_convex<
+    rmf_traffic::geometry::Circle>(1.0)
+};
+
+const rmf_traffic::agv::VehicleTraits a1_traits{
+  {0.7, 0.3},
+  {1.0, 0.45},
+  a1_profile
+};
+
+const rmf_traffic::schedule::ParticipantDescription a1_description = {
+  "p1",
+  "test_Negotiator",
+  rmf_traffic::schedule::ParticipantDescription::Rx::Responsive,
+  a1_profile
+};
+
+const ParticipantConfig a1_config = {
+  a1_profile, a1_traits, a1_description
+};
+
+// a2 - A slower version of a0 / a1
+const rmf_traffic::Profile a2_profile{
+  rmf_traffic::geometry::make_final_convex<
+    rmf_traffic::geometry::Circle>(1.0)
+};
+
+const rmf_traffic::agv::VehicleTraits a2_traits{
+  {0.3, 0.1},
+  {0.5, 0.2},
+  a2_profile
+};
+
+const rmf_traffic::schedule::ParticipantDescription a2_description = {
+  "p2",
+  "test_Negotiator",
+  rmf_traffic::schedule::ParticipantDescription::Rx::Responsive,
+  a2_profile
+};
+
+const ParticipantConfig a2_config = {
+  a2_profile, a2_traits, a2_description
+};
+
+//==============================================================================
+template<typename TableViewPtr>
+std::string to_string(const TableViewPtr& table)
+{
+  std::string out = "[";
+  for (const auto& p : table->sequence())
+  {
+    out += " " + std::to_string(p.participant)
+      + ":" + std::to_string(p.version);
+  }
+  out += " ]";
+
+  return out;
+}
+
+//==============================================================================
+class TestPathNegotiator
+  : public rmf_traffic::schedule::Negotiator,
+  public std::enable_shared_from_this<TestPathNegotiator>
+{
+public:
+
+  struct Intention
+  {
+    std::vector<rmf_traffic::agv::Planner::Start> start;
+    rmf_traffic::agv::Planner::Goal goal;
+    std::shared_ptr<rmf_traffic::agv::Planner> planner;
+
+    Intention(
+      std::vector<rmf_traffic::agv::Planner::Start> starts_,
+      rmf_traffic::agv::Planner::Goal goal_,
+      std::shared_ptr<rmf_traffic::agv::Planner> planner_)
+    : start(std::move(starts_)),
+      goal(std::move(goal_)),
+      planner(std::move(planner_))
+    {
+      // Do nothing
+    }
+
+    Intention(
+      rmf_traffic::agv::Planner::Start start_,
+      rmf_traffic::agv::Planner::Goal goal_,
+      std::shared_ptr<rmf_traffic::agv::Planner> planner_)
+    : start({std::move(start_)}),
+      goal(std::move(goal_)),
+      planner(std::move(planner_))
+    {
+      // Do nothing
+    }
+  };
+
+  using ParticipantId = rmf_traffic::schedule::ParticipantId;
+  using Intentions = std::unordered_map<ParticipantId, Intention>;
+
+  TestPathNegotiator(
+    std::shared_ptr<rmf_traffic::agv::Planner> planner,
+    rmf_traffic::agv::Plan::StartSet starts,
+    rmf_traffic::agv::Plan::Goal goal)
+  : _planner(std::move(planner)),
+    _starts(std::move(starts)),
+    _goal(std::move(goal))
+  {
+    // Do nothing
+  }
+
+  TestPathNegotiator& print(bool on)
+  {
+    _print = on;
+    return *this;
+  }
+
+  TestPathNegotiator& n(
+    std::shared_ptr<rmf_traffic::schedule::Negotiation> negotiation)
+  {
+    _n = std::move(negotiation);
+    return *this;
+  }
+
+  TestPathNegotiator& w(const rxcpp::schedulers::worker& worker)
+  {
+    _worker = worker;
+    return *this;
+  }
+
+  void respond(
+    const TableViewerPtr& table_viewer,
+    const ResponderPtr& responder) final
+  {
+    if (_print)
+    {
+      std::cout << "    Responding to " << to_string(table_viewer)
+                << " (" << _n.lock().get() << ")" << std::endl;
+    }
+
+    rmf_fleet_adapter::services::ProgressEvaluator evaluator;
+    if (table_viewer->parent_id())
+    {
+      const auto& s = table_viewer->sequence();
+      assert(s.size() >= 2);
+      evaluator.compliant_leeway_base *= s[s.size()-2].version + 1;
+    }
+
+    auto negotiate = rmf_fleet_adapter::services::Negotiate::path(
+      0, _planner, _starts, _goal, {}, table_viewer, responder, nullptr,
+      evaluator);
+
+    auto sub = rmf_rxcpp::make_job<
+      rmf_fleet_adapter::services::Negotiate::Result>(negotiate)
+      .observe_on(rxcpp::identity_same_worker(_worker))
+      .subscribe([w = weak_from_this()](const auto& result)
+        {
+          result.respond();
+          if (const auto self = w.lock())
+            self->_services.erase(result.service);
+        });
+
+    _subscriptions.emplace_back(std::move(sub));
+    _services.insert(std::move(negotiate));
+  }
+
+private:
+  std::shared_ptr<rmf_traffic::agv::Planner> _planner;
+  rmf_traffic::agv::Plan::StartSet _starts;
+  rmf_traffic::agv::Plan::Goal _goal;
+  std::vector<rmf_rxcpp::subscription_guard> _subscriptions;
+  std::unordered_set<std::shared_ptr<rmf_fleet_adapter::services::Negotiate>>
+  _services;
+  bool _print = false;
+  std::weak_ptr<rmf_traffic::schedule::Negotiation> _n;
+  rxcpp::schedulers::worker _worker;
+};
+
+//==============================================================================
+inline std::unordered_map<
+  rmf_traffic::schedule::ParticipantId,
+  std::shared_ptr<TestPathNegotiator>
+>
+make_negotiators(const TestPathNegotiator::Intentions& intentions)
+{
+  std::unordered_map<
+    rmf_traffic::schedule::ParticipantId,
+    std::shared_ptr<TestPathNegotiator>
+  > negotiators;
+
+  for (const auto& entry : intentions)
+  {
+    const auto participant = entry.first;
+    const auto& intention = entry.second;
+    negotiators.insert(
+      std::make_pair(
+        participant,
+        std::make_shared<TestPathNegotiator>(
+          intention.planner, intention.start, intention.goal)));
+  }
+
+  return negotiators;
+}
+
+//==============================================================================
+class TestEmergencyNegotiator
+  : public rmf_traffic::schedule::Negotiator,
+  public std::enable_shared_from_this<TestEmergencyNegotiator>
+{
+public:
+
+  struct Intention
+  {
+    std::vector<rmf_traffic::agv::Planner::Start> start;
+    std::shared_ptr<rmf_traffic::agv::Planner> planner;
+
+    Intention(
+      std::vector<rmf_traffic::agv::Planner::Start> starts_,
+      std::shared_ptr<rmf_traffic::agv::Planner> planner_)
+    : start(std::move(starts_)),
+      planner(std::move(planner_))
+    {
+      // Do nothing
+    }
+
+    Intention(
+      rmf_traffic::agv::Planner::Start start_,
+      std::shared_ptr<rmf_traffic::agv::Planner> planner_)
+    : start({std::move(start_)}),
+      planner(std::move(planner_))
+    {
+      // Do nothing
+    }
+  };
+
+  using ParticipantId = rmf_traffic::schedule::ParticipantId;
+  using Intentions = std::unordered_map<ParticipantId, Intention>;
+
+  TestEmergencyNegotiator(
+    std::shared_ptr<rmf_traffic::agv::Planner> planner,
+    rmf_traffic::agv::Plan::StartSet starts)
+  : _planner(std::move(planner)),
+    _starts(std::move(starts))
+  {
+    // Do nothing
+  }
+
+  TestEmergencyNegotiator& print(bool on)
+  {
+    _print = on;
+    return *this;
+  }
+
+  TestEmergencyNegotiator& n(
+    std::shared_ptr<rmf_traffic::schedule::Negotiation> negotiation)
+  {
+    _n = std::move(negotiation);
+    return *this;
+  }
+
+  TestEmergencyNegotiator& w(const rxcpp::schedulers::worker& worker)
+  {
+    _worker = worker;
+    return *this;
+  }
+
+  void respond(
+    const TableViewerPtr& table_viewer,
+    const ResponderPtr& responder) final
+  {
+    if (_print)
+    {
+      std::cout << "    Responding to " << to_string(table_viewer)
+                << " (" << _n.lock().get() << ")" << std::endl;
+    }
+
+    rmf_fleet_adapter::services::ProgressEvaluator evaluator;
+    if (table_viewer->parent_id())
+    {
+      const auto& s = table_viewer->sequence();
+      assert(s.size() >= 2);
+      evaluator.compliant_leeway_base *= s[s.size()-2].version + 1;
+    }
+
+    auto negotiate = rmf_fleet_adapter::services::Negotiate::emergency_pullover(
+      0, _planner, _starts, table_viewer, responder, nullptr, evaluator);
+
+    auto sub = rmf_rxcpp::make_job<
+      rmf_fleet_adapter::services::Negotiate::Result>(std::move(negotiate))
+      .observe_on(rxcpp::identity_same_worker(_worker))
+      .subscribe([w = weak_from_this()](const auto& result)
+        {
+          result.respond();
+          if (const auto self = w.lock())
+            self->_services.erase(result.service);
+        });
+
+    _subscriptions.emplace_back(std::move(sub));
+    _services.insert(std::move(negotiate));
+  }
+
+private:
+  std::shared_ptr<rmf_traffic::agv::Planner> _planner;
+  rmf_traffic::agv::Plan::StartSet _starts;
+  std::vector<rmf_rxcpp::subscription_guard> _subscriptions;
+  std::unordered_set<std::shared_ptr<rmf_fleet_adapter::services::Negotiate>>
+  _services;
+  bool _print = false;
+  std::weak_ptr<rmf_traffic::schedule::Negotiation> _n;
+  rxcpp::schedulers::worker _worker;
+};
+
+//==============================================================================
+inline std::unordered_map<
+  rmf_traffic::schedule::ParticipantId,
+  std::shared_ptr<TestEmergencyNegotiator>
+>
+make_negotiators(const TestEmergencyNegotiator::Intentions& intentions)
+{
+  std::unordered_map<
+    rmf_traffic::schedule::ParticipantId,
+    std::shared_ptr<TestEmergencyNegotiator>
+  > negotiators;
+
+  for (const auto& entry : intentions)
+  {
+    const auto participant = entry.first;
+    const auto& intention = entry.second;
+    negotiators.insert(
+      {
+        participant,
+        std::make_shared<TestEmergencyNegotiator>(
+          intention.planner, intention.start)
+      });
+  }
+
+  return negotiators;
+}
+
+//==============================================================================
+template<typename NegotiatorT>
+class NegotiationRoom
+  : public std::enable_shared_from_this<NegotiationRoom<NegotiatorT>>
+{
+public:
+
+  using ParticipantId = rmf_traffic::schedule::ParticipantId;
+  using Negotiator = NegotiatorT;
+  using Negotiation = rmf_traffic::schedule::Negotiation;
+
+  class Responder : public rmf_traffic::schedule::Negotiator::Responder
+  {
+  public:
+    Responder(
+      std::shared_ptr<NegotiationRoom<Negotiator>> room,
+      rmf_traffic::schedule::Negotiation::TablePtr table)
+    : _room(std::move(room)),
+      _table(std::move(table))
+    {
+      // Do nothing
+    }
+
+    template<typename... Args>
+    static std::shared_ptr<Responder> make(Args&&... args)
+    {
+      return std::make_shared<Responder>(std::forward<Args>(args)...);
+    }
+
+    void submit(
+      rmf_traffic::PlanId plan,
+      std::vector<rmf_traffic::Route> itinerary,
+      ApprovalCallback approval_callback = nullptr) const final
+    {
+      const auto room = _room.lock();
+      if (!room)
+        return;
+
+      if (!_table->ongoing())
+      {
+        if (room->_print)
+        {
+          std::cout << "Deprecated negotiation (" << room->negotiation.get()
+                    << "): " << to_string(_table);
+        }
+
+        return;
+      }
+
+      if (_table->defunct())
+      {
+        if (room->_print)
+        {
+          std::cout << "Defunct " << to_string(_table) << " ("
+                    << room->negotiation.get() << "): " << to_string(_table)
+                    << std::endl;
+        }
+
+        return;
+      }
+
+      rmf_traffic::schedule::SimpleResponder(_table)
+      .submit(plan, std::move(itinerary), std::move(approval_callback));
+
+      if (room->_print)
+      {
+        std::cout << "Submission given for " + to_string(_table)
+                  << " (" << room->negotiation.get() << "):\n";
+        print_itinerary(*_table->submission());
+      }
+
+      if (room->check_finished())
+        return;
+
+      for (const auto& n : room->negotiators)
+      {
+        const auto participant = n.first;
+        const auto respond_to = _table->respond(participant);
+        if (respond_to)
+        {
+          if (skip(respond_to))
+          {
+            if (room->_print)
+            {
+              std::cout << "    Skipping a response request from "
+                        << to_string(respond_to) << std::endl;
+            }
+
+            respond_to->forfeit(respond_to->version());
+            continue;
+          }
+
+          n.second->print(room->_print).n(room->negotiation).w(room->worker)
+          .respond(respond_to->viewer(), make(room, respond_to));
+        }
+      }
+    }
+
+    void reject(const Alternatives& alternatives) const final
+    {
+      const auto room = _room.lock();
+      if (!room)
+        return;
+
+      if (_table->defunct())
+        return;
+
+      rmf_traffic::schedule::SimpleResponder(_table).reject(alternatives);
+
+      if (room->check_finished())
+        return;
+
+      const auto parent = _table->parent();
+      if (parent)
+      {
+        if (room->_print)
+        {
+          std::cout << "[ "<< std::to_string(_table->participant())
+                    << " ] rejected " << to_string(parent) << " ("
+                    << room->negotiation.get() << ") with ["
+                    << alternatives.size() << "] alternatives" << std::endl;
+        }
+
+        if (skip(parent))
+        {
+          std::cout << "Forfeit given for " << to_string(parent)
+                    << " after too many rejections";
+          parent->forfeit(parent->version());
+          room->check_finished();
+          return;
+        }
+
+        room->negotiators.at(parent->participant())
+        ->print(room->_print).n(room->negotiation).w(room->worker)
+        .respond(parent->viewer(), make(room, parent));
+      }
+    }
+
+    void forfeit(const std::vector<ParticipantId>& blockers) const final
+    {
+      const auto room = _room.lock();
+      if (!room)
+        return;
+
+      if (_table->defunct())
+        return;
+
+      rmf_traffic::schedule::SimpleResponder(_table).forfeit(blockers);
+
+      if (room->_print)
+      {
+        std::cout << "Forfeit given for " << to_string(_table)
+                  << " with the following blockers:";
+        for (const auto p : blockers)
+          std::cout << " " << p << std::endl;
+      }
+
+      room->check_finished();
+    }
+
+  private:
+    std::weak_ptr<NegotiationRoom> _room;
+    rmf_traffic::schedule::Negotiation::TablePtr _table;
+  };
+
+  using Intention = typename Negotiator::Intention;
+  using Intentions = typename Negotiator::Intentions;
+
+  NegotiationRoom(
+    std::shared_ptr<const rmf_traffic::schedule::Viewer> viewer,
+    Intentions intentions,
+    const bool print = false)
+  : negotiators(make_negotiators(intentions)),
+    negotiation(Negotiation::make_shared(
+        std::move(viewer), get_participants(intentions))),
+    worker(rxcpp::schedulers::make_event_loop().create_worker()),
+    _print(print)
+  {
+    // Do nothing
+  }
+
+  static bool skip(const Negotiation::TablePtr& table)
+  {
+    if (table->submission() && !table->rejected())
+      return true;
+
+    // Give up we have already attempted more than 2 submissions
+    if (table->version() > 2)
+      return true;
+
+    auto ancestor = table->parent();
+    while (ancestor)
+    {
+      if (ancestor->rejected() || ancestor->forfeited())
+        return true;
+
+      ancestor = ancestor->parent();
+    }
+
+    return false;
+  }
+
+  using Proposal = rmf_traffic::schedule::Negotiation::Proposal;
+  using OptProposal = rmf_utils::optional<Proposal>;
+
+  std::future<OptProposal> solve()
+  {
+    if (_print)
+    {
+      std::cout << "Beginning negotiation for ("
+                << negotiation.get() << ")" <<std::endl;
+    }
+
+    for (const auto& n : negotiators)
+    {
+      const auto participant = n.first;
+      const auto table = negotiation->table(participant, {});
+      if (!table)
+        continue;
+
+      const auto& negotiator = n.second;
+      negotiator->print(_print).n(negotiation).w(worker).respond(
+        table->viewer(),
+        Responder::make(this->shared_from_this(), table));
+    }
+
+    return _solution.get_future();
+  }
+
+  static std::vector<ParticipantId> get_participants(
+    const std::unordered_map<ParticipantId, Intention>& intentions)
+  {
+    std::vector<ParticipantId> participants;
+    participants.reserve(intentions.size());
+    for (const auto& entry : intentions)
+      participants.push_back(entry.first);
+
+    return participants;
+  }
+
+  bool check_finished()
+  {
+    if (!negotiation)
+      return true;
+
+    if (!negotiation->ready() && !negotiation->complete())
+      return false;
+
+    if (negotiation->ready())
+    {
+      const auto winner = negotiation->evaluate(
+        rmf_traffic::schedule::QuickestFinishEvaluator());
+
+      if (_print)
+      {
+        std::cout << "Successfully finished negotiation ("
+                  << negotiation.get() << ") with " << to_string(winner)
+                  << std::endl;
+      }
+
+      if (!_promise_fulfilled)
+      {
+        _promise_fulfilled = true;
+        _solution.set_value(winner->proposal());
+      }
+    }
+    else
+    {
+      std::cout << "Failed finish for negotiation (" << negotiation.get()
+                << ")" << std::endl;
+
+      if (!_promise_fulfilled)
+      {
+        _promise_fulfilled = true;
+        _solution.set_value(rmf_utils::nullopt);
+      }
+    }
+
+    negotiation.reset();
+    return true;
+  }
+
+  std::unordered_map<ParticipantId, std::shared_ptr<Negotiator>> negotiators;
+  std::shared_ptr<rmf_traffic::schedule::Negotiation> negotiation;
+  rxcpp::schedulers::worker worker;
+
+  std::promise<OptProposal> _solution;
+  bool _promise_fulfilled = false;
+
+
+  NegotiationRoom& print()
+  {
+    _print = true;
+    return *this;
+  }
+
+  bool _print = false;
+};
+
+using TestPathNegotiationRoom = NegotiationRoom<TestPathNegotiator>;
+using TestEmergencyNegotiationRoom = NegotiationRoom<TestEmergencyNegotiator>;
+
+
+} // namespace rmf_fleet_adapter_test
+
+#endif // TEST__SERVICES__NEGOTIATIONROOM_HPP
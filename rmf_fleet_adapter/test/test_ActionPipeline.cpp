@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <ActionPipeline.hpp>
+
+using rmf_fleet_adapter::ActionPipeline;
+
+namespace {
+//==============================================================================
+ActionPipeline::Action make_action(
+  const std::string& category,
+  std::size_t waypoint,
+  rmf_traffic::Time start_time)
+{
+  return ActionPipeline::Action{
+    category,
+    nlohmann::json{{"name", category}},
+    std::chrono::seconds(10),
+    waypoint,
+    start_time
+  };
+}
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("Back-to-back actions are prepared together")
+{
+  const auto pipeline = ActionPipeline::make();
+  const auto t0 = rmf_traffic::Time(std::chrono::seconds(100));
+  const auto scan = pipeline->prepare(make_action("scan", 3, t0));
+  const auto beep = pipeline->prepare(
+    make_action("beep", 3, t0 + std::chrono::seconds(10)));
+  auto lift = pipeline->prepare(
+    make_action("lift_tote", 3, t0 + std::chrono::seconds(21)));
+
+  // This action happens after the robot has moved somewhere else
+  const auto drop = pipeline->prepare(
+    make_action("drop_tote", 5, t0 + std::chrono::seconds(60)));
+  CHECK(pipeline->size() == 4);
+
+  const auto next = pipeline->next(*scan);
+  REQUIRE(next.has_value());
+  CHECK(next->category == "beep");
+  CHECK(next->description["name"] == "beep");
+  CHECK(pipeline->following_duration(*scan) == std::chrono::seconds(20));
+  CHECK(pipeline->following_duration(*lift) == rmf_traffic::Duration(0));
+  CHECK_FALSE(pipeline->next(*lift).has_value());
+  CHECK_FALSE(pipeline->next(*drop).has_value());
+
+  // Starting an action drops the actions that were prepared before it
+  pipeline->start(*beep);
+  CHECK(pipeline->size() == 3);
+  CHECK_FALSE(pipeline->next(*scan).has_value());
+  CHECK(pipeline->next(*beep)->category == "lift_tote");
+
+  // Releasing a ticket withdraws its action
+  const std::weak_ptr<ActionPipeline::Ticket> weak_lift = lift;
+  lift.reset();
+  CHECK(weak_lift.expired());
+  CHECK(pipeline->size() == 2);
+  CHECK_FALSE(pipeline->next(*beep).has_value());
+}
+
+//==============================================================================
+SCENARIO("A hold covers the actions that it was made for")
+{
+  const auto pipeline = ActionPipeline::make();
+  const auto t0 = rmf_traffic::Time(std::chrono::seconds(100));
+  const Eigen::Vector3d p(1.0, 2.0, 0.0);
+  CHECK_FALSE(pipeline->hold_covers(7, "L1", p, t0));
+
+  pipeline->hold(7, "L1", p, t0 + std::chrono::seconds(30));
+  CHECK(pipeline->hold_covers(7, "L1", p, t0 + std::chrono::seconds(30)));
+  CHECK(pipeline->hold_covers(
+      7, "L1", p + Eigen::Vector3d(0.05, 0.0, 0.0), t0));
+
+  // The hold was replaced by another plan
+  CHECK_FALSE(pipeline->hold_covers(8, "L1", p, t0));
+
+  // The action would last longer than the hold
+  CHECK_FALSE(
+    pipeline->hold_covers(7, "L1", p, t0 + std::chrono::seconds(31)));
+
+  // The robot is somewhere else
+  CHECK_FALSE(pipeline->hold_covers(7, "L2", p, t0));
+  CHECK_FALSE(
+    pipeline->hold_covers(7, "L1", p + Eigen::Vector3d(1.0, 0.0, 0.0), t0));
+}
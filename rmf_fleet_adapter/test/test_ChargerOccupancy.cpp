@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <ChargerOccupancy.hpp>
+
+using rmf_fleet_adapter::ChargerOccupancy;
+
+//==============================================================================
+SCENARIO("Charger occupancy follows the assignments of robots")
+{
+  const auto occupancy = ChargerOccupancy::make();
+  CHECK(occupancy->assigned(3) == 0);
+  CHECK_FALSE(occupancy->charger_of("a").has_value());
+
+  occupancy->assign("a", 3);
+  occupancy->assign("b", 3);
+  CHECK(occupancy->assigned(3) == 2);
+  CHECK(occupancy->charger_of("a") == std::optional<std::size_t>(3));
+
+  // Assigning the same charger again changes nothing
+  occupancy->assign("a", 3);
+  CHECK(occupancy->assigned(3) == 2);
+
+  occupancy->assign("a", 5);
+  CHECK(occupancy->assigned(3) == 1);
+  CHECK(occupancy->assigned(5) == 1);
+
+  // Two robots swapping chargers
+  occupancy->assign("a", 3);
+  occupancy->assign("b", 5);
+  CHECK(occupancy->assigned(3) == 1);
+  CHECK(occupancy->assigned(5) == 1);
+  CHECK(occupancy->charger_of("b") == std::optional<std::size_t>(5));
+}
+
+//==============================================================================
+SCENARIO("Retreat estimates belong to one planner")
+{
+  const auto occupancy = ChargerOccupancy::make();
+  const auto planner_a = std::make_shared<int>(0);
+  const auto planner_b = std::make_shared<int>(0);
+
+  CHECK_FALSE(occupancy->retreat_drain(planner_a, 1, 3).has_value());
+
+  occupancy->record_retreat_drain(planner_a, 1, 3, 0.1);
+  occupancy->record_retreat_drain(planner_a, 2, 3, 0.2);
+  CHECK(occupancy->retreat_drain(planner_a, 1, 3) == std::optional<double>(0.1));
+  CHECK(occupancy->retreat_drain(planner_a, 2, 3) == std::optional<double>(0.2));
+  CHECK_FALSE(occupancy->retreat_drain(planner_a, 3, 1).has_value());
+  CHECK_FALSE(occupancy->retreat_drain(planner_b, 1, 3).has_value());
+
+  // Recording an estimate of a new planner forgets the old estimates
+  occupancy->record_retreat_drain(planner_b, 2, 3, 0.25);
+  CHECK(occupancy->retreat_drain(planner_b, 2, 3) == std::optional<double>(0.25));
+  CHECK_FALSE(occupancy->retreat_drain(planner_b, 1, 3).has_value());
+  CHECK_FALSE(occupancy->retreat_drain(planner_a, 1, 3).has_value());
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <ChargingSchedule.hpp>
+
+#include <algorithm>
+
+using namespace std::chrono_literals;
+using rmf_fleet_adapter::ChargingSchedule;
+
+namespace {
+//==============================================================================
+rmf_traffic::Time at(int hour, int minute, int day = 0)
+{
+  return rmf_traffic::Time(
+    std::chrono::hours(24*day + hour) + std::chrono::minutes(minute));
+}
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("Charging schedule follows the rotation of a fleet")
+{
+  const auto yaml = YAML::Load(
+    "my_fleet:\n"
+    "  \"02:00\": { robot_1: charger_B, robot_2: queue_A }\n"
+    "  \"00:00\": { robot_1: charger_A, robot_2: charger_B }\n"
+    "  \"01:55\": { robot_1: queue_A }\n"
+    "other_fleet:\n"
+    "  \"00:00\": { robot_3: charger_C }\n"
+    "parking: [queue_A]\n");
+
+  const auto schedule = ChargingSchedule::make(yaml, "my_fleet", true);
+
+  auto robots = schedule->robots();
+  std::sort(robots.begin(), robots.end());
+  CHECK(robots == std::vector<std::string>({"robot_1", "robot_2"}));
+  CHECK(schedule->at("robot_3", at(0, 0)) == nullptr);
+
+  const auto* a = schedule->at("robot_1", at(0, 30));
+  REQUIRE(a);
+  CHECK(a->waypoint == "charger_A");
+  CHECK_FALSE(a->wait);
+
+  a = schedule->at("robot_1", at(1, 55));
+  REQUIRE(a);
+  CHECK(a->waypoint == "queue_A");
+  CHECK(a->wait);
+
+  a = schedule->at("robot_1", at(13, 0));
+  REQUIRE(a);
+  CHECK(a->waypoint == "charger_B");
+
+  // The schedule cycles every day
+  a = schedule->at("robot_2", at(1, 0, 3));
+  REQUIRE(a);
+  CHECK(a->waypoint == "charger_B");
+
+  CHECK(schedule->minute_of_day(at(23, 59, 2)) == 23*60 + 59);
+}
+
+//==============================================================================
+SCENARIO("Charging schedule wraps around to the previous day")
+{
+  const auto yaml = YAML::Load(
+    "my_fleet:\n"
+    "  \"06:00\": { robot_1: charger_A }\n"
+    "  \"18:00\": { robot_1: charger_B }\n");
+
+  const auto schedule = ChargingSchedule::make(yaml, "my_fleet", true);
+  const auto* a = schedule->at("robot_1", at(3, 0, 1));
+  REQUIRE(a);
+  CHECK(a->waypoint == "charger_B");
+}
+
+//==============================================================================
+SCENARIO("Malformed charging schedule times are rejected")
+{
+  for (const std::string time : {"24:00", "1200", "12:60", "ab:00", "12:"})
+  {
+    const auto yaml = YAML::Load(
+      "my_fleet:\n  \"" + time + "\": { robot_1: charger_A }\n");
+    CHECK_THROWS(ChargingSchedule::make(yaml, "my_fleet", true));
+  }
+}
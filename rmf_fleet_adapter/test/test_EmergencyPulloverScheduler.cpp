@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <EmergencyPulloverScheduler.hpp>
+
+using namespace std::chrono_literals;
+using rmf_fleet_adapter::EmergencyPulloverScheduler;
+using Hazard = EmergencyPulloverScheduler::Hazard;
+using Graph = rmf_traffic::agv::Graph;
+
+namespace {
+//==============================================================================
+// 0 -- 1 -- 2 -[door]- 3 -- 4, where 0 is a parking spot and 4 is a holding
+// point
+Graph make_graph()
+{
+  const std::string map = "test_map";
+  Graph graph;
+  for (std::size_t i = 0; i < 5; ++i)
+    graph.add_waypoint(map, {static_cast<double>(i), 0.0});
+
+  for (const std::size_t i : {0, 1, 3})
+  {
+    graph.add_lane(i, i+1);
+    graph.add_lane(i+1, i);
+  }
+
+  graph.add_lane(
+    {2, Graph::Lane::Event::make(Graph::Lane::DoorOpen("door", 4s))}, 3);
+  graph.add_lane(3, 2);
+
+  graph.get_waypoint(0).set_parking_spot(true);
+  graph.get_waypoint(4).set_holding_point(true);
+  return graph;
+}
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("Assess the hazard of robot locations")
+{
+  const auto graph = make_graph();
+  const auto now = std::chrono::steady_clock::now();
+
+  const auto at = [&](std::size_t wp)
+    {
+      rmf_traffic::agv::Plan::StartSet starts;
+      starts.emplace_back(now, wp, 0.0);
+      return starts;
+    };
+
+  CHECK(EmergencyPulloverScheduler::assess(graph, at(0)) == Hazard::Parked);
+  CHECK(EmergencyPulloverScheduler::assess(graph, at(1)) == Hazard::Waypoint);
+  CHECK(EmergencyPulloverScheduler::assess(graph, at(2)) == Hazard::Doorway);
+  CHECK(EmergencyPulloverScheduler::assess(graph, at(4)) == Hazard::Holding);
+
+  // A robot in the middle of the lane from 0 to 1
+  rmf_traffic::agv::Plan::StartSet on_lane;
+  on_lane.emplace_back(now, 1, 0.0, Eigen::Vector2d(0.5, 0.0), 0);
+  CHECK(EmergencyPulloverScheduler::assess(graph, on_lane) == Hazard::Lane);
+
+  // A robot on a waypoint also gets starts along the lanes that leave it, but
+  // those do not change its hazard
+  auto on_waypoint = at(0);
+  on_waypoint.emplace_back(now, 1, 0.0, Eigen::Vector2d(0.0, 0.0), 0);
+  CHECK(EmergencyPulloverScheduler::assess(graph, on_waypoint)
+    == Hazard::Parked);
+}
+
+//==============================================================================
+SCENARIO("Emergency pullover searches start in order of hazard")
+{
+  const auto worker = rxcpp::schedulers::make_event_loop().create_worker();
+  const auto scheduler = EmergencyPulloverScheduler::make(worker, 1);
+
+  std::mutex mutex;
+  std::vector<std::string> started;
+  std::vector<EmergencyPulloverScheduler::Ticket> tickets;
+
+  const auto start = [&](const std::string& name)
+    {
+      return [&, name](EmergencyPulloverScheduler::Ticket ticket)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          started.push_back(name);
+          tickets.push_back(std::move(ticket));
+        };
+    };
+
+  const auto wait_for = [&](std::size_t count)
+    {
+      const auto deadline = std::chrono::steady_clock::now() + 5s;
+      while (std::chrono::steady_clock::now() < deadline)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (started.size() >= count)
+          return;
+      }
+    };
+
+  const auto finish_oldest = [&]()
+    {
+      EmergencyPulloverScheduler::Ticket ticket;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        ticket = std::move(tickets.front());
+        tickets.erase(tickets.begin());
+      }
+      ticket.reset();
+    };
+
+  scheduler->submit(Hazard::Waypoint, start("first"));
+  scheduler->submit(Hazard::Parked, start("parked"));
+  scheduler->submit(Hazard::Lane, start("lane"));
+  scheduler->submit(Hazard::Doorway, start("doorway"));
+  scheduler->submit(Hazard::Lane, start("lane_2"));
+
+  CHECK(scheduler->running() == 1);
+  CHECK(scheduler->waiting() == 4);
+
+  for (std::size_t i = 2; i <= 5; ++i)
+  {
+    finish_oldest();
+    wait_for(i);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  CHECK(started == std::vector<std::string>(
+      {"first", "doorway", "lane", "lane_2", "parked"}));
+}
+
+//==============================================================================
+SCENARIO("Claimed parking spots are left out of later searches")
+{
+  auto graph = make_graph();
+  graph.get_waypoint(4).set_parking_spot(true);
+
+  const auto worker = rxcpp::schedulers::make_event_loop().create_worker();
+  const auto scheduler = EmergencyPulloverScheduler::make(worker, 1);
+
+  // Nothing is claimed yet, so every parking spot is still searched
+  CHECK_FALSE(scheduler->unclaimed(graph, std::nullopt, "a").has_value());
+
+  scheduler->claim("a", 0);
+  const auto for_b = scheduler->unclaimed(graph, std::nullopt, "b");
+  REQUIRE(for_b.has_value());
+  CHECK(*for_b == std::vector<std::size_t>({4}));
+
+  // A robot does not get excluded from its own claim
+  CHECK_FALSE(scheduler->unclaimed(graph, std::nullopt, "a").has_value());
+
+  // If every candidate is claimed, the candidates are searched anyway
+  const auto crowded =
+    scheduler->unclaimed(graph, std::vector<std::size_t>({0}), "b");
+  REQUIRE(crowded.has_value());
+  CHECK(*crowded == std::vector<std::size_t>({0}));
+
+  scheduler->release("a");
+  CHECK_FALSE(scheduler->unclaimed(graph, std::nullopt, "b").has_value());
+
+  scheduler->claim("a", 0);
+  scheduler->clear_claims();
+  CHECK_FALSE(scheduler->unclaimed(graph, std::nullopt, "b").has_value());
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <FloorPlanner.hpp>
+
+#include <rmf_traffic/geometry/Circle.hpp>
+
+using rmf_fleet_adapter::FloorPlanner;
+using Graph = rmf_traffic::agv::Graph;
+using Planner = rmf_traffic::agv::Planner;
+
+namespace {
+//==============================================================================
+// Three floors. Lift A stops at every floor and lift B goes straight from L1
+// to L3. Each floor is a row of waypoints with lift A at x=0 and lift B at x=2.
+Graph make_building()
+{
+  Graph graph;
+  graph.set_known_lift(Graph::LiftProperties(
+      "A", {0.0, 0.0}, 0.0, {1.0, 1.0}));
+  graph.set_known_lift(Graph::LiftProperties(
+      "B", {2.0, 0.0}, 0.0, {1.0, 1.0}));
+  const auto lift_a = graph.find_known_lift("A");
+  const auto lift_b = graph.find_known_lift("B");
+
+  std::vector<std::vector<std::size_t>> floors;
+  for (const auto& [map, width] :
+    std::vector<std::pair<std::string, std::size_t>>{
+      {"L1", 3}, {"L2", 2}, {"L3", 3}})
+  {
+    std::vector<std::size_t> wps;
+    for (std::size_t i = 0; i < width; ++i)
+    {
+      auto& wp = graph.add_waypoint(map, {static_cast<double>(i), 0.0});
+      if (i == 0)
+        wp.set_in_lift(lift_a);
+      else if (i == 2)
+        wp.set_in_lift(lift_b);
+
+      wps.push_back(wp.index());
+      if (i > 0)
+      {
+        graph.add_lane(wps[i-1], wps[i]);
+        graph.add_lane(wps[i], wps[i-1]);
+      }
+    }
+    floors.push_back(wps);
+  }
+
+  for (const auto& [from, to] :
+    std::vector<std::pair<std::size_t, std::size_t>>{
+      {floors[0][0], floors[1][0]},
+      {floors[1][0], floors[2][0]},
+      {floors[0][2], floors[2][2]}})
+  {
+    graph.add_lane(from, to);
+    graph.add_lane(to, from);
+  }
+
+  return graph;
+}
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("Floors and lifts are chosen by the expected time in lifts")
+{
+  const auto graph = make_building();
+  const auto floor_planner = FloorPlanner::make(2);
+
+  auto route = floor_planner->route(graph, "L1", "L3");
+  REQUIRE(route.has_value());
+  CHECK(route->floors == std::vector<std::string>({"L1", "L3"}));
+  CHECK(route->lifts == std::vector<std::string>({"B"}));
+
+  route = floor_planner->route(graph, "L2", "L2");
+  REQUIRE(route.has_value());
+  CHECK(route->floors == std::vector<std::string>({"L2"}));
+  CHECK(route->lifts.empty());
+
+  // Lift B is busy on the wrong floor, so lift A gets there sooner
+  FloorPlanner::LiftState state;
+  state.lift_name = "B";
+  state.current_floor = "L3";
+  state.session_id = "someone_else";
+  state.motion_state = FloorPlanner::LiftState::MOTION_STOPPED;
+  floor_planner->update_lift(state, rmf_traffic::Time());
+
+  route = floor_planner->route(graph, "L1", "L3");
+  REQUIRE(route.has_value());
+  CHECK(route->floors == std::vector<std::string>({"L1", "L3"}));
+  CHECK(route->lifts == std::vector<std::string>({"A"}));
+}
+
+//==============================================================================
+SCENARIO("Restricted planners only search the chosen floors and lifts")
+{
+  const auto shape = rmf_traffic::geometry::make_final_convex<
+    rmf_traffic::geometry::Circle>(0.2);
+  rmf_traffic::agv::VehicleTraits traits(
+    {1.0, 0.5}, {1.0, 0.5}, rmf_traffic::Profile(shape));
+  const auto planner = std::make_shared<const Planner>(
+    Planner::Configuration(make_building(), traits),
+    Planner::Options(nullptr));
+  const auto& graph = planner->get_configuration().graph();
+
+  const auto floor_planner = FloorPlanner::make(2);
+  const auto restricted = floor_planner->planner_for(planner, "L1", "L3");
+  REQUIRE(restricted != planner);
+  CHECK(floor_planner->size() == 1);
+  CHECK(floor_planner->planner_for(planner, "L1", "L3") == restricted);
+
+  const auto& closures = restricted->get_configuration().lane_closures();
+  for (std::size_t i = 0; i < graph.num_lanes(); ++i)
+  {
+    const auto& lane = graph.get_lane(i);
+    const auto& entry = graph.get_waypoint(lane.entry().waypoint_index());
+    const auto& exit = graph.get_waypoint(lane.exit().waypoint_index());
+    if (entry.get_map_name() == "L2" || exit.get_map_name() == "L2")
+      CHECK(closures.is_closed(i));
+    else if (entry.get_map_name() == exit.get_map_name())
+      CHECK(closures.is_open(i));
+  }
+
+  const auto now = rmf_traffic::Time();
+  const auto start = rmf_traffic::agv::Plan::Start(now, 1, 0.0);
+  const auto result = restricted->plan(
+    start, rmf_traffic::agv::Plan::Goal(7));
+  REQUIRE(result.success());
+
+  // Each floor pair gets its own planner, up to the limit
+  floor_planner->planner_for(planner, "L1", "L2");
+  floor_planner->planner_for(planner, "L2", "L3");
+  CHECK(floor_planner->size() == 2);
+
+  // A new fleet planner forgets the restricted planners
+  const auto replaced = std::make_shared<const Planner>(
+    planner->get_configuration(), Planner::Options(nullptr));
+  floor_planner->planner_for(replaced, "L1", "L3");
+  CHECK(floor_planner->size() == 1);
+}
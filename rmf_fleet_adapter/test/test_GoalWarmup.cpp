@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <GoalWarmup.hpp>
+
+#include <rmf_traffic/geometry/Circle.hpp>
+
+#include <thread>
+
+using rmf_fleet_adapter::GoalWarmup;
+using Planner = rmf_traffic::agv::Planner;
+
+//==============================================================================
+SCENARIO("Goals are warmed up in order of recent use")
+{
+  const std::string map = "test_map";
+  rmf_traffic::agv::Graph graph;
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    graph.add_waypoint(map, {static_cast<double>(i), 0.0});
+    if (i > 0)
+    {
+      graph.add_lane(i-1, i);
+      graph.add_lane(i, i-1);
+    }
+  }
+
+  graph.get_waypoint(6).set_charger(true);
+  graph.get_waypoint(1).set_parking_spot(true);
+  graph.get_waypoint(7).set_parking_spot(true);
+
+  const auto warmup = GoalWarmup::make(4);
+  CHECK(warmup->goals(graph) == std::vector<std::size_t>({6, 1, 7}));
+
+  warmup->record(3);
+  warmup->record(5);
+  warmup->record(5);
+  warmup->record(7);
+  CHECK(warmup->goals(graph) == std::vector<std::size_t>({5, 3, 7, 6}));
+
+  // Goals that are not in the graph are skipped
+  warmup->record(20);
+  CHECK(warmup->goals(graph) == std::vector<std::size_t>({5, 3, 7, 6}));
+
+  const auto shape = rmf_traffic::geometry::make_final_convex<
+    rmf_traffic::geometry::Circle>(0.5);
+  rmf_traffic::agv::VehicleTraits traits(
+    {1.0, 0.5}, {1.0, 0.5}, rmf_traffic::Profile(shape));
+  const auto planner = std::make_shared<Planner>(
+    Planner::Configuration(graph, traits), Planner::Options(nullptr));
+
+  warmup->warm_up(planner, {0});
+  const auto give_up = std::chrono::steady_clock::now()
+    + std::chrono::seconds(30);
+  while (!warmup->ready() && std::chrono::steady_clock::now() < give_up)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  REQUIRE(warmup->ready());
+  CHECK(planner->cache_audit().differential_drive_planner_cache_size() > 0);
+
+  // Older uses count for less than new ones after a warm up
+  warmup->record(3);
+  warmup->record(3);
+  CHECK(warmup->goals(graph).front() == 3);
+}
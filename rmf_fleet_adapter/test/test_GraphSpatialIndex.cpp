@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <rmf_utils/catch.hpp>
+
+#include <GraphSpatialIndex.hpp>
+
+#include <random>
+
+using rmf_fleet_adapter::GraphSpatialIndex;
+using Graph = rmf_traffic::agv::Graph;
+
+namespace {
+//==============================================================================
+Graph make_grid(const std::size_t width, const double spacing)
+{
+  Graph graph;
+  for (std::size_t y = 0; y < width; ++y)
+  {
+    for (std::size_t x = 0; x < width; ++x)
+    {
+      graph.add_waypoint(
+        "L1", {static_cast<double>(x) * spacing,
+          static_cast<double>(y) * spacing});
+    }
+  }
+
+  for (std::size_t y = 0; y < width; ++y)
+  {
+    for (std::size_t x = 0; x < width; ++x)
+    {
+      const std::size_t i = y * width + x;
+      if (x + 1 < width)
+      {
+        graph.add_lane(i, i + 1);
+        graph.add_lane(i + 1, i);
+      }
+
+      if (y + 1 < width)
+      {
+        graph.add_lane(i, i + width);
+        graph.add_lane(i + width, i);
+      }
+    }
+  }
+
+  // A long diagonal lane that crosses many cells of the index
+  graph.add_lane(0, width * width - 1);
+
+  // A waypoint on another map, right on top of the first one
+  graph.add_waypoint("L2", {0.0, 0.0});
+  return graph;
+}
+
+//==============================================================================
+bool same_starts(
+  const rmf_traffic::agv::Plan::StartSet& a,
+  const rmf_traffic::agv::Plan::StartSet& b)
+{
+  if (a.size() != b.size())
+    return false;
+
+  for (std::size_t i = 0; i < a.size(); ++i)
+  {
+    if (a[i].waypoint() != b[i].waypoint() || a[i].lane() != b[i].lane())
+      return false;
+
+    if (a[i].orientation() != b[i].orientation())
+      return false;
+  }
+
+  return true;
+}
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("Spatial index matches a full scan of the graph")
+{
+  const auto graph = make_grid(20, 2.0);
+  const auto index = GraphSpatialIndex::make(graph);
+  CHECK(index->matches(graph));
+
+  const auto near_origin = index->waypoints_near("L1", {0.1, 0.1}, 0.5);
+  CHECK(near_origin == std::vector<std::size_t>({0}));
+  CHECK(index->waypoints_near("L2", {0.1, 0.1}, 0.5).size() == 1);
+  CHECK(index->waypoints_near("L3", {0.1, 0.1}, 0.5).empty());
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> coord(-3.0, 41.0);
+  std::uniform_real_distribution<double> yaw(-3.0, 3.0);
+  const auto now = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < 500; ++i)
+  {
+    const Eigen::Vector3d pose(coord(rng), coord(rng), yaw(rng));
+    for (const double lane_distance : {0.3, 1.0, 3.0})
+    {
+      const auto expected = rmf_traffic::agv::compute_plan_starts(
+        graph, "L1", pose, now, 0.5, lane_distance, 1e-8);
+
+      const auto actual = index->compute_plan_starts(
+        graph, "L1", pose, now, 0.5, lane_distance, 1e-8);
+
+      CHECK(same_starts(expected, actual));
+    }
+  }
+}
+
+//==============================================================================
+SCENARIO("A neighborhood can be reused while the robot stays inside it")
+{
+  const auto graph = make_grid(20, 2.0);
+  const auto index = GraphSpatialIndex::make(graph);
+  const auto now = std::chrono::steady_clock::now();
+
+  const double radius = 3.0;
+  const double margin = 2.0;
+  const Eigen::Vector2d center(10.3, 10.9);
+  const auto neighborhood =
+    index->neighborhood(graph, "L1", center, radius + margin);
+
+  CHECK(neighborhood->covers("L1", center, radius));
+  CHECK(neighborhood->covers("L1", center + Eigen::Vector2d(1.5, 1.0), radius));
+  CHECK_FALSE(neighborhood->covers("L1", center + Eigen::Vector2d(3.0, 0.0),
+    radius));
+  CHECK_FALSE(neighborhood->covers("L2", center, radius));
+
+  // Walk the robot along a lane while staying inside the neighborhood
+  for (double x = 8.5; x <= 12.0; x += 0.1)
+  {
+    const Eigen::Vector3d pose(x, 10.05, 0.0);
+    REQUIRE(neighborhood->covers("L1", pose.block<2, 1>(0, 0), radius));
+    for (const double lane_distance : {0.3, 1.0, 3.0})
+    {
+      const auto expected = rmf_traffic::agv::compute_plan_starts(
+        graph, "L1", pose, now, 0.5, lane_distance, 1e-8);
+
+      const auto actual = neighborhood->compute_plan_starts(
+        "L1", pose, now, 0.5, lane_distance, 1e-8);
+
+      CHECK(same_starts(expected, actual));
+    }
+  }
+}
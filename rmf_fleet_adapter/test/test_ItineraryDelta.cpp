@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <ItineraryDelta.hpp>
+
+using namespace std::chrono_literals;
+using rmf_fleet_adapter::ItineraryDelta;
+using Kind = ItineraryDelta::Kind;
+
+namespace {
+//==============================================================================
+rmf_traffic::Route make_route(
+  const std::string& map,
+  rmf_traffic::Time start,
+  double x)
+{
+  rmf_traffic::Trajectory trajectory;
+  trajectory.insert(start, {x, 0.0, 0.0}, {0.0, 0.0, 0.0});
+  trajectory.insert(start + 10s, {x + 5.0, 0.0, 0.0}, {0.0, 0.0, 0.0});
+  return rmf_traffic::Route(map, std::move(trajectory));
+}
+
+//==============================================================================
+rmf_traffic::schedule::Itinerary make_hold(
+  rmf_traffic::Time start,
+  rmf_traffic::Time finish,
+  double x)
+{
+  rmf_traffic::Trajectory trajectory;
+  trajectory.insert(start, {x, 0.0, 0.0}, {0.0, 0.0, 0.0});
+  trajectory.insert(finish, {x, 0.0, 0.0}, {0.0, 0.0, 0.0});
+  return {rmf_traffic::Route("L1", std::move(trajectory))};
+}
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("Compute the change between itineraries of the same plan")
+{
+  const auto now = std::chrono::steady_clock::now();
+  const rmf_traffic::schedule::Itinerary current = {
+    make_route("L1", now, 0.0),
+    make_route("L1", now + 20s, 10.0)
+  };
+
+  WHEN("Nothing changes")
+  {
+    CHECK(ItineraryDelta::compute(current, current).kind == Kind::Unchanged);
+  }
+
+  WHEN("Every route is pushed back by the same amount")
+  {
+    const rmf_traffic::schedule::Itinerary next = {
+      make_route("L1", now + 3s, 0.0),
+      make_route("L1", now + 23s, 10.0)
+    };
+
+    const auto delta = ItineraryDelta::compute(current, next);
+    CHECK(delta.kind == Kind::Delay);
+    CHECK(delta.delay == 3s);
+  }
+
+  WHEN("Routes are pushed back by different amounts")
+  {
+    const rmf_traffic::schedule::Itinerary next = {
+      make_route("L1", now + 3s, 0.0),
+      make_route("L1", now + 25s, 10.0)
+    };
+
+    CHECK(ItineraryDelta::compute(current, next).kind == Kind::Set);
+  }
+
+  WHEN("A route is added after the current ones")
+  {
+    auto next = current;
+    next.push_back(make_route("L2", now + 40s, 0.0));
+
+    const auto delta = ItineraryDelta::compute(current, next);
+    CHECK(delta.kind == Kind::Extend);
+    REQUIRE(delta.additional_routes.size() == 1);
+    CHECK(delta.additional_routes.front().map() == "L2");
+  }
+
+  WHEN("A route moves somewhere else")
+  {
+    const rmf_traffic::schedule::Itinerary next = {
+      make_route("L1", now, 0.0),
+      make_route("L1", now + 20s, 12.0)
+    };
+
+    CHECK(ItineraryDelta::compute(current, next).kind == Kind::Set);
+  }
+
+  WHEN("A route is removed")
+  {
+    const rmf_traffic::schedule::Itinerary next = {current.front()};
+    CHECK(ItineraryDelta::compute(current, next).kind == Kind::Set);
+  }
+
+  WHEN("There is no current itinerary")
+  {
+    CHECK(ItineraryDelta::compute({}, current).kind == Kind::Set);
+  }
+}
+
+//==============================================================================
+SCENARIO("Renew a stationary hold")
+{
+  const auto now = std::chrono::steady_clock::now();
+  const auto current = make_hold(now, now + 60s, 0.0);
+
+  WHEN("The hold is renewed for the same length of time")
+  {
+    const auto delta =
+      ItineraryDelta::compute(current, make_hold(now + 30s, now + 90s, 0.0));
+    CHECK(delta.kind == Kind::Delay);
+    CHECK(delta.delay == 30s);
+  }
+
+  WHEN("The robot will be leaving sooner")
+  {
+    const auto delta =
+      ItineraryDelta::compute(current, make_hold(now + 30s, now + 50s, 0.0));
+    CHECK(delta.kind == Kind::Delay);
+    CHECK(delta.delay == -10s);
+  }
+
+  WHEN("The reported position jitters")
+  {
+    const auto delta =
+      ItineraryDelta::compute(current, make_hold(now + 30s, now + 90s, 0.01));
+    CHECK(delta.kind == Kind::Delay);
+  }
+
+  WHEN("The hold would not cover the start of the new hold")
+  {
+    const auto next = make_hold(now + 10s, now + 100s, 0.0);
+    CHECK(ItineraryDelta::compute(current, next).kind == Kind::Set);
+  }
+
+  WHEN("The robot holds somewhere else")
+  {
+    const auto next = make_hold(now + 30s, now + 90s, 1.0);
+    CHECK(ItineraryDelta::compute(current, next).kind == Kind::Set);
+  }
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <rmf_rxcpp/JobStats.hpp>
+
+using rmf_rxcpp::JobStats;
+using namespace std::chrono_literals;
+
+namespace {
+struct TestJobAction {};
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("Job statistics are collected in windows")
+{
+  auto& stats = JobStats::get("test_JobStats");
+  CHECK(&stats == &JobStats::get("test_JobStats"));
+
+  stats.queued();
+  stats.queued();
+  stats.started(2ms);
+  stats.finished(50us);
+
+  auto window = stats.take_window();
+  CHECK(window.type == "test_JobStats");
+  CHECK(window.queued == 1);
+  CHECK(window.wait.count == 1);
+  CHECK(window.wait.max == Approx(0.002));
+  CHECK(window.execution.count == 1);
+  CHECK(window.execution.buckets[1] == 1);
+
+  stats.started(0s);
+  stats.finished(20s);
+  window = stats.take_window();
+  CHECK(window.queued == 0);
+  CHECK(window.wait.count == 1);
+  CHECK(window.execution.count == 1);
+  CHECK(window.execution.buckets.back() == 1);
+
+  window = stats.take_window();
+  CHECK(window.wait.count == 0);
+  CHECK(window.execution.count == 0);
+}
+
+//==============================================================================
+SCENARIO("Job statistics are named after their action")
+{
+  auto& stats = JobStats::of<TestJobAction>();
+  CHECK(stats.type() == "TestJobAction");
+  CHECK(&stats == &JobStats::get("TestJobAction"));
+}
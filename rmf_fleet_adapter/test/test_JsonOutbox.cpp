@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <JsonOutbox.hpp>
+
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using rmf_fleet_adapter::JsonOutbox;
+
+//==============================================================================
+SCENARIO("Outbox jobs run in order away from the caller")
+{
+  const auto outbox = JsonOutbox::make();
+  const auto caller = std::this_thread::get_id();
+
+  std::vector<int> order;
+  std::thread::id runner;
+  std::promise<void> done;
+  for (int i = 0; i < 5; ++i)
+  {
+    outbox->push(
+      [&order, &runner, i]()
+      {
+        order.push_back(i);
+        runner = std::this_thread::get_id();
+      });
+  }
+  outbox->push([&done]() { done.set_value(); });
+
+  // A job that throws does not stop the jobs after it
+  std::promise<void> after_throw;
+  outbox->push([]() { throw std::runtime_error("bad message"); });
+  outbox->push([&after_throw]() { after_throw.set_value(); });
+
+  REQUIRE(
+    done.get_future().wait_for(std::chrono::seconds(5))
+    == std::future_status::ready);
+  CHECK(order == std::vector<int>({0, 1, 2, 3, 4}));
+  CHECK(runner != caller);
+
+  REQUIRE(
+    after_throw.get_future().wait_for(std::chrono::seconds(5))
+    == std::future_status::ready);
+  CHECK(outbox->pending() == 0);
+}
+
+//==============================================================================
+SCENARIO("Destroying the outbox drops the jobs that have not started")
+{
+  std::promise<void> started;
+  std::promise<void> release;
+  auto release_future = release.get_future().share();
+  bool late_job_ran = false;
+  std::thread releaser;
+  {
+    const auto outbox = JsonOutbox::make();
+    outbox->push(
+      [&started, release_future]()
+      {
+        started.set_value();
+        release_future.wait();
+      });
+    outbox->push([&late_job_ran]() { late_job_ran = true; });
+
+    REQUIRE(
+      started.get_future().wait_for(std::chrono::seconds(5))
+      == std::future_status::ready);
+    CHECK(outbox->pending() == 1);
+
+    releaser = std::thread(
+      [&release]()
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        release.set_value();
+      });
+  }
+
+  releaser.join();
+  CHECK_FALSE(late_job_ran);
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <rmf_utils/catch.hpp>
+
+#include <KeyedStateIndex.hpp>
+
+#include <rmf_door_msgs/msg/door_state.hpp>
+
+using DoorState = rmf_door_msgs::msg::DoorState;
+using rmf_fleet_adapter::KeyedStateIndex;
+
+namespace {
+//==============================================================================
+DoorState::SharedPtr make_state(const std::string& name, uint32_t mode)
+{
+  auto state = std::make_shared<DoorState>();
+  state->door_name = name;
+  state->current_mode.value = mode;
+  return state;
+}
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("States are only delivered to the subscribers of their device")
+{
+  KeyedStateIndex<DoorState> index(
+    [](const DoorState& state) { return state.door_name; });
+
+  CHECK_FALSE(index.latest("door_a"));
+
+  std::vector<uint32_t> received_a;
+  std::size_t received_b = 0;
+  index.observe("door_a").subscribe(
+    [&](const DoorState::SharedPtr& state)
+    {
+      REQUIRE(state->door_name == "door_a");
+      received_a.push_back(state->current_mode.value);
+    });
+
+  index.observe("door_b").subscribe(
+    [&](const DoorState::SharedPtr&) { ++received_b; });
+
+  index.update(make_state("door_a", 0));
+  index.update(make_state("door_c", 1));
+  index.update(make_state("door_a", 2));
+
+  CHECK(received_a == std::vector<uint32_t>({0, 2}));
+  CHECK(received_b == 0);
+
+  REQUIRE(index.latest("door_a"));
+  CHECK(index.latest("door_a")->current_mode.value == 2);
+  REQUIRE(index.latest("door_c"));
+  CHECK(index.latest("door_c")->current_mode.value == 1);
+  CHECK_FALSE(index.latest("door_b"));
+}
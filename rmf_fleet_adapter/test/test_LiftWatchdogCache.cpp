@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+
+#include <rmf_utils/catch.hpp>
+
+#include <LiftWatchdogCache.hpp>
+
+#include <thread>
+
+using namespace std::chrono_literals;
+using rmf_fleet_adapter::LiftWatchdogCache;
+using Decision = LiftWatchdogCache::Decision;
+
+//==============================================================================
+SCENARIO("Lift watchdog decisions are prefetched and used once")
+{
+  std::vector<std::string> asked;
+  std::vector<LiftWatchdogCache::Decide> answers;
+  const auto cache = LiftWatchdogCache::make(
+    [&](const std::string& lift, LiftWatchdogCache::Decide decide)
+    {
+      asked.push_back(lift);
+      answers.push_back(std::move(decide));
+    }, 200ms);
+
+  std::optional<Decision> received;
+  const auto receive = [&](Decision d) { received = d; };
+
+  WHEN("The decision arrives before the doors open")
+  {
+    cache->prefetch("lift_1", "L1");
+    cache->prefetch("lift_1", "L1");
+    CHECK(asked.size() == 1);
+
+    answers.front()(Decision::Clear);
+    cache->prefetch("lift_1", "L1");
+    CHECK(asked.size() == 1);
+
+    cache->request("lift_1", "L1", receive);
+    REQUIRE(received.has_value());
+    CHECK(*received == Decision::Clear);
+    CHECK(asked.size() == 1);
+
+    // The decision was used up, so the next entry needs a new one
+    received = std::nullopt;
+    cache->request("lift_1", "L1", receive);
+    CHECK_FALSE(received.has_value());
+    CHECK(asked.size() == 2);
+    answers.back()(Decision::Crowded);
+    REQUIRE(received.has_value());
+    CHECK(*received == Decision::Crowded);
+  }
+
+  WHEN("The doors open while the prefetch is pending")
+  {
+    cache->prefetch("lift_1", "L1");
+    cache->request("lift_1", "L1", receive);
+    CHECK(asked.size() == 1);
+    CHECK_FALSE(received.has_value());
+
+    answers.front()(Decision::Clear);
+    REQUIRE(received.has_value());
+    CHECK(*received == Decision::Clear);
+  }
+
+  WHEN("The prefetched decision has gone stale")
+  {
+    cache->prefetch("lift_1", "L1");
+    answers.front()(Decision::Clear);
+    std::this_thread::sleep_for(300ms);
+
+    cache->request("lift_1", "L1", receive);
+    CHECK_FALSE(received.has_value());
+    CHECK(asked.size() == 2);
+  }
+
+  WHEN("Decisions are for different levels")
+  {
+    cache->prefetch("lift_1", "L1");
+    answers.front()(Decision::Clear);
+
+    cache->request("lift_1", "L2", receive);
+    CHECK_FALSE(received.has_value());
+    CHECK(asked.size() == 2);
+  }
+}
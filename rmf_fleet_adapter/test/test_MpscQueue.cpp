@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <rmf_utils/catch.hpp>
+
+#include <rmf_rxcpp/detail/MpscQueue.hpp>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using rmf_rxcpp::detail::MpscQueue;
+
+//==============================================================================
+SCENARIO("Values pushed from many threads come out of an MPSC queue once")
+{
+  MpscQueue<std::unique_ptr<std::size_t>> queue;
+
+  std::unique_ptr<std::size_t> value;
+  CHECK_FALSE(queue.pop(value));
+
+  const std::size_t num_producers = 4;
+  const std::size_t values_per_producer = 10000;
+  std::vector<std::thread> producers;
+  for (std::size_t p = 0; p < num_producers; ++p)
+  {
+    producers.emplace_back([&queue, p]()
+      {
+        for (std::size_t i = 0; i < values_per_producer; ++i)
+        {
+          queue.push(
+            std::make_unique<std::size_t>(p * values_per_producer + i));
+        }
+      });
+  }
+
+  // Values from the same producer must come out in the order they went in
+  std::vector<std::size_t> last_seen(num_producers, 0);
+  std::vector<std::size_t> received(num_producers, 0);
+  std::size_t total = 0;
+  while (total < num_producers * values_per_producer)
+  {
+    if (!queue.pop(value))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+
+    REQUIRE(value);
+    const std::size_t producer = *value / values_per_producer;
+    const std::size_t index = *value % values_per_producer;
+    REQUIRE(producer < num_producers);
+    if (received[producer] > 0)
+      CHECK(index > last_seen[producer]);
+
+    last_seen[producer] = index;
+    ++received[producer];
+    ++total;
+  }
+
+  for (auto& producer : producers)
+    producer.join();
+
+  for (const auto count : received)
+    CHECK(count == values_per_producer);
+
+  CHECK_FALSE(queue.pop(value));
+
+  // Anything still in the queue is cleaned up when the queue is destroyed
+  queue.push(std::make_unique<std::size_t>(0));
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <NegotiationScheduler.hpp>
+
+#include <future>
+
+using namespace std::chrono_literals;
+using rmf_fleet_adapter::NegotiationScheduler;
+
+SCENARIO("Negotiation scheduler limits concurrency")
+{
+  const auto worker = rxcpp::schedulers::make_event_loop().create_worker();
+  const auto now = std::chrono::steady_clock::now();
+
+  std::mutex mutex;
+  std::vector<std::string> started;
+  std::vector<NegotiationScheduler::Ticket> tickets;
+  std::promise<void> all_started;
+  std::size_t expected = 0;
+
+  const auto start = [&](const std::string& name)
+    {
+      return [&, name](NegotiationScheduler::Ticket ticket)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          started.push_back(name);
+          tickets.push_back(std::move(ticket));
+          if (started.size() == expected)
+            all_started.set_value();
+        };
+    };
+
+  // Finish the negotiation that started first and wait for the next one to
+  // start in its place
+  const auto finish_oldest = [&]()
+    {
+      NegotiationScheduler::Ticket ticket;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        ticket = std::move(tickets.front());
+        tickets.erase(tickets.begin());
+      }
+      ticket.reset();
+
+      const auto deadline = std::chrono::steady_clock::now() + 5s;
+      while (std::chrono::steady_clock::now() < deadline)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!tickets.empty())
+          break;
+      }
+    };
+
+  WHEN("There is no limit")
+  {
+    const auto scheduler = NegotiationScheduler::make(worker, 0);
+    expected = 3;
+    scheduler->submit(now, start("a"));
+    scheduler->submit(now, start("b"));
+    scheduler->submit(now, start("c"));
+
+    CHECK(started.size() == 3);
+    CHECK(scheduler->waiting() == 0);
+  }
+
+  WHEN("Negotiations are prioritized by age")
+  {
+    const auto scheduler = NegotiationScheduler::make(
+      worker, 1, NegotiationScheduler::Priority::Age);
+    expected = 3;
+    scheduler->submit(now, start("a"));
+    scheduler->submit(now, start("b"));
+    scheduler->submit(now - 10s, start("c"));
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      CHECK(started == std::vector<std::string>{"a"});
+    }
+    CHECK(scheduler->running() == 1);
+    CHECK(scheduler->waiting() == 2);
+
+    auto future = all_started.get_future();
+    for (std::size_t i = 0; i < 2; ++i)
+      finish_oldest();
+
+    REQUIRE(future.wait_for(5s) == std::future_status::ready);
+    std::lock_guard<std::mutex> lock(mutex);
+    CHECK(started == std::vector<std::string>{"a", "b", "c"});
+  }
+
+  WHEN("Negotiations are prioritized by conflict time")
+  {
+    const auto scheduler = NegotiationScheduler::make(
+      worker, 1, NegotiationScheduler::Priority::ConflictTime);
+    expected = 3;
+    scheduler->submit(now, start("a"));
+    scheduler->submit(now + 20s, start("b"));
+    scheduler->submit(now + 10s, start("c"));
+
+    auto future = all_started.get_future();
+    for (std::size_t i = 0; i < 2; ++i)
+      finish_oldest();
+
+    REQUIRE(future.wait_for(5s) == std::future_status::ready);
+    std::lock_guard<std::mutex> lock(mutex);
+    CHECK(started == std::vector<std::string>{"a", "c", "b"});
+  }
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <OutgoingValidation.hpp>
+
+using rmf_fleet_adapter::OutgoingValidation;
+
+namespace {
+//==============================================================================
+std::size_t count_samples(OutgoingValidation& validation, std::size_t n)
+{
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    if (validation.sample())
+      ++count;
+  }
+
+  return count;
+}
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("Sampling outgoing messages for validation")
+{
+  OutgoingValidation validation;
+  CHECK(validation.sample_period() == 1);
+  CHECK(count_samples(validation, 10) == 10);
+
+  validation.sample_period(5);
+  CHECK(validation.sample_period() == 5);
+
+  validation.sample_period(0);
+  CHECK(validation.sample_period() == 0);
+
+#ifdef NDEBUG
+  CHECK(count_samples(validation, 10) == 0);
+
+  validation.sample_period(5);
+  CHECK(count_samples(validation, 20) == 4);
+#else
+  // Debug builds validate everything
+  CHECK(count_samples(validation, 10) == 10);
+#endif
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <rmf_utils/catch.hpp>
+
+#include <PlannerRegistry.hpp>
+
+#include <rmf_traffic/geometry/Circle.hpp>
+
+using rmf_fleet_adapter::PlannerRegistry;
+using Graph = rmf_traffic::agv::Graph;
+using VehicleTraits = rmf_traffic::agv::VehicleTraits;
+
+namespace {
+//==============================================================================
+Graph make_graph(const std::size_t num_waypoints)
+{
+  Graph graph;
+  for (std::size_t i = 0; i < num_waypoints; ++i)
+  {
+    graph.add_waypoint("test_map", {static_cast<double>(i), 0.0});
+    if (i > 0)
+    {
+      graph.add_lane(i-1, i);
+      graph.add_lane(i, i-1);
+    }
+  }
+
+  return graph;
+}
+
+//==============================================================================
+VehicleTraits make_traits(const double linear_velocity)
+{
+  const auto shape = rmf_traffic::geometry::make_final_convex<
+    rmf_traffic::geometry::Circle>(0.5);
+
+  return VehicleTraits(
+    {linear_velocity, 0.5}, {1.0, 0.5}, rmf_traffic::Profile(shape));
+}
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("Fleets with identical graphs and traits share a planner")
+{
+  auto& registry = PlannerRegistry::get();
+  const auto initial_size = registry.size();
+
+  auto first = registry.share(make_graph(5), make_traits(1.0));
+  auto second = registry.share(make_graph(5), make_traits(1.0));
+  CHECK(first == second);
+  CHECK(registry.size() == initial_size + 1);
+
+  // Different traits need a different planner
+  const auto faster = registry.share(make_graph(5), make_traits(2.0));
+  CHECK(faster != first);
+
+  // So does any change to the graph
+  auto moved = make_graph(5);
+  moved.get_waypoint(2).set_location({2.0, 1e-9});
+  CHECK(registry.share(std::move(moved), make_traits(1.0)) != first);
+
+  auto named = make_graph(5);
+  named.add_key("charger", 3);
+  CHECK(registry.share(std::move(named), make_traits(1.0)) != first);
+
+  auto door = make_graph(4);
+  door.add_waypoint("test_map", {4.0, 0.0});
+  door.add_lane(
+    {3, Graph::Lane::Event::make(
+        Graph::Lane::DoorOpen("door", std::chrono::seconds(4)))},
+    4);
+  door.add_lane(4, 3);
+  CHECK(registry.share(std::move(door), make_traits(1.0)) != first);
+
+  // Once the planner is released, a new one is made
+  first.reset();
+  second.reset();
+  const auto third = registry.share(make_graph(5), make_traits(1.0));
+  CHECK(third->get_configuration().graph().num_waypoints() == 5);
+  CHECK(registry.size() == initial_size + 2);
+}
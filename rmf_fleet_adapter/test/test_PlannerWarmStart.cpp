@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <PlannerWarmStart.hpp>
+
+#include <rmf_traffic/geometry/Circle.hpp>
+
+#include <filesystem>
+
+using rmf_fleet_adapter::PlannerWarmStart;
+using Planner = rmf_traffic::agv::Planner;
+
+namespace {
+//==============================================================================
+Planner::Configuration make_config(const std::size_t num_waypoints)
+{
+  const std::string map = "test_map";
+  rmf_traffic::agv::Graph graph;
+  for (std::size_t i = 0; i < num_waypoints; ++i)
+  {
+    graph.add_waypoint(map, {static_cast<double>(i), 0.0});
+    if (i > 0)
+    {
+      graph.add_lane(i-1, i);
+      graph.add_lane(i, i-1);
+    }
+  }
+
+  const auto shape = rmf_traffic::geometry::make_final_convex<
+    rmf_traffic::geometry::Circle>(0.5);
+
+  rmf_traffic::agv::VehicleTraits traits(
+    {1.0, 0.5}, {1.0, 0.5}, rmf_traffic::Profile(shape));
+
+  return Planner::Configuration(std::move(graph), std::move(traits));
+}
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("Planner warm start records survive a restart")
+{
+  const auto filename = (std::filesystem::temp_directory_path()
+    / "test_planner_warm_start.txt").string();
+  std::filesystem::remove(filename);
+
+  const auto config = make_config(5);
+  const auto now = std::chrono::steady_clock::now();
+  const Planner::StartSet starts = {
+    Planner::Start(now, 0, 0.0),
+    Planner::Start(now, 1, 0.0)
+  };
+
+  {
+    const auto warm_start = PlannerWarmStart::make(filename, config);
+    CHECK(warm_start->loaded() == 0);
+
+    warm_start->record(starts, 4);
+    warm_start->record(starts, 4);
+    CHECK(warm_start->entries().size() == 2);
+    CHECK(warm_start->save());
+  }
+
+  WHEN("The record is loaded with the same configuration")
+  {
+    const auto warm_start = PlannerWarmStart::make(filename, config);
+    CHECK(warm_start->loaded() == 2);
+
+    const auto entries = warm_start->entries();
+    REQUIRE(entries.size() == 2);
+    CHECK(entries[0] == PlannerWarmStart::Entry{0, 4});
+    CHECK(entries[1] == PlannerWarmStart::Entry{1, 4});
+
+    // Warming up should solve the problems without any trouble
+    warm_start->warm_up(std::make_shared<Planner>(config, Planner::Options(
+        nullptr)));
+  }
+
+  WHEN("The record is loaded with a different configuration")
+  {
+    const auto other_config = make_config(6);
+    CHECK(PlannerWarmStart::key(config) != PlannerWarmStart::key(other_config));
+
+    const auto warm_start = PlannerWarmStart::make(filename, other_config);
+    CHECK(warm_start->loaded() == 0);
+    CHECK(warm_start->entries().empty());
+  }
+
+  std::filesystem::remove(filename);
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <PulloverCandidates.hpp>
+
+#include <rmf_traffic/geometry/Circle.hpp>
+
+#include <thread>
+
+using rmf_fleet_adapter::PulloverCandidates;
+using Planner = rmf_traffic::agv::Planner;
+
+//==============================================================================
+SCENARIO("Pullover candidates are the closest parking spots")
+{
+  const std::string map = "test_map";
+  rmf_traffic::agv::Graph graph;
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    graph.add_waypoint(map, {static_cast<double>(i), 0.0});
+    if (i > 0)
+    {
+      graph.add_lane(i-1, i);
+      graph.add_lane(i, i-1);
+    }
+  }
+
+  // Waypoint 8 is a parking spot that can only be left, never reached from
+  // anywhere else
+  graph.add_waypoint(map, {10.0, 10.0});
+  graph.add_lane(8, 7);
+
+  for (const std::size_t i : {0, 3, 7, 8})
+    graph.get_waypoint(i).set_parking_spot(true);
+
+  const auto shape = rmf_traffic::geometry::make_final_convex<
+    rmf_traffic::geometry::Circle>(0.5);
+
+  rmf_traffic::agv::VehicleTraits traits(
+    {1.0, 0.5}, {1.0, 0.5}, rmf_traffic::Profile(shape));
+
+  const auto planner = std::make_shared<Planner>(
+    Planner::Configuration(graph, traits), Planner::Options(nullptr));
+
+  const auto candidates = PulloverCandidates::make(planner, 2);
+
+  const auto give_up = std::chrono::steady_clock::now()
+    + std::chrono::seconds(30);
+  while (!candidates->ready() && std::chrono::steady_clock::now() < give_up)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  REQUIRE(candidates->ready());
+
+  const auto now = std::chrono::steady_clock::now();
+  const auto from = [&](std::vector<std::size_t> waypoints)
+    {
+      rmf_traffic::agv::Plan::StartSet starts;
+      for (const auto wp : waypoints)
+        starts.emplace_back(now, wp, 0.0);
+
+      return candidates->get(starts);
+    };
+
+  const auto near_1 = from({1});
+  REQUIRE(near_1.has_value());
+  CHECK(*near_1 == std::vector<std::size_t>({0, 3}));
+
+  const auto near_6 = from({6});
+  REQUIRE(near_6.has_value());
+  CHECK(*near_6 == std::vector<std::size_t>({7, 3}));
+
+  // The candidates of every start are combined
+  const auto near_both = from({1, 6});
+  REQUIRE(near_both.has_value());
+  CHECK(near_both->size() == 3);
+
+  // A robot that is already on a parking spot can stay there
+  const auto near_8 = from({8});
+  REQUIRE(near_8.has_value());
+  CHECK(*near_8 == std::vector<std::size_t>({8, 7}));
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <Reporting.hpp>
+
+using rmf_fleet_adapter::Reporting;
+
+//==============================================================================
+SCENARIO("Unsent log entries can be capped")
+{
+  Reporting reporting(rxcpp::schedulers::make_event_loop().create_worker());
+  CHECK(reporting.unsent_size() == 0);
+
+  for (std::size_t i = 0; i < 10; ++i)
+    reporting.push(rmf_task::Log::Tier::Info, std::to_string(i));
+  CHECK(reporting.unsent_size() == 10);
+
+  CHECK(reporting.drop_oldest_unsent(20) == 0);
+  CHECK(reporting.drop_oldest_unsent(4) == 6);
+  CHECK(reporting.unsent_size() == 4);
+
+  // The newest entries are the ones that are kept
+  const auto unsent = reporting.take_unsent();
+  REQUIRE(unsent.size() == 4);
+  CHECK(unsent.front()["text"] == "6");
+  CHECK(unsent.back()["text"] == "9");
+  CHECK(reporting.unsent_size() == 0);
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <TaskDescriptionCache.hpp>
+
+#include <rmf_task/requests/Clean.hpp>
+
+using rmf_fleet_adapter::TaskDescriptionCache;
+
+namespace {
+//==============================================================================
+TaskDescriptionCache::ConstDescriptionPtr make_description(std::size_t wp)
+{
+  return rmf_task::requests::Clean::Description::make(
+    wp, wp, rmf_traffic::Trajectory());
+}
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("Task descriptions are cached by their canonical JSON")
+{
+  TaskDescriptionCache cache(2);
+  const auto a = nlohmann::json::parse(R"({"zone": "a", "type": "vacuum"})");
+  const auto a_reordered =
+    nlohmann::json::parse(R"({"type": "vacuum", "zone": "a"})");
+  const auto b = nlohmann::json::parse(R"({"zone": "b"})");
+  const auto c = nlohmann::json::parse(R"({"zone": "c"})");
+
+  CHECK_FALSE(cache.find("clean", a));
+
+  const auto description_a = make_description(0);
+  cache.insert("clean", a, description_a);
+  CHECK(cache.find("clean", a) == description_a);
+  CHECK(cache.find("clean", a_reordered) == description_a);
+  CHECK_FALSE(cache.find("compose", a));
+
+  // Failed deserializations are not remembered
+  cache.insert("clean", b, nullptr);
+  CHECK(cache.size() == 1);
+
+  const auto description_b = make_description(1);
+  cache.insert("clean", b, description_b);
+  CHECK(cache.size() == 2);
+
+  // Finding a refreshes it, so b is the least recently used
+  CHECK(cache.find("clean", a) == description_a);
+  cache.insert("clean", c, make_description(2));
+  CHECK(cache.size() == 2);
+  CHECK(cache.find("clean", a) == description_a);
+  CHECK_FALSE(cache.find("clean", b));
+  CHECK(cache.find("clean", c));
+
+  cache.clear();
+  CHECK(cache.size() == 0);
+  CHECK_FALSE(cache.find("clean", a));
+}
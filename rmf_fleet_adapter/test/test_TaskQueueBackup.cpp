@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <TaskQueueBackup.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+using rmf_fleet_adapter::TaskQueueBackup;
+
+namespace {
+//==============================================================================
+nlohmann::json make_request(const std::string& place)
+{
+  return {
+    {"category", "patrol"},
+    {"description", {{"places", {place}}, {"rounds", 1}}}
+  };
+}
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("Task queue backups survive a restart")
+{
+  const auto filename = (std::filesystem::temp_directory_path()
+    / "test_task_queue_backup.json").string();
+  std::filesystem::remove(filename);
+
+  {
+    const auto backup = TaskQueueBackup::make(filename);
+    CHECK(backup->loaded() == 0);
+    CHECK_FALSE(backup->take_loaded("robot_a").has_value());
+
+    backup->record("task_1", make_request("A"));
+    backup->record("task_2", make_request("B"));
+    backup->record("task_3", make_request("C"));
+
+    std::unordered_map<std::string, TaskQueueBackup::TaskIds> robots;
+    // charge_1 has no recorded request, like an automatic task
+    robots["robot_a"].dispatched = {"task_2", "charge_1", "task_1"};
+    robots["robot_b"].direct = {"task_3"};
+    CHECK(backup->save(robots));
+  }
+
+  const auto backup = TaskQueueBackup::make(filename);
+  CHECK(backup->loaded() == 3);
+
+  const auto a = backup->take_loaded("robot_a");
+  REQUIRE(a.has_value());
+  REQUIRE(a->dispatched.size() == 2);
+  CHECK(a->dispatched[0].id == "task_2");
+  CHECK(a->dispatched[0].request == make_request("B"));
+  CHECK(a->dispatched[1].id == "task_1");
+  CHECK(a->direct.empty());
+
+  // The queues of a robot can only be taken once
+  CHECK_FALSE(backup->take_loaded("robot_a").has_value());
+
+  WHEN("The backup is saved before every robot took its queues")
+  {
+    std::unordered_map<std::string, TaskQueueBackup::TaskIds> robots;
+    robots["robot_a"] = {};
+    robots["robot_b"] = {};
+    CHECK(backup->save(robots));
+
+    const auto reloaded = TaskQueueBackup::make(filename);
+    CHECK(reloaded->loaded() == 1);
+
+    const auto b = reloaded->take_loaded("robot_b");
+    REQUIRE(b.has_value());
+    REQUIRE(b->direct.size() == 1);
+    CHECK(b->direct[0].id == "task_3");
+    CHECK(b->direct[0].request == make_request("C"));
+  }
+
+  WHEN("The file is not a task queue backup")
+  {
+    {
+      std::ofstream file(filename, std::ios::trunc);
+      file << "{\"robots\": {}}";
+    }
+
+    CHECK(TaskQueueBackup::make(filename)->loaded() == 0);
+  }
+
+  std::filesystem::remove(filename);
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <TimerWheel.hpp>
+
+using rmf_fleet_adapter::TimerWheel;
+
+//==============================================================================
+SCENARIO("Timers in a timer wheel")
+{
+  const auto resolution = std::chrono::milliseconds(100);
+  const auto start = TimerWheel::Clock::now();
+  TimerWheel wheel(resolution, start);
+
+  std::size_t fast_count = 0;
+  std::size_t slow_count = 0;
+  auto fast = wheel.add(
+    std::chrono::milliseconds(250), [&]() { ++fast_count; });
+
+  // Long enough to need more than one revolution of the wheel
+  const std::chrono::milliseconds slow_period =
+    resolution * static_cast<int>(TimerWheel::NumSlots + 10);
+  auto slow = wheel.add(slow_period, [&]() { ++slow_count; });
+  CHECK(wheel.size() == 2);
+
+  wheel.advance(start + std::chrono::milliseconds(250));
+  CHECK(fast_count == 0);
+
+  wheel.advance(start + std::chrono::milliseconds(300));
+  CHECK(fast_count == 1);
+
+  wheel.advance(start + std::chrono::milliseconds(600));
+  CHECK(fast_count == 2);
+  CHECK(slow_count == 0);
+
+  WHEN("The wheel goes past the slow period")
+  {
+    wheel.advance(start + slow_period - resolution);
+    CHECK(slow_count == 0);
+
+    wheel.advance(start + slow_period);
+    CHECK(slow_count == 1);
+  }
+
+  WHEN("A timer is cancelled")
+  {
+    fast->cancel();
+    wheel.advance(start + std::chrono::seconds(2));
+    CHECK(fast_count == 2);
+    CHECK(wheel.size() == 1);
+  }
+
+  WHEN("A timer is dropped")
+  {
+    fast = nullptr;
+    wheel.advance(start + std::chrono::seconds(2));
+    CHECK(fast_count == 2);
+    CHECK(wheel.size() == 1);
+  }
+
+  WHEN("A timer drops itself in its callback")
+  {
+    std::size_t once_count = 0;
+    TimerWheel::TimerPtr once;
+    once = wheel.add(
+      std::chrono::milliseconds(100),
+      [&]()
+      {
+        ++once_count;
+        once = nullptr;
+      });
+
+    wheel.advance(start + std::chrono::seconds(2));
+    CHECK(once_count == 1);
+    CHECK(wheel.size() == 2);
+  }
+}
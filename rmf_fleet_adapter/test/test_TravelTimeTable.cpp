@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <TravelTimeTable.hpp>
+
+#include <rmf_traffic/geometry/Circle.hpp>
+
+#include <cmath>
+#include <thread>
+
+using rmf_fleet_adapter::TravelTimeTable;
+using Planner = rmf_traffic::agv::Planner;
+
+//==============================================================================
+SCENARIO("Travel time table matches the planner")
+{
+  const std::string map = "test_map";
+  rmf_traffic::agv::Graph graph;
+  for (std::size_t i = 0; i < 6; ++i)
+  {
+    graph.add_waypoint(map, {static_cast<double>(i), 0.0});
+    if (i > 0)
+    {
+      graph.add_lane(i-1, i);
+      graph.add_lane(i, i-1);
+    }
+  }
+
+  // Waypoint 5 can only be left, never reached
+  graph.add_waypoint(map, {10.0, 10.0});
+  graph.add_lane(6, 5);
+
+  graph.add_key("A", 0);
+  graph.add_key("B", 3);
+  graph.add_key("C", 6);
+  graph.get_waypoint(5).set_charger(true);
+
+  const auto shape = rmf_traffic::geometry::make_final_convex<
+    rmf_traffic::geometry::Circle>(0.5);
+
+  rmf_traffic::agv::VehicleTraits traits(
+    {1.0, 0.5}, {1.0, 0.5}, rmf_traffic::Profile(shape));
+
+  const auto planner = std::make_shared<Planner>(
+    Planner::Configuration(graph, traits), Planner::Options(nullptr));
+
+  const auto table = TravelTimeTable::make(planner);
+  CHECK(table->size() == 4);
+
+  const auto give_up = std::chrono::steady_clock::now()
+    + std::chrono::seconds(30);
+  while (!table->ready() && std::chrono::steady_clock::now() < give_up)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  REQUIRE(table->ready());
+
+  // Waypoints without a name or a special role are not in the table
+  CHECK_FALSE(table->get(0, 1).has_value());
+  CHECK_FALSE(table->get(1, 0).has_value());
+
+  const auto now = std::chrono::steady_clock::now();
+  for (const std::size_t start : {0, 3, 5})
+  {
+    for (const std::size_t goal : {0, 3, 5})
+    {
+      if (start == goal)
+      {
+        CHECK(table->get(start, goal) == 0.0);
+        continue;
+      }
+
+      const auto cost = table->get(start, goal);
+      REQUIRE(cost.has_value());
+
+      const auto expected = planner->setup(
+        Planner::Start(now, start, 0.0), Planner::Goal(goal)).ideal_cost();
+      REQUIRE(expected.has_value());
+      CHECK(*cost == Approx(*expected));
+    }
+  }
+
+  const auto unreachable = table->get(0, 6);
+  REQUIRE(unreachable.has_value());
+  CHECK(std::isinf(*unreachable));
+}
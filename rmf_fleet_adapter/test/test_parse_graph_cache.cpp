@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <rmf_utils/catch.hpp>
+
+#include <rmf_fleet_adapter/agv/parse_graph.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using Graph = rmf_traffic::agv::Graph;
+
+namespace {
+//==============================================================================
+void check_same_graph(const Graph& expected, const Graph& actual)
+{
+  REQUIRE(actual.num_waypoints() == expected.num_waypoints());
+  for (std::size_t i = 0; i < expected.num_waypoints(); ++i)
+  {
+    const auto& e = expected.get_waypoint(i);
+    const auto& a = actual.get_waypoint(i);
+    CHECK(a.get_map_name() == e.get_map_name());
+    CHECK((a.get_location() - e.get_location()).norm() == Approx(0.0));
+    CHECK(a.name() == e.name());
+    CHECK(a.is_parking_spot() == e.is_parking_spot());
+    CHECK(a.is_holding_point() == e.is_holding_point());
+    CHECK(a.is_passthrough_point() == e.is_passthrough_point());
+    CHECK(a.is_charger() == e.is_charger());
+    CHECK(a.in_mutex_group() == e.in_mutex_group());
+  }
+
+  CHECK(actual.keys() == expected.keys());
+
+  REQUIRE(actual.num_lanes() == expected.num_lanes());
+  for (std::size_t i = 0; i < expected.num_lanes(); ++i)
+  {
+    const auto& e = expected.get_lane(i);
+    const auto& a = actual.get_lane(i);
+    CHECK(a.entry().waypoint_index() == e.entry().waypoint_index());
+    CHECK(a.exit().waypoint_index() == e.exit().waypoint_index());
+    CHECK(static_cast<bool>(a.entry().event()) ==
+      static_cast<bool>(e.entry().event()));
+    CHECK(static_cast<bool>(a.exit().event()) ==
+      static_cast<bool>(e.exit().event()));
+    CHECK(a.properties().speed_limit() == e.properties().speed_limit());
+  }
+}
+
+//==============================================================================
+std::string read_all(const std::string& filename)
+{
+  std::ifstream in(filename, std::ios::binary);
+  std::stringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("Loading a nav graph through the binary cache")
+{
+  const rmf_traffic::agv::VehicleTraits traits{
+    {0.5, 0.75},
+    {0.6, 2.0},
+    rmf_traffic::Profile{
+      rmf_traffic::geometry::make_final_convex<
+        rmf_traffic::geometry::Circle>(1.0)
+    }
+  };
+
+  const std::filesystem::path dir =
+    std::filesystem::temp_directory_path() / "test_parse_graph_cache";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+
+  const std::string nav_file = (dir / "nav.yaml").string();
+  const std::string cache_file = (dir / "nav.cache").string();
+  std::filesystem::copy_file(
+    TEST_RESOURCES_DIR "/office_nav.yaml", nav_file);
+
+  const auto expected = rmf_fleet_adapter::agv::parse_graph(nav_file, traits);
+
+  // The first load parses the YAML and writes the cache
+  const auto first =
+    rmf_fleet_adapter::agv::parse_graph(nav_file, traits, cache_file);
+  REQUIRE(std::filesystem::exists(cache_file));
+  check_same_graph(expected, first);
+
+  // The second load comes from the cache
+  const auto cache_contents = read_all(cache_file);
+  const auto second =
+    rmf_fleet_adapter::agv::parse_graph(nav_file, traits, cache_file);
+  check_same_graph(expected, second);
+  CHECK(read_all(cache_file) == cache_contents);
+
+  WHEN("The nav graph file changes")
+  {
+    // Renaming the only level changes the hash of the file
+    auto yaml = read_all(nav_file);
+    const auto pos = yaml.find("L1:");
+    REQUIRE(pos != std::string::npos);
+    yaml.replace(pos, 3, "L2:");
+    std::ofstream(nav_file, std::ios::trunc) << yaml;
+
+    const auto updated =
+      rmf_fleet_adapter::agv::parse_graph(nav_file, traits, cache_file);
+
+    THEN("The stale cache is ignored and rewritten")
+    {
+      REQUIRE(updated.num_waypoints() > 0);
+      CHECK(updated.get_waypoint(0).get_map_name() == "L2");
+      CHECK(read_all(cache_file) != cache_contents);
+    }
+  }
+
+  WHEN("The cache is corrupted")
+  {
+    std::ofstream(cache_file, std::ios::binary | std::ios::trunc)
+      << cache_contents.substr(0, cache_contents.size() / 2);
+
+    THEN("The graph is parsed from YAML again")
+    {
+      const auto reparsed =
+        rmf_fleet_adapter::agv::parse_graph(nav_file, traits, cache_file);
+      check_same_graph(expected, reparsed);
+      CHECK(read_all(cache_file) == cache_contents);
+    }
+  }
+
+  std::filesystem::remove_all(dir);
+}
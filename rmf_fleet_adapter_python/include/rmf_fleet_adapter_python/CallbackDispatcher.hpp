@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef CALLBACKDISPATCHER_HPP
+#define CALLBACKDISPATCHER_HPP
+
+#include <pybind11/pybind11.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Collects calls from the fleet adapter's threads into Python callbacks so
+// that a Python thread can run them in batches. The adapter's threads only
+// queue the call, without taking the GIL, and the Python thread takes the GIL
+// once for each batch instead of once for each call.
+class CallbackDispatcher
+{
+public:
+
+  // Queue up a call. This may be called from any thread, and it does not need
+  // the GIL.
+  void push(std::function<void()> call)
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_shutdown)
+        return;
+
+      _calls.push_back(std::move(call));
+    }
+    _cv.notify_one();
+  }
+
+  // Wait until there is at least one queued call, or until the timeout runs
+  // out, and then run every queued call in the order that they arrived. This
+  // must be called with the GIL held, and the GIL is released while waiting.
+  // Returns the number of calls that were run.
+  std::size_t dispatch(std::optional<double> timeout_seconds)
+  {
+    std::vector<std::function<void()>> calls;
+    {
+      pybind11::gil_scoped_release release;
+      std::unique_lock<std::mutex> lock(_mutex);
+      const auto ready = [this]() { return !_calls.empty() || _shutdown; };
+      if (timeout_seconds.has_value())
+      {
+        _cv.wait_for(
+          lock,
+          std::chrono::duration<double>(*timeout_seconds),
+          ready);
+      }
+      else
+      {
+        _cv.wait(lock, ready);
+      }
+
+      calls.swap(_calls);
+    }
+
+    for (const auto& call : calls)
+    {
+      try
+      {
+        call();
+      }
+      catch (pybind11::error_already_set& e)
+      {
+        // Report the error without losing the rest of the batch
+        e.discard_as_unraisable("CallbackDispatcher.dispatch");
+      }
+    }
+
+    // Drop the arguments of these calls while we still hold the GIL
+    const auto count = calls.size();
+    calls.clear();
+    return count;
+  }
+
+  // Stop accepting calls and wake up any thread that is waiting in dispatch().
+  void shutdown()
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _shutdown = true;
+    }
+    _cv.notify_all();
+  }
+
+  bool is_shutdown() const
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _shutdown;
+  }
+
+  // Make a C++ callback that queues a call to a Python function on the
+  // dispatcher instead of calling it right away. The arguments are kept as C++
+  // objects until the call is dispatched.
+  template<typename... Args>
+  static std::function<void(Args...)> wrap(
+    std::shared_ptr<CallbackDispatcher> dispatcher,
+    pybind11::function function)
+  {
+    // The Python function may be released from any thread, so take the GIL
+    // when it is deleted.
+    std::shared_ptr<pybind11::function> held(
+      new pybind11::function(std::move(function)),
+      [](pybind11::function* f)
+      {
+        pybind11::gil_scoped_acquire acquire;
+        delete f;
+      });
+
+    return [dispatcher = std::move(dispatcher), held = std::move(held)](
+      Args... args)
+      {
+        dispatcher->push(
+          [held, args = std::make_tuple(std::decay_t<Args>(args)...)]()
+          {
+            std::apply(*held, args);
+          });
+      };
+  }
+
+private:
+  mutable std::mutex _mutex;
+  std::condition_variable _cv;
+  std::vector<std::function<void()>> _calls;
+  bool _shutdown = false;
+};
+
+#endif // CALLBACKDISPATCHER_HPP
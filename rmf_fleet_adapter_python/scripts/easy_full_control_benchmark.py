@@ -0,0 +1,346 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 Open Source Robotics Foundation, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Measure the overhead of driving an EasyFullControl fleet from Python.
+
+An EasyFullControl fleet is created with a number of mock robots that sit
+still on a grid graph. The robot states are then pushed into the adapter at a
+fixed rate, either one EasyRobotUpdateHandle.update() call per robot or one
+EasyFullControl.update_all() call per cycle, and the script reports:
+
+- The latency of each update call, as seen by the Python caller
+- The CPU time used by the Python thread that makes the calls
+- The CPU time used by every other thread of the process, which is mostly
+  the fleet adapter (and the schedule node, unless --external-schedule is
+  given)
+
+Example:
+    easy_full_control_benchmark.py --robots 50 --rate 10 --duration 30
+"""
+
+import argparse
+import datetime
+import math
+import resource
+import sys
+import threading
+import time
+
+import rmf_adapter as adpt
+import rmf_adapter.battery as battery
+import rmf_adapter.easy_full_control as efc
+import rmf_adapter.geometry as geometry
+import rmf_adapter.graph as graph
+import rmf_adapter.nodes as nodes
+import rmf_adapter.vehicletraits as traits
+
+
+map_name = "benchmark_map"
+fleet_name = "benchmark_fleet"
+grid_spacing = 5.0
+
+
+def make_graph(num_robots):
+    # A square grid with at least one waypoint for every robot
+    side = max(2, math.ceil(math.sqrt(num_robots)))
+    nav_graph = graph.Graph()
+    for i in range(side):
+        for j in range(side):
+            nav_graph.add_waypoint(
+                map_name, [i*grid_spacing, j*grid_spacing])
+
+    for i in range(side):
+        for j in range(side):
+            index = i*side + j
+            if i + 1 < side:
+                nav_graph.add_bidir_lane(index, index + side)
+            if j + 1 < side:
+                nav_graph.add_bidir_lane(index, index + 1)
+
+    nav_graph.get_waypoint(0).set_charger(True)
+    return nav_graph
+
+
+def make_fleet_config(nav_graph, robot_names):
+    profile = traits.Profile(geometry.make_final_convex_circle(0.5))
+    robot_traits = traits.VehicleTraits(linear=traits.Limits(0.7, 0.3),
+                                        angular=traits.Limits(1.0, 0.45),
+                                        profile=profile)
+
+    battery_sys = battery.BatterySystem.make(24.0, 40.0, 8.8)
+    mech_sys = battery.MechanicalSystem.make(70.0, 40.0, 0.22)
+    motion_sink = battery.SimpleMotionPowerSink(battery_sys, mech_sys)
+    ambient_power_sys = battery.PowerSystem.make(20.0)
+    ambient_sink = battery.SimpleDevicePowerSink(
+        battery_sys, ambient_power_sys)
+    tool_power_sys = battery.PowerSystem.make(10.0)
+    tool_sink = battery.SimpleDevicePowerSink(battery_sys, tool_power_sys)
+
+    known_robots = {
+        name: efc.RobotConfiguration([]) for name in robot_names
+    }
+
+    return efc.FleetConfiguration(
+        fleet_name=fleet_name,
+        transformations_to_robot_coordinates=None,
+        known_robot_configurations=known_robots,
+        traits=robot_traits,
+        graph=nav_graph,
+        battery_system=battery_sys,
+        motion_sink=motion_sink,
+        ambient_sink=ambient_sink,
+        tool_sink=tool_sink,
+        recharge_threshold=0.2,
+        recharge_soc=1.0,
+        account_for_battery_drain=False,
+        task_categories={},
+        action_categories={},
+        finishing_request="nothing")
+
+
+class CommandCounter:
+    # The robots never move, so the commands only get counted
+
+    def __init__(self):
+        self.navigate = 0
+        self.stop = 0
+        self.action = 0
+
+    def on_navigate(self, destination, execution):
+        self.navigate += 1
+
+    def on_stop(self, activity):
+        self.stop += 1
+
+    def on_action(self, category, description, execution):
+        self.action += 1
+
+
+def percentile(sorted_values, fraction):
+    if not sorted_values:
+        return float('nan')
+    index = min(len(sorted_values) - 1,
+                int(round(fraction*(len(sorted_values) - 1))))
+    return sorted_values[index]
+
+
+def process_cpu_time():
+    usage = resource.getrusage(resource.RUSAGE_SELF)
+    return usage.ru_utime + usage.ru_stime
+
+
+def report(args, latencies, cycles, overruns, wall, caller_cpu, total_cpu,
+           commands):
+    latencies_us = sorted(x*1e6 for x in latencies)
+    calls_per_cycle = 1 if args.batched else args.robots
+    other_cpu = max(0.0, total_cpu - caller_cpu)
+
+    print()
+    print(f"robots:            {args.robots}")
+    print(f"mode:              "
+          f"{'update_all' if args.batched else 'update per robot'}")
+    print(f"target rate:       {args.rate:.1f} Hz")
+    print(f"achieved rate:     {cycles/wall:.1f} Hz "
+          f"({cycles} cycles, {overruns} overran their period)")
+    print(f"update calls:      {len(latencies)} "
+          f"({calls_per_cycle} per cycle)")
+    print()
+    print("update call latency [us]")
+    print(f"  mean:  {sum(latencies_us)/max(1, len(latencies_us)):10.1f}")
+    for label, fraction in [
+            ('p50', 0.5), ('p90', 0.9), ('p99', 0.99), ('max', 1.0)]:
+        print(f"  {label}:   {percentile(latencies_us, fraction):10.1f}")
+    print()
+    print("CPU usage [% of one core]")
+    print(f"  python caller thread: {100.0*caller_cpu/wall:6.1f}")
+    print(f"  other threads:        {100.0*other_cpu/wall:6.1f}")
+    print(f"  whole process:        {100.0*total_cpu/wall:6.1f}")
+    if args.robots > 0:
+        per_state = other_cpu/max(1, cycles*args.robots)
+        print(f"  other threads per robot state: {per_state*1e6:.1f} us")
+    print()
+    print(f"commands received: navigate={commands.navigate} "
+          f"stop={commands.stop} action={commands.action}")
+
+
+def main(argv=sys.argv):
+    parser = argparse.ArgumentParser(
+        prog='easy_full_control_benchmark',
+        description='Measure the overhead of EasyFullControl robot updates '
+                    'made from Python')
+    parser.add_argument('-n', '--robots', type=int, default=10,
+                        help='Number of mock robots in the fleet')
+    parser.add_argument('-r', '--rate', type=float, default=10.0,
+                        help='How often each robot state is updated [Hz]')
+    parser.add_argument('-d', '--duration', type=float, default=20.0,
+                        help='How long to measure for [s]')
+    parser.add_argument('-w', '--warmup', type=float, default=3.0,
+                        help='How long to run before measuring [s]')
+    parser.add_argument('-b', '--batched', action='store_true',
+                        help='Use one EasyFullControl.update_all() call per '
+                             'cycle instead of one update() call per robot')
+    parser.add_argument('--dispatcher', action='store_true',
+                        help='Queue robot commands on a CallbackDispatcher '
+                             'instead of calling into Python right away')
+    parser.add_argument('--external-schedule', action='store_true',
+                        help='Use an already running schedule node instead '
+                             'of starting one inside this process')
+    args = parser.parse_args(argv[1:])
+
+    if args.robots < 1 or args.rate <= 0.0 or args.duration <= 0.0:
+        parser.error('robots, rate and duration must be positive')
+
+    adpt.init_rclcpp()
+
+    # The adapter cannot start without a traffic schedule to talk to
+    running = True
+    schedule_thread = None
+    if not args.external_schedule:
+        schedule_node = nodes.make_schedule(adpt.NodeOptions())
+
+        def spin_schedule():
+            while running:
+                adpt.spin_some_rclcpp(schedule_node)
+                time.sleep(0.01)
+
+        schedule_thread = threading.Thread(target=spin_schedule, daemon=True)
+        schedule_thread.start()
+
+    adapter = adpt.Adapter.make(
+        'easy_full_control_benchmark',
+        wait_time=datetime.timedelta(seconds=10))
+    if adapter is None:
+        print('Unable to start the adapter: no traffic schedule was found')
+        return 1
+
+    robot_names = [f'robot_{i}' for i in range(args.robots)]
+    nav_graph = make_graph(args.robots)
+    fleet = adapter.add_easy_fleet(make_fleet_config(nav_graph, robot_names))
+
+    commands = CommandCounter()
+    dispatcher = None
+    dispatcher_thread = None
+    if args.dispatcher:
+        dispatcher = efc.CallbackDispatcher()
+
+        def dispatch_commands():
+            while not dispatcher.is_shutdown:
+                dispatcher.dispatch(timeout=0.5)
+
+        dispatcher_thread = threading.Thread(
+            target=dispatch_commands, daemon=True)
+        dispatcher_thread.start()
+
+    # Put each robot on its own waypoint
+    states = []
+    robots = []
+    for i, name in enumerate(robot_names):
+        p = nav_graph.get_waypoint(i).location
+        state = efc.RobotState(map_name, [p[0], p[1], 0.0], 1.0)
+        if dispatcher is not None:
+            callbacks = efc.RobotCallbacks(
+                commands.on_navigate, commands.on_stop, commands.on_action,
+                dispatcher)
+        else:
+            callbacks = efc.RobotCallbacks(
+                commands.on_navigate, commands.on_stop, commands.on_action)
+
+        robot = fleet.add_robot(
+            name, state, efc.RobotConfiguration([]), callbacks)
+        if robot is None:
+            print(f'Unable to add [{name}] to the fleet')
+            return 1
+
+        states.append(state)
+        robots.append(robot)
+
+    updates = [
+        efc.RobotStateUpdate(robot, state)
+        for robot, state in zip(robots, states)
+    ]
+
+    adapter.start()
+
+    period = 1.0/args.rate
+    latencies = []
+
+    def run_cycles(duration, record):
+        cycles = 0
+        overruns = 0
+        start = time.perf_counter()
+        next_cycle = start
+        while next_cycle - start < duration:
+            if args.batched:
+                t0 = time.perf_counter()
+                fleet.update_all(updates)
+                t1 = time.perf_counter()
+                if record:
+                    latencies.append(t1 - t0)
+            else:
+                for robot, state in zip(robots, states):
+                    t0 = time.perf_counter()
+                    robot.update(state, None)
+                    t1 = time.perf_counter()
+                    if record:
+                        latencies.append(t1 - t0)
+
+            cycles += 1
+            next_cycle += period
+            delay = next_cycle - time.perf_counter()
+            if delay > 0.0:
+                time.sleep(delay)
+            else:
+                overruns += 1
+                next_cycle = time.perf_counter()
+
+        return cycles, overruns
+
+    print(f'Warming up for {args.warmup:.1f}s ...')
+    run_cycles(args.warmup, False)
+
+    print(f'Measuring for {args.duration:.1f}s ...')
+    wall_start = time.perf_counter()
+    caller_start = time.thread_time()
+    process_start = process_cpu_time()
+    cycles, overruns = run_cycles(args.duration, True)
+    process_end = process_cpu_time()
+    caller_end = time.thread_time()
+    wall_end = time.perf_counter()
+
+    report(
+        args,
+        latencies,
+        cycles,
+        overruns,
+        wall_end - wall_start,
+        caller_end - caller_start,
+        process_end - process_start,
+        commands)
+
+    running = False
+    if dispatcher is not None:
+        dispatcher.shutdown()
+        dispatcher_thread.join()
+    if schedule_thread is not None:
+        schedule_thread.join()
+
+    adapter.stop()
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
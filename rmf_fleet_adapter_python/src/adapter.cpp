@@ -13,6 +13,7 @@
 #include "rmf_fleet_adapter/agv/FleetUpdateHandle.hpp"
 #include "rmf_fleet_adapter/agv/test/MockAdapter.hpp"
 #include "rmf_fleet_adapter_python/PyRobotCommandHandle.hpp"
+#include "rmf_fleet_adapter_python/CallbackDispatcher.hpp"
 #include <rmf_fleet_adapter/agv/Transformation.hpp>
 #include <rmf_fleet_adapter/agv/Waypoint.hpp>
 #include <rclcpp/rclcpp.hpp>
@@ -237,19 +238,22 @@ PYBIND11_MODULE(rmf_adapter, m) {
     py::overload_cast<std::size_t, double>(
       &agv::RobotUpdateHandle::update_position),
     py::arg("waypoint"),
-    py::arg("orientation"))
+    py::arg("orientation"),
+    py::call_guard<py::gil_scoped_release>())
   .def("update_current_lanes",
     py::overload_cast<const Eigen::Vector3d&,
     const std::vector<std::size_t>&>(
       &agv::RobotUpdateHandle::update_position),
     py::arg("position"),
-    py::arg("lanes"))
+    py::arg("lanes"),
+    py::call_guard<py::gil_scoped_release>())
   .def("update_off_grid_position",
     py::overload_cast<const Eigen::Vector3d&,
     std::size_t>(
       &agv::RobotUpdateHandle::update_position),
     py::arg("position"),
-    py::arg("target_waypoint"))
+    py::arg("target_waypoint"),
+    py::call_guard<py::gil_scoped_release>())
   .def("update_lost_position",
     py::overload_cast<const std::string&,
     const Eigen::Vector3d&,
@@ -261,11 +265,13 @@ PYBIND11_MODULE(rmf_adapter, m) {
     py::arg("position"),
     py::arg("max_merge_waypoint_distance") = 0.1,
     py::arg("max_merge_lane_distance") = 1.0,
-    py::arg("min_lane_length") = 1e-8)
+    py::arg("min_lane_length") = 1e-8,
+    py::call_guard<py::gil_scoped_release>())
   .def("update_position",
     py::overload_cast<rmf_traffic::agv::Plan::StartSet>(
       &agv::RobotUpdateHandle::update_position),
-    py::arg("start_set"))
+    py::arg("start_set"),
+    py::call_guard<py::gil_scoped_release>())
   .def("use_parking_reservation_system", &agv::RobotUpdateHandle::use_parking_reservation_system,
     py::arg("enable"))
   .def("set_charger_waypoint", &agv::RobotUpdateHandle::set_charger_waypoint,
@@ -273,7 +279,8 @@ PYBIND11_MODULE(rmf_adapter, m) {
   .def("set_finishing_request", &agv::RobotUpdateHandle::set_finishing_request,
     py::arg("finishing_request"))
   .def("update_battery_soc", &agv::RobotUpdateHandle::update_battery_soc,
-    py::arg("battery_soc"))
+    py::arg("battery_soc"),
+    py::call_guard<py::gil_scoped_release>())
   .def("override_status", &agv::RobotUpdateHandle::override_status,
     py::arg("new_status"))
   .def_property("maximum_delay",
@@ -483,6 +490,7 @@ PYBIND11_MODULE(rmf_adapter, m) {
   .def("finished", &ActionExecution::finished)
   .def("okay", &ActionExecution::okay)
   .def("set_automatic_cancel", &ActionExecution::set_automatic_cancel, py::arg("on"))
+  .def("next_action", &ActionExecution::next_action)
   .def_property_readonly("identifier", &ActionExecution::identifier);
 
   // ROBOT INTERRUPTION   ====================================================
@@ -669,6 +677,22 @@ PYBIND11_MODULE(rmf_adapter, m) {
     "Specify a period for how often the fleet state message is published for\
      this fleet. Passing in None will disable the fleet state message\
      publishing. The default value is 1s")
+  .def("fleet_state_update_change_detection",
+    &agv::FleetUpdateHandle::fleet_state_update_change_detection,
+    py::arg("heartbeat_period"),
+    py::arg("position_threshold") = 0.05,
+    py::arg("yaw_threshold") = 0.05,
+    py::arg("battery_threshold") = 0.01,
+    "Only send fleet state updates when a robot's state has changed or the\
+     heartbeat period has passed. Passing None for the heartbeat period\
+     sends every update, which is the default")
+  .def("fleet_state_activity_periods",
+    &agv::FleetUpdateHandle::fleet_state_activity_periods,
+    py::arg("idle_period"),
+    py::arg("charging_period"),
+    "Refresh the states of idle and charging robots at these periods instead\
+     of every time the fleet state is published. Passing None refreshes\
+     those robots every time, which is the default")
   .def("set_update_listener",
     &agv::FleetUpdateHandle::set_update_listener,
     py::arg("listener"),
@@ -754,7 +778,81 @@ PYBIND11_MODULE(rmf_adapter, m) {
   .def("reassign_dispatched_tasks",
     &agv::FleetUpdateHandle::reassign_dispatched_tasks)
   .def("set_planner_cache_reset_size",
-    &agv::FleetUpdateHandle::set_planner_cache_reset_size);
+    &agv::FleetUpdateHandle::set_planner_cache_reset_size)
+  .def("set_planner_warm_start_file",
+    &agv::FleetUpdateHandle::set_planner_warm_start_file,
+    py::arg("filename"))
+  .def("set_planner_goal_warmup",
+    &agv::FleetUpdateHandle::set_planner_goal_warmup,
+    py::arg("max_goals"))
+  .def("set_floor_restricted_planning",
+    &agv::FleetUpdateHandle::set_floor_restricted_planning,
+    py::arg("max_planners"))
+  .def("set_memory_caps",
+    &agv::FleetUpdateHandle::set_memory_caps,
+    py::arg("max_bid_assignments"),
+    py::arg("max_executed_tasks") = 100,
+    py::arg("max_unsent_log_entries") = std::nullopt)
+  .def("set_action_pipelining",
+    &agv::FleetUpdateHandle::set_action_pipelining,
+    py::arg("enabled"))
+  .def("set_task_queue_backup_file",
+    &agv::FleetUpdateHandle::set_task_queue_backup_file,
+    py::arg("filename"),
+    py::arg("period") = rmf_traffic::Duration(std::chrono::seconds(5)),
+    "Back up the task queues of the robots to this file and restore them\
+     from it after a restart. Passing None stops the backups, which is the\
+     default")
+  .def("set_charging_schedule_file",
+    &agv::FleetUpdateHandle::set_charging_schedule_file,
+    py::arg("filename"),
+    "Follow the charger rotation in this rmf_charging_schedule file and plan\
+     tasks with the chargers it will assign. Passing None stops following a\
+     schedule, which is the default")
+  .def("set_negotiation_evaluator_params",
+    &agv::FleetUpdateHandle::set_negotiation_evaluator_params,
+    py::arg("compliant_leeway_base"),
+    py::arg("compliant_leeway_multiplier"),
+    py::arg("estimate_leeway"),
+    py::arg("max_cost_threshold"),
+    py::arg("adaptive") = false)
+  .def("set_anytime_planning_deadline",
+    &agv::FleetUpdateHandle::set_anytime_planning_deadline,
+    py::arg("deadline"))
+  .def("set_delay_reporting",
+    &agv::FleetUpdateHandle::set_delay_reporting,
+    py::arg("threshold"),
+    py::arg("min_period") = std::nullopt)
+  .def("set_travel_time_precomputation",
+    &agv::FleetUpdateHandle::set_travel_time_precomputation,
+    py::arg("enabled"))
+  .def("set_emergency_pullover_precomputation",
+    &agv::FleetUpdateHandle::set_emergency_pullover_precomputation,
+    py::arg("max_candidates"))
+  .def("set_max_concurrent_bids",
+    &agv::FleetUpdateHandle::set_max_concurrent_bids,
+    py::arg("max_bids"))
+  .def("set_allocation_threads",
+    &agv::FleetUpdateHandle::set_allocation_threads,
+    py::arg("threads"))
+  .def("set_incremental_reassignment",
+    &agv::FleetUpdateHandle::set_incremental_reassignment,
+    py::arg("max_robots"),
+    py::arg("time_budget") = rmf_traffic::time::from_seconds(5.0))
+  .def("set_outgoing_validation_sample_period",
+    &agv::FleetUpdateHandle::set_outgoing_validation_sample_period,
+    py::arg("sample_period"))
+  .def("set_task_state_publish_interval",
+    &agv::FleetUpdateHandle::set_task_state_publish_interval,
+    py::arg("interval"))
+  .def("set_lane_closure_planner_cache_size",
+    &agv::FleetUpdateHandle::set_lane_closure_planner_cache_size,
+    py::arg("size"))
+  .def("interrupt_robots",
+    &agv::FleetUpdateHandle::interrupt_robots,
+    py::arg("labels"),
+    py::arg("robot_names"),
+    py::arg("robots_are_interrupted"));
 
   // TASK REQUEST CONFIRMATION ===============================================
   auto m_fleet_update_handle = m.def_submodule("fleet_update_handle");
@@ -782,6 +880,13 @@ PYBIND11_MODULE(rmf_adapter, m) {
       return self.errors();
     });
 
+  // FLEET INTERRUPTION ================================================
+  py::class_<agv::FleetUpdateHandle::Interruption>(
+    m_fleet_update_handle, "FleetInterruption")
+  .def("resume",
+    &agv::FleetUpdateHandle::Interruption::resume,
+    py::arg("labels"));
+
   // SPEED LIMIT REQUEST ===============================================
   py::class_<agv::FleetUpdateHandle::SpeedLimitRequest>(
     m_fleet_update_handle, "SpeedLimitRequest")
@@ -900,8 +1005,11 @@ PYBIND11_MODULE(rmf_adapter, m) {
     py::arg("node_options") = rclcpp::NodeOptions(),
     py::arg("wait_time") = rmf_utils::optional<rmf_traffic::Duration>(
       rmf_utils::nullopt))
+  .def_static("make_sharing", &agv::Adapter::make_sharing,
+    py::arg("other"))
   .def("add_easy_fleet", &agv::Adapter::add_easy_fleet,
-    py::arg("configuration"))
+    py::arg("configuration"),
+    py::call_guard<py::gil_scoped_release>())
   .def("add_fleet", &agv::Adapter::add_fleet,
     py::arg("fleet_name"),
     py::arg("traits"),
@@ -957,6 +1065,10 @@ PYBIND11_MODULE(rmf_adapter, m) {
   py::class_<agv::EasyFullControl, std::shared_ptr<agv::EasyFullControl>>(
     m, "EasyFullControl")
   .def("add_robot", &agv::EasyFullControl::add_robot)
+  .def("update_all",
+    &agv::EasyFullControl::update_all,
+    py::arg("updates"),
+    py::call_guard<py::gil_scoped_release>())
   .def("more", [](agv::EasyFullControl& self)
     {
       return self.more();
@@ -968,7 +1080,8 @@ PYBIND11_MODULE(rmf_adapter, m) {
     agv::EasyFullControl::EasyRobotUpdateHandle,
     std::shared_ptr<agv::EasyFullControl::EasyRobotUpdateHandle>
   >(m_easy_full_control, "EasyRobotUpdateHandle")
-  .def("update", &agv::EasyFullControl::EasyRobotUpdateHandle::update)
+  .def("update", &agv::EasyFullControl::EasyRobotUpdateHandle::update,
+    py::call_guard<py::gil_scoped_release>())
   .def("max_merge_waypoint_distance", &agv::EasyFullControl::EasyRobotUpdateHandle::max_merge_waypoint_distance)
   .def("set_max_merge_waypoint_distance", &agv::EasyFullControl::EasyRobotUpdateHandle::set_max_merge_waypoint_distance)
   .def("max_merge_lane_distance", &agv::EasyFullControl::EasyRobotUpdateHandle::max_merge_lane_distance)
@@ -1001,6 +1114,24 @@ PYBIND11_MODULE(rmf_adapter, m) {
     &agv::EasyFullControl::RobotState::battery_state_of_charge,
     &agv::EasyFullControl::RobotState::set_battery_state_of_charge);
 
+  py::class_<agv::EasyFullControl::RobotStateUpdate>(m_easy_full_control, "RobotStateUpdate")
+  .def(py::init<
+      std::shared_ptr<agv::EasyFullControl::EasyRobotUpdateHandle>,
+      agv::EasyFullControl::RobotState,
+      agv::EasyFullControl::ConstActivityIdentifierPtr>(),
+    py::arg("robot"),
+    py::arg("state"),
+    py::arg("current_activity") = nullptr)
+  .def_property_readonly(
+    "robot",
+    &agv::EasyFullControl::RobotStateUpdate::robot)
+  .def_property_readonly(
+    "state",
+    &agv::EasyFullControl::RobotStateUpdate::state)
+  .def_property_readonly(
+    "current_activity",
+    &agv::EasyFullControl::RobotStateUpdate::current_activity);
+
   py::class_<agv::EasyFullControl::RobotConfiguration>(m_easy_full_control, "RobotConfiguration")
   .def(py::init<std::vector<std::string>>(),
     py::arg("compatible_chargers"))
@@ -1013,6 +1144,14 @@ PYBIND11_MODULE(rmf_adapter, m) {
     &agv::EasyFullControl::RobotConfiguration::finishing_request,
     &agv::EasyFullControl::RobotConfiguration::set_finishing_request);
 
+  py::class_<CallbackDispatcher, std::shared_ptr<CallbackDispatcher>>(
+    m_easy_full_control, "CallbackDispatcher")
+  .def(py::init<>())
+  .def("dispatch", &CallbackDispatcher::dispatch,
+    py::arg("timeout") = std::nullopt)
+  .def("shutdown", &CallbackDispatcher::shutdown)
+  .def_property_readonly("is_shutdown", &CallbackDispatcher::is_shutdown);
+
   py::class_<agv::EasyFullControl::RobotCallbacks>(m_easy_full_control, "RobotCallbacks")
   .def(py::init<
       agv::EasyFullControl::NavigationRequest,
@@ -1021,6 +1160,33 @@ PYBIND11_MODULE(rmf_adapter, m) {
     py::arg("navigate"),
     py::arg("stop"),
     py::arg("action_executor"))
+  // Queue the commands on a dispatcher so that a Python thread can handle
+  // them in batches with CallbackDispatcher.dispatch()
+  .def(py::init(
+      [](
+        py::function navigate,
+        py::function stop,
+        py::function action_executor,
+        std::shared_ptr<CallbackDispatcher> dispatcher)
+      {
+        return agv::EasyFullControl::RobotCallbacks(
+          CallbackDispatcher::wrap<
+            agv::EasyFullControl::Destination,
+            agv::EasyFullControl::CommandExecution>(
+            dispatcher, std::move(navigate)),
+          CallbackDispatcher::wrap<
+            agv::EasyFullControl::ConstActivityIdentifierPtr>(
+            dispatcher, std::move(stop)),
+          CallbackDispatcher::wrap<
+            const std::string&,
+            const nlohmann::json&,
+            ActionExecution>(
+            dispatcher, std::move(action_executor)));
+      }),
+    py::arg("navigate"),
+    py::arg("stop"),
+    py::arg("action_executor"),
+    py::arg("dispatcher"))
   .def_property_readonly(
     "navigate",
     &agv::EasyFullControl::RobotCallbacks::navigate)
@@ -1279,5 +1445,7 @@ PYBIND11_MODULE(rmf_adapter, m) {
   .def_property_readonly("scale", &agv::Transformation::scale)
   .def_property_readonly("translation", &agv::Transformation::translation)
   .def("apply", &agv::Transformation::apply)
-  .def("apply_inverse", &agv::Transformation::apply_inverse);
+  .def("apply_inverse", &agv::Transformation::apply_inverse)
+  .def("apply_all", &agv::Transformation::apply_all)
+  .def("apply_inverse_all", &agv::Transformation::apply_inverse_all);
 }
@@ -1,6 +1,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/chrono.h>
 #include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
 #include <memory>
@@ -22,8 +23,32 @@ using Lane = rmf_traffic::agv::Graph::Lane;
 
 using OrientationConstraint = Graph::OrientationConstraint;
 
+// One row of Graph.waypoint_array()
+struct WaypointRecord
+{
+  uint64_t index;
+  double x;
+  double y;
+  bool holding_point;
+  bool passthrough_point;
+  bool parking_spot;
+  bool charger;
+};
+
+// One row of Graph.lane_array()
+struct LaneRecord
+{
+  uint64_t index;
+  uint64_t entry;
+  uint64_t exit;
+};
+
 void bind_graph(py::module& m)
 {
+  PYBIND11_NUMPY_DTYPE(WaypointRecord,
+    index, x, y, holding_point, passthrough_point, parking_spot, charger);
+  PYBIND11_NUMPY_DTYPE(LaneRecord, index, entry, exit);
+
   auto m_graph = m.def_submodule("graph");
   py::class_<Graph::LiftProperties,
     std::shared_ptr<Graph::LiftProperties>>(m_graph, "LiftProperties")
@@ -193,6 +218,44 @@ void bind_graph(py::module& m)
       &Graph::lane_from, py::const_),
     py::return_value_policy::reference_internal)
   .def_property_readonly("num_lanes", &Graph::num_lanes)
+
+  // Structured NumPy arrays of the whole graph, filled in one pass without
+  // creating a Python object for each waypoint or lane
+  .def("waypoint_array", [](const Graph& self)
+    {
+      py::array_t<WaypointRecord> array(self.num_waypoints());
+      auto rows = array.mutable_unchecked<1>();
+      for (std::size_t i = 0; i < self.num_waypoints(); ++i)
+      {
+        const auto& wp = self.get_waypoint(i);
+        const Eigen::Vector2d& p = wp.get_location();
+        rows(i) = WaypointRecord{
+          wp.index(),
+          p.x(),
+          p.y(),
+          wp.is_holding_point(),
+          wp.is_passthrough_point(),
+          wp.is_parking_spot(),
+          wp.is_charger()
+        };
+      }
+      return array;
+    })
+  .def("lane_array", [](const Graph& self)
+    {
+      py::array_t<LaneRecord> array(self.num_lanes());
+      auto rows = array.mutable_unchecked<1>();
+      for (std::size_t i = 0; i < self.num_lanes(); ++i)
+      {
+        const auto& lane = self.get_lane(i);
+        rows(i) = LaneRecord{
+          lane.index(),
+          lane.entry().waypoint_index(),
+          lane.exit().waypoint_index()
+        };
+      }
+      return array;
+    })
   .def("lanes_from_waypoint",
     py::overload_cast<std::size_t>(&Graph::lanes_from, py::const_),
     py::arg("wp_index"))
@@ -202,5 +265,15 @@ void bind_graph(py::module& m)
 
   // PARSE GRAPH ==============================================================
   // Helper function to parse a graph from a yaml file
-  m_graph.def("parse_graph", &rmf_fleet_adapter::agv::parse_graph);
+  m_graph.def("parse_graph",
+    py::overload_cast<const std::string&,
+    const rmf_traffic::agv::VehicleTraits&>(
+      &rmf_fleet_adapter::agv::parse_graph));
+  m_graph.def("parse_graph",
+    py::overload_cast<const std::string&,
+    const rmf_traffic::agv::VehicleTraits&, const std::string&>(
+      &rmf_fleet_adapter::agv::parse_graph),
+    py::arg("filename"),
+    py::arg("vehicle_traits"),
+    py::arg("cache_file"));
 }
@@ -1,6 +1,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/chrono.h>
 #include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
 #include "rmf_traffic_ros2/Time.hpp"
@@ -24,6 +25,41 @@ using Interpolate = rmf_traffic::agv::Interpolate;
 using TimePoint = std::chrono::time_point<std::chrono::system_clock,
     std::chrono::nanoseconds>;
 
+// One row of Plan.waypoint_array(). The time is in nanoseconds since the
+// epoch, and graph_index is -1 for waypoints that are not on the graph.
+struct PlanWaypointRecord
+{
+  int64_t time;
+  double x;
+  double y;
+  double yaw;
+  int64_t graph_index;
+  uint64_t itinerary_index;
+  uint64_t trajectory_index;
+};
+
+py::array_t<PlanWaypointRecord> make_waypoint_array(
+  const std::vector<Plan::Waypoint>& waypoints)
+{
+  py::array_t<PlanWaypointRecord> array(waypoints.size());
+  auto rows = array.mutable_unchecked<1>();
+  for (std::size_t i = 0; i < waypoints.size(); ++i)
+  {
+    const auto& wp = waypoints[i];
+    const Eigen::Vector3d& p = wp.position();
+    rows(i) = PlanWaypointRecord{
+      wp.time().time_since_epoch().count(),
+      p.x(),
+      p.y(),
+      p.z(),
+      wp.graph_index().has_value() ? int64_t(*wp.graph_index()) : -1,
+      wp.itinerary_index(),
+      wp.trajectory_index()
+    };
+  }
+  return array;
+}
+
 // NOTE(CH3):
 // Factory method for Start() to allow passing in of system_clock::time_points,
 // as Start objects are constructed using steady_clock::time_points
@@ -55,6 +91,9 @@ Planner make_planner(Configuration config)
 
 void bind_plan(py::module& m)
 {
+  PYBIND11_NUMPY_DTYPE(PlanWaypointRecord,
+    time, x, y, yaw, graph_index, itinerary_index, trajectory_index);
+
   auto m_plan = m.def_submodule("plan");
 
   // PLANNER ===================================================================
@@ -125,7 +164,11 @@ void bind_plan(py::module& m)
   .def_property_readonly("waypoints",
     &Plan::get_waypoints)
   .def_property_readonly("start",
-    &Plan::get_start);
+    &Plan::get_start)
+  .def("waypoint_array", [](const Plan& self)
+    {
+      return make_waypoint_array(self.get_waypoints());
+    });
 
   // WAYPOINT ==================================================================
   py::class_<Plan::Waypoint>(m_plan, "Waypoint")
@@ -194,6 +237,18 @@ void bind_plan(py::module& m)
 
     },
     py::arg("start"), py::arg("goal"),
-    py::return_value_policy::reference_internal);
+    py::return_value_policy::reference_internal)
+  .def("get_plan_waypoint_array",
+    [&](Planner& self,
+    Start start,
+    Goal goal)
+    {
+      const auto result = self.plan(start, goal);
+      if (result.success())
+        return make_waypoint_array(result->get_waypoints());
+
+      return make_waypoint_array({});
+    },
+    py::arg("start"), py::arg("goal"));
 
 }
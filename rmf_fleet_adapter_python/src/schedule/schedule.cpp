@@ -1,5 +1,6 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
 #include <pybind11/chrono.h>
 #include <pybind11/stl.h>
 
@@ -19,9 +20,29 @@ rmf_traffic::Time to_rmf_time(SystemTimePoint time)
   return rmf_traffic::Time(time.time_since_epoch());
 }
 
+// One row of Trajectory.to_array(). The time is in seconds, the same as
+// Trajectory.time().
+struct TrajectoryWaypointRecord
+{
+  double time;
+  double x;
+  double y;
+  double yaw;
+  double vx;
+  double vy;
+  double vyaw;
+};
+
+// Positions given as an N x 3 array
+using PositionArray =
+  Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>;
+
 //==============================================================================
 void bind_schedule(py::module& m)
 {
+  PYBIND11_NUMPY_DTYPE(TrajectoryWaypointRecord,
+    time, x, y, yaw, vx, vy, vyaw);
+
   auto m_schedule = m.def_submodule("schedule");
 
   /// PARTICIPANT ==============================================================
@@ -70,6 +91,26 @@ void bind_schedule(py::module& m)
       rmf_traffic::Trajectory>(&rmf_traffic::Route::trajectory));
 
   // MAKE TRAJECTORY FUNCTION ==================================================
+  // A NumPy array of positions is read in place instead of being converted
+  // into a list of vectors one element at a time.
+  m_schedule.def(
+    "make_trajectory",
+    [](const rmf_traffic::agv::VehicleTraits& traits,
+    SystemTimePoint start_time,
+    const Eigen::Ref<const PositionArray>& input_positions)
+    {
+      std::vector<Eigen::Vector3d> positions;
+      positions.reserve(input_positions.rows());
+      for (Eigen::Index i = 0; i < input_positions.rows(); ++i)
+        positions.push_back(input_positions.row(i).transpose());
+
+      return rmf_traffic::agv::Interpolate::positions(
+        traits, to_rmf_time(start_time), positions);
+    },
+    py::arg("traits"),
+    py::arg("start_time"),
+    py::arg("input_positions").noconvert());
+
   m_schedule.def(
     "make_trajectory",
     [](const rmf_traffic::agv::VehicleTraits& traits,
@@ -117,5 +158,22 @@ void bind_schedule(py::module& m)
       return rmf_traffic::time::to_seconds(
         self.at(index).time().time_since_epoch());
     },
-    py::arg("index"));
+    py::arg("index"))
+  .def("to_array", [](const rmf_traffic::Trajectory& self)
+    {
+      py::array_t<TrajectoryWaypointRecord> array(self.size());
+      auto rows = array.mutable_unchecked<1>();
+      std::size_t i = 0;
+      for (const auto& wp : self)
+      {
+        const Eigen::Vector3d p = wp.position();
+        const Eigen::Vector3d v = wp.velocity();
+        rows(i++) = TrajectoryWaypointRecord{
+          rmf_traffic::time::to_seconds(wp.time().time_since_epoch()),
+          p.x(), p.y(), p.z(),
+          v.x(), v.y(), v.z()
+        };
+      }
+      return array;
+    });
 }
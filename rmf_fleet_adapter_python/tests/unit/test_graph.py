@@ -279,6 +279,16 @@ def test_graph():
     # Remember waypoint 0 counts as one waypoint also!
     assert rawr_graph.num_waypoints == 11
 
+    # Test the waypoint array
+    waypoints = rawr_graph.waypoint_array()
+    assert waypoints.shape == (11,)
+    assert np.array_equal(waypoints["index"], np.arange(11))
+    assert waypoints[2]["x"] == 5.0 and waypoints[2]["y"] == -5.0
+    assert waypoints[8]["holding_point"]
+    assert waypoints[9]["passthrough_point"]
+    assert waypoints[10]["parking_spot"]
+    assert not waypoints[10]["holding_point"]
+
     # Test keys
     assert not rawr_graph.keys and type(rawr_graph.keys) is dict
 
@@ -27,9 +27,19 @@
 #include <rmf_reservation_msgs/msg/claim_request.hpp>
 #include <rmf_fleet_adapter/StandardNames.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <limits>
+#include <numeric>
+#include <set>
 #include <sstream>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 using namespace rmf_fleet_adapter;
@@ -79,6 +89,15 @@ public:
     return ticket;
   }
 
+  /// Bring back a ticket that was handed out before a restart
+  void restore_ticket(
+    const std::size_t index,
+    const rmf_reservation_msgs::msg::RequestHeader& request_header)
+  {
+    _ticket_to_header[index] = request_header;
+    _next_ticket_id = std::max(_next_ticket_id, index + 1);
+  }
+
   std::string debug_ticket(const std::size_t index)
   {
     auto ticket = get_existing_ticket(index);
@@ -118,21 +137,69 @@ struct LocationReq
 /// Implements a simple Mutex. Only one robot can claim a location at a time.
 /// The current implementation is relatively simplistic and basically checks
 /// if a location is occupied or not. A queuing system is in the works.
+///
+/// The free locations are kept in their own index so that claiming and
+/// releasing only touch the locations involved, and listing the free
+/// locations does not need to look at the occupied ones.
 class CurrentState
 {
 public:
   /// Get list of free locations
   std::vector<std::string> free_locations() const
   {
-    std::vector<std::string> locations;
-    for (auto&[loc, state] : _current_location_reservations)
+    return std::vector<std::string>(
+      _free_locations.begin(), _free_locations.end());
+  }
+
+  /// Check if a location has been added or claimed before
+  bool has_location(const std::string& location) const
+  {
+    return _current_location_reservations.count(location) > 0;
+  }
+
+  /// Get the location that a ticket is holding, if any
+  std::optional<std::string> location_of(const std::size_t ticket_id) const
+  {
+    auto location = _ticket_to_location.find(ticket_id);
+    if (location == _ticket_to_location.end())
     {
-      if (!state.ticket.has_value())
-      {
-        locations.push_back(loc);
-      }
+      return std::nullopt;
     }
-    return locations;
+    return location->second;
+  }
+
+  /// Get every known location with the ticket that is holding it
+  const std::unordered_map<std::string, LocationState>& reservations() const
+  {
+    return _current_location_reservations;
+  }
+
+  /// Check if a ticket could be given this location right now. Locations that
+  /// are not in the list are fine to occupy, like in
+  /// allocate_lowest_cost_free_spot.
+  bool is_available(const std::string& location) const
+  {
+    auto parking = _current_location_reservations.find(location);
+    return parking == _current_location_reservations.end()
+      || !parking->second.ticket.has_value();
+  }
+
+  /// Locations that became free or were taken since the last call. A location
+  /// that was taken and freed again in between is in neither list.
+  struct Changes
+  {
+    std::vector<std::string> freed;
+    std::vector<std::string> taken;
+  };
+
+  Changes take_changes()
+  {
+    Changes changes;
+    changes.freed.assign(_freed_since.begin(), _freed_since.end());
+    changes.taken.assign(_taken_since.begin(), _taken_since.end());
+    _freed_since.clear();
+    _taken_since.clear();
+    return changes;
   }
 
   void add_location(std::shared_ptr<rclcpp::Node> node, std::string location)
@@ -147,6 +214,8 @@ public:
     {
       _current_location_reservations.emplace(location,
         LocationState {std::nullopt});
+      _free_locations.insert(location);
+      _mark_freed(location);
     }
     else
     {
@@ -171,30 +240,36 @@ public:
       release(ticket_id);
     }
 
-    std::unordered_map<std::string, std::size_t> positions;
-    for (std::size_t i = 0; i < requests.size(); ++i)
-    {
-      positions[requests[i].location] = i;
-    }
+    // Visit the requests from cheapest to most expensive without losing
+    // track of their positions in the original list.
+    std::vector<std::size_t> order(requests.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+      [&requests](std::size_t a, std::size_t b)
+      {
+        return requests[a] < requests[b];
+      });
 
-    std::sort(requests.begin(), requests.end());
-    for (std::size_t i = 0; i < requests.size(); i++)
+    for (const std::size_t i : order)
     {
-      auto parking = _current_location_reservations.find(requests[i].location);
+      const auto& location = requests[i].location;
+      auto parking = _current_location_reservations.find(location);
       if (parking == _current_location_reservations.end())
       {
         // New parking spot not in list. Should be fine to occupy.
-        _current_location_reservations[requests[i].location] =
-          LocationState {ticket_id};
-        _ticket_to_location.emplace(ticket_id, requests[i].location);
-        return positions[requests[i].location];
+        _current_location_reservations.emplace(
+          location, LocationState {ticket_id});
+        _ticket_to_location.emplace(ticket_id, location);
+        return i;
       }
       else if (!parking->second.ticket.has_value())
       {
         // Existing parking spot.
-        _current_location_reservations[requests[i].location].ticket = ticket_id;
-        _ticket_to_location.emplace(ticket_id, requests[i].location);
-        return positions[parking->first];
+        parking->second.ticket = ticket_id;
+        _free_locations.erase(location);
+        _mark_taken(location);
+        _ticket_to_location.emplace(ticket_id, location);
+        return i;
       }
     }
 
@@ -218,13 +293,38 @@ public:
     }
     auto location = _ticket->second;
     _current_location_reservations[location].ticket = std::nullopt;
+    if (_free_locations.insert(location).second)
+    {
+      _mark_freed(location);
+    }
     _ticket_to_location.erase(_ticket);
     return {location};
   }
 
 private:
+  void _mark_freed(const std::string& location)
+  {
+    if (_taken_since.erase(location) == 0)
+    {
+      _freed_since.insert(location);
+    }
+  }
+
+  void _mark_taken(const std::string& location)
+  {
+    if (_freed_since.erase(location) == 0)
+    {
+      _taken_since.insert(location);
+    }
+  }
+
   std::unordered_map<std::string, LocationState> _current_location_reservations;
   std::unordered_map<std::size_t, std::string> _ticket_to_location;
+  /// Every location in _current_location_reservations without a ticket. This
+  /// is ordered so that the published list of free spots is stable.
+  std::set<std::string> _free_locations;
+  std::set<std::string> _freed_since;
+  std::set<std::string> _taken_since;
 };
 
 
@@ -265,6 +365,18 @@ public:
     indices.erase(idx);
   }
 
+  // Gives every item in the order that they were added.
+  std::vector<T> items() const
+  {
+    std::vector<T> output;
+    output.reserve(indices.size());
+    for (const auto idx : indices)
+    {
+      output.push_back(index_to_item.at(idx));
+    }
+    return output;
+  }
+
   // Gives the most recent item in the queue.
   // Returns nullopt if the queue is empty.
   std::optional<T> front()
@@ -295,6 +407,10 @@ class ServiceQueueManager
 {
   std::unordered_map<std::string,
     ItemQueue<std::size_t>> resource_queues;
+  /// The resources whose queues each ticket is waiting in, so removing a
+  /// ticket only visits those queues.
+  std::unordered_map<std::size_t,
+    std::unordered_set<std::string>> ticket_resources;
 public:
   /// Service
   std::optional<std::size_t> service_next_in_queue(const std::string& resource)
@@ -312,21 +428,398 @@ public:
   void add_to_queue(
     std::size_t ticket, std::vector<std::string>& resources)
   {
+    auto& waiting_in = ticket_resources[ticket];
     for (auto resource: resources)
     {
       resource_queues[resource].add(ticket);
+      waiting_in.insert(resource);
     }
   }
 
   void remove_ticket(std::size_t ticket)
   {
-    for (auto& [_, resource_queue]: resource_queues)
+    auto waiting_in = ticket_resources.find(ticket);
+    if (waiting_in == ticket_resources.end())
+    {
+      return;
+    }
+
+    for (const auto& resource: waiting_in->second)
+    {
+      auto resource_queue = resource_queues.find(resource);
+      if (resource_queue != resource_queues.end())
+      {
+        resource_queue->second.remove_item(ticket);
+      }
+    }
+    ticket_resources.erase(waiting_in);
+  }
+
+  /// Get the tickets waiting for each resource, oldest first
+  std::vector<std::pair<std::string, std::vector<std::size_t>>> queues() const
+  {
+    std::vector<std::pair<std::string, std::vector<std::size_t>>> output;
+    for (const auto& [resource, resource_queue] : resource_queues)
+    {
+      auto tickets = resource_queue.items();
+      if (!tickets.empty())
+      {
+        output.emplace_back(resource, std::move(tickets));
+      }
+    }
+    return output;
+  }
+
+  /// Put back the tickets that were waiting for a resource before a restart
+  void restore_queue(
+    const std::string& resource,
+    const std::vector<std::size_t>& tickets)
+  {
+    for (const auto ticket : tickets)
+    {
+      resource_queues[resource].add(ticket);
+      ticket_resources[ticket].insert(resource);
+    }
+  }
+};
+
+/// An append-only file of the changes made to the reservation state, so that
+/// the node can pick up where it left off after a restart instead of every
+/// fleet adapter having to request its reservations again. Each line is a
+/// record of space-separated fields with the strings quoted. The file is
+/// rewritten from time to time as the smallest set of records that produce
+/// the current state, which serves as a snapshot for the records that follow.
+class Journal
+{
+public:
+  Journal(std::string path)
+  : _path(std::move(path))
+  {
+    _out.open(_path, std::ios::app);
+  }
+
+  bool is_open() const
+  {
+    return _out.is_open();
+  }
+
+  /// Read every record in the file
+  std::vector<std::string> read() const
+  {
+    std::vector<std::string> records;
+    std::ifstream in(_path);
+    std::string line;
+    while (std::getline(in, line))
+    {
+      if (!line.empty())
+      {
+        records.push_back(std::move(line));
+      }
+    }
+    return records;
+  }
+
+  void append(const std::string& record)
+  {
+    _out << record << '\n';
+    _out.flush();
+    ++_appended;
+  }
+
+  /// Number of records appended since the file was last rewritten
+  std::size_t appended() const
+  {
+    return _appended;
+  }
+
+  /// Replace the contents of the file. The new contents are written next to
+  /// it first, so a crash part way through leaves the old file intact.
+  bool rewrite(const std::vector<std::string>& records)
+  {
+    const std::string tmp = _path + ".tmp";
+    {
+      std::ofstream out(tmp, std::ios::trunc);
+      for (const auto& record : records)
+      {
+        out << record << '\n';
+      }
+
+      out.flush();
+      if (!out)
+      {
+        return false;
+      }
+    }
+
+    _out.close();
+    const bool renamed = std::rename(tmp.c_str(), _path.c_str()) == 0;
+    _out.open(_path, std::ios::app);
+    if (renamed)
+    {
+      _appended = 0;
+    }
+    return renamed;
+  }
+
+private:
+  std::string _path;
+  std::ofstream _out;
+  std::size_t _appended = 0;
+};
+
+/// Write the fields of a journal record
+class RecordWriter
+{
+public:
+  RecordWriter(const std::string& op)
+  {
+    _ss << op;
+  }
+
+  RecordWriter& operator<<(const std::string& value)
+  {
+    _ss << ' ' << std::quoted(value);
+    return *this;
+  }
+
+  RecordWriter& operator<<(const std::size_t value)
+  {
+    _ss << ' ' << value;
+    return *this;
+  }
+
+  RecordWriter& operator<<(const std::vector<std::string>& values)
+  {
+    _ss << ' ' << values.size();
+    for (const auto& value : values)
+    {
+      _ss << ' ' << std::quoted(value);
+    }
+    return *this;
+  }
+
+  RecordWriter& operator<<(const std::vector<std::size_t>& values)
+  {
+    _ss << ' ' << values.size();
+    for (const auto value : values)
+    {
+      _ss << ' ' << value;
+    }
+    return *this;
+  }
+
+  RecordWriter& operator<<(const std::vector<LocationReq>& locations)
+  {
+    _ss << ' ' << locations.size();
+    for (const auto& location : locations)
+    {
+      _ss << ' ' << std::quoted(location.location)
+          << ' ' << std::setprecision(17) << location.cost;
+    }
+    return *this;
+  }
+
+  std::string str() const
+  {
+    return _ss.str();
+  }
+
+private:
+  std::ostringstream _ss;
+};
+
+/// Read the fields of a journal record. Reading past the end or a malformed
+/// field leaves the reader failed.
+class RecordReader
+{
+public:
+  RecordReader(const std::string& record)
+  : _ss(record)
+  {
+    _ss >> _op;
+  }
+
+  const std::string& op() const
+  {
+    return _op;
+  }
+
+  bool ok() const
+  {
+    return !_ss.fail();
+  }
+
+  RecordReader& operator>>(std::string& value)
+  {
+    _ss >> std::quoted(value);
+    return *this;
+  }
+
+  RecordReader& operator>>(std::size_t& value)
+  {
+    _ss >> value;
+    return *this;
+  }
+
+  RecordReader& operator>>(std::vector<std::string>& values)
+  {
+    std::size_t n = 0;
+    _ss >> n;
+    values.clear();
+    for (std::size_t i = 0; i < n && _ss; ++i)
     {
-      resource_queue.remove_item(ticket);
+      std::string value;
+      _ss >> std::quoted(value);
+      values.push_back(std::move(value));
     }
+    return *this;
   }
+
+  RecordReader& operator>>(std::vector<std::size_t>& values)
+  {
+    std::size_t n = 0;
+    _ss >> n;
+    values.clear();
+    for (std::size_t i = 0; i < n && _ss; ++i)
+    {
+      std::size_t value = 0;
+      _ss >> value;
+      values.push_back(value);
+    }
+    return *this;
+  }
+
+  RecordReader& operator>>(std::vector<LocationReq>& locations)
+  {
+    std::size_t n = 0;
+    _ss >> n;
+    locations.clear();
+    for (std::size_t i = 0; i < n && _ss; ++i)
+    {
+      LocationReq location;
+      _ss >> std::quoted(location.location) >> location.cost;
+      locations.push_back(std::move(location));
+    }
+    return *this;
+  }
+
+private:
+  std::istringstream _ss;
+  std::string _op;
 };
 
+/// Solves the assignment problem with the Hungarian method. Each row is given
+/// at most one column and each column at most one row, so that as many rows
+/// as possible get a column with a finite cost, and the total cost of those
+/// is as low as possible. Returns the column of each row, if it got one.
+/// Time complexity: O(rows^2 * columns)
+std::vector<std::optional<std::size_t>> min_cost_assignment(
+  const std::vector<std::vector<double>>& costs,
+  const std::size_t columns)
+{
+  const std::size_t rows = costs.size();
+  // The method needs at least as many columns as rows, so rows that cannot
+  // be served get padded columns of their own.
+  const std::size_t m = std::max(rows, columns);
+
+  // Infinite costs are swapped for one that is larger than any sum of finite
+  // costs, so that unserved rows are avoided before anything else.
+  double finite_total = 0.0;
+  for (const auto& row : costs)
+  {
+    for (const double cost : row)
+    {
+      if (std::isfinite(cost))
+      {
+        finite_total += std::abs(cost);
+      }
+    }
+  }
+  const double unserved = 1.0 + 2.0 * finite_total;
+
+  const auto cost_of = [&](std::size_t i, std::size_t j)
+    {
+      if (j >= columns || !std::isfinite(costs[i][j]))
+      {
+        return unserved;
+      }
+      return costs[i][j];
+    };
+
+  // Potentials and matches are 1-indexed, with 0 as a sentinel.
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  std::vector<double> u(rows + 1, 0.0);
+  std::vector<double> v(m + 1, 0.0);
+  std::vector<std::size_t> row_of_column(m + 1, 0);
+  std::vector<std::size_t> way(m + 1, 0);
+  for (std::size_t i = 1; i <= rows; ++i)
+  {
+    row_of_column[0] = i;
+    std::size_t j0 = 0;
+    std::vector<double> min_slack(m + 1, inf);
+    std::vector<bool> used(m + 1, false);
+    do
+    {
+      used[j0] = true;
+      const std::size_t i0 = row_of_column[j0];
+      double delta = inf;
+      std::size_t j1 = 0;
+      for (std::size_t j = 1; j <= m; ++j)
+      {
+        if (used[j])
+        {
+          continue;
+        }
+
+        const double slack = cost_of(i0 - 1, j - 1) - u[i0] - v[j];
+        if (slack < min_slack[j])
+        {
+          min_slack[j] = slack;
+          way[j] = j0;
+        }
+
+        if (min_slack[j] < delta)
+        {
+          delta = min_slack[j];
+          j1 = j;
+        }
+      }
+
+      for (std::size_t j = 0; j <= m; ++j)
+      {
+        if (used[j])
+        {
+          u[row_of_column[j]] += delta;
+          v[j] -= delta;
+        }
+        else
+        {
+          min_slack[j] -= delta;
+        }
+      }
+      j0 = j1;
+    } while (row_of_column[j0] != 0);
+
+    do
+    {
+      const std::size_t j1 = way[j0];
+      row_of_column[j0] = row_of_column[j1];
+      j0 = j1;
+    } while (j0 != 0);
+  }
+
+  std::vector<std::optional<std::size_t>> assignment(rows);
+  for (std::size_t j = 1; j <= columns; ++j)
+  {
+    const std::size_t i = row_of_column[j];
+    if (i != 0 && std::isfinite(costs[i - 1][j - 1]))
+    {
+      assignment[i - 1] = j - 1;
+    }
+  }
+  return assignment;
+}
+
 using namespace std::chrono_literals;
 
 class ReservationNode : public rclcpp::Node
@@ -346,20 +839,34 @@ public:
         ReservationRequestTopicName, qos,
         std::bind(&ReservationNode::on_request, this,
         std::placeholders::_1));
+    // Every claim, release and new graph is followed by publishing the spots
+    // that it freed or took.
     claim_subscription_ =
       this->create_subscription<rmf_reservation_msgs::msg::ClaimRequest>(
         ReservationClaimTopicName, qos,
-        std::bind(&ReservationNode::claim_request, this,
-        std::placeholders::_1));
+        [this](
+          const rmf_reservation_msgs::msg::ClaimRequest::ConstSharedPtr& msg)
+        {
+          claim_request(msg);
+          publish_spot_changes();
+        });
     release_subscription_ =
       this->create_subscription<rmf_reservation_msgs::msg::ReleaseRequest>(
         ReservationReleaseTopicName, qos,
-        std::bind(&ReservationNode::release, this, std::placeholders::_1));
+        [this](
+          const rmf_reservation_msgs::msg::ReleaseRequest::ConstSharedPtr& msg)
+        {
+          release(msg);
+          publish_spot_changes();
+        });
     graph_subscription_ =
       this->create_subscription<rmf_building_map_msgs::msg::Graph>(
         NavGraphTopicName, qos,
-        std::bind(&ReservationNode::received_graph, this,
-        std::placeholders::_1));
+        [this](const rmf_building_map_msgs::msg::Graph::ConstSharedPtr& msg)
+        {
+          received_graph(msg);
+          publish_spot_changes();
+        });
 
     ticket_pub_ = this->create_publisher<rmf_reservation_msgs::msg::Ticket>(
       ReservationResponseTopicName, qos);
@@ -370,16 +877,305 @@ public:
       this->create_publisher<rmf_reservation_msgs::msg::FreeParkingSpots>(
       "/rmf/reservations/free_parking_spot", qos);
 
+    // The changes are only meaningful in order and without gaps, so keep
+    // enough of them for subscribers that fall behind while everyone parks
+    // at once.
+    rclcpp::QoS changes_qos(1000);
+    changes_qos = changes_qos.reliable();
+    freed_spots_pub_ =
+      this->create_publisher<rmf_reservation_msgs::msg::FreeParkingSpots>(
+      ReservationFreedSpotsTopicName, changes_qos);
+    taken_spots_pub_ =
+      this->create_publisher<rmf_reservation_msgs::msg::FreeParkingSpots>(
+      ReservationTakenSpotsTopicName, changes_qos);
+
+    // The full list of free spots is published with this period in seconds
+    // so that new subscribers, or ones that missed a change, can catch up.
+    const double snapshot_period = this->declare_parameter<double>(
+      "free_spots_snapshot_period", 0.5);
+
     timer_ =
-      this->create_wall_timer(500ms,
+      this->create_wall_timer(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::duration<double>(std::max(snapshot_period, 0.01))),
         std::bind(&ReservationNode::publish_free_spots, this));
+
+    // Keep a journal of the reservations in this file so that they survive a
+    // restart. Call recover() once the node is made to load it.
+    const auto journal_path = this->declare_parameter<std::string>(
+      "state_journal", "");
+    compact_every_ = static_cast<std::size_t>(std::max<int64_t>(
+        1, this->declare_parameter<int64_t>("state_journal_compact_every",
+        1000)));
+    if (!journal_path.empty())
+    {
+      journal_ = std::make_unique<Journal>(journal_path);
+      if (!journal_->is_open())
+      {
+        RCLCPP_ERROR(this->get_logger(),
+          "Could not open the state journal [%s]. Reservations will not "
+          "survive a restart.", journal_path.c_str());
+        journal_ = nullptr;
+      }
+    }
+
+    // Claims that arrive within this many seconds of each other are assigned
+    // their spots together, so that robots finishing at the same time do not
+    // take each other's nearest spots one by one. A window of zero serves
+    // each claim as soon as it arrives.
+    const double batch_window = this->declare_parameter<double>(
+      "claim_batch_window", 0.0);
+    if (batch_window > 0.0)
+    {
+      batch_timer_ = this->create_wall_timer(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::duration<double>(batch_window)),
+        [this]()
+        {
+          batch_timer_->cancel();
+          serve_claim_batch();
+          publish_spot_changes();
+        });
+      batch_timer_->cancel();
+    }
+  }
+
+  /// Load the reservations that were in the journal when the node last
+  /// stopped. This needs to be called after the node has been made and before
+  /// it starts spinning.
+  void recover()
+  {
+    if (!journal_)
+    {
+      return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto records = journal_->read();
+    replaying_ = true;
+    std::size_t bad_records = 0;
+    for (const auto& r : records)
+    {
+      if (!apply(r))
+      {
+        ++bad_records;
+      }
+    }
+    replaying_ = false;
+
+    // Nobody needs to hear about the spots that were taken before the restart
+    current_state_.take_changes();
+    compact();
+
+    const auto elapsed = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count();
+    RCLCPP_INFO(this->get_logger(),
+      "Recovered %lu reservation records in %.1f ms", records.size(), elapsed);
+    if (bad_records > 0)
+    {
+      RCLCPP_WARN(this->get_logger(),
+        "Skipped %lu malformed records in the state journal", bad_records);
+    }
   }
 
 private:
+  /// Append a change to the journal, if there is one
+  void record(const RecordWriter& writer)
+  {
+    if (!journal_ || replaying_)
+    {
+      return;
+    }
+
+    journal_->append(writer.str());
+    if (journal_->appended() >= compact_every_)
+    {
+      compact();
+    }
+  }
+
+  /// Rewrite the journal as the records that produce the current state
+  void compact()
+  {
+    if (!journal_)
+    {
+      return;
+    }
+
+    std::vector<std::string> records;
+    for (const auto& [location, _] : current_state_.reservations())
+    {
+      records.push_back((RecordWriter("location") << location).str());
+    }
+
+    for (const auto& [ticket, header] : ticket_store_._ticket_to_header)
+    {
+      records.push_back((RecordWriter("request") << ticket
+        << header.fleet_name << header.robot_name
+        << static_cast<std::size_t>(header.request_id)
+        << requests_[ticket]).str());
+    }
+
+    for (const auto& [ticket, wait_points] : waitpoints_)
+    {
+      records.push_back(
+        (RecordWriter("waitpoints") << ticket << wait_points).str());
+    }
+
+    for (const auto& [location, state] : current_state_.reservations())
+    {
+      if (state.ticket.has_value())
+      {
+        records.push_back(
+          (RecordWriter("take") << *state.ticket << location).str());
+      }
+    }
+
+    for (const auto& [resource, tickets] : queue_manager_.queues())
+    {
+      records.push_back(
+        (RecordWriter("queue") << resource << tickets).str());
+    }
+
+    if (!journal_->rewrite(records))
+    {
+      RCLCPP_ERROR(this->get_logger(),
+        "Failed to compact the state journal. It will keep growing.");
+    }
+  }
+
+  /// Apply a record from the journal. Returns false if it was malformed.
+  bool apply(const std::string& r)
+  {
+    RecordReader reader(r);
+    const auto& op = reader.op();
+    std::size_t ticket = 0;
+    if (op == "location")
+    {
+      std::string location;
+      if (!(reader >> location).ok())
+      {
+        return false;
+      }
+
+      if (!current_state_.has_location(location))
+      {
+        current_state_.add_location(shared_from_this(), location);
+      }
+    }
+    else if (op == "request")
+    {
+      rmf_reservation_msgs::msg::RequestHeader header;
+      std::size_t request_id = 0;
+      std::vector<LocationReq> requests;
+      if (!(reader >> ticket >> header.fleet_name >> header.robot_name
+        >> request_id >> requests).ok())
+      {
+        return false;
+      }
+
+      header.request_id = request_id;
+      ticket_store_.restore_ticket(ticket, header);
+      requests_[ticket] = std::move(requests);
+    }
+    else if (op == "waitpoints")
+    {
+      std::vector<LocationReq> wait_points;
+      if (!(reader >> ticket >> wait_points).ok())
+      {
+        return false;
+      }
+      waitpoints_[ticket] = std::move(wait_points);
+    }
+    else if (op == "take")
+    {
+      std::string location;
+      if (!(reader >> ticket >> location).ok())
+      {
+        return false;
+      }
+      current_state_.allocate_lowest_cost_free_spot(
+        shared_from_this(), {LocationReq{location, 0.0}}, ticket);
+    }
+    else if (op == "free")
+    {
+      if (!(reader >> ticket).ok())
+      {
+        return false;
+      }
+      current_state_.release(ticket);
+    }
+    else if (op == "wait")
+    {
+      std::vector<std::string> resources;
+      if (!(reader >> ticket >> resources).ok())
+      {
+        return false;
+      }
+      queue_manager_.add_to_queue(ticket, resources);
+    }
+    else if (op == "unwait")
+    {
+      if (!(reader >> ticket).ok())
+      {
+        return false;
+      }
+      queue_manager_.remove_ticket(ticket);
+    }
+    else if (op == "queue")
+    {
+      std::string resource;
+      std::vector<std::size_t> tickets;
+      if (!(reader >> resource >> tickets).ok())
+      {
+        return false;
+      }
+      queue_manager_.restore_queue(resource, tickets);
+    }
+    else
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  /// allocate_lowest_cost_free_spot, keeping the journal up to date
+  std::optional<std::size_t> allocate(
+    const std::vector<LocationReq>& requests,
+    const std::size_t ticket_id)
+  {
+    if (current_state_.location_of(ticket_id).has_value())
+    {
+      record(RecordWriter("free") << ticket_id);
+    }
+
+    auto result = current_state_.allocate_lowest_cost_free_spot(
+      shared_from_this(), requests, ticket_id);
+    if (result.has_value())
+    {
+      record(RecordWriter("take") << ticket_id
+        << requests[result.value()].location);
+    }
+    return result;
+  }
+
+  /// CurrentState::release, keeping the journal up to date
+  std::optional<std::string> release_ticket(const std::size_t ticket_id)
+  {
+    auto location = current_state_.release(ticket_id);
+    if (location.has_value())
+    {
+      record(RecordWriter("free") << ticket_id);
+    }
+    return location;
+  }
+
   void received_graph(
     const rmf_building_map_msgs::msg::Graph::ConstSharedPtr& graph_msg)
   {
     RCLCPP_INFO(this->get_logger(), "Got graph");
+    std::unordered_set<std::string> seen;
     for (std::size_t i = 0; i < graph_msg->vertices.size(); i++)
     {
       for (auto& param: graph_msg->vertices[i].params)
@@ -387,8 +1183,19 @@ private:
         //TODO(arjoc) make this configure-able
         if (param.name == "is_parking_spot" && param.value_bool)
         {
-          current_state_.add_location(shared_from_this(),
-            graph_msg->vertices[i].name);
+          const auto& name = graph_msg->vertices[i].name;
+          // Locations that were restored from the journal are already known,
+          // but a name that appears twice in this graph is still reported.
+          if (seen.insert(name).second && current_state_.has_location(name))
+          {
+            continue;
+          }
+
+          current_state_.add_location(shared_from_this(), name);
+          if (current_state_.has_location(name))
+          {
+            record(RecordWriter("location") << name);
+          }
         }
       }
     }
@@ -411,11 +1218,145 @@ private:
 
     auto ticket = ticket_store_.get_new_ticket(request->header);
     requests_[ticket.ticket_id] = requests;
+    record(RecordWriter("request") << ticket.ticket_id
+      << ticket.header.fleet_name << ticket.header.robot_name
+      << static_cast<std::size_t>(ticket.header.request_id) << requests);
     ticket_pub_->publish(ticket);
   }
 
   void claim_request(
     const rmf_reservation_msgs::msg::ClaimRequest::ConstSharedPtr& request)
+  {
+    if (!batch_timer_)
+    {
+      serve_claim(request);
+      return;
+    }
+
+    // A repeated claim for the same ticket replaces the one that is waiting
+    for (auto& pending : pending_claims_)
+    {
+      if (pending->ticket.ticket_id == request->ticket.ticket_id)
+      {
+        pending = request;
+        return;
+      }
+    }
+
+    if (pending_claims_.empty())
+    {
+      batch_timer_->reset();
+    }
+    pending_claims_.push_back(request);
+  }
+
+  /// Give the claims of the current batch the set of free spots with the
+  /// lowest total cost. Claims that none of the free spots can serve are then
+  /// queued and sent to a waitpoint one by one, the same as unbatched claims.
+  void serve_claim_batch()
+  {
+    auto claims = std::move(pending_claims_);
+    pending_claims_.clear();
+    if (claims.empty())
+    {
+      return;
+    }
+
+    // Each ticket gives up whatever it was holding before being reassigned,
+    // as in allocate_lowest_cost_free_spot.
+    for (const auto& claim : claims)
+    {
+      release_ticket(claim->ticket.ticket_id);
+    }
+
+    std::unordered_map<std::string, std::size_t> column_of_location;
+    std::vector<std::string> locations;
+    std::vector<std::vector<double>> costs(claims.size());
+    for (std::size_t i = 0; i < claims.size(); ++i)
+    {
+      for (const auto& req : requests_[claims[i]->ticket.ticket_id])
+      {
+        if (!current_state_.is_available(req.location))
+        {
+          continue;
+        }
+
+        auto inserted = column_of_location.insert(
+          {req.location, locations.size()});
+        if (inserted.second)
+        {
+          locations.push_back(req.location);
+        }
+
+        const std::size_t column = inserted.first->second;
+        if (costs[i].size() <= column)
+        {
+          costs[i].resize(column + 1, std::numeric_limits<double>::infinity());
+        }
+        costs[i][column] = std::min(costs[i][column], req.cost);
+      }
+    }
+
+    for (auto& row : costs)
+    {
+      row.resize(locations.size(), std::numeric_limits<double>::infinity());
+    }
+
+    const auto assignment = min_cost_assignment(costs, locations.size());
+    RCLCPP_DEBUG(this->get_logger(), "Assigning a batch of %lu claims",
+      claims.size());
+
+    std::vector<rmf_reservation_msgs::msg::ClaimRequest::ConstSharedPtr>
+    unserved;
+    for (std::size_t i = 0; i < claims.size(); ++i)
+    {
+      const std::size_t ticket = claims[i]->ticket.ticket_id;
+      const auto& requests = requests_[ticket];
+      std::optional<std::size_t> chosen;
+      if (assignment[i].has_value())
+      {
+        for (std::size_t k = 0; k < requests.size(); ++k)
+        {
+          if (requests[k].location != locations[*assignment[i]])
+          {
+            continue;
+          }
+
+          if (!chosen.has_value() || requests[k].cost < requests[*chosen].cost)
+          {
+            chosen = k;
+          }
+        }
+      }
+
+      if (!chosen.has_value() ||
+        !allocate({requests[*chosen]}, ticket).has_value())
+      {
+        unserved.push_back(claims[i]);
+        continue;
+      }
+
+      rmf_reservation_msgs::msg::ReservationAllocation allocation;
+      allocation.ticket = ticket_store_.get_existing_ticket(ticket);
+      allocation.instruction_type =
+        rmf_reservation_msgs::msg::ReservationAllocation::IMMEDIATELY_PROCEED;
+      allocation.chosen_alternative = *chosen;
+      allocation.resource = requests[*chosen].location;
+
+      RCLCPP_DEBUG(this->get_logger(), "Allocating %s to %s",
+        allocation.resource.c_str(),
+        ticket_store_.debug_ticket(ticket).c_str());
+      allocation_pub_->publish(allocation);
+    }
+
+    for (const auto& claim : unserved)
+    {
+      serve_claim(claim);
+    }
+  }
+
+  void serve_claim(
+    const rmf_reservation_msgs::msg::ClaimRequest::ConstSharedPtr& request)
   {
     // This logic is for the simplified queue-less version.
     std::vector<LocationReq> locations;
@@ -428,10 +1369,7 @@ private:
     }
 
     // Allocate the lowest cost free spot from list of intended final locations if possible
-    auto result = current_state_.allocate_lowest_cost_free_spot(
-        shared_from_this(),
-        locations,
-        request->ticket.ticket_id);
+    auto result = allocate(locations, request->ticket.ticket_id);
     if (result.has_value())
     {
       rmf_reservation_msgs::msg::ReservationAllocation allocation;
@@ -463,6 +1401,8 @@ private:
     RCLCPP_INFO(
       this->get_logger(), "%s", ss.str().c_str());
     queue_manager_.add_to_queue(request->ticket.ticket_id, location_names);
+    record(RecordWriter("wait") << request->ticket.ticket_id
+      << location_names);
 
     // Allocate a waitpoint by preference as given by Fleet Adapter
     std::vector<LocationReq> wait_points;
@@ -479,10 +1419,9 @@ private:
     }
 
     waitpoints_[request->ticket.ticket_id] = wait_points;
-    auto waitpoint_result = current_state_.allocate_lowest_cost_free_spot(
-      shared_from_this(),
-      wait_points,
-      request->ticket.ticket_id);
+    record(RecordWriter("waitpoints") << request->ticket.ticket_id
+      << wait_points);
+    auto waitpoint_result = allocate(wait_points, request->ticket.ticket_id);
     if (waitpoint_result.has_value())
     {
       rmf_reservation_msgs::msg::ReservationAllocation allocation;
@@ -512,7 +1451,7 @@ private:
       this->get_logger(), "Releasing ticket for %s",
       ticket_store_.debug_ticket(request->ticket.ticket_id).c_str());
     auto ticket = request->ticket.ticket_id;
-    auto previous_waiting_location = current_state_.release(ticket);
+    auto previous_waiting_location = release_ticket(ticket);
     if (!previous_waiting_location.has_value())
     {
       RCLCPP_ERROR(
@@ -529,8 +1468,10 @@ private:
     while (auto next_ticket =
       queue_manager_.service_next_in_queue(previous_waiting_location.value()))
     {
+      record(RecordWriter("unwait") << next_ticket.value());
+
       // Release the ticket
-      previous_waiting_location = current_state_.release(next_ticket.value());
+      previous_waiting_location = release_ticket(next_ticket.value());
       if (!previous_waiting_location.has_value())
       {
         RCLCPP_ERROR(
@@ -541,10 +1482,7 @@ private:
       }
 
       auto result =
-        current_state_.allocate_lowest_cost_free_spot(
-          shared_from_this(),
-          requests_[next_ticket.value()],
-          next_ticket.value());
+        allocate(requests_[next_ticket.value()], next_ticket.value());
       RCLCPP_DEBUG(
         this->get_logger(), "Found next item %lu on queue %s",
         next_ticket.value(),
@@ -590,6 +1528,27 @@ private:
     free_spot_pub_->publish(spots);
   }
 
+  /// Publish only the spots that became free or were taken since the last
+  /// time. Freed spots go out before taken ones, so a subscriber that applies
+  /// them in order ends up with the same free list as this node.
+  void publish_spot_changes()
+  {
+    auto changes = current_state_.take_changes();
+    if (!changes.freed.empty())
+    {
+      rmf_reservation_msgs::msg::FreeParkingSpots freed;
+      freed.spots = std::move(changes.freed);
+      freed_spots_pub_->publish(freed);
+    }
+
+    if (!changes.taken.empty())
+    {
+      rmf_reservation_msgs::msg::FreeParkingSpots taken;
+      taken.spots = std::move(changes.taken);
+      taken_spots_pub_->publish(taken);
+    }
+  }
+
   rclcpp::Subscription<rmf_reservation_msgs::msg::FlexibleTimeRequest>::SharedPtr
     request_subscription_;
   rclcpp::Subscription<rmf_reservation_msgs::msg::ClaimRequest>::SharedPtr
@@ -604,6 +1563,10 @@ private:
     allocation_pub_;
   rclcpp::Publisher<rmf_reservation_msgs::msg::FreeParkingSpots>::SharedPtr
     free_spot_pub_;
+  rclcpp::Publisher<rmf_reservation_msgs::msg::FreeParkingSpots>::SharedPtr
+    freed_spots_pub_;
+  rclcpp::Publisher<rmf_reservation_msgs::msg::FreeParkingSpots>::SharedPtr
+    taken_spots_pub_;
 
   std::unordered_map<std::size_t, std::vector<LocationReq>> requests_;
   std::unordered_map<std::size_t, std::vector<LocationReq>> waitpoints_;
@@ -612,12 +1575,23 @@ private:
   ServiceQueueManager queue_manager_;
 
   rclcpp::TimerBase::SharedPtr timer_;
+
+  std::unique_ptr<Journal> journal_;
+  std::size_t compact_every_ = 1000;
+  bool replaying_ = false;
+
+  // Only used when claims are batched
+  rclcpp::TimerBase::SharedPtr batch_timer_;
+  std::vector<rmf_reservation_msgs::msg::ClaimRequest::ConstSharedPtr>
+  pending_claims_;
 };
 
 int main(int argc, const char** argv)
 {
   rclcpp::init(argc, argv);
-  rclcpp::spin(std::make_shared<ReservationNode>());
+  auto node = std::make_shared<ReservationNode>();
+  node->recover();
+  rclcpp::spin(node);
   rclcpp::shutdown();
   return 0;
 }
@@ -107,7 +107,9 @@ public:
   /// Get a mutable ref of active tasks map list handled by dispatcher
   const DispatchStates& active_dispatches() const;
 
-  /// Get a mutable ref of terminated tasks map list
+  /// Get a mutable ref of terminated tasks map list. Only the most recently
+  /// terminated tasks are kept, as limited by the terminated_tasks_max_size
+  /// and terminated_tasks_max_age parameters.
   const DispatchStates& finished_dispatches() const;
 
   using DispatchStateCallback =
@@ -126,6 +128,16 @@ public:
   ///   evaluator used to select the best bid from fleets
   void evaluator(bidding::Auctioneer::ConstEvaluatorPtr evaluator);
 
+  /// Set an evaluator that chooses the winners of concurrent auctions which
+  /// conclude together. By default this is nullptr, unless the
+  /// bidding_joint_evaluation parameter is true, in which case it is a
+  /// `BalancedQuickestFinishEvaluator`.
+  ///
+  /// \param [in] evaluator
+  ///   evaluator used to jointly select the best bids of several auctions
+  void joint_evaluator(
+    bidding::Auctioneer::ConstJointEvaluatorPtr evaluator);
+
   /// Get the rclcpp::Node that this dispatcher will be using for communication.
   std::shared_ptr<rclcpp::Node> node();
 
@@ -33,6 +33,7 @@ const std::string GetDispatchStatesSrvName = "get_dispatches";
 const std::string DispatchCommandTopicName = Prefix + "dispatch_request";
 const std::string DispatchAckTopicName = Prefix + "dispatch_ack";
 const std::string DispatchStatesTopicName = "dispatch_states";
+const std::string DispatchStateUpdatesTopicName = "dispatch_state_updates";
 const std::string TaskStatusTopicName = "task_summaries";
 const std::string TaskStateUpdateTopicName = "task_state_update";
 
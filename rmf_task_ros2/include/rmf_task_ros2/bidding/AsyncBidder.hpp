@@ -18,6 +18,7 @@
 #ifndef RMF_TASK_ROS2__BIDDING__ASYNCBIDDER_HPP
 #define RMF_TASK_ROS2__BIDDING__ASYNCBIDDER_HPP
 
+#include <optional>
 #include <unordered_set>
 
 #include <rclcpp/node.hpp>
@@ -45,6 +46,29 @@ public:
   using ReceiveNotice =
     std::function<void(const BidNoticeMsg& notice, Respond respond)>;
 
+  /// Returns true once a response to a notice can no longer be used, either
+  /// because the time window of its auction has passed or because the notice
+  /// was preempted by newer ones. This may be called from any thread.
+  using IsCancelled = std::function<bool()>;
+
+  /// Callback function when a bid notice is received from the auctioneer,
+  /// for bidders that are able to stop working on a notice that has been
+  /// cancelled. Responses to a cancelled notice will not be published.
+  ///
+  /// \param[in] notice
+  ///   bid notice msg
+  ///
+  /// \param[in] respond
+  ///   Call this to submit a response to the notice
+  ///
+  /// \param[in] is_cancelled
+  ///   Check this to find out if there is no longer any point in responding
+  using ReceiveCancellableNotice =
+    std::function<void(
+        const BidNoticeMsg& notice,
+        Respond respond,
+        IsCancelled is_cancelled)>;
+
   /// Create a bidder to bid for incoming task requests from Task Dispatcher
   ///
   /// \param[in] node
@@ -62,6 +86,40 @@ public:
     const std::shared_ptr<rclcpp::Node>& node,
     ReceiveNotice notice_cb);
 
+  /// Create a bidder whose notice callback is told when a notice has been
+  /// cancelled.
+  ///
+  /// \param[in] node
+  ///   ROS 2 node instance
+  ///
+  /// \param[in] notice_cb
+  ///   fn which is used to provide a bid submission during a call for bid
+  static std::shared_ptr<AsyncBidder> make_cancellable(
+    const std::shared_ptr<rclcpp::Node>& node,
+    ReceiveCancellableNotice notice_cb);
+
+  /// Limit how many notices may be passed to the notice callback before they
+  /// have been responded to. Notices beyond this limit wait in a queue, and
+  /// the ones whose time window passes while they wait are dropped. A notice
+  /// stops counting against the limit once it is responded to or its time
+  /// window passes. By default there is no limit.
+  ///
+  /// When there is a limit, the notice callback may be triggered from
+  /// whichever thread responded to an earlier notice.
+  void set_max_concurrent_notices(std::optional<std::size_t> max);
+
+  /// Get the limit on how many notices may be handled at once.
+  std::optional<std::size_t> max_concurrent_notices() const;
+
+  /// Set how many notices may wait in the queue. When a notice arrives and
+  /// the queue is full, the oldest waiting notice is declined to make room,
+  /// since newer auctions have more time left to be bid on. The default is
+  /// 100. Values below 1 will be treated as 1.
+  void set_max_queued_notices(std::size_t max);
+
+  /// Get how many notices may wait in the queue.
+  std::size_t max_queued_notices() const;
+
   class Implementation;
 
 private:
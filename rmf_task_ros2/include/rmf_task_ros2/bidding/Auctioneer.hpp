@@ -71,6 +71,26 @@ public:
 
   using ConstEvaluatorPtr = std::shared_ptr<const Evaluator>;
 
+  /// A pure abstract interface class for the auctioneer to choose the winners
+  /// of several auctions that conclude at the same time. Unlike an Evaluator,
+  /// this can take into account how the choice for one auction affects the
+  /// others, e.g. to avoid awarding every auction of a burst to one fleet.
+  class JointEvaluator
+  {
+  public:
+
+    /// Given the submissions of several auctions, choose the best one for each
+    /// auction. The result must have one entry for each auction, in the same
+    /// order, and each entry is the index of the chosen submission or nullopt
+    /// if none of them should win.
+    virtual std::vector<std::optional<std::size_t>> choose(
+      const std::vector<Responses>& auctions) const = 0;
+
+    virtual ~JointEvaluator() = default;
+  };
+
+  using ConstJointEvaluatorPtr = std::shared_ptr<const JointEvaluator>;
+
   /// Create an instance of the Auctioneer. This instance will handle all
   /// the task dispatching bidding mechanism. A default evaluator is used.
   ///
@@ -128,22 +148,62 @@ public:
     BiddingResultCallback result_callback,
     ConstEvaluatorPtr evaluator);
 
-  /// Start a bidding process by provide a bidding task. Note the each
-  /// bidding process is conducted sequentially
+  /// Start a bidding process by provide a bidding task. Bidding processes are
+  /// started in the order that they are requested, and no more than
+  /// max_concurrent_bids() of them will be in process at once.
   ///
   /// \param[in] bid_notice
   ///   bidding task, task which will call for bid
   void request_bid(const BidNoticeMsg& bid_notice);
 
-  /// Call this to tell the auctioneer that it may begin to perform the next bid
+  /// Call this to tell the auctioneer that the result of a concluded bid has
+  /// been settled, so it may begin to perform the next bid. This should be
+  /// called once for each time that the bidding result callback is triggered.
   void ready_for_next_bid();
 
+  /// Set how many bidding processes may be in process at once. A bidding
+  /// process counts against this limit from when its bid notice is published
+  /// until ready_for_next_bid() is called for its result. The default is 1,
+  /// which means each bidding process is conducted sequentially. Values below
+  /// 1 will be treated as 1.
+  ///
+  /// Only raise this if the bidders are able to give accurate proposals for
+  /// one task while another of their proposals may still be awarded.
+  void set_max_concurrent_bids(std::size_t max);
+
+  /// Get how many bidding processes may be in process at once.
+  std::size_t max_concurrent_bids() const;
+
+  /// Turn on or off concluding a bidding process as soon as every bidder has
+  /// responded to it, instead of always waiting for the end of its time
+  /// window. The bidders are counted from the subscriptions to the bid notice
+  /// topic, and bidders are expected to respond to every notice, even if only
+  /// to decline. This is off by default.
+  void set_early_close(bool enabled);
+
+  /// Check whether bidding processes may conclude before their time windows.
+  bool early_close() const;
+
   /// Provide a custom evaluator which will be used to choose the best bid
   /// If no selection is given, Default is: LeastFleetDiffCostEvaluator
   ///
   /// \param[in] evaluator
   void set_evaluator(ConstEvaluatorPtr evaluator);
 
+  /// Provide an evaluator which will choose the winners of all the bidding
+  /// processes that are ready to conclude together. Whenever a bidding process
+  /// concludes and a joint evaluator is set, every other open bidding process
+  /// that is also ready to conclude will be concluded with it. The evaluator
+  /// given to set_evaluator() is still used when only one is ready. Pass in a
+  /// nullptr to stop using a joint evaluator, which is the default.
+  ///
+  /// This only makes a difference when max_concurrent_bids() is more than 1.
+  /// Bidding processes that are started together share their start time, so
+  /// a burst of them will normally be ready to conclude at the same moment.
+  ///
+  /// \param[in] evaluator
+  void set_joint_evaluator(ConstJointEvaluatorPtr evaluator);
+
   class Implementation;
 
 private:
@@ -172,6 +232,21 @@ public:
   std::optional<std::size_t> choose(const Responses& submissions) const final;
 };
 
+//==============================================================================
+/// Jointly assigns auctions to fleets so that the sum of their finish times is
+/// as low as possible while no fleet wins more than one of them, because each
+/// proposal of a fleet assumes that it is the only new task that the fleet
+/// will receive. If there are more auctions than fleets that can take them,
+/// the remaining auctions are assigned the same way in further rounds, which
+/// spreads a burst of tasks across the fleets instead of giving all of them
+/// to whichever fleet happens to be quickest.
+class BalancedQuickestFinishEvaluator : public Auctioneer::JointEvaluator
+{
+public:
+  std::vector<std::optional<std::size_t>> choose(
+    const std::vector<Responses>& auctions) const final;
+};
+
 } // namespace bidding
 } // namespace rmf_task_ros2
 
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef RMF_TASK_ROS2__BIDDING__BATCHEDNOTICE_HPP
+#define RMF_TASK_ROS2__BIDDING__BATCHEDNOTICE_HPP
+
+#include <rmf_task_ros2/bidding/Response.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace rmf_task_ros2 {
+namespace bidding {
+
+//==============================================================================
+/// One task inside of a batched bid notice
+struct BatchedTask
+{
+  std::string task_id;
+
+  /// The task request, serialized as JSON in the same way as the request of a
+  /// single bid notice
+  std::string request;
+};
+
+//==============================================================================
+/// Make one bid notice that calls for bids on a whole batch of tasks. The
+/// request of the notice holds all the tasks in this form:
+///
+///   {"batch": [{"task_id": "...", "request": {...}}, ...]}
+///
+/// A bidder should respond with a single proposal for taking on all of the
+/// tasks together, and the winner of the bid is awarded every task in it.
+BidNoticeMsg make_batched_notice(
+  const std::string& batch_id,
+  const std::vector<BatchedTask>& tasks,
+  const builtin_interfaces::msg::Duration& time_window,
+  bool dry_run = false);
+
+//==============================================================================
+/// Get the tasks of a batched bid notice. This returns std::nullopt if the
+/// notice is for a single task.
+std::optional<std::vector<BatchedTask>> read_batched_notice(
+  const BidNoticeMsg& notice);
+
+} // namespace bidding
+} // namespace rmf_task_ros2
+
+#endif // RMF_TASK_ROS2__BIDDING__BATCHEDNOTICE_HPP
@@ -0,0 +1,470 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+/// Note: This is a benchmark for the task dispatcher. It runs a dispatcher
+/// together with a number of mock bidders in one process, submits tasks at a
+/// fixed rate, and reports how long they took to be awarded.
+
+#include <rmf_task_ros2/Dispatcher.hpp>
+#include <rmf_task_ros2/StandardNames.hpp>
+#include <rmf_task_ros2/bidding/AsyncBidder.hpp>
+#include <rmf_task_ros2/bidding/BatchedNotice.hpp>
+
+#include <rmf_task_msgs/msg/api_request.hpp>
+#include <rmf_task_msgs/msg/dispatch_ack.hpp>
+#include <rmf_task_msgs/msg/dispatch_command.hpp>
+
+#include <rclcpp/rclcpp.hpp>
+#include <rmf_traffic_ros2/Time.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace rmf_task_ros2;
+using DispatchCommandMsg = rmf_task_msgs::msg::DispatchCommand;
+using DispatchAckMsg = rmf_task_msgs::msg::DispatchAck;
+using ApiRequestMsg = rmf_task_msgs::msg::ApiRequest;
+
+//==============================================================================
+struct Counters
+{
+  std::size_t notices = 0;
+  std::size_t responses = 0;
+  std::size_t awards = 0;
+  std::size_t acks = 0;
+};
+
+//==============================================================================
+struct TaskRecord
+{
+  std::chrono::steady_clock::time_point submitted;
+  std::optional<std::chrono::steady_clock::time_point> awarded;
+  bool failed = false;
+};
+
+//==============================================================================
+/// Tracks the auctions that are open, from when their notice goes out until
+/// their task is either awarded or fails to be assigned.
+class ConcurrencyMonitor
+{
+public:
+
+  void open(const std::string& task_id)
+  {
+    if (_open.count(task_id) > 0)
+      return;
+
+    _advance();
+    _open.insert(task_id);
+    _max = std::max(_max, _open.size());
+  }
+
+  void close(const std::string& task_id)
+  {
+    if (_open.count(task_id) == 0)
+      return;
+
+    _advance();
+    _open.erase(task_id);
+  }
+
+  std::size_t max() const
+  {
+    return _max;
+  }
+
+  /// The average number of open auctions since the first one was opened
+  double mean() const
+  {
+    if (!_start.has_value())
+      return 0.0;
+
+    const auto now = std::chrono::steady_clock::now();
+    const double total = std::chrono::duration<double>(now - *_start).count();
+    const double area = _area + static_cast<double>(_open.size())
+      * std::chrono::duration<double>(now - _last).count();
+    return total > 0.0 ? area / total : 0.0;
+  }
+
+private:
+
+  // Add up the time spent with the current number of open auctions
+  void _advance()
+  {
+    const auto now = std::chrono::steady_clock::now();
+    if (!_start.has_value())
+    {
+      _start = now;
+      _last = now;
+    }
+
+    _area += static_cast<double>(_open.size())
+      * std::chrono::duration<double>(now - _last).count();
+    _last = now;
+  }
+
+  std::unordered_set<std::string> _open;
+  std::optional<std::chrono::steady_clock::time_point> _start;
+  std::chrono::steady_clock::time_point _last;
+  double _area = 0.0;
+  std::size_t _max = 0;
+};
+
+//==============================================================================
+/// A bidder that takes a fixed amount of time to compute each bid, then
+/// proposes a random finish time. It acknowledges every command that is sent
+/// to its fleet, as a fleet adapter would.
+class MockBidder
+{
+public:
+
+  MockBidder(
+    const rclcpp::Context::SharedPtr& context,
+    std::string fleet_name_,
+    std::chrono::nanoseconds latency_,
+    std::chrono::nanoseconds jitter_,
+    Counters& counters_,
+    std::function<void(const std::string&)> on_award_)
+  : fleet_name(std::move(fleet_name_)),
+    latency(latency_),
+    jitter(jitter_),
+    counters(counters_),
+    on_award(std::move(on_award_)),
+    random(std::hash<std::string>()(fleet_name))
+  {
+    node = rclcpp::Node::make_shared(
+      fleet_name, rclcpp::NodeOptions().context(context));
+
+    bidder = bidding::AsyncBidder::make(
+      node,
+      [this](const bidding::BidNoticeMsg&, bidding::AsyncBidder::Respond r)
+      {
+        this->receive_notice(std::move(r));
+      });
+
+    ack_pub = node->create_publisher<DispatchAckMsg>(
+      DispatchAckTopicName,
+      rclcpp::ServicesQoS().keep_last(20).transient_local());
+
+    command_sub = node->create_subscription<DispatchCommandMsg>(
+      DispatchCommandTopicName,
+      rclcpp::ServicesQoS().keep_last(20).reliable().transient_local(),
+      [this](const DispatchCommandMsg::UniquePtr msg)
+      {
+        this->receive_command(*msg);
+      });
+  }
+
+  void receive_notice(bidding::AsyncBidder::Respond respond)
+  {
+    ++counters.notices;
+    auto delay = latency;
+    if (jitter.count() > 0)
+    {
+      delay += std::chrono::nanoseconds(
+        std::uniform_int_distribution<int64_t>(0, jitter.count())(random));
+    }
+
+    const double finish_offset =
+      std::uniform_real_distribution<double>(10.0, 20.0)(random);
+
+    const std::size_t key = next_timer++;
+    timers[key] = node->create_wall_timer(
+      std::max(delay, std::chrono::nanoseconds(1)),
+      [this, key, finish_offset, respond = std::move(respond)]()
+      {
+        respond(bidding::Response{
+          bidding::Response::Proposal{
+            fleet_name,
+            "robot",
+            0.0,
+            finish_offset,
+            rmf_traffic::time::apply_offset(
+              std::chrono::steady_clock::now(), finish_offset)
+          },
+          {}
+        });
+
+        ++counters.responses;
+        timers.erase(key);
+      });
+  }
+
+  void receive_command(const DispatchCommandMsg& msg)
+  {
+    if (msg.fleet_name != fleet_name)
+      return;
+
+    if (!acknowledged.insert(msg.dispatch_id).second)
+      return;
+
+    if (msg.type == DispatchCommandMsg::TYPE_AWARD)
+    {
+      ++counters.awards;
+      on_award(msg.task_id);
+    }
+
+    DispatchAckMsg ack;
+    ack.dispatch_id = msg.dispatch_id;
+    ack.success = true;
+    ack_pub->publish(ack);
+    ++counters.acks;
+  }
+
+  std::string fleet_name;
+  std::chrono::nanoseconds latency;
+  std::chrono::nanoseconds jitter;
+  Counters& counters;
+  std::function<void(const std::string&)> on_award;
+  std::mt19937_64 random;
+
+  rclcpp::Node::SharedPtr node;
+  std::shared_ptr<bidding::AsyncBidder> bidder;
+  rclcpp::Publisher<DispatchAckMsg>::SharedPtr ack_pub;
+  rclcpp::Subscription<DispatchCommandMsg>::SharedPtr command_sub;
+  std::unordered_map<std::size_t, rclcpp::TimerBase::SharedPtr> timers;
+  std::size_t next_timer = 0;
+  std::unordered_set<uint64_t> acknowledged;
+};
+
+//==============================================================================
+double percentile(const std::vector<double>& sorted, double p)
+{
+  if (sorted.empty())
+    return 0.0;
+
+  const auto rank = static_cast<std::size_t>(
+    std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+  return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  rclcpp::init(argc, argv);
+  const auto context = rclcpp::contexts::get_global_default_context();
+
+  const auto node = rclcpp::Node::make_shared("rmf_dispatcher_benchmark");
+  const auto num_bidders = static_cast<std::size_t>(
+    std::max<int64_t>(node->declare_parameter<int64_t>("num_bidders", 3), 1));
+  const double bid_latency =
+    node->declare_parameter<double>("bid_latency", 0.05);
+  const double bid_latency_jitter =
+    node->declare_parameter<double>("bid_latency_jitter", 0.0);
+  const double submission_rate = std::max(
+    node->declare_parameter<double>("submission_rate", 10.0), 1e-3);
+  const auto num_tasks = static_cast<std::size_t>(
+    std::max<int64_t>(node->declare_parameter<int64_t>("num_tasks", 100), 1));
+  const double timeout = node->declare_parameter<double>("timeout", 60.0);
+
+  RCLCPP_INFO(
+    node->get_logger(),
+    "Benchmarking dispatcher with %lu bidders taking %.3fs (+%.3fs jitter) "
+    "per bid, submitting %lu tasks at %.2f tasks/s",
+    num_bidders, bid_latency, bid_latency_jitter, num_tasks, submission_rate);
+
+  // The dispatcher shares this node, so its parameters can be given in the
+  // same way as the benchmark parameters.
+  const auto dispatcher = Dispatcher::make(node);
+
+  Counters counters;
+  ConcurrencyMonitor concurrency;
+  std::unordered_map<std::string, TaskRecord> records;
+  std::size_t finished = 0;
+
+  const auto finish = [&](const std::string& task_id, bool failed)
+    {
+      concurrency.close(task_id);
+      const auto it = records.find(task_id);
+      if (it == records.end() || it->second.awarded || it->second.failed)
+        return;
+
+      if (failed)
+        it->second.failed = true;
+      else
+        it->second.awarded = std::chrono::steady_clock::now();
+
+      ++finished;
+    };
+
+  dispatcher->on_change(
+    [&](const DispatchState& state)
+    {
+      if (state.status == DispatchState::Status::Queued)
+      {
+        records.insert({state.task_id, TaskRecord{state.submission_time}});
+      }
+      else if (state.status == DispatchState::Status::FailedToAssign
+      || state.status == DispatchState::Status::CanceledInFlight)
+      {
+        finish(state.task_id, true);
+      }
+    });
+
+  const auto to_duration = [](double seconds)
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(std::max(seconds, 0.0)));
+    };
+
+  std::vector<std::unique_ptr<MockBidder>> bidders;
+  for (std::size_t i = 0; i < num_bidders; ++i)
+  {
+    bidders.push_back(std::make_unique<MockBidder>(
+        context,
+        "benchmark_fleet_" + std::to_string(i),
+        to_duration(bid_latency),
+        to_duration(bid_latency_jitter),
+        counters,
+        [&finish](const std::string& task_id) { finish(task_id, false); }));
+  }
+
+  const auto notice_sub = node->create_subscription<bidding::BidNoticeMsg>(
+    BidNoticeTopicName,
+    rclcpp::ServicesQoS().reliable(),
+    [&concurrency](const bidding::BidNoticeMsg::UniquePtr msg)
+    {
+      const auto batch = bidding::read_batched_notice(*msg);
+      if (!batch.has_value())
+        return concurrency.open(msg->task_id);
+
+      for (const auto& task : *batch)
+        concurrency.open(task.task_id);
+    });
+
+  const auto api_pub = node->create_publisher<ApiRequestMsg>(
+    "task_api_requests",
+    rclcpp::SystemDefaultsQoS().keep_last(10).reliable().transient_local());
+
+  std::promise<void> done_promise;
+  std::shared_future<void> done(done_promise.get_future());
+  bool done_set = false;
+
+  std::size_t submitted = 0;
+  std::optional<std::chrono::steady_clock::time_point> first_submission;
+  std::optional<std::chrono::steady_clock::time_point> last_submission;
+  rclcpp::TimerBase::SharedPtr submit_timer;
+  submit_timer = node->create_wall_timer(
+    to_duration(1.0 / submission_rate),
+    [&]()
+    {
+      if (submitted >= num_tasks)
+        return;
+
+      nlohmann::json request;
+      request["type"] = "dispatch_task_request";
+      request["request"]["category"] = "patrol";
+      request["request"]["description"]["places"] =
+        std::vector<std::string>({"benchmark"});
+      request["request"]["description"]["rounds"] = 1;
+
+      ApiRequestMsg msg;
+      msg.request_id = "benchmark-" + std::to_string(submitted);
+      msg.json_msg = request.dump();
+      api_pub->publish(msg);
+
+      const auto now = std::chrono::steady_clock::now();
+      if (!first_submission.has_value())
+        first_submission = now;
+      last_submission = now;
+
+      if (++submitted >= num_tasks)
+        submit_timer->cancel();
+    });
+
+  const auto check_timer = node->create_wall_timer(
+    std::chrono::milliseconds(100),
+    [&]()
+    {
+      if (done_set || submitted < num_tasks)
+        return;
+
+      const bool all_finished =
+        records.size() >= num_tasks && finished >= records.size();
+      const bool timed_out = std::chrono::steady_clock::now()
+      - *last_submission > to_duration(timeout);
+
+      if (all_finished || timed_out)
+      {
+        done_set = true;
+        done_promise.set_value();
+      }
+    });
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  for (const auto& bidder : bidders)
+    executor.add_node(bidder->node);
+
+  executor.spin_until_future_complete(done);
+  const auto end = std::chrono::steady_clock::now();
+
+  //============================================================================
+  std::vector<double> latencies;
+  std::size_t failed = 0;
+  for (const auto& [_, record] : records)
+  {
+    if (record.awarded.has_value())
+    {
+      latencies.push_back(
+        std::chrono::duration<double>(*record.awarded - record.submitted)
+        .count());
+    }
+    else if (record.failed)
+    {
+      ++failed;
+    }
+  }
+  std::sort(latencies.begin(), latencies.end());
+
+  const double elapsed = first_submission.has_value() ?
+    std::chrono::duration<double>(end - *first_submission).count() : 0.0;
+
+  std::cout << "\n=== Dispatcher benchmark ===\n"
+            << "Tasks submitted:        " << submitted << "\n"
+            << "Tasks received:         " << records.size() << "\n"
+            << "Tasks awarded:          " << latencies.size() << "\n"
+            << "Tasks failed:           " << failed << "\n"
+            << "Tasks unfinished:       "
+            << records.size() - latencies.size() - failed << "\n"
+            << "Throughput (tasks/s):   "
+            << (elapsed > 0.0 ? latencies.size() / elapsed : 0.0) << "\n"
+            << "Dispatch latency (s):\n"
+            << "  p50:                  " << percentile(latencies, 50) << "\n"
+            << "  p90:                  " << percentile(latencies, 90) << "\n"
+            << "  p99:                  " << percentile(latencies, 99) << "\n"
+            << "  max:                  "
+            << (latencies.empty() ? 0.0 : latencies.back()) << "\n"
+            << "Open auctions:\n"
+            << "  max:                  " << concurrency.max() << "\n"
+            << "  mean:                 " << concurrency.mean() << "\n"
+            << "Messages:\n"
+            << "  bid notices received: " << counters.notices << "\n"
+            << "  bid responses sent:   " << counters.responses << "\n"
+            << "  awards received:      " << counters.awards << "\n"
+            << "  acks sent:            " << counters.acks << "\n"
+            << std::endl;
+
+  rclcpp::shutdown();
+}
@@ -16,6 +16,7 @@
 */
 
 #include <rmf_task_ros2/Dispatcher.hpp>
+#include <rmf_task_ros2/bidding/BatchedNotice.hpp>
 #include <rmf_task_ros2/StandardNames.hpp>
 
 #include <rmf_websocket/BroadcastClient.hpp>
@@ -36,6 +37,7 @@
 #include <rmf_task_msgs/msg/api_response.hpp>
 
 #include <rmf_traffic_ros2/Time.hpp>
+#include <rmf_traffic_ros2/Tracing.hpp>
 
 #include <nlohmann/json.hpp>
 #include <nlohmann/json-schema.hpp>
@@ -48,6 +50,9 @@
 
 #include <std_msgs/msg/string.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <list>
 #include <random>
 #include <unordered_set>
 
@@ -185,6 +190,14 @@ public:
   DispatchStatesPub::SharedPtr dispatch_states_pub;
   rclcpp::TimerBase::SharedPtr dispatch_states_pub_timer;
 
+  // When deltas are turned on, only the dispatch states that changed are
+  // published regularly, and full snapshots are published less often.
+  bool publish_dispatch_state_deltas;
+  int dispatch_states_snapshot_period;
+  DispatchStatesPub::SharedPtr dispatch_state_updates_pub;
+  rclcpp::TimerBase::SharedPtr dispatch_states_snapshot_timer;
+  std::unordered_set<TaskID> changed_dispatch_states;
+
   uint64_t next_dispatch_command_id = 0;
   std::unordered_map<uint64_t, DispatchCommandMsg> lingering_commands;
   rclcpp::TimerBase::SharedPtr dispatch_command_timer;
@@ -196,12 +209,44 @@ public:
 
   DispatchStates active_dispatch_states;
   DispatchStates finished_dispatch_states;
+
+  // Finished dispatch states from the oldest to the most recently finished,
+  // so the oldest ones can be evicted in constant time
+  struct FinishedEntry
+  {
+    TaskID task_id;
+    std::chrono::steady_clock::time_point finish_time;
+  };
+  std::list<FinishedEntry> finished_order;
+  std::unordered_map<TaskID, std::list<FinishedEntry>::iterator>
+  finished_position;
+  std::optional<std::chrono::steady_clock::duration> terminated_tasks_max_age;
   std::size_t task_counter = 0; // index for generating task_id
   builtin_interfaces::msg::Duration bidding_time_window;
   std::size_t terminated_tasks_max_size;
   int publish_active_tasks_period;
   bool use_timestamp_for_task_id;
   bool use_unique_hex_string_with_task_id;
+  std::size_t max_concurrent_bids;
+  bool bidding_early_close;
+  bool bidding_joint_evaluation;
+
+  // Bid notices that arrive close together can be sent out as one batch
+  std::size_t bid_batch_size;
+  std::chrono::nanoseconds bid_batch_delay;
+  std::vector<bidding::BidNoticeMsg> unbatched_notices;
+  rclcpp::TimerBase::SharedPtr bid_batch_timer;
+  std::size_t batch_counter = 0;
+
+  struct BidBatch
+  {
+    std::vector<TaskID> tasks;
+    // The auctioneer is only told that the batch is settled once the result
+    // of every one of its tasks is settled
+    std::size_t unsettled;
+  };
+  std::unordered_map<TaskID, BidBatch> bid_batches;
+  std::unordered_map<TaskID, TaskID> batch_of_task;
 
   std::unordered_map<std::size_t, std::string> legacy_task_type_names =
   {
@@ -215,6 +260,10 @@ public:
   using LegacyConversionMap = std::unordered_map<std::string, LegacyConversion>;
   LegacyConversionMap legacy_task_types;
 
+  // The fields of a converted legacy request that only depend on its
+  // category, so they do not need to be rebuilt for every submission
+  std::unordered_map<std::string, nlohmann::json> legacy_request_templates;
+
   Implementation(std::shared_ptr<rclcpp::Node> node_)
   : node{std::move(node_)}
   {
@@ -231,11 +280,31 @@ public:
     RCLCPP_INFO(node->get_logger(),
       " Declared Terminated Tasks Max Size Param as: %lu",
       terminated_tasks_max_size);
+    const double terminated_tasks_max_age_param =
+      node->declare_parameter<double>("terminated_tasks_max_age", 0.0);
+    if (terminated_tasks_max_age_param > 0.0)
+    {
+      terminated_tasks_max_age = rmf_traffic::time::from_seconds(
+        terminated_tasks_max_age_param);
+      RCLCPP_INFO(node->get_logger(),
+        " Declared Terminated Tasks Max Age Param as: %f secs",
+        terminated_tasks_max_age_param);
+    }
     publish_active_tasks_period =
       node->declare_parameter<int>("publish_active_tasks_period", 2);
     RCLCPP_INFO(node->get_logger(),
       " Declared publish_active_tasks_period as: %d secs",
       publish_active_tasks_period);
+    publish_dispatch_state_deltas =
+      node->declare_parameter<bool>("publish_dispatch_state_deltas", false);
+    dispatch_states_snapshot_period =
+      node->declare_parameter<int>("dispatch_states_snapshot_period", 30);
+    if (publish_dispatch_state_deltas)
+    {
+      RCLCPP_INFO(node->get_logger(),
+        " Publishing dispatch state deltas with snapshots every %d secs",
+        dispatch_states_snapshot_period);
+    }
     use_timestamp_for_task_id =
       node->declare_parameter<bool>("use_timestamp_for_task_id", false);
     RCLCPP_INFO(node->get_logger(),
@@ -248,6 +317,51 @@ public:
       " Use unique hex string with task_id: %s",
       (use_unique_hex_string_with_task_id ? "true" : "false"));
 
+    // Fleet adapters compute each bid from the assignments they already have,
+    // so allowing more than one auction at a time may produce proposals that
+    // are no longer accurate by the time they are awarded.
+    const auto max_concurrent_bids_param =
+      node->declare_parameter<int>("max_concurrent_bids", 1);
+    max_concurrent_bids = static_cast<std::size_t>(
+      std::max(max_concurrent_bids_param, 1));
+    RCLCPP_INFO(node->get_logger(),
+      " Declared max_concurrent_bids as: %lu",
+      max_concurrent_bids);
+
+    bidding_early_close =
+      node->declare_parameter<bool>("bidding_early_close", false);
+    RCLCPP_INFO(node->get_logger(),
+      " Close auctions once all bidders respond: %s",
+      (bidding_early_close ? "true" : "false"));
+
+    // Only makes a difference when auctions are allowed to run concurrently
+    bidding_joint_evaluation =
+      node->declare_parameter<bool>("bidding_joint_evaluation", false);
+    RCLCPP_INFO(node->get_logger(),
+      " Evaluate concurrent auctions jointly: %s",
+      (bidding_joint_evaluation ? "true" : "false"));
+
+    // Fleet adapters plan the tasks of a batch together and the winner of the
+    // bid takes all of them, so batching trades some flexibility in how tasks
+    // are spread across fleets for much less planning work.
+    const auto bid_batch_size_param =
+      node->declare_parameter<int>("bid_batch_size", 1);
+    bid_batch_size = static_cast<std::size_t>(
+      std::max(bid_batch_size_param, 1));
+    RCLCPP_INFO(node->get_logger(),
+      " Declared bid_batch_size as: %lu",
+      bid_batch_size);
+    const double bid_batch_delay_param =
+      node->declare_parameter<double>("bid_batch_delay", 0.1);
+    bid_batch_delay = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      rmf_traffic::time::from_seconds(bid_batch_delay_param));
+    if (bid_batch_size > 1)
+    {
+      RCLCPP_INFO(node->get_logger(),
+        " Declared bid_batch_delay as: %f secs",
+        bid_batch_delay_param);
+    }
+
     std::optional<std::string> server_uri = std::nullopt;
     const std::string uri =
       node->declare_parameter("server_uri", std::string());
@@ -279,9 +393,27 @@ public:
 
     // TODO(MXG): The smallest resolution this supports is 1 second. That
     // doesn't seem great.
-    dispatch_states_pub_timer = node->create_wall_timer(
-      std::chrono::seconds(publish_active_tasks_period),
-      [this]() { this->publish_dispatch_states(); });
+    if (publish_dispatch_state_deltas)
+    {
+      dispatch_state_updates_pub = node->create_publisher<DispatchStatesMsg>(
+        rmf_task_ros2::DispatchStateUpdatesTopicName, qos);
+
+      dispatch_states_pub_timer = node->create_wall_timer(
+        std::chrono::seconds(publish_active_tasks_period),
+        [this]() { this->publish_dispatch_state_updates(); });
+
+      const int snapshot_period = std::max(
+        dispatch_states_snapshot_period, publish_active_tasks_period);
+      dispatch_states_snapshot_timer = node->create_wall_timer(
+        std::chrono::seconds(snapshot_period),
+        [this]() { this->publish_dispatch_states(); });
+    }
+    else
+    {
+      dispatch_states_pub_timer = node->create_wall_timer(
+        std::chrono::seconds(publish_active_tasks_period),
+        [this]() { this->publish_dispatch_states(); });
+    }
 
     dispatch_command_pub = node->create_publisher<DispatchCommandMsg>(
       rmf_task_ros2::DispatchCommandTopicName,
@@ -317,9 +449,16 @@ public:
         const std::optional<bidding::Response::Proposal> winner,
         const std::vector<std::string>& errors)
       {
-        this->conclude_bid(task_id, std::move(winner), errors);
+        this->conclude_auction(task_id, std::move(winner), errors);
       },
       std::make_shared<bidding::QuickestFinishEvaluator>());
+    auctioneer->set_max_concurrent_bids(max_concurrent_bids);
+    auctioneer->set_early_close(bidding_early_close);
+    if (bidding_joint_evaluation)
+    {
+      auctioneer->set_joint_evaluator(
+        std::make_shared<bidding::BalancedQuickestFinishEvaluator>());
+    }
 
     // Setup up stream srv interfaces
     submit_task_srv = node->create_service<SubmitTaskSrv>(
@@ -548,7 +687,8 @@ public:
         .request(task_request_json.dump())
         .task_id(task_id)
         .time_window(bidding_time_window)
-        .dry_run(false));
+        .dry_run(false),
+        task_request_json);
 
       nlohmann::json response_json;
       response_json["success"] = true;
@@ -586,6 +726,13 @@ public:
     }
 
     const std::string category = desc_it->second;
+    const auto desc_conversion_it = legacy_task_types.find(category);
+    if (desc_conversion_it == legacy_task_types.end())
+    {
+      RCLCPP_ERROR(
+        node->get_logger(), "TaskType: %u is not supported", task_type_index);
+      return std::nullopt;
+    }
 
     // auto generate a task_id for a given submitted task
     const auto task_id =
@@ -594,48 +741,158 @@ public:
     RCLCPP_INFO(node->get_logger(),
       "Received Task Submission [%s]", task_id.c_str());
 
-    nlohmann::json task_request;
+    auto& task_template = legacy_request_templates[category];
+    if (task_template.is_null())
+    {
+      task_template["priority"]["type"] = "binary";
+      task_template["category"] = category;
+      task_template["labels"] = std::vector<std::string>({"legacy_request"});
+    }
+
+    nlohmann::json task_request = task_template;
     task_request["unix_millis_earliest_start_time"] =
       std::chrono::duration_cast<std::chrono::milliseconds>(
       rmf_traffic_ros2::convert(submission.start_time).time_since_epoch())
       .count();
+    task_request["priority"]["value"] = submission.priority.value;
+    task_request["description"] = desc_conversion_it->second(submission);
 
-    auto& priority = task_request["priority"];
-    priority["type"] = "binary";
-    priority["value"] = submission.priority.value;
-    task_request["category"] = category;
-    task_request["description"] = legacy_task_types.at(category)(submission);
-    task_request["labels"] = std::vector<std::string>({"legacy_request"});
-
-    push_bid_notice(
-      rmf_task_msgs::build<bidding::BidNoticeMsg>()
+    auto bid_notice = rmf_task_msgs::build<bidding::BidNoticeMsg>()
       .request(task_request.dump())
       .task_id(task_id)
       .time_window(bidding_time_window)
-      .dry_run(false));
+      .dry_run(false);
+
+    push_bid_notice(std::move(bid_notice), std::move(task_request));
 
     return task_id;
   }
 
-  nlohmann::json push_bid_notice(bidding::BidNoticeMsg bid_notice)
+  /// The request is given both as the serialized string in the bid notice
+  /// and already parsed, so it does not need to be parsed again here.
+  nlohmann::json push_bid_notice(
+    bidding::BidNoticeMsg bid_notice,
+    nlohmann::json request)
   {
-    const auto request = nlohmann::json::parse(bid_notice.request);
     auto new_dispatch_state =
       std::make_shared<DispatchState>(
       bid_notice.task_id, std::chrono::steady_clock::now());
-    new_dispatch_state->request = request;
+    new_dispatch_state->request = std::move(request);
 
     const auto state = create_task_state_json(new_dispatch_state, "queued");
 
     active_dispatch_states[bid_notice.task_id] = new_dispatch_state;
+    mark_changed(bid_notice.task_id);
 
     if (on_change_fn)
       on_change_fn(*new_dispatch_state);
 
-    auctioneer->request_bid(bid_notice);
+    rmf_traffic_ros2::tracing::instant("task_submitted", bid_notice.task_id);
+    request_bid(std::move(bid_notice));
     return state;
   }
 
+  void request_bid(bidding::BidNoticeMsg bid_notice)
+  {
+    if (bid_batch_size <= 1 || bid_notice.dry_run)
+    {
+      auctioneer->request_bid(bid_notice);
+      return;
+    }
+
+    unbatched_notices.push_back(std::move(bid_notice));
+    if (unbatched_notices.size() >= bid_batch_size)
+    {
+      flush_bid_batch();
+      return;
+    }
+
+    if (!bid_batch_timer)
+    {
+      bid_batch_timer = node->create_wall_timer(
+        bid_batch_delay,
+        [this]() { this->flush_bid_batch(); });
+    }
+  }
+
+  void flush_bid_batch()
+  {
+    if (bid_batch_timer)
+    {
+      bid_batch_timer->cancel();
+      bid_batch_timer.reset();
+    }
+
+    std::vector<bidding::BidNoticeMsg> notices;
+    for (auto& notice : unbatched_notices)
+    {
+      // Skip tasks that were canceled while they were waiting
+      const auto it = active_dispatch_states.find(notice.task_id);
+      if (it == active_dispatch_states.end())
+        continue;
+
+      if (it->second->status != DispatchState::Status::Queued)
+        continue;
+
+      notices.push_back(std::move(notice));
+    }
+    unbatched_notices.clear();
+
+    if (notices.empty())
+      return;
+
+    if (notices.size() == 1)
+    {
+      auctioneer->request_bid(notices.front());
+      return;
+    }
+
+    const auto batch_id = "batch.dispatch-" + std::to_string(batch_counter++);
+    std::vector<bidding::BatchedTask> tasks;
+    BidBatch batch;
+    for (const auto& notice : notices)
+    {
+      tasks.push_back(bidding::BatchedTask{notice.task_id, notice.request});
+      batch.tasks.push_back(notice.task_id);
+      batch_of_task[notice.task_id] = batch_id;
+    }
+    batch.unsettled = batch.tasks.size();
+    bid_batches[batch_id] = std::move(batch);
+
+    RCLCPP_INFO(
+      node->get_logger(),
+      "Calling for bids on %lu tasks together as [%s]",
+      tasks.size(),
+      batch_id.c_str());
+
+    auctioneer->request_bid(
+      bidding::make_batched_notice(batch_id, tasks, bidding_time_window));
+  }
+
+  /// Tell the auctioneer that the result for this task is settled. For a task
+  /// that was bid on as part of a batch, the auctioneer is only told once the
+  /// results for the whole batch are settled.
+  void settle_bid(const TaskID& task_id)
+  {
+    const auto b_it = batch_of_task.find(task_id);
+    if (b_it == batch_of_task.end())
+    {
+      auctioneer->ready_for_next_bid();
+      return;
+    }
+
+    const auto batch_it = bid_batches.find(b_it->second);
+    batch_of_task.erase(b_it);
+    if (batch_it == bid_batches.end())
+      return;
+
+    if (--batch_it->second.unsettled > 0)
+      return;
+
+    bid_batches.erase(batch_it);
+    auctioneer->ready_for_next_bid();
+  }
+
   bool cancel_task(const TaskID& task_id)
   {
     using Status = DispatchState::Status;
@@ -738,6 +995,22 @@ public:
     return false;
   }
 
+  void conclude_auction(
+    const TaskID& auction_id,
+    const std::optional<bidding::Response::Proposal> winner,
+    const std::vector<std::string>& errors)
+  {
+    const auto batch_it = bid_batches.find(auction_id);
+    if (batch_it == bid_batches.end())
+      return conclude_bid(auction_id, winner, errors);
+
+    // The winner of a batch takes every task in it. Settling the tasks may
+    // erase the batch, so we iterate over a copy of its tasks.
+    const auto tasks = batch_it->second.tasks;
+    for (const auto& task_id : tasks)
+      conclude_bid(task_id, winner, errors);
+  }
+
   void conclude_bid(
     const TaskID& task_id,
     const std::optional<bidding::Response::Proposal> winner,
@@ -746,16 +1019,29 @@ public:
     const auto it = active_dispatch_states.find(task_id);
     if (it == active_dispatch_states.end())
     {
-      RCLCPP_ERROR(
-        node->get_logger(),
-        "Received a winning bid for a task request [%s] which is no longer "
-        "being dispatched. This may indicate a bug and should be reported to "
-        "the developers of RMF.",
-        task_id.c_str());
+      const auto finished_it = finished_dispatch_states.find(task_id);
+      const bool canceled = finished_it != finished_dispatch_states.end()
+        && finished_it->second->status
+        == DispatchState::Status::CanceledInFlight;
+
+      if (!canceled)
+      {
+        RCLCPP_ERROR(
+          node->get_logger(),
+          "Received a winning bid for a task request [%s] which is no longer "
+          "being dispatched. This may indicate a bug and should be reported to "
+          "the developers of RMF.",
+          task_id.c_str());
+      }
+
+      // There is nothing left to do for this task, so the auctioneer can
+      // move on.
+      settle_bid(task_id);
       return;
     }
 
-    auto& dispatch_state = it->second;
+    const auto dispatch_state = it->second;
+    mark_changed(task_id);
     for (const auto& error : errors)
     {
       try
@@ -791,6 +1077,7 @@ public:
         "No fleet adapters offered a bid for task [" + task_id + "]";
 
       dispatch_state->errors.push_back(std::move(error));
+      move_to_finished(task_id);
 
       if (on_change_fn)
         on_change_fn(*dispatch_state);
@@ -821,7 +1108,7 @@ public:
       update_msg.data = task_state_update.dump();
       task_state_update_pub->publish(update_msg);
 
-      auctioneer->ready_for_next_bid();
+      settle_bid(task_id);
       return;
     }
 
@@ -849,6 +1136,7 @@ public:
 
     lingering_commands[award_command.dispatch_id] = award_command;
     dispatch_command_pub->publish(award_command);
+    rmf_traffic_ros2::tracing::instant("dispatch_award", task_id);
   }
 
   //==============================================================================
@@ -901,29 +1189,50 @@ public:
   void move_to_finished(const std::string& task_id)
   {
     const auto active_it = active_dispatch_states.find(task_id);
+    if (active_it == active_dispatch_states.end())
+      return;
+
+    finished_dispatch_states[task_id] = std::move(active_it->second);
+    active_dispatch_states.erase(active_it);
+    mark_changed(task_id);
+
+    // A task ID that finishes again is treated as the most recently finished
+    const auto position_it = finished_position.find(task_id);
+    if (position_it != finished_position.end())
+      finished_order.erase(position_it->second);
+
+    const auto now = std::chrono::steady_clock::now();
+    finished_order.push_back(FinishedEntry{task_id, now});
+    finished_position[task_id] = std::prev(finished_order.end());
+
+    evict_finished(now);
+  }
 
-    // TODO(MXG): We can make this more efficient by having a queue of
-    // finished dispatch state IDs in chronological order
-    if (finished_dispatch_states.size() >= terminated_tasks_max_size)
+  /// Forget the oldest finished dispatch states until there are no more than
+  /// terminated_tasks_max_size of them and none are older than
+  /// terminated_tasks_max_age.
+  void evict_finished(std::chrono::steady_clock::time_point now)
+  {
+    while (!finished_order.empty())
     {
-      auto check_it = finished_dispatch_states.begin();
-      auto oldest_it = check_it++;
-      for (; check_it != finished_dispatch_states.end(); ++check_it)
-      {
-        const auto& check = check_it->second->submission_time;
-        const auto& oldest = oldest_it->second->submission_time;
-        if (check < oldest)
-          oldest_it = check_it;
-      }
+      const auto& oldest = finished_order.front();
+      const bool too_many = finished_order.size() > terminated_tasks_max_size;
+      const bool too_old = terminated_tasks_max_age.has_value()
+        && oldest.finish_time + *terminated_tasks_max_age < now;
 
-      finished_dispatch_states.erase(oldest_it);
-    }
+      if (!too_many && !too_old)
+        break;
 
-    finished_dispatch_states[active_it->first] = active_it->second;
+      finished_dispatch_states.erase(oldest.task_id);
+      finished_position.erase(oldest.task_id);
+      finished_order.pop_front();
+    }
   }
 
   void publish_dispatch_states()
   {
+    evict_finished(std::chrono::steady_clock::now());
+
     const auto fill_states = [](auto& into, const auto& from)
       {
         for (const auto& [id, state] : from)
@@ -941,6 +1250,44 @@ public:
       .finished(std::move(finished)));
   }
 
+  void mark_changed(const TaskID& task_id)
+  {
+    if (publish_dispatch_state_deltas)
+      changed_dispatch_states.insert(task_id);
+  }
+
+  /// Publish only the dispatch states that changed since the last time this
+  /// was called. States that were evicted are left out, so subscribers should
+  /// rely on the full snapshots to forget old states.
+  void publish_dispatch_state_updates()
+  {
+    evict_finished(std::chrono::steady_clock::now());
+    if (changed_dispatch_states.empty())
+      return;
+
+    std::vector<DispatchStateMsg> active;
+    std::vector<DispatchStateMsg> finished;
+    for (const auto& task_id : changed_dispatch_states)
+    {
+      const auto active_it = active_dispatch_states.find(task_id);
+      if (active_it != active_dispatch_states.end())
+      {
+        active.push_back(convert(*active_it->second));
+        continue;
+      }
+
+      const auto finished_it = finished_dispatch_states.find(task_id);
+      if (finished_it != finished_dispatch_states.end())
+        finished.push_back(convert(*finished_it->second));
+    }
+    changed_dispatch_states.clear();
+
+    dispatch_state_updates_pub->publish(
+      rmf_task_msgs::build<DispatchStatesMsg>()
+      .active(std::move(active))
+      .finished(std::move(finished)));
+  }
+
   void publish_lingering_commands()
   {
     std::vector<uint64_t> expired_commands;
@@ -988,7 +1335,7 @@ public:
         request.fleet_name.c_str());
 
       if (request.type == request.TYPE_AWARD)
-        auctioneer->ready_for_next_bid();
+        settle_bid(request.task_id);
 
       lingering_commands.erase(it);
     }
@@ -1011,6 +1358,19 @@ public:
       const auto state_it = active_dispatch_states.find(command.task_id);
       if (state_it == active_dispatch_states.end())
       {
+        settle_bid(command.task_id);
+
+        const auto finished_it =
+          finished_dispatch_states.find(command.task_id);
+        if (finished_it != finished_dispatch_states.end()
+          && finished_it->second->status
+          == DispatchState::Status::CanceledInFlight)
+        {
+          // The task was canceled after it was awarded. There should be
+          // another lingering command telling the fleet adapter to remove it.
+          return;
+        }
+
         RCLCPP_ERROR(
           node->get_logger(),
           "Could not find active dispatch state for [%s] despite receiving an "
@@ -1024,6 +1384,7 @@ public:
       if (state->status == DispatchState::Status::Selected)
       {
         state->status = DispatchState::Status::Dispatched;
+        mark_changed(state->task_id);
         move_to_finished(state->task_id);
       }
       else if (state->status == DispatchState::Status::CanceledInFlight)
@@ -1043,7 +1404,7 @@ public:
           static_cast<uint8_t>(state->status));
       }
 
-      auctioneer->ready_for_next_bid();
+      settle_bid(command.task_id);
       return;
     }
     else if (command.type == DispatchCommandMsg::TYPE_REMOVE)
@@ -1135,6 +1496,13 @@ void Dispatcher::evaluator(bidding::Auctioneer::ConstEvaluatorPtr evaluator)
   _pimpl->auctioneer->set_evaluator(std::move(evaluator));
 }
 
+//==============================================================================
+void Dispatcher::joint_evaluator(
+  bidding::Auctioneer::ConstJointEvaluatorPtr evaluator)
+{
+  _pimpl->auctioneer->set_joint_evaluator(std::move(evaluator));
+}
+
 //==============================================================================
 std::shared_ptr<rclcpp::Node> Dispatcher::node()
 {
@@ -22,41 +22,203 @@
 #include <rmf_task_msgs/msg/bid_proposal.hpp>
 #include <rmf_task_ros2/StandardNames.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+
 namespace rmf_task_ros2 {
 namespace bidding {
 
+namespace {
+//==============================================================================
+// A notice that has been received, and whether a response to it still matters
+struct Ticket
+{
+  BidNoticeMsg notice;
+  std::chrono::steady_clock::time_point deadline;
+  std::atomic_bool cancelled{false};
+  std::atomic_bool responded{false};
+
+  bool expired() const
+  {
+    return cancelled || std::chrono::steady_clock::now() >= deadline;
+  }
+};
+
+using TicketPtr = std::shared_ptr<Ticket>;
+using BidResponsePub = rclcpp::Publisher<BidResponseMsg>;
+
+//==============================================================================
+// Responses may arrive from any thread and may outlive the bidder, so the
+// notices that are being handled are kept in a queue that is shared with the
+// respond callbacks.
+class NoticeQueue : public std::enable_shared_from_this<NoticeQueue>
+{
+public:
+
+  NoticeQueue(
+    AsyncBidder::ReceiveCancellableNotice receive_notice_,
+    BidResponsePub::SharedPtr pub_,
+    rclcpp::Logger logger_)
+  : receive_notice(std::move(receive_notice_)),
+    pub(std::move(pub_)),
+    logger(std::move(logger_))
+  {
+    // Do nothing
+  }
+
+  void push(const BidNoticeMsg& notice)
+  {
+    const auto ticket = std::make_shared<Ticket>();
+    ticket->notice = notice;
+    ticket->deadline = std::chrono::steady_clock::now()
+      + rclcpp::Duration(notice.time_window)
+      .to_chrono<std::chrono::nanoseconds>();
+
+    std::vector<TicketPtr> preempted;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      waiting.push_back(ticket);
+      while (waiting.size() > max_queued)
+      {
+        preempted.push_back(waiting.front());
+        waiting.pop_front();
+      }
+    }
+
+    for (const auto& old : preempted)
+    {
+      if (old->expired())
+        continue;
+
+      RCLCPP_WARN(
+        logger,
+        "[Bidder] Declining bid notice for task_id [%s] because too many "
+        "newer notices are waiting to be handled",
+        old->notice.task_id.c_str());
+
+      old->cancelled = true;
+      pub->publish(convert(Response{std::nullopt, {}}, old->notice.task_id));
+    }
+
+    dispatch();
+  }
+
+  // Pass on as many waiting notices as the limit allows
+  void dispatch()
+  {
+    std::vector<TicketPtr> starting;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      // Notices whose time window has passed no longer hold up the others
+      in_flight.erase(
+        std::remove_if(
+          in_flight.begin(), in_flight.end(),
+          [](const TicketPtr& t) { return t->expired(); }),
+        in_flight.end());
+
+      while (!waiting.empty()
+        && (!max_concurrent.has_value() || in_flight.size() < *max_concurrent))
+      {
+        auto ticket = std::move(waiting.front());
+        waiting.pop_front();
+        if (ticket->expired())
+        {
+          RCLCPP_DEBUG(
+            logger,
+            "[Bidder] Dropping bid notice for task_id [%s] because its time "
+            "window has passed",
+            ticket->notice.task_id.c_str());
+          continue;
+        }
+
+        in_flight.push_back(ticket);
+        starting.push_back(std::move(ticket));
+      }
+    }
+
+    if (!receive_notice)
+      return;
+
+    for (const auto& ticket : starting)
+    {
+      receive_notice(
+        ticket->notice,
+        [w = weak_from_this(), ticket, pub = pub](const Response& response)
+        {
+          if (ticket->responded.exchange(true))
+            return;
+
+          if (!ticket->expired())
+            pub->publish(convert(response, ticket->notice.task_id));
+
+          if (const auto self = w.lock())
+            self->release(ticket);
+        },
+        [ticket]() { return ticket->expired(); });
+    }
+  }
+
+  void release(const TicketPtr& ticket)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      const auto it = std::find(in_flight.begin(), in_flight.end(), ticket);
+      if (it != in_flight.end())
+        in_flight.erase(it);
+    }
+
+    dispatch();
+  }
+
+  AsyncBidder::ReceiveCancellableNotice receive_notice;
+  BidResponsePub::SharedPtr pub;
+  rclcpp::Logger logger;
+
+  mutable std::mutex mutex;
+  std::optional<std::size_t> max_concurrent;
+  std::size_t max_queued = 100;
+  std::deque<TicketPtr> waiting;
+  std::vector<TicketPtr> in_flight;
+};
+} // anonymous namespace
+
 //==============================================================================
 class AsyncBidder::Implementation
 {
 public:
 
   std::weak_ptr<rclcpp::Node> w_node;
-  ReceiveNotice receive_notice;
 
   using BidNoticeSub = rclcpp::Subscription<BidNoticeMsg>;
   BidNoticeSub::SharedPtr bid_notice_sub;
 
-  using BidResponsePub = rclcpp::Publisher<BidResponseMsg>;
   BidResponsePub::SharedPtr bid_response_pub;
 
+  std::shared_ptr<NoticeQueue> queue;
+
   Implementation(
     std::shared_ptr<rclcpp::Node> node_,
-    ReceiveNotice receive_notice)
-  : w_node{std::move(node_)},
-    receive_notice{std::move(receive_notice)}
+    ReceiveCancellableNotice receive_notice)
+  : w_node{std::move(node_)}
   {
     const auto bid_qos = rclcpp::ServicesQoS().reliable();
     const auto node = w_node.lock();
 
+    bid_response_pub = node->create_publisher<BidResponseMsg>(
+      rmf_task_ros2::BidResponseTopicName, bid_qos);
+
+    queue = std::make_shared<NoticeQueue>(
+      std::move(receive_notice), bid_response_pub, node->get_logger());
+
     bid_notice_sub = node->create_subscription<BidNoticeMsg>(
       rmf_task_ros2::BidNoticeTopicName, bid_qos,
       [&](const BidNoticeMsg::UniquePtr msg)
       {
         this->handle_notice(*msg);
       });
-
-    bid_response_pub = node->create_publisher<BidResponseMsg>(
-      rmf_task_ros2::BidResponseTopicName, bid_qos);
   }
 
   // Callback fn when a dispatch notice is received
@@ -71,17 +233,10 @@ public:
       msg.task_id.c_str());
 
     // check if the user did not supply a receive notice callback
-    if (!receive_notice)
+    if (!queue->receive_notice)
       return;
 
-    // Send the notice
-    receive_notice(
-      msg,
-      [task_id = msg.task_id, pub = bid_response_pub](
-        const Response& response)
-      {
-        pub->publish(convert(response, task_id));
-      });
+    queue->push(msg);
   }
 };
 
@@ -89,14 +244,65 @@ public:
 std::shared_ptr<AsyncBidder> AsyncBidder::make(
   const std::shared_ptr<rclcpp::Node>& node,
   ReceiveNotice receive_notice)
+{
+  ReceiveCancellableNotice cancellable = nullptr;
+  if (receive_notice)
+  {
+    cancellable = [receive_notice = std::move(receive_notice)](
+      const BidNoticeMsg& notice, Respond respond, IsCancelled)
+      {
+        receive_notice(notice, std::move(respond));
+      };
+  }
+
+  return make_cancellable(node, std::move(cancellable));
+}
+
+//==============================================================================
+std::shared_ptr<AsyncBidder> AsyncBidder::make_cancellable(
+  const std::shared_ptr<rclcpp::Node>& node,
+  ReceiveCancellableNotice receive_notice)
 {
   auto bidder = std::shared_ptr<AsyncBidder>(new AsyncBidder());
   bidder->_pimpl =
-    rmf_utils::make_unique_impl<Implementation>(node, receive_notice);
+    rmf_utils::make_unique_impl<Implementation>(
+    node, std::move(receive_notice));
 
   return bidder;
 }
 
+//==============================================================================
+void AsyncBidder::set_max_concurrent_notices(std::optional<std::size_t> max)
+{
+  {
+    std::lock_guard<std::mutex> lock(_pimpl->queue->mutex);
+    _pimpl->queue->max_concurrent = max;
+  }
+
+  _pimpl->queue->dispatch();
+}
+
+//==============================================================================
+std::optional<std::size_t> AsyncBidder::max_concurrent_notices() const
+{
+  std::lock_guard<std::mutex> lock(_pimpl->queue->mutex);
+  return _pimpl->queue->max_concurrent;
+}
+
+//==============================================================================
+void AsyncBidder::set_max_queued_notices(std::size_t max)
+{
+  std::lock_guard<std::mutex> lock(_pimpl->queue->mutex);
+  _pimpl->queue->max_queued = std::max<std::size_t>(max, 1);
+}
+
+//==============================================================================
+std::size_t AsyncBidder::max_queued_notices() const
+{
+  std::lock_guard<std::mutex> lock(_pimpl->queue->mutex);
+  return _pimpl->queue->max_queued;
+}
+
 //==============================================================================
 AsyncBidder::AsyncBidder()
 {
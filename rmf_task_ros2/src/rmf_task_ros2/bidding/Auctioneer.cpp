@@ -21,6 +21,9 @@
 
 #include "internal_Auctioneer.hpp"
 
+#include <algorithm>
+#include <limits>
+
 namespace rmf_task_ros2 {
 namespace bidding {
 
@@ -74,16 +77,6 @@ Auctioneer::Implementation::Implementation(
     {
       this->receive_response(*msg);
     });
-
-  timer = rclcpp::create_wall_timer(
-    std::chrono::milliseconds(200),
-    [&]()
-      {
-        this->finish_bidding_process();
-      },
-    nullptr,
-    node_base_interface.get(),
-    node_timers_interface.get());
 }
 
 //==============================================================================
@@ -95,9 +88,13 @@ void Auctioneer::Implementation::request_bid(
     "Add Task [%s] to a bidding queue",
     bid_notice.task_id.c_str());
 
-  open_bid_queue.push(
+  pending_bids.push_back(
     OpenBid{bid_notice,
-      node_clock_interface->get_clock()->now(), {}});
+      node_clock_interface->get_clock()->now(), {}, nullptr,
+      rmf_traffic_ros2::tracing::Span::begin(
+        "auction_queue", bid_notice.task_id)});
+
+  start_pending_bids();
 }
 
 //==============================================================================
@@ -123,51 +120,166 @@ void Auctioneer::Implementation::receive_response(const BidResponseMsg& msg)
 
   // check if bidding task is initiated by the auctioneer previously
   // add submited proposal to the current bidding tasks list
-  if (open_bid_queue.front().bid_notice.task_id == id)
-    open_bid_queue.front().responses.push_back(response);
+  const auto it = open_bids.find(id);
+  if (it == open_bids.end())
+    return;
+
+  it->second.responses.push_back(response);
+
+  // Without an early close, nothing can change until the deadline
+  if (early_close)
+    finish_bidding_process(id);
 }
 
 //==============================================================================
-// determine the winner within a bidding task instance
-void Auctioneer::Implementation::finish_bidding_process()
+bool Auctioneer::Implementation::finish_bidding_process(
+  const std::string& task_id)
 {
-  if (open_bid_queue.size() == 0)
-    return;
+  const auto it = open_bids.find(task_id);
+  if (it == open_bids.end())
+    return true;
 
-  // Executing the task at the front queue
-  auto front_task = open_bid_queue.front();
+  if (!ready_to_conclude(it->second))
+    return false;
 
-  if (bidding_in_process)
+  // Take the auctions out before concluding them, because the result callback
+  // may start other auctions.
+  std::vector<OpenBid> concluding;
+  concluding.push_back(std::move(it->second));
+  open_bids.erase(it);
+
+  if (joint_evaluator)
   {
-    if (determine_winner(front_task))
+    auto other = open_bids.begin();
+    while (other != open_bids.end())
     {
-      open_bid_queue.pop();
+      if (ready_to_conclude(other->second))
+      {
+        concluding.push_back(std::move(other->second));
+        other = open_bids.erase(other);
+      }
+      else
+      {
+        ++other;
+      }
     }
   }
-  else
+
+  for (auto& bid : concluding)
+  {
+    bid.deadline->cancel();
+    bid.trace.arg("responses", std::to_string(bid.responses.size())).end();
+  }
+
+  const auto winners = evaluate_jointly(concluding);
+  for (std::size_t i = 0; i < concluding.size(); ++i)
+    determine_winner(concluding[i], winners[i]);
+
+  start_pending_bids();
+  return true;
+}
+
+//==============================================================================
+void Auctioneer::Implementation::start_pending_bids()
+{
+  // Auctions that start together share a start time so that they will also
+  // be ready to conclude together.
+  const auto now = node_clock_interface->get_clock()->now();
+  while (!pending_bids.empty()
+    && open_bids.size() + unsettled_bids < max_concurrent_bids)
   {
+    // An auction for the same task ID cannot be told apart from one that is
+    // still open, so it waits until that one is finished. Later auctions wait
+    // behind it to keep the order that they were requested in.
+    const auto& task_id = pending_bids.front().bid_notice.task_id;
+    if (open_bids.count(task_id) > 0)
+      break;
+
     RCLCPP_INFO(
       node_logging_interface->get_logger(),
       " - Start new bidding task: %s",
-      front_task.bid_notice.task_id.c_str());
-    open_bid_queue.front().start_time =
-      node_clock_interface->get_clock()->now();
-    bid_notice_pub->publish(front_task.bid_notice);
-    bidding_in_process = true;
+      task_id.c_str());
+
+    auto bid = std::move(pending_bids.front());
+    pending_bids.pop_front();
+    bid.start_time = now;
+    bid.trace = rmf_traffic_ros2::tracing::Span::begin(
+      "auction", bid.bid_notice.task_id);
+    bid_notice_pub->publish(bid.bid_notice);
+    schedule_deadline(bid);
+    open_bids.insert({bid.bid_notice.task_id, std::move(bid)});
   }
 }
 
 //==============================================================================
-bool Auctioneer::Implementation::determine_winner(
-  const OpenBid& bidding_task)
+void Auctioneer::Implementation::schedule_deadline(OpenBid& bid)
+{
+  const auto clock = node_clock_interface->get_clock();
+  const auto remaining = rclcpp::Duration(bid.bid_notice.time_window)
+    - (clock->now() - bid.start_time);
+
+  // Timers need a positive period
+  const auto period = std::max(
+    remaining, rclcpp::Duration(std::chrono::milliseconds(1)));
+
+  bid.deadline = rclcpp::create_timer(
+    node_base_interface,
+    node_timers_interface,
+    clock,
+    period,
+    [this, task_id = bid.bid_notice.task_id]()
+    {
+      if (this->finish_bidding_process(task_id))
+        return;
+
+      // The clock may have been adjusted since the deadline was scheduled,
+      // so aim for the deadline again instead of waiting another full period.
+      const auto it = this->open_bids.find(task_id);
+      if (it != this->open_bids.end())
+        this->schedule_deadline(it->second);
+    });
+}
+
+//==============================================================================
+bool Auctioneer::Implementation::ready_to_conclude(
+  const OpenBid& bidding_task) const
 {
   const auto duration =
     node_clock_interface->get_clock()->now() - bidding_task.start_time;
   if (duration < bidding_task.bid_notice.time_window)
-    return false;
+  {
+    if (!early_close)
+      return false;
 
+    // Every bidder listens for notices with exactly one subscription and
+    // responds once to each notice, so the auction can be closed once there
+    // are as many responses as subscriptions. Anything else listening to the
+    // notices will only make us fall back to waiting for the time window.
+    const auto bidders = bid_notice_pub->get_subscription_count();
+    if (bidders == 0 || bidding_task.responses.size() < bidders)
+      return false;
+
+    RCLCPP_DEBUG(
+      node_logging_interface->get_logger(),
+      "All %lu bidders have responded to [%s]",
+      bidders,
+      bidding_task.bid_notice.task_id.c_str());
+  }
+
+  return true;
+}
+
+//==============================================================================
+void Auctioneer::Implementation::determine_winner(
+  const OpenBid& bidding_task,
+  const std::optional<Response::Proposal>& winner)
+{
   if (!bidding_result_callback)
-    return true;
+    return;
+
+  // The callback may settle this auction right away, so it needs to be counted
+  // before the callback is triggered.
+  ++unsettled_bids;
 
   auto task_id = bidding_task.bid_notice.task_id;
   RCLCPP_DEBUG(
@@ -188,10 +300,9 @@ bool Auctioneer::Implementation::determine_winner(
       "Task auction for [%s] did not received any bids", task_id.c_str());
 
     bidding_result_callback(task_id, std::nullopt, errors);
-    return true;
+    return;
   }
 
-  auto winner = evaluate(bidding_task.responses);
   if (winner.has_value())
   {
     RCLCPP_INFO(
@@ -203,8 +314,6 @@ bool Auctioneer::Implementation::determine_winner(
 
   // Call the user defined callback function
   bidding_result_callback(task_id, winner, errors);
-
-  return true;
 }
 
 //==============================================================================
@@ -232,6 +341,53 @@ std::optional<Response::Proposal> Auctioneer::Implementation::evaluate(
   return responses[*choice].proposal;
 }
 
+//==============================================================================
+std::vector<std::optional<Response::Proposal>>
+Auctioneer::Implementation::evaluate_jointly(const std::vector<OpenBid>& bids)
+{
+  std::vector<std::optional<Response::Proposal>> winners;
+  winners.reserve(bids.size());
+  if (!joint_evaluator || bids.size() < 2)
+  {
+    for (const auto& bid : bids)
+      winners.push_back(evaluate(bid.responses));
+
+    return winners;
+  }
+
+  std::vector<Responses> auctions;
+  auctions.reserve(bids.size());
+  for (const auto& bid : bids)
+    auctions.push_back(bid.responses);
+
+  const auto choices = joint_evaluator->choose(auctions);
+  if (choices.size() != auctions.size())
+  {
+    RCLCPP_WARN(
+      node_logging_interface->get_logger(),
+      "Joint bidding evaluator chose %lu winners for %lu auctions. The "
+      "auctions will be evaluated one at a time instead.",
+      choices.size(),
+      auctions.size());
+
+    for (const auto& responses : auctions)
+      winners.push_back(evaluate(responses));
+
+    return winners;
+  }
+
+  for (std::size_t i = 0; i < auctions.size(); ++i)
+  {
+    const auto& choice = choices[i];
+    if (choice.has_value() && *choice < auctions[i].size())
+      winners.push_back(auctions[i][*choice].proposal);
+    else
+      winners.push_back(std::nullopt);
+  }
+
+  return winners;
+}
+
 //==============================================================================
 std::shared_ptr<Auctioneer> Auctioneer::make(
   const std::shared_ptr<rclcpp::Node>& node,
@@ -289,7 +445,35 @@ void Auctioneer::request_bid(const BidNoticeMsg& bid_notice)
 //==============================================================================
 void Auctioneer::ready_for_next_bid()
 {
-  _pimpl->bidding_in_process = false;
+  if (_pimpl->unsettled_bids > 0)
+    --_pimpl->unsettled_bids;
+
+  _pimpl->start_pending_bids();
+}
+
+//==============================================================================
+void Auctioneer::set_max_concurrent_bids(std::size_t max)
+{
+  _pimpl->max_concurrent_bids = std::max<std::size_t>(max, 1);
+  _pimpl->start_pending_bids();
+}
+
+//==============================================================================
+std::size_t Auctioneer::max_concurrent_bids() const
+{
+  return _pimpl->max_concurrent_bids;
+}
+
+//==============================================================================
+void Auctioneer::set_early_close(bool enabled)
+{
+  _pimpl->early_close = enabled;
+}
+
+//==============================================================================
+bool Auctioneer::early_close() const
+{
+  return _pimpl->early_close;
 }
 
 //==============================================================================
@@ -298,6 +482,12 @@ void Auctioneer::set_evaluator(ConstEvaluatorPtr evaluator)
   _pimpl->evaluator = std::move(evaluator);
 }
 
+//==============================================================================
+void Auctioneer::set_joint_evaluator(ConstJointEvaluatorPtr evaluator)
+{
+  _pimpl->joint_evaluator = std::move(evaluator);
+}
+
 //==============================================================================
 Auctioneer::Auctioneer()
 {
@@ -327,6 +517,88 @@ std::optional<std::size_t> select_best(
 
   return best_index;
 }
+
+//==============================================================================
+/// Solve the assignment problem for a cost matrix with no more rows than
+/// columns using the Hungarian algorithm. The result gives the column assigned
+/// to each row.
+std::vector<std::size_t> solve_assignment(
+  const std::vector<std::vector<double>>& cost)
+{
+  const std::size_t n = cost.size();
+  const std::size_t m = n > 0 ? cost.front().size() : 0;
+  const double inf = std::numeric_limits<double>::infinity();
+
+  // Rows and columns are counted from 1 here, with column 0 standing in for
+  // the row that is being added to the assignment.
+  std::vector<double> u(n + 1, 0.0);
+  std::vector<double> v(m + 1, 0.0);
+  std::vector<std::size_t> row_of_col(m + 1, 0);
+  std::vector<std::size_t> way(m + 1, 0);
+  for (std::size_t i = 1; i <= n; ++i)
+  {
+    row_of_col[0] = i;
+    std::size_t col = 0;
+    std::vector<double> min_v(m + 1, inf);
+    std::vector<bool> used(m + 1, false);
+    do
+    {
+      used[col] = true;
+      const std::size_t row = row_of_col[col];
+      double delta = inf;
+      std::size_t next_col = 0;
+      for (std::size_t j = 1; j <= m; ++j)
+      {
+        if (used[j])
+          continue;
+
+        const double reduced = cost[row - 1][j - 1] - u[row] - v[j];
+        if (reduced < min_v[j])
+        {
+          min_v[j] = reduced;
+          way[j] = col;
+        }
+
+        if (min_v[j] < delta)
+        {
+          delta = min_v[j];
+          next_col = j;
+        }
+      }
+
+      for (std::size_t j = 0; j <= m; ++j)
+      {
+        if (used[j])
+        {
+          u[row_of_col[j]] += delta;
+          v[j] -= delta;
+        }
+        else
+        {
+          min_v[j] -= delta;
+        }
+      }
+
+      col = next_col;
+    } while (row_of_col[col] != 0);
+
+    do
+    {
+      const std::size_t prev_col = way[col];
+      row_of_col[col] = row_of_col[prev_col];
+      col = prev_col;
+    } while (col != 0);
+  }
+
+  std::vector<std::size_t> assignment(n, 0);
+  for (std::size_t j = 1; j <= m; ++j)
+  {
+    if (row_of_col[j] != 0)
+      assignment[row_of_col[j] - 1] = j - 1;
+  }
+
+  return assignment;
+}
 } // anonymous namespace
 
 //==============================================================================
@@ -360,5 +632,129 @@ std::optional<std::size_t> QuickestFinishEvaluator::choose(
     });
 }
 
+//==============================================================================
+std::vector<std::optional<std::size_t>>
+BalancedQuickestFinishEvaluator::choose(
+  const std::vector<Responses>& auctions) const
+{
+  std::vector<std::optional<std::size_t>> choices(auctions.size());
+
+  // Index the fleets that made any proposal, and measure finish times from the
+  // earliest one to keep the costs small.
+  std::unordered_map<std::string, std::size_t> fleet_index;
+  std::optional<rmf_traffic::Time> earliest;
+  for (const auto& responses : auctions)
+  {
+    for (const auto& response : responses)
+    {
+      if (!response.proposal.has_value())
+        continue;
+
+      const auto& proposal = *response.proposal;
+      fleet_index.insert({proposal.fleet_name, fleet_index.size()});
+      if (!earliest.has_value() || proposal.finish_time < *earliest)
+        earliest = proposal.finish_time;
+    }
+  }
+
+  if (fleet_index.empty())
+    return choices;
+
+  // Any real assignment is preferred over leaving an auction for a later
+  // round, so a missing proposal costs more than every real one put together.
+  std::vector<std::vector<std::optional<std::size_t>>> proposal_of(
+    auctions.size(),
+    std::vector<std::optional<std::size_t>>(fleet_index.size()));
+  std::vector<std::vector<double>> finish(
+    auctions.size(), std::vector<double>(fleet_index.size(), 0.0));
+  double total = 0.0;
+  for (std::size_t a = 0; a < auctions.size(); ++a)
+  {
+    for (std::size_t r = 0; r < auctions[a].size(); ++r)
+    {
+      const auto& proposal = auctions[a][r].proposal;
+      if (!proposal.has_value())
+        continue;
+
+      const std::size_t f = fleet_index.at(proposal->fleet_name);
+      const double t = rmf_traffic::time::to_seconds(
+        proposal->finish_time - *earliest);
+
+      // If a fleet responded more than once, keep its quickest proposal
+      if (proposal_of[a][f].has_value() && finish[a][f] <= t)
+        continue;
+
+      proposal_of[a][f] = r;
+      finish[a][f] = t;
+      total += t;
+    }
+  }
+  const double missing = 2.0 * total + 1.0;
+
+  std::vector<std::size_t> remaining;
+  for (std::size_t a = 0; a < auctions.size(); ++a)
+  {
+    for (const auto& p : proposal_of[a])
+    {
+      if (p.has_value())
+      {
+        remaining.push_back(a);
+        break;
+      }
+    }
+  }
+
+  const std::size_t num_fleets = fleet_index.size();
+  while (!remaining.empty())
+  {
+    // The solver needs at least as many columns as rows, so assign fleets to
+    // auctions when there are more auctions than fleets.
+    const bool by_fleet = remaining.size() > num_fleets;
+    const std::size_t rows = by_fleet ? num_fleets : remaining.size();
+    const std::size_t cols = by_fleet ? remaining.size() : num_fleets;
+    std::vector<std::vector<double>> cost(rows, std::vector<double>(cols));
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+      for (std::size_t j = 0; j < cols; ++j)
+      {
+        const std::size_t a = remaining[by_fleet ? j : i];
+        const std::size_t f = by_fleet ? i : j;
+        cost[i][j] = proposal_of[a][f].has_value() ? finish[a][f] : missing;
+      }
+    }
+
+    const auto assignment = solve_assignment(cost);
+    std::vector<bool> assigned(remaining.size(), false);
+    bool progress = false;
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+      const std::size_t k = by_fleet ? assignment[i] : i;
+      const std::size_t a = remaining[k];
+      const std::size_t f = by_fleet ? i : assignment[i];
+      if (!proposal_of[a][f].has_value())
+        continue;
+
+      choices[a] = proposal_of[a][f];
+      assigned[k] = true;
+      progress = true;
+    }
+
+    // The cost of a missing proposal means every round assigns at least one
+    // auction, but make sure this can never loop forever.
+    if (!progress)
+      break;
+
+    std::vector<std::size_t> next;
+    for (std::size_t k = 0; k < remaining.size(); ++k)
+    {
+      if (!assigned[k])
+        next.push_back(remaining[k]);
+    }
+    remaining = std::move(next);
+  }
+
+  return choices;
+}
+
 } // namespace bidding
 } // namespace rmf_task_ros2
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_task_ros2/bidding/BatchedNotice.hpp>
+
+#include <nlohmann/json.hpp>
+
+namespace rmf_task_ros2 {
+namespace bidding {
+
+//==============================================================================
+BidNoticeMsg make_batched_notice(
+  const std::string& batch_id,
+  const std::vector<BatchedTask>& tasks,
+  const builtin_interfaces::msg::Duration& time_window,
+  bool dry_run)
+{
+  nlohmann::json batch = nlohmann::json::array();
+  for (const auto& task : tasks)
+  {
+    nlohmann::json entry;
+    entry["task_id"] = task.task_id;
+    entry["request"] = nlohmann::json::parse(task.request);
+    batch.push_back(std::move(entry));
+  }
+
+  nlohmann::json request;
+  request["batch"] = std::move(batch);
+
+  return rmf_task_msgs::build<BidNoticeMsg>()
+    .request(request.dump())
+    .task_id(batch_id)
+    .time_window(time_window)
+    .dry_run(dry_run);
+}
+
+//==============================================================================
+std::optional<std::vector<BatchedTask>> read_batched_notice(
+  const BidNoticeMsg& notice)
+{
+  const auto request =
+    nlohmann::json::parse(notice.request, nullptr, false);
+
+  if (!request.is_object())
+    return std::nullopt;
+
+  const auto batch_it = request.find("batch");
+  if (batch_it == request.end() || !batch_it->is_array())
+    return std::nullopt;
+
+  std::vector<BatchedTask> tasks;
+  tasks.reserve(batch_it->size());
+  for (const auto& entry : *batch_it)
+  {
+    if (!entry.is_object())
+      return std::nullopt;
+
+    const auto id_it = entry.find("task_id");
+    const auto request_it = entry.find("request");
+    if (id_it == entry.end() || !id_it->is_string()
+      || request_it == entry.end())
+    {
+      return std::nullopt;
+    }
+
+    tasks.push_back(
+      BatchedTask{id_it->get<std::string>(), request_it->dump()});
+  }
+
+  return tasks;
+}
+
+} // namespace bidding
+} // namespace rmf_task_ros2
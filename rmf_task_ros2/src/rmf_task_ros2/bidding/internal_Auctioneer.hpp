@@ -24,8 +24,12 @@
 #include <rmf_task_msgs/msg/bid_proposal.hpp>
 
 #include <rmf_traffic_ros2/Time.hpp>
+#include <rmf_traffic_ros2/Tracing.hpp>
 #include <rmf_task_ros2/StandardNames.hpp>
 
+#include <deque>
+#include <unordered_map>
+
 namespace rmf_task_ros2 {
 namespace bidding {
 
@@ -43,19 +47,36 @@ public:
   rclcpp::node_interfaces::NodeParametersInterface::SharedPtr
   node_parameters_interface;
 
-  rclcpp::TimerBase::SharedPtr timer;
   BiddingResultCallback bidding_result_callback;
   ConstEvaluatorPtr evaluator;
+  ConstJointEvaluatorPtr joint_evaluator;
 
   struct OpenBid
   {
     BidNoticeMsg bid_notice;
     builtin_interfaces::msg::Time start_time;
     std::vector<bidding::Response> responses;
+    // Fires when the time window of the auction is over
+    rclcpp::TimerBase::SharedPtr deadline;
+    // Times the wait in the queue and then the auction itself
+    rmf_traffic_ros2::tracing::Span trace;
   };
 
-  bool bidding_in_process = false;
-  std::queue<OpenBid> open_bid_queue;
+  // Auctions that are waiting for their turn to be announced
+  std::deque<OpenBid> pending_bids;
+
+  // Auctions that have been announced and are collecting responses, keyed by
+  // task ID
+  std::unordered_map<std::string, OpenBid> open_bids;
+
+  // Auctions that have concluded but whose results have not been settled by
+  // ready_for_next_bid() yet. These still count against max_concurrent_bids.
+  std::size_t unsettled_bids = 0;
+
+  std::size_t max_concurrent_bids = 1;
+
+  // Conclude an auction as soon as every bidder has responded to it
+  bool early_close = false;
 
   using BidNoticePub = rclcpp::Publisher<BidNoticeMsg>;
   BidNoticePub::SharedPtr bid_notice_pub;
@@ -85,13 +106,28 @@ public:
   // Receive proposal and evaluate
   void receive_response(const BidResponseMsg& msg);
 
-  // determine the winner within a bidding task instance
-  void finish_bidding_process();
+  // Conclude the auction for a task if it is ready, and announce as many
+  // pending auctions as the limit allows. Returns false if the auction is
+  // still open.
+  bool finish_bidding_process(const std::string& task_id);
 
-  bool determine_winner(const OpenBid& bidding_task);
+  void start_pending_bids();
+
+  void schedule_deadline(OpenBid& bid);
+
+  bool ready_to_conclude(const OpenBid& bidding_task) const;
+
+  // Report the winner of a bidding task instance
+  void determine_winner(
+    const OpenBid& bidding_task,
+    const std::optional<Response::Proposal>& winner);
 
   std::optional<Response::Proposal> evaluate(const Responses& responses);
 
+  // Choose the winners of several auctions that are concluding together
+  std::vector<std::optional<Response::Proposal>> evaluate_jointly(
+    const std::vector<OpenBid>& bids);
+
   static const Implementation& get(const Auctioneer& auctioneer)
   {
     return *auctioneer._pimpl;
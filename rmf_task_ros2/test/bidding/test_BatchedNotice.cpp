@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_task_ros2/bidding/BatchedNotice.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <rmf_utils/catch.hpp>
+
+namespace rmf_task_ros2 {
+namespace bidding {
+
+//==============================================================================
+SCENARIO("Batched bid notices")
+{
+  nlohmann::json patrol;
+  patrol["category"] = "patrol";
+  patrol["description"] = "mocking a patrol";
+
+  nlohmann::json delivery;
+  delivery["category"] = "delivery";
+  delivery["description"] = "mocking a delivery";
+
+  builtin_interfaces::msg::Duration window;
+  window.sec = 2;
+
+  const auto notice = make_batched_notice(
+    "batch.dispatch-0",
+    {{"patrol.dispatch-0", patrol.dump()},
+      {"delivery.dispatch-1", delivery.dump()}},
+    window);
+
+  CHECK(notice.task_id == "batch.dispatch-0");
+  CHECK(notice.time_window.sec == 2);
+  CHECK_FALSE(notice.dry_run);
+
+  const auto tasks = read_batched_notice(notice);
+  REQUIRE(tasks.has_value());
+  REQUIRE(tasks->size() == 2);
+  CHECK((*tasks)[0].task_id == "patrol.dispatch-0");
+  CHECK(nlohmann::json::parse((*tasks)[0].request) == patrol);
+  CHECK((*tasks)[1].task_id == "delivery.dispatch-1");
+  CHECK(nlohmann::json::parse((*tasks)[1].request) == delivery);
+
+  BidNoticeMsg single;
+  single.task_id = "patrol.dispatch-2";
+  single.request = patrol.dump();
+  CHECK_FALSE(read_batched_notice(single).has_value());
+
+  single.request = "not json";
+  CHECK_FALSE(read_batched_notice(single).has_value());
+}
+
+} // namespace bidding
+} // namespace rmf_task_ros2
@@ -128,5 +128,57 @@ SCENARIO("Auctioneer Winner Evaluator", "[Evaluator]")
   rclcpp::shutdown(rcl_context);
 }
 
+//==============================================================================
+SCENARIO("Joint Winner Evaluator", "[Evaluator]")
+{
+  const auto proposal = [](const std::string& fleet, double finish)
+    {
+      return Response{
+        Response::Proposal{
+          fleet, "", 0.0, 0.0, rmf_traffic::time::apply_offset(now, finish)},
+        {}};
+    };
+
+  BalancedQuickestFinishEvaluator eval;
+
+  WHEN("No auctions")
+  {
+    CHECK(eval.choose({}).empty());
+  }
+
+  WHEN("One fleet is quickest for every auction")
+  {
+    // Picking the quickest finish for each auction on its own would give both
+    // to fleet1, but fleet2 costs less for the second one than the first.
+    const std::vector<Responses> auctions{
+      {proposal("fleet1", 3.0), proposal("fleet2", 5.0)},
+      {proposal("fleet2", 4.0), proposal("fleet1", 3.5)}};
+
+    const auto choices = eval.choose(auctions);
+    REQUIRE(choices.size() == 2);
+    CHECK(choices[0] == 0);
+    CHECK(choices[1] == 0);
+  }
+
+  WHEN("There are more auctions than fleets")
+  {
+    const std::vector<Responses> auctions{
+      {proposal("fleet1", 1.0), proposal("fleet2", 2.0)},
+      {proposal("fleet1", 1.5), proposal("fleet2", 2.5)},
+      {proposal("fleet1", 1.2), proposal("fleet2", 9.0)},
+      {Response{std::nullopt, {"no robots"}}}};
+
+    const auto choices = eval.choose(auctions);
+    REQUIRE(choices.size() == 4);
+
+    // Each fleet wins one of the first round, and the leftover auction goes
+    // to whichever fleet is quickest for it.
+    CHECK(choices[0] == 1);
+    CHECK(choices[1] == 0);
+    CHECK(choices[2] == 0);
+    CHECK_FALSE(choices[3].has_value());
+  }
+}
+
 } // namespace bidding
 } // namespace rmf_task_ros2
@@ -17,11 +17,13 @@
 
 #include <rmf_task_ros2/bidding/AsyncBidder.hpp>
 #include <rmf_task_ros2/bidding/Auctioneer.hpp>
+#include <rmf_task_ros2/StandardNames.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <rmf_traffic_ros2/Time.hpp>
 
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include <rmf_utils/catch.hpp>
@@ -62,6 +64,7 @@ SCENARIO("Auction with 2 Bids", "[TwoBids]")
   std::optional<std::string> test_notice_bidder2;
   std::string r_result_id = "";
   std::string r_result_winner = "";
+  std::vector<std::string> concluded_ids;
 
   // Creating 1 auctioneer and 1 bidder
   const auto rcl_context = std::make_shared<rclcpp::Context>();
@@ -72,11 +75,12 @@ SCENARIO("Auction with 2 Bids", "[TwoBids]")
   auto auctioneer = Auctioneer::make(
     node,
     /// Bidding Result Callback Function
-    [&r_result_id, &r_result_winner](
+    [&r_result_id, &r_result_winner, &concluded_ids](
       const auto& task_id,
       const auto winner,
       const auto&)
     {
+      concluded_ids.push_back(task_id);
       if (!winner)
         return;
       r_result_id = task_id;
@@ -170,6 +174,145 @@ SCENARIO("Auction with 2 Bids", "[TwoBids]")
     REQUIRE(r_result_id == "bid2");
   }
 
+  WHEN("Both tasks are bid concurrently")
+  {
+    auctioneer->set_max_concurrent_bids(2);
+    auctioneer->request_bid(bidding_task1);
+    auctioneer->request_bid(bidding_task2);
+
+    executor.spin_until_future_complete(ready_future,
+      rmf_traffic::time::from_seconds(1.0));
+
+    // Both notices should go out without waiting for the first auction
+    REQUIRE(test_notice_bidder2.has_value());
+    CHECK(*test_notice_bidder2 == bidding_task2.request);
+    CHECK(concluded_ids.empty());
+
+    executor.spin_until_future_complete(ready_future,
+      rmf_traffic::time::from_seconds(2.5));
+
+    // The auctions may conclude in either order
+    std::sort(concluded_ids.begin(), concluded_ids.end());
+    REQUIRE(concluded_ids.size() == 2);
+    CHECK(concluded_ids[0] == "bid1");
+    CHECK(concluded_ids[1] == "bid2");
+  }
+
+  WHEN("The auction closes once both bidders have responded")
+  {
+    auctioneer->set_early_close(true);
+    auctioneer->request_bid(bidding_task1);
+
+    // Both bidders respond right away, so this should not need to wait for
+    // the 2s time window.
+    executor.spin_until_future_complete(ready_future,
+      rmf_traffic::time::from_seconds(1.0));
+
+    REQUIRE(concluded_ids.size() == 1);
+    CHECK(concluded_ids[0] == "bid1");
+    CHECK(r_result_winner == "bidder1");
+  }
+
+  WHEN("Only one task may be bid at a time")
+  {
+    auctioneer->request_bid(bidding_task1);
+    auctioneer->request_bid(bidding_task2);
+
+    executor.spin_until_future_complete(ready_future,
+      rmf_traffic::time::from_seconds(3.5));
+
+    // The second auction waits until the first one's result is settled
+    REQUIRE(concluded_ids.size() == 1);
+    CHECK(concluded_ids[0] == "bid1");
+    CHECK(!test_notice_bidder2.has_value());
+
+    auctioneer->ready_for_next_bid();
+    executor.spin_until_future_complete(ready_future,
+      rmf_traffic::time::from_seconds(3.0));
+
+    REQUIRE(concluded_ids.size() == 2);
+    CHECK(concluded_ids[1] == "bid2");
+  }
+
+  rclcpp::shutdown(rcl_context);
+}
+
+//==============================================================================
+SCENARIO("Bidder with a queue of notices", "[NoticeQueue]")
+{
+  const auto rcl_context = std::make_shared<rclcpp::Context>();
+  rcl_context->init(0, nullptr);
+  const auto node = rclcpp::Node::make_shared(
+    "test_notice_queue", rclcpp::NodeOptions().context(rcl_context));
+
+  rclcpp::ExecutorOptions exec_options;
+  exec_options.context = rcl_context;
+  rclcpp::executors::SingleThreadedExecutor executor(exec_options);
+  executor.add_node(node);
+
+  std::vector<std::string> received;
+  std::vector<AsyncBidder::Respond> responders;
+  std::vector<AsyncBidder::IsCancelled> cancellations;
+  auto bidder = AsyncBidder::make_cancellable(
+    node,
+    [&](const auto& notice, auto respond, auto is_cancelled)
+    {
+      // Hold on to every notice without responding
+      received.push_back(notice.task_id);
+      responders.push_back(std::move(respond));
+      cancellations.push_back(std::move(is_cancelled));
+    });
+  bidder->set_max_concurrent_notices(1);
+
+  const auto notice_pub = node->create_publisher<BidNoticeMsg>(
+    BidNoticeTopicName, rclcpp::ServicesQoS().reliable());
+
+  const auto short_window =
+    rmf_traffic_ros2::convert(rmf_traffic::time::from_seconds(0.5));
+
+  BidNoticeMsg first;
+  first.task_id = "first";
+  first.time_window = short_window;
+
+  BidNoticeMsg second;
+  second.task_id = "second";
+  second.time_window = short_window;
+
+  BidNoticeMsg third;
+  third.task_id = "third";
+  third.time_window = timeout;
+
+  std::promise<void> ready_promise;
+  std::shared_future<void> ready_future(ready_promise.get_future());
+
+  // Give the subscription time to connect before publishing
+  executor.spin_until_future_complete(ready_future,
+    rmf_traffic::time::from_seconds(0.5));
+
+  notice_pub->publish(first);
+  notice_pub->publish(second);
+  notice_pub->publish(third);
+  executor.spin_until_future_complete(ready_future,
+    rmf_traffic::time::from_seconds(0.2));
+
+  // Only one notice may be handled at a time
+  REQUIRE(received.size() == 1);
+  CHECK(received[0] == "first");
+  CHECK_FALSE(cancellations[0]());
+
+  executor.spin_until_future_complete(ready_future,
+    rmf_traffic::time::from_seconds(0.5));
+
+  // The time window of the first notice has passed while it was being handled
+  CHECK(cancellations[0]());
+
+  // Once the first notice is done, the second one has expired while waiting,
+  // so it gets skipped.
+  responders[0](Response{std::nullopt, {}});
+  REQUIRE(received.size() == 2);
+  CHECK(received[1] == "third");
+  CHECK_FALSE(cancellations[1]());
+
   rclcpp::shutdown(rcl_context);
 }
 
@@ -24,6 +24,10 @@ namespace rmf_traffic_ros2 {
 //==============================================================================
 rmf_traffic::Route convert(const rmf_traffic_msgs::msg::Route& from);
 
+//==============================================================================
+/// Convert from a Route message that may be moved from.
+rmf_traffic::Route convert(rmf_traffic_msgs::msg::Route&& from);
+
 //==============================================================================
 rmf_traffic_msgs::msg::Route convert(const rmf_traffic::Route& from);
 
@@ -31,6 +35,12 @@ rmf_traffic_msgs::msg::Route convert(const rmf_traffic::Route& from);
 std::vector<rmf_traffic::Route> convert(
   const std::vector<rmf_traffic_msgs::msg::Route>& from);
 
+//==============================================================================
+/// Convert from Route messages that may be moved from. The input will be left
+/// empty.
+std::vector<rmf_traffic::Route> convert(
+  std::vector<rmf_traffic_msgs::msg::Route>&& from);
+
 //==============================================================================
 std::vector<rmf_traffic_msgs::msg::Route> convert(
   const std::vector<rmf_traffic::Route>& from);
@@ -62,11 +62,15 @@ const std::string NegotiationStatesTopicName = Prefix +
   "negotiation_states";
 const std::string NegotiationStatusesTopicName = Prefix +
   "negotiation_statuses";
+const std::string ScheduleMetricsTopicName = Prefix + "schedule_metrics";
+const std::string MirrorDiagnosticsTopicName = Prefix + "mirror_diagnostics";
 
 const std::string BlockadeCancelTopicName = Prefix +
   "blockade_cancel";
 const std::string BlockadeHeartbeatTopicName = Prefix +
   "blockade_heartbeat";
+const std::string BlockadeHeartbeatUpdatesTopicName = Prefix +
+  "blockade_heartbeat_updates";
 const std::string BlockadeReachedTopicName = Prefix +
   "blockade_reached";
 const std::string BlockadeReadyTopicName = Prefix +
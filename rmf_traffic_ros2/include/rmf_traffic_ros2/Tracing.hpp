@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef RMF_TRAFFIC_ROS2__TRACING_HPP
+#define RMF_TRAFFIC_ROS2__TRACING_HPP
+
+#include <memory>
+#include <string>
+
+namespace rmf_traffic_ros2 {
+namespace tracing {
+
+//==============================================================================
+/// Start writing trace events to a file in the Chrome trace event format. The
+/// file can be opened with chrome://tracing or https://ui.perfetto.dev.
+///
+/// Tracing is enabled automatically when the RMF_TRACE_DIR environment
+/// variable names a directory. Each process then writes its events to
+/// rmf_trace_<pid>.json inside of that directory. Event timestamps come from
+/// the system clock, so the files of several processes can be loaded together.
+///
+/// Every event carries a trace key. Events that share a trace key belong to
+/// the same job, e.g. the task ID of a task as it moves from the dispatcher
+/// through a fleet adapter and into the traffic schedule.
+///
+/// \param[in] filename
+///   The file to write to. Any file that was being written is closed first.
+///
+/// \return true if the file could be opened.
+bool enable(const std::string& filename);
+
+//==============================================================================
+/// Stop tracing and close the trace file.
+void disable();
+
+//==============================================================================
+/// Check whether tracing is enabled. This is cheap enough to call in hot paths.
+bool enabled();
+
+//==============================================================================
+/// A span of time that will be recorded as a single trace event when it ends.
+/// Spans end when they are destroyed if end() was not called earlier.
+///
+/// A span that was created while tracing was disabled does nothing.
+class Span
+{
+public:
+
+  /// Create a span that does nothing.
+  Span();
+
+  /// Begin a span if tracing is enabled.
+  ///
+  /// \param[in] name
+  ///   The name of the step that is being timed.
+  ///
+  /// \param[in] trace_key
+  ///   The key of the job that this step belongs to.
+  static Span begin(const std::string& name, const std::string& trace_key);
+
+  /// Attach an argument to the trace event of this span.
+  Span& arg(const std::string& key, const std::string& value);
+
+  /// End the span now and write its event.
+  void end();
+
+  /// Check whether this span will write an event when it ends.
+  bool active() const;
+
+  Span(Span&&);
+  Span& operator=(Span&&);
+  ~Span();
+
+  class Implementation;
+private:
+  // An inactive span must not allocate anything, so this cannot be an
+  // impl_ptr, which is never empty.
+  std::unique_ptr<Implementation> _pimpl;
+};
+
+//==============================================================================
+/// Record a single point in time for a job, if tracing is enabled.
+void instant(const std::string& name, const std::string& trace_key);
+
+} // namespace tracing
+} // namespace rmf_traffic_ros2
+
+#endif // RMF_TRAFFIC_ROS2__TRACING_HPP
@@ -31,6 +31,10 @@ namespace rmf_traffic_ros2 {
 rmf_traffic::schedule::Change::Add::Item convert(
   const rmf_traffic_msgs::msg::ScheduleChangeAddItem& from);
 
+//==============================================================================
+rmf_traffic::schedule::Change::Add::Item convert(
+  rmf_traffic_msgs::msg::ScheduleChangeAddItem&& from);
+
 //==============================================================================
 rmf_traffic_msgs::msg::ScheduleChangeAddItem convert(
   const rmf_traffic::schedule::Change::Add::Item& from);
@@ -39,6 +43,10 @@ rmf_traffic_msgs::msg::ScheduleChangeAddItem convert(
 rmf_traffic::schedule::Change::Add convert(
   const rmf_traffic_msgs::msg::ScheduleChangeAdd& from);
 
+//==============================================================================
+rmf_traffic::schedule::Change::Add convert(
+  rmf_traffic_msgs::msg::ScheduleChangeAdd&& from);
+
 //==============================================================================
 rmf_traffic_msgs::msg::ScheduleChangeAdd convert(
   const rmf_traffic::schedule::Change::Add& from);
@@ -20,9 +20,12 @@
 
 #include <rmf_traffic/schedule/Database.hpp>
 #include <rmf_traffic/schedule/Mirror.hpp>
+#include <rmf_traffic/schedule/Snapshot.hpp>
 
 #include <rclcpp/node.hpp>
 
+#include <optional>
+
 namespace rmf_traffic_ros2 {
 namespace schedule {
 
@@ -64,14 +67,129 @@ public:
     /// Toggle the choice to wakeup on an update.
     Options& update_on_wakeup(bool choice);
 
+    /// True if incoming patches should be decoded and applied on a background
+    /// thread. The background thread builds the next version of the mirror in
+    /// a separate buffer, so the update mutex is only locked for as long as it
+    /// takes to swap the new version in. This is false by default.
+    ///
+    /// This must be chosen before the mirror manager is created with
+    /// make_mirror(). Changing it afterwards has no effect.
+    bool async_updates() const;
+
+    /// Toggle asynchronous updates.
+    Options& async_updates(bool choice);
+
+    /// The minimum amount of time between swaps of new versions into the
+    /// mirror when async_updates() is true. Changes that arrive in between
+    /// will be accumulated and become visible together. The default of zero
+    /// makes each change visible as soon as it has been applied.
+    rmf_traffic::Duration minimum_swap_interval() const;
+
+    /// Set the minimum swap interval.
+    Options& minimum_swap_interval(rmf_traffic::Duration interval);
+
+    /// True if the mirror manager should collect statistics about the updates
+    /// that it receives. These can be retrieved with
+    /// MirrorManager::statistics(). This is false by default.
+    ///
+    /// This must be chosen before the mirror manager is created with
+    /// make_mirror(). Changing it afterwards has no effect.
+    bool statistics() const;
+
+    /// Toggle the collection of statistics.
+    Options& statistics(bool choice);
+
+    /// If this is greater than zero and statistics() is true, the statistics
+    /// will be published as statistics_msgs/MetricsMessage on the
+    /// MirrorDiagnosticsTopicName topic with this period. The default of zero
+    /// disables the topic.
+    rmf_traffic::Duration diagnostics_period() const;
+
+    /// Set the diagnostics period.
+    Options& diagnostics_period(rmf_traffic::Duration period);
+
+    /// True if updates should be received in the compact format. Positions
+    /// and velocities in that format are rounded to a tenth of a millimeter
+    /// (or of a millimeter per second), which typically makes updates much
+    /// smaller. The schedule node sends this format to any mirror that asks
+    /// for it. This is false by default.
+    ///
+    /// This must be chosen before the mirror manager is created with
+    /// make_mirror(). Changing it afterwards has no effect.
+    bool compact_updates() const;
+
+    /// Toggle the compact update format.
+    Options& compact_updates(bool choice);
+
     class Implementation;
   private:
     rmf_utils::impl_ptr<Implementation> _pimpl;
   };
 
+  /// Statistics about the updates that a mirror manager has received
+  struct Statistics
+  {
+    /// The newest schedule database version that any update has reported
+    std::optional<rmf_traffic::schedule::Version> latest_seen_version;
+
+    /// The version that the mirror is currently at
+    std::optional<rmf_traffic::schedule::Version> mirror_version;
+
+    /// How many versions the mirror is behind the latest seen version
+    uint64_t version_lag = 0;
+
+    /// Number of update messages that have been received
+    std::size_t updates_received = 0;
+
+    /// Number of the received updates that were remedial updates
+    std::size_t remedial_updates = 0;
+
+    /// Number of patches that could not be applied to the mirror
+    std::size_t failed_updates = 0;
+
+    /// Number of times that changes were requested from the schedule node
+    std::size_t update_requests = 0;
+
+    /// Number of times that no update arrived before the update timeout
+    std::size_t update_timeouts = 0;
+
+    /// Number of updates that were stashed while the query was validated
+    std::size_t stashed_updates = 0;
+
+    /// Number of stashed updates that were processed after validation
+    std::size_t processed_stashed_updates = 0;
+
+    /// Total serialized size of the update messages that have been received
+    std::size_t bytes_received = 0;
+
+    /// Number of patches that have been applied
+    std::size_t patches_applied = 0;
+
+    /// Total time spent applying patches to the mirror
+    rmf_traffic::Duration total_apply_time = rmf_traffic::Duration(0);
+  };
+
+  /// Get the statistics of this mirror manager. If Options::statistics() was
+  /// not turned on, this will return std::nullopt.
+  std::optional<Statistics> statistics() const;
+
   /// Get an immutable view of the mirror
   std::shared_ptr<const rmf_traffic::schedule::Mirror> view() const;
 
+  /// Get an immutable snapshot of the latest state of the mirror.
+  ///
+  /// Each time the mirror gets updated, a new snapshot is published. Getting
+  /// the latest snapshot does not lock the update mutex, and the snapshot can
+  /// be used from any thread for as long as it is held, no matter how many
+  /// more updates arrive. Use rmf_traffic::schedule::Snapshot::version() to
+  /// find out which version of the schedule a snapshot belongs to.
+  ///
+  /// Snapshots are only published once this has been called for the first
+  /// time, so that mirrors without snapshot readers do not pay for them. The
+  /// first call will lock the update mutex, if there is one, to create the
+  /// initial snapshot.
+  std::shared_ptr<const rmf_traffic::schedule::Snapshot> snapshot() const;
+
   /// Attempt to update this mirror immediately.
   ///
   // TODO(MXG): Consider allowing this function to accept a callback that will
@@ -68,6 +68,15 @@ public:
   /// Get the current timeout duration setting.
   rmf_traffic::Duration timeout_duration() const;
 
+  /// Record every negotiation message that this Negotiation receives, along
+  /// with the time that it arrived, into a compact binary file. The file can
+  /// be replayed and profiled offline with rmf_traffic_negotiation_replay.
+  ///
+  /// \param[in] filename
+  ///   The file to record into. It will be overwritten if it already exists.
+  ///   Pass an empty string to stop recording.
+  Negotiation& record(const std::string& filename);
+
   using TableViewPtr = rmf_traffic::schedule::Negotiation::Table::ViewerPtr;
   using ResponderPtr = rmf_traffic::schedule::Negotiator::ResponderPtr;
   using StatusUpdateCallback =
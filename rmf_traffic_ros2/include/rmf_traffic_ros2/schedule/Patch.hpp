@@ -32,6 +32,10 @@ rmf_traffic_msgs::msg::ScheduleParticipantPatch convert(
 rmf_traffic::schedule::Patch::Participant convert(
   const rmf_traffic_msgs::msg::ScheduleParticipantPatch& from);
 
+//==============================================================================
+rmf_traffic::schedule::Patch::Participant convert(
+  rmf_traffic_msgs::msg::ScheduleParticipantPatch&& from);
+
 //==============================================================================
 rmf_traffic_msgs::msg::SchedulePatch convert(
   const rmf_traffic::schedule::Patch& from);
@@ -40,6 +44,14 @@ rmf_traffic_msgs::msg::SchedulePatch convert(
 rmf_traffic::schedule::Patch convert(
   const rmf_traffic_msgs::msg::SchedulePatch& from);
 
+//==============================================================================
+/// Convert from a SchedulePatch message that may be moved from, e.g. one that
+/// was received through a std::unique_ptr. Routes, erasures and checkpoints
+/// are taken over from the message instead of being copied, so the message
+/// should not be used afterwards.
+rmf_traffic::schedule::Patch convert(
+  rmf_traffic_msgs::msg::SchedulePatch&& from);
+
 } // nmaespace rmf_traffic_ros2
 
 #endif // RMF_TRAFFIC_ROS2__SCHEDULE__PATCH_HPP
@@ -23,6 +23,8 @@
 
 #include <rclcpp/node.hpp>
 
+#include <optional>
+
 namespace rmf_traffic_ros2 {
 namespace schedule {
 
@@ -83,6 +85,31 @@ public:
     rmf_traffic::schedule::ParticipantDescription description,
     std::function<void(rmf_traffic::schedule::Participant)> ready_callback);
 
+  /// Hold back the itinerary changes of all the participants of this writer
+  /// and publish them together once per window instead of one at a time. The
+  /// changes keep their order, and a progress report of a participant is
+  /// dropped when a newer report for the same plan is waiting in the same
+  /// window, since only the newest one matters to the schedule.
+  ///
+  /// By default every change is published immediately.
+  ///
+  /// \param[in] window
+  ///   How long to hold back changes. Passing std::nullopt publishes every
+  ///   change immediately again, after publishing any that are waiting.
+  Writer& batch_window(std::optional<rmf_traffic::Duration> window);
+
+  /// Hold back the progress reports of each participant of this writer and
+  /// only send the latest one once per window. Any progress that is being held
+  /// for a participant is sent right before its next itinerary change so the
+  /// schedule always sees them in order.
+  ///
+  /// By default every progress report is sent immediately.
+  ///
+  /// \param[in] window
+  ///   How long to hold back progress reports. Passing std::nullopt sends
+  ///   every report immediately again, after sending any that are held.
+  Writer& reached_window(std::optional<rmf_traffic::Duration> window);
+
   class Implementation;
 private:
   Writer();
@@ -0,0 +1,590 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_traffic_ros2/blockade/Node.hpp>
+#include <rmf_traffic_ros2/blockade/Writer.hpp>
+#include <rmf_traffic_ros2/StandardNames.hpp>
+
+#include <rmf_traffic_msgs/msg/blockade_cancel.hpp>
+#include <rmf_traffic_msgs/msg/blockade_heartbeat.hpp>
+#include <rmf_traffic_msgs/msg/blockade_reached.hpp>
+#include <rmf_traffic_msgs/msg/blockade_ready.hpp>
+#include <rmf_traffic_msgs/msg/blockade_release.hpp>
+#include <rmf_traffic_msgs/msg/blockade_set.hpp>
+
+#include <rclcpp/executors.hpp>
+#include <rclcpp/node.hpp>
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+// This benchmark runs a blockade node in-process together with a configurable
+// number of synthetic blockade participants that repeatedly drive along paths
+// of a chosen topology, and reports how quickly the moderator lets them move
+// and how much traffic that produces. The parameters can be set with the usual
+// --ros-args -p <name>:=<value> arguments, and any blockade node parameters
+// that are passed in the same way will be applied to the blockade node too.
+//
+// The available topologies are:
+// - parallel: every participant has its own lane, so nothing ever conflicts
+// - crossing: half of the participants drive along rows and the other half
+//   along columns of a grid, so every row crosses every column
+// - corridor: every participant drives in the same direction down one shared
+//   corridor, staggered by the lane spacing
+
+namespace {
+
+using Checkpoint = rmf_traffic::blockade::Writer::Checkpoint;
+using ReservedRange = rmf_traffic::blockade::ReservedRange;
+using ReservationId = rmf_traffic::blockade::ReservationId;
+
+//==============================================================================
+struct Settings
+{
+  std::size_t participants;
+  std::size_t checkpoints;
+  std::string topology;
+  double spacing;
+  double radius;
+  bool ready_all;
+  std::chrono::nanoseconds step_period;
+  std::chrono::nanoseconds warmup;
+  std::chrono::nanoseconds duration;
+  std::size_t threads;
+};
+
+//==============================================================================
+Settings declare_settings(rclcpp::Node& node)
+{
+  Settings settings;
+
+  // Number of synthetic participants
+  settings.participants = static_cast<std::size_t>(
+    std::max<int64_t>(1, node.declare_parameter<int>("participants", 30)));
+
+  // Number of checkpoints along each path
+  settings.checkpoints = static_cast<std::size_t>(
+    std::max<int64_t>(2, node.declare_parameter<int>("checkpoints", 10)));
+
+  // Which path topology to use: parallel, crossing, or corridor
+  settings.topology =
+    node.declare_parameter<std::string>("topology", "crossing");
+
+  // Distance, in meters, between neighboring lanes and between the
+  // checkpoints along a lane
+  settings.spacing =
+    std::max(0.1, node.declare_parameter<double>("spacing", 2.0));
+
+  // Radius, in meters, of each participant
+  settings.radius =
+    std::max(0.01, node.declare_parameter<double>("radius", 0.5));
+
+  // If true, participants report that they are ready for every checkpoint as
+  // soon as they set a path, the way read-only fleets do. Otherwise they report
+  // each checkpoint as ready when they arrive at it.
+  settings.ready_all = node.declare_parameter<bool>("ready_all", true);
+
+  // Milliseconds that it takes a participant to move from one checkpoint to
+  // the next once it has permission to
+  settings.step_period = std::chrono::milliseconds(
+    std::max<int64_t>(1, node.declare_parameter<int>("step_period", 20)));
+
+  // Seconds to run before measurements begin
+  settings.warmup = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::duration<double>(
+      std::max(0.0, node.declare_parameter<double>("warmup", 5.0))));
+
+  // Seconds to collect measurements for
+  settings.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::duration<double>(
+      std::max(1.0, node.declare_parameter<double>("duration", 30.0))));
+
+  // Number of executor threads shared by all of the nodes
+  settings.threads = static_cast<std::size_t>(
+    std::max<int64_t>(2, node.declare_parameter<int>("threads", 4)));
+
+  return settings;
+}
+
+//==============================================================================
+std::optional<std::vector<Checkpoint>> make_path(
+  const Settings& settings,
+  const std::size_t index)
+{
+  const std::size_t n = settings.checkpoints;
+  const double s = settings.spacing;
+  std::vector<Checkpoint> path;
+  path.reserve(n);
+
+  if (settings.topology == "parallel")
+  {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      path.push_back(
+        {Eigen::Vector2d(s * i, s * index), "benchmark_map", true});
+    }
+  }
+  else if (settings.topology == "crossing")
+  {
+    // Rows and columns are centered on the same square so that every row
+    // crosses every column.
+    const std::size_t lane = index / 2;
+    const double offset = s * (n - 1) / 2.0 - s * lane;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      const Eigen::Vector2d p = index % 2 == 0 ?
+        Eigen::Vector2d(s * i, offset) : Eigen::Vector2d(offset, s * i);
+      path.push_back({p, "benchmark_map", true});
+    }
+  }
+  else if (settings.topology == "corridor")
+  {
+    const double start = -s * index;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      path.push_back(
+        {Eigen::Vector2d(start + s * i, 0.0), "benchmark_map", true});
+    }
+  }
+  else
+  {
+    return std::nullopt;
+  }
+
+  return path;
+}
+
+//==============================================================================
+struct Usage
+{
+  std::chrono::steady_clock::time_point wall;
+  double cpu_seconds;
+  long max_rss_kb;
+
+  static Usage now()
+  {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    const auto seconds = [](const timeval& t)
+      {
+        return static_cast<double>(t.tv_sec) + 1e-6 * t.tv_usec;
+      };
+
+    return Usage{
+      std::chrono::steady_clock::now(),
+      seconds(usage.ru_utime) + seconds(usage.ru_stime),
+      usage.ru_maxrss
+    };
+  }
+};
+
+//==============================================================================
+double percentile(const std::vector<double>& sorted, const double p)
+{
+  if (sorted.empty())
+    return 0.0;
+
+  const auto index = static_cast<std::size_t>(p * (sorted.size() - 1));
+  return sorted[index];
+}
+
+//==============================================================================
+struct Counts
+{
+  std::size_t checkpoints_reached = 0;
+  std::size_t paths_completed = 0;
+};
+
+//==============================================================================
+/// One synthetic participant. The range callback of the blockade writer only
+/// stores the latest range, and the driver timer does everything else, so that
+/// the participant is never used from inside a writer callback.
+class Agent
+{
+public:
+
+  Agent(
+    rmf_traffic_ros2::blockade::Writer& writer,
+    const rmf_traffic::blockade::ParticipantId id,
+    const Settings& settings,
+    std::vector<Checkpoint> path)
+  : _path(std::move(path)),
+    _ready_all(settings.ready_all),
+    _range(std::make_shared<RangeSlot>()),
+    _participant(writer.make_participant(
+        id, settings.radius,
+        [range = _range](
+          const ReservationId reservation,
+          const ReservedRange& new_range)
+        {
+          std::lock_guard<std::mutex> lock(range->mutex);
+          range->value = {reservation, new_range};
+        }))
+  {
+    // Do nothing
+  }
+
+  /// Advance this agent by one step.
+  void step(
+    const std::chrono::steady_clock::time_point now,
+    std::vector<double>& time_to_ready,
+    Counts& counts)
+  {
+    if (!_set_time.has_value())
+    {
+      _participant.set(_path);
+      _set_time = now;
+      _permitted = false;
+      if (_ready_all)
+      {
+        for (std::size_t i = 0; i < _path.size() - 1; ++i)
+          _participant.ready(i);
+      }
+      else
+      {
+        _participant.ready(0);
+      }
+
+      return;
+    }
+
+    const auto range = [&]() -> std::optional<ReservedRange>
+      {
+        std::lock_guard<std::mutex> lock(_range->mutex);
+        if (!_range->value.has_value())
+          return std::nullopt;
+
+        if (_range->value->first != _participant.reservation_id())
+          return std::nullopt;
+
+        return _range->value->second;
+      } ();
+
+    const std::size_t last_reached = _participant.last_reached();
+    if (!range.has_value() || range->end <= last_reached)
+      return;
+
+    if (!_permitted)
+    {
+      _permitted = true;
+      time_to_ready.push_back(
+        std::chrono::duration<double>(now - *_set_time).count());
+    }
+
+    const std::size_t next = last_reached + 1;
+    _participant.reached(next);
+    ++counts.checkpoints_reached;
+
+    if (next + 1 >= _path.size())
+    {
+      // Start over from the beginning of the path on the next step.
+      ++counts.paths_completed;
+      _participant.cancel();
+      _set_time = std::nullopt;
+      return;
+    }
+
+    if (!_ready_all)
+      _participant.ready(next);
+  }
+
+private:
+
+  struct RangeSlot
+  {
+    std::mutex mutex;
+    std::optional<std::pair<ReservationId, ReservedRange>> value;
+  };
+
+  std::vector<Checkpoint> _path;
+  bool _ready_all;
+  std::shared_ptr<RangeSlot> _range;
+  rmf_traffic::blockade::Participant _participant;
+  std::optional<std::chrono::steady_clock::time_point> _set_time;
+  bool _permitted = false;
+};
+
+//==============================================================================
+class Driver
+{
+public:
+
+  Driver(
+    std::shared_ptr<rclcpp::Node> node,
+    std::vector<std::unique_ptr<Agent>> agents,
+    std::chrono::nanoseconds step_period)
+  : _node(std::move(node)),
+    _agents(std::move(agents))
+  {
+    _timer = _node->create_wall_timer(step_period, [this]() { _step(); });
+  }
+
+  void start_recording()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _time_to_ready.clear();
+    _counts = Counts();
+  }
+
+  std::pair<std::vector<double>, Counts> stop_recording()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return {std::move(_time_to_ready), _counts};
+  }
+
+private:
+
+  void _step()
+  {
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& agent : _agents)
+      agent->step(now, _time_to_ready, _counts);
+  }
+
+  std::shared_ptr<rclcpp::Node> _node;
+  std::vector<std::unique_ptr<Agent>> _agents;
+  std::vector<double> _time_to_ready;
+  Counts _counts;
+  std::mutex _mutex;
+  rclcpp::TimerBase::SharedPtr _timer;
+};
+
+//==============================================================================
+/// Count the messages that pass through each of the blockade topics.
+class Traffic
+{
+public:
+
+  struct Volume
+  {
+    std::size_t set = 0;
+    std::size_t ready = 0;
+    std::size_t reached = 0;
+    std::size_t release = 0;
+    std::size_t cancel = 0;
+    std::size_t heartbeats = 0;
+    std::size_t heartbeat_statuses = 0;
+    std::size_t updates = 0;
+    std::size_t update_statuses = 0;
+    std::size_t gridlocks = 0;
+  };
+
+  Traffic(rclcpp::Node& node)
+  {
+    using namespace rmf_traffic_ros2;
+    using namespace rmf_traffic_msgs::msg;
+    auto qos = rclcpp::SystemDefaultsQoS().keep_last(100);
+
+    _set_sub = node.create_subscription<BlockadeSet>(
+      BlockadeSetTopicName, qos.best_effort(),
+      [this](const BlockadeSet::SharedPtr) { _count(&Volume::set); });
+
+    _ready_sub = node.create_subscription<BlockadeReady>(
+      BlockadeReadyTopicName, qos.best_effort(),
+      [this](const BlockadeReady::SharedPtr) { _count(&Volume::ready); });
+
+    _reached_sub = node.create_subscription<BlockadeReached>(
+      BlockadeReachedTopicName, qos.best_effort(),
+      [this](const BlockadeReached::SharedPtr) { _count(&Volume::reached); });
+
+    _release_sub = node.create_subscription<BlockadeRelease>(
+      BlockadeReleaseTopicName, qos.best_effort(),
+      [this](const BlockadeRelease::SharedPtr) { _count(&Volume::release); });
+
+    _cancel_sub = node.create_subscription<BlockadeCancel>(
+      BlockadeCancelTopicName, qos.best_effort(),
+      [this](const BlockadeCancel::SharedPtr) { _count(&Volume::cancel); });
+
+    _heartbeat_sub = node.create_subscription<BlockadeHeartbeat>(
+      BlockadeHeartbeatTopicName, qos.reliable(),
+      [this](const BlockadeHeartbeat::SharedPtr msg)
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_volume.heartbeats;
+        _volume.heartbeat_statuses += msg->statuses.size();
+        if (msg->has_gridlock)
+          ++_volume.gridlocks;
+      });
+
+    _updates_sub = node.create_subscription<BlockadeHeartbeat>(
+      BlockadeHeartbeatUpdatesTopicName, qos.reliable(),
+      [this](const BlockadeHeartbeat::SharedPtr msg)
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_volume.updates;
+        _volume.update_statuses += msg->statuses.size();
+      });
+  }
+
+  void start_recording()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _volume = Volume();
+  }
+
+  Volume stop_recording()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _volume;
+  }
+
+private:
+
+  void _count(std::size_t Volume::* field)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ++(_volume.*field);
+  }
+
+  Volume _volume;
+  std::mutex _mutex;
+
+  rclcpp::SubscriptionBase::SharedPtr _set_sub;
+  rclcpp::SubscriptionBase::SharedPtr _ready_sub;
+  rclcpp::SubscriptionBase::SharedPtr _reached_sub;
+  rclcpp::SubscriptionBase::SharedPtr _release_sub;
+  rclcpp::SubscriptionBase::SharedPtr _cancel_sub;
+  rclcpp::SubscriptionBase::SharedPtr _heartbeat_sub;
+  rclcpp::SubscriptionBase::SharedPtr _updates_sub;
+};
+
+} // anonymous namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  rclcpp::init(argc, argv);
+
+  auto load_node = std::make_shared<rclcpp::Node>("blockade_benchmark_load");
+  auto observer_node =
+    std::make_shared<rclcpp::Node>("blockade_benchmark_observer");
+  const auto settings = declare_settings(*load_node);
+
+  std::vector<std::vector<Checkpoint>> paths;
+  for (std::size_t i = 0; i < settings.participants; ++i)
+  {
+    auto path = make_path(settings, i);
+    if (!path.has_value())
+    {
+      std::cerr << "Unknown topology [" << settings.topology << "]. Choose "
+                << "from: parallel, crossing, corridor" << std::endl;
+      rclcpp::shutdown();
+      return 1;
+    }
+
+    paths.push_back(std::move(*path));
+  }
+
+  auto blockade_node = rmf_traffic_ros2::blockade::make_node();
+  Traffic traffic(*observer_node);
+
+  rclcpp::executors::MultiThreadedExecutor executor(
+    rclcpp::ExecutorOptions(), settings.threads);
+  executor.add_node(blockade_node);
+  executor.add_node(load_node);
+  executor.add_node(observer_node);
+  std::thread spin_thread([&executor]() { executor.spin(); });
+
+  std::cout << "Creating " << settings.participants << " participants on a ["
+            << settings.topology << "] topology" << std::endl;
+  const auto writer = rmf_traffic_ros2::blockade::Writer::make(*load_node);
+  std::vector<std::unique_ptr<Agent>> agents;
+  for (std::size_t i = 0; i < settings.participants; ++i)
+  {
+    agents.emplace_back(
+      std::make_unique<Agent>(*writer, i, settings, std::move(paths[i])));
+  }
+
+  Driver driver(load_node, std::move(agents), settings.step_period);
+
+  std::cout << "Warming up for "
+            << std::chrono::duration<double>(settings.warmup).count() << "s"
+            << std::endl;
+  std::this_thread::sleep_for(settings.warmup);
+
+  std::cout << "Measuring for "
+            << std::chrono::duration<double>(settings.duration).count() << "s"
+            << std::endl;
+  const auto start_usage = Usage::now();
+  traffic.start_recording();
+  driver.start_recording();
+  std::this_thread::sleep_for(settings.duration);
+  auto [time_to_ready, counts] = driver.stop_recording();
+  const auto volume = traffic.stop_recording();
+  const auto finish_usage = Usage::now();
+
+  executor.cancel();
+  spin_thread.join();
+  rclcpp::shutdown();
+
+  const double wall = std::chrono::duration<double>(
+    finish_usage.wall - start_usage.wall).count();
+  std::sort(time_to_ready.begin(), time_to_ready.end());
+
+  std::printf("\n");
+  std::printf("participants:           %lu\n", settings.participants);
+  std::printf("checkpoints per path:   %lu\n", settings.checkpoints);
+  std::printf("topology:               %s\n", settings.topology.c_str());
+  std::printf("checkpoints reached/s:  %.1f\n",
+    counts.checkpoints_reached / wall);
+  std::printf("paths completed/s:      %.1f\n", counts.paths_completed / wall);
+  std::printf(
+    "time to ready (ms):     p50 %.2f  p90 %.2f  p99 %.2f  max %.2f\n",
+    1e3 * percentile(time_to_ready, 0.50),
+    1e3 * percentile(time_to_ready, 0.90),
+    1e3 * percentile(time_to_ready, 0.99),
+    time_to_ready.empty() ? 0.0 : 1e3 * time_to_ready.back());
+  std::printf(
+    "participant msgs/s:     set %.1f  ready %.1f  reached %.1f  "
+    "release %.1f  cancel %.1f\n",
+    volume.set / wall, volume.ready / wall, volume.reached / wall,
+    volume.release / wall, volume.cancel / wall);
+  std::printf(
+    "heartbeats/s:           %.1f (%.1f statuses each)\n",
+    volume.heartbeats / wall,
+    volume.heartbeats > 0 ?
+    static_cast<double>(volume.heartbeat_statuses) / volume.heartbeats : 0.0);
+  std::printf(
+    "status updates/s:       %.1f (%.1f statuses each)\n",
+    volume.updates / wall,
+    volume.updates > 0 ?
+    static_cast<double>(volume.update_statuses) / volume.updates : 0.0);
+  std::printf("gridlocked heartbeats:  %lu\n", volume.gridlocks);
+  std::printf(
+    "cpu usage:              %.2f cores\n",
+    (finish_usage.cpu_seconds - start_usage.cpu_seconds) / wall);
+  std::printf(
+    "peak memory:            %.1f MB\n", finish_usage.max_rss_kb / 1024.0);
+  std::printf(
+    "\nTime to ready is measured from when a participant sets a path until it "
+    "is first permitted to leave its starting checkpoint, with a resolution of "
+    "%ld ms.\n",
+    std::chrono::duration_cast<std::chrono::milliseconds>(
+      settings.step_period).count());
+
+  return 0;
+}
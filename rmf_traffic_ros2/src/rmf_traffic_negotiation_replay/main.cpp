@@ -0,0 +1,532 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "../rmf_traffic_ros2/schedule/NegotiationRoom.hpp"
+#include "../rmf_traffic_ros2/schedule/internal_NegotiationRecording.hpp"
+
+#include <rmf_traffic_ros2/Route.hpp>
+#include <rmf_traffic_ros2/schedule/Itinerary.hpp>
+#include <rmf_traffic_ros2/schedule/ParticipantDescription.hpp>
+
+#include <rmf_traffic/geometry/Circle.hpp>
+#include <rmf_traffic/schedule/Database.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// This tool replays a negotiation recording that was made with
+// rmf_traffic_ros2::schedule::Negotiation::record(~). Every recorded message
+// is applied to a fresh negotiation in the same order that it was received,
+// and the time spent in each phase of the negotiation is reported:
+//
+// * response: how long each negotiator took to respond after its table became
+//   available, taken from the recorded arrival times. This is dominated by the
+//   time the negotiators spent planning, plus the messaging latency.
+// * decoding: how long it takes to deserialize each message and convert its
+//   contents into rmf_traffic types.
+// * validation: how long it takes to apply each message to the negotiation
+//   tables, including the tables that were waiting on a parent proposal.
+// * state update: how long it takes to rebuild the negotiation state message
+//   that a schedule node publishes after each message.
+//
+// The decoding, validation, and state update phases are measured again during
+// the replay, so they can be used to compare performance changes
+// deterministically.
+
+namespace {
+
+using rmf_traffic_ros2::schedule::NegotiationRecord;
+using rmf_traffic_ros2::schedule::NegotiationRecorder;
+using rmf_traffic_ros2::schedule::NegotiationRoom;
+using Kind = NegotiationRecorder::Kind;
+using ParticipantId = rmf_traffic::schedule::ParticipantId;
+using Version = rmf_traffic::schedule::Version;
+
+//==============================================================================
+class Phase
+{
+public:
+
+  void add(const double seconds)
+  {
+    _samples.push_back(seconds);
+  }
+
+  template<typename F>
+  auto time(F&& f)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    auto result = f();
+    add(std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count());
+    return result;
+  }
+
+  void report(const char* name)
+  {
+    std::sort(_samples.begin(), _samples.end());
+    double total = 0.0;
+    for (const auto s : _samples)
+      total += s;
+
+    const auto percentile = [&](const double p)
+      {
+        if (_samples.empty())
+          return 0.0;
+
+        return _samples[static_cast<std::size_t>(p * (_samples.size() - 1))];
+      };
+
+    std::printf(
+      "%-14s n %-6lu total %9.3f ms  p50 %8.3f  p90 %8.3f  max %8.3f ms\n",
+      name, _samples.size(), 1e3 * total, 1e3 * percentile(0.5),
+      1e3 * percentile(0.9), _samples.empty() ? 0.0 : 1e3 * _samples.back());
+  }
+
+private:
+  std::vector<double> _samples;
+};
+
+//==============================================================================
+using TableKey = std::pair<Version, std::vector<ParticipantId>>;
+
+//==============================================================================
+std::vector<ParticipantId> participants_of(
+  const std::vector<rmf_traffic_msgs::msg::NegotiationKey>& keys)
+{
+  std::vector<ParticipantId> participants;
+  participants.reserve(keys.size());
+  for (const auto& key : keys)
+    participants.push_back(key.participant);
+
+  return participants;
+}
+
+//==============================================================================
+class Replay
+{
+public:
+
+  Replay(const std::vector<NegotiationRecord>& records)
+  {
+    _register_participants(records);
+  }
+
+  void apply(const NegotiationRecord& record)
+  {
+    switch (record.kind)
+    {
+      case Kind::Participant:
+        return;
+      case Kind::Notice:
+        return _apply_notice(record);
+      case Kind::Proposal:
+        return _apply_proposal(record);
+      case Kind::Rejection:
+        return _apply_rejection(record);
+      case Kind::Forfeit:
+        return _apply_forfeit(record);
+      case Kind::Conclusion:
+        return _apply_conclusion(record);
+    }
+  }
+
+  void report()
+  {
+    std::printf("negotiations:  %lu opened, %lu resolved, %lu failed, "
+      "%lu unfinished\n", _opened, _resolved, _failed, _rooms.size());
+    std::printf("messages:      %lu proposals, %lu rejections, %lu forfeits\n",
+      _proposals, _rejections, _forfeits);
+    if (_unknown_participants > 0)
+    {
+      std::printf(
+        "skipped:       %lu notices with unrecorded participants\n",
+        _unknown_participants);
+    }
+
+    std::printf("\n");
+    _response.report("response");
+    _decoding.report("decoding");
+    _validation.report("validation");
+    _state_update.report("state update");
+    _duration.report("negotiation");
+  }
+
+private:
+
+  void _register_participants(const std::vector<NegotiationRecord>& records)
+  {
+    std::map<ParticipantId, rmf_traffic::schedule::ParticipantDescription>
+    descriptions;
+    for (const auto& record : records)
+    {
+      if (record.kind != Kind::Participant)
+        continue;
+
+      const auto msg = record.get<NegotiationRecorder::Participant>();
+      descriptions.insert_or_assign(
+        msg.id, rmf_traffic_ros2::convert(msg.description));
+    }
+
+    // The database hands out participant IDs in order, so we fill the gaps
+    // between the recorded IDs with placeholders to give each recorded
+    // participant the same ID that it had when it was recorded.
+    const rmf_traffic::schedule::ParticipantDescription placeholder(
+      "placeholder", "rmf_traffic_negotiation_replay",
+      rmf_traffic::schedule::ParticipantDescription::Rx::Unresponsive,
+      rmf_traffic::Profile(
+        rmf_traffic::geometry::make_final_convex<
+          rmf_traffic::geometry::Circle>(0.1)));
+
+    std::vector<ParticipantId> placeholders;
+    for (const auto& [id, description] : descriptions)
+    {
+      while (true)
+      {
+        const auto next = _database.register_participant(placeholder).id();
+        if (next == id)
+        {
+          _database.update_description(id, description);
+          break;
+        }
+
+        placeholders.push_back(next);
+        if (next > id)
+        {
+          std::cerr << "Unable to give participant [" << id << "] its "
+                    << "recorded ID" << std::endl;
+          break;
+        }
+      }
+    }
+
+    for (const auto id : placeholders)
+      _database.unregister_participant(id);
+  }
+
+  void _apply_notice(const NegotiationRecord& record)
+  {
+    const auto msg = _decoding.time(
+      [&]() { return record.get<NegotiationRecorder::Notice>(); });
+
+    _notice_time[msg.conflict_version] = record.time;
+
+    const auto r_it = _rooms.find(msg.conflict_version);
+    if (r_it != _rooms.end())
+    {
+      _validation.time(
+        [&]()
+        {
+          auto& negotiation = r_it->second->negotiation;
+          for (const auto p : msg.participants)
+          {
+            const auto& current = negotiation.participants();
+            if (std::find(current.begin(), current.end(), p) == current.end())
+              negotiation.add_participant(p);
+          }
+          return true;
+        });
+
+      _update_state(msg.conflict_version, record.time);
+      return;
+    }
+
+    auto negotiation = _validation.time(
+      [&]()
+      {
+        return rmf_traffic::schedule::Negotiation::make(
+          _database.snapshot(), msg.participants);
+      });
+
+    if (!negotiation)
+    {
+      ++_unknown_participants;
+      return;
+    }
+
+    ++_opened;
+    _rooms.insert(
+      {
+        msg.conflict_version,
+        std::make_unique<NegotiationRoom>(*std::move(negotiation))
+      });
+    _update_state(msg.conflict_version, record.time);
+  }
+
+  void _apply_proposal(const NegotiationRecord& record)
+  {
+    ++_proposals;
+    const auto msg = _decoding.time(
+      [&]() { return record.get<NegotiationRecorder::Proposal>(); });
+
+    auto sequence = participants_of(msg.to_accommodate);
+    sequence.push_back(msg.for_participant);
+    _record_response(msg.conflict_version, sequence, record.time);
+    _proposal_time[{msg.conflict_version, sequence}] = record.time;
+
+    const auto r_it = _rooms.find(msg.conflict_version);
+    if (r_it == _rooms.end())
+      return;
+
+    auto& room = *r_it->second;
+    const auto to_accommodate = rmf_traffic_ros2::convert(msg.to_accommodate);
+    const auto itinerary = _decoding.time(
+      [&]() { return rmf_traffic_ros2::convert(msg.itinerary); });
+
+    _validation.time(
+      [&]()
+      {
+        const auto search =
+          room.negotiation.find(msg.for_participant, to_accommodate);
+        if (search.deprecated())
+          return false;
+
+        if (!search.table)
+        {
+          room.cached_proposals.push_back(msg);
+          return false;
+        }
+
+        search.table->submit(msg.plan_id, itinerary, msg.proposal_version);
+        room.check_cache({});
+        return true;
+      });
+
+    _update_state(msg.conflict_version, record.time);
+  }
+
+  void _apply_rejection(const NegotiationRecord& record)
+  {
+    ++_rejections;
+    const auto msg = _decoding.time(
+      [&]() { return record.get<NegotiationRecorder::Rejection>(); });
+
+    // The owner of the rejected table needs to respond again
+    _rejection_time[{msg.conflict_version, participants_of(msg.table)}] =
+      record.time;
+
+    const auto r_it = _rooms.find(msg.conflict_version);
+    if (r_it == _rooms.end())
+      return;
+
+    auto& room = *r_it->second;
+    const auto table_sequence = rmf_traffic_ros2::convert(msg.table);
+    const auto alternatives = _decoding.time(
+      [&]() { return rmf_traffic_ros2::convert(msg.alternatives); });
+
+    _validation.time(
+      [&]()
+      {
+        const auto search = room.negotiation.find(table_sequence);
+        if (search.deprecated())
+          return false;
+
+        if (!search.table)
+        {
+          room.cached_rejections.push_back(msg);
+          return false;
+        }
+
+        search.table->reject(
+          msg.table.back().version, msg.rejected_by, alternatives);
+        room.check_cache({});
+        return true;
+      });
+
+    _update_state(msg.conflict_version, record.time);
+  }
+
+  void _apply_forfeit(const NegotiationRecord& record)
+  {
+    ++_forfeits;
+    const auto msg = _decoding.time(
+      [&]() { return record.get<NegotiationRecorder::Forfeit>(); });
+
+    _record_response(
+      msg.conflict_version, participants_of(msg.table), record.time);
+
+    const auto r_it = _rooms.find(msg.conflict_version);
+    if (r_it == _rooms.end())
+      return;
+
+    auto& room = *r_it->second;
+    const auto table_sequence = rmf_traffic_ros2::convert(msg.table);
+    _validation.time(
+      [&]()
+      {
+        const auto search = room.negotiation.find(table_sequence);
+        if (search.deprecated())
+          return false;
+
+        if (!search.table)
+        {
+          room.cached_forfeits.push_back(msg);
+          return false;
+        }
+
+        search.table->forfeit(msg.table.back().version);
+        room.check_cache({});
+        return true;
+      });
+
+    _update_state(msg.conflict_version, record.time);
+  }
+
+  void _apply_conclusion(const NegotiationRecord& record)
+  {
+    const auto msg = _decoding.time(
+      [&]() { return record.get<NegotiationRecorder::Conclusion>(); });
+
+    const auto r_it = _rooms.find(msg.conflict_version);
+    if (r_it == _rooms.end())
+      return;
+
+    if (msg.resolved)
+      ++_resolved;
+    else
+      ++_failed;
+
+    const auto n_it = _notice_time.find(msg.conflict_version);
+    if (n_it != _notice_time.end())
+    {
+      _duration.add(
+        std::chrono::duration<double>(record.time - n_it->second).count());
+    }
+
+    _rooms.erase(r_it);
+  }
+
+  void _record_response(
+    const Version conflict_version,
+    const std::vector<ParticipantId>& sequence,
+    const std::chrono::nanoseconds time)
+  {
+    // A table becomes available when its negotiation is opened, when the
+    // parent table receives a proposal, or when the table gets rejected.
+    const auto n_it = _notice_time.find(conflict_version);
+    if (n_it == _notice_time.end())
+      return;
+
+    auto available = n_it->second;
+    if (sequence.size() > 1)
+    {
+      const std::vector<ParticipantId> parent(
+        sequence.begin(), sequence.end() - 1);
+      const auto p_it = _proposal_time.find({conflict_version, parent});
+      if (p_it != _proposal_time.end())
+        available = std::max(available, p_it->second);
+    }
+
+    const auto r_it = _rejection_time.find({conflict_version, sequence});
+    if (r_it != _rejection_time.end())
+      available = std::max(available, r_it->second);
+
+    if (available <= time)
+      _response.add(std::chrono::duration<double>(time - available).count());
+  }
+
+  void _update_state(
+    const Version conflict_version,
+    const std::chrono::nanoseconds time)
+  {
+    const auto r_it = _rooms.find(conflict_version);
+    if (r_it == _rooms.end())
+      return;
+
+    const auto offset = rmf_traffic::Time(
+      std::chrono::duration_cast<rmf_traffic::Duration>(time));
+    _state_update.time(
+      [&]()
+      {
+        r_it->second->update_state_msg(conflict_version, offset, offset);
+        return true;
+      });
+  }
+
+  rmf_traffic::schedule::Database _database;
+  std::unordered_map<Version, std::unique_ptr<NegotiationRoom>> _rooms;
+
+  std::unordered_map<Version, std::chrono::nanoseconds> _notice_time;
+  std::map<TableKey, std::chrono::nanoseconds> _proposal_time;
+  std::map<TableKey, std::chrono::nanoseconds> _rejection_time;
+
+  std::size_t _opened = 0;
+  std::size_t _resolved = 0;
+  std::size_t _failed = 0;
+  std::size_t _unknown_participants = 0;
+  std::size_t _proposals = 0;
+  std::size_t _rejections = 0;
+  std::size_t _forfeits = 0;
+
+  Phase _response;
+  Phase _decoding;
+  Phase _validation;
+  Phase _state_update;
+  Phase _duration;
+};
+
+} // anonymous namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " <recording file> [repetitions]"
+              << std::endl;
+    return 1;
+  }
+
+  std::vector<NegotiationRecord> records;
+  try
+  {
+    records = rmf_traffic_ros2::schedule::read_negotiation_recording(argv[1]);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  // When the recording is replayed several times, only the last replay is
+  // reported so that warm-up effects are left out of the measurements
+  const int repetitions = argc > 2 ? std::max(1, std::atoi(argv[2])) : 1;
+
+  std::printf("Replaying %lu records from [%s]", records.size(), argv[1]);
+  if (repetitions > 1)
+    std::printf(" %d times", repetitions);
+  std::printf("\n\n");
+
+  for (int i = 0; i < repetitions; ++i)
+  {
+    Replay replay(records);
+    for (const auto& record : records)
+      replay.apply(record);
+
+    if (i + 1 == repetitions)
+      replay.report();
+  }
+
+  return 0;
+}
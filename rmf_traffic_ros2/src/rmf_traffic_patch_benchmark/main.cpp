@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <rmf_traffic_ros2/schedule/Patch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// This benchmark builds a schedule Patch with a configurable number of
+// participants, each adding a few routes with many waypoints, which is the
+// shape of the large patches that mirrors receive when they first sync with
+// the schedule. It then times converting the patch into a message, converting
+// the message back by copying from it, and converting it back by moving from
+// it, which is what a subscriber that owns its message can do.
+//
+// Usage: rmf_traffic_patch_benchmark [participants] [routes] [waypoints] [reps]
+
+namespace {
+
+//==============================================================================
+rmf_traffic::schedule::Patch make_patch(
+  std::size_t participants,
+  std::size_t routes,
+  std::size_t waypoints)
+{
+  using Change = rmf_traffic::schedule::Change;
+  const auto start = std::chrono::steady_clock::now();
+
+  std::vector<rmf_traffic::schedule::Patch::Participant> parts;
+  parts.reserve(participants);
+  for (std::size_t p = 0; p < participants; ++p)
+  {
+    std::vector<Change::Add::Item> items;
+    for (std::size_t r = 0; r < routes; ++r)
+    {
+      rmf_traffic::Trajectory trajectory;
+      for (std::size_t w = 0; w < waypoints; ++w)
+      {
+        trajectory.insert(
+          start + std::chrono::seconds(w),
+          Eigen::Vector3d(static_cast<double>(w), static_cast<double>(p), 0.0),
+          Eigen::Vector3d(1.0, 0.0, 0.0));
+      }
+
+      auto route = std::make_shared<rmf_traffic::Route>(
+        "level_" + std::to_string(p % 4) + "_of_a_reasonably_long_map_name",
+        std::move(trajectory));
+      route->checkpoints({0, waypoints / 2, waypoints - 1});
+      items.push_back({r, r, std::move(route)});
+    }
+
+    std::vector<uint64_t> erased;
+    for (std::size_t r = 0; r < routes; ++r)
+      erased.push_back(routes + r);
+
+    parts.emplace_back(
+      p, p + 1,
+      Change::Erase{std::move(erased)},
+      std::vector<Change::Delay>{},
+      Change::Add{p, std::move(items)},
+      Change::Progress(p, std::vector<uint64_t>(routes, 0)));
+  }
+
+  return rmf_traffic::schedule::Patch{std::move(parts), std::nullopt,
+    std::nullopt, 1};
+}
+
+//==============================================================================
+template<typename F>
+double time_ms(std::size_t reps, F f)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < reps; ++i)
+    f();
+
+  const auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count()
+    / static_cast<double>(reps);
+}
+
+} // anonymous namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  const std::size_t participants = argc > 1 ? std::stoul(argv[1]) : 200;
+  const std::size_t routes = argc > 2 ? std::stoul(argv[2]) : 3;
+  const std::size_t waypoints = argc > 3 ? std::max(2ul, std::stoul(argv[3])) :
+    500;
+  const std::size_t reps = argc > 4 ? std::stoul(argv[4]) : 10;
+
+  const auto patch = make_patch(participants, routes, waypoints);
+  std::cout << "Patch with " << participants << " participants, " << routes
+            << " routes each, " << waypoints << " waypoints per route"
+            << std::endl;
+
+  std::size_t sink = 0;
+  const double to_msg = time_ms(reps, [&]()
+      {
+        sink += rmf_traffic_ros2::convert(patch).participants.size();
+      });
+
+  const auto msg = rmf_traffic_ros2::convert(patch);
+  const double from_msg = time_ms(reps, [&]()
+      {
+        sink += rmf_traffic_ros2::convert(msg).size();
+      });
+
+  // Moving from a message consumes it, so each repetition needs its own copy.
+  // Copy them all up front so that the copies are not timed.
+  std::vector<rmf_traffic_msgs::msg::SchedulePatch> copies(reps, msg);
+  std::size_t next = 0;
+  const double from_moved_msg = time_ms(reps, [&]()
+      {
+        sink += rmf_traffic_ros2::convert(std::move(copies[next++])).size();
+      });
+
+  std::printf("Patch -> message          %10.2f ms\n", to_msg);
+  std::printf("message -> Patch (copy)   %10.2f ms\n", from_msg);
+  std::printf("message -> Patch (move)   %10.2f ms\n", from_moved_msg);
+  std::printf("(%zu)\n", sink);
+  return 0;
+}
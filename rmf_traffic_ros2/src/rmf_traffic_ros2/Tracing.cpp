@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_traffic_ros2/Tracing.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <unistd.h>
+
+namespace rmf_traffic_ros2 {
+namespace tracing {
+
+namespace {
+//==============================================================================
+int64_t now_us()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+//==============================================================================
+uint64_t thread_number()
+{
+  return std::hash<std::thread::id>()(std::this_thread::get_id()) & 0xFFFFFFFF;
+}
+
+//==============================================================================
+class Tracer
+{
+public:
+
+  static Tracer& get()
+  {
+    static Tracer tracer;
+    return tracer;
+  }
+
+  bool open(const std::string& filename)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _close();
+    _file.open(filename, std::ios::out | std::ios::trunc);
+    if (!_file.good())
+      return false;
+
+    // The closing bracket of the JSON Array Format is optional, which lets the
+    // file stay readable even if the process never gets to close it.
+    _file << "[\n";
+    _active = true;
+    return true;
+  }
+
+  void close()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _close();
+  }
+
+  bool active() const
+  {
+    return _active.load(std::memory_order_relaxed);
+  }
+
+  void write(const nlohmann::json& event)
+  {
+    const auto line = event.dump();
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_active)
+      return;
+
+    _file << line << ",\n";
+  }
+
+  ~Tracer()
+  {
+    close();
+  }
+
+private:
+
+  Tracer()
+  {
+    const char* dir = std::getenv("RMF_TRACE_DIR");
+    if (dir && dir[0] != '\0')
+    {
+      open(std::string(dir) + "/rmf_trace_"
+        + std::to_string(getpid()) + ".json");
+    }
+  }
+
+  void _close()
+  {
+    if (!_file.is_open())
+      return;
+
+    _active = false;
+    _file << "{}]\n";
+    _file.close();
+  }
+
+  std::atomic_bool _active{false};
+  std::mutex _mutex;
+  std::ofstream _file;
+};
+
+//==============================================================================
+nlohmann::json make_event(
+  const std::string& name,
+  const std::string& phase,
+  int64_t ts,
+  const std::string& trace_key)
+{
+  nlohmann::json event;
+  event["name"] = name;
+  event["cat"] = "rmf";
+  event["ph"] = phase;
+  event["ts"] = ts;
+  event["pid"] = getpid();
+  event["tid"] = thread_number();
+  event["args"]["trace"] = trace_key;
+  return event;
+}
+} // anonymous namespace
+
+//==============================================================================
+bool enable(const std::string& filename)
+{
+  return Tracer::get().open(filename);
+}
+
+//==============================================================================
+void disable()
+{
+  Tracer::get().close();
+}
+
+//==============================================================================
+bool enabled()
+{
+  return Tracer::get().active();
+}
+
+//==============================================================================
+class Span::Implementation
+{
+public:
+  nlohmann::json event;
+  int64_t start;
+};
+
+//==============================================================================
+Span::Span()
+{
+  // Do nothing
+}
+
+//==============================================================================
+Span Span::begin(const std::string& name, const std::string& trace_key)
+{
+  Span span;
+  if (!enabled())
+    return span;
+
+  const auto start = now_us();
+  span._pimpl = std::make_unique<Implementation>(
+    Implementation{make_event(name, "X", start, trace_key), start});
+  return span;
+}
+
+//==============================================================================
+Span& Span::arg(const std::string& key, const std::string& value)
+{
+  if (_pimpl)
+    _pimpl->event["args"][key] = value;
+
+  return *this;
+}
+
+//==============================================================================
+void Span::end()
+{
+  if (!_pimpl)
+    return;
+
+  _pimpl->event["dur"] = now_us() - _pimpl->start;
+  Tracer::get().write(_pimpl->event);
+  _pimpl.reset();
+}
+
+//==============================================================================
+bool Span::active() const
+{
+  return static_cast<bool>(_pimpl);
+}
+
+//==============================================================================
+Span::Span(Span&& other)
+: _pimpl(std::move(other._pimpl))
+{
+  // Do nothing
+}
+
+//==============================================================================
+Span& Span::operator=(Span&& other)
+{
+  end();
+  _pimpl = std::move(other._pimpl);
+  return *this;
+}
+
+//==============================================================================
+Span::~Span()
+{
+  end();
+}
+
+//==============================================================================
+void instant(const std::string& name, const std::string& trace_key)
+{
+  if (!enabled())
+    return;
+
+  auto event = make_event(name, "i", now_us(), trace_key);
+  event["s"] = "p";
+  Tracer::get().write(event);
+}
+
+} // namespace tracing
+} // namespace rmf_traffic_ros2
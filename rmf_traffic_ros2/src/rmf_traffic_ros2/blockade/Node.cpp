@@ -28,6 +28,8 @@
 #include <rmf_traffic_msgs/msg/blockade_set.hpp>
 #include <rmf_traffic_msgs/msg/blockade_status.hpp>
 
+#include <unordered_map>
+
 namespace rmf_traffic_ros2 {
 namespace blockade {
 
@@ -94,12 +96,49 @@ public:
       BlockadeHeartbeatTopicName,
       rclcpp::SystemDefaultsQoS().keep_last(10).reliable());
 
+    // If this is true, changes to the assignments only publish the statuses
+    // that changed on the heartbeat updates topic, and the full status of all
+    // participants only gets published by the heartbeat timer.
+    status_updates = declare_parameter<bool>("status_updates", false);
+    if (status_updates)
+    {
+      heartbeat_updates_pub = create_publisher<HeartbeatMsg>(
+        BlockadeHeartbeatUpdatesTopicName,
+        rclcpp::SystemDefaultsQoS().keep_last(10).reliable());
+    }
+
+    // Period, in milliseconds, for publishing the full status of all
+    // participants
+    const auto heartbeat_period = std::chrono::milliseconds(
+      std::max<int64_t>(1, declare_parameter<int>("heartbeat_period", 1000)));
+
     heartbeat_timer = create_wall_timer(
-      std::chrono::seconds(1),
+      heartbeat_period,
       [this]()
       {
         this->publish_status();
       });
+
+    // Period, in milliseconds, for batching the updates of the participants.
+    // When this is greater than zero, a burst of messages from many
+    // participants will be handled with one check of the assignments and one
+    // status publication. When it is zero, every message is checked as soon as
+    // it arrives.
+    const auto update_batch_period =
+      declare_parameter<int>("update_batch_period", 0);
+    if (update_batch_period > 0)
+    {
+      update_timer = create_wall_timer(
+        std::chrono::milliseconds(update_batch_period),
+        [this]()
+        {
+          if (!this->update_pending)
+            return;
+
+          this->update_pending = false;
+          this->check_for_updates();
+        });
+    }
   }
 
   using SetMsg = rmf_traffic_msgs::msg::BlockadeSet;
@@ -129,7 +168,7 @@ public:
         get_logger(), "Exception due to [set] update: %s", e.what());
     }
 
-    check_for_updates();
+    request_update();
   }
 
   using ReadyMsg = rmf_traffic_msgs::msg::BlockadeReady;
@@ -146,7 +185,7 @@ public:
         get_logger(), "Exception due to [ready] update: %s", e.what());
     }
 
-    check_for_updates();
+    request_update();
   }
 
   using ReleaseMsg = rmf_traffic_msgs::msg::BlockadeRelease;
@@ -164,7 +203,7 @@ public:
         get_logger(), "Exception due to [release] update: %s", e.what());
     }
 
-    check_for_updates();
+    request_update();
   }
 
   using ReachedMsg = rmf_traffic_msgs::msg::BlockadeReached;
@@ -182,7 +221,7 @@ public:
         get_logger(), "Exception due to [reached] update: %s", e.what());
     }
 
-    check_for_updates();
+    request_update();
   }
 
   using CancelMsg = rmf_traffic_msgs::msg::BlockadeCancel;
@@ -202,7 +241,20 @@ public:
         get_logger(), "Exception due to [cancel] update: %s", e.what());
     }
 
-    check_for_updates();
+    request_update();
+  }
+
+  /// Check for updates to the assignments right away, or wait until the next
+  /// batch if batching is turned on.
+  void request_update()
+  {
+    if (!update_timer)
+    {
+      check_for_updates();
+      return;
+    }
+
+    update_pending = true;
   }
 
   void check_for_updates()
@@ -212,13 +264,16 @@ public:
       return;
 
     last_assignment_version = current_version;
-    publish_status();
+    if (status_updates)
+      publish_status_updates();
+    else
+      publish_status();
   }
 
   using HeartbeatMsg = rmf_traffic_msgs::msg::BlockadeHeartbeat;
   rclcpp::Publisher<HeartbeatMsg>::SharedPtr heartbeat_pub;
   using StatusMsg = rmf_traffic_msgs::msg::BlockadeStatus;
-  void publish_status()
+  std::vector<StatusMsg> current_statuses() const
   {
     const auto& ranges = moderator->assignments().ranges();
 
@@ -240,16 +295,73 @@ public:
         .assignment_end(range.end));
     }
 
+    return statuses;
+  }
+
+  void publish_status()
+  {
+    auto statuses = current_statuses();
+    if (status_updates)
+    {
+      last_published.clear();
+      for (const auto& status : statuses)
+        last_published.insert({status.participant, status});
+    }
+
+    last_gridlock = moderator->has_gridlock();
     auto msg = rmf_traffic_msgs::build<HeartbeatMsg>()
       .statuses(std::move(statuses))
-      .has_gridlock(moderator->has_gridlock());
+      .has_gridlock(last_gridlock);
 
     heartbeat_pub->publish(msg);
   }
 
+  /// Publish only the statuses that changed since they were last published.
+  /// Participants that no longer have a status are left to the next full
+  /// heartbeat.
+  void publish_status_updates()
+  {
+    std::vector<StatusMsg> changed;
+    for (auto& status : current_statuses())
+    {
+      const auto insertion =
+        last_published.insert({status.participant, status});
+      if (insertion.second)
+      {
+        changed.push_back(std::move(status));
+        continue;
+      }
+
+      auto& previous = insertion.first->second;
+      if (previous == status)
+        continue;
+
+      previous = status;
+      changed.push_back(std::move(status));
+    }
+
+    const bool has_gridlock = moderator->has_gridlock();
+    if (changed.empty() && has_gridlock == last_gridlock)
+      return;
+
+    last_gridlock = has_gridlock;
+    auto msg = rmf_traffic_msgs::build<HeartbeatMsg>()
+      .statuses(std::move(changed))
+      .has_gridlock(has_gridlock);
+
+    heartbeat_updates_pub->publish(msg);
+  }
+
   std::shared_ptr<rmf_traffic::blockade::Moderator> moderator;
   std::size_t last_assignment_version = 0;
   rclcpp::TimerBase::SharedPtr heartbeat_timer;
+  rclcpp::TimerBase::SharedPtr update_timer;
+  bool update_pending = false;
+
+  bool status_updates = false;
+  rclcpp::Publisher<HeartbeatMsg>::SharedPtr heartbeat_updates_pub;
+  std::unordered_map<uint64_t, StatusMsg> last_published;
+  bool last_gridlock = false;
 };
 
 //==============================================================================
@@ -85,6 +85,7 @@ public:
 
   using HeartbeatMsg = rmf_traffic_msgs::msg::BlockadeHeartbeat;
   rclcpp::Subscription<HeartbeatMsg>::SharedPtr heartbeat_sub;
+  rclcpp::Subscription<HeartbeatMsg>::SharedPtr heartbeat_updates_sub;
 
   // NOTE(MXG): Because of some awkwardness in the design of the rectification
   // factory, we can only allow one participant to be constructed at a time.
@@ -104,7 +105,17 @@ public:
       rclcpp::SystemDefaultsQoS().keep_last(10).reliable(),
       [&](const HeartbeatMsg::UniquePtr msg)
       {
-        check_status(*msg);
+        check_status(*msg, true);
+      });
+
+    // The blockade node may be configured to publish only the statuses that
+    // have changed in between its full heartbeats.
+    heartbeat_updates_sub = node.create_subscription<HeartbeatMsg>(
+      BlockadeHeartbeatUpdatesTopicName,
+      rclcpp::SystemDefaultsQoS().keep_last(10).reliable(),
+      [&](const HeartbeatMsg::UniquePtr msg)
+      {
+        check_status(*msg, false);
       });
   }
 
@@ -165,7 +176,11 @@ public:
     return range;
   }
 
-  void check_status(const HeartbeatMsg& heartbeat)
+  /// \param[in] complete
+  ///   True if the heartbeat contains the status of every participant. When
+  ///   this is false, participants that are missing from the heartbeat will
+  ///   not be checked.
+  void check_status(const HeartbeatMsg& heartbeat, const bool complete)
   {
     const auto writer = weak_writer.lock();
     if (!writer)
@@ -211,6 +226,12 @@ public:
       stub_map_copy.erase(it);
     }
 
+    // A partial update says nothing about the participants that are missing
+    // from it, so the remaining stubs and the dead set are left for the next
+    // complete heartbeat.
+    if (!complete)
+      return;
+
     for (const auto& s : stub_map_copy)
     {
       // Check on the remaining stubs to make sure they shouldn't have any
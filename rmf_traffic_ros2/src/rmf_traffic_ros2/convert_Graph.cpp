@@ -29,6 +29,8 @@
 #include <rmf_building_map_msgs/msg/graph_edge.hpp>
 #include <rmf_building_map_msgs/msg/param.hpp>
 
+#include <istream>
+#include <streambuf>
 #include <unordered_set>
 
 namespace rmf_traffic_ros2 {
@@ -38,76 +40,239 @@ namespace rmf_traffic_ros2 {
 using CoordsIdxHashMap = std::unordered_map<std::size_t, std::unordered_map<
       double, std::unordered_map<double, std::size_t>>>;
 
-// local helper function to factor json parsing code for both
-// the compressed and uncompressed case
-static rmf_traffic::agv::Graph json_to_graph(
-  const std::vector<uint8_t>& json_doc,
-  const int graph_idx,
-  const double wp_tolerance);
-
-std::optional<std::vector<uint8_t>> decompress_gzip(
-  const std::vector<uint8_t>& in)
+//==============================================================================
+/// Inflates a gzipped buffer a chunk at a time as it gets read, so the whole
+/// decompressed document never needs to be held in memory.
+class GzipStreambuf : public std::streambuf
 {
-  std::vector<uint8_t> out;
-  z_stream strm;
-  memset(&strm, 0, sizeof(strm));
-  strm.zalloc = Z_NULL;
-  strm.zfree = Z_NULL;
-  strm.opaque = Z_NULL;
-  strm.avail_in = 0;
-  strm.next_in = Z_NULL;
-  const int inflate_init_ret = inflateInit2(&strm, 15 + 32);
-  if (inflate_init_ret != Z_OK)
+public:
+
+  GzipStreambuf(const std::vector<uint8_t>& in)
+  : _buffer(ChunkSize)
   {
-    std::cout << "error in inflateInit2()" << std::endl;
-    return std::nullopt;
+    memset(&_strm, 0, sizeof(_strm));
+    _strm.zalloc = Z_NULL;
+    _strm.zfree = Z_NULL;
+    _strm.opaque = Z_NULL;
+    _ok = inflateInit2(&_strm, 15 + 32) == Z_OK;
+    if (!_ok)
+    {
+      std::cout << "error in inflateInit2()" << std::endl;
+      return;
+    }
+
+    _strm.next_in = const_cast<Bytef*>(in.data());
+    _strm.avail_in = in.size();
   }
 
-  const std::size_t READ_CHUNK_SIZE = 128 * 1024;
-  std::size_t read_pos = 0;
+  ~GzipStreambuf()
+  {
+    if (_strm.state)
+      inflateEnd(&_strm);
+  }
 
-  std::vector<uint8_t> inflate_buf(READ_CHUNK_SIZE);
+  /// False if the compressed data could not be inflated
+  bool ok() const
+  {
+    return _ok;
+  }
 
-  do
+  std::size_t total_out() const
   {
-    if (read_pos + READ_CHUNK_SIZE < in.size())
-      strm.avail_in = READ_CHUNK_SIZE;
-    else
-      strm.avail_in = in.size() - read_pos;
+    return _strm.total_out;
+  }
+
+protected:
 
-    strm.next_in = (unsigned char*)&in[read_pos];
-    read_pos += strm.avail_in;
+  int_type underflow() final
+  {
+    if (gptr() < egptr())
+      return traits_type::to_int_type(*gptr());
+
+    if (!_ok || _done)
+      return traits_type::eof();
 
-    int inflate_ret = 0;
-    do
+    _strm.next_out = reinterpret_cast<Bytef*>(_buffer.data());
+    _strm.avail_out = _buffer.size();
+    while (_strm.avail_out == _buffer.size())
     {
-      strm.avail_out = inflate_buf.size();
-      strm.next_out = &inflate_buf[0];
-      inflate_ret = inflate(&strm, Z_NO_FLUSH);
-      if (inflate_ret == Z_NEED_DICT ||
-        inflate_ret == Z_DATA_ERROR ||
-        inflate_ret == Z_MEM_ERROR)
+      const int inflate_ret = inflate(&_strm, Z_NO_FLUSH);
+      if (inflate_ret == Z_STREAM_END)
+      {
+        _done = true;
+        break;
+      }
+
+      if (inflate_ret != Z_OK)
       {
+        // Z_BUF_ERROR here means that the input ended before the stream did
+        _ok = false;
         std::cout << "unrecoverable zlib inflate error" << std::endl;
-        inflateEnd(&strm);
-        return std::nullopt;
+        break;
       }
-      const int n_have = inflate_buf.size() - strm.avail_out;
-      out.insert(
-        out.end(),
-        inflate_buf.begin(),
-        inflate_buf.begin() + n_have);
-    } while (strm.avail_out == 0);
+    }
+
+    const std::size_t n_have = _buffer.size() - _strm.avail_out;
+    if (n_have == 0)
+      return traits_type::eof();
+
+    setg(_buffer.data(), _buffer.data(), _buffer.data() + n_have);
+    return traits_type::to_int_type(*gptr());
+  }
+
+private:
+  static constexpr std::size_t ChunkSize = 128 * 1024;
+  z_stream _strm;
+  std::vector<char> _buffer;
+  bool _ok = false;
+  bool _done = false;
+};
+
+//==============================================================================
+/// A SAX handler that builds a GeoJSON site map document while keeping only the
+/// features that describe the navigation graph. Every other feature is dropped
+/// as soon as it has been read, so large site maps never need a full document
+/// in memory.
+class SiteMapSax
+{
+public:
+
+  using json = nlohmann::json;
+
+  json document = json::object();
+
+  bool null() { return add(nullptr); }
+  bool boolean(bool val) { return add(val); }
+  bool number_integer(json::number_integer_t val) { return add(val); }
+  bool number_unsigned(json::number_unsigned_t val) { return add(val); }
+  bool number_float(json::number_float_t val, const json::string_t&)
+  {
+    return add(val);
+  }
+  bool string(json::string_t& val) { return add(std::move(val)); }
+  bool binary(json::binary_t& val) { return add(json::binary(std::move(val))); }
+
+  bool start_object(std::size_t)
+  {
+    if (_stack.empty())
+      _stack.push_back(&document);
+    else
+      _stack.push_back(add_child(json::object()));
+
+    return true;
+  }
+
+  bool key(json::string_t& val)
+  {
+    if (_stack.size() == 1)
+      _top_level_key = val;
+
+    _key = std::move(val);
+    return true;
+  }
 
-    if (inflate_ret == Z_STREAM_END)
-      break;
-  } while (read_pos < in.size());
+  bool end_object()
+  {
+    _stack.pop_back();
+    if (_in_features() && !_is_graph_feature(_stack.back()->back()))
+      _stack.back()->get_ref<json::array_t&>().pop_back();
+
+    return true;
+  }
+
+  bool start_array(std::size_t)
+  {
+    if (_stack.empty())
+      return false;
+
+    _stack.push_back(add_child(json::array()));
+    return true;
+  }
 
-  std::cout << "inflated: " << in.size() << " -> " << out.size() << std::endl;
+  bool end_array()
+  {
+    _stack.pop_back();
+    return true;
+  }
+
+  bool parse_error(
+    std::size_t,
+    const std::string&,
+    const nlohmann::detail::exception& ex)
+  {
+    // Throw the same exceptions that nlohmann::json::parse would
+    if (const auto* e = dynamic_cast<const json::parse_error*>(&ex))
+      throw *e;
+    if (const auto* e = dynamic_cast<const json::out_of_range*>(&ex))
+      throw *e;
+
+    throw std::runtime_error(ex.what());
+  }
+
+private:
+
+  template<typename T>
+  bool add(T&& value)
+  {
+    if (_stack.empty())
+      return false;
+
+    add_child(json(std::forward<T>(value)));
+    return true;
+  }
+
+  json* add_child(json value)
+  {
+    json* parent = _stack.back();
+    if (parent->is_object())
+    {
+      auto& child = (*parent)[_key];
+      child = std::move(value);
+      return &child;
+    }
+
+    parent->push_back(std::move(value));
+    return &parent->back();
+  }
 
-  return {out};
+  // True if the top of the stack is the top-level features array
+  bool _in_features() const
+  {
+    return _stack.size() == 2 && _top_level_key == "features"
+      && _stack.back()->is_array();
+  }
+
+  static bool _is_graph_feature(const json& feature)
+  {
+    const auto type_it = feature.find("feature_type");
+    if (type_it == feature.end() || !type_it->is_string())
+      return false;
+
+    const auto& type = type_it->get_ref<const std::string&>();
+    return type == "rmf_vertex" || type == "rmf_lane";
+  }
+
+  std::vector<json*> _stack;
+  std::string _key;
+  std::string _top_level_key;
+};
+
+//==============================================================================
+template<typename Input>
+static nlohmann::json parse_site_map(Input&& input)
+{
+  SiteMapSax sax;
+  nlohmann::json::sax_parse(std::forward<Input>(input), &sax);
+  return std::move(sax.document);
 }
 
+// local helper function to factor json parsing code for both
+// the compressed and uncompressed case
+static rmf_traffic::agv::Graph json_to_graph(
+  const nlohmann::json& j,
+  const int graph_idx,
+  const double wp_tolerance);
+
 //==============================================================================
 rmf_traffic::agv::Graph convert(const rmf_site_map_msgs::msg::SiteMap& from,
   int graph_idx, double wp_tolerance)
@@ -116,15 +281,34 @@ rmf_traffic::agv::Graph convert(const rmf_site_map_msgs::msg::SiteMap& from,
   if (from.encoding == from.MAP_DATA_GEOJSON)
   {
     std::cout << "converting GeoJSON map" << std::endl;
-    return json_to_graph(from.data, graph_idx, wp_tolerance);
+    return json_to_graph(parse_site_map(from.data), graph_idx, wp_tolerance);
   }
   else if (from.encoding == from.MAP_DATA_GEOJSON_GZ)
   {
     std::cout << "converting compressed GeoJSON map" << std::endl;
-    const auto uncompressed = decompress_gzip(from.data);
-    if (!uncompressed.has_value())
+    GzipStreambuf inflated(from.data);
+    if (!inflated.ok())
       return graph;
-    return json_to_graph(uncompressed.value(), graph_idx, wp_tolerance);
+
+    std::istream stream(&inflated);
+    nlohmann::json j;
+    try
+    {
+      j = parse_site_map(stream);
+    }
+    catch (const nlohmann::json::parse_error&)
+    {
+      // A corrupted stream cuts the document short, which is not the fault of
+      // the document.
+      if (!inflated.ok())
+        return graph;
+
+      throw;
+    }
+
+    std::cout << "inflated: " << from.data.size() << " -> "
+              << inflated.total_out() << std::endl;
+    return json_to_graph(j, graph_idx, wp_tolerance);
   }
   else
   {
@@ -134,13 +318,11 @@ rmf_traffic::agv::Graph convert(const rmf_site_map_msgs::msg::SiteMap& from,
 }
 
 rmf_traffic::agv::Graph json_to_graph(
-  const std::vector<uint8_t>& json_doc,
+  const nlohmann::json& j,
   const int graph_idx,
   const double wp_tolerance)
 {
   rmf_traffic::agv::Graph graph;
-  std::cout << "json_to_graph with doc length " << json_doc.size() << std::endl;
-  nlohmann::json j = nlohmann::json::parse(json_doc);
   std::cout << "parsed " << j.size() << "entries in json" << std::endl;
 
   const auto preferred_crs_it = j.find("preferred_crs");
@@ -22,10 +22,13 @@
 
 namespace rmf_traffic_ros2 {
 
+namespace {
 //==============================================================================
-rmf_traffic::Route convert(const rmf_traffic_msgs::msg::Route& from)
+rmf_traffic::Route convert_route(
+  std::string map,
+  const rmf_traffic_msgs::msg::Route& from)
 {
-  rmf_traffic::Route route{from.map, convert(from.trajectory)};
+  rmf_traffic::Route route{std::move(map), convert(from.trajectory)};
   std::set<uint64_t> checkpoints(
     from.checkpoints.begin(), from.checkpoints.end());
   route.checkpoints(std::move(checkpoints));
@@ -44,6 +47,20 @@ rmf_traffic::Route convert(const rmf_traffic_msgs::msg::Route& from)
   return route;
 }
 
+} // anonymous namespace
+
+//==============================================================================
+rmf_traffic::Route convert(const rmf_traffic_msgs::msg::Route& from)
+{
+  return convert_route(from.map, from);
+}
+
+//==============================================================================
+rmf_traffic::Route convert(rmf_traffic_msgs::msg::Route&& from)
+{
+  return convert_route(std::move(from.map), from);
+}
+
 //==============================================================================
 std::vector<rmf_traffic_msgs::msg::TrafficDependency> convert(
   const rmf_traffic::DependsOnParticipant& from)
@@ -92,17 +109,32 @@ std::vector<rmf_traffic::Route> convert(
   const std::vector<rmf_traffic_msgs::msg::Route>& from)
 {
   std::vector<rmf_traffic::Route> output;
+  output.reserve(from.size());
   for (const auto& msg : from)
     output.emplace_back(convert(msg));
 
   return output;
 }
 
+//==============================================================================
+std::vector<rmf_traffic::Route> convert(
+  std::vector<rmf_traffic_msgs::msg::Route>&& from)
+{
+  std::vector<rmf_traffic::Route> output;
+  output.reserve(from.size());
+  for (auto& msg : from)
+    output.emplace_back(convert(std::move(msg)));
+
+  from.clear();
+  return output;
+}
+
 //==============================================================================
 std::vector<rmf_traffic_msgs::msg::Route> convert(
   const std::vector<rmf_traffic::Route>& from)
 {
   std::vector<rmf_traffic_msgs::msg::Route> output;
+  output.reserve(from.size());
   for (const auto& msg : from)
     output.emplace_back(convert(msg));
 
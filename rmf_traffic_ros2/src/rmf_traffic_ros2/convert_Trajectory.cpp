@@ -53,26 +53,21 @@ rmf_traffic::Trajectory convert(const rmf_traffic_msgs::msg::Trajectory& from)
   return output;
 }
 
-namespace {
-//==============================================================================
-rmf_traffic_msgs::msg::TrajectoryWaypoint convert_waypoint(
-  const rmf_traffic::Trajectory::Waypoint& from)
-{
-  rmf_traffic_msgs::msg::TrajectoryWaypoint output;
-  output.time = from.time().time_since_epoch().count();
-  output.position = from_eigen(from.position());
-  output.velocity = from_eigen(from.velocity());
-  return output;
-}
-
-} // anonymous namespace
-
 //==============================================================================
 rmf_traffic_msgs::msg::Trajectory convert(const rmf_traffic::Trajectory& from)
 {
   rmf_traffic_msgs::msg::Trajectory output;
+  output.waypoints.resize(from.size());
+
+  // Fill in the waypoints where they are instead of building temporaries
+  auto out = output.waypoints.begin();
   for (const auto& waypoint : from)
-    output.waypoints.emplace_back(convert_waypoint(waypoint));
+  {
+    out->time = waypoint.time().time_since_epoch().count();
+    out->position = from_eigen(waypoint.position());
+    out->velocity = from_eigen(waypoint.velocity());
+    ++out;
+  }
 
   return output;
 }
@@ -0,0 +1,307 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "internal_CompactMirrorUpdate.hpp"
+
+#include <rclcpp/serialization.hpp>
+#include <rclcpp/serialized_message.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+namespace {
+//==============================================================================
+using MirrorUpdate = rmf_traffic_msgs::msg::MirrorUpdate;
+
+enum class Format : uint8_t
+{
+  // The rest of the data is the regular CDR encoding of the whole update
+  Regular = 0,
+
+  // The rest of the data is the length of the CDR encoding of the update
+  // without its waypoints, then that encoding, then the waypoint stream
+  Compact = 1
+};
+
+//==============================================================================
+template<typename Msg, typename F>
+void for_each_trajectory(Msg& msg, F&& f)
+{
+  for (auto& participant : msg.patch.participants)
+  {
+    for (auto& item : participant.additions.items)
+      f(item.route.trajectory);
+  }
+}
+
+//==============================================================================
+void write_varint(uint64_t value, std::vector<uint8_t>& output)
+{
+  while (value >= 0x80)
+  {
+    output.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  output.push_back(static_cast<uint8_t>(value));
+}
+
+//==============================================================================
+void write_signed(int64_t value, std::vector<uint8_t>& output)
+{
+  // Zigzag encoding keeps small negative values small
+  write_varint(
+    (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63),
+    output);
+}
+
+//==============================================================================
+class Reader
+{
+public:
+
+  Reader(const std::vector<uint8_t>& data)
+  : _data(data)
+  {
+    // Do nothing
+  }
+
+  uint8_t byte()
+  {
+    if (_pos >= _data.size())
+      throw std::runtime_error("Compact mirror update ended unexpectedly");
+
+    return _data[_pos++];
+  }
+
+  uint64_t varint()
+  {
+    uint64_t value = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7)
+    {
+      const uint8_t b = byte();
+      value |= static_cast<uint64_t>(b & 0x7f) << shift;
+      if (!(b & 0x80))
+        return value;
+    }
+
+    throw std::runtime_error("Compact mirror update has an invalid integer");
+  }
+
+  int64_t signed_varint()
+  {
+    const uint64_t value = varint();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  }
+
+  const uint8_t* take(std::size_t size)
+  {
+    if (_data.size() - _pos < size)
+      throw std::runtime_error("Compact mirror update ended unexpectedly");
+
+    const uint8_t* start = _data.data() + _pos;
+    _pos += size;
+    return start;
+  }
+
+  bool done() const
+  {
+    return _pos == _data.size();
+  }
+
+private:
+  const std::vector<uint8_t>& _data;
+  std::size_t _pos = 0;
+};
+
+//==============================================================================
+std::optional<int64_t> quantize(const double value)
+{
+  const double scaled = value / CompactMirrorUpdateResolution;
+  // Stay well inside the range of int64_t so the differences cannot overflow
+  if (!std::isfinite(scaled) || std::abs(scaled) > 1e18)
+    return std::nullopt;
+
+  return static_cast<int64_t>(std::llround(scaled));
+}
+
+//==============================================================================
+void append_serialized(
+  const MirrorUpdate& msg,
+  std::vector<uint8_t>& output,
+  const bool with_length)
+{
+  static const rclcpp::Serialization<MirrorUpdate> serialization;
+  rclcpp::SerializedMessage serialized;
+  serialization.serialize_message(&msg, &serialized);
+
+  const auto& raw = serialized.get_rcl_serialized_message();
+  if (with_length)
+    write_varint(raw.buffer_length, output);
+
+  output.insert(output.end(), raw.buffer, raw.buffer + raw.buffer_length);
+}
+
+//==============================================================================
+MirrorUpdate deserialize(const uint8_t* data, const std::size_t size)
+{
+  static const rclcpp::Serialization<MirrorUpdate> serialization;
+  rclcpp::SerializedMessage serialized(size);
+  auto& raw = serialized.get_rcl_serialized_message();
+  std::memcpy(raw.buffer, data, size);
+  raw.buffer_length = size;
+
+  MirrorUpdate msg;
+  serialization.deserialize_message(&serialized, &msg);
+  return msg;
+}
+
+//==============================================================================
+std::vector<uint8_t> encode_regular(const MirrorUpdate& msg)
+{
+  std::vector<uint8_t> output;
+  output.push_back(static_cast<uint8_t>(Format::Regular));
+  append_serialized(msg, output, false);
+  return output;
+}
+
+} // anonymous namespace
+
+//==============================================================================
+std::vector<uint8_t> encode_compact(const MirrorUpdate& msg)
+{
+  std::vector<uint8_t> waypoints;
+  bool valid = true;
+  for_each_trajectory(
+    msg, [&](const auto& trajectory)
+    {
+      if (!valid)
+        return;
+
+      write_varint(trajectory.waypoints.size(), waypoints);
+      uint64_t last_time = 0;
+      std::array<int64_t, 6> last_values = {0, 0, 0, 0, 0, 0};
+      for (const auto& wp : trajectory.waypoints)
+      {
+        // Unsigned arithmetic wraps around instead of overflowing
+        const uint64_t time = static_cast<uint64_t>(wp.time);
+        write_signed(static_cast<int64_t>(time - last_time), waypoints);
+        last_time = time;
+
+        for (std::size_t i = 0; i < 6; ++i)
+        {
+          const auto value = quantize(
+            i < 3 ? wp.position[i] : wp.velocity[i - 3]);
+          if (!value.has_value())
+          {
+            valid = false;
+            return;
+          }
+
+          write_signed(*value - last_values[i], waypoints);
+          last_values[i] = *value;
+        }
+      }
+    });
+
+  if (!valid)
+    return encode_regular(msg);
+
+  auto stripped = msg;
+  for_each_trajectory(
+    stripped, [](auto& trajectory)
+    {
+      trajectory.waypoints.clear();
+    });
+
+  std::vector<uint8_t> output;
+  output.reserve(waypoints.size() + 64);
+  output.push_back(static_cast<uint8_t>(Format::Compact));
+  append_serialized(stripped, output, true);
+  output.insert(output.end(), waypoints.begin(), waypoints.end());
+  return output;
+}
+
+//==============================================================================
+MirrorUpdate decode_compact(const std::vector<uint8_t>& data)
+{
+  Reader reader(data);
+  const uint8_t format = reader.byte();
+  if (format == static_cast<uint8_t>(Format::Regular))
+    return deserialize(data.data() + 1, data.size() - 1);
+
+  if (format != static_cast<uint8_t>(Format::Compact))
+  {
+    throw std::runtime_error(
+      "Unknown compact mirror update format ["
+      + std::to_string(format) + "]");
+  }
+
+  const uint64_t stripped_size = reader.varint();
+  if (stripped_size > data.size())
+    throw std::runtime_error("Compact mirror update ended unexpectedly");
+
+  const std::size_t size = static_cast<std::size_t>(stripped_size);
+  auto msg = deserialize(reader.take(size), size);
+
+  for_each_trajectory(
+    msg, [&](auto& trajectory)
+    {
+      const uint64_t count = reader.varint();
+      // Every waypoint takes at least seven bytes, so this also guards against
+      // allocating for a corrupted count.
+      if (count > data.size())
+        throw std::runtime_error("Compact mirror update ended unexpectedly");
+
+      trajectory.waypoints.resize(static_cast<std::size_t>(count));
+      // Corrupted differences should wrap around instead of overflowing
+      uint64_t last_time = 0;
+      std::array<uint64_t, 6> last_values = {0, 0, 0, 0, 0, 0};
+      for (auto& wp : trajectory.waypoints)
+      {
+        last_time += static_cast<uint64_t>(reader.signed_varint());
+        wp.time = static_cast<int64_t>(last_time);
+
+        for (std::size_t i = 0; i < 6; ++i)
+        {
+          last_values[i] += static_cast<uint64_t>(reader.signed_varint());
+          const double value =
+            static_cast<double>(static_cast<int64_t>(last_values[i]))
+            * CompactMirrorUpdateResolution;
+
+          if (i < 3)
+            wp.position[i] = value;
+          else
+            wp.velocity[i - 3] = value;
+        }
+      }
+    });
+
+  if (!reader.done())
+    throw std::runtime_error("Compact mirror update has trailing data");
+
+  return msg;
+}
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "internal_ConflictHorizon.hpp"
+
+#include <algorithm>
+#include <set>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+HorizonCheck HorizonCheck::decide(
+  const RouteBounds& a,
+  const RouteBounds& b,
+  const rmf_traffic::Time horizon_end,
+  const rmf_traffic::Duration recheck_step)
+{
+  HorizonCheck check;
+  const auto overlap_start = std::max(a.start_time, b.start_time);
+  if (horizon_end < overlap_start)
+  {
+    // These routes cannot meet until after the horizon
+    check.kind = Kind::Defer;
+    check.recheck_time = overlap_start;
+    return check;
+  }
+
+  const auto overlap_finish = std::min(a.finish_time, b.finish_time);
+  if (overlap_finish <= horizon_end)
+    return check;
+
+  if (horizon_end <= overlap_start)
+  {
+    // One of the routes starts right at the horizon, so there is nothing
+    // before the horizon to check yet
+    check.kind = Kind::Defer;
+    check.recheck_time = horizon_end + recheck_step;
+    return check;
+  }
+
+  // Check the part within the horizon now and the rest once the horizon has
+  // moved on
+  check.kind = Kind::Clipped;
+  check.recheck_time = horizon_end + recheck_step;
+  return check;
+}
+
+//==============================================================================
+std::optional<rmf_traffic::Trajectory> clip_to_horizon(
+  const rmf_traffic::Trajectory& trajectory,
+  const rmf_traffic::Time horizon_end)
+{
+  rmf_traffic::Trajectory clipped;
+  for (const auto& wp : trajectory)
+  {
+    if (horizon_end <= wp.time() && clipped.size() == 0)
+      return std::nullopt;
+
+    clipped.insert(wp.time(), wp.position(), wp.velocity());
+    if (horizon_end <= wp.time())
+      break;
+  }
+
+  if (clipped.size() < 2)
+    return std::nullopt;
+
+  return clipped;
+}
+
+//==============================================================================
+void defer_route(
+  DeferredRoutes& deferred,
+  const ChangedRoute& change,
+  const rmf_traffic::Time recheck_time)
+{
+  const auto key = std::make_pair(change.participant, change.route_id);
+  const auto it = deferred.insert({key, DeferredRoute{change, recheck_time}});
+  if (it.second)
+    return;
+
+  auto& existing = it.first->second;
+  if (existing.change.route != change.route)
+    existing = DeferredRoute{change, recheck_time};
+  else if (recheck_time < existing.recheck_time)
+    existing.recheck_time = recheck_time;
+}
+
+//==============================================================================
+void recheck_deferred_routes(
+  const rmf_traffic::Time horizon_end,
+  const rmf_traffic::schedule::ItineraryViewer& viewer,
+  ChangedRoutes& view_changes,
+  DeferredRoutes& deferred)
+{
+  std::set<std::pair<ParticipantId, rmf_traffic::RouteId>> changed;
+  for (const auto& vc : view_changes)
+    changed.insert({vc.participant, vc.route_id});
+
+  for (auto it = deferred.begin(); it != deferred.end(); )
+  {
+    auto& change = it->second.change;
+    if (horizon_end < it->second.recheck_time)
+    {
+      ++it;
+      continue;
+    }
+
+    const auto plan_id = viewer.get_current_plan_id(change.participant);
+    const auto itinerary = viewer.get_itinerary(change.participant);
+    const auto description = viewer.get_participant(change.participant);
+    if (plan_id.has_value() && *plan_id == change.plan_id
+      && itinerary.has_value() && change.route_id < itinerary->size()
+      && description && changed.count(it->first) == 0)
+    {
+      change.route = (*itinerary)[change.route_id];
+      change.description = *description;
+      view_changes.push_back(std::move(change));
+    }
+
+    it = deferred.erase(it);
+  }
+}
+
+//==============================================================================
+bool ReportedConflicts::report(const RouteConflict& conflict)
+{
+  Key key{
+    conflict.participant_a, conflict.route_id_a,
+    conflict.participant_b, conflict.route_id_b};
+  Routes routes{conflict.route_a, conflict.route_b};
+
+  // The same pair can be found from either side, so always store it with the
+  // lower participant ID first
+  if (conflict.participant_b < conflict.participant_a)
+  {
+    key = Key{
+      conflict.participant_b, conflict.route_id_b,
+      conflict.participant_a, conflict.route_id_a};
+    routes = Routes{conflict.route_b, conflict.route_a};
+  }
+
+  const auto it = _reported.insert({key, routes});
+  if (it.second)
+    return true;
+
+  if (it.first->second == routes)
+    return false;
+
+  it.first->second = std::move(routes);
+  return true;
+}
+
+//==============================================================================
+void ReportedConflicts::prune(
+  const rmf_traffic::schedule::ItineraryViewer& viewer)
+{
+  const auto is_current = [&](
+    ParticipantId participant,
+    rmf_traffic::RouteId route_id,
+    const rmf_traffic::ConstRoutePtr& route) -> bool
+    {
+      const auto itinerary = viewer.get_itinerary(participant);
+      return itinerary.has_value() && route_id < itinerary->size()
+        && (*itinerary)[route_id] == route;
+    };
+
+  for (auto it = _reported.begin(); it != _reported.end(); )
+  {
+    const auto& [p_a, r_a, p_b, r_b] = it->first;
+    if (is_current(p_a, r_a, it->second.first)
+      && is_current(p_b, r_b, it->second.second))
+    {
+      ++it;
+      continue;
+    }
+
+    it = _reported.erase(it);
+  }
+}
+
+//==============================================================================
+std::size_t ReportedConflicts::size() const
+{
+  return _reported.size();
+}
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
@@ -0,0 +1,302 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "internal_Metrics.hpp"
+
+#include <statistics_msgs/msg/statistic_data_type.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+Metrics::Metrics(std::string source)
+: _source(std::move(source))
+{
+  // Do nothing
+}
+
+//==============================================================================
+void Metrics::add_statistic(
+  const std::string& name,
+  std::string unit,
+  std::vector<double> buckets)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto& stat = _statistics[name];
+  stat.unit = std::move(unit);
+  stat.buckets = std::move(buckets);
+  stat.bucket_counts.resize(stat.buckets.size(), 0);
+}
+
+//==============================================================================
+void Metrics::add_counter(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _counters.insert({name, 0});
+}
+
+//==============================================================================
+void Metrics::record(const std::string& name, const double value)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto it = _statistics.find(name);
+  if (it == _statistics.end())
+    return;
+
+  auto& stat = it->second;
+  const auto bucket = std::lower_bound(
+    stat.buckets.begin(), stat.buckets.end(), value);
+  if (bucket != stat.buckets.end())
+    ++stat.bucket_counts[bucket - stat.buckets.begin()];
+
+  stat.cumulative_sum += value;
+  ++stat.cumulative_count;
+
+  if (stat.count == 0)
+  {
+    stat.min = value;
+    stat.max = value;
+  }
+  else
+  {
+    stat.min = std::min(stat.min, value);
+    stat.max = std::max(stat.max, value);
+  }
+
+  ++stat.count;
+  stat.sum += value;
+  stat.sum_squares += value * value;
+}
+
+//==============================================================================
+void Metrics::record(
+  const std::string& name,
+  const std::chrono::steady_clock::duration value)
+{
+  record(name, std::chrono::duration<double>(value).count());
+}
+
+//==============================================================================
+void Metrics::increment(const std::string& name, const std::size_t amount)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto it = _counters.find(name);
+  if (it == _counters.end())
+    return;
+
+  it->second += amount;
+}
+
+//==============================================================================
+std::size_t Metrics::counter(const std::string& name) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto it = _counters.find(name);
+  if (it == _counters.end())
+    return 0;
+
+  return it->second;
+}
+
+//==============================================================================
+double Metrics::cumulative_sum(const std::string& name) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto it = _statistics.find(name);
+  if (it == _statistics.end())
+    return 0.0;
+
+  return it->second.cumulative_sum;
+}
+
+//==============================================================================
+uint64_t Metrics::cumulative_count(const std::string& name) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto it = _statistics.find(name);
+  if (it == _statistics.end())
+    return 0;
+
+  return it->second.cumulative_count;
+}
+
+//==============================================================================
+std::vector<statistics_msgs::msg::MetricsMessage> Metrics::flush(
+  const rclcpp::Time& window_stop)
+{
+  using DataType = statistics_msgs::msg::StatisticDataType;
+  using DataPoint = statistics_msgs::msg::StatisticDataPoint;
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  const rclcpp::Time window_start = _window_start.value_or(window_stop);
+  _window_start = window_stop;
+
+  std::vector<statistics_msgs::msg::MetricsMessage> messages;
+  for (auto& [name, stat] : _statistics)
+  {
+    if (stat.count == 0)
+      continue;
+
+    const double n = static_cast<double>(stat.count);
+    const double mean = stat.sum / n;
+    const double variance =
+      std::max(0.0, stat.sum_squares / n - mean * mean);
+
+    statistics_msgs::msg::MetricsMessage msg;
+    msg.measurement_source_name = _source;
+    msg.metrics_source = name;
+    msg.unit = stat.unit;
+    msg.window_start = window_start;
+    msg.window_stop = window_stop;
+
+    const auto add = [&](uint8_t type, double data)
+      {
+        DataPoint point;
+        point.data_type = type;
+        point.data = data;
+        msg.statistics.push_back(point);
+      };
+
+    add(DataType::STATISTICS_DATA_TYPE_AVERAGE, mean);
+    add(DataType::STATISTICS_DATA_TYPE_MINIMUM, stat.min);
+    add(DataType::STATISTICS_DATA_TYPE_MAXIMUM, stat.max);
+    add(DataType::STATISTICS_DATA_TYPE_STDDEV, std::sqrt(variance));
+    add(DataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT, n);
+    messages.emplace_back(std::move(msg));
+
+    stat.count = 0;
+    stat.sum = 0.0;
+    stat.sum_squares = 0.0;
+  }
+
+  for (const auto& [name, value] : _counters)
+  {
+    statistics_msgs::msg::MetricsMessage msg;
+    msg.measurement_source_name = _source;
+    msg.metrics_source = name;
+    msg.unit = "count";
+    msg.window_start = window_start;
+    msg.window_stop = window_stop;
+
+    DataPoint point;
+    point.data_type = DataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT;
+    point.data = static_cast<double>(value);
+    msg.statistics.push_back(point);
+    messages.emplace_back(std::move(msg));
+  }
+
+  return messages;
+}
+
+//==============================================================================
+std::string Metrics::prometheus() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::stringstream ss;
+  for (const auto& [name, stat] : _statistics)
+  {
+    const std::string full_name = _source + "_" + name;
+    ss << "# TYPE " << full_name << " histogram\n";
+
+    uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < stat.buckets.size(); ++i)
+    {
+      cumulative += stat.bucket_counts[i];
+      ss << full_name << "_bucket{le=\"" << stat.buckets[i] << "\"} "
+         << cumulative << "\n";
+    }
+
+    ss << full_name << "_bucket{le=\"+Inf\"} " << stat.cumulative_count
+       << "\n";
+    ss << full_name << "_sum " << stat.cumulative_sum << "\n";
+    ss << full_name << "_count " << stat.cumulative_count << "\n";
+  }
+
+  for (const auto& [name, value] : _counters)
+  {
+    const std::string full_name = _source + "_" + name + "_total";
+    ss << "# TYPE " << full_name << " counter\n";
+    ss << full_name << " " << value << "\n";
+  }
+
+  return ss.str();
+}
+
+//==============================================================================
+std::vector<double> Metrics::duration_buckets()
+{
+  return {1e-4, 5e-4, 1e-3, 5e-3, 1e-2, 5e-2, 1e-1, 5e-1, 1.0, 5.0, 10.0};
+}
+
+//==============================================================================
+std::vector<double> Metrics::size_buckets()
+{
+  return {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000};
+}
+
+//==============================================================================
+TimedLock::TimedLock(
+  std::mutex& mutex,
+  Metrics* metrics,
+  const char* const wait_statistic,
+  const char* const hold_statistic)
+: _lock(mutex, std::defer_lock),
+  _metrics(metrics),
+  _hold_statistic(hold_statistic)
+{
+  if (!_metrics)
+  {
+    _lock.lock();
+    return;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  _lock.lock();
+  _acquired = std::chrono::steady_clock::now();
+  _metrics->record(wait_statistic, _acquired - start);
+}
+
+//==============================================================================
+TimedLock::~TimedLock()
+{
+  if (_metrics)
+    _metrics->record(
+      _hold_statistic, std::chrono::steady_clock::now() - _acquired);
+}
+
+//==============================================================================
+ScopeTimer::ScopeTimer(Metrics* metrics, const char* const statistic)
+: _metrics(metrics),
+  _statistic(statistic)
+{
+  if (_metrics)
+    _start = std::chrono::steady_clock::now();
+}
+
+//==============================================================================
+ScopeTimer::~ScopeTimer()
+{
+  if (_metrics)
+    _metrics->record(_statistic, std::chrono::steady_clock::now() - _start);
+}
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
@@ -15,10 +15,19 @@
  *
 */
 
+#include "internal_CompactMirrorUpdate.hpp"
+#include "internal_Metrics.hpp"
+#include "internal_PatchHandoff.hpp"
+#include "internal_WorkerPool.hpp"
+
+#include <atomic>
 #include <chrono>
+#include <functional>
+#include <optional>
 
 #include <rclcpp/logger.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <rclcpp/serialization.hpp>
 
 #include <rmf_utils/Modular.hpp>
 
@@ -49,6 +58,8 @@ using ParticipantsInfoSub = rclcpp::Subscription<ParticipantsInfo>::SharedPtr;
 
 using MirrorUpdate = rmf_traffic_msgs::msg::MirrorUpdate;
 using MirrorUpdateSub = rclcpp::Subscription<MirrorUpdate>::SharedPtr;
+using CompactMirrorUpdateSub =
+  rclcpp::Subscription<CompactMirrorUpdate>::SharedPtr;
 
 using RequestChanges = rmf_traffic_msgs::srv::RequestChanges;
 using RequestChangesFuture = rclcpp::Client<RequestChanges>::SharedFuture;
@@ -78,10 +89,11 @@ public:
   uint64_t query_id;
   rmf_traffic_msgs::msg::ScheduleIdentity schedule_node_id;
   bool require_query_validation = false;
-  std::list<MirrorUpdate::SharedPtr> stashed_query_updates;
+  std::list<MirrorUpdate::ConstSharedPtr> stashed_query_updates;
   Options options;
   ScheduleIdentitySub schedule_startup_sub;
   MirrorUpdateSub mirror_update_sub;
+  CompactMirrorUpdateSub compact_update_sub;
   ParticipantsInfoSub participants_info_sub;
   rclcpp::Subscription<ScheduleQueries>::SharedPtr queries_info_sub;
   RequestChangesClient request_changes_client;
@@ -92,10 +104,59 @@ public:
 
   std::shared_ptr<rmf_traffic::schedule::Mirror> mirror;
 
+  // The latest published snapshot of the mirror. This must only be accessed
+  // with std::atomic_load and std::atomic_store so that readers never need to
+  // lock the update mutex.
+  mutable std::shared_ptr<const rmf_traffic::schedule::Snapshot>
+  latest_snapshot;
+
+  // Snapshots only get published after the first one has been requested.
+  mutable std::atomic_bool snapshots_requested{false};
+
+  // The latest version of the mirror that readers see. When async updates are
+  // turned on, update_worker swaps the contents of the mirror, so anything
+  // that is not holding the update mutex must read the version from here
+  // instead of from the mirror. Only the thread that changed the mirror may
+  // call store_mirror_version().
+  std::atomic<uint64_t> visible_version{0};
+  std::atomic_bool has_visible_version{false};
+
+  // When async updates are turned on, changes get applied to this staging
+  // mirror by update_worker, and then the staging mirror gets swapped with the
+  // mirror that readers see. The changes that were applied since the last
+  // swap are kept so that they can be replayed onto the old mirror, which
+  // becomes the next staging mirror. These are only touched by update_worker.
+  using MirrorChange = std::function<void(rmf_traffic::schedule::Mirror&)>;
+  std::unique_ptr<rmf_traffic::schedule::Mirror> staging_mirror;
+  std::vector<MirrorChange> unswapped_changes;
+  std::chrono::steady_clock::time_point last_swap_time;
+  std::atomic_bool swap_pending{false};
+
+  // The worker cannot use the service clients, so it leaves its requests for
+  // updates here to be sent by async_update_timer. The inner optional is the
+  // minimum version that should be requested.
+  std::mutex async_update_request_mutex;
+  std::optional<std::optional<uint64_t>> async_update_request;
+  rclcpp::TimerBase::SharedPtr async_update_timer;
+
   bool initial_update = true;
 
   rmf_traffic::schedule::Version next_minimum_version = 0;
 
+  // These are only used if statistics are turned on. The metrics are thread
+  // safe so that the update worker can also record into them.
+  using MetricsMsg = statistics_msgs::msg::MetricsMessage;
+  std::shared_ptr<Metrics> metrics;
+  rclcpp::Serialization<MirrorUpdate> update_serialization;
+  std::atomic<uint64_t> latest_seen_version{0};
+  std::atomic_bool has_seen_version{false};
+  rclcpp::Publisher<MetricsMsg>::SharedPtr diagnostics_pub;
+  rclcpp::TimerBase::SharedPtr diagnostics_timer;
+
+  // This is declared last so that the worker gets stopped before any of the
+  // fields that it uses are destructed.
+  std::unique_ptr<WorkerPool> update_worker;
+
   Implementation(
     const std::shared_ptr<rclcpp::Node>& node,
     rmf_traffic::schedule::Query _query,
@@ -109,6 +170,13 @@ public:
     options(std::move(_options)),
     mirror(std::make_shared<rmf_traffic::schedule::Mirror>())
   {
+    // The worker and the metrics need to exist before any updates can arrive
+    if (options.statistics())
+      setup_statistics(*node);
+
+    if (options.async_updates())
+      setup_async_updates(*node);
+
     setup_update_topics();
     setup_queries_sub();
 
@@ -124,6 +192,315 @@ public:
       });
   }
 
+  void setup_statistics(rclcpp::Node& node)
+  {
+    metrics = std::make_shared<Metrics>("mirror");
+    metrics->add_statistic(
+      "patch_apply_time", "seconds", Metrics::duration_buckets());
+    metrics->add_statistic(
+      "version_lag", "versions", Metrics::size_buckets());
+
+    for (const auto* name : {
+        "updates_received",
+        "remedial_updates",
+        "failed_updates",
+        "update_requests",
+        "update_timeouts",
+        "stashed_updates",
+        "processed_stashed_updates",
+        "bytes_received"
+      })
+    {
+      metrics->add_counter(name);
+    }
+
+    const auto period = options.diagnostics_period();
+    if (period <= rmf_traffic::Duration(0))
+      return;
+
+    diagnostics_pub = node.create_publisher<MetricsMsg>(
+      MirrorDiagnosticsTopicName,
+      rclcpp::SystemDefaultsQoS().reliable().keep_last(100));
+
+    diagnostics_timer = node.create_wall_timer(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(period),
+      [this]()
+      {
+        const auto node = weak_node.lock();
+        if (!node)
+          return;
+
+        for (auto& msg : metrics->flush(node->now()))
+        {
+          msg.measurement_source_name =
+            node->get_fully_qualified_name() + std::string("/query_")
+            + std::to_string(query_id);
+          diagnostics_pub->publish(msg);
+        }
+      });
+  }
+
+  // The wire size only needs to be given if the update did not arrive in the
+  // regular format.
+  void record_received(
+    const MirrorUpdate& msg,
+    std::optional<std::size_t> wire_size = std::nullopt)
+  {
+    if (!metrics)
+      return;
+
+    metrics->increment("updates_received");
+    if (msg.is_remedial_update)
+      metrics->increment("remedial_updates");
+
+    if (!wire_size.has_value())
+    {
+      rclcpp::SerializedMessage serialized;
+      update_serialization.serialize_message(&msg, &serialized);
+      wire_size = serialized.size();
+    }
+    metrics->increment("bytes_received", *wire_size);
+
+    if (!has_seen_version
+      || rmf_utils::modular(latest_seen_version.load())
+      .less_than(msg.database_version))
+    {
+      latest_seen_version = msg.database_version;
+      has_seen_version = true;
+    }
+  }
+
+  void record_applied(std::chrono::steady_clock::duration apply_time)
+  {
+    if (!metrics)
+      return;
+
+    metrics->record("patch_apply_time", apply_time);
+  }
+
+  // This should be called whenever the version of the mirror that readers see
+  // has changed.
+  void record_version_lag() const
+  {
+    if (!metrics || !has_seen_version)
+      return;
+
+    metrics->record("version_lag", static_cast<double>(current_lag()));
+  }
+
+  void store_mirror_version()
+  {
+    const auto version = mirror->latest_version();
+    if (version.has_value())
+      visible_version = *version;
+
+    has_visible_version = version.has_value();
+  }
+
+  std::optional<uint64_t> load_mirror_version() const
+  {
+    if (!has_visible_version)
+      return std::nullopt;
+
+    return visible_version.load();
+  }
+
+  uint64_t current_lag() const
+  {
+    const auto seen = latest_seen_version.load();
+    const auto current = load_mirror_version();
+    if (!current.has_value())
+      return seen;
+
+    if (rmf_utils::modular(*current).less_than(seen))
+      return seen - *current;
+
+    return 0;
+  }
+
+  void increment(const std::string& counter) const
+  {
+    if (metrics)
+      metrics->increment(counter);
+  }
+
+  std::optional<Statistics> get_statistics() const
+  {
+    if (!metrics)
+      return std::nullopt;
+
+    Statistics stats;
+    if (has_seen_version)
+    {
+      stats.latest_seen_version = latest_seen_version.load();
+      stats.version_lag = current_lag();
+    }
+
+    stats.mirror_version = load_mirror_version();
+    stats.updates_received = metrics->counter("updates_received");
+    stats.remedial_updates = metrics->counter("remedial_updates");
+    stats.failed_updates = metrics->counter("failed_updates");
+    stats.update_requests = metrics->counter("update_requests");
+    stats.update_timeouts = metrics->counter("update_timeouts");
+    stats.stashed_updates = metrics->counter("stashed_updates");
+    stats.processed_stashed_updates =
+      metrics->counter("processed_stashed_updates");
+    stats.bytes_received = metrics->counter("bytes_received");
+    stats.patches_applied = metrics->cumulative_count("patch_apply_time");
+    stats.total_apply_time =
+      std::chrono::duration_cast<rmf_traffic::Duration>(
+      std::chrono::duration<double>(
+        metrics->cumulative_sum("patch_apply_time")));
+
+    return stats;
+  }
+
+  void setup_async_updates(rclcpp::Node& node)
+  {
+    staging_mirror = std::make_unique<rmf_traffic::schedule::Mirror>(*mirror);
+    update_worker = std::make_unique<WorkerPool>(1);
+
+    const auto interval = options.minimum_swap_interval();
+    const auto timer_period = interval > rmf_traffic::Duration(0) ?
+      std::chrono::duration_cast<std::chrono::nanoseconds>(interval) :
+      std::chrono::nanoseconds(100ms);
+
+    async_update_timer = node.create_wall_timer(
+      timer_period,
+      [this]()
+      {
+        if (swap_pending)
+          update_worker->post(0, [this]() { swap_staging_mirror(); });
+
+        std::optional<std::optional<uint64_t>> request;
+        {
+          std::lock_guard<std::mutex> lock(async_update_request_mutex);
+          std::swap(request, async_update_request);
+        }
+
+        if (request.has_value())
+          request_update(*request);
+      });
+  }
+
+  // Apply a change to the staging mirror and swap it in if enough time has
+  // passed since the last swap. This must only be called by update_worker.
+  void stage_change(MirrorChange change)
+  {
+    change(*staging_mirror);
+    record_staged_change(std::move(change));
+  }
+
+  // Remember a change that has already been applied to the staging mirror,
+  // and swap it in if enough time has passed since the last swap. This must
+  // only be called by update_worker.
+  void record_staged_change(MirrorChange change)
+  {
+    unswapped_changes.emplace_back(std::move(change));
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - last_swap_time < options.minimum_swap_interval())
+    {
+      swap_pending = true;
+      return;
+    }
+
+    swap_staging_mirror();
+  }
+
+  // This must only be called by update_worker.
+  void swap_staging_mirror()
+  {
+    swap_pending = false;
+    if (unswapped_changes.empty())
+      return;
+
+    {
+      std::mutex* update_mutex = options.update_mutex();
+      std::unique_lock<std::mutex> lock;
+      if (update_mutex)
+        lock = std::unique_lock<std::mutex>(*update_mutex);
+
+      // Swapping the contents instead of the pointers means that anyone who
+      // is holding onto view() will see the new version.
+      std::swap(*mirror, *staging_mirror);
+      store_mirror_version();
+      publish_snapshot();
+    }
+    record_version_lag();
+
+    // Bring the old version up to date so it can be the next staging mirror
+    for (const auto& change : unswapped_changes)
+      change(*staging_mirror);
+
+    unswapped_changes.clear();
+    last_swap_time = std::chrono::steady_clock::now();
+  }
+
+  void request_update_from_worker(std::optional<uint64_t> minimum_version)
+  {
+    std::lock_guard<std::mutex> lock(async_update_request_mutex);
+    if (async_update_request.has_value()
+      && !async_update_request->has_value())
+    {
+      // A full update has already been requested
+      return;
+    }
+
+    async_update_request = minimum_version;
+  }
+
+  // This must only be called by update_worker.
+  void apply_patch_async(const MirrorUpdate::ConstSharedPtr& msg)
+  {
+    const auto node = weak_node.lock();
+    if (!node)
+      return;
+
+    PatchHandoff::PatchPtr patch;
+    try
+    {
+      patch = PatchHandoff::get().find(query_id, *msg);
+      if (!patch)
+      {
+        patch = std::make_shared<rmf_traffic::schedule::Patch>(
+          convert(msg->patch));
+      }
+    }
+    catch (const std::exception& e)
+    {
+      RCLCPP_ERROR(
+        node->get_logger(),
+        "[rmf_traffic_ros2::MirrorManager] Failed to deserialize Patch "
+        "message: %s",
+        e.what());
+      increment("failed_updates");
+      request_update_from_worker(std::nullopt);
+      return;
+    }
+
+    const auto apply_start = std::chrono::steady_clock::now();
+    const bool applied = staging_mirror->update(*patch);
+    record_applied(std::chrono::steady_clock::now() - apply_start);
+    if (!applied)
+    {
+      increment("failed_updates");
+      if (!msg->is_remedial_update)
+      {
+        RCLCPP_WARN(
+          node->get_logger(),
+          "Failed to update using patch for DB version %lu; requesting new "
+          "update",
+          patch->latest_version());
+        request_update_from_worker(staging_mirror->latest_version());
+      }
+      return;
+    }
+
+    record_staged_change(
+      [patch](rmf_traffic::schedule::Mirror& m) { m.update(*patch); });
+  }
+
   bool reconnect_schedule(
     const rmf_traffic_msgs::msg::ScheduleIdentity& node_id)
   {
@@ -251,15 +628,35 @@ public:
         handle_participants_info(msg);
       });
 
-    RCLCPP_INFO(node->get_logger(), "Registering to query topic %s",
-      (QueryUpdateTopicNameBase + std::to_string(query_id)).c_str());
-    mirror_update_sub = node->create_subscription<MirrorUpdate>(
-      QueryUpdateTopicNameBase + std::to_string(query_id),
-      rclcpp::ServicesQoS().reliable().keep_last(5000),
-      [this](const MirrorUpdate::SharedPtr msg)
-      {
-        handle_update(msg);
-      });
+    const std::string topic =
+      QueryUpdateTopicNameBase + std::to_string(query_id);
+    if (options.compact_updates())
+    {
+      RCLCPP_INFO(node->get_logger(), "Registering to compact query topic %s",
+        (topic + CompactMirrorUpdateTopicSuffix).c_str());
+      compact_update_sub = node->create_subscription<CompactMirrorUpdate>(
+        topic + CompactMirrorUpdateTopicSuffix,
+        rclcpp::ServicesQoS().reliable().keep_last(5000),
+        [this](CompactMirrorUpdate::ConstSharedPtr msg)
+        {
+          handle_compact_update(*msg);
+        });
+    }
+    else
+    {
+      RCLCPP_INFO(node->get_logger(), "Registering to query topic %s",
+        topic.c_str());
+      mirror_update_sub = node->create_subscription<MirrorUpdate>(
+        topic,
+        rclcpp::ServicesQoS().reliable().keep_last(5000),
+        [this](MirrorUpdate::ConstSharedPtr msg)
+        {
+          // Taking a const shared pointer allows intra-process subscriptions
+          // to share one message instead of each receiving its own copy.
+          record_received(*msg);
+          handle_update(std::move(msg));
+        });
+    }
 
     // At this point we know we have the correct ID for our query
     require_query_validation = false;
@@ -278,6 +675,35 @@ public:
     if (!validate_meta_update(msg->node_id))
       return;
 
+    if (update_worker)
+    {
+      update_worker->post(
+        0, [this, msg]()
+        {
+          try
+          {
+            const auto info = convert(*msg);
+            stage_change(
+              [info](rmf_traffic::schedule::Mirror& m)
+              {
+                m.update_participants_info(info);
+              });
+          }
+          catch (const std::exception& e)
+          {
+            if (const auto node = weak_node.lock())
+            {
+              RCLCPP_ERROR(
+                node->get_logger(),
+                "[rmf_traffic_ros2::MirrorManager] Failed to update "
+                "participant info: %s",
+                e.what());
+            }
+          }
+        });
+      return;
+    }
+
     try
     {
       std::mutex* update_mutex = options.update_mutex();
@@ -285,10 +711,12 @@ public:
       {
         std::lock_guard<std::mutex> lock(*update_mutex);
         mirror->update_participants_info(convert(*msg));
+        publish_snapshot();
       }
       else
       {
         mirror->update_participants_info(convert(*msg));
+        publish_snapshot();
       }
     }
     catch (const std::exception& e)
@@ -303,6 +731,39 @@ public:
     }
   }
 
+  // Publish a snapshot of the current state of the mirror if anyone is
+  // reading snapshots. This should be called while the update mutex is locked,
+  // right after the mirror has been changed.
+  void publish_snapshot() const
+  {
+    if (!snapshots_requested)
+      return;
+
+    std::atomic_store(&latest_snapshot, mirror->snapshot());
+  }
+
+  std::shared_ptr<const rmf_traffic::schedule::Snapshot> get_snapshot() const
+  {
+    auto current = std::atomic_load(&latest_snapshot);
+    if (current)
+      return current;
+
+    // This is the first request for a snapshot, so we need to make sure that
+    // the mirror is not being updated while we take it.
+    std::mutex* update_mutex = options.update_mutex();
+    std::unique_lock<std::mutex> lock;
+    if (update_mutex)
+      lock = std::unique_lock<std::mutex>(*update_mutex);
+
+    current = std::atomic_load(&latest_snapshot);
+    if (current)
+      return current;
+
+    snapshots_requested = true;
+    publish_snapshot();
+    return std::atomic_load(&latest_snapshot);
+  }
+
   void process_stashed_queries()
   {
     const auto node = weak_node.lock();
@@ -310,6 +771,12 @@ public:
       return;
 
     RCLCPP_DEBUG(node->get_logger(), "Processing stashed queries");
+    if (metrics)
+    {
+      metrics->increment(
+        "processed_stashed_updates", stashed_query_updates.size());
+    }
+
     for (auto&& msg: stashed_query_updates)
     {
       RCLCPP_DEBUG(
@@ -329,11 +796,17 @@ public:
 
   void apply_patch(
     const std::shared_ptr<rclcpp::Node>& node,
-    const rmf_traffic_msgs::msg::SchedulePatch& msg,
+    const rmf_traffic::schedule::Patch& patch,
     const bool is_remedial)
   {
-    const rmf_traffic::schedule::Patch patch = convert(msg);
-    if (!mirror->update(patch) && !is_remedial)
+    const auto apply_start = std::chrono::steady_clock::now();
+    const bool applied = mirror->update(patch);
+    record_applied(std::chrono::steady_clock::now() - apply_start);
+    store_mirror_version();
+    if (!applied)
+      increment("failed_updates");
+
+    if (!applied && !is_remedial)
     {
       std::string patch_base = patch.base_version() ?
         std::to_string(*patch.base_version()) : std::string("any");
@@ -348,10 +821,14 @@ public:
         patch_base.c_str());
 
       request_update(mirror->latest_version());
+      return;
     }
+
+    publish_snapshot();
+    record_version_lag();
   }
 
-  void handle_update(const MirrorUpdate::SharedPtr msg)
+  void handle_update(const MirrorUpdate::ConstSharedPtr& msg)
   {
     update_timer->reset();
     const auto node = weak_node.lock();
@@ -390,22 +867,40 @@ public:
         "Stashing suspect query for DB version %lu",
         msg->patch.latest_version);
       stashed_query_updates.push_back(msg);
+      increment("stashed_updates");
+      return;
+    }
+
+    if (update_worker)
+    {
+      update_worker->post(
+        0, [this, msg]() { apply_patch_async(msg); });
       return;
     }
 
     try
     {
-      const rmf_traffic::schedule::Patch patch = convert(msg->patch);
+      // If this mirror shares a process with the schedule node, the patch
+      // that produced this message may still be in memory, in which case we
+      // can skip decoding it. Otherwise decode the message before locking the
+      // mutex so that other users of the mirror are not blocked while the
+      // conversion is happening.
+      const auto handoff = PatchHandoff::get().find(query_id, *msg);
+      std::optional<rmf_traffic::schedule::Patch> decoded;
+      if (!handoff)
+        decoded = convert(msg->patch);
+
+      const rmf_traffic::schedule::Patch& patch = handoff ? *handoff : *decoded;
 
       std::mutex* update_mutex = options.update_mutex();
       if (update_mutex)
       {
         std::lock_guard<std::mutex> lock(*update_mutex);
-        apply_patch(node, msg->patch, msg->is_remedial_update);
+        apply_patch(node, patch, msg->is_remedial_update);
       }
       else
       {
-        apply_patch(node, msg->patch, msg->is_remedial_update);
+        apply_patch(node, patch, msg->is_remedial_update);
       }
     }
     catch (const std::exception& e)
@@ -415,21 +910,50 @@ public:
         "[rmf_traffic_ros2::MirrorManager] Failed to deserialize Patch "
         "message: %s",
         e.what());
+      increment("failed_updates");
       // Get a full update in case we're just missing some information
       request_update();
     }
   }
 
+  void handle_compact_update(const CompactMirrorUpdate& compact)
+  {
+    MirrorUpdate::ConstSharedPtr msg;
+    try
+    {
+      msg = std::make_shared<const MirrorUpdate>(decode_compact(compact.data));
+    }
+    catch (const std::exception& e)
+    {
+      const auto node = weak_node.lock();
+      if (!node)
+        return;
+
+      RCLCPP_ERROR(
+        node->get_logger(),
+        "[rmf_traffic_ros2::MirrorManager] Failed to decode compact mirror "
+        "update: %s",
+        e.what());
+      increment("failed_updates");
+      request_update();
+      return;
+    }
+
+    record_received(*msg, compact.data.size());
+    handle_update(std::move(msg));
+  }
+
   void handle_update_timeout()
   {
     const auto node = weak_node.lock();
     if (!node)
       return;
 
+    increment("update_timeouts");
     RCLCPP_INFO(
       node->get_logger(),
       "Requesting new schedule update because update timed out");
-    request_update(mirror->latest_version());
+    request_update(load_mirror_version());
   }
 
   void request_update(std::optional<uint64_t> minimum_version = std::nullopt)
@@ -464,6 +988,7 @@ public:
 
     if (request_changes_client && request_changes_client->service_is_ready())
     {
+      increment("update_requests");
       request_changes_client->async_send_request(
         std::make_shared<RequestChanges::Request>(request),
         [this, minimum_version](const RequestChangesFuture response)
@@ -528,6 +1053,7 @@ public:
     // Make sure nothing is truly coming in on this topic and triggering a
     // callback while we are remaking it
     mirror_update_sub.reset();
+    compact_update_sub.reset();
     // Also make sure we don't try to handle another update of queries,
     // or it might cause a particularly icky cycle of never-ending redos
     queries_info_sub.reset();
@@ -595,7 +1121,20 @@ public:
   {
     register_query_client = nullptr;
     request_changes_client = nullptr;
-    mirror->reset();
+    if (update_worker)
+    {
+      update_worker->post(
+        0, [this]()
+        {
+          stage_change([](rmf_traffic::schedule::Mirror& m) { m.reset(); });
+        });
+    }
+    else
+    {
+      mirror->reset();
+      store_mirror_version();
+      publish_snapshot();
+    }
 
     const auto node = weak_node.lock();
     if (!node)
@@ -669,6 +1208,16 @@ public:
 
   bool update_on_wakeup;
 
+  bool async_updates = false;
+
+  rmf_traffic::Duration minimum_swap_interval = rmf_traffic::Duration(0);
+
+  bool statistics = false;
+
+  rmf_traffic::Duration diagnostics_period = rmf_traffic::Duration(0);
+
+  bool compact_updates = false;
+
 };
 
 //==============================================================================
@@ -710,6 +1259,79 @@ auto MirrorManager::Options::update_on_wakeup(bool choice) -> Options&
   return *this;
 }
 
+//==============================================================================
+bool MirrorManager::Options::async_updates() const
+{
+  return _pimpl->async_updates;
+}
+
+//==============================================================================
+auto MirrorManager::Options::async_updates(bool choice) -> Options&
+{
+  _pimpl->async_updates = choice;
+  return *this;
+}
+
+//==============================================================================
+rmf_traffic::Duration MirrorManager::Options::minimum_swap_interval() const
+{
+  return _pimpl->minimum_swap_interval;
+}
+
+//==============================================================================
+auto MirrorManager::Options::minimum_swap_interval(
+  rmf_traffic::Duration interval) -> Options&
+{
+  _pimpl->minimum_swap_interval = interval;
+  return *this;
+}
+
+//==============================================================================
+bool MirrorManager::Options::statistics() const
+{
+  return _pimpl->statistics;
+}
+
+//==============================================================================
+auto MirrorManager::Options::statistics(bool choice) -> Options&
+{
+  _pimpl->statistics = choice;
+  return *this;
+}
+
+//==============================================================================
+rmf_traffic::Duration MirrorManager::Options::diagnostics_period() const
+{
+  return _pimpl->diagnostics_period;
+}
+
+//==============================================================================
+auto MirrorManager::Options::diagnostics_period(
+  rmf_traffic::Duration period) -> Options&
+{
+  _pimpl->diagnostics_period = period;
+  return *this;
+}
+
+//==============================================================================
+bool MirrorManager::Options::compact_updates() const
+{
+  return _pimpl->compact_updates;
+}
+
+//==============================================================================
+auto MirrorManager::Options::compact_updates(bool choice) -> Options&
+{
+  _pimpl->compact_updates = choice;
+  return *this;
+}
+
+//==============================================================================
+auto MirrorManager::statistics() const -> std::optional<Statistics>
+{
+  return _pimpl->get_statistics();
+}
+
 //==============================================================================
 std::shared_ptr<const rmf_traffic::schedule::Mirror>
 MirrorManager::view() const
@@ -717,10 +1339,17 @@ MirrorManager::view() const
   return _pimpl->mirror;
 }
 
+//==============================================================================
+std::shared_ptr<const rmf_traffic::schedule::Snapshot>
+MirrorManager::snapshot() const
+{
+  return _pimpl->get_snapshot();
+}
+
 //==============================================================================
 void MirrorManager::update()
 {
-  _pimpl->request_update(_pimpl->mirror->latest_version());
+  _pimpl->request_update(_pimpl->load_mirror_version());
 }
 
 //==============================================================================
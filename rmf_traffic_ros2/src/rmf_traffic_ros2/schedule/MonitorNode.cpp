@@ -24,6 +24,8 @@
 
 #include <rclcpp/executors.hpp>
 
+#include <algorithm>
+
 namespace rmf_traffic_ros2 {
 namespace schedule {
 
@@ -56,8 +58,23 @@ void MonitorNode::setup()
   heartbeat_period = std::chrono::milliseconds(
     get_parameter("heartbeat_period").as_int());
 
+  // In hot standby mode the monitor also listens to itinerary changes so that
+  // it can take over without losing any changes that were in flight.
+  declare_parameter<bool>("hot_standby", false);
+  hot_standby = get_parameter("hot_standby").as_bool();
+
+  // How long, in milliseconds, to keep itinerary changes for replaying in hot
+  // standby mode. This should be comfortably longer than the time it takes
+  // for a change to show up in a mirror update.
+  declare_parameter<int>("hot_standby_replay_window", 5000);
+  hot_standby_replay_window = std::chrono::milliseconds(
+    std::max<int64_t>(0, get_parameter("hot_standby_replay_window").as_int()));
+
   start_heartbeat_listener();
   start_data_synchronisers();
+
+  if (hot_standby)
+    start_itinerary_listeners();
 }
 
 //==============================================================================
@@ -89,14 +106,16 @@ void MonitorNode::start_heartbeat_listener()
         get_logger(),
         "  not_alive_count_change: %d",
         event.not_alive_count_change);
-      if ( // The ideal pattern is 0, -1, 1, 1
-        event.alive_count == 0 && event.alive_count_change < 0 &&
-        event.not_alive_count > 0 && event.not_alive_count_change > 0)
+      // The ideal pattern for a crash is 0, -1, 1, 1, but a primary whose
+      // writer gets destroyed before its lease runs out only reports 0, -1,
+      // 0, 0. Either way nothing is left to keep the schedule running, so
+      // take over as soon as the last alive primary is gone.
+      if (event.alive_count == 0 && event.alive_count_change < 0)
       {
         RCLCPP_ERROR(
           get_logger(),
           "Detected death of primary schedule node");
-        on_fail_over_callback(create_new_schedule_node());
+        fail_over();
       }
     };
   heartbeat_sub = create_subscription<Heartbeat>(
@@ -141,6 +160,133 @@ void MonitorNode::start_data_synchronisers()
     });
 }
 
+//==============================================================================
+void MonitorNode::start_itinerary_listeners()
+{
+  // This must match the QoS that ScheduleNode uses for these topics
+  const auto itinerary_qos =
+    rclcpp::SystemDefaultsQoS()
+    .reliable()
+    .keep_last(100);
+
+  itinerary_set_sub =
+    create_subscription<ScheduleNode::ItinerarySet>(
+    rmf_traffic_ros2::ItinerarySetTopicName,
+    itinerary_qos,
+    [=](ScheduleNode::ItinerarySet::UniquePtr msg)
+    {
+      this->buffer_itinerary_change(std::move(*msg));
+    });
+
+  itinerary_extend_sub =
+    create_subscription<ScheduleNode::ItineraryExtend>(
+    rmf_traffic_ros2::ItineraryExtendTopicName,
+    itinerary_qos,
+    [=](ScheduleNode::ItineraryExtend::UniquePtr msg)
+    {
+      this->buffer_itinerary_change(std::move(*msg));
+    });
+
+  itinerary_delay_sub =
+    create_subscription<ScheduleNode::ItineraryDelay>(
+    rmf_traffic_ros2::ItineraryDelayTopicName,
+    itinerary_qos,
+    [=](ScheduleNode::ItineraryDelay::UniquePtr msg)
+    {
+      this->buffer_itinerary_change(std::move(*msg));
+    });
+
+  itinerary_reached_sub =
+    create_subscription<ScheduleNode::ItineraryReached>(
+    rmf_traffic_ros2::ItineraryReachedTopicName,
+    itinerary_qos,
+    [=](ScheduleNode::ItineraryReached::UniquePtr msg)
+    {
+      this->buffer_itinerary_change(std::move(*msg));
+    });
+
+  itinerary_clear_sub =
+    create_subscription<ScheduleNode::ItineraryClear>(
+    rmf_traffic_ros2::ItineraryClearTopicName,
+    itinerary_qos,
+    [=](ScheduleNode::ItineraryClear::UniquePtr msg)
+    {
+      this->buffer_itinerary_change(std::move(*msg));
+    });
+
+  RCLCPP_INFO(
+    get_logger(),
+    "Hot standby enabled with a replay window of %ld ms",
+    std::chrono::duration_cast<std::chrono::milliseconds>(
+      hot_standby_replay_window).count());
+}
+
+//==============================================================================
+void MonitorNode::buffer_itinerary_change(ScheduleNode::ItineraryChange change)
+{
+  const auto now = std::chrono::steady_clock::now();
+  itinerary_replay_buffer.push_back({now, std::move(change)});
+
+  while (!itinerary_replay_buffer.empty()
+    && itinerary_replay_buffer.front().received_time
+    + hot_standby_replay_window < now)
+  {
+    itinerary_replay_buffer.pop_front();
+  }
+}
+
+//==============================================================================
+void MonitorNode::replay_itinerary_changes(ScheduleNode& node)
+{
+  if (itinerary_replay_buffer.empty())
+    return;
+
+  std::vector<ScheduleNode::ItineraryChange> changes;
+  changes.reserve(itinerary_replay_buffer.size());
+  for (auto& buffered : itinerary_replay_buffer)
+    changes.emplace_back(std::move(buffered.change));
+
+  itinerary_replay_buffer.clear();
+
+  RCLCPP_INFO(
+    get_logger(),
+    "Replaying %lu buffered itinerary changes into the replacement schedule "
+    "node",
+    changes.size());
+
+  node.apply_itinerary_changes(changes);
+}
+
+//==============================================================================
+void MonitorNode::fail_over()
+{
+  // Liveliness events can keep arriving after the first one, but there must
+  // only ever be one replacement schedule node.
+  if (failed_over)
+    return;
+
+  failed_over = true;
+  const auto start = std::chrono::steady_clock::now();
+  auto node = create_new_schedule_node();
+  last_failover_duration = std::chrono::steady_clock::now() - start;
+
+  const auto duration_ms =
+    std::chrono::duration_cast<std::chrono::milliseconds>(
+    *last_failover_duration).count();
+  RCLCPP_INFO(
+    get_logger(),
+    "Replacement schedule node was ready %ld ms after the primary was lost",
+    duration_ms);
+
+  if (node)
+  {
+    // Let the failover time be inspected on the replacement node
+    node->declare_parameter<int64_t>("failover_duration_ms", duration_ms);
+  }
+
+  on_fail_over_callback(node);
+}
+
 //==============================================================================
 std::shared_ptr<rclcpp::Node> MonitorNode::create_new_schedule_node()
 {
@@ -149,6 +295,10 @@ std::shared_ptr<rclcpp::Node> MonitorNode::create_new_schedule_node()
     database,
     registered_queries,
     rclcpp::NodeOptions());
+
+  // The replacement node has not started spinning yet, so nothing else can
+  // touch its database while the changes are replayed.
+  replay_itinerary_changes(*node);
   return node;
 }
 
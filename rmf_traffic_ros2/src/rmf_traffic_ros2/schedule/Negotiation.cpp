@@ -16,10 +16,12 @@
 */
 
 #include "NegotiationRoom.hpp"
+#include "internal_NegotiationRecording.hpp"
 
 #include <rmf_traffic_ros2/Route.hpp>
 #include <rmf_traffic_ros2/schedule/Itinerary.hpp>
 #include <rmf_traffic_ros2/schedule/Negotiation.hpp>
+#include <rmf_traffic_ros2/schedule/ParticipantDescription.hpp>
 
 #include <rmf_traffic_ros2/StandardNames.hpp>
 
@@ -306,6 +308,42 @@ public:
   uint retained_history_count = 0;
   std::map<Version, rmf_traffic::schedule::Negotiation> history;
 
+  // If this is set, every negotiation message that we receive gets recorded.
+  // It is accessed atomically because recording can be started or stopped
+  // while the subscriptions are being serviced.
+  std::shared_ptr<NegotiationRecorder> recorder;
+
+  template<typename Message>
+  void record(const Message& msg)
+  {
+    if (const auto r = std::atomic_load(&recorder))
+      r->record(msg);
+  }
+
+  void record_notice(const Notice& msg)
+  {
+    const auto r = std::atomic_load(&recorder);
+    if (!r)
+      return;
+
+    // Record the descriptions of the participants first so that the replay
+    // can reconstruct the negotiation.
+    const auto snapshot = viewer->snapshot();
+    for (const auto p : msg.participants)
+    {
+      const auto* description = snapshot->get_participant(p);
+      if (!description)
+        continue;
+
+      NegotiationRecorder::Participant participant;
+      participant.id = p;
+      participant.description = rmf_traffic_ros2::convert(*description);
+      r->record(participant);
+    }
+
+    r->record(msg);
+  }
+
   Implementation(
     rclcpp::Node& node_,
     std::shared_ptr<const rmf_traffic::schedule::Snappable> viewer_,
@@ -333,6 +371,7 @@ public:
       NegotiationNoticeTopicName, qos,
       [&](const Notice::UniquePtr msg)
       {
+        this->record_notice(*msg);
         this->receive_notice(*msg);
       });
 
@@ -346,6 +385,7 @@ public:
       NegotiationProposalTopicName, qos,
       [&](const Proposal::UniquePtr msg)
       {
+        this->record(*msg);
         this->receive_proposal(*msg);
       });
 
@@ -356,6 +396,7 @@ public:
       NegotiationRejectionTopicName, qos,
       [&](const Rejection::UniquePtr msg)
       {
+        this->record(*msg);
         this->receive_rejection(*msg);
       });
 
@@ -366,6 +407,7 @@ public:
       NegotiationForfeitTopicName, qos,
       [&](const Forfeit::UniquePtr msg)
       {
+        this->record(*msg);
         this->receive_forfeit(*msg);
       });
 
@@ -376,6 +418,7 @@ public:
       NegotiationConclusionTopicName, qos,
       [&](const Conclusion::UniquePtr msg)
       {
+        this->record(*msg);
         this->receive_conclusion(*msg);
       });
 
@@ -1121,6 +1164,26 @@ rmf_traffic::Duration Negotiation::timeout_duration() const
   return _pimpl->timeout;
 }
 
+//==============================================================================
+Negotiation& Negotiation::record(const std::string& filename)
+{
+  std::shared_ptr<NegotiationRecorder> recorder;
+  if (!filename.empty())
+  {
+    recorder = NegotiationRecorder::make(filename);
+    if (!recorder)
+    {
+      RCLCPP_ERROR(
+        _pimpl->node.get_logger(),
+        "[rmf_traffic_ros2::schedule::Negotiation::record] Unable to open ["
+        "%s] for recording negotiations", filename.c_str());
+    }
+  }
+
+  std::atomic_store(&_pimpl->recorder, std::move(recorder));
+  return *this;
+}
+
 //==============================================================================
 Negotiation::TableViewPtr Negotiation::table_view(
   uint64_t conflict_version,
@@ -84,6 +84,7 @@ void NegotiationRoom::update_state_msg(
   using Negotiation = rmf_traffic::schedule::Negotiation;
   std::vector<Negotiation::ConstTablePtr> queue;
   std::unordered_map<Negotiation::ConstTablePtr, int64_t> table_index;
+  decltype(itinerary_msgs) current_itinerary_msgs;
 
   for (const auto p : negotiation.participants())
   {
@@ -117,11 +118,27 @@ void NegotiationRoom::update_state_msg(
 
     node.rejected = top->rejected();
     if (const auto* submission = top->submission())
-      node.itinerary = convert(*submission);
+    {
+      const auto cached = itinerary_msgs.find(top);
+      if (cached != itinerary_msgs.end()
+        && cached->second.first == top->version())
+      {
+        node.itinerary = cached->second.second;
+      }
+      else
+      {
+        node.itinerary = convert(*submission);
+      }
+
+      current_itinerary_msgs[top] = {top->version(), node.itinerary};
+    }
 
     state_msg.tree.push_back(std::move(node));
   }
 
+  // Only keep the conversions of tables that still have a submission
+  itinerary_msgs = std::move(current_itinerary_msgs);
+
   for (const auto& proposal : cached_proposals)
     state_msg.orphan_proposals.push_back(proposal);
 
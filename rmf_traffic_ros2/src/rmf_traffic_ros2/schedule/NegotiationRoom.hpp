@@ -25,8 +25,10 @@
 #include <rmf_traffic_msgs/msg/negotiation_forfeit.hpp>
 #include <rmf_traffic_msgs/msg/negotiation_key.hpp>
 #include <rmf_traffic_msgs/msg/negotiation_state.hpp>
+#include <rmf_traffic_msgs/msg/route.hpp>
 
 #include <list>
+#include <unordered_map>
 
 namespace rmf_traffic_ros2 {
 
@@ -57,6 +59,15 @@ struct NegotiationRoom
 
   rmf_traffic_msgs::msg::NegotiationState state_msg;
 
+  // The converted submission of each table, along with the table version that
+  // it was converted from. This lets update_state_msg skip converting the
+  // itineraries of tables that have not changed since the last update.
+  using ItineraryMsg = std::vector<rmf_traffic_msgs::msg::Route>;
+  std::unordered_map<
+    rmf_traffic::schedule::Negotiation::ConstTablePtr,
+    std::pair<rmf_traffic::schedule::Version, ItineraryMsg>
+  > itinerary_msgs;
+
   void update_state_msg(
     uint64_t conflict_version,
     rmf_traffic::Time start_time,
@@ -16,7 +16,12 @@
 */
 
 #include "internal_Node.hpp"
+#include "internal_PatchHandoff.hpp"
+#include "internal_RouteBounds.hpp"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
 #include <cstring>
 
 #include <rmf_traffic_ros2/Route.hpp>
@@ -36,6 +41,10 @@
 
 #include <rmf_utils/optional.hpp>
 
+#include <fstream>
+#include <future>
+#include <map>
+#include <type_traits>
 #include <unordered_map>
 #include <uuid/uuid.h>
 
@@ -72,12 +81,137 @@ std::string generate_schedule_node_name(const ScheduleNode::ScheduleId& id)
 
   return "rmf_traffic_schedule_node_" + uuid_underscore;
 }
+
+//==============================================================================
+// Get the maps that a query is restricted to, or std::nullopt if the query can
+// see routes on every map.
+std::optional<std::unordered_set<std::string>> get_query_maps(
+  const rmf_traffic::schedule::Query& query)
+{
+  using Mode = rmf_traffic::schedule::Query::Spacetime::Mode;
+  const auto& spacetime = query.spacetime();
+  const auto mode = spacetime.get_mode();
+  if (Mode::Regions == mode)
+  {
+    std::unordered_set<std::string> maps;
+    for (const auto& region : *spacetime.regions())
+      maps.insert(region.get_map());
+
+    return maps;
+  }
+
+  if (Mode::Timespan == mode)
+  {
+    const auto* timespan = spacetime.timespan();
+    if (timespan->all_maps())
+      return std::nullopt;
+
+    return timespan->maps();
+  }
+
+  return std::nullopt;
+}
 }
 
 //==============================================================================
-std::vector<ScheduleNode::ConflictSet> get_conflicts(
-  const rmf_traffic::schedule::Viewer::View& view_changes,
-  const rmf_traffic::schedule::ItineraryViewer& viewer)
+namespace {
+//==============================================================================
+// The routes that one participant has on a single map
+struct ParticipantRoutes
+{
+  ScheduleNode::ParticipantId participant;
+  rmf_traffic::PlanId plan_id;
+  std::shared_ptr<const rmf_traffic::schedule::ParticipantDescription>
+  description;
+  double radius;
+  std::vector<std::pair<std::size_t, rmf_traffic::ConstRoutePtr>> routes;
+};
+
+//==============================================================================
+// All of the changes and all of the existing routes for one map. Routes on
+// different maps can never conflict, so each shard can be checked separately.
+struct MapShard
+{
+  std::vector<const ScheduleNode::ChangedRoute*> changes;
+  std::vector<ParticipantRoutes> participants;
+};
+
+// std::map is used so that the shards are always visited in the same order
+using MapShards = std::map<std::string, MapShard>;
+
+//==============================================================================
+MapShards make_shards(
+  const ScheduleNode::ChangedRoutes& view_changes,
+  const rmf_traffic::schedule::ItineraryViewer& viewer,
+  RouteBoundsCache& bounds)
+{
+  MapShards shards;
+  for (const auto& vc : view_changes)
+  {
+    // Make sure the bounds of every route are available before any checking
+    // begins, so that the cache is only read while the workers are running.
+    bounds.insert(vc.route);
+    shards[vc.route->map()].changes.push_back(&vc);
+  }
+
+  for (const auto participant : viewer.participant_ids())
+  {
+    const auto description = viewer.get_participant(participant);
+    if (!description)
+      continue;
+
+    const auto itinerary = viewer.get_itinerary(participant);
+    if (!itinerary.has_value())
+      continue;
+
+    const auto plan_id = *viewer.get_current_plan_id(participant);
+    const double radius = profile_radius(description->profile());
+    for (std::size_t r = 0; r < itinerary->size(); ++r)
+    {
+      const auto& route = (*itinerary)[r];
+      assert(route);
+      const auto shard_it = shards.find(route->map());
+      if (shard_it == shards.end())
+        continue;
+
+      bounds.insert(route);
+      auto& participants = shard_it->second.participants;
+      if (participants.empty()
+        || participants.back().participant != participant)
+      {
+        participants.push_back(
+          ParticipantRoutes{participant, plan_id, description, radius, {}});
+      }
+
+      participants.back().routes.push_back({r, route});
+    }
+  }
+
+  return shards;
+}
+
+//==============================================================================
+// The conflicts that were found within the horizon, and the changed routes
+// that need to be checked again when the horizon reaches the given time.
+struct ShardConflicts
+{
+  std::vector<RouteConflict> conflicts;
+  std::vector<std::pair<const ScheduleNode::ChangedRoute*, rmf_traffic::Time>>
+  deferred;
+
+  // Pairs of routes whose conflict detection threw an exception
+  std::size_t failed_checks = 0;
+  std::string last_error;
+};
+
+//==============================================================================
+ShardConflicts get_conflicts(
+  const MapShard& shard,
+  const RouteBoundsCache& bounds,
+  const std::size_t participants_begin,
+  const std::size_t participants_end,
+  const std::optional<rmf_traffic::Time> horizon_end,
+  const rmf_traffic::Duration recheck_step)
 {
   const auto is_unresponsive = [](
     const rmf_traffic::schedule::ParticipantDescription& desc) -> bool
@@ -86,17 +220,34 @@ std::vector<ScheduleNode::ConflictSet> get_conflicts(
         == rmf_traffic::schedule::ParticipantDescription::Rx::Unresponsive;
     };
 
-  std::vector<ScheduleNode::ConflictSet> conflicts;
-  const auto& participants = viewer.participant_ids();
-  for (const auto participant : participants)
+  // Trajectories that reach beyond the horizon only get checked up to the
+  // horizon. Each one is clipped once and shared by every pair it is in.
+  std::unordered_map<
+    const rmf_traffic::Route*, std::optional<rmf_traffic::Trajectory>>
+  clipped;
+  const auto within_horizon = [&](const rmf_traffic::Route& route)
+    -> const std::optional<rmf_traffic::Trajectory>&
+    {
+      auto it = clipped.find(&route);
+      if (it == clipped.end())
+      {
+        it = clipped.insert(
+          {&route, clip_to_horizon(route.trajectory(), *horizon_end)}).first;
+      }
+
+      return it->second;
+    };
+
+  ShardConflicts result;
+  auto& conflicts = result.conflicts;
+  for (std::size_t i = participants_begin; i < participants_end; ++i)
   {
-    const auto itinerary = *viewer.get_itinerary(participant);
-    const auto plan_id = *viewer.get_current_plan_id(participant);
-    const auto description = viewer.get_participant(participant);
-    if (!description)
-      continue;
+    const auto& p = shard.participants[i];
+    const auto participant = p.participant;
+    const auto plan_id = p.plan_id;
+    const auto& description = p.description;
 
-    for (auto vc = view_changes.begin(); vc != view_changes.end(); ++vc)
+    for (const auto* vc : shard.changes)
     {
       if (vc->participant == participant)
       {
@@ -111,13 +262,11 @@ std::vector<ScheduleNode::ConflictSet> get_conflicts(
         continue;
       }
 
-      for (std::size_t r = 0; r < itinerary.size(); ++r)
-      {
-        const auto& route = itinerary[r];
-        assert(route);
-        if (route->map() != vc->route->map())
-          continue;
+      const double vc_radius = profile_radius(vc->description.profile());
+      const auto* const vc_bounds = bounds.find(vc->route.get());
 
+      for (const auto& [r, route] : p.routes)
+      {
         if (route->should_ignore(vc->participant, vc->plan_id))
           continue;
 
@@ -134,18 +283,173 @@ std::vector<ScheduleNode::ConflictSet> get_conflicts(
         if (dep_u)
           continue;
 
-        const auto found_conflict = rmf_traffic::DetectConflict::between(
-          vc->description.profile(), vc->route->trajectory(), nullptr,
-          description->profile(), route->trajectory(), nullptr);
-        if (found_conflict.has_value())
+        const auto* const r_bounds = bounds.find(route.get());
+        if (vc_bounds && r_bounds && vc_bounds->has_value()
+          && r_bounds->has_value())
+        {
+          // Skip the full conflict detection if these routes are nowhere near
+          // each other in space or time.
+          if (!(*vc_bounds)->may_overlap(vc_radius, **r_bounds, p.radius))
+            continue;
+        }
+
+        const rmf_traffic::Trajectory* vc_trajectory = &vc->route->trajectory();
+        const rmf_traffic::Trajectory* r_trajectory = &route->trajectory();
+        if (horizon_end.has_value() && vc_bounds && r_bounds
+          && vc_bounds->has_value() && r_bounds->has_value())
+        {
+          const auto check = HorizonCheck::decide(
+            **vc_bounds, **r_bounds, *horizon_end, recheck_step);
+
+          if (check.kind != HorizonCheck::Kind::Whole)
+            result.deferred.push_back({vc, check.recheck_time});
+
+          if (check.kind == HorizonCheck::Kind::Defer)
+            continue;
+
+          if (check.kind == HorizonCheck::Kind::Clipped)
+          {
+            const auto& vc_clipped = within_horizon(*vc->route);
+            const auto& r_clipped = within_horizon(*route);
+            if (!vc_clipped.has_value() || !r_clipped.has_value())
+            {
+              // There is not enough of one of the routes before the horizon
+              // to check, so wait for the recheck
+              continue;
+            }
+
+            vc_trajectory = &*vc_clipped;
+            r_trajectory = &*r_clipped;
+          }
+        }
+
+        try
+        {
+          const auto found_conflict = rmf_traffic::DetectConflict::between(
+            vc->description.profile(), *vc_trajectory, nullptr,
+            description->profile(), *r_trajectory, nullptr);
+          if (found_conflict.has_value())
+          {
+            conflicts.push_back(
+              RouteConflict{
+                vc->participant, vc->route_id, vc->route,
+                participant, r, route
+              });
+          }
+        }
+        catch (const std::exception& e)
+        {
+          // One bad pair of routes must not stop the rest from being checked
+          ++result.failed_checks;
+          result.last_error = e.what();
+        }
+      }
+    }
+  }
+
+  return result;
+}
+} // anonymous namespace
+
+//==============================================================================
+// Find the conflicts between the changed routes and every route in the viewer.
+// If horizon_end has a value, only conflicts up to that time are found, and
+// the changed routes that still need to be checked beyond it are added to
+// deferred. Conflicts between routes that were already reported are left
+// out, so checking a deferred route again does not reopen its negotiation.
+struct FoundConflicts
+{
+  std::vector<ScheduleNode::ConflictSet> conflicts;
+  std::size_t failed_checks = 0;
+  std::string last_error;
+};
+
+FoundConflicts get_conflicts(
+  const ScheduleNode::ChangedRoutes& view_changes,
+  const rmf_traffic::schedule::ItineraryViewer& viewer,
+  RouteBoundsCache& bounds,
+  WorkerPool* const pool,
+  const std::optional<rmf_traffic::Time> horizon_end,
+  const rmf_traffic::Duration recheck_step,
+  ScheduleNode::DeferredRoutes& deferred,
+  ReportedConflicts& reported)
+{
+  const auto shards = make_shards(view_changes, viewer, bounds);
+
+  FoundConflicts found;
+  const auto collect = [&](ShardConflicts shard_conflicts)
+    {
+      for (const auto& conflict : shard_conflicts.conflicts)
+      {
+        if (reported.report(conflict))
         {
-          conflicts.push_back({participant, vc->participant});
+          found.conflicts.push_back(
+            {conflict.participant_a, conflict.participant_b});
         }
       }
+
+      for (const auto& [vc, recheck_time] : shard_conflicts.deferred)
+        defer_route(deferred, *vc, recheck_time);
+
+      found.failed_checks += shard_conflicts.failed_checks;
+      if (!shard_conflicts.last_error.empty())
+        found.last_error = std::move(shard_conflicts.last_error);
+    };
+
+  if (!pool || pool->size() < 2)
+  {
+    for (const auto& [_, shard] : shards)
+    {
+      collect(
+        get_conflicts(
+          shard, bounds, 0, shard.participants.size(),
+          horizon_end, recheck_step));
     }
+
+    reported.prune(viewer);
+    return found;
   }
 
-  return conflicts;
+  // Each map gets checked by its own worker. When there are fewer maps than
+  // workers, the participants of each map are divided into contiguous chunks
+  // so that every worker has something to do. The results get concatenated in
+  // a fixed order so that the outcome is identical to checking serially.
+  const std::size_t chunks_per_shard =
+    std::max<std::size_t>(1, pool->size() / std::max<std::size_t>(
+        1, shards.size()));
+
+  std::vector<std::future<ShardConflicts>> futures;
+  std::size_t key = 0;
+  for (const auto& [_, shard] : shards)
+  {
+    const std::size_t N = shard.participants.size();
+    const std::size_t num_chunks = std::max<std::size_t>(
+      1, std::min(chunks_per_shard, N));
+    const std::size_t chunk_size = (N + num_chunks - 1) / num_chunks;
+
+    for (std::size_t c = 0; c < num_chunks; ++c)
+    {
+      const std::size_t begin = std::min(c * chunk_size, N);
+      const std::size_t end = std::min((c+1) * chunk_size, N);
+      const MapShard* const shard_ptr = &shard;
+
+      auto task = std::make_shared<std::packaged_task<ShardConflicts()>>(
+        [shard_ptr, &bounds, begin, end, horizon_end, recheck_step]()
+        {
+          return get_conflicts(
+            *shard_ptr, bounds, begin, end, horizon_end, recheck_step);
+        });
+
+      futures.emplace_back(task->get_future());
+      pool->post(key++, [task]() { (*task)(); });
+    }
+  }
+
+  for (auto& future : futures)
+    collect(future.get());
+
+  reported.prune(viewer);
+  return found;
 }
 
 //==============================================================================
@@ -171,6 +475,173 @@ ScheduleNode::ScheduleNode(
   declare_parameter<std::string>(
     "log_file_location", ".rmf_schedule_node.yaml");
 
+  // Number of worker threads that will convert and publish mirror updates. If
+  // this is zero, mirror updates will be published directly from the update
+  // timer callback.
+  declare_parameter<int>("mirror_update_threads", 0);
+  const auto mirror_update_threads =
+    get_parameter("mirror_update_threads").as_int();
+  if (mirror_update_threads > 0)
+  {
+    mirror_update_pool = std::make_unique<WorkerPool>(mirror_update_threads);
+    RCLCPP_INFO(
+      get_logger(),
+      "Publishing mirror updates with %ld worker threads",
+      mirror_update_threads);
+  }
+
+  // Number of threads used to check for conflicts. The participants in the
+  // schedule are partitioned across these threads.
+  declare_parameter<int>("conflict_check_threads", 1);
+  const auto conflict_check_threads =
+    get_parameter("conflict_check_threads").as_int();
+  if (conflict_check_threads > 1)
+  {
+    conflict_check_pool = std::make_unique<WorkerPool>(conflict_check_threads);
+    RCLCPP_INFO(
+      get_logger(),
+      "Checking for conflicts with %ld threads",
+      conflict_check_threads);
+  }
+
+  // How far into the future, in seconds, to detect conflicts. Routes that
+  // could only conflict beyond this horizon are checked later, once the
+  // horizon slides forward to reach them, so no negotiations get opened for
+  // conflicts that are likely to be replanned away before they happen. A value
+  // of zero checks the full extent of every route right away.
+  declare_parameter<int>("conflict_horizon", 0);
+  conflict_horizon = std::chrono::seconds(
+    std::max<int64_t>(0, get_parameter("conflict_horizon").as_int()));
+
+  // Share published patches with mirrors in the same process so that they do
+  // not need to decode the messages. This is only useful when mirrors are
+  // running in the same process as the schedule node, e.g. in a component
+  // container.
+  declare_parameter<bool>("intra_process_patch_handoff", false);
+  intra_process_patch_handoff =
+    get_parameter("intra_process_patch_handoff").as_bool();
+
+  // Minimum period, in milliseconds, between regular updates for each query
+  // topic. Changes that occur within this window are coalesced into a single
+  // patch. A value of zero sends out updates as soon as they are available.
+  declare_parameter<int>("mirror_update_min_interval", 0);
+  mirror_update_min_interval = std::chrono::milliseconds(
+    std::max<int64_t>(
+      0, get_parameter("mirror_update_min_interval").as_int()));
+
+  // Period, in milliseconds, for culling old data out of the schedule
+  declare_parameter<int>("cull_period", 60000);
+  cull_period = std::chrono::milliseconds(
+    std::max<int64_t>(1, get_parameter("cull_period").as_int()));
+
+  // How long, in seconds, to keep routes in the schedule after they finish
+  declare_parameter<int>("cull_horizon", 7200);
+  cull_horizon = std::chrono::seconds(
+    std::max<int64_t>(0, get_parameter("cull_horizon").as_int()));
+
+  // Approximate limit, in megabytes, for how much memory the routes in the
+  // schedule may use. Once the limit is exceeded, routes that have finished
+  // will be culled earlier than the cull horizon. Zero means no limit.
+  declare_parameter<int>("cull_memory_budget_mb", 0);
+  cull_memory_budget = static_cast<std::size_t>(
+    std::max<int64_t>(0, get_parameter("cull_memory_budget_mb").as_int()))
+    * 1024 * 1024;
+
+  // How long, in seconds, a negotiation or a wait for a negotiation conclusion
+  // can go without activity before it gets culled
+  declare_parameter<int>("negotiation_timeout", 30);
+  negotiation_timeout = std::chrono::seconds(
+    std::max<int64_t>(1, get_parameter("negotiation_timeout").as_int()));
+
+  // If this is greater than zero, negotiations that have been open for this
+  // many milliseconds will be concluded with the best proposal set that is
+  // available, or refused if none is available.
+  declare_parameter<int>("negotiation_deadline", 0);
+  negotiation_deadline = std::chrono::milliseconds(
+    std::max<int64_t>(0, get_parameter("negotiation_deadline").as_int()));
+
+  // How long, in milliseconds, to keep waiting for more proposals after a
+  // negotiation has found its first feasible proposal set. A value of zero
+  // concludes negotiations as soon as any feasible proposal set is found.
+  declare_parameter<int>("negotiation_settle_time", 0);
+  negotiation_settle_time = std::chrono::milliseconds(
+    std::max<int64_t>(0, get_parameter("negotiation_settle_time").as_int()));
+
+  // While waiting out the settle time, a negotiation will be concluded right
+  // away if its best proposal set delays the participants by no more than
+  // this many seconds in total.
+  declare_parameter<double>("negotiation_quality_bound", 0.0);
+  negotiation_quality_bound = std::max(
+    0.0, get_parameter("negotiation_quality_bound").as_double());
+
+  // Period, in milliseconds, for materializing a full snapshot of each query.
+  // A value of zero disables snapshots.
+  declare_parameter<int>("snapshot_period", 0);
+  snapshot_period = std::chrono::milliseconds(
+    std::max<int64_t>(0, get_parameter("snapshot_period").as_int()));
+
+  // How many versions a mirror must fall behind before it is sent a snapshot
+  // instead of a patch when it requests a remedial update.
+  declare_parameter<int>("snapshot_min_lag", 1000);
+  snapshot_min_lag = static_cast<Version>(
+    std::max<int64_t>(0, get_parameter("snapshot_min_lag").as_int()));
+
+  // Period, in milliseconds, for publishing statistics about the hot paths of
+  // the node. A value of zero disables the instrumentation entirely.
+  declare_parameter<int>("metrics_period", 0);
+  metrics_period = std::chrono::milliseconds(
+    std::max<int64_t>(0, get_parameter("metrics_period").as_int()));
+
+  // If this is not empty, the cumulative metrics will be written to this file
+  // in the Prometheus text format each time the metrics are published.
+  declare_parameter<std::string>("metrics_prometheus_file", "");
+  metrics_prometheus_file =
+    get_parameter("metrics_prometheus_file").as_string();
+
+  // Period, in milliseconds, for repeating reports of unresolved schedule
+  // inconsistencies. When this is greater than zero, each change only gets an
+  // inconsistency report if it revealed new inconsistencies. When it is zero,
+  // all inconsistencies of a participant are reported after every change.
+  declare_parameter<int>("inconsistency_report_period", 0);
+  inconsistency_report_period = std::chrono::milliseconds(
+    std::max<int64_t>(
+      0, get_parameter("inconsistency_report_period").as_int()));
+
+  // Minimum period, in milliseconds, between broadcasts of the participant
+  // list after participants register or unregister. A value of zero broadcasts
+  // the list right away after every change.
+  declare_parameter<int>("participants_broadcast_period", 0);
+  participants_broadcast_period = std::chrono::milliseconds(
+    std::max<int64_t>(
+      0, get_parameter("participants_broadcast_period").as_int()));
+
+  // Period, in milliseconds, for applying queued itinerary changes as a single
+  // batch. A value of zero applies each change as soon as it arrives.
+  declare_parameter<int>("itinerary_batch_period", 0);
+  itinerary_batch_period = std::chrono::milliseconds(
+    std::max<int64_t>(0, get_parameter("itinerary_batch_period").as_int()));
+
+  // Minimum period, in milliseconds, between publications of the negotiation
+  // states. Every negotiation message changes the state of a negotiation, and
+  // each publication contains the full state of every open negotiation, so in
+  // busy negotiations it can help to only publish the latest states once per
+  // period. A value of zero publishes the states after every change.
+  declare_parameter<int>("negotiation_states_period", 0);
+  negotiation_states_period = std::chrono::milliseconds(
+    std::max<int64_t>(
+      0, get_parameter("negotiation_states_period").as_int()));
+
+  // If this is not empty, the participant registrations and itinerary changes
+  // that this node receives will be recorded into this file, which can be
+  // replayed with rmf_traffic_schedule_replay.
+  declare_parameter<std::string>("schedule_record_file", "");
+
+  // Number of threads that the schedule node executable will spin this node
+  // with. Negotiation messages are handled in their own callback group, so
+  // with more than one thread they do not have to wait behind itinerary
+  // changes and mirror updates.
+  declare_parameter<int>("executor_threads", 2);
+
   // TODO(MXG): Expose a parameter for the update period
   // TODO(MXG): We can probably do something smarter to decide when to update
   // than a simple wall timer
@@ -240,9 +711,21 @@ ScheduleNode::ScheduleNode(
 //==============================================================================
 ScheduleNode::~ScheduleNode()
 {
-  conflict_check_quit = true;
+  // Stop publishing mirror updates before anything else gets torn down
+  mirror_update_pool.reset();
+
+  {
+    // Lock the mutex so that the conflict check thread cannot miss this
+    // notification between checking its wake condition and waiting.
+    std::lock_guard<std::mutex> lock(database_mutex);
+    conflict_check_quit = true;
+  }
+  conflict_check_cv.notify_all();
+
   if (conflict_check_thread.joinable())
     conflict_check_thread.join();
+
+  conflict_check_pool.reset();
 }
 
 //==============================================================================
@@ -279,6 +762,10 @@ void ScheduleNode::setup(const QueryMap& queries)
     throw e;
   }
 
+  // The metrics must exist before the conflict check thread starts, because
+  // that thread reads them without any synchronization.
+  setup_metrics();
+  setup_schedule_recorder();
   setup_redundancy();
   setup_query_services();
   setup_participant_services();
@@ -287,6 +774,47 @@ void ScheduleNode::setup(const QueryMap& queries)
   setup_incosistency_pub();
   setup_conflict_topics_and_thread();
   setup_cull_timer();
+  setup_snapshot_timer();
+}
+
+//==============================================================================
+void ScheduleNode::setup_schedule_recorder()
+{
+  const auto filename = get_parameter("schedule_record_file").as_string();
+  if (filename.empty())
+    return;
+
+  schedule_recorder = ScheduleRecorder::make(filename);
+  if (!schedule_recorder)
+  {
+    RCLCPP_ERROR(
+      get_logger(),
+      "Unable to open schedule recording file [%s]",
+      filename.c_str());
+    return;
+  }
+
+  // Participants that were restored from the registry will not register again,
+  // so we record them up front to let a replay reconstruct them.
+  for (const auto id : database->participant_ids())
+  {
+    const auto* description = database->get_participant(id);
+    if (!description)
+      continue;
+
+    ScheduleRecorder::Participant msg;
+    msg.id = id;
+    msg.description = rmf_traffic_ros2::convert(*description);
+    schedule_recorder->record_registration(msg);
+  }
+
+  schedule_recorder_timer = create_wall_timer(
+    std::chrono::seconds(1), [this]() { schedule_recorder->flush(); });
+
+  RCLCPP_INFO(
+    get_logger(),
+    "Recording schedule changes into [%s]",
+    filename.c_str());
 }
 
 //==============================================================================
@@ -326,6 +854,20 @@ void ScheduleNode::setup_participant_services()
     const UnregisterParticipant::Request::SharedPtr request,
     const UnregisterParticipant::Response::SharedPtr response)
     { this->unregister_participant(request_header, request, response); });
+
+  if (participants_broadcast_period > std::chrono::nanoseconds(0))
+  {
+    participants_broadcast_timer = create_wall_timer(
+      participants_broadcast_period, [this]()
+      {
+        std::lock_guard<std::mutex> lock(database_mutex);
+        if (!participants_broadcast_pending)
+          return;
+
+        participants_broadcast_pending = false;
+        broadcast_participants();
+      });
+  }
 }
 
 //==============================================================================
@@ -352,46 +894,137 @@ void ScheduleNode::setup_itinerary_topics()
     create_subscription<ItinerarySet>(
     rmf_traffic_ros2::ItinerarySetTopicName,
     itinerary_qos,
-    [=](const ItinerarySet::UniquePtr msg)
+    [=](ItinerarySet::UniquePtr msg)
     {
-      this->itinerary_set(*msg);
+      this->receive_itinerary_change(std::move(*msg));
     });
 
   itinerary_extend_sub =
     create_subscription<ItineraryExtend>(
     rmf_traffic_ros2::ItineraryExtendTopicName,
     itinerary_qos,
-    [=](const ItineraryExtend::UniquePtr msg)
+    [=](ItineraryExtend::UniquePtr msg)
     {
-      this->itinerary_extend(*msg);
+      this->receive_itinerary_change(std::move(*msg));
     });
 
   itinerary_delay_sub =
     create_subscription<ItineraryDelay>(
     rmf_traffic_ros2::ItineraryDelayTopicName,
     itinerary_qos,
-    [=](const ItineraryDelay::UniquePtr msg)
+    [=](ItineraryDelay::UniquePtr msg)
     {
-      this->itinerary_delay(*msg);
+      this->receive_itinerary_change(std::move(*msg));
     });
 
   itinerary_reached_sub =
     create_subscription<ItineraryReached>(
     rmf_traffic_ros2::ItineraryReachedTopicName,
     itinerary_qos,
-    [=](const ItineraryReached::UniquePtr msg)
+    [=](ItineraryReached::UniquePtr msg)
     {
-      this->itinerary_reached(*msg);
+      this->receive_itinerary_change(std::move(*msg));
     });
 
   itinerary_clear_sub =
     create_subscription<ItineraryClear>(
     rmf_traffic_ros2::ItineraryClearTopicName,
     itinerary_qos,
-    [=](const ItineraryClear::UniquePtr msg)
+    [=](ItineraryClear::UniquePtr msg)
     {
-      this->itinerary_clear(*msg);
+      this->receive_itinerary_change(std::move(*msg));
     });
+
+  if (itinerary_batch_period > std::chrono::nanoseconds(0))
+  {
+    itinerary_batch_timer = create_wall_timer(
+      itinerary_batch_period, [this]() { apply_itinerary_batch(); });
+  }
+}
+
+//==============================================================================
+void ScheduleNode::receive_itinerary_change(ItineraryChange change)
+{
+  if (schedule_recorder)
+  {
+    std::visit(
+      [&](const auto& msg) { schedule_recorder->record(msg); }, change);
+  }
+
+  if (itinerary_batch_timer)
+  {
+    std::lock_guard<std::mutex> lock(pending_itinerary_mutex);
+    pending_itinerary_changes.emplace_back(std::move(change));
+    return;
+  }
+
+  std::visit(
+    [&](const auto& msg)
+    {
+      using T = std::decay_t<decltype(msg)>;
+      if constexpr (std::is_same_v<T, ItinerarySet>)
+        itinerary_set(msg);
+      else if constexpr (std::is_same_v<T, ItineraryExtend>)
+        itinerary_extend(msg);
+      else if constexpr (std::is_same_v<T, ItineraryDelay>)
+        itinerary_delay(msg);
+      else if constexpr (std::is_same_v<T, ItineraryReached>)
+        itinerary_reached(msg);
+      else
+        itinerary_clear(msg);
+    }, change);
+}
+
+//==============================================================================
+void ScheduleNode::apply_itinerary_batch()
+{
+  std::vector<ItineraryChange> changes;
+  {
+    std::lock_guard<std::mutex> lock(pending_itinerary_mutex);
+    changes.swap(pending_itinerary_changes);
+  }
+
+  if (changes.empty())
+    return;
+
+  const ScopeTimer timer(metrics.get(), "itinerary_batch_latency");
+  if (metrics)
+  {
+    metrics->record(
+      "itinerary_batch_size", static_cast<double>(changes.size()));
+  }
+
+  apply_itinerary_changes(changes);
+}
+
+//==============================================================================
+void ScheduleNode::apply_itinerary_changes(
+  const std::vector<ItineraryChange>& changes)
+{
+  const TimedLock lock(
+    database_mutex, metrics.get(), "database_mutex_wait",
+    "database_mutex_hold");
+
+  // The changes are applied in the order they were received, so the outcome
+  // is the same as if they had been applied one at a time.
+  for (const auto& change : changes)
+  {
+    std::visit(
+      [&](const auto& msg)
+      {
+        using T = std::decay_t<decltype(msg)>;
+        if constexpr (std::is_same_v<T, ItinerarySet>)
+          apply_itinerary_set(msg);
+        else if constexpr (std::is_same_v<T, ItineraryExtend>)
+          apply_itinerary_extend(msg);
+        else if constexpr (std::is_same_v<T, ItineraryDelay>)
+          apply_itinerary_delay(msg);
+        else if constexpr (std::is_same_v<T, ItineraryReached>)
+          apply_itinerary_reached(msg);
+        else
+          apply_itinerary_clear(msg);
+      }, change);
+  }
 }
 
 //==============================================================================
@@ -401,6 +1034,12 @@ void ScheduleNode::setup_incosistency_pub()
     create_publisher<InconsistencyMsg>(
     rmf_traffic_ros2::ScheduleInconsistencyTopicName,
     rclcpp::SystemDefaultsQoS().keep_last(10).reliable());
+
+  if (inconsistency_report_period > std::chrono::nanoseconds(0))
+  {
+    inconsistency_report_timer = create_wall_timer(
+      inconsistency_report_period, [this]() { republish_inconsistencies(); });
+  }
 }
 
 //==============================================================================
@@ -410,12 +1049,18 @@ void ScheduleNode::setup_conflict_topics_and_thread()
     .reliable()
     .keep_last(1000);
 
+  negotiation_callback_group = create_callback_group(
+    rclcpp::CallbackGroupType::MutuallyExclusive);
+  rclcpp::SubscriptionOptions negotiation_options;
+  negotiation_options.callback_group = negotiation_callback_group;
+
   conflict_ack_sub = create_subscription<ConflictAck>(
     rmf_traffic_ros2::NegotiationAckTopicName, negotiation_qos,
     [&](const ConflictAck::UniquePtr msg)
     {
       this->receive_conclusion_ack(*msg);
-    });
+    },
+    negotiation_options);
 
   conflict_notice_pub = create_publisher<ConflictNotice>(
     rmf_traffic_ros2::NegotiationNoticeTopicName, negotiation_qos);
@@ -425,28 +1070,32 @@ void ScheduleNode::setup_conflict_topics_and_thread()
     [&](const ConflictRefusal::UniquePtr msg)
     {
       this->receive_refusal(*msg);
-    });
+    },
+    negotiation_options);
 
   conflict_proposal_sub = create_subscription<ConflictProposal>(
     rmf_traffic_ros2::NegotiationProposalTopicName, negotiation_qos,
     [&](const ConflictProposal::UniquePtr msg)
     {
       this->receive_proposal(*msg);
-    });
+    },
+    negotiation_options);
 
   conflict_rejection_sub = create_subscription<ConflictRejection>(
     rmf_traffic_ros2::NegotiationRejectionTopicName, negotiation_qos,
     [&](const ConflictRejection::UniquePtr msg)
     {
       this->receive_rejection(*msg);
-    });
+    },
+    negotiation_options);
 
   conflict_forfeit_sub = create_subscription<ConflictForfeit>(
     rmf_traffic_ros2::NegotiationForfeitTopicName, negotiation_qos,
     [&](const ConflictForfeit::UniquePtr msg)
     {
       this->receive_forfeit(*msg);
-    });
+    },
+    negotiation_options);
 
   conflict_conclusion_pub = create_publisher<ConflictConclusion>(
     rmf_traffic_ros2::NegotiationConclusionTopicName, negotiation_qos);
@@ -469,85 +1118,225 @@ void ScheduleNode::setup_conflict_topics_and_thread()
   // Initial conflict-free publication
   negotiation_stasuses_pub->publish(NegotiationStatuses{});
 
+  const auto zero = std::chrono::nanoseconds(0);
+  if (negotiation_deadline > zero || negotiation_settle_time > zero)
+  {
+    // Check the negotiations often enough to catch their deadlines within a
+    // tenth of the shortest setting.
+    auto shortest = std::chrono::nanoseconds::max();
+    for (const auto setting : {negotiation_deadline, negotiation_settle_time})
+    {
+      if (setting > zero)
+        shortest = std::min(shortest, setting);
+    }
+
+    const auto period = std::max<std::chrono::nanoseconds>(
+      std::chrono::milliseconds(10), shortest / 10);
+
+    negotiation_deadline_timer = create_wall_timer(
+      period, [this]() { check_negotiation_deadlines(); },
+      negotiation_callback_group);
+  }
+
+  if (negotiation_states_period > std::chrono::nanoseconds(0))
+  {
+    negotiation_states_timer = create_wall_timer(
+      negotiation_states_period, [this]()
+      {
+        std::lock_guard<std::mutex> lock(active_conflicts_mutex);
+        if (!negotiation_states_pending)
+          return;
+
+        negotiation_states_pending = false;
+        publish_negotiation_states();
+      },
+      negotiation_callback_group);
+  }
+
   conflict_check_quit = false;
   conflict_check_thread = std::thread(
     [&]()
     {
       rmf_traffic::schedule::Mirror mirror;
+      RouteBoundsCache route_bounds;
+      DeferredRoutes deferred;
+      ReportedConflicts reported;
       const auto query_all = rmf_traffic::schedule::query_all();
 
       while (rclcpp::ok(get_node_options().context()) && !conflict_check_quit)
       {
         rmf_utils::optional<rmf_traffic::schedule::Patch> next_patch;
-        rmf_traffic::schedule::Viewer::View view_changes;
-
-        // Use this scope to minimize how long we lock the database for
+        std::optional<rmf_traffic::schedule::ParticipantDescriptionsMap>
+        participants;
+        ChangedRoutes view_changes;
+        std::chrono::steady_clock::time_point hold_start;
+
+        // Use this scope to minimize how long we lock the database for. We only
+        // copy the changes out of the database while it is locked. The mirror
+        // is only used by this thread, so it can be updated afterwards.
         {
           std::unique_lock<std::mutex> lock(database_mutex);
-          conflict_check_cv.wait_for(lock, std::chrono::milliseconds(100), [&]()
+          const auto has_changes = [&]()
+            {
+              return conflict_check_quit
+                || database->latest_version() != mirror.latest_version()
+                || last_known_participants_version
+                != current_participants_version;
+            };
+
+          if (deferred.empty())
+          {
+            conflict_check_cv.wait(lock, has_changes);
+          }
+          else
           {
-            return !(database->latest_version() <= mirror.latest_version())
-            && !conflict_check_quit;
-          });
+            // Wake up when the horizon reaches the earliest deferred route.
+            // The recheck times are in ROS time while the wait is measured in
+            // real time, so the wait is capped and the horizon gets evaluated
+            // again after each wake-up in case the two clocks drift apart.
+            auto recheck_time = deferred.begin()->second.recheck_time;
+            for (const auto& [_, d] : deferred)
+              recheck_time = std::min(recheck_time, d.recheck_time);
+
+            const auto ros_now = rmf_traffic_ros2::convert(now());
+            const auto timeout = std::clamp<rmf_traffic::Duration>(
+              recheck_time - conflict_horizon - ros_now,
+              std::chrono::milliseconds(1),
+              std::max<rmf_traffic::Duration>(
+                conflict_horizon / 4, std::chrono::milliseconds(1)));
+
+            conflict_check_cv.wait_for(lock, timeout, has_changes);
+          }
+
+          if (conflict_check_quit)
+            break;
 
-          if ( (database->latest_version() == mirror.latest_version()
-          && last_known_participants_version == current_participants_version)
-          || conflict_check_quit)
+          // Waiting on the condition variable releases the mutex, so only the
+          // time spent copying out the changes counts as holding it.
+          hold_start = std::chrono::steady_clock::now();
+          if (metrics)
           {
-            // This is a casual wakeup to check if we're supposed to quit yet
-            continue;
+            metrics->record(
+              "conflict_check_lag",
+              static_cast<double>(
+                database->latest_version()
+                - mirror.latest_version().value_or(0)));
           }
 
           if (last_known_participants_version != current_participants_version)
           {
             last_known_participants_version = current_participants_version;
-            rmf_traffic::schedule::ParticipantDescriptionsMap participants;
+            participants = rmf_traffic::schedule::ParticipantDescriptionsMap();
             for (const auto& id: database->participant_ids())
             {
-              participants.insert({id, *database->get_participant(id)});
-            }
-
-            try
-            {
-              mirror.update_participants_info(participants);
-            }
-            catch (const std::exception& e)
-            {
-              RCLCPP_ERROR(get_logger(), "%s", e.what());
+              participants->insert({id, *database->get_participant(id)});
             }
           }
 
           const auto last_checked_version = mirror.latest_version().value_or(0);
-          next_patch = database->changes(query_all, mirror.latest_version());
-          // TODO(MXG): Check whether the database really needs to remain locked
-          // during this update.
           try
           {
-            if (!mirror.update(*next_patch))
+            next_patch = database->changes(query_all, mirror.latest_version());
+
+            const auto view = database->query(query_all, last_checked_version);
+            for (const auto& vc : view)
             {
-              const std::string mirror_version = mirror.latest_version() ?
-              std::to_string(*mirror.latest_version()) : "none";
-              const std::string patch_base = next_patch->base_version() ?
-              std::to_string(*next_patch->base_version()) : "any";
-              RCLCPP_ERROR(
-                get_logger(),
-                "Failed to update conflict detection mirror. Mirror version: %s"
-                ", patch base: %s",
-                mirror_version.c_str(),
-                patch_base.c_str());
-              continue;
+              view_changes.push_back(
+                ChangedRoute{
+                  vc.participant,
+                  vc.plan_id,
+                  vc.route_id,
+                  vc.route,
+                  vc.description
+                });
             }
+          }
+          catch (const std::exception& e)
+          {
+            RCLCPP_ERROR(get_logger(), "%s", e.what());
+            continue;
+          }
 
-            view_changes = database->query(query_all, last_checked_version);
+          if (metrics)
+          {
+            metrics->record(
+              "conflict_check_mutex_hold",
+              std::chrono::steady_clock::now() - hold_start);
+          }
+        }
+
+        if (participants.has_value())
+        {
+          try
+          {
+            mirror.update_participants_info(*participants);
           }
           catch (const std::exception& e)
           {
             RCLCPP_ERROR(get_logger(), "%s", e.what());
+          }
+        }
+
+        try
+        {
+          if (!mirror.update(*next_patch))
+          {
+            const std::string mirror_version = mirror.latest_version() ?
+              std::to_string(*mirror.latest_version()) : "none";
+            const std::string patch_base = next_patch->base_version() ?
+              std::to_string(*next_patch->base_version()) : "any";
+            RCLCPP_ERROR(
+              get_logger(),
+              "Failed to update conflict detection mirror. Mirror version: %s"
+              ", patch base: %s",
+              mirror_version.c_str(),
+              patch_base.c_str());
             continue;
           }
         }
+        catch (const std::exception& e)
+        {
+          RCLCPP_ERROR(get_logger(), "%s", e.what());
+          continue;
+        }
 
-        auto conflicts = get_conflicts(view_changes, mirror);
+        std::optional<rmf_traffic::Time> horizon_end;
+        if (conflict_horizon > std::chrono::nanoseconds(0))
+        {
+          horizon_end = rmf_traffic_ros2::convert(now()) + conflict_horizon;
+          recheck_deferred_routes(*horizon_end, mirror, view_changes, deferred);
+        }
+
+        FoundConflicts found;
+        try
+        {
+          found = get_conflicts(
+            view_changes, mirror, route_bounds, conflict_check_pool.get(),
+            horizon_end, conflict_horizon / 4, deferred, reported);
+        }
+        catch (const std::exception& e)
+        {
+          RCLCPP_ERROR(
+            get_logger(),
+            "Failed to check the schedule for conflicts: %s", e.what());
+        }
+        route_bounds.prune();
+
+        if (found.failed_checks > 0)
+        {
+          RCLCPP_ERROR(
+            get_logger(),
+            "Conflict detection failed for %zu pairs of routes. Last error: %s",
+            found.failed_checks, found.last_error.c_str());
+        }
+
+        auto& conflicts = found.conflicts;
+
+        if (metrics && horizon_end.has_value())
+        {
+          metrics->record(
+            "conflict_check_deferred", static_cast<double>(deferred.size()));
+        }
         for (ConflictSet& conflict : conflicts)
         {
           // Collect all other participants that have dependencies on the ones
@@ -615,7 +1404,13 @@ void ScheduleNode::setup_conflict_topics_and_thread()
             participants.begin(), participants.end());
 
           conflict_notice_pub->publish(msg);
-          publish_negotiation_states();
+          {
+            std::lock_guard<std::mutex> lock(active_conflicts_mutex);
+            request_negotiation_states();
+          }
+
+          if (metrics)
+            metrics->increment("negotiations_opened");
         }
       }
     });
@@ -625,7 +1420,113 @@ void ScheduleNode::setup_conflict_topics_and_thread()
 void ScheduleNode::setup_cull_timer()
 {
   cull_timer = create_wall_timer(
-    std::chrono::minutes(1), [this]() { cull(); });
+    cull_period, [this]() { cull(); });
+}
+
+//==============================================================================
+void ScheduleNode::setup_snapshot_timer()
+{
+  if (snapshot_period == std::chrono::nanoseconds(0))
+    return;
+
+  snapshot_timer = create_wall_timer(
+    snapshot_period, [this]() { update_snapshots(); });
+}
+
+//==============================================================================
+void ScheduleNode::setup_metrics()
+{
+  if (metrics_period == std::chrono::nanoseconds(0))
+    return;
+
+  metrics = std::make_shared<Metrics>("rmf_traffic_schedule");
+
+  const auto durations = Metrics::duration_buckets();
+  for (const auto* name : {
+      "itinerary_set_latency",
+      "itinerary_extend_latency",
+      "itinerary_delay_latency",
+      "itinerary_reached_latency",
+      "itinerary_clear_latency",
+      "itinerary_batch_latency",
+      "database_mutex_wait",
+      "database_mutex_hold",
+      "conflict_check_mutex_hold",
+      "mirror_update_conversion_time",
+      "mirror_update_compaction_time"
+    })
+  {
+    metrics->add_statistic(name, "seconds", durations);
+  }
+
+  metrics->add_statistic(
+    "mirror_update_patch_size", "participants", Metrics::size_buckets());
+  metrics->add_statistic(
+    "itinerary_batch_size", "changes", Metrics::size_buckets());
+  metrics->add_statistic(
+    "conflict_check_lag", "versions", Metrics::size_buckets());
+  metrics->add_statistic(
+    "schedule_route_kilobytes", "kilobytes", Metrics::size_buckets());
+  metrics->add_statistic(
+    "cull_effective_horizon", "seconds",
+    {60.0, 300.0, 600.0, 1800.0, 3600.0, 7200.0, 14400.0, 86400.0});
+
+  metrics->add_counter("mirror_update_compact_bytes");
+  metrics->add_counter("negotiations_opened");
+  metrics->add_counter("negotiations_resolved");
+  metrics->add_counter("negotiations_failed");
+  metrics->add_counter("culled_routes");
+  metrics->add_counter("culled_bytes");
+
+  metrics_pub = create_publisher<MetricsMsg>(
+    rmf_traffic_ros2::ScheduleMetricsTopicName,
+    rclcpp::SystemDefaultsQoS().reliable().keep_last(100));
+
+  metrics_timer = create_wall_timer(
+    metrics_period, [this]() { publish_metrics(); });
+
+  RCLCPP_INFO(
+    get_logger(),
+    "Publishing schedule metrics on %s every %ld ms",
+    metrics_pub->get_topic_name(),
+    std::chrono::duration_cast<std::chrono::milliseconds>(
+      metrics_period).count());
+}
+
+//==============================================================================
+void ScheduleNode::publish_metrics()
+{
+  for (const auto& msg : metrics->flush(now()))
+    metrics_pub->publish(msg);
+
+  if (metrics_prometheus_file.empty())
+    return;
+
+  // Write to a temporary file first so that a scraper never sees a partially
+  // written file.
+  const std::string temp_file = metrics_prometheus_file + ".tmp";
+  {
+    std::ofstream out(temp_file, std::ios::trunc);
+    if (!out)
+    {
+      RCLCPP_WARN(
+        get_logger(),
+        "[ScheduleNode::publish_metrics] Unable to open [%s] for writing",
+        temp_file.c_str());
+      return;
+    }
+
+    out << metrics->prometheus();
+  }
+
+  if (std::rename(temp_file.c_str(), metrics_prometheus_file.c_str()) != 0)
+  {
+    RCLCPP_WARN(
+      get_logger(),
+      "[ScheduleNode::publish_metrics] Unable to write metrics to [%s]: %s",
+      metrics_prometheus_file.c_str(),
+      std::strerror(errno));
+  }
 }
 
 //==============================================================================
@@ -724,14 +1625,20 @@ void ScheduleNode::register_query(
   {
     if (existing_query.query == new_query)
     {
+      ++existing_query.registrations;
       RCLCPP_INFO(
         get_logger(),
-        "A new mirror is tracking query ID [%ld]",
-        existing_query_id);
-
+        "A new mirror is tracking query ID [%ld], which has been registered "
+        "%lu times",
+        existing_query_id,
+        existing_query.registrations);
+
+      // The mirror shares the topic and publisher of the existing query. The
+      // set of queries has not changed, so there is no need to broadcast it
+      // to every mirror and replica again. The last broadcast is kept for
+      // late joiners.
       existing_query.last_registration_time = std::chrono::steady_clock::now();
       response->query_id = existing_query_id;
-      broadcast_queries();
       return;
     }
   }
@@ -785,15 +1692,27 @@ void ScheduleNode::register_query(
     rmf_traffic_ros2::QueryUpdateTopicNameBase + std::to_string(query_id),
     rclcpp::ServicesQoS().reliable().keep_last(5000));
 
+  // Mirrors that want the compact format subscribe to this topic instead
+  CompactMirrorUpdateTopicPublisher compact_publisher =
+    create_publisher<CompactMirrorUpdate>(
+    rmf_traffic_ros2::QueryUpdateTopicNameBase + std::to_string(query_id)
+    + CompactMirrorUpdateTopicSuffix,
+    rclcpp::ServicesQoS().reliable().keep_last(5000));
+
   registered_queries.emplace(
     query_id,
     QueryInfo{
       query,
       std::move(update_publisher),
+      std::move(compact_publisher),
       std::nullopt,
       std::nullopt,
       std::chrono::steady_clock::now(),
-      {}
+      {},
+      std::chrono::steady_clock::time_point(),
+      nullptr,
+      get_query_maps(query),
+      true
     });
 }
 
@@ -805,7 +1724,8 @@ void ScheduleNode::cleanup_queries()
   auto it = registered_queries.begin();
   while (it != registered_queries.end())
   {
-    if (it->second.publisher->get_subscription_count() == 0)
+    if (it->second.publisher->get_subscription_count() == 0
+      && it->second.compact_publisher->get_subscription_count() == 0)
     {
       if (query_grace_period < now - it->second.last_registration_time)
       {
@@ -813,6 +1733,12 @@ void ScheduleNode::cleanup_queries()
         // It's important that we use the post-increment operator here so that
         // we increment the iterator to its next value while erasing the element
         // that it used to point at.
+        RCLCPP_INFO(
+          get_logger(),
+          "Removing query ID [%ld] since none of the %lu mirrors that "
+          "registered it are subscribed anymore",
+          it->first,
+          it->second.registrations);
         registered_queries.erase(it++);
         any_erased = true;
         continue;
@@ -834,7 +1760,95 @@ void ScheduleNode::cull()
     // Cull unnecessary data from the schedule
     std::lock_guard<std::mutex> lock(database_mutex);
     database->set_current_time(time);
-    database->cull(time - std::chrono::hours(2));
+
+    // Estimate how much memory each route is using so that we can tighten the
+    // cull horizon if the schedule is larger than its memory budget.
+    struct RouteFootprint
+    {
+      rmf_traffic::Time finish_time;
+      std::size_t bytes;
+    };
+    std::vector<RouteFootprint> footprints;
+    std::size_t total_bytes = 0;
+    const auto query_all = rmf_traffic::schedule::query_all();
+    const auto view = database->query(
+      query_all.spacetime(), query_all.participants());
+    for (const auto& v : view)
+    {
+      const auto& trajectory = v.route->trajectory();
+      const auto* finish_time = trajectory.finish_time();
+      if (!finish_time)
+        continue;
+
+      const std::size_t bytes = estimated_route_bytes
+        + trajectory.size() * estimated_waypoint_bytes;
+      footprints.push_back({*finish_time, bytes});
+      total_bytes += bytes;
+    }
+
+    auto cull_time = time - cull_horizon;
+    if (cull_memory_budget > 0 && total_bytes > cull_memory_budget)
+    {
+      // Drop the routes that finished earliest until we are within budget,
+      // but never drop routes that have not finished yet.
+      std::sort(
+        footprints.begin(), footprints.end(),
+        [](const RouteFootprint& a, const RouteFootprint& b)
+        {
+          return a.finish_time < b.finish_time;
+        });
+
+      std::size_t remaining_bytes = total_bytes;
+      for (const auto& f : footprints)
+      {
+        if (remaining_bytes <= cull_memory_budget || time < f.finish_time)
+          break;
+
+        cull_time =
+          std::max(cull_time, f.finish_time + rmf_traffic::Duration(1));
+        remaining_bytes -= f.bytes;
+      }
+    }
+
+    std::size_t culled_routes = 0;
+    std::size_t culled_bytes = 0;
+    for (const auto& f : footprints)
+    {
+      if (f.finish_time < cull_time)
+      {
+        ++culled_routes;
+        culled_bytes += f.bytes;
+      }
+    }
+
+    database->cull(cull_time);
+    mark_all_maps_changed();
+
+    // The horizon will be shorter than cull_horizon whenever the memory
+    // budget forced routes out early.
+    const auto effective_horizon = rmf_traffic::time::to_seconds(
+      time - cull_time);
+    if (metrics)
+    {
+      metrics->increment("culled_routes", culled_routes);
+      metrics->increment("culled_bytes", culled_bytes);
+      metrics->record(
+        "schedule_route_kilobytes",
+        static_cast<double>(total_bytes - culled_bytes) / 1024.0);
+      metrics->record("cull_effective_horizon", effective_horizon);
+    }
+
+    if (culled_routes > 0)
+    {
+      RCLCPP_INFO(
+        get_logger(),
+        "[ScheduleNode::cull] Culled %lu routes (about %lu KB) that finished "
+        "more than %fs ago. About %lu KB of routes remain in the schedule.",
+        culled_routes,
+        culled_bytes / 1024,
+        effective_horizon,
+        (total_bytes - culled_bytes) / 1024);
+    }
   }
 
   {
@@ -843,7 +1857,7 @@ void ScheduleNode::cull()
     std::vector<std::size_t> cull_wait;
     for (const auto& [v, wait] : active_conflicts._waiting)
     {
-      if (wait.conclusion_time + std::chrono::seconds(30) > time)
+      if (wait.conclusion_time + negotiation_timeout < time)
       {
         cull_wait.push_back(v);
       }
@@ -863,8 +1877,7 @@ void ScheduleNode::cull()
     {
       if (open.has_value())
       {
-        // TODO(MXG): Make this deadline configurable
-        if (open->last_active_time + std::chrono::seconds(30) > time)
+        if (open->last_active_time + negotiation_timeout < time)
         {
           cull_negotiation.push_back(v);
         }
@@ -933,6 +1946,16 @@ void ScheduleNode::register_participant(
       .next_storage_base(registration.next_storage_base())
       .error("");
 
+    mark_all_maps_changed();
+
+    if (schedule_recorder)
+    {
+      ScheduleRecorder::Participant msg;
+      msg.id = registration.id();
+      msg.description = request->description;
+      schedule_recorder->record_registration(msg);
+    }
+
     RCLCPP_INFO(
       get_logger(),
       "Registered participant [%ld] named [%s] owned by [%s]",
@@ -940,7 +1963,7 @@ void ScheduleNode::register_participant(
       request->description.name.c_str(),
       request->description.owner.c_str());
 
-    broadcast_participants();
+    request_participants_broadcast();
   }
   catch (const std::exception& e)
   {
@@ -983,9 +2006,17 @@ void ScheduleNode::unregister_participant(
     const std::string owner = p->owner();
 
     auto version = database->itinerary_version(request->participant_id);
+    mark_maps_changed(request->participant_id);
     database->clear(request->participant_id, version);
     response->confirmation = true;
 
+    if (schedule_recorder)
+    {
+      ScheduleRecorder::Participant msg;
+      msg.id = request->participant_id;
+      schedule_recorder->record_unregistration(msg);
+    }
+
     RCLCPP_INFO(
       get_logger(),
       "Unregistered participant [%ld] named [%s] owned by [%s]",
@@ -993,7 +2024,7 @@ void ScheduleNode::unregister_participant(
       name.c_str(),
       owner.c_str());
 
-    broadcast_participants();
+    request_participants_broadcast();
   }
   catch (const std::exception& e)
   {
@@ -1007,6 +2038,18 @@ void ScheduleNode::unregister_participant(
   }
 }
 
+//==============================================================================
+void ScheduleNode::request_participants_broadcast()
+{
+  if (participants_broadcast_period == std::chrono::nanoseconds(0))
+  {
+    broadcast_participants();
+    return;
+  }
+
+  participants_broadcast_pending = true;
+}
+
 //==============================================================================
 void ScheduleNode::broadcast_participants()
 {
@@ -1023,6 +2066,7 @@ void ScheduleNode::broadcast_participants()
     msg.participants.push_back(participant);
   }
   participants_info_pub->publish(msg);
+  conflict_check_cv.notify_all();
 }
 
 //==============================================================================
@@ -1088,16 +2132,29 @@ void ScheduleNode::request_changes(
 //==============================================================================
 void ScheduleNode::itinerary_set(const ItinerarySet& set)
 {
-  std::unique_lock<std::mutex> lock(database_mutex);
+  const ScopeTimer timer(metrics.get(), "itinerary_set_latency");
+  const TimedLock lock(
+    database_mutex, metrics.get(), "database_mutex_wait",
+    "database_mutex_hold");
+  apply_itinerary_set(set);
+}
+
+//==============================================================================
+void ScheduleNode::apply_itinerary_set(const ItinerarySet& set)
+{
   assert(!set.itinerary.empty());
   try
   {
+    // Both the maps of the routes being replaced and the maps of the new
+    // routes are affected by this change.
+    mark_maps_changed(set.participant);
     database->set(
       set.participant,
       set.plan,
       rmf_traffic_ros2::convert(set.itinerary),
       set.storage_base,
       set.itinerary_version);
+    mark_maps_changed(set.participant);
 
     publish_inconsistencies(set.participant);
 
@@ -1113,13 +2170,26 @@ void ScheduleNode::itinerary_set(const ItinerarySet& set)
 //==============================================================================
 void ScheduleNode::itinerary_extend(const ItineraryExtend& extend)
 {
-  std::unique_lock<std::mutex> lock(database_mutex);
+  const ScopeTimer timer(metrics.get(), "itinerary_extend_latency");
+  const TimedLock lock(
+    database_mutex, metrics.get(), "database_mutex_wait",
+    "database_mutex_hold");
+  apply_itinerary_extend(extend);
+}
+
+//==============================================================================
+void ScheduleNode::apply_itinerary_extend(const ItineraryExtend& extend)
+{
   try
   {
+    // The database may also apply buffered out-of-order changes that move
+    // routes off of their current maps, so mark the maps before and after.
+    mark_maps_changed(extend.participant);
     database->extend(
       extend.participant,
       rmf_traffic_ros2::convert(extend.routes),
       extend.itinerary_version);
+    mark_maps_changed(extend.participant);
 
     publish_inconsistencies(extend.participant);
 
@@ -1134,9 +2204,18 @@ void ScheduleNode::itinerary_extend(const ItineraryExtend& extend)
 }
 
 //==============================================================================
-void ScheduleNode::itinerary_delay(const ItineraryDelay& delay)
+void ScheduleNode::itinerary_delay(const ItineraryDelay& delay)
+{
+  const ScopeTimer timer(metrics.get(), "itinerary_delay_latency");
+  const TimedLock lock(
+    database_mutex, metrics.get(), "database_mutex_wait",
+    "database_mutex_hold");
+  apply_itinerary_delay(delay);
+}
+
+//==============================================================================
+void ScheduleNode::apply_itinerary_delay(const ItineraryDelay& delay)
 {
-  std::unique_lock<std::mutex> lock(database_mutex);
   const auto duration = rmf_traffic::Duration(delay.delay);
 
   static const auto delay_limit = std::chrono::hours(1);
@@ -1176,10 +2255,14 @@ void ScheduleNode::itinerary_delay(const ItineraryDelay& delay)
       }
     }
 
+    // The database may also apply buffered out-of-order changes that move
+    // routes off of their current maps, so mark the maps before and after.
+    mark_maps_changed(delay.participant);
     database->delay(
       delay.participant,
       duration,
       delay.itinerary_version);
+    mark_maps_changed(delay.participant);
 
     publish_inconsistencies(delay.participant);
 
@@ -1196,14 +2279,25 @@ void ScheduleNode::itinerary_delay(const ItineraryDelay& delay)
 //==============================================================================
 void ScheduleNode::itinerary_reached(const ItineraryReached& msg)
 {
-  std::unique_lock<std::mutex> lock(database_mutex);
+  const ScopeTimer timer(metrics.get(), "itinerary_reached_latency");
+  const TimedLock lock(
+    database_mutex, metrics.get(), "database_mutex_wait",
+    "database_mutex_hold");
+  apply_itinerary_reached(msg);
+}
+
+//==============================================================================
+void ScheduleNode::apply_itinerary_reached(const ItineraryReached& msg)
+{
   try
   {
+    mark_maps_changed(msg.participant);
     database->reached(
       msg.participant,
       msg.plan,
       msg.reached_checkpoints,
       msg.progress_version);
+    mark_maps_changed(msg.participant);
 
     // There is no risk of inconsistencies or conflicts occurring due to new
     // progress being reported, so we do not need to check for either.
@@ -1218,10 +2312,22 @@ void ScheduleNode::itinerary_reached(const ItineraryReached& msg)
 //==============================================================================
 void ScheduleNode::itinerary_clear(const ItineraryClear& clear)
 {
-  std::unique_lock<std::mutex> lock(database_mutex);
+  const ScopeTimer timer(metrics.get(), "itinerary_clear_latency");
+  const TimedLock lock(
+    database_mutex, metrics.get(), "database_mutex_wait",
+    "database_mutex_hold");
+  apply_itinerary_clear(clear);
+}
+
+//==============================================================================
+void ScheduleNode::apply_itinerary_clear(const ItineraryClear& clear)
+{
   try
   {
+    // Buffered changes that the clear makes ready may put routes on new maps
+    mark_maps_changed(clear.participant);
     database->clear(clear.participant, clear.itinerary_version);
+    mark_maps_changed(clear.participant);
 
     publish_inconsistencies(clear.participant);
 
@@ -1235,20 +2341,104 @@ void ScheduleNode::itinerary_clear(const ItineraryClear& clear)
   }
 }
 
+//==============================================================================
+void ScheduleNode::mark_maps_changed(
+  rmf_traffic::schedule::ParticipantId participant)
+{
+  if (all_maps_changed)
+    return;
+
+  const auto itinerary = database->get_itinerary(participant);
+  if (!itinerary.has_value())
+    return;
+
+  for (const auto& route : *itinerary)
+    changed_maps.insert(route->map());
+}
+
+//==============================================================================
+void ScheduleNode::mark_all_maps_changed()
+{
+  all_maps_changed = true;
+  changed_maps.clear();
+}
+
 //==============================================================================
 void ScheduleNode::publish_inconsistencies(
   rmf_traffic::schedule::ParticipantId id)
 {
-  // TODO(MXG): This approach is likely to send out a lot of redundant
-  // inconsistency reports. We should try to be smarter about how
-  // inconsistencies get reported.
   const auto it = database->inconsistencies().find(id);
   assert(it != database->inconsistencies().end());
   if (it->ranges.size() == 0)
+  {
+    inconsistency_reports.erase(id);
+    return;
+  }
+
+  auto msg =
+    rmf_traffic_ros2::convert(*it, database->get_current_progress_version(id));
+
+  if (inconsistency_report_period == std::chrono::nanoseconds(0))
+  {
+    inconsistency_pub->publish(msg);
+    return;
+  }
+
+  // Only tell the participant about ranges that it has not heard about yet.
+  // Ranges that it was already told about will be re-sent by
+  // republish_inconsistencies() if they do not get resolved.
+  auto& report = inconsistency_reports[id];
+  auto unreported = msg.ranges;
+  const auto already_reported = [&](const auto& r)
+    {
+      return std::find(
+        report.ranges.begin(), report.ranges.end(),
+        InconsistencyReport::Range(r.lower, r.upper)) != report.ranges.end();
+    };
+  unreported.erase(
+    std::remove_if(unreported.begin(), unreported.end(), already_reported),
+    unreported.end());
+
+  report.ranges.clear();
+  for (const auto& r : msg.ranges)
+    report.ranges.emplace_back(r.lower, r.upper);
+
+  if (unreported.empty())
     return;
 
-  inconsistency_pub->publish(
-    rmf_traffic_ros2::convert(*it, database->get_current_progress_version(id)));
+  report.time = std::chrono::steady_clock::now();
+  msg.ranges = std::move(unreported);
+  inconsistency_pub->publish(msg);
+}
+
+//==============================================================================
+void ScheduleNode::republish_inconsistencies()
+{
+  std::lock_guard<std::mutex> lock(database_mutex);
+  const auto now = std::chrono::steady_clock::now();
+  for (auto it = inconsistency_reports.begin();
+    it != inconsistency_reports.end(); )
+  {
+    const auto id = it->first;
+    auto& report = it->second;
+    const auto element = database->inconsistencies().find(id);
+    if (element == database->inconsistencies().end()
+      || element->ranges.size() == 0)
+    {
+      it = inconsistency_reports.erase(it);
+      continue;
+    }
+
+    if (now - report.time >= inconsistency_report_period)
+    {
+      report.time = now;
+      inconsistency_pub->publish(
+        rmf_traffic_ros2::convert(
+          *element, database->get_current_progress_version(id)));
+    }
+
+    ++it;
+  }
 }
 
 //==============================================================================
@@ -1289,18 +2479,89 @@ void ScheduleNode::receive_startup_msg(const ScheduleId& msg)
 //==============================================================================
 void ScheduleNode::update_mirrors()
 {
-  for (auto& [query_id, query_info] : registered_queries)
+  struct Outgoing
+  {
+    uint64_t query_id;
+    MirrorUpdateTopicPublisher publisher;
+    CompactMirrorUpdateTopicPublisher compact_publisher;
+    PendingMirrorUpdatePtr update;
+  };
+  std::vector<Outgoing> outgoing;
+
+  mirror_update_cache.clear();
+  const std::size_t initial_cache_hits = mirror_update_cache_hits;
+  const auto current_time = std::chrono::steady_clock::now();
+  Version latest_version;
+
+  // Only hold the database mutex long enough to snapshot the patches. The
+  // conversion and publishing happen afterwards.
   {
-    for (const auto request : query_info.remediation_requests)
+    const TimedLock lock(
+      database_mutex, metrics.get(), "database_mutex_wait",
+      "database_mutex_hold");
+    latest_version = database->latest_version();
+
+    // Find out which queries might be able to see the changes that happened
+    // since the last round. Queries that are restricted to maps which were
+    // not touched have nothing new to receive.
+    for (auto& [query_id, query_info] : registered_queries)
     {
-      const auto updated = update_query(
-        query_info.publisher,
-        query_info.query,
-        request,
-        true);
+      if (query_info.dirty)
+        continue;
+
+      if (all_maps_changed || !query_info.maps.has_value())
+      {
+        query_info.dirty = true;
+        continue;
+      }
+
+      for (const auto& map : changed_maps)
+      {
+        if (query_info.maps->count(map) > 0)
+        {
+          query_info.dirty = true;
+          break;
+        }
+      }
+    }
+    changed_maps.clear();
+    all_maps_changed = false;
 
-      if (updated)
+    for (auto& [query_id, query_info] : registered_queries)
+    {
+      for (const auto request : query_info.remediation_requests)
       {
+        const auto& snapshot = query_info.snapshot;
+        const bool use_snapshot = snapshot
+          && (!request.has_value()
+          || snapshot_min_lag < latest_version - *request)
+          && (!request.has_value()
+          || rmf_utils::modular(*request).less_than(
+            snapshot->msg.database_version));
+
+        if (use_snapshot)
+        {
+          const auto snapshot_version = snapshot->msg.database_version;
+          RCLCPP_INFO(
+            get_logger(),
+            "[ScheduleNode::update_mirrors] Sending snapshot of version %lu "
+            "followed by changes up to %lu for query %ld",
+            snapshot_version,
+            latest_version,
+            query_id);
+
+          outgoing.push_back({query_id, query_info.publisher,
+            query_info.compact_publisher, snapshot});
+
+          auto tail = prepare_mirror_update(
+            query_info.query, snapshot_version, true);
+          outgoing.push_back({query_id, query_info.publisher,
+            query_info.compact_publisher, std::move(tail)});
+          continue;
+        }
+
+        auto update = prepare_mirror_update(query_info.query, request, true);
+
         const std::string starting_from = request.has_value() ?
           "version " + std::to_string(*request) : "the beginning";
 
@@ -1309,57 +2570,252 @@ void ScheduleNode::update_mirrors()
           "[ScheduleNode::update_mirrors] Sending remedial update starting "
           "from %s going to %lu for query %ld",
           starting_from.c_str(),
-          database->latest_version(),
+          latest_version,
+          query_id);
+
+        outgoing.push_back({query_id, query_info.publisher,
+          query_info.compact_publisher, std::move(update)});
+      }
+      query_info.remediation_requests.clear();
+
+      if (query_info.last_checked_version == latest_version)
+        continue;
+
+      if (current_time - query_info.last_publish_time
+        < mirror_update_min_interval)
+      {
+        // Leave last_checked_version alone so that the accumulated changes
+        // get sent out in one patch once the interval has elapsed.
+        continue;
+      }
+
+      query_info.last_checked_version = latest_version;
+      if (!query_info.dirty)
+      {
+        // None of the changes since the last patch could be seen by this
+        // query, so there would be nothing in the patch.
+        continue;
+      }
+
+      query_info.dirty = false;
+      auto update = prepare_mirror_update(
+        query_info.query, query_info.last_sent_version, false);
+
+      if (update->patch.has_value())
+      {
+        // Update the latest version sent to this topic
+        query_info.last_sent_version = latest_version;
+        query_info.last_publish_time = current_time;
+
+        RCLCPP_DEBUG(
+          get_logger(),
+          "[ScheduleNode::update_mirrors] Updated query [%ld]",
           query_id);
+
+        outgoing.push_back({query_id, query_info.publisher,
+          query_info.compact_publisher, std::move(update)});
       }
     }
-    query_info.remediation_requests.clear();
+  }
 
-    if (query_info.last_checked_version == database->latest_version())
-      continue;
+  if (latest_version != last_conflict_check_notice)
+  {
+    last_conflict_check_notice = latest_version;
+    conflict_check_cv.notify_all();
+  }
+
+  for (const auto& out : outgoing)
+  {
+    publish_mirror_update(
+      out.query_id, out.publisher, out.compact_publisher, out.update);
+  }
+
+  if (mirror_update_cache_hits != initial_cache_hits)
+  {
+    const std::size_t total =
+      mirror_update_cache_hits + mirror_update_cache_misses;
+
+    RCLCPP_DEBUG(
+      get_logger(),
+      "[ScheduleNode::update_mirrors] Reused %lu mirror updates for version "
+      "%lu. Cumulative patch cache hit rate: %lu / %lu",
+      mirror_update_cache_hits - initial_cache_hits,
+      latest_version,
+      mirror_update_cache_hits,
+      total);
+  }
+}
 
-    query_info.last_checked_version = database->latest_version();
-    const auto updated = update_query(
-      query_info.publisher,
-      query_info.query,
-      query_info.last_sent_version,
-      false);
+//==============================================================================
+void ScheduleNode::update_snapshots()
+{
+  std::vector<PendingMirrorUpdatePtr> snapshots;
+  {
+    std::lock_guard<std::mutex> lock(database_mutex);
 
-    if (updated)
+    // Queries with identical parameters will share the same snapshot
+    mirror_update_cache.clear();
+    for (auto& [_, query_info] : registered_queries)
     {
-      // Update the latest version sent to this topic
-      query_info.last_sent_version = database->latest_version();
+      const auto& snapshot = query_info.snapshot;
+      if (snapshot
+        && snapshot->msg.database_version == database->latest_version())
+      {
+        // Nothing has changed since the last snapshot
+        continue;
+      }
 
-      RCLCPP_DEBUG(
-        get_logger(),
-        "[ScheduleNode::update_mirrors] Updated query [%ld]",
-        query_id);
+      auto update = prepare_mirror_update(query_info.query, std::nullopt, true);
+      query_info.snapshot = update;
+      snapshots.push_back(std::move(update));
     }
+    mirror_update_cache.clear();
   }
 
-  conflict_check_cv.notify_all();
+  // Convert the snapshots now so that this does not need to happen when a
+  // mirror asks for one.
+  for (const auto& snapshot : snapshots)
+    snapshot->get_msg(metrics.get());
 }
 
 //==============================================================================
-bool ScheduleNode::update_query(
-  const MirrorUpdateTopicPublisher& publisher,
+const ScheduleNode::MirrorUpdate&
+ScheduleNode::PendingMirrorUpdate::get_msg(Metrics* metrics)
+{
+  std::call_once(
+    convert_once, [&]()
+    {
+      const ScopeTimer timer(metrics, "mirror_update_conversion_time");
+      msg.patch = rmf_traffic_ros2::convert(*patch);
+      if (metrics)
+        metrics->record(
+          "mirror_update_patch_size", static_cast<double>(patch->size()));
+    });
+
+  return msg;
+}
+
+//==============================================================================
+const CompactMirrorUpdate&
+ScheduleNode::PendingMirrorUpdate::get_compact_msg(Metrics* metrics)
+{
+  const auto& full = get_msg(metrics);
+  std::call_once(
+    compact_once, [&]()
+    {
+      const ScopeTimer timer(metrics, "mirror_update_compaction_time");
+      compact_msg.data = encode_compact(full);
+      if (metrics)
+      {
+        metrics->increment(
+          "mirror_update_compact_bytes", compact_msg.data.size());
+      }
+    });
+
+  return compact_msg;
+}
+
+//==============================================================================
+ScheduleNode::PendingMirrorUpdatePtr ScheduleNode::prepare_mirror_update(
   const rmf_traffic::schedule::Query& query,
   VersionOpt last_sent_version,
   bool is_remedial)
 {
-  const auto patch = database->changes(query, last_sent_version);
+  for (const auto& cached : mirror_update_cache)
+  {
+    if (cached->is_remedial != is_remedial)
+      continue;
 
-  if (!is_remedial && patch.size() == 0 && !patch.cull())
-    return false;
+    if (cached->last_sent_version != last_sent_version)
+      continue;
 
-  rmf_traffic_msgs::msg::MirrorUpdate msg;
-  msg.node_id = node_id;
-  msg.database_version = database->latest_version();
-  msg.patch = rmf_traffic_ros2::convert(patch);
-  msg.is_remedial_update = is_remedial;
-  publisher->publish(msg);
+    if (!(cached->query == query))
+      continue;
+
+    ++mirror_update_cache_hits;
+    return cached;
+  }
+
+  ++mirror_update_cache_misses;
+  auto update = std::make_shared<PendingMirrorUpdate>();
+  update->query = query;
+  update->last_sent_version = last_sent_version;
+  update->is_remedial = is_remedial;
+  update->msg.node_id = node_id;
+  update->msg.database_version = database->latest_version();
+  update->msg.is_remedial_update = is_remedial;
+
+  auto patch = database->changes(query, last_sent_version);
+  if (is_remedial || patch.size() > 0 || patch.cull())
+    update->patch = std::move(patch);
+
+  mirror_update_cache.push_back(update);
+  return update;
+}
+
+//==============================================================================
+void ScheduleNode::publish_mirror_update(
+  const uint64_t query_id,
+  const MirrorUpdateTopicPublisher& publisher,
+  const CompactMirrorUpdateTopicPublisher& compact_publisher,
+  const PendingMirrorUpdatePtr& update)
+{
+  if (!update->patch.has_value())
+    return;
+
+  // Only send the formats that some mirror is listening for. The regular
+  // format is always sent unless every mirror has chosen the compact one.
+  const auto send = [publisher, compact_publisher, metrics = metrics](
+    const PendingMirrorUpdatePtr& update)
+    {
+      const bool want_compact = compact_publisher->get_subscription_count() > 0;
+      if (!want_compact || publisher->get_subscription_count() > 0)
+        publisher->publish(update->get_msg(metrics.get()));
+
+      if (want_compact)
+        compact_publisher->publish(update->get_compact_msg(metrics.get()));
+    };
+
+  const bool handoff = intra_process_patch_handoff;
+  const auto offer = [query_id, handoff](const PendingMirrorUpdatePtr& update)
+    {
+      if (!handoff)
+        return;
+
+      // Alias the patch to the update that owns it
+      PatchHandoff::get().offer(
+        query_id, update->msg, PatchHandoff::PatchPtr(update, &*update->patch));
+    };
+
+  if (!mirror_update_pool)
+  {
+    update->get_msg(metrics.get());
+    offer(update);
+    send(update);
+    return;
+  }
 
-  return true;
+  mirror_update_pool->post(
+    query_id,
+    [update, offer, send, metrics = metrics, logger = get_logger(),
+    query_id]()
+    {
+      try
+      {
+        update->get_msg(metrics.get());
+        offer(update);
+        send(update);
+      }
+      catch (const std::exception& e)
+      {
+        RCLCPP_ERROR(
+          logger,
+          "[ScheduleNode::publish_mirror_update] Failed to publish mirror "
+          "update for query [%lu]: %s",
+          query_id,
+          e.what());
+      }
+    });
 }
 
 //==============================================================================
@@ -1450,7 +2906,134 @@ void ScheduleNode::refuse(std::size_t conflict_version)
   conclusion.conflict_version = conflict_version;
   conclusion.resolved = false;
   conflict_conclusion_pub->publish(conclusion);
-  publish_negotiation_states();
+  request_negotiation_states();
+
+  if (metrics)
+    metrics->increment("negotiations_failed");
+}
+
+//==============================================================================
+void ScheduleNode::resolve(std::size_t conflict_version)
+{
+  auto* open = active_conflicts.negotiation(conflict_version);
+  if (!open)
+    return;
+
+  auto& negotiation = open->room.negotiation;
+  const auto choose =
+    negotiation.evaluate(rmf_traffic::schedule::QuickestFinishEvaluator());
+  assert(choose);
+
+  active_conflicts.conclude(
+    conflict_version, rmf_traffic_ros2::convert(now()));
+
+  ConflictConclusion conclusion;
+  conclusion.conflict_version = conflict_version;
+  conclusion.resolved = true;
+  conclusion.table = rmf_traffic_ros2::convert(choose->sequence());
+
+  std::string output = "Resolved negotiation ["
+    + std::to_string(conflict_version) + "]:";
+
+  for (const auto p : conclusion.table)
+    output += " " + std::to_string(p.participant) + ":" + std::to_string(
+      p.version);
+  RCLCPP_INFO(get_logger(), "%s", output.c_str());
+
+  conflict_conclusion_pub->publish(std::move(conclusion));
+
+  if (metrics)
+    metrics->increment("negotiations_resolved");
+}
+
+//==============================================================================
+bool ScheduleNode::should_resolve(
+  const rmf_traffic::schedule::Negotiation& negotiation,
+  const std::unordered_map<ParticipantId, rmf_traffic::Time>& finish_times)
+const
+{
+  if (negotiation_settle_time == std::chrono::nanoseconds(0))
+    return true;
+
+  // There is nothing left to wait for
+  if (negotiation.complete())
+    return true;
+
+  const auto choose =
+    negotiation.evaluate(rmf_traffic::schedule::QuickestFinishEvaluator());
+  if (!choose)
+    return false;
+
+  double total_delay = 0.0;
+  for (const auto& submission : choose->proposal())
+  {
+    const auto f_it = finish_times.find(submission.participant);
+    if (f_it == finish_times.end())
+      continue;
+
+    std::optional<rmf_traffic::Time> finish;
+    for (const auto& route : submission.itinerary)
+    {
+      const auto* route_finish = route.trajectory().finish_time();
+      if (route_finish && (!finish.has_value() || *finish < *route_finish))
+        finish = *route_finish;
+    }
+
+    if (finish.has_value() && f_it->second < *finish)
+      total_delay += rmf_traffic::time::to_seconds(*finish - f_it->second);
+  }
+
+  return total_delay <= negotiation_quality_bound;
+}
+
+//==============================================================================
+void ScheduleNode::check_negotiation_deadlines()
+{
+  std::lock_guard<std::mutex> lock(active_conflicts_mutex);
+  const auto time = rmf_traffic_ros2::convert(now());
+  const auto zero = std::chrono::nanoseconds(0);
+
+  std::vector<Version> resolve_negotiations;
+  std::vector<Version> refuse_negotiations;
+  for (auto& [v, open] : active_conflicts._negotiations)
+  {
+    if (!open.has_value())
+      continue;
+
+    const bool past_deadline = negotiation_deadline > zero
+      && open->start_time + negotiation_deadline < time;
+
+    if (!open->room.negotiation.ready())
+    {
+      // A rejection may have taken away the feasible proposal set
+      open->ready_time = std::nullopt;
+      if (past_deadline)
+        refuse_negotiations.push_back(v);
+
+      continue;
+    }
+
+    if (!open->ready_time.has_value())
+      open->ready_time = time;
+
+    if (past_deadline || *open->ready_time + negotiation_settle_time <= time)
+      resolve_negotiations.push_back(v);
+  }
+
+  for (const auto v : resolve_negotiations)
+    resolve(v);
+
+  for (const auto v : refuse_negotiations)
+  {
+    RCLCPP_WARN(
+      get_logger(),
+      "Refusing negotiation [%lu] because it passed its deadline without "
+      "finding a feasible proposal set", v);
+    refuse(v);
+  }
+
+  if (!resolve_negotiations.empty())
+    request_negotiation_states();
 }
 
 //==============================================================================
@@ -1503,30 +3086,16 @@ void ScheduleNode::receive_proposal(const ConflictProposal& msg)
 
   if (negotiation.ready())
   {
-    // TODO(MXG): If the negotiation is not complete yet, give some time for
-    // more proposals to arrive before choosing one.
-    const auto choose =
-      negotiation.evaluate(rmf_traffic::schedule::QuickestFinishEvaluator());
-    assert(choose);
-
-    active_conflicts.conclude(
-      msg.conflict_version, rmf_traffic_ros2::convert(now()));
-
-    ConflictConclusion conclusion;
-    conclusion.conflict_version = msg.conflict_version;
-    conclusion.resolved = true;
-    conclusion.table = rmf_traffic_ros2::convert(choose->sequence());
-
-    std::string output = "Resolved negotiation ["
-      + std::to_string(msg.conflict_version) + "]:";
-
-    for (const auto p : conclusion.table)
-      output += " " + std::to_string(p.participant) + ":" + std::to_string(
-        p.version);
-    RCLCPP_INFO(get_logger(), "%s", output.c_str());
-
-    conflict_conclusion_pub->publish(std::move(conclusion));
-//    print_conclusion(active_conflicts._waiting);
+    if (should_resolve(negotiation, open->finish_times))
+    {
+      resolve(msg.conflict_version);
+    }
+    else if (!open->ready_time.has_value())
+    {
+      // Give some time for more proposals to arrive before choosing one. The
+      // deadline timer will conclude the negotiation if they do not.
+      open->ready_time = open->last_active_time;
+    }
   }
   else if (negotiation.complete())
   {
@@ -1544,9 +3113,12 @@ void ScheduleNode::receive_proposal(const ConflictProposal& msg)
 
     conflict_conclusion_pub->publish(conclusion);
 //    print_conclusion(active_conflicts._waiting);
+
+    if (metrics)
+      metrics->increment("negotiations_failed");
   }
 
-  publish_negotiation_states();
+  request_negotiation_states();
 }
 
 //==============================================================================
@@ -1594,7 +3166,7 @@ void ScheduleNode::receive_rejection(const ConflictRejection& msg)
     negotiation);
   open->update_state_msg(msg.conflict_version);
 
-  publish_negotiation_states();
+  request_negotiation_states();
 }
 
 //==============================================================================
@@ -1638,7 +3210,13 @@ void ScheduleNode::receive_forfeit(const ConflictForfeit& msg)
     negotiation);
   open->update_state_msg(msg.conflict_version);
 
-  if (negotiation.complete())
+  if (negotiation.complete() && negotiation.ready())
+  {
+    // A feasible proposal set was found while the negotiation was waiting for
+    // more proposals, and this forfeit ended the exploration.
+    resolve(msg.conflict_version);
+  }
+  else if (negotiation.complete())
   {
     std::string output = "Forfeited negotiation ["
       + std::to_string(msg.conflict_version) + "]";
@@ -1653,9 +3231,24 @@ void ScheduleNode::receive_forfeit(const ConflictForfeit& msg)
 
     conflict_conclusion_pub->publish(conclusion);
 //    print_conclusion(active_conflicts._waiting);
+
+    if (metrics)
+      metrics->increment("negotiations_failed");
+  }
+
+  request_negotiation_states();
+}
+
+//==============================================================================
+void ScheduleNode::request_negotiation_states()
+{
+  if (negotiation_states_period == std::chrono::nanoseconds(0))
+  {
+    publish_negotiation_states();
+    return;
   }
 
-  publish_negotiation_states();
+  negotiation_states_pending = true;
 }
 
 //==============================================================================
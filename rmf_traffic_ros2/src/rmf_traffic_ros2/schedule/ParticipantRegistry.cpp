@@ -16,6 +16,8 @@
 */
 
 #include <mutex>
+#include <optional>
+#include <unordered_map>
 #include <rmf_traffic_ros2/schedule/ParticipantRegistry.hpp>
 #include <rmf_traffic_ros2/schedule/ParticipantDescription.hpp>
 #include "internal_YamlSerialization.hpp"
@@ -26,24 +28,51 @@ namespace rmf_traffic_ros2 {
 namespace schedule {
 
 //==============================================================================
-struct UniqueId
+/// Participant IDs indexed by owner and then by name. Looking a participant
+/// up only hashes the owner and name that are already in its description, so
+/// registering participants and replaying the log never has to build a
+/// combined key string. It also keeps pairs like ("ab", "c") and ("a", "bc")
+/// apart, which a concatenated key would hash identically.
+class ParticipantIndex
 {
-  std::string name;
-  std::string owner;
+public:
+  std::optional<ParticipantId> find(
+    const std::string& owner,
+    const std::string& name) const
+  {
+    const auto owner_it = _ids.find(owner);
+    if (owner_it == _ids.end())
+      return std::nullopt;
+
+    const auto name_it = owner_it->second.find(name);
+    if (name_it == owner_it->second.end())
+      return std::nullopt;
 
-  bool operator==(const UniqueId& other) const
+    return name_it->second;
+  }
+
+  void insert(
+    const std::string& owner,
+    const std::string& name,
+    const ParticipantId id)
   {
-    return name == other.name && owner == other.owner;
+    _ids[owner].insert_or_assign(name, id);
   }
-};
 
-//==============================================================================
-struct UniqueIdHasher
-{
-  std::size_t operator()(UniqueId id) const
+  void erase(const std::string& owner, const std::string& name)
   {
-    return std::hash<std::string>{}(id.name + id.owner);
+    const auto owner_it = _ids.find(owner);
+    if (owner_it == _ids.end())
+      return;
+
+    owner_it->second.erase(name);
+    if (owner_it->second.empty())
+      _ids.erase(owner_it);
   }
+
+private:
+  std::unordered_map<std::string,
+    std::unordered_map<std::string, ParticipantId>> _ids;
 };
 
 //==============================================================================
@@ -75,12 +104,12 @@ public:
     ParticipantDescription new_description)
   {
     std::lock_guard<std::mutex> lock(_mutex);
-    const UniqueId key = {new_description.name(), new_description.owner()};
-    const auto it = _id_from_name.find(key);
+    const auto existing = _id_from_name.find(
+      new_description.owner(), new_description.name());
 
-    if (it != _id_from_name.end())
+    if (existing.has_value())
     {
-      const auto id = it->second;
+      const auto id = *existing;
       auto& description_entry = _description.at(id);
 
       // Check if footprint has changed
@@ -99,10 +128,14 @@ public:
     }
 
     const auto registration = _database->register_participant(new_description);
-    _id_from_name[key] = registration.id();
-    _description.insert_or_assign(registration.id(), new_description);
+    _id_from_name.insert(
+      new_description.owner(), new_description.name(), registration.id());
 
-    write_to_file({AtomicOperation::OpType::Add, new_description});
+    if (!_reading_from_log)
+      write_to_file({AtomicOperation::OpType::Add, new_description});
+
+    _description.insert_or_assign(
+      registration.id(), std::move(new_description));
     return registration;
   }
 
@@ -111,13 +144,7 @@ public:
     const std::string& name,
     const std::string& owner)
   {
-    UniqueId key = {name, owner};
-    auto id = _id_from_name.find(key);
-    if (id == _id_from_name.end())
-    {
-      return std::nullopt;
-    }
-    return {id->second};
+    return _id_from_name.find(owner, name);
   }
 
   // Friendship for the sake of testing
@@ -148,12 +175,12 @@ private:
     if (operation.operation == AtomicOperation::OpType::Add
       || operation.operation == AtomicOperation::OpType::Update)
     {
-      add_or_retrieve_participant(operation.description);
+      add_or_retrieve_participant(std::move(operation.description));
     }
   }
 
   //==========================================================================
-  std::unordered_map<UniqueId, ParticipantId, UniqueIdHasher> _id_from_name;
+  ParticipantIndex _id_from_name;
   std::unordered_map<ParticipantId, ParticipantDescription> _description;
   std::shared_ptr<Database> _database;
   std::unique_ptr<AbstractParticipantLogger> _logger;
@@ -206,15 +233,14 @@ bool mockup_modify_last_participant_id(ParticipantRegistry& registry)
     return false;
 
   const auto old_id = *highest_id;
-  auto unique_id = UniqueId{desc->name(), desc->owner()};
-  impl._id_from_name.erase(unique_id);
+  impl._id_from_name.erase(desc->owner(), desc->name());
   impl._description.erase(old_id);
 
   impl._database->unregister_participant(old_id);
   const auto registration = impl._database->register_participant(*desc);
   const auto new_id = registration.id();
 
-  impl._id_from_name[unique_id] = new_id;
+  impl._id_from_name.insert(desc->owner(), desc->name(), new_id);
   impl._description.insert({new_id, *desc});
 
   return true;
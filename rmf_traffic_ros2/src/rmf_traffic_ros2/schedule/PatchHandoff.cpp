@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "internal_PatchHandoff.hpp"
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+PatchHandoff& PatchHandoff::get()
+{
+  static PatchHandoff instance;
+  return instance;
+}
+
+//==============================================================================
+void PatchHandoff::offer(
+  const uint64_t query_id,
+  const rmf_traffic_msgs::msg::MirrorUpdate& msg,
+  PatchPtr patch)
+{
+  auto key = _make_key(query_id, msg);
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto insertion = _patches.insert_or_assign(key, std::move(patch));
+  if (!insertion.second)
+    return;
+
+  _order.emplace_back(std::move(key));
+  while (_order.size() > capacity)
+  {
+    _patches.erase(_order.front());
+    _order.pop_front();
+  }
+}
+
+//==============================================================================
+auto PatchHandoff::find(
+  const uint64_t query_id,
+  const rmf_traffic_msgs::msg::MirrorUpdate& msg) const -> PatchPtr
+{
+  const auto key = _make_key(query_id, msg);
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto it = _patches.find(key);
+  if (it == _patches.end())
+    return nullptr;
+
+  return it->second;
+}
+
+//==============================================================================
+auto PatchHandoff::_make_key(
+  const uint64_t query_id,
+  const rmf_traffic_msgs::msg::MirrorUpdate& msg) -> Key
+{
+  return Key{
+    msg.node_id.node_uuid,
+    query_id,
+    msg.patch.has_base_version,
+    msg.patch.has_base_version ? msg.patch.base_version : 0,
+    msg.patch.latest_version,
+    msg.is_remedial_update
+  };
+}
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "internal_RouteBounds.hpp"
+
+#include <algorithm>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+namespace {
+//==============================================================================
+void expand(RouteBounds& bounds, const Eigen::Vector3d& p)
+{
+  bounds.min_x = std::min(bounds.min_x, p[0]);
+  bounds.min_y = std::min(bounds.min_y, p[1]);
+  bounds.max_x = std::max(bounds.max_x, p[0]);
+  bounds.max_y = std::max(bounds.max_y, p[1]);
+}
+} // anonymous namespace
+
+//==============================================================================
+std::optional<RouteBounds> RouteBounds::make(
+  const rmf_traffic::Trajectory& trajectory)
+{
+  if (trajectory.size() == 0)
+    return std::nullopt;
+
+  const auto& first = trajectory.front();
+  const Eigen::Vector3d p0 = first.position();
+  RouteBounds bounds{
+    p0[0], p0[1], p0[0], p0[1],
+    *trajectory.start_time(),
+    *trajectory.finish_time()
+  };
+
+  auto it = trajectory.begin();
+  auto last = it;
+  ++it;
+  for (; it != trajectory.end(); ++it, ++last)
+  {
+    const double dt = rmf_traffic::time::to_seconds(it->time() - last->time());
+    const Eigen::Vector3d p_start = last->position();
+    const Eigen::Vector3d p_finish = it->position();
+
+    // A cubic Hermite segment is contained in the convex hull of its
+    // equivalent Bezier control points.
+    expand(bounds, p_start + last->velocity() * dt / 3.0);
+    expand(bounds, p_finish - it->velocity() * dt / 3.0);
+    expand(bounds, p_finish);
+  }
+
+  return bounds;
+}
+
+//==============================================================================
+bool RouteBounds::may_overlap(
+  const double radius,
+  const RouteBounds& other,
+  const double other_radius) const
+{
+  if (finish_time < other.start_time || other.finish_time < start_time)
+    return false;
+
+  const double r = radius + other_radius;
+  if (max_x + r < other.min_x || other.max_x + r < min_x)
+    return false;
+
+  if (max_y + r < other.min_y || other.max_y + r < min_y)
+    return false;
+
+  return true;
+}
+
+//==============================================================================
+double profile_radius(const rmf_traffic::Profile& profile)
+{
+  double radius = 0.0;
+  if (const auto& footprint = profile.footprint())
+    radius = std::max(radius, footprint->get_characteristic_length());
+
+  if (const auto& vicinity = profile.vicinity())
+    radius = std::max(radius, vicinity->get_characteristic_length());
+
+  return radius;
+}
+
+//==============================================================================
+const std::optional<RouteBounds>& RouteBoundsCache::insert(
+  const ConstRoutePtr& route)
+{
+  const auto insertion = _entries.insert({route.get(), Entry{route, {}}});
+  if (insertion.second)
+    insertion.first->second.bounds = RouteBounds::make(route->trajectory());
+
+  return insertion.first->second.bounds;
+}
+
+//==============================================================================
+const std::optional<RouteBounds>* RouteBoundsCache::find(
+  const rmf_traffic::Route* route) const
+{
+  const auto it = _entries.find(route);
+  if (it == _entries.end())
+    return nullptr;
+
+  return &it->second.bounds;
+}
+
+//==============================================================================
+void RouteBoundsCache::prune()
+{
+  auto it = _entries.begin();
+  while (it != _entries.end())
+  {
+    if (it->second.route.use_count() <= 1)
+      it = _entries.erase(it);
+    else
+      ++it;
+  }
+}
+
+//==============================================================================
+std::size_t RouteBoundsCache::size() const
+{
+  return _entries.size();
+}
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
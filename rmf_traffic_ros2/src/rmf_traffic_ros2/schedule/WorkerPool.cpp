@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "internal_WorkerPool.hpp"
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+WorkerPool::WorkerPool(std::size_t num_threads)
+: _quit(false)
+{
+  if (num_threads == 0)
+    num_threads = 1;
+
+  _workers.reserve(num_threads);
+  for (std::size_t i = 0; i < num_threads; ++i)
+    _workers.emplace_back(std::make_unique<Worker>());
+
+  // Launch the threads only after every worker has been constructed so that
+  // the vector does not get modified while any of them are running.
+  for (const auto& worker : _workers)
+  {
+    Worker* const w = worker.get();
+    w->thread = std::thread([this, w]() { this->_run(*w); });
+  }
+}
+
+//==============================================================================
+void WorkerPool::post(const std::size_t key, Job job)
+{
+  auto& worker = *_workers[key % _workers.size()];
+  {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.queue.emplace_back(std::move(job));
+  }
+  worker.cv.notify_one();
+}
+
+//==============================================================================
+std::size_t WorkerPool::size() const
+{
+  return _workers.size();
+}
+
+//==============================================================================
+WorkerPool::~WorkerPool()
+{
+  _quit = true;
+  for (const auto& worker : _workers)
+  {
+    {
+      // Lock the mutex so the notification cannot slip in between a worker
+      // checking _quit and beginning its wait.
+      std::lock_guard<std::mutex> lock(worker->mutex);
+    }
+    worker->cv.notify_all();
+  }
+
+  for (const auto& worker : _workers)
+  {
+    if (worker->thread.joinable())
+      worker->thread.join();
+  }
+}
+
+//==============================================================================
+void WorkerPool::_run(Worker& worker)
+{
+  while (!_quit)
+  {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(worker.mutex);
+      worker.cv.wait(lock, [&]() { return _quit || !worker.queue.empty(); });
+
+      if (_quit)
+        return;
+
+      job = std::move(worker.queue.front());
+      worker.queue.pop_front();
+    }
+
+    job();
+  }
+}
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
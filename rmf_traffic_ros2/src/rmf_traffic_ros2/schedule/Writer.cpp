@@ -28,6 +28,7 @@
 #include <rmf_traffic_msgs/msg/itinerary_clear.hpp>
 
 #include <rmf_traffic_msgs/msg/schedule_inconsistency.hpp>
+#include <rmf_traffic_msgs/msg/participant.hpp>
 #include <rmf_traffic_msgs/msg/participants.hpp>
 
 #include <rmf_traffic_msgs/srv/register_participant.hpp>
@@ -35,6 +36,13 @@
 
 #include <rmf_utils/RateLimiter.hpp>
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+
 using namespace std::chrono_literals;
 
 namespace rmf_traffic_ros2 {
@@ -53,6 +61,20 @@ rmf_traffic::schedule::Writer::Registration convert(
 namespace schedule {
 
 namespace {
+//==============================================================================
+// The most itinerary versions of a participant that get retransmitted in
+// response to one inconsistency report. Whatever is left out will be reported
+// again by the schedule once this burst has arrived.
+constexpr std::size_t max_retransmit_versions = 64;
+
+// How long to wait before retransmitting the same versions again if the
+// schedule keeps reporting them as missing. This doubles every time the same
+// versions are reported, up to the maximum.
+constexpr rmf_traffic::Duration initial_retransmit_backoff =
+  std::chrono::milliseconds(200);
+constexpr rmf_traffic::Duration max_retransmit_backoff =
+  std::chrono::seconds(10);
+
 //==============================================================================
 class RectifierFactory
   : public rmf_traffic::schedule::RectificationRequesterFactory
@@ -79,6 +101,12 @@ public:
     // that might indicate that there are conflicting upstream participant
     // sources.
     rmf_utils::RateLimiter correction_limiter;
+
+    // The versions that were retransmitted most recently, and when they may be
+    // retransmitted again
+    std::vector<rmf_traffic::schedule::Rectifier::Range> last_retransmitted;
+    std::chrono::steady_clock::time_point next_retransmit;
+    rmf_traffic::Duration backoff = initial_retransmit_backoff;
   };
 
   using RectifierMap = std::unordered_map<
@@ -90,6 +118,7 @@ public:
 
   using InconsistencyMsg = rmf_traffic_msgs::msg::ScheduleInconsistency;
   using ParticipantsInfoMsg = rmf_traffic_msgs::msg::Participants;
+  using ParticipantInfoMsg = rmf_traffic_msgs::msg::Participant;
 
   std::unique_ptr<rmf_traffic::schedule::RectificationRequester> make(
     rmf_traffic::schedule::Rectifier rectifier,
@@ -125,12 +154,57 @@ public:
       return;
     }
 
+    // Only retransmit a bounded burst of the missing versions, starting from
+    // the oldest ones since the schedule cannot apply anything newer until
+    // those arrive.
     using Range = rmf_traffic::schedule::Rectifier::Range;
     std::vector<Range> ranges;
     ranges.reserve(msg.ranges.size());
+    std::size_t budget = max_retransmit_versions;
     for (const auto& r : msg.ranges)
-      ranges.emplace_back(Range{r.lower, r.upper});
+    {
+      if (budget == 0)
+        break;
+
+      const std::size_t count = static_cast<std::size_t>(r.upper - r.lower) + 1;
+      if (count <= budget)
+      {
+        ranges.emplace_back(Range{r.lower, r.upper});
+        budget -= count;
+      }
+      else
+      {
+        ranges.emplace_back(Range{r.lower, r.lower + (budget - 1)});
+        budget = 0;
+      }
+    }
+
+    // On a lossy link the schedule may report the same missing versions again
+    // before our retransmission has had a chance to arrive, so back off
+    // exponentially while the same versions keep getting reported.
+    const auto now = std::chrono::steady_clock::now();
+    const bool same_ranges = ranges.size() == stub->last_retransmitted.size()
+      && std::equal(
+      ranges.begin(), ranges.end(), stub->last_retransmitted.begin(),
+      [](const Range& a, const Range& b)
+      {
+        return a.lower == b.lower && a.upper == b.upper;
+      });
+
+    if (same_ranges)
+    {
+      if (now < stub->next_retransmit)
+        return;
+
+      stub->backoff = std::min(2 * stub->backoff, max_retransmit_backoff);
+    }
+    else
+    {
+      stub->backoff = initial_retransmit_backoff;
+      stub->last_retransmitted = ranges;
+    }
 
+    stub->next_retransmit = now + stub->backoff;
     stub->rectifier.retransmit(
       ranges, msg.last_known_itinerary, msg.last_known_progress);
   }
@@ -148,6 +222,18 @@ public:
   {
     std::vector<std::weak_ptr<RectifierData>> incorrect_descriptions;
     std::vector<ChangeID> incorrect_ids;
+
+    // Index the participants of the message by owner and name so that each of
+    // our participants can be found without scanning the whole message.
+    std::unordered_map<std::string,
+      std::unordered_map<std::string, const ParticipantInfoMsg*>>
+    remote_participants;
+    for (const auto& participant : msg.participants)
+    {
+      const auto& remote_desc = participant.description;
+      remote_participants[remote_desc.owner][remote_desc.name] = &participant;
+    }
+
     for (const auto& s : rectifier_map)
     {
       const auto stub = s.second.lock();
@@ -163,17 +249,21 @@ public:
 
       const auto& local_desc = *local_desc_opt;
 
-      auto p = std::find_if(
-        msg.participants.begin(),
-        msg.participants.end(),
-        [&local_desc](const auto& participant)
+      const ParticipantInfoMsg* const p =
+        [&]() -> const ParticipantInfoMsg*
         {
-          const auto& remote_desc = participant.description;
-          return local_desc.owner() == remote_desc.owner
-          && local_desc.name() == remote_desc.name;
-        });
+          const auto o_it = remote_participants.find(local_desc.owner());
+          if (o_it == remote_participants.end())
+            return nullptr;
+
+          const auto n_it = o_it->second.find(local_desc.name());
+          if (n_it == o_it->second.end())
+            return nullptr;
 
-      if (p == msg.participants.end())
+          return n_it->second;
+        }();
+
+      if (!p)
       {
         if (!stub->correction_limiter.reached_limit())
         {
@@ -250,7 +340,10 @@ RectifierFactory::Requester::Requester(
 : data(std::make_shared<RectifierData>(
       RectifierData{
         std::move(rectifier_),
-        rmf_utils::RateLimiter(1min, 3)
+        rmf_utils::RateLimiter(1min, 3),
+        {},
+        std::chrono::steady_clock::time_point(),
+        initial_retransmit_backoff
       }))
 {
   // Do nothing
@@ -303,6 +396,22 @@ public:
 
     std::weak_ptr<rclcpp::Node> weak_node;
 
+    // Changes that are waiting for the end of the batch window
+    using Change = std::variant<Set, Extend, Delay, Reached, Clear>;
+    std::mutex pending_mutex;
+    std::vector<Change> pending;
+    rclcpp::TimerBase::SharedPtr batch_timer;
+
+    // Held while changes are published, so they go out in the order that they
+    // were made even when the batch window is being turned off. This is always
+    // locked before pending_mutex.
+    std::mutex publish_mutex;
+
+    // The latest progress report of each participant, held until the end of
+    // the reached window or until the itinerary of the participant changes
+    std::unordered_map<ParticipantId, Reached> held_reached;
+    rclcpp::TimerBase::SharedPtr reached_timer;
+
     static std::shared_ptr<Transport> make(
       const std::shared_ptr<rclcpp::Node>& node)
     {
@@ -384,7 +493,7 @@ public:
       const StorageId storage,
       const rmf_traffic::schedule::ItineraryVersion version) final
     {
-      set_pub->publish(
+      send(
         rmf_traffic_msgs::build<Set>()
         .participant(participant)
         .plan(plan)
@@ -398,7 +507,7 @@ public:
       const Itinerary& routes,
       const rmf_traffic::schedule::ItineraryVersion version) final
     {
-      extend_pub->publish(
+      send(
         rmf_traffic_msgs::build<Extend>()
         .participant(participant)
         .routes(convert(routes))
@@ -410,7 +519,7 @@ public:
       const rmf_traffic::Duration duration,
       const rmf_traffic::schedule::ItineraryVersion version) final
     {
-      delay_pub->publish(
+      send(
         rmf_traffic_msgs::build<Delay>()
         .participant(participant)
         .delay(duration.count())
@@ -423,7 +532,7 @@ public:
       const std::vector<CheckpointId>& reached_checkpoints,
       const ProgressVersion version) final
     {
-      reached_pub->publish(
+      send(
         rmf_traffic_msgs::build<Reached>()
         .participant(participant)
         .plan(plan)
@@ -435,17 +544,212 @@ public:
       const rmf_traffic::schedule::ParticipantId participant,
       const rmf_traffic::schedule::ItineraryVersion version) final
     {
-      clear_pub->publish(
+      send(
         rmf_traffic_msgs::build<Clear>()
         .participant(participant)
         .itinerary_version(version));
     }
 
+    template<typename Message>
+    void send(Message msg)
+    {
+      std::lock_guard<std::mutex> publish_lock(publish_mutex);
+      std::optional<Reached> held;
+      {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        if constexpr (std::is_same_v<Message, Reached>)
+        {
+          if (reached_timer)
+          {
+            held_reached[msg.participant] = std::move(msg);
+            return;
+          }
+        }
+        else
+        {
+          // Progress that was reported before an itinerary change needs to be
+          // sent before the change.
+          const auto r_it = held_reached.find(msg.participant);
+          if (r_it != held_reached.end())
+          {
+            held = std::move(r_it->second);
+            held_reached.erase(r_it);
+          }
+        }
+
+        if (batch_timer)
+        {
+          if (held.has_value())
+            pending.emplace_back(std::move(*held));
+
+          pending.emplace_back(std::move(msg));
+          return;
+        }
+      }
+
+      if (held.has_value())
+        publish(*held);
+
+      publish(msg);
+    }
+
+    void release_reached()
+    {
+      std::lock_guard<std::mutex> publish_lock(publish_mutex);
+      std::unordered_map<ParticipantId, Reached> reached;
+      {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        reached.swap(held_reached);
+        if (batch_timer)
+        {
+          for (auto& [_, msg] : reached)
+            pending.emplace_back(std::move(msg));
+
+          return;
+        }
+      }
+
+      for (const auto& [_, msg] : reached)
+        publish(msg);
+    }
+
+    void publish(const Change& change)
+    {
+      std::visit([this](const auto& msg) { publish(msg); }, change);
+    }
+
+    void publish(const Set& msg) { set_pub->publish(msg); }
+    void publish(const Extend& msg) { extend_pub->publish(msg); }
+    void publish(const Delay& msg) { delay_pub->publish(msg); }
+    void publish(const Reached& msg) { reached_pub->publish(msg); }
+    void publish(const Clear& msg) { clear_pub->publish(msg); }
+
+    void flush()
+    {
+      std::lock_guard<std::mutex> publish_lock(publish_mutex);
+      flush_pending();
+    }
+
+    // publish_mutex must be locked while calling this
+    void flush_pending()
+    {
+      std::vector<Change> changes;
+      {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        changes.swap(pending);
+      }
+
+      if (changes.empty())
+        return;
+
+      // The schedule only keeps the newest progress of each plan, so a
+      // progress report that is followed by another one for the same plan
+      // does not need to be sent. Itinerary changes cannot be collapsed
+      // because the schedule expects every itinerary version to arrive.
+      std::unordered_map<ParticipantId, PlanId> latest_reached;
+      std::vector<bool> superseded(changes.size(), false);
+      for (std::size_t i = changes.size(); i > 0; --i)
+      {
+        const auto* reached = std::get_if<Reached>(&changes[i-1]);
+        if (!reached)
+          continue;
+
+        const auto [it, inserted] =
+          latest_reached.insert({reached->participant, reached->plan});
+        if (!inserted && it->second == reached->plan)
+          superseded[i-1] = true;
+        else
+          it->second = reached->plan;
+      }
+
+      for (std::size_t i = 0; i < changes.size(); ++i)
+      {
+        if (!superseded[i])
+          publish(changes[i]);
+      }
+    }
+
+    void batch_window(std::optional<rmf_traffic::Duration> window)
+    {
+      const auto node = weak_node.lock();
+      rclcpp::TimerBase::SharedPtr timer;
+      if (node && window.has_value())
+      {
+        timer = node->create_wall_timer(
+          *window,
+          [w = weak_from_this()]()
+          {
+            if (const auto self = w.lock())
+              self->flush();
+          });
+      }
+
+      // Keep publish_mutex until the old batch is out, otherwise a change that
+      // is sent right after the timer is removed could be published ahead of
+      // the older changes that are still pending.
+      std::lock_guard<std::mutex> publish_lock(publish_mutex);
+      {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        std::swap(batch_timer, timer);
+      }
+
+      if (timer)
+      {
+        timer->cancel();
+        flush_pending();
+      }
+    }
+
+    void reached_window(std::optional<rmf_traffic::Duration> window)
+    {
+      const auto node = weak_node.lock();
+      rclcpp::TimerBase::SharedPtr timer;
+      if (node && window.has_value())
+      {
+        timer = node->create_wall_timer(
+          *window,
+          [w = weak_from_this()]()
+          {
+            if (const auto self = w.lock())
+              self->release_reached();
+          });
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        std::swap(reached_timer, timer);
+      }
+
+      if (timer)
+      {
+        timer->cancel();
+        release_reached();
+      }
+    }
+
+    // Registrations that have already been received through
+    // async_make_participant, keyed by owner and name
+    using ParticipantKey = std::pair<std::string, std::string>;
+    std::mutex prefetched_mutex;
+    std::map<ParticipantKey, Registration> prefetched;
+
     Registration register_participant(
       rmf_traffic::schedule::ParticipantDescription participant_info) final
     {
       using namespace std::chrono_literals;
 
+      {
+        std::lock_guard<std::mutex> lock(prefetched_mutex);
+        const auto p_it = prefetched.find(
+          {participant_info.owner(), participant_info.name()});
+        if (p_it != prefetched.end())
+        {
+          auto registration = p_it->second;
+          prefetched.erase(p_it);
+          return registration;
+        }
+      }
+
       auto request = std::make_shared<Register::Request>();
       request->description = convert(participant_info);
 
@@ -626,24 +930,49 @@ public:
     rmf_traffic::schedule::ParticipantDescription description,
     std::function<void(rmf_traffic::schedule::Participant)> ready_callback)
   {
-    std::thread worker(
-      [description = std::move(description),
-      this,
-      ready_callback = std::move(ready_callback)]()
+    // Send the registration request right away instead of blocking a thread
+    // on it, so the requests of many participants are in flight together.
+    // Once the response arrives, the participant is created from it without
+    // another round trip.
+    auto request = std::make_shared<Transport::Register::Request>();
+    request->description = convert(description);
+
+    using Response =
+      std::shared_future<std::shared_ptr<Transport::Register::Response>>;
+    std::function<void(Response)> on_response =
+      [this,
+      description = std::move(description),
+      ready_callback = std::move(ready_callback)](const Response& response)
       {
-        // TODO(MXG): We could probably make an implementation of the
-        // RectifierFactory that allows us to pass the ready_callback along to
-        // the service call so that it gets triggered when the service response
-        // is received. That way we don't need to create an additional thread
-        // here and worry about the threat of race conditions.
-        auto participant = rmf_traffic::schedule::make_participant(
-          std::move(description), transport, transport->rectifier_factory);
-
-        if (ready_callback)
-          ready_callback(std::move(participant));
-      });
+        if (response.wait_for(0s) == std::future_status::ready)
+        {
+          const auto msg = response.get();
+          if (msg->error.empty())
+          {
+            std::lock_guard<std::mutex> lock(transport->prefetched_mutex);
+            transport->prefetched.insert_or_assign(
+              {description.owner(), description.name()}, convert(*msg));
+          }
+        }
 
-    worker.detach();
+        // Creating the participant and triggering the callback stay off of
+        // the executor, as before. If the registration failed, this will
+        // request it again and report the error.
+        std::thread worker(
+          [this, description, ready_callback]()
+          {
+            auto participant = rmf_traffic::schedule::make_participant(
+              description, transport, transport->rectifier_factory);
+
+            if (ready_callback)
+              ready_callback(std::move(participant));
+          });
+
+        worker.detach();
+      };
+
+    transport->register_client->async_send_request(
+      std::move(request), std::move(on_response));
   }
 };
 
@@ -700,6 +1029,20 @@ void Writer::async_make_participant(
     std::move(description), std::move(ready_callback));
 }
 
+//==============================================================================
+Writer& Writer::batch_window(std::optional<rmf_traffic::Duration> window)
+{
+  _pimpl->transport->batch_window(window);
+  return *this;
+}
+
+//==============================================================================
+Writer& Writer::reached_window(std::optional<rmf_traffic::Duration> window)
+{
+  _pimpl->transport->reached_window(window);
+  return *this;
+}
+
 //==============================================================================
 Writer::Writer()
 {
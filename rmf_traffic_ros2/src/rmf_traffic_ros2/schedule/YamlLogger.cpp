@@ -16,17 +16,36 @@
 */
 
 #include <rmf_traffic_ros2/schedule/ParticipantRegistry.hpp>
+#include <chrono>
+#include <cstdio>
 #include <filesystem>
 #include <fstream>
 #include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <unistd.h>
 #include "internal_YamlSerialization.hpp"
 
 namespace rmf_traffic_ros2 {
 namespace schedule {
 
+//==============================================================================
+// The log file is an append-only journal: each operation is appended to the
+// end of the file as a new item of the root YAML sequence, so registering or
+// updating a participant only costs one small write. Once the journal has
+// grown to about twice the size it had after it was last compacted, it gets
+// rewritten with only the latest record for each participant.
 class YamlLogger::Implementation
 {
 public:
+  // Journal records to allow beyond twice the compacted size before compacting
+  static constexpr std::size_t compaction_slack = 64;
+
+  // Appends are flushed to the OS right away, but they are only synced to disk
+  // once this many have accumulated or sync_period has passed.
+  static constexpr std::size_t sync_batch_size = 32;
+  static constexpr std::chrono::seconds sync_period = std::chrono::seconds(1);
+
   //===========================================================================
   Implementation(std::string file_path)
   : _file_path(file_path)
@@ -36,47 +55,48 @@ public:
     {
       std::filesystem::create_directories(
         std::filesystem::absolute(file_path).parent_path());
+      _journal = YAML::Node(YAML::NodeType::Sequence);
       _initial_buffer_size = 0;
+      _compacted_size = 0;
       return;
     }
 
     std::lock_guard<std::mutex> file_lock(_mutex);
-    _buffer = YAML::LoadFile(file_path);
-    if (!_buffer.IsSequence())
+    _journal = YAML::LoadFile(file_path);
+    if (!_journal.IsSequence())
     {
       //Malformatted YAML. Failing so that we don't corrupt data
-      throw YAML::ParserException(_buffer.Mark(),
+      throw YAML::ParserException(_journal.Mark(),
               "Malformatted file - Expected the root format of the"\
               " document to be a yaml sequence");
     }
-    _initial_buffer_size = _buffer.size();
+    _initial_buffer_size = _journal.size();
+    _compacted_size = _journal.size();
+  }
+
+  //===========================================================================
+  ~Implementation()
+  {
+    if (_file)
+    {
+      sync();
+      std::fclose(_file);
+    }
   }
 
   //=========================================================================
   void write_operation(AtomicOperation operation)
   {
-    std::string uuid = operation.description.name()
-      + operation.description.owner();
     std::lock_guard<std::mutex> file_lock(_mutex);
+    auto record = serialize(operation);
 
-    if (operation.operation == AtomicOperation::OpType::Update)
-    {
-      auto index = _name_to_index[uuid];
-      AtomicOperation op {
-        AtomicOperation::OpType::Add,
-        operation.description
-      };
-      _buffer[index] = serialize(op);
-    }
-    else if (operation.operation == AtomicOperation::OpType::Add)
-    {
-      auto index = _buffer.size();
-      _name_to_index[uuid] = index;
-      _buffer.push_back(serialize(operation));
-    }
+    YAML::Emitter emitter;
+    emitter << YAML::BeginSeq << record << YAML::EndSeq;
+    append(std::string(emitter.c_str()) + "\n");
+    _journal.push_back(record);
 
-    std::ofstream file(_file_path);
-    file << _buffer;
+    if (_journal.size() >= 2 * _compacted_size + compaction_slack)
+      compact();
   }
 
   //===========================================================================
@@ -88,23 +108,151 @@ public:
       return std::nullopt;
     }
 
-    auto operation = atomic_operation(_buffer[_counter]);
-
-    std::string uuid = operation.description.name() +
-      operation.description.owner();
-
-    _name_to_index[uuid] = _counter;
+    auto operation = atomic_operation(_journal[_counter]);
     ++_counter;
 
     return operation;
   }
 
 private:
-  YAML::Node _buffer; // used when loading the file
+  //===========================================================================
+  void open_for_append()
+  {
+    // Files written by a compaction or by older versions of this logger might
+    // not end with a newline, which the next sequence item needs.
+    bool needs_newline = false;
+    if (std::filesystem::exists(_file_path)
+      && std::filesystem::file_size(_file_path) > 0)
+    {
+      std::ifstream existing(_file_path, std::ios::binary);
+      existing.seekg(-1, std::ios::end);
+      needs_newline = existing.get() != '\n';
+    }
+
+    _file = std::fopen(_file_path.c_str(), "a");
+    if (!_file)
+    {
+      throw std::runtime_error(
+              "[YamlLogger] Unable to open [" + _file_path + "] for writing");
+    }
+
+    if (needs_newline)
+      std::fputc('\n', _file);
+  }
+
+  //===========================================================================
+  void append(const std::string& text)
+  {
+    if (!_file)
+      open_for_append();
+
+    if (std::fwrite(text.data(), 1, text.size(), _file) != text.size()
+      || std::fflush(_file) != 0)
+    {
+      throw std::runtime_error(
+              "[YamlLogger] Failed to append to [" + _file_path + "]");
+    }
+
+    ++_unsynced_writes;
+    const auto now = std::chrono::steady_clock::now();
+    if (_unsynced_writes >= sync_batch_size || _last_sync + sync_period < now)
+      sync();
+  }
+
+  //===========================================================================
+  void sync()
+  {
+    if (_unsynced_writes == 0)
+      return;
+
+    fsync(fileno(_file));
+    _unsynced_writes = 0;
+    _last_sync = std::chrono::steady_clock::now();
+  }
+
+  //===========================================================================
+  void compact()
+  {
+    // Fold the journal down to the latest description of each participant,
+    // keeping the participants in the order they were first added so that
+    // restoring the registry will produce the same participant IDs.
+    YAML::Node compacted(YAML::NodeType::Sequence);
+    // Indexed by owner and then by name so that participants whose names and
+    // owners happen to concatenate into the same string are kept apart.
+    std::unordered_map<std::string,
+      std::unordered_map<std::string, std::size_t>> index;
+    try
+    {
+      for (const auto& record : _journal)
+      {
+        auto operation = atomic_operation(record);
+        operation.operation = AtomicOperation::OpType::Add;
+
+        auto& owner_index = index[operation.description.owner()];
+        const auto [it, inserted] = owner_index.insert(
+          {operation.description.name(), compacted.size()});
+        if (inserted)
+          compacted.push_back(serialize(operation));
+        else
+          compacted[it->second] = serialize(operation);
+      }
+    }
+    catch (const std::exception&)
+    {
+      // The journal has a record that cannot be parsed, so leave the file as
+      // it is rather than risk losing data. Back off so that we do not retry
+      // on every write.
+      _compacted_size = _journal.size();
+      return;
+    }
+
+    // Write the compacted journal to a separate file and then move it into
+    // place so that a crash during compaction never loses the original.
+    const std::string temp_path = _file_path + ".compact";
+    std::FILE* temp = std::fopen(temp_path.c_str(), "w");
+    if (!temp)
+    {
+      _compacted_size = _journal.size();
+      return;
+    }
+
+    YAML::Emitter emitter;
+    emitter << compacted;
+    const std::string text = std::string(emitter.c_str()) + "\n";
+    const bool written =
+      std::fwrite(text.data(), 1, text.size(), temp) == text.size()
+      && std::fflush(temp) == 0
+      && fsync(fileno(temp)) == 0;
+    std::fclose(temp);
+
+    if (!written)
+    {
+      std::remove(temp_path.c_str());
+      _compacted_size = _journal.size();
+      return;
+    }
+
+    if (_file)
+    {
+      sync();
+      std::fclose(_file);
+      _file = nullptr;
+    }
+
+    std::filesystem::rename(temp_path, _file_path);
+    _journal = compacted;
+    _compacted_size = compacted.size();
+  }
+
+  YAML::Node _journal;
   std::size_t _initial_buffer_size;
-  std::unordered_map<std::string, std::size_t> _name_to_index;
+  std::size_t _compacted_size;
   std::size_t _counter;
   std::string _file_path;
+  std::FILE* _file = nullptr;
+  std::size_t _unsynced_writes = 0;
+  std::chrono::steady_clock::time_point _last_sync =
+    std::chrono::steady_clock::now();
   std::mutex _mutex;
 };
 
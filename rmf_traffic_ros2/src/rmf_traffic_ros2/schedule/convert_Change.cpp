@@ -35,6 +35,17 @@ rmf_traffic::schedule::Change::Add::Item convert(
   };
 }
 
+//==============================================================================
+rmf_traffic::schedule::Change::Add::Item convert(
+  rmf_traffic_msgs::msg::ScheduleChangeAddItem&& from)
+{
+  return {
+    from.route_id,
+    from.storage_id,
+    std::make_shared<rmf_traffic::Route>(convert(std::move(from.route)))
+  };
+}
+
 //==============================================================================
 rmf_traffic_msgs::msg::ScheduleChangeAddItem convert(
   const rmf_traffic::schedule::Change::Add::Item& from)
@@ -58,6 +69,17 @@ rmf_traffic::schedule::Change::Add convert(
   };
 }
 
+//==============================================================================
+rmf_traffic::schedule::Change::Add convert(
+  rmf_traffic_msgs::msg::ScheduleChangeAdd&& from)
+{
+  return {
+    from.plan_id,
+    convert_vector<rmf_traffic::schedule::Change::Add::Item>(
+      std::move(from.items))
+  };
+}
+
 //==============================================================================
 rmf_traffic::schedule::Change::Delay convert(
   const rmf_traffic_msgs::msg::ScheduleChangeDelay& from)
@@ -75,6 +75,17 @@ std::optional<rmf_traffic::schedule::Change::Progress> convert(
     from.version, from.checkpoints);
 }
 
+//==============================================================================
+std::optional<rmf_traffic::schedule::Change::Progress> convert(
+  rmf_traffic_msgs::msg::ScheduleChangeProgress&& from)
+{
+  if (!from.has_progress)
+    return std::nullopt;
+
+  return rmf_traffic::schedule::Change::Progress(
+    from.version, std::move(from.checkpoints));
+}
+
 //==============================================================================
 rmf_traffic_msgs::msg::ScheduleParticipantPatch convert(
   const rmf_traffic::schedule::Patch::Participant& from)
@@ -104,6 +115,20 @@ rmf_traffic::schedule::Patch::Participant convert(
   };
 }
 
+//==============================================================================
+rmf_traffic::schedule::Patch::Participant convert(
+  rmf_traffic_msgs::msg::ScheduleParticipantPatch&& from)
+{
+  return rmf_traffic::schedule::Patch::Participant{
+    from.participant_id,
+    from.itinerary_version,
+    rmf_traffic::schedule::Change::Erase{std::move(from.erasures)},
+    convert_vector<rmf_traffic::schedule::Change::Delay>(from.delays),
+    convert(std::move(from.additions)),
+    convert(std::move(from.progress))
+  };
+}
+
 //==============================================================================
 rmf_traffic_msgs::msg::SchedulePatch convert(
   const rmf_traffic::schedule::Patch& from)
@@ -147,4 +172,25 @@ rmf_traffic::schedule::Patch convert(
   };
 }
 
+//==============================================================================
+rmf_traffic::schedule::Patch convert(
+  rmf_traffic_msgs::msg::SchedulePatch&& from)
+{
+  std::optional<rmf_traffic::schedule::Change::Cull> cull;
+  if (!from.cull.empty())
+    cull = convert(from.cull.front());
+
+  std::optional<rmf_traffic::schedule::Version> base_version;
+  if (from.has_base_version)
+    base_version = from.base_version;
+
+  return rmf_traffic::schedule::Patch{
+    convert_vector<rmf_traffic::schedule::Patch::Participant>(
+      std::move(from.participants)),
+    std::move(cull),
+    base_version,
+    from.latest_version
+  };
+}
+
 } // namespace rmf_traffic_ros2
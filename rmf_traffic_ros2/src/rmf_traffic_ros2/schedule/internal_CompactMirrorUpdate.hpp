@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_COMPACTMIRRORUPDATE_HPP
+#define SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_COMPACTMIRRORUPDATE_HPP
+
+#include <rmf_traffic_msgs/msg/mirror_update.hpp>
+
+#include <std_msgs/msg/u_int8_multi_array.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+/// The message that carries a compact mirror update. Compact updates for a
+/// query are published next to the regular MirrorUpdate messages, on the
+/// query's update topic name with CompactMirrorUpdateTopicSuffix appended.
+/// A mirror opts into the compact format by subscribing to that topic
+/// instead of the regular one.
+using CompactMirrorUpdate = std_msgs::msg::UInt8MultiArray;
+
+/// Appended to the query update topic name to get the compact topic name.
+constexpr const char* CompactMirrorUpdateTopicSuffix = "/compact";
+
+/// Positions and velocities are rounded to this resolution in the compact
+/// format. Waypoint times are always kept exactly.
+constexpr double CompactMirrorUpdateResolution = 1e-4;
+
+//==============================================================================
+/// Encode a mirror update into the compact format.
+///
+/// Everything except the trajectory waypoints is kept in its regular CDR
+/// encoding. The waypoints are moved into a separate stream where each time is
+/// stored as the difference from the previous waypoint's time, and each
+/// position and velocity component is rounded to
+/// CompactMirrorUpdateResolution and stored as the difference from the
+/// previous waypoint's component. The differences are written as variable
+/// length integers, so the slowly varying waypoints of a trajectory usually
+/// take a few bytes per component instead of eight.
+///
+/// If the update contains a value that cannot be rounded, the whole update is
+/// sent in its regular encoding instead, so encoding never fails.
+std::vector<uint8_t> encode_compact(
+  const rmf_traffic_msgs::msg::MirrorUpdate& msg);
+
+//==============================================================================
+/// Decode an update that was produced by encode_compact(). This throws
+/// std::runtime_error if the data is malformed.
+rmf_traffic_msgs::msg::MirrorUpdate decode_compact(
+  const std::vector<uint8_t>& data);
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
+
+#endif // SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_COMPACTMIRRORUPDATE_HPP
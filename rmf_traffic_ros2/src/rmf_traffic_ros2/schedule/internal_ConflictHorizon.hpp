@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_CONFLICTHORIZON_HPP
+#define SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_CONFLICTHORIZON_HPP
+
+#include "internal_RouteBounds.hpp"
+
+#include <rmf_traffic/schedule/ParticipantDescription.hpp>
+#include <rmf_traffic/schedule/Viewer.hpp>
+
+#include <map>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+using ParticipantId = rmf_traffic::schedule::ParticipantId;
+
+//==============================================================================
+/// A copy of a route that has changed in the database. These get copied out
+/// while the database mutex is locked so that conflict detection can be done
+/// after the mutex has been released.
+struct ChangedRoute
+{
+  ParticipantId participant;
+  rmf_traffic::PlanId plan_id;
+  rmf_traffic::RouteId route_id;
+  rmf_traffic::ConstRoutePtr route;
+  rmf_traffic::schedule::ParticipantDescription description;
+};
+using ChangedRoutes = std::vector<ChangedRoute>;
+
+//==============================================================================
+/// A changed route that could still conflict with something beyond the
+/// conflict horizon. It gets checked again once the horizon reaches its
+/// recheck_time.
+struct DeferredRoute
+{
+  ChangedRoute change;
+  rmf_traffic::Time recheck_time;
+};
+using DeferredRoutes =
+  std::map<std::pair<ParticipantId, rmf_traffic::RouteId>, DeferredRoute>;
+
+//==============================================================================
+/// How a pair of routes should be checked against a conflict horizon.
+struct HorizonCheck
+{
+  enum class Kind
+  {
+    /// Both routes can be checked in full right now
+    Whole,
+
+    /// Check the parts of the routes up to the horizon now, and check the
+    /// changed route again at recheck_time
+    Clipped,
+
+    /// Nothing can be checked yet, so check the changed route again at
+    /// recheck_time
+    Defer
+  };
+
+  Kind kind = Kind::Whole;
+  rmf_traffic::Time recheck_time = rmf_traffic::Time();
+
+  /// Decide how to check two routes with these bounds.
+  ///
+  /// \param[in] horizon_end
+  ///   Conflicts are only looked for up to this time.
+  ///
+  /// \param[in] recheck_step
+  ///   How far the horizon needs to move before a clipped pair gets checked
+  ///   again.
+  static HorizonCheck decide(
+    const RouteBounds& a,
+    const RouteBounds& b,
+    rmf_traffic::Time horizon_end,
+    rmf_traffic::Duration recheck_step);
+};
+
+//==============================================================================
+/// Get the part of a trajectory that leads up to the horizon, including the
+/// first waypoint at or beyond the horizon so that the motion up to the
+/// horizon is kept whole. Returns std::nullopt if that leaves fewer than two
+/// waypoints, e.g. because the trajectory starts at or beyond the horizon.
+std::optional<rmf_traffic::Trajectory> clip_to_horizon(
+  const rmf_traffic::Trajectory& trajectory,
+  rmf_traffic::Time horizon_end);
+
+//==============================================================================
+/// Defer a changed route until recheck_time. If the same route is already
+/// deferred, the earlier recheck time is kept.
+void defer_route(
+  DeferredRoutes& deferred,
+  const ChangedRoute& change,
+  rmf_traffic::Time recheck_time);
+
+//==============================================================================
+/// Move the deferred routes that the horizon has reached into the changed
+/// routes so that they get checked again. Each route is refreshed from the
+/// viewer, and any route that its participant has since replaced is dropped,
+/// because the replacement will have been checked as a change of its own.
+void recheck_deferred_routes(
+  rmf_traffic::Time horizon_end,
+  const rmf_traffic::schedule::ItineraryViewer& viewer,
+  ChangedRoutes& view_changes,
+  DeferredRoutes& deferred);
+
+//==============================================================================
+/// A conflict that was detected between two specific routes.
+struct RouteConflict
+{
+  ParticipantId participant_a;
+  rmf_traffic::RouteId route_id_a;
+  rmf_traffic::ConstRoutePtr route_a;
+
+  ParticipantId participant_b;
+  rmf_traffic::RouteId route_id_b;
+  rmf_traffic::ConstRoutePtr route_b;
+};
+
+//==============================================================================
+/// Remembers which conflicts have already been reported, so that checking a
+/// pair of routes again without either of them changing does not reopen a
+/// negotiation that already failed or was forfeited. The routes are kept
+/// alive, so an unchanged route is recognized by its pointer.
+class ReportedConflicts
+{
+public:
+
+  /// Returns true and remembers the conflict if it has not been reported for
+  /// these exact routes before.
+  bool report(const RouteConflict& conflict);
+
+  /// Forget the conflicts whose routes are no longer in the viewer.
+  void prune(const rmf_traffic::schedule::ItineraryViewer& viewer);
+
+  /// Get how many conflicts are being remembered.
+  std::size_t size() const;
+
+private:
+
+  using Key = std::tuple<
+    ParticipantId, rmf_traffic::RouteId, ParticipantId, rmf_traffic::RouteId>;
+  using Routes =
+    std::pair<rmf_traffic::ConstRoutePtr, rmf_traffic::ConstRoutePtr>;
+
+  std::map<Key, Routes> _reported;
+};
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
+
+#endif // SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_CONFLICTHORIZON_HPP
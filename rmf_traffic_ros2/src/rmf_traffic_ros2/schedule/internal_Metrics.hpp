@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_METRICS_HPP
+#define SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_METRICS_HPP
+
+#include <rclcpp/time.hpp>
+
+#include <statistics_msgs/msg/metrics_message.hpp>
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+/// A thread-safe collection of named statistics. Each statistic tracks the
+/// samples recorded during the current reporting interval, which get reported
+/// as statistics_msgs, as well as a cumulative histogram that can be exported
+/// in the Prometheus text exposition format.
+class Metrics
+{
+public:
+
+  /// Constructor
+  ///
+  /// \param[in] source
+  ///   The name of the component that is producing these metrics. This will
+  ///   be used as the prefix of the Prometheus metric names.
+  Metrics(std::string source);
+
+  /// Add a statistic that will have samples recorded for it.
+  ///
+  /// \param[in] name
+  ///   The name of the statistic. This should only contain characters that
+  ///   are valid for a Prometheus metric name.
+  ///
+  /// \param[in] unit
+  ///   The unit of the samples, e.g. "seconds".
+  ///
+  /// \param[in] buckets
+  ///   The upper bounds of the histogram buckets, in ascending order.
+  void add_statistic(
+    const std::string& name,
+    std::string unit,
+    std::vector<double> buckets);
+
+  /// Add a counter that can be incremented.
+  void add_counter(const std::string& name);
+
+  /// Record a sample for a statistic. Samples for unknown statistics are
+  /// ignored.
+  void record(const std::string& name, double value);
+
+  /// Record a duration, in seconds, for a statistic.
+  void record(
+    const std::string& name,
+    std::chrono::steady_clock::duration value);
+
+  /// Increment a counter. Unknown counters are ignored.
+  void increment(const std::string& name, std::size_t amount = 1);
+
+  /// Get the current value of a counter.
+  std::size_t counter(const std::string& name) const;
+
+  /// Get the sum of every sample that has ever been recorded for a statistic.
+  double cumulative_sum(const std::string& name) const;
+
+  /// Get the number of samples that have ever been recorded for a statistic.
+  uint64_t cumulative_count(const std::string& name) const;
+
+  /// Get a message for each statistic that has had samples recorded since the
+  /// last time this was called, and reset the interval.
+  std::vector<statistics_msgs::msg::MetricsMessage> flush(
+    const rclcpp::Time& window_stop);
+
+  /// Get the cumulative values of all statistics and counters in the
+  /// Prometheus text exposition format.
+  std::string prometheus() const;
+
+  /// Standard duration buckets, from a tenth of a millisecond to ten seconds.
+  static std::vector<double> duration_buckets();
+
+  /// Standard size buckets, from one to ten thousand.
+  static std::vector<double> size_buckets();
+
+private:
+
+  struct Statistic
+  {
+    std::string unit;
+    std::vector<double> buckets;
+
+    // Cumulative histogram
+    std::vector<uint64_t> bucket_counts;
+    double cumulative_sum = 0.0;
+    uint64_t cumulative_count = 0;
+
+    // Current reporting interval
+    uint64_t count = 0;
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+  };
+
+  std::string _source;
+  std::optional<rclcpp::Time> _window_start;
+  std::map<std::string, Statistic> _statistics;
+  std::map<std::string, std::size_t> _counters;
+  mutable std::mutex _mutex;
+};
+
+//==============================================================================
+/// Lock a mutex and record how long it took to acquire the lock and how long
+/// the lock was held, if a Metrics instance is given. Without one, this is
+/// just a lock and the clock is never read.
+///
+/// These are used on every itinerary change, so the statistic names must be
+/// string literals, or otherwise outlive the lock, to spare an allocation.
+class TimedLock
+{
+public:
+
+  TimedLock(
+    std::mutex& mutex,
+    Metrics* metrics,
+    const char* wait_statistic,
+    const char* hold_statistic);
+
+  ~TimedLock();
+
+private:
+  std::unique_lock<std::mutex> _lock;
+  Metrics* _metrics;
+  const char* _hold_statistic;
+  std::chrono::steady_clock::time_point _acquired;
+};
+
+//==============================================================================
+/// Record how long the current scope took to finish, if a Metrics instance is
+/// given. The statistic name must outlive the timer, like for TimedLock.
+class ScopeTimer
+{
+public:
+
+  ScopeTimer(Metrics* metrics, const char* statistic);
+
+  ~ScopeTimer();
+
+private:
+  Metrics* _metrics;
+  const char* _statistic;
+  std::chrono::steady_clock::time_point _start;
+};
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
+
+#endif // SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_METRICS_HPP
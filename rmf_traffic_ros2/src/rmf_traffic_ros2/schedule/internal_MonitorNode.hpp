@@ -30,6 +30,7 @@
 
 #include <rmf_traffic_ros2/schedule/MirrorManager.hpp>
 
+#include <deque>
 #include <optional>
 #include <unordered_map>
 
@@ -70,6 +71,48 @@ public:
 
   void start_data_synchronisers();
 
+  // In hot standby mode the monitor listens to the same itinerary topics as
+  // the primary schedule node and keeps the changes from the most recent
+  // replay window. When the monitor takes over, these changes are replayed
+  // into the forked database so that any changes which the primary received
+  // but never sent out in a mirror update are not lost. Replaying a change
+  // that the mirror already has makes no difference to the database.
+  bool hot_standby = false;
+  std::chrono::nanoseconds hot_standby_replay_window = 5s;
+
+  struct BufferedItineraryChange
+  {
+    std::chrono::steady_clock::time_point received_time;
+    ScheduleNode::ItineraryChange change;
+  };
+  std::deque<BufferedItineraryChange> itinerary_replay_buffer;
+
+  rclcpp::Subscription<ScheduleNode::ItinerarySet>::SharedPtr
+    itinerary_set_sub;
+  rclcpp::Subscription<ScheduleNode::ItineraryExtend>::SharedPtr
+    itinerary_extend_sub;
+  rclcpp::Subscription<ScheduleNode::ItineraryDelay>::SharedPtr
+    itinerary_delay_sub;
+  rclcpp::Subscription<ScheduleNode::ItineraryReached>::SharedPtr
+    itinerary_reached_sub;
+  rclcpp::Subscription<ScheduleNode::ItineraryClear>::SharedPtr
+    itinerary_clear_sub;
+
+  void start_itinerary_listeners();
+  void buffer_itinerary_change(ScheduleNode::ItineraryChange change);
+
+  // Apply the buffered itinerary changes to a replacement schedule node.
+  void replay_itinerary_changes(ScheduleNode& node);
+
+  // Create the replacement schedule node and hand it to the failover
+  // callback. Only the first call does anything.
+  void fail_over();
+  bool failed_over = false;
+
+  // How long it took to get the replacement schedule node ready after the
+  // death of the primary was detected
+  std::optional<std::chrono::nanoseconds> last_failover_duration;
+
   virtual std::shared_ptr<rclcpp::Node> create_new_schedule_node();
 
   std::optional<rmf_traffic_ros2::schedule::MirrorManager> mirror;
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "internal_NegotiationRecording.hpp"
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+const std::string NegotiationRecorder::magic = "RMFNEG01";
+
+//==============================================================================
+std::unique_ptr<NegotiationRecorder> NegotiationRecorder::make(
+  const std::string& filename)
+{
+  // Negotiation messages are infrequent enough that we can afford to flush
+  // each one, which keeps the recording usable if the node gets killed.
+  auto writer =
+    RecordWriter::make(filename, magic, RecordWriter::Flush::EachRecord);
+  if (!writer)
+    return nullptr;
+
+  return std::unique_ptr<NegotiationRecorder>(
+    new NegotiationRecorder(std::move(writer)));
+}
+
+//==============================================================================
+NegotiationRecorder::NegotiationRecorder(std::unique_ptr<RecordWriter> writer)
+: _writer(std::move(writer))
+{
+  // Do nothing
+}
+
+//==============================================================================
+void NegotiationRecorder::record(const Participant& msg)
+{
+  _record(Kind::Participant, msg);
+}
+
+//==============================================================================
+void NegotiationRecorder::record(const Notice& msg)
+{
+  _record(Kind::Notice, msg);
+}
+
+//==============================================================================
+void NegotiationRecorder::record(const Proposal& msg)
+{
+  _record(Kind::Proposal, msg);
+}
+
+//==============================================================================
+void NegotiationRecorder::record(const Rejection& msg)
+{
+  _record(Kind::Rejection, msg);
+}
+
+//==============================================================================
+void NegotiationRecorder::record(const Forfeit& msg)
+{
+  _record(Kind::Forfeit, msg);
+}
+
+//==============================================================================
+void NegotiationRecorder::record(const Conclusion& msg)
+{
+  _record(Kind::Conclusion, msg);
+}
+
+//==============================================================================
+template<typename Message>
+void NegotiationRecorder::_record(const Kind kind, const Message& msg)
+{
+  _writer->write(static_cast<uint8_t>(kind), msg);
+}
+
+//==============================================================================
+std::vector<NegotiationRecord> read_negotiation_recording(
+  const std::string& filename)
+{
+  return read_records(
+    filename, NegotiationRecorder::magic,
+    NegotiationRecorder::Kind::Conclusion, "negotiation");
+}
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_NEGOTIATIONRECORDING_HPP
+#define SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_NEGOTIATIONRECORDING_HPP
+
+#include "internal_RecordFile.hpp"
+
+#include <rmf_traffic_msgs/msg/negotiation_conclusion.hpp>
+#include <rmf_traffic_msgs/msg/negotiation_forfeit.hpp>
+#include <rmf_traffic_msgs/msg/negotiation_notice.hpp>
+#include <rmf_traffic_msgs/msg/negotiation_proposal.hpp>
+#include <rmf_traffic_msgs/msg/negotiation_rejection.hpp>
+#include <rmf_traffic_msgs/msg/participant.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+/// Writes the negotiation messages that a node receives into a RecordWriter
+/// file so that the negotiations can be replayed and profiled offline. Each
+/// record is written out right away.
+class NegotiationRecorder
+{
+public:
+
+  enum class Kind : uint8_t
+  {
+    Participant = 0,
+    Notice = 1,
+    Proposal = 2,
+    Rejection = 3,
+    Forfeit = 4,
+    Conclusion = 5
+  };
+
+  using Participant = rmf_traffic_msgs::msg::Participant;
+  using Notice = rmf_traffic_msgs::msg::NegotiationNotice;
+  using Proposal = rmf_traffic_msgs::msg::NegotiationProposal;
+  using Rejection = rmf_traffic_msgs::msg::NegotiationRejection;
+  using Forfeit = rmf_traffic_msgs::msg::NegotiationForfeit;
+  using Conclusion = rmf_traffic_msgs::msg::NegotiationConclusion;
+
+  /// The string that every recording begins with
+  static const std::string magic;
+
+  /// Open a file to record into. Any existing file will be overwritten.
+  /// Returns nullptr if the file could not be opened.
+  static std::unique_ptr<NegotiationRecorder> make(const std::string& filename);
+
+  /// Record the description of a participant. The participants of each
+  /// negotiation should be recorded before its notice so that the negotiation
+  /// can be reconstructed.
+  void record(const Participant& msg);
+
+  void record(const Notice& msg);
+  void record(const Proposal& msg);
+  void record(const Rejection& msg);
+  void record(const Forfeit& msg);
+  void record(const Conclusion& msg);
+
+private:
+
+  NegotiationRecorder(std::unique_ptr<RecordWriter> writer);
+
+  template<typename Message>
+  void _record(Kind kind, const Message& msg);
+
+  std::unique_ptr<RecordWriter> _writer;
+};
+
+//==============================================================================
+/// A single record that was read from a negotiation recording
+using NegotiationRecord = Record<NegotiationRecorder::Kind>;
+
+//==============================================================================
+/// Read every record of a negotiation recording. Throws std::runtime_error if
+/// the file cannot be opened or is not a negotiation recording. A record that
+/// was cut short, e.g. because the recording node was killed, ends the
+/// recording without an error.
+std::vector<NegotiationRecord> read_negotiation_recording(
+  const std::string& filename);
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
+
+#endif // SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_NEGOTIATIONRECORDING_HPP
@@ -19,6 +19,11 @@
 #define SRC__RMF_TRAFFIC_SCHEDULE__SCHEDULENODE_HPP
 
 #include "NegotiationRoom.hpp"
+#include "internal_CompactMirrorUpdate.hpp"
+#include "internal_ConflictHorizon.hpp"
+#include "internal_Metrics.hpp"
+#include "internal_ScheduleRecording.hpp"
+#include "internal_WorkerPool.hpp"
 
 #include <rmf_traffic/schedule/Database.hpp>
 #include <rmf_traffic/schedule/Negotiation.hpp>
@@ -63,10 +68,18 @@
 
 #include <rmf_utils/Modular.hpp>
 
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <variant>
+#include <vector>
 
 namespace rmf_traffic_ros2 {
 namespace schedule {
@@ -150,6 +163,57 @@ public:
   rclcpp::TimerBase::SharedPtr cull_timer;
   void cull();
 
+  std::chrono::nanoseconds cull_period = std::chrono::minutes(1);
+
+  // Routes that finished longer ago than this will be culled
+  std::chrono::nanoseconds cull_horizon = std::chrono::hours(2);
+
+  // If the estimated memory used by routes in the schedule exceeds this many
+  // bytes, then finished routes will be culled earlier than the cull horizon
+  // until the schedule fits within the budget. Zero means unlimited.
+  std::size_t cull_memory_budget = 0;
+
+  // Rough per-route and per-waypoint memory costs used to estimate how much
+  // memory the schedule is using.
+  static constexpr std::size_t estimated_route_bytes = 256;
+  static constexpr std::size_t estimated_waypoint_bytes = 128;
+
+  // Negotiations and conclusion waits with no activity for this long will be
+  // culled
+  std::chrono::nanoseconds negotiation_timeout = std::chrono::seconds(30);
+
+  // If this is greater than zero, a negotiation that has been open for this
+  // long gets concluded with the best proposal set that is available, or
+  // refused if there is none.
+  std::chrono::nanoseconds negotiation_deadline = std::chrono::nanoseconds(0);
+
+  // If this is greater than zero, a negotiation that has a feasible proposal
+  // set will wait up to this long for more proposals before it gets concluded,
+  // unless the exploration finishes or the best proposal set is within the
+  // quality bound. If it is zero, negotiations conclude as soon as any
+  // feasible proposal set is found.
+  std::chrono::nanoseconds negotiation_settle_time =
+    std::chrono::nanoseconds(0);
+
+  // The total delay, in seconds, that the best proposal set may add to the
+  // finish times that the participants had when the negotiation began for the
+  // negotiation to conclude without waiting out the settle time.
+  double negotiation_quality_bound = 0.0;
+
+  // Checks the deadlines and settle times of the open negotiations
+  rclcpp::TimerBase::SharedPtr negotiation_deadline_timer;
+  void check_negotiation_deadlines();
+
+  // If a mirror requests a remedial update starting from a version that is
+  // more than snapshot_min_lag versions behind the latest version, it will be
+  // sent the most recent snapshot of its query followed by a tail patch with
+  // the changes since the snapshot, instead of a patch of the entire history.
+  std::chrono::nanoseconds snapshot_period = std::chrono::nanoseconds(0);
+  rmf_traffic::schedule::Version snapshot_min_lag = 0;
+  rclcpp::TimerBase::SharedPtr snapshot_timer;
+  void update_snapshots();
+  void setup_snapshot_timer();
+
   virtual void setup_query_services();
 
   using RegisterParticipant = rmf_traffic_msgs::srv::RegisterParticipant;
@@ -176,6 +240,8 @@ public:
 
   using MirrorUpdate = rmf_traffic_msgs::msg::MirrorUpdate;
   using MirrorUpdateTopicPublisher = rclcpp::Publisher<MirrorUpdate>::SharedPtr;
+  using CompactMirrorUpdateTopicPublisher =
+    rclcpp::Publisher<CompactMirrorUpdate>::SharedPtr;
 
   void add_query_topic(uint64_t query_id);
   void remove_query_topic(uint64_t query_id);
@@ -187,6 +253,19 @@ public:
   rclcpp::Publisher<ParticipantsInfo>::SharedPtr participants_info_pub;
   virtual void broadcast_participants();
 
+  // If participants_broadcast_period is greater than zero, registering or
+  // unregistering a participant only marks the participant list as dirty, and
+  // the list gets broadcast at most once per period. This way a fleet that
+  // brings up many participants at once does not cause a full participant
+  // list to be published and processed for every single one of them.
+  std::chrono::nanoseconds participants_broadcast_period =
+    std::chrono::nanoseconds(0);
+  bool participants_broadcast_pending = false;
+  rclcpp::TimerBase::SharedPtr participants_broadcast_timer;
+
+  // This must be called while database_mutex is locked.
+  void request_participants_broadcast();
+
   using ScheduleQuery = rmf_traffic_msgs::msg::ScheduleQuery;
   using ScheduleQueries = rmf_traffic_msgs::msg::ScheduleQueries;
   rclcpp::Publisher<ScheduleQueries>::SharedPtr queries_info_pub;
@@ -204,30 +283,90 @@ public:
 
   using ItinerarySet = rmf_traffic_msgs::msg::ItinerarySet;
   void itinerary_set(const ItinerarySet& set);
+  void apply_itinerary_set(const ItinerarySet& set);
   rclcpp::Subscription<ItinerarySet>::SharedPtr itinerary_set_sub;
 
   using ItineraryExtend = rmf_traffic_msgs::msg::ItineraryExtend;
   void itinerary_extend(const ItineraryExtend& extend);
+  void apply_itinerary_extend(const ItineraryExtend& extend);
   rclcpp::Subscription<ItineraryExtend>::SharedPtr itinerary_extend_sub;
 
   using ItineraryDelay = rmf_traffic_msgs::msg::ItineraryDelay;
   void itinerary_delay(const ItineraryDelay& delay);
+  void apply_itinerary_delay(const ItineraryDelay& delay);
   rclcpp::Subscription<ItineraryDelay>::SharedPtr itinerary_delay_sub;
 
   using ItineraryReached = rmf_traffic_msgs::msg::ItineraryReached;
   void itinerary_reached(const ItineraryReached& msg);
+  void apply_itinerary_reached(const ItineraryReached& msg);
   rclcpp::Subscription<ItineraryReached>::SharedPtr itinerary_reached_sub;
 
   using ItineraryClear = rmf_traffic_msgs::msg::ItineraryClear;
   void itinerary_clear(const ItineraryClear& clear);
+  void apply_itinerary_clear(const ItineraryClear& clear);
   rclcpp::Subscription<ItineraryClear>::SharedPtr itinerary_clear_sub;
 
+  // The apply_itinerary_* functions must be called while database_mutex is
+  // locked. The itinerary_* functions lock it themselves.
+
+  using ItineraryChange = std::variant<
+    ItinerarySet,
+    ItineraryExtend,
+    ItineraryDelay,
+    ItineraryReached,
+    ItineraryClear>;
+
+  // If itinerary_batch_period is greater than zero, incoming itinerary changes
+  // are queued up and then applied together under a single lock of the
+  // database_mutex, so mirrors and the conflict checker will never see only
+  // part of a burst of changes. Otherwise each change is applied immediately.
+  std::chrono::nanoseconds itinerary_batch_period = std::chrono::nanoseconds(0);
+  std::vector<ItineraryChange> pending_itinerary_changes;
+  std::mutex pending_itinerary_mutex;
+  rclcpp::TimerBase::SharedPtr itinerary_batch_timer;
+  void receive_itinerary_change(ItineraryChange change);
+  void apply_itinerary_batch();
+
+  // If the schedule_record_file parameter is not empty, every registration and
+  // itinerary change that this node ingests gets recorded so that the load can
+  // be replayed offline with rmf_traffic_schedule_replay.
+  std::unique_ptr<ScheduleRecorder> schedule_recorder;
+  rclcpp::TimerBase::SharedPtr schedule_recorder_timer;
+  void setup_schedule_recorder();
+
+  // Apply a sequence of itinerary changes in order under a single lock of the
+  // database_mutex. Changes whose itinerary versions are already in the
+  // database have no effect, so it is safe to replay changes that might have
+  // been applied before.
+  void apply_itinerary_changes(const std::vector<ItineraryChange>& changes);
+
   virtual void setup_itinerary_topics();
 
   using InconsistencyMsg = rmf_traffic_msgs::msg::ScheduleInconsistency;
   rclcpp::Publisher<InconsistencyMsg>::SharedPtr inconsistency_pub;
   void publish_inconsistencies(rmf_traffic::schedule::ParticipantId id);
 
+  // If inconsistency_report_period is greater than zero, each inconsistency
+  // report only contains the ranges that the participant has not been told
+  // about yet, and nothing gets published if there are no new ranges. Ranges
+  // that remain unresolved are reported again in full once per period, in
+  // case the earlier report or the retransmission got lost. These reports must
+  // only be accessed while database_mutex is locked.
+  struct InconsistencyReport
+  {
+    using Range = std::pair<
+      rmf_traffic::schedule::ItineraryVersion,
+      rmf_traffic::schedule::ItineraryVersion>;
+    std::vector<Range> ranges;
+    std::chrono::steady_clock::time_point time;
+  };
+  std::unordered_map<rmf_traffic::schedule::ParticipantId, InconsistencyReport>
+  inconsistency_reports;
+  std::chrono::nanoseconds inconsistency_report_period =
+    std::chrono::nanoseconds(0);
+  rclcpp::TimerBase::SharedPtr inconsistency_report_timer;
+  void republish_inconsistencies();
+
   rclcpp::Subscription<ScheduleId>::SharedPtr startup_sub;
   rclcpp::Publisher<ScheduleId>::SharedPtr startup_pub;
   void receive_startup_msg(const ScheduleId& msg);
@@ -236,12 +375,72 @@ public:
 
   rclcpp::TimerBase::SharedPtr mirror_update_timer;
   void update_mirrors();
-  bool update_query(
-    const MirrorUpdateTopicPublisher& publisher,
+
+  // Each query topic will wait at least this long between regular (i.e.
+  // non-remedial) updates. Any schedule changes that happen during the wait
+  // get coalesced into one patch that is sent once the interval has passed.
+  std::chrono::nanoseconds mirror_update_min_interval =
+    std::chrono::nanoseconds(0);
+
+  // A patch that has been snapshotted from the database for one round of
+  // update_mirrors(). Queries with identical parameters that are waiting on
+  // the same version will share one of these, so the patch only needs to be
+  // computed and converted once.
+  struct PendingMirrorUpdate
+  {
+    rmf_traffic::schedule::Query query;
+    VersionOpt last_sent_version;
+    bool is_remedial;
+    std::optional<rmf_traffic::schedule::Patch> patch;
+    MirrorUpdate msg;
+    std::once_flag convert_once;
+    CompactMirrorUpdate compact_msg;
+    std::once_flag compact_once;
+
+    // Convert the patch into a message the first time this is called. This is
+    // safe to call from multiple threads at once. The conversion time and the
+    // size of the patch get recorded in metrics if it is not nullptr.
+    const MirrorUpdate& get_msg(Metrics* metrics = nullptr);
+
+    // Encode the message in the compact format the first time this is called.
+    // This is safe to call from multiple threads at once.
+    const CompactMirrorUpdate& get_compact_msg(Metrics* metrics = nullptr);
+  };
+  using PendingMirrorUpdatePtr = std::shared_ptr<PendingMirrorUpdate>;
+
+  // Find the update that was already prepared during this round for an
+  // identical query, or snapshot a new patch from the database. This must be
+  // called while database_mutex is locked.
+  PendingMirrorUpdatePtr prepare_mirror_update(
     const rmf_traffic::schedule::Query& query,
     VersionOpt last_sent_version,
     bool is_remedial);
 
+  // Convert and publish a prepared update. This does not touch the database,
+  // so it does not need database_mutex to be locked. The compact format is
+  // only encoded if some mirror has subscribed to it.
+  void publish_mirror_update(
+    uint64_t query_id,
+    const MirrorUpdateTopicPublisher& publisher,
+    const CompactMirrorUpdateTopicPublisher& compact_publisher,
+    const PendingMirrorUpdatePtr& update);
+
+  // This cache is only valid for one database version, so it gets cleared at
+  // the start of each round of update_mirrors().
+  std::vector<PendingMirrorUpdatePtr> mirror_update_cache;
+  std::size_t mirror_update_cache_hits = 0;
+  std::size_t mirror_update_cache_misses = 0;
+
+  // If this is not null, then mirror updates will be converted and published
+  // by this pool instead of the timer callback. Updates for any one query are
+  // always published by the same worker, so they will stay in order.
+  std::unique_ptr<WorkerPool> mirror_update_pool;
+
+  // If this is true, each patch that gets published is also offered to the
+  // process-wide PatchHandoff, so any mirrors that share this process can use
+  // the patch directly instead of decoding the message.
+  bool intra_process_patch_handoff = false;
+
   // TODO(MXG): Consider using libguarded instead of a database_mutex
   std::mutex database_mutex;
   std::shared_ptr<rmf_traffic::schedule::Database> database;
@@ -250,21 +449,81 @@ public:
   {
     rmf_traffic::schedule::Query query;
     MirrorUpdateTopicPublisher publisher;
+    CompactMirrorUpdateTopicPublisher compact_publisher;
     VersionOpt last_checked_version;
     VersionOpt last_sent_version;
     std::chrono::steady_clock::time_point last_registration_time;
     std::unordered_set<VersionOpt> remediation_requests;
+    std::chrono::steady_clock::time_point last_publish_time;
+
+    // A full-state update for this query that was materialized by the
+    // snapshot timer. This will be nullptr if snapshots are disabled.
+    PendingMirrorUpdatePtr snapshot;
+
+    // The maps that this query is restricted to, or std::nullopt if the query
+    // can see every map.
+    std::optional<std::unordered_set<std::string>> maps;
+
+    // Whether any schedule change that this query might see has happened
+    // since the last regular patch was prepared for it. Queries that are not
+    // dirty skip calling Database::changes() entirely.
+    bool dirty = true;
+
+    // How many times mirrors have registered this query. Mirrors never
+    // unregister, so whether the query is still in use is decided by the
+    // number of subscriptions to its topics instead.
+    std::size_t registrations = 1;
   };
   using QueryInfoMap = std::unordered_map<uint64_t, QueryInfo>;
 
   std::size_t last_query_id = 0;
   QueryInfoMap registered_queries;
 
+  // The maps that have been touched by schedule changes since the last round
+  // of update_mirrors(). These must only be used while database_mutex is
+  // locked.
+  std::unordered_set<std::string> changed_maps;
+  bool all_maps_changed = false;
+
+  // Record that the routes which the participant currently has on the
+  // schedule are about to change or have just changed. This must be called
+  // while database_mutex is locked.
+  void mark_maps_changed(rmf_traffic::schedule::ParticipantId participant);
+
+  // Record that the schedule has changed in a way that any query might see.
+  void mark_all_maps_changed();
+
   // TODO(MXG): Make this a separate node
   std::thread conflict_check_thread;
   std::condition_variable conflict_check_cv;
   std::atomic_bool conflict_check_quit;
 
+  // If this is not null, then conflict checking will be divided up across the
+  // workers of this pool.
+  std::unique_ptr<WorkerPool> conflict_check_pool;
+
+  // The conflict check thread only gets notified when the database version
+  // has changed since the last notification.
+  rmf_traffic::schedule::Version last_conflict_check_notice = 0;
+
+  // Instrumentation for the hot paths of the node. This will be nullptr if
+  // metrics are disabled, in which case nothing gets measured.
+  std::shared_ptr<Metrics> metrics;
+  std::chrono::nanoseconds metrics_period = std::chrono::nanoseconds(0);
+  std::string metrics_prometheus_file;
+  using MetricsMsg = statistics_msgs::msg::MetricsMessage;
+  rclcpp::Publisher<MetricsMsg>::SharedPtr metrics_pub;
+  rclcpp::TimerBase::SharedPtr metrics_timer;
+  void setup_metrics();
+  void publish_metrics();
+
+  // The negotiation subscriptions are serviced by this callback group instead
+  // of the default one, so that a multi-threaded executor can handle them
+  // while the default group is busy ingesting itineraries or publishing mirror
+  // updates. The negotiation callbacks only touch state that is protected by
+  // active_conflicts_mutex.
+  rclcpp::CallbackGroup::SharedPtr negotiation_callback_group;
+
   using ConflictAck = rmf_traffic_msgs::msg::NegotiationAck;
   using ConflictAckSub = rclcpp::Subscription<ConflictAck>;
   ConflictAckSub::SharedPtr conflict_ack_sub;
@@ -280,6 +539,17 @@ public:
   void receive_refusal(const ConflictRefusal& msg);
   void refuse(std::size_t conflict_version);
 
+  // Conclude a negotiation with its best proposal set. This must be called
+  // while active_conflicts_mutex is locked, and only for negotiations that are
+  // ready.
+  void resolve(std::size_t conflict_version);
+
+  // Decide whether a negotiation that is ready should be concluded right away
+  bool should_resolve(
+    const rmf_traffic::schedule::Negotiation& negotiation,
+    const std::unordered_map<ParticipantId, rmf_traffic::Time>& finish_times)
+  const;
+
   using ConflictProposal = rmf_traffic_msgs::msg::NegotiationProposal;
   using ConflictProposalSub = rclcpp::Subscription<ConflictProposal>;
   ConflictProposalSub::SharedPtr conflict_proposal_sub;
@@ -306,6 +576,17 @@ public:
 
   using Negotiation = rmf_traffic::schedule::Negotiation;
 
+  using ChangedRoute = schedule::ChangedRoute;
+  using ChangedRoutes = schedule::ChangedRoutes;
+
+  // If conflict_horizon is greater than zero, conflicts are only detected up
+  // to that far into the future. Changed routes that could still conflict
+  // beyond the horizon are deferred, and get checked again by the conflict
+  // check thread once the horizon reaches their recheck_time.
+  std::chrono::nanoseconds conflict_horizon = std::chrono::nanoseconds(0);
+  using DeferredRoute = schedule::DeferredRoute;
+  using DeferredRoutes = schedule::DeferredRoutes;
+
   using NegotiationStates = rmf_traffic_msgs::msg::NegotiationStates;
   using NegotiationStatesPub = rclcpp::Publisher<NegotiationStates>;
   NegotiationStatesPub::SharedPtr negotiation_states_pub;
@@ -316,6 +597,17 @@ public:
   // Published by publish_negotiation_states
   NegotiationStatusesPub::SharedPtr negotiation_stasuses_pub;
 
+  // If negotiation_states_period is greater than zero, changes to the
+  // negotiations only mark the states as dirty, and the states get published
+  // at most once per period.
+  std::chrono::nanoseconds negotiation_states_period =
+    std::chrono::nanoseconds(0);
+  bool negotiation_states_pending = false;
+  rclcpp::TimerBase::SharedPtr negotiation_states_timer;
+
+  // This must be called while active_conflicts_mutex is locked.
+  void request_negotiation_states();
+
   class ConflictRecord
   {
   public:
@@ -328,6 +620,13 @@ public:
       rmf_traffic::Time start_time;
       rmf_traffic::Time last_active_time;
 
+      // The first time that a feasible proposal set was found
+      std::optional<rmf_traffic::Time> ready_time = std::nullopt;
+
+      // The finish time of each participant's itinerary when it joined the
+      // negotiation
+      std::unordered_map<ParticipantId, rmf_traffic::Time> finish_times = {};
+
       void update_state_msg(uint64_t conflict_version)
       {
         room.update_state_msg(conflict_version, start_time, last_active_time);
@@ -393,12 +692,13 @@ public:
       for (const auto p : add_to_negotiation)
         _version[p] = negotiation_version;
 
+      const auto snapshot = viewer.snapshot();
       auto& update_negotiation = insertion.first->second;
       if (!update_negotiation)
       {
         update_negotiation = OpenNegotiation{
           *rmf_traffic::schedule::Negotiation::make(
-            viewer.snapshot(), std::vector<ParticipantId>(
+            snapshot, std::vector<ParticipantId>(
               add_to_negotiation.begin(), add_to_negotiation.end())),
           time, // start time
           time  // last update time
@@ -413,6 +713,24 @@ public:
         }
       }
 
+      for (const auto p : add_to_negotiation)
+      {
+        const auto itinerary = snapshot->get_itinerary(p);
+        if (!itinerary.has_value())
+          continue;
+
+        for (const auto& route : *itinerary)
+        {
+          const auto* finish = route->trajectory().finish_time();
+          if (!finish)
+            continue;
+
+          auto& finish_time = update_negotiation->finish_times.insert(
+            {p, *finish}).first->second;
+          finish_time = std::max(finish_time, *finish);
+        }
+      }
+
       update_negotiation->update_state_msg(negotiation_version);
       return Entry{negotiation_version, &update_negotiation->room.negotiation};
     }
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_PATCHHANDOFF_HPP
+#define SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_PATCHHANDOFF_HPP
+
+#include <rmf_traffic/schedule/Patch.hpp>
+
+#include <rmf_traffic_msgs/msg/mirror_update.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+/// A process-wide store of recently published patches. When a schedule node
+/// and a mirror share a process, the mirror can pick up the patch that the
+/// schedule node already has in memory instead of decoding the message that
+/// was sent to it.
+///
+/// Entries are identified by the schedule node, the query, and the versions
+/// of the patch, so a mirror will only ever receive the exact patch that was
+/// converted into the message that it received.
+class PatchHandoff
+{
+public:
+
+  using PatchPtr = std::shared_ptr<const rmf_traffic::schedule::Patch>;
+
+  /// Get the instance that is shared by the whole process.
+  static PatchHandoff& get();
+
+  /// Offer the patch that was used to produce this message. Only the most
+  /// recent few patches are kept.
+  void offer(
+    uint64_t query_id,
+    const rmf_traffic_msgs::msg::MirrorUpdate& msg,
+    PatchPtr patch);
+
+  /// Find the patch that produced this message, if it is still available.
+  PatchPtr find(
+    uint64_t query_id,
+    const rmf_traffic_msgs::msg::MirrorUpdate& msg) const;
+
+  /// How many patches will be kept at once.
+  static constexpr std::size_t capacity = 64;
+
+private:
+
+  PatchHandoff() = default;
+
+  using Key = std::tuple<std::string, uint64_t, bool, uint64_t, uint64_t, bool>;
+  static Key _make_key(
+    uint64_t query_id,
+    const rmf_traffic_msgs::msg::MirrorUpdate& msg);
+
+  std::map<Key, PatchPtr> _patches;
+  std::deque<Key> _order;
+  mutable std::mutex _mutex;
+};
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
+
+#endif // SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_PATCHHANDOFF_HPP
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "internal_RecordFile.hpp"
+
+#include <stdexcept>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+std::unique_ptr<RecordWriter> RecordWriter::make(
+  const std::string& filename,
+  const std::string& magic,
+  const Flush flush)
+{
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+    return nullptr;
+
+  file.write(magic.data(), static_cast<std::streamsize>(magic.size()));
+  file.flush();
+  if (!file.good())
+    return nullptr;
+
+  return std::unique_ptr<RecordWriter>(
+    new RecordWriter(std::move(file), flush));
+}
+
+//==============================================================================
+RecordWriter::RecordWriter(std::ofstream file, const Flush flush)
+: _file(std::move(file)),
+  _flush(flush),
+  _start(std::chrono::steady_clock::now())
+{
+  // Do nothing
+}
+
+//==============================================================================
+RecordWriter::~RecordWriter()
+{
+  flush();
+}
+
+//==============================================================================
+void RecordWriter::flush()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_buffer.empty())
+    return;
+
+  _file.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+  _file.flush();
+  _buffer.clear();
+}
+
+//==============================================================================
+void RecordWriter::_write(
+  const uint8_t kind,
+  const uint8_t* const data,
+  const std::size_t size)
+{
+  const int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - _start).count();
+  const uint32_t size_value = static_cast<uint32_t>(size);
+
+  const auto append = [this](const void* bytes, const std::size_t n)
+    {
+      const auto* b = static_cast<const char*>(bytes);
+      _buffer.insert(_buffer.end(), b, b + n);
+    };
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  append(&kind, sizeof(kind));
+  append(&time, sizeof(time));
+  append(&size_value, sizeof(size_value));
+  append(data, size);
+
+  if (_flush == Flush::EachRecord)
+  {
+    _file.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+    _file.flush();
+    _buffer.clear();
+  }
+}
+
+//==============================================================================
+std::vector<Record<uint8_t>> read_records(
+  const std::string& filename,
+  const std::string& magic,
+  const uint8_t last_kind,
+  const std::string& name)
+{
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open())
+  {
+    throw std::runtime_error(
+            "Unable to open " + name + " recording [" + filename + "]");
+  }
+
+  std::string header(magic.size(), '\0');
+  file.read(header.data(), static_cast<std::streamsize>(header.size()));
+  if (!file.good() || header != magic)
+  {
+    throw std::runtime_error(
+            "The file [" + filename + "] is not a " + name + " recording");
+  }
+
+  std::vector<Record<uint8_t>> records;
+  while (true)
+  {
+    uint8_t kind = 0;
+    int64_t time = 0;
+    uint32_t size = 0;
+    file.read(reinterpret_cast<char*>(&kind), sizeof(kind));
+    file.read(reinterpret_cast<char*>(&time), sizeof(time));
+    file.read(reinterpret_cast<char*>(&size), sizeof(size));
+    if (!file.good())
+      break;
+
+    if (kind > last_kind)
+    {
+      throw std::runtime_error(
+              "Unknown record kind [" + std::to_string(kind) + "] in "
+              + name + " recording [" + filename + "]");
+    }
+
+    std::vector<uint8_t> data(size);
+    file.read(reinterpret_cast<char*>(data.data()), size);
+    if (!file.good())
+      break;
+
+    records.push_back(
+      Record<uint8_t>{kind, std::chrono::nanoseconds(time), std::move(data)});
+  }
+
+  return records;
+}
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
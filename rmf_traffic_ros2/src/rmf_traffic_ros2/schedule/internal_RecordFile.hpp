@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_RECORDFILE_HPP
+#define SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_RECORDFILE_HPP
+
+#include <rclcpp/serialization.hpp>
+#include <rclcpp/serialized_message.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+/// Writes ROS messages into a compact binary file so that they can be replayed
+/// and profiled offline.
+///
+/// The file begins with an 8-byte magic string that says what kind of
+/// recording it is. Each record after that holds the kind of message, the time
+/// it was received relative to the start of the recording, the size of the
+/// message, and the message itself in its ROS wire format. Numbers are written
+/// in the byte order of the recording machine.
+class RecordWriter
+{
+public:
+
+  enum class Flush
+  {
+    /// Write every record out as soon as it is made. Use this for infrequent
+    /// messages so the recording stays usable if the node gets killed.
+    EachRecord,
+
+    /// Keep records in memory until flush() is called or the writer is
+    /// destroyed. Use this for messages that arrive too often to write out
+    /// one by one.
+    Manually
+  };
+
+  /// Open a file to record into. Any existing file will be overwritten.
+  /// Returns nullptr if the file could not be opened.
+  static std::unique_ptr<RecordWriter> make(
+    const std::string& filename,
+    const std::string& magic,
+    Flush flush);
+
+  /// Record a message with the given kind. This may be called from any
+  /// thread.
+  template<typename Message>
+  void write(uint8_t kind, const Message& msg)
+  {
+    rclcpp::SerializedMessage serialized;
+    rclcpp::Serialization<Message>().serialize_message(&msg, &serialized);
+    const auto& rcl_msg = serialized.get_rcl_serialized_message();
+    _write(kind, rcl_msg.buffer, rcl_msg.buffer_length);
+  }
+
+  /// Write out any records that are still buffered
+  void flush();
+
+  ~RecordWriter();
+
+private:
+
+  RecordWriter(std::ofstream file, Flush flush);
+
+  void _write(uint8_t kind, const uint8_t* data, std::size_t size);
+
+  std::mutex _mutex;
+  std::ofstream _file;
+  Flush _flush;
+  std::vector<char> _buffer;
+  std::chrono::steady_clock::time_point _start;
+};
+
+//==============================================================================
+/// A single record that was read from a recording
+template<typename Kind>
+struct Record
+{
+  Kind kind;
+
+  /// The time that the message was received, relative to the start of the
+  /// recording
+  std::chrono::nanoseconds time;
+
+  /// The message in its ROS wire format
+  std::vector<uint8_t> data;
+
+  /// Deserialize the message of this record. The Message type must match the
+  /// kind of the record.
+  template<typename Message>
+  Message get() const
+  {
+    rclcpp::SerializedMessage serialized(data.size());
+    auto& rcl_msg = serialized.get_rcl_serialized_message();
+    std::memcpy(rcl_msg.buffer, data.data(), data.size());
+    rcl_msg.buffer_length = data.size();
+
+    Message msg;
+    rclcpp::Serialization<Message>().deserialize_message(&serialized, &msg);
+    return msg;
+  }
+};
+
+//==============================================================================
+/// Read every record of a recording. Throws std::runtime_error if the file
+/// cannot be opened, does not begin with the magic string, or has a record
+/// whose kind is greater than last_kind. A record that was cut short, e.g.
+/// because the recording node was killed, ends the recording without an
+/// error.
+///
+/// \param[in] name
+///   What kind of recording this is, for error messages.
+std::vector<Record<uint8_t>> read_records(
+  const std::string& filename,
+  const std::string& magic,
+  uint8_t last_kind,
+  const std::string& name);
+
+//==============================================================================
+/// Read every record of a recording with the kinds given by an enum class
+template<typename Kind>
+std::vector<Record<Kind>> read_records(
+  const std::string& filename,
+  const std::string& magic,
+  const Kind last_kind,
+  const std::string& name)
+{
+  auto raw = read_records(
+    filename, magic, static_cast<uint8_t>(last_kind), name);
+
+  std::vector<Record<Kind>> records;
+  records.reserve(raw.size());
+  for (auto& r : raw)
+  {
+    records.push_back(
+      Record<Kind>{static_cast<Kind>(r.kind), r.time, std::move(r.data)});
+  }
+
+  return records;
+}
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
+
+#endif // SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_RECORDFILE_HPP
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_ROUTEBOUNDS_HPP
+#define SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_ROUTEBOUNDS_HPP
+
+#include <rmf_traffic/Profile.hpp>
+#include <rmf_traffic/Route.hpp>
+#include <rmf_traffic/Trajectory.hpp>
+
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+/// An axis-aligned spatio-temporal bounding box that contains every point that
+/// a trajectory passes through.
+struct RouteBounds
+{
+  double min_x;
+  double min_y;
+  double max_x;
+  double max_y;
+  rmf_traffic::Time start_time;
+  rmf_traffic::Time finish_time;
+
+  /// Compute the bounds of a trajectory. Each segment of a trajectory is a
+  /// cubic spline, so we bound it using the convex hull of its Bezier control
+  /// points. Returns std::nullopt for an empty trajectory.
+  static std::optional<RouteBounds> make(
+    const rmf_traffic::Trajectory& trajectory);
+
+  /// Check whether two participants following trajectories with these bounds
+  /// could possibly conflict. If this returns false then there is no need to
+  /// run a full conflict detection between them.
+  ///
+  /// The radius arguments should be the largest characteristic length of the
+  /// footprint and vicinity of the participant's profile.
+  bool may_overlap(
+    double radius,
+    const RouteBounds& other,
+    double other_radius) const;
+};
+
+//==============================================================================
+/// Get the largest characteristic length of the shapes in a profile.
+double profile_radius(const rmf_traffic::Profile& profile);
+
+//==============================================================================
+/// Keeps track of the bounds of every route that the conflict checker has
+/// seen, so that each route only needs to have its bounds computed once.
+class RouteBoundsCache
+{
+public:
+
+  using ConstRoutePtr = std::shared_ptr<const rmf_traffic::Route>;
+
+  /// Get the bounds of a route, computing them if this route has not been seen
+  /// before.
+  const std::optional<RouteBounds>& insert(const ConstRoutePtr& route);
+
+  /// Get the bounds of a route if they have already been computed. This does
+  /// not modify the cache, so it is safe to call from multiple threads as long
+  /// as insert() and prune() are not being called at the same time.
+  ///
+  /// Returns nullptr if the route is not in the cache.
+  const std::optional<RouteBounds>* find(
+    const rmf_traffic::Route* route) const;
+
+  /// Remove the bounds of any routes that are no longer being used by anything
+  /// outside of this cache.
+  void prune();
+
+  /// Get the number of routes in the cache.
+  std::size_t size() const;
+
+private:
+
+  struct Entry
+  {
+    ConstRoutePtr route;
+    std::optional<RouteBounds> bounds;
+  };
+
+  std::unordered_map<const rmf_traffic::Route*, Entry> _entries;
+};
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
+
+#endif // SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_ROUTEBOUNDS_HPP
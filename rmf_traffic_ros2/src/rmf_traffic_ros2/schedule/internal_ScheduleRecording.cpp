@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "internal_ScheduleRecording.hpp"
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+const std::string ScheduleRecorder::magic = "RMFSCH01";
+
+//==============================================================================
+std::unique_ptr<ScheduleRecorder> ScheduleRecorder::make(
+  const std::string& filename)
+{
+  auto writer =
+    RecordWriter::make(filename, magic, RecordWriter::Flush::Manually);
+  if (!writer)
+    return nullptr;
+
+  return std::unique_ptr<ScheduleRecorder>(
+    new ScheduleRecorder(std::move(writer)));
+}
+
+//==============================================================================
+ScheduleRecorder::ScheduleRecorder(std::unique_ptr<RecordWriter> writer)
+: _writer(std::move(writer))
+{
+  // Do nothing
+}
+
+//==============================================================================
+void ScheduleRecorder::record_registration(const Participant& msg)
+{
+  _record(Kind::Register, msg);
+}
+
+//==============================================================================
+void ScheduleRecorder::record_unregistration(const Participant& msg)
+{
+  _record(Kind::Unregister, msg);
+}
+
+//==============================================================================
+void ScheduleRecorder::record(const Set& msg)
+{
+  _record(Kind::Set, msg);
+}
+
+//==============================================================================
+void ScheduleRecorder::record(const Extend& msg)
+{
+  _record(Kind::Extend, msg);
+}
+
+//==============================================================================
+void ScheduleRecorder::record(const Delay& msg)
+{
+  _record(Kind::Delay, msg);
+}
+
+//==============================================================================
+void ScheduleRecorder::record(const Reached& msg)
+{
+  _record(Kind::Reached, msg);
+}
+
+//==============================================================================
+void ScheduleRecorder::record(const Clear& msg)
+{
+  _record(Kind::Clear, msg);
+}
+
+//==============================================================================
+void ScheduleRecorder::flush()
+{
+  _writer->flush();
+}
+
+//==============================================================================
+template<typename Message>
+void ScheduleRecorder::_record(const Kind kind, const Message& msg)
+{
+  _writer->write(static_cast<uint8_t>(kind), msg);
+}
+
+//==============================================================================
+std::vector<ScheduleRecord> read_schedule_recording(
+  const std::string& filename)
+{
+  return read_records(
+    filename, ScheduleRecorder::magic, ScheduleRecorder::Kind::Clear,
+    "schedule");
+}
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
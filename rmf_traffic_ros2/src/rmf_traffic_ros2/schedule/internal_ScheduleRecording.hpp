@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_SCHEDULERECORDING_HPP
+#define SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_SCHEDULERECORDING_HPP
+
+#include "internal_RecordFile.hpp"
+
+#include <rmf_traffic_msgs/msg/itinerary_clear.hpp>
+#include <rmf_traffic_msgs/msg/itinerary_delay.hpp>
+#include <rmf_traffic_msgs/msg/itinerary_extend.hpp>
+#include <rmf_traffic_msgs/msg/itinerary_reached.hpp>
+#include <rmf_traffic_msgs/msg/itinerary_set.hpp>
+#include <rmf_traffic_msgs/msg/participant.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+/// Writes the participant registrations and itinerary changes that a schedule
+/// node ingests into a RecordWriter file, so that the load on the schedule
+/// node can be replayed and profiled offline.
+///
+/// Itinerary changes arrive far more often than negotiation messages, so the
+/// records are buffered and only written out when flush() is called or the
+/// recorder is destroyed.
+class ScheduleRecorder
+{
+public:
+
+  enum class Kind : uint8_t
+  {
+    Register = 0,
+    Unregister = 1,
+    Set = 2,
+    Extend = 3,
+    Delay = 4,
+    Reached = 5,
+    Clear = 6
+  };
+
+  using Participant = rmf_traffic_msgs::msg::Participant;
+  using Set = rmf_traffic_msgs::msg::ItinerarySet;
+  using Extend = rmf_traffic_msgs::msg::ItineraryExtend;
+  using Delay = rmf_traffic_msgs::msg::ItineraryDelay;
+  using Reached = rmf_traffic_msgs::msg::ItineraryReached;
+  using Clear = rmf_traffic_msgs::msg::ItineraryClear;
+
+  /// The string that every recording begins with
+  static const std::string magic;
+
+  /// Open a file to record into. Any existing file will be overwritten.
+  /// Returns nullptr if the file could not be opened.
+  static std::unique_ptr<ScheduleRecorder> make(const std::string& filename);
+
+  /// Record that a participant was registered with the given ID
+  void record_registration(const Participant& msg);
+
+  /// Record that a participant was unregistered. Only the ID of the message
+  /// needs to be filled in.
+  void record_unregistration(const Participant& msg);
+
+  void record(const Set& msg);
+  void record(const Extend& msg);
+  void record(const Delay& msg);
+  void record(const Reached& msg);
+  void record(const Clear& msg);
+
+  /// Write out any records that are still buffered
+  void flush();
+
+private:
+
+  ScheduleRecorder(std::unique_ptr<RecordWriter> writer);
+
+  template<typename Message>
+  void _record(Kind kind, const Message& msg);
+
+  std::unique_ptr<RecordWriter> _writer;
+};
+
+//==============================================================================
+/// A single record that was read from a schedule recording
+using ScheduleRecord = Record<ScheduleRecorder::Kind>;
+
+//==============================================================================
+/// Read every record of a schedule recording. Throws std::runtime_error if the
+/// file cannot be opened or is not a schedule recording. A record that was cut
+/// short, e.g. because the recording node was killed, ends the recording
+/// without an error.
+std::vector<ScheduleRecord> read_schedule_recording(
+  const std::string& filename);
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
+
+#endif // SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_SCHEDULERECORDING_HPP
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_WORKERPOOL_HPP
+#define SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_WORKERPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+/// A fixed-size pool of worker threads. Each worker has its own job queue, and
+/// jobs are assigned to workers by key, so all jobs that are posted with the
+/// same key will be run in the same order that they were posted.
+class WorkerPool
+{
+public:
+
+  using Job = std::function<void()>;
+
+  /// Constructor
+  ///
+  /// \param[in] num_threads
+  ///   Number of worker threads to launch. At least one thread will always be
+  ///   launched.
+  WorkerPool(std::size_t num_threads);
+
+  /// Post a job to the worker that is responsible for this key.
+  void post(std::size_t key, Job job);
+
+  /// Get the number of worker threads in this pool.
+  std::size_t size() const;
+
+  /// The destructor will wait for each worker to finish its current job. Any
+  /// jobs that are still queued will be discarded.
+  ~WorkerPool();
+
+private:
+
+  struct Worker
+  {
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Job> queue;
+  };
+
+  void _run(Worker& worker);
+
+  std::vector<std::unique_ptr<Worker>> _workers;
+  std::atomic_bool _quit;
+};
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
+
+#endif // SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_WORKERPOOL_HPP
@@ -18,6 +18,7 @@
 #ifndef SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_CONVERT_VECTOR_HPP
 #define SRC__RMF_TRAFFIC_ROS2__SCHEDULE__INTERNAL_CONVERT_VECTOR_HPP
 
+#include <utility>
 #include <vector>
 
 namespace rmf_traffic_ros2 {
@@ -33,6 +34,21 @@ void convert_vector(
     output.emplace_back(convert(i));
 }
 
+//==============================================================================
+/// Convert a vector whose elements may be moved from, so that any strings or
+/// nested vectors inside of them can be taken over instead of copied.
+template<typename T_out, typename T_in>
+void convert_vector(
+  std::vector<T_out>& output,
+  std::vector<T_in>&& input)
+{
+  output.reserve(output.size() + input.size());
+  for (auto& i : input)
+    output.emplace_back(convert(std::move(i)));
+
+  input.clear();
+}
+
 //==============================================================================
 template<typename T_out, typename T_in>
 std::vector<T_out> convert_vector(
@@ -43,6 +59,16 @@ std::vector<T_out> convert_vector(
   return output;
 }
 
+//==============================================================================
+template<typename T_out, typename T_in>
+std::vector<T_out> convert_vector(
+  std::vector<T_in>&& input)
+{
+  std::vector<T_out> output;
+  convert_vector(output, std::move(input));
+  return output;
+}
+
 } // namespace rmf_traffic_ros2
 
 #endif // INTERNAL_CONVERT_VECTOR_HPP
@@ -19,6 +19,8 @@
 
 #include <rclcpp/rclcpp.hpp>
 
+#include <algorithm>
+
 int main(int argc, char* argv[])
 {
   rclcpp::init(argc, argv);
@@ -29,7 +31,14 @@ int main(int argc, char* argv[])
     node->get_logger(),
     "Beginning traffic schedule node");
 
-  rclcpp::spin(node);
+  // Negotiations are handled in their own callback group, so spinning with
+  // multiple threads keeps them responsive while itineraries are flooding in.
+  const auto threads = static_cast<std::size_t>(
+    std::max<int64_t>(1, node->get_parameter("executor_threads").as_int()));
+  rclcpp::executors::MultiThreadedExecutor executor(
+    rclcpp::ExecutorOptions(), threads);
+  executor.add_node(node);
+  executor.spin();
 
   RCLCPP_INFO(
     node->get_logger(),
@@ -0,0 +1,432 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_traffic_ros2/schedule/MirrorManager.hpp>
+#include <rmf_traffic_ros2/schedule/Node.hpp>
+#include <rmf_traffic_ros2/schedule/Writer.hpp>
+#include <rmf_traffic_ros2/Time.hpp>
+
+#include <rmf_traffic/geometry/Circle.hpp>
+#include <rmf_traffic/schedule/Query.hpp>
+
+#include <rclcpp/executors.hpp>
+#include <rclcpp/node.hpp>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// This benchmark runs a schedule node in-process together with a configurable
+// number of simulated participants and mirrors, and reports how well the
+// schedule node keeps up. The parameters can be set with the usual
+// --ros-args -p <name>:=<value> arguments, and any schedule node parameters
+// that are passed in the same way will be applied to the schedule node too.
+
+namespace {
+
+//==============================================================================
+struct Settings
+{
+  std::size_t participants;
+  std::size_t waypoints;
+  double update_rate;
+  std::size_t mirrors;
+  std::chrono::nanoseconds warmup;
+  std::chrono::nanoseconds duration;
+  std::chrono::nanoseconds poll_period;
+  std::size_t threads;
+};
+
+//==============================================================================
+Settings declare_settings(rclcpp::Node& node)
+{
+  Settings settings;
+
+  // Number of simulated participants
+  settings.participants = static_cast<std::size_t>(
+    std::max<int64_t>(1, node.declare_parameter<int>("participants", 50)));
+
+  // Number of waypoints in each itinerary that gets sent
+  settings.waypoints = static_cast<std::size_t>(
+    std::max<int64_t>(2, node.declare_parameter<int>("waypoints", 10)));
+
+  // How many times per second each participant sends a new itinerary
+  settings.update_rate =
+    std::max(0.01, node.declare_parameter<double>("update_rate", 1.0));
+
+  // Number of mirrors, each with its own query, that follow the schedule
+  settings.mirrors = static_cast<std::size_t>(
+    std::max<int64_t>(1, node.declare_parameter<int>("mirrors", 4)));
+
+  // Seconds to run before measurements begin
+  settings.warmup = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::duration<double>(
+      std::max(0.0, node.declare_parameter<double>("warmup", 5.0))));
+
+  // Seconds to collect measurements for
+  settings.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::duration<double>(
+      std::max(1.0, node.declare_parameter<double>("duration", 30.0))));
+
+  // Milliseconds between checks of the mirrors. This bounds the resolution of
+  // the latency measurements.
+  settings.poll_period = std::chrono::milliseconds(
+    std::max<int64_t>(1, node.declare_parameter<int>("poll_period", 2)));
+
+  // Number of executor threads shared by all of the nodes
+  settings.threads = static_cast<std::size_t>(
+    std::max<int64_t>(3, node.declare_parameter<int>("threads", 4)));
+
+  return settings;
+}
+
+//==============================================================================
+struct Usage
+{
+  std::chrono::steady_clock::time_point wall;
+  double cpu_seconds;
+  long max_rss_kb;
+
+  static Usage now()
+  {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    const auto seconds = [](const timeval& t)
+      {
+        return static_cast<double>(t.tv_sec) + 1e-6 * t.tv_usec;
+      };
+
+    return Usage{
+      std::chrono::steady_clock::now(),
+      seconds(usage.ru_utime) + seconds(usage.ru_stime),
+      usage.ru_maxrss
+    };
+  }
+};
+
+//==============================================================================
+double percentile(const std::vector<double>& sorted, const double p)
+{
+  if (sorted.empty())
+    return 0.0;
+
+  const auto index = static_cast<std::size_t>(p * (sorted.size() - 1));
+  return sorted[index];
+}
+
+//==============================================================================
+class Load
+{
+public:
+
+  Load(
+    std::shared_ptr<rclcpp::Node> node,
+    std::vector<rmf_traffic::schedule::Participant> participants,
+    const Settings& settings)
+  : _node(std::move(node)),
+    _participants(std::move(participants)),
+    _waypoints(settings.waypoints),
+    _total_rate(settings.update_rate * _participants.size()),
+    _start(std::chrono::steady_clock::now())
+  {
+    _timer = _node->create_wall_timer(
+      std::chrono::milliseconds(1), [this]() { _send(); });
+  }
+
+  std::size_t sent() const
+  {
+    return _sent;
+  }
+
+private:
+
+  void _send()
+  {
+    // Send however many updates are due to keep up the overall rate, cycling
+    // through the participants so that each one updates at the requested rate.
+    const double elapsed = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - _start).count();
+    const auto due = static_cast<std::size_t>(elapsed * _total_rate);
+
+    for (; _sent < due; ++_sent)
+    {
+      auto& participant = _participants[_sent % _participants.size()];
+      participant.set(
+        participant.plan_id_assigner()->assign(),
+        {{"benchmark_map", _make_trajectory(_sent % _participants.size())}});
+    }
+  }
+
+  rmf_traffic::Trajectory _make_trajectory(const std::size_t index) const
+  {
+    // Each participant gets its own lane so that no conflicts get detected.
+    // The first waypoint is stamped with the current time, which is how the
+    // mirrors measure how long it took for the change to reach them.
+    const auto now = rmf_traffic_ros2::convert(_node->get_clock()->now());
+    const double y = 10.0 * index;
+    rmf_traffic::Trajectory trajectory;
+    for (std::size_t i = 0; i < _waypoints; ++i)
+    {
+      trajectory.insert(
+        now + std::chrono::seconds(i),
+        Eigen::Vector3d(static_cast<double>(i), y, 0.0),
+        Eigen::Vector3d::UnitX());
+    }
+
+    return trajectory;
+  }
+
+  std::shared_ptr<rclcpp::Node> _node;
+  std::vector<rmf_traffic::schedule::Participant> _participants;
+  std::size_t _waypoints;
+  double _total_rate;
+  std::chrono::steady_clock::time_point _start;
+  std::size_t _sent = 0;
+  rclcpp::TimerBase::SharedPtr _timer;
+};
+
+//==============================================================================
+class Observer
+{
+public:
+
+  Observer(
+    std::shared_ptr<rclcpp::Node> node,
+    std::vector<rmf_traffic_ros2::schedule::MirrorManager> mirrors,
+    std::vector<rmf_traffic::schedule::ParticipantId> participants,
+    std::chrono::nanoseconds poll_period)
+  : _node(std::move(node)),
+    _mirrors(std::move(mirrors)),
+    _participants(std::move(participants)),
+    _last_seen(_mirrors.size())
+  {
+    _timer = _node->create_wall_timer(poll_period, [this]() { _poll(); });
+  }
+
+  void start_recording()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _latencies.clear();
+    _recording = true;
+  }
+
+  std::vector<double> stop_recording()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _recording = false;
+    return std::move(_latencies);
+  }
+
+private:
+
+  void _poll()
+  {
+    const auto now = rmf_traffic_ros2::convert(_node->get_clock()->now());
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (std::size_t m = 0; m < _mirrors.size(); ++m)
+    {
+      const auto view = _mirrors[m].view();
+      auto& last_seen = _last_seen[m];
+      for (const auto p : _participants)
+      {
+        const auto itinerary = view->get_itinerary(p);
+        if (!itinerary.has_value() || itinerary->empty())
+          continue;
+
+        const auto& trajectory = itinerary->front()->trajectory();
+        if (trajectory.size() == 0)
+          continue;
+
+        const auto stamp = *trajectory.start_time();
+        const auto it = last_seen.insert({p, stamp});
+        if (!it.second && it.first->second == stamp)
+          continue;
+
+        it.first->second = stamp;
+        if (_recording)
+          _latencies.push_back(rmf_traffic::time::to_seconds(now - stamp));
+      }
+    }
+  }
+
+  std::shared_ptr<rclcpp::Node> _node;
+  std::vector<rmf_traffic_ros2::schedule::MirrorManager> _mirrors;
+  std::vector<rmf_traffic::schedule::ParticipantId> _participants;
+  std::vector<std::unordered_map<rmf_traffic::schedule::ParticipantId,
+    rmf_traffic::Time>> _last_seen;
+  std::vector<double> _latencies;
+  bool _recording = false;
+  std::mutex _mutex;
+  rclcpp::TimerBase::SharedPtr _timer;
+};
+
+} // anonymous namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  rclcpp::init(argc, argv);
+  using namespace std::chrono_literals;
+
+  auto load_node = std::make_shared<rclcpp::Node>("schedule_benchmark_load");
+  auto observer_node =
+    std::make_shared<rclcpp::Node>("schedule_benchmark_observer");
+  const auto settings = declare_settings(*load_node);
+
+  // Keep the participant registry of the benchmark out of the way of any real
+  // schedule node.
+  const auto log_file = (std::filesystem::temp_directory_path()
+    / ("rmf_schedule_benchmark_" + std::to_string(getpid()) + ".yaml"))
+    .string();
+  auto schedule_node = rmf_traffic_ros2::schedule::make_node(
+    rclcpp::NodeOptions()
+    .parameter_overrides({{"log_file_location", log_file}}));
+
+  rclcpp::executors::MultiThreadedExecutor executor(
+    rclcpp::ExecutorOptions(), settings.threads);
+  executor.add_node(schedule_node);
+  executor.add_node(load_node);
+  executor.add_node(observer_node);
+  std::thread spin_thread([&executor]() { executor.spin(); });
+
+  const auto cleanup = [&]()
+    {
+      executor.cancel();
+      spin_thread.join();
+      std::filesystem::remove(log_file);
+      rclcpp::shutdown();
+    };
+
+  std::cout << "Registering " << settings.participants << " participants"
+            << std::endl;
+  const auto writer = rmf_traffic_ros2::schedule::Writer::make(load_node);
+  std::vector<std::future<rmf_traffic::schedule::Participant>> futures;
+  for (std::size_t i = 0; i < settings.participants; ++i)
+  {
+    futures.emplace_back(
+      writer->make_participant(
+        rmf_traffic::schedule::ParticipantDescription(
+          "benchmark_" + std::to_string(i),
+          "benchmark",
+          rmf_traffic::schedule::ParticipantDescription::Rx::Unresponsive,
+          rmf_traffic::Profile(
+            rmf_traffic::geometry::make_final_convex<
+              rmf_traffic::geometry::Circle>(0.5)))));
+  }
+
+  std::vector<rmf_traffic::schedule::Participant> participants;
+  std::vector<rmf_traffic::schedule::ParticipantId> participant_ids;
+  for (auto& future : futures)
+  {
+    if (future.wait_for(30s) != std::future_status::ready)
+    {
+      std::cerr << "Timed out while registering participants" << std::endl;
+      cleanup();
+      return 1;
+    }
+
+    participants.emplace_back(future.get());
+    participant_ids.push_back(participants.back().id());
+  }
+
+  std::cout << "Creating " << settings.mirrors << " mirrors" << std::endl;
+  std::vector<rmf_traffic_ros2::schedule::MirrorManager> mirrors;
+  for (std::size_t i = 0; i < settings.mirrors; ++i)
+  {
+    // Give each mirror a distinct query so that each one gets its own topic,
+    // while still covering every participant.
+    auto future = rmf_traffic_ros2::schedule::make_mirror(
+      observer_node,
+      rmf_traffic::schedule::make_query(
+        {"benchmark_map", "benchmark_mirror_" + std::to_string(i)}));
+
+    if (future.wait_for(30s) != std::future_status::ready)
+    {
+      std::cerr << "Timed out while creating mirrors" << std::endl;
+      cleanup();
+      return 1;
+    }
+
+    mirrors.emplace_back(future.get());
+  }
+
+  Load load(load_node, std::move(participants), settings);
+  Observer observer(
+    observer_node, std::move(mirrors), participant_ids, settings.poll_period);
+
+  std::cout << "Warming up for "
+            << rmf_traffic::time::to_seconds(settings.warmup) << "s"
+            << std::endl;
+  std::this_thread::sleep_for(settings.warmup);
+
+  std::cout << "Measuring for "
+            << rmf_traffic::time::to_seconds(settings.duration) << "s"
+            << std::endl;
+  const auto start_usage = Usage::now();
+  const std::size_t start_sent = load.sent();
+  observer.start_recording();
+  std::this_thread::sleep_for(settings.duration);
+  auto latencies = observer.stop_recording();
+  const std::size_t finish_sent = load.sent();
+  const auto finish_usage = Usage::now();
+
+  cleanup();
+
+  const double wall = std::chrono::duration<double>(
+    finish_usage.wall - start_usage.wall).count();
+  const std::size_t sent = finish_sent - start_sent;
+  const std::size_t expected = sent * settings.mirrors;
+  std::sort(latencies.begin(), latencies.end());
+
+  std::printf("\n");
+  std::printf("participants:           %lu\n", settings.participants);
+  std::printf("waypoints per update:   %lu\n", settings.waypoints);
+  std::printf("mirrors:                %lu\n", settings.mirrors);
+  std::printf("itinerary updates/s:    %.1f\n", sent / wall);
+  std::printf(
+    "mirror updates seen/s:  %.1f (%.1f%% of sent updates)\n",
+    latencies.size() / wall,
+    expected > 0 ? 100.0 * latencies.size() / expected : 0.0);
+  std::printf(
+    "mirror latency (ms):    p50 %.2f  p90 %.2f  p99 %.2f  max %.2f\n",
+    1e3 * percentile(latencies, 0.50),
+    1e3 * percentile(latencies, 0.90),
+    1e3 * percentile(latencies, 0.99),
+    latencies.empty() ? 0.0 : 1e3 * latencies.back());
+  std::printf(
+    "cpu usage:              %.2f cores\n",
+    (finish_usage.cpu_seconds - start_usage.cpu_seconds) / wall);
+  std::printf(
+    "peak memory:            %.1f MB\n", finish_usage.max_rss_kb / 1024.0);
+  std::printf(
+    "\nLatencies are measured by polling the mirrors every %ld ms, and updates "
+    "that are superseded before a poll are not counted.\n",
+    std::chrono::duration_cast<std::chrono::milliseconds>(
+      settings.poll_period).count());
+
+  return 0;
+}
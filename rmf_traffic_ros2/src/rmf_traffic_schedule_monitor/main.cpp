@@ -20,6 +20,8 @@
 
 #include <rclcpp/rclcpp.hpp>
 
+#include <algorithm>
+
 int main(int argc, char* argv[])
 {
   rclcpp::init(argc, argv);
@@ -46,7 +48,13 @@ int main(int argc, char* argv[])
     RCLCPP_INFO(
       active_schedule_node->get_logger(),
       "Spinning up replacement schedule node");
-    rclcpp::spin(active_schedule_node);
+    const auto threads = static_cast<std::size_t>(
+      std::max<int64_t>(
+        1, active_schedule_node->get_parameter("executor_threads").as_int()));
+    rclcpp::executors::MultiThreadedExecutor executor(
+      rclcpp::ExecutorOptions(), threads);
+    executor.add_node(active_schedule_node);
+    executor.spin();
     RCLCPP_INFO(
       active_schedule_node->get_logger(),
       "Shutting down replacement schedule node");
@@ -0,0 +1,640 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "../rmf_traffic_ros2/schedule/internal_Node.hpp"
+#include "../rmf_traffic_ros2/schedule/internal_ScheduleRecording.hpp"
+
+#include <rmf_traffic_ros2/StandardNames.hpp>
+#include <rmf_traffic_ros2/schedule/MirrorManager.hpp>
+#include <rmf_traffic_ros2/schedule/ParticipantDescription.hpp>
+
+#include <rmf_traffic/geometry/Circle.hpp>
+#include <rmf_traffic/schedule/Database.hpp>
+#include <rmf_traffic/schedule/Query.hpp>
+
+#include <rclcpp/executors.hpp>
+#include <rclcpp/node.hpp>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// This tool replays a schedule recording that was made by a schedule node with
+// its schedule_record_file parameter set. A fresh schedule node is started
+// in-process with every recorded participant registered under its original
+// ID, and the recorded itinerary changes are published to it on the usual
+// topics with their original timing, optionally sped up. The tool reports:
+//
+// * throughput: how many changes per second were sent, and how far the replay
+//   fell behind the recorded timing.
+// * mirror latency: how long it took for each new plan to show up in the
+//   mirrors, measured by polling them.
+// * conflict detection lag: how long after the last change of its participants
+//   the schedule node announced each conflict.
+//
+// The parameters of the replay can be set with --ros-args -p <name>:=<value>,
+// and any schedule node parameters that are passed in the same way will be
+// applied to the schedule node too, so different settings can be compared
+// against the same load.
+
+namespace {
+
+using rmf_traffic_ros2::schedule::ScheduleRecord;
+using rmf_traffic_ros2::schedule::ScheduleRecorder;
+using Kind = ScheduleRecorder::Kind;
+using ParticipantId = rmf_traffic::schedule::ParticipantId;
+using Clock = std::chrono::steady_clock;
+
+//==============================================================================
+struct Settings
+{
+  double speed;
+  std::size_t mirrors;
+  std::chrono::nanoseconds poll_period;
+  std::chrono::nanoseconds drain;
+  std::size_t threads;
+};
+
+//==============================================================================
+Settings declare_settings(rclcpp::Node& node)
+{
+  Settings settings;
+
+  // How many times faster than the recorded timing the changes are sent. A
+  // value of zero sends the changes as fast as possible.
+  settings.speed = std::max(0.0, node.declare_parameter<double>("speed", 1.0));
+
+  // Number of mirrors that follow the schedule
+  settings.mirrors = static_cast<std::size_t>(
+    std::max<int64_t>(1, node.declare_parameter<int>("mirrors", 1)));
+
+  // Milliseconds between checks of the mirrors. This bounds the resolution of
+  // the latency measurements.
+  settings.poll_period = std::chrono::milliseconds(
+    std::max<int64_t>(1, node.declare_parameter<int>("poll_period", 2)));
+
+  // Seconds to keep measuring after the last change was sent
+  settings.drain = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::duration<double>(
+      std::max(0.0, node.declare_parameter<double>("drain", 2.0))));
+
+  // Number of executor threads shared by all of the nodes
+  settings.threads = static_cast<std::size_t>(
+    std::max<int64_t>(3, node.declare_parameter<int>("threads", 4)));
+
+  return settings;
+}
+
+//==============================================================================
+struct Usage
+{
+  Clock::time_point wall;
+  double cpu_seconds;
+  long max_rss_kb;
+
+  static Usage now()
+  {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    const auto seconds = [](const timeval& t)
+      {
+        return static_cast<double>(t.tv_sec) + 1e-6 * t.tv_usec;
+      };
+
+    return Usage{
+      Clock::now(),
+      seconds(usage.ru_utime) + seconds(usage.ru_stime),
+      usage.ru_maxrss
+    };
+  }
+};
+
+//==============================================================================
+double percentile(const std::vector<double>& sorted, const double p)
+{
+  if (sorted.empty())
+    return 0.0;
+
+  const auto index = static_cast<std::size_t>(p * (sorted.size() - 1));
+  return sorted[index];
+}
+
+//==============================================================================
+void print_latencies(const char* name, std::vector<double> latencies)
+{
+  std::sort(latencies.begin(), latencies.end());
+  std::printf(
+    "%-24s n %-6lu p50 %.2f  p90 %.2f  p99 %.2f  max %.2f\n",
+    name, latencies.size(),
+    1e3 * percentile(latencies, 0.50),
+    1e3 * percentile(latencies, 0.90),
+    1e3 * percentile(latencies, 0.99),
+    latencies.empty() ? 0.0 : 1e3 * latencies.back());
+}
+
+//==============================================================================
+/// Make a database where every recorded participant has its recorded ID
+std::shared_ptr<rmf_traffic::schedule::Database> make_database(
+  const std::vector<ScheduleRecord>& records,
+  std::vector<ParticipantId>& participants)
+{
+  std::map<ParticipantId, rmf_traffic::schedule::ParticipantDescription>
+  descriptions;
+  for (const auto& record : records)
+  {
+    if (record.kind != Kind::Register)
+      continue;
+
+    const auto msg = record.get<ScheduleRecorder::Participant>();
+    descriptions.insert_or_assign(
+      msg.id, rmf_traffic_ros2::convert(msg.description));
+  }
+
+  // The database hands out participant IDs in order, so we fill the gaps
+  // between the recorded IDs with placeholders to give each recorded
+  // participant the same ID that it had when it was recorded.
+  const rmf_traffic::schedule::ParticipantDescription placeholder(
+    "placeholder", "rmf_traffic_schedule_replay",
+    rmf_traffic::schedule::ParticipantDescription::Rx::Unresponsive,
+    rmf_traffic::Profile(
+      rmf_traffic::geometry::make_final_convex<
+        rmf_traffic::geometry::Circle>(0.1)));
+
+  auto database = std::make_shared<rmf_traffic::schedule::Database>();
+  std::vector<ParticipantId> placeholders;
+  for (const auto& [id, description] : descriptions)
+  {
+    while (true)
+    {
+      const auto next = database->register_participant(placeholder).id();
+      if (next == id)
+      {
+        database->update_description(id, description);
+        participants.push_back(id);
+        break;
+      }
+
+      placeholders.push_back(next);
+      if (next > id)
+      {
+        std::cerr << "Unable to give participant [" << id << "] its "
+                  << "recorded ID" << std::endl;
+        break;
+      }
+    }
+  }
+
+  for (const auto id : placeholders)
+    database->unregister_participant(id);
+
+  return database;
+}
+
+//==============================================================================
+/// Keeps track of when the changes of each participant were sent, so that the
+/// observers can tell how long it took for the changes to have an effect.
+class SendLog
+{
+public:
+
+  void sent(const ParticipantId participant, const Clock::time_point time)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _last_sent[participant] = time;
+  }
+
+  void sent_plan(
+    const ParticipantId participant,
+    const uint64_t plan,
+    const Clock::time_point time)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _last_sent[participant] = time;
+    auto& plans = _plans[participant];
+    plans.insert({plan, time});
+
+    // Plans that the mirrors still have not seen by now were superseded
+    while (plans.size() > 64)
+      plans.erase(plans.begin());
+  }
+
+  /// The time that a plan was sent, or nullopt if it was not sent
+  std::optional<Clock::time_point> plan_sent(
+    const ParticipantId participant,
+    const uint64_t plan) const
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto p_it = _plans.find(participant);
+    if (p_it == _plans.end())
+      return std::nullopt;
+
+    const auto it = p_it->second.find(plan);
+    if (it == p_it->second.end())
+      return std::nullopt;
+
+    return it->second;
+  }
+
+  /// The latest time that a change was sent for any of the participants
+  std::optional<Clock::time_point> last_sent(
+    const std::vector<ParticipantId>& participants) const
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::optional<Clock::time_point> latest;
+    for (const auto p : participants)
+    {
+      const auto it = _last_sent.find(p);
+      if (it == _last_sent.end())
+        continue;
+
+      if (!latest.has_value() || *latest < it->second)
+        latest = it->second;
+    }
+
+    return latest;
+  }
+
+private:
+  mutable std::mutex _mutex;
+  std::unordered_map<ParticipantId, Clock::time_point> _last_sent;
+  std::unordered_map<ParticipantId, std::map<uint64_t, Clock::time_point>>
+  _plans;
+};
+
+//==============================================================================
+class Observer
+{
+public:
+
+  Observer(
+    std::shared_ptr<rclcpp::Node> node,
+    std::vector<rmf_traffic_ros2::schedule::MirrorManager> mirrors,
+    std::vector<ParticipantId> participants,
+    std::shared_ptr<SendLog> log,
+    std::chrono::nanoseconds poll_period)
+  : _node(std::move(node)),
+    _mirrors(std::move(mirrors)),
+    _participants(std::move(participants)),
+    _log(std::move(log)),
+    _last_seen(_mirrors.size())
+  {
+    _timer = _node->create_wall_timer(poll_period, [this]() { _poll(); });
+
+    _notice_sub = _node->create_subscription<ConflictNotice>(
+      rmf_traffic_ros2::NegotiationNoticeTopicName,
+      rclcpp::ServicesQoS().reliable().keep_last(1000),
+      [this](const ConflictNotice::UniquePtr msg) { _receive(*msg); });
+  }
+
+  std::vector<double> mirror_latencies()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _mirror_latencies;
+  }
+
+  std::vector<double> conflict_lags()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _conflict_lags;
+  }
+
+private:
+
+  using ConflictNotice = rmf_traffic_msgs::msg::NegotiationNotice;
+
+  void _poll()
+  {
+    const auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (std::size_t m = 0; m < _mirrors.size(); ++m)
+    {
+      const auto view = _mirrors[m].view();
+      auto& last_seen = _last_seen[m];
+      for (const auto p : _participants)
+      {
+        const auto plan = view->get_current_plan_id(p);
+        if (!plan.has_value())
+          continue;
+
+        const auto it = last_seen.insert({p, *plan});
+        if (!it.second && it.first->second == *plan)
+          continue;
+
+        it.first->second = *plan;
+        const auto sent = _log->plan_sent(p, *plan);
+        if (sent.has_value())
+        {
+          _mirror_latencies.push_back(
+            std::chrono::duration<double>(now - *sent).count());
+        }
+      }
+    }
+  }
+
+  void _receive(const ConflictNotice& msg)
+  {
+    const auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // The schedule node repeats its notices until the negotiation gets
+    // acknowledged, so only the first notice of each conflict is measured.
+    if (!_noticed.insert(msg.conflict_version).second)
+      return;
+
+    const auto sent = _log->last_sent(msg.participants);
+    if (!sent.has_value())
+      return;
+
+    _conflict_lags.push_back(
+      std::chrono::duration<double>(now - *sent).count());
+  }
+
+  std::shared_ptr<rclcpp::Node> _node;
+  std::vector<rmf_traffic_ros2::schedule::MirrorManager> _mirrors;
+  std::vector<ParticipantId> _participants;
+  std::shared_ptr<SendLog> _log;
+  std::vector<std::unordered_map<ParticipantId, uint64_t>> _last_seen;
+  std::unordered_set<uint64_t> _noticed;
+  std::vector<double> _mirror_latencies;
+  std::vector<double> _conflict_lags;
+  std::mutex _mutex;
+  rclcpp::TimerBase::SharedPtr _timer;
+  rclcpp::Subscription<ConflictNotice>::SharedPtr _notice_sub;
+};
+
+//==============================================================================
+class Player
+{
+public:
+
+  Player(
+    std::shared_ptr<rclcpp::Node> node,
+    std::shared_ptr<SendLog> log)
+  : _node(std::move(node)),
+    _log(std::move(log))
+  {
+    // The publishers keep more history than the schedule node subscriptions
+    // so that accelerated replays do not lose changes on our side.
+    const auto qos = rclcpp::SystemDefaultsQoS().reliable().keep_last(1000);
+    _set_pub = _node->create_publisher<ScheduleRecorder::Set>(
+      rmf_traffic_ros2::ItinerarySetTopicName, qos);
+    _extend_pub = _node->create_publisher<ScheduleRecorder::Extend>(
+      rmf_traffic_ros2::ItineraryExtendTopicName, qos);
+    _delay_pub = _node->create_publisher<ScheduleRecorder::Delay>(
+      rmf_traffic_ros2::ItineraryDelayTopicName, qos);
+    _reached_pub = _node->create_publisher<ScheduleRecorder::Reached>(
+      rmf_traffic_ros2::ItineraryReachedTopicName, qos);
+    _clear_pub = _node->create_publisher<ScheduleRecorder::Clear>(
+      rmf_traffic_ros2::ItineraryClearTopicName, qos);
+    _unregister_client = _node->create_client<Unregister>(
+      rmf_traffic_ros2::UnregisterParticipantSrvName);
+  }
+
+  /// Send the change of a record. Returns true if the record was a change.
+  bool play(const ScheduleRecord& record)
+  {
+    const auto now = Clock::now();
+    switch (record.kind)
+    {
+      case Kind::Register:
+        return false;
+      case Kind::Unregister:
+      {
+        const auto msg = record.get<ScheduleRecorder::Participant>();
+        auto request = std::make_shared<Unregister::Request>();
+        request->participant_id = msg.id;
+        _unregister_client->async_send_request(request);
+        _log->sent(msg.id, now);
+        return true;
+      }
+      case Kind::Set:
+      {
+        const auto msg = record.get<ScheduleRecorder::Set>();
+        _log->sent_plan(msg.participant, msg.plan, now);
+        _set_pub->publish(msg);
+        return true;
+      }
+      case Kind::Extend:
+        return _publish<ScheduleRecorder::Extend>(record, *_extend_pub, now);
+      case Kind::Delay:
+        return _publish<ScheduleRecorder::Delay>(record, *_delay_pub, now);
+      case Kind::Reached:
+        return _publish<ScheduleRecorder::Reached>(record, *_reached_pub, now);
+      case Kind::Clear:
+        return _publish<ScheduleRecorder::Clear>(record, *_clear_pub, now);
+    }
+
+    return false;
+  }
+
+private:
+
+  using Unregister = rmf_traffic_msgs::srv::UnregisterParticipant;
+
+  template<typename Message>
+  bool _publish(
+    const ScheduleRecord& record,
+    rclcpp::Publisher<Message>& publisher,
+    const Clock::time_point now)
+  {
+    const auto msg = record.get<Message>();
+    _log->sent(msg.participant, now);
+    publisher.publish(msg);
+    return true;
+  }
+
+  std::shared_ptr<rclcpp::Node> _node;
+  std::shared_ptr<SendLog> _log;
+  rclcpp::Publisher<ScheduleRecorder::Set>::SharedPtr _set_pub;
+  rclcpp::Publisher<ScheduleRecorder::Extend>::SharedPtr _extend_pub;
+  rclcpp::Publisher<ScheduleRecorder::Delay>::SharedPtr _delay_pub;
+  rclcpp::Publisher<ScheduleRecorder::Reached>::SharedPtr _reached_pub;
+  rclcpp::Publisher<ScheduleRecorder::Clear>::SharedPtr _clear_pub;
+  rclcpp::Client<Unregister>::SharedPtr _unregister_client;
+};
+
+} // anonymous namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  const auto args = rclcpp::init_and_remove_ros_arguments(argc, argv);
+  if (args.size() < 2)
+  {
+    std::cerr << "Usage: " << args[0] << " <recording file> "
+              << "[--ros-args -p <name>:=<value> ...]" << std::endl;
+    rclcpp::shutdown();
+    return 1;
+  }
+
+  std::vector<ScheduleRecord> records;
+  try
+  {
+    records = rmf_traffic_ros2::schedule::read_schedule_recording(args[1]);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    rclcpp::shutdown();
+    return 1;
+  }
+
+  using namespace std::chrono_literals;
+  auto player_node = std::make_shared<rclcpp::Node>("schedule_replay_player");
+  auto observer_node =
+    std::make_shared<rclcpp::Node>("schedule_replay_observer");
+  const auto settings = declare_settings(*player_node);
+
+  std::vector<ParticipantId> participants;
+  const auto database = make_database(records, participants);
+
+  // Keep the participant registry of the replay out of the way of any real
+  // schedule node.
+  const auto log_file = (std::filesystem::temp_directory_path()
+    / ("rmf_schedule_replay_" + std::to_string(getpid()) + ".yaml"))
+    .string();
+  auto schedule_node =
+    std::make_shared<rmf_traffic_ros2::schedule::ScheduleNode>(
+    database,
+    rmf_traffic_ros2::schedule::ScheduleNode::QueryMap(),
+    rclcpp::NodeOptions()
+    .parameter_overrides({{"log_file_location", log_file}}));
+
+  rclcpp::executors::MultiThreadedExecutor executor(
+    rclcpp::ExecutorOptions(), settings.threads);
+  executor.add_node(schedule_node);
+  executor.add_node(player_node);
+  executor.add_node(observer_node);
+  std::thread spin_thread([&executor]() { executor.spin(); });
+
+  const auto cleanup = [&]()
+    {
+      executor.cancel();
+      spin_thread.join();
+      std::filesystem::remove(log_file);
+      rclcpp::shutdown();
+    };
+
+  std::cout << "Creating " << settings.mirrors << " mirrors" << std::endl;
+  std::vector<rmf_traffic_ros2::schedule::MirrorManager> mirrors;
+  for (std::size_t i = 0; i < settings.mirrors; ++i)
+  {
+    auto future = rmf_traffic_ros2::schedule::make_mirror(
+      observer_node, rmf_traffic::schedule::query_all());
+
+    if (future.wait_for(30s) != std::future_status::ready)
+    {
+      std::cerr << "Timed out while creating mirrors" << std::endl;
+      cleanup();
+      return 1;
+    }
+
+    mirrors.emplace_back(future.get());
+  }
+
+  const auto log = std::make_shared<SendLog>();
+  Player player(player_node, log);
+  Observer observer(
+    observer_node, std::move(mirrors), participants, log,
+    settings.poll_period);
+
+  // Give the subscriptions of the schedule node a moment to discover the
+  // publishers so that the first changes do not get lost.
+  std::this_thread::sleep_for(1s);
+
+  std::cout << "Replaying " << records.size() << " records with "
+            << participants.size() << " participants from [" << args[1]
+            << "]";
+  if (settings.speed > 0.0)
+    std::cout << " at " << settings.speed << "x speed" << std::endl;
+  else
+    std::cout << " as fast as possible" << std::endl;
+
+  const auto start_usage = Usage::now();
+  std::size_t sent = 0;
+  double max_behind = 0.0;
+  for (const auto& record : records)
+  {
+    if (settings.speed > 0.0)
+    {
+      const auto due = start_usage.wall
+        + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(
+          std::chrono::duration<double>(record.time).count()
+          / settings.speed));
+
+      const auto now = Clock::now();
+      if (now < due)
+        std::this_thread::sleep_until(due);
+      else
+        max_behind = std::max(
+          max_behind, std::chrono::duration<double>(now - due).count());
+    }
+
+    if (player.play(record))
+      ++sent;
+  }
+  const auto finish_usage = Usage::now();
+
+  std::this_thread::sleep_for(settings.drain);
+  const auto mirror_latencies = observer.mirror_latencies();
+  const auto conflict_lags = observer.conflict_lags();
+  cleanup();
+
+  const double wall = std::chrono::duration<double>(
+    finish_usage.wall - start_usage.wall).count();
+  const double recorded = records.empty() ? 0.0 :
+    std::chrono::duration<double>(records.back().time).count();
+
+  std::printf("\n");
+  std::printf("changes sent:             %lu\n", sent);
+  std::printf(
+    "replay duration:          %.2f s (%.2f s recorded)\n", wall, recorded);
+  std::printf(
+    "changes/s:                %.1f\n", wall > 0.0 ? sent / wall : 0.0);
+  std::printf("max behind recording:     %.2f ms\n", 1e3 * max_behind);
+  print_latencies("mirror latency (ms):", mirror_latencies);
+  print_latencies("conflict lag (ms):", conflict_lags);
+  std::printf(
+    "cpu usage:                %.2f cores\n",
+    wall > 0.0 ? (finish_usage.cpu_seconds - start_usage.cpu_seconds) / wall
+    : 0.0);
+  std::printf(
+    "peak memory:              %.1f MB\n", finish_usage.max_rss_kb / 1024.0);
+  std::printf(
+    "\nMirror latencies are measured by polling the mirrors every %ld ms, and "
+    "plans that are superseded before a poll are not counted. Conflict lags "
+    "are measured from the last change that was sent for any participant of "
+    "the conflict.\n",
+    std::chrono::duration_cast<std::chrono::milliseconds>(
+      settings.poll_period).count());
+
+  return 0;
+}
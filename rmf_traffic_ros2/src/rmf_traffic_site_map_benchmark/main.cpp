@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_traffic_ros2/agv/Graph.hpp>
+
+#include <nlohmann/json.hpp>
+#include <zlib.h>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// This benchmark generates a synthetic gzipped GeoJSON site map with a grid of
+// navigation graph vertices and lanes, padded with a configurable number of
+// features that are not part of the navigation graph (walls, floors, etc),
+// which is what makes real campus maps large. It then compares the streaming
+// conversion done by rmf_traffic_ros2::convert against inflating the whole
+// document and parsing it into a DOM, which is what convert used to do.
+//
+// Each approach runs in its own child process so that their peak resident set
+// sizes can be compared.
+//
+// Usage: rmf_traffic_site_map_benchmark [grid_size] [filler_features]
+
+namespace {
+
+//==============================================================================
+std::string make_site_map(std::size_t grid_size, std::size_t filler_features)
+{
+  // Roughly a metre between vertices
+  const double step = 1e-5;
+  const auto lon = [&](std::size_t i) { return 103.8 + step * i; };
+  const auto lat = [&](std::size_t j) { return 1.3 + step * j; };
+
+  nlohmann::json features = nlohmann::json::array();
+  for (std::size_t i = 0; i < grid_size; ++i)
+  {
+    for (std::size_t j = 0; j < grid_size; ++j)
+    {
+      const std::string name = std::to_string(i) + "_" + std::to_string(j);
+      features.push_back(
+        {
+          {"type", "Feature"},
+          {"feature_type", "rmf_vertex"},
+          {"geometry", {{"type", "Point"}, {"coordinates", {lon(i), lat(j)}}}},
+          {"properties", {{"name", name}}}
+        });
+
+      const auto add_lane = [&](std::size_t i1, std::size_t j1)
+        {
+          features.push_back(
+            {
+              {"type", "Feature"},
+              {"feature_type", "rmf_lane"},
+              {"geometry", {
+                  {"type", "LineString"},
+                  {"coordinates", {{lon(i), lat(j)}, {lon(i1), lat(j1)}}}}},
+              {"properties", {{"bidirectional", true}}}
+            });
+        };
+
+      if (i + 1 < grid_size)
+        add_lane(i + 1, j);
+      if (j + 1 < grid_size)
+        add_lane(i, j + 1);
+    }
+  }
+
+  for (std::size_t k = 0; k < filler_features; ++k)
+  {
+    nlohmann::json outline = nlohmann::json::array();
+    for (std::size_t c = 0; c < 8; ++c)
+      outline.push_back({lon(k % grid_size) + 1e-6 * c, lat(c)});
+
+    features.push_back(
+      {
+        {"type", "Feature"},
+        {"feature_type", "rmf_wall"},
+        {"geometry", {{"type", "LineString"}, {"coordinates", outline}}},
+        {"properties", {{"texture_name", "default"}, {"level_idx", 0}}}
+      });
+  }
+
+  nlohmann::json doc = {
+    {"type", "FeatureCollection"},
+    {"preferred_crs", "EPSG:3857"},
+    {"site_name", "benchmark"},
+    {"features", std::move(features)}
+  };
+
+  return doc.dump();
+}
+
+//==============================================================================
+std::vector<uint8_t> gzip(const std::string& input)
+{
+  z_stream strm;
+  memset(&strm, 0, sizeof(strm));
+  deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+    Z_DEFAULT_STRATEGY);
+
+  std::vector<uint8_t> output(deflateBound(&strm, input.size()));
+  strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+  strm.avail_in = input.size();
+  strm.next_out = output.data();
+  strm.avail_out = output.size();
+  deflate(&strm, Z_FINISH);
+  output.resize(strm.total_out);
+  deflateEnd(&strm);
+  return output;
+}
+
+//==============================================================================
+std::vector<uint8_t> gunzip(const std::vector<uint8_t>& input)
+{
+  z_stream strm;
+  memset(&strm, 0, sizeof(strm));
+  inflateInit2(&strm, 15 + 32);
+  strm.next_in = const_cast<Bytef*>(input.data());
+  strm.avail_in = input.size();
+
+  std::vector<uint8_t> output;
+  std::vector<uint8_t> chunk(128 * 1024);
+  int ret = Z_OK;
+  while (ret == Z_OK)
+  {
+    strm.next_out = chunk.data();
+    strm.avail_out = chunk.size();
+    ret = inflate(&strm, Z_NO_FLUSH);
+    output.insert(
+      output.end(), chunk.begin(), chunk.end() - strm.avail_out);
+  }
+
+  inflateEnd(&strm);
+  return output;
+}
+
+//==============================================================================
+long peak_rss_kb()
+{
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+//==============================================================================
+template<typename F>
+void run_in_child(const std::string& label, F f)
+{
+  std::cout.flush();
+  const pid_t pid = fork();
+  if (pid == 0)
+  {
+    const long baseline = peak_rss_kb();
+    const auto start = std::chrono::steady_clock::now();
+    const std::string result = f();
+    const auto finish = std::chrono::steady_clock::now();
+    const double ms =
+      std::chrono::duration<double, std::milli>(finish - start).count();
+
+    std::printf(
+      "%-10s %10.1f ms   peak RSS %8ld kB (+%ld kB)   %s\n",
+      label.c_str(), ms, peak_rss_kb(), peak_rss_kb() - baseline,
+      result.c_str());
+    std::fflush(stdout);
+    _exit(0);
+  }
+
+  int status = 0;
+  waitpid(pid, &status, 0);
+}
+
+} // anonymous namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  const std::size_t grid_size = argc > 1 ? std::stoul(argv[1]) : 100;
+  const std::size_t filler = argc > 2 ? std::stoul(argv[2]) : 200000;
+
+  rmf_site_map_msgs::msg::SiteMap msg;
+  {
+    const std::string doc = make_site_map(grid_size, filler);
+    msg.encoding = msg.MAP_DATA_GEOJSON_GZ;
+    msg.data = gzip(doc);
+    std::printf(
+      "Site map with %lu vertices and %lu filler features: "
+      "%lu bytes, %lu bytes compressed\n",
+      grid_size * grid_size, filler, doc.size(), msg.data.size());
+  }
+
+  run_in_child(
+    "dom",
+    [&]()
+    {
+      const auto inflated = gunzip(msg.data);
+      const auto j = nlohmann::json::parse(inflated);
+      return std::to_string(j["features"].size()) + " features parsed";
+    });
+
+  run_in_child(
+    "streaming",
+    [&]()
+    {
+      const auto graph = rmf_traffic_ros2::convert(msg);
+      return std::to_string(graph.num_waypoints()) + " waypoints, "
+      + std::to_string(graph.num_lanes()) + " lanes";
+    });
+
+  return 0;
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <rmf_traffic_ros2/schedule/Patch.hpp>
+
+#include <rclcpp/serialization.hpp>
+#include <rclcpp/serialized_message.hpp>
+
+#include "../../src/rmf_traffic_ros2/schedule/internal_CompactMirrorUpdate.hpp"
+
+#include <cmath>
+#include <limits>
+
+using namespace rmf_traffic_ros2::schedule;
+using Change = rmf_traffic::schedule::Change;
+using MirrorUpdate = rmf_traffic_msgs::msg::MirrorUpdate;
+
+namespace {
+//==============================================================================
+MirrorUpdate make_update()
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  std::vector<rmf_traffic::schedule::Patch::Participant> parts;
+  for (std::size_t p = 0; p < 3; ++p)
+  {
+    rmf_traffic::Trajectory trajectory;
+    for (std::size_t w = 0; w < 20; ++w)
+    {
+      const double t = static_cast<double>(w);
+      trajectory.insert(
+        start + std::chrono::milliseconds(1234*w + 7),
+        Eigen::Vector3d(0.37*t, -1.234567 + p, 0.01*t*t),
+        Eigen::Vector3d(0.37, -0.000049, 0.02*t));
+    }
+
+    auto route = std::make_shared<rmf_traffic::Route>(
+      "L" + std::to_string(p), std::move(trajectory));
+    route->checkpoints({1, 3});
+
+    parts.emplace_back(
+      p, p + 10,
+      Change::Erase{{p}},
+      std::vector<Change::Delay>{Change::Delay{std::chrono::seconds(p)}},
+      Change::Add{p, {{7, 8, std::move(route)}}},
+      Change::Progress(p, {0, 1}));
+  }
+
+  MirrorUpdate msg;
+  msg.node_id.node_uuid = "test_CompactMirrorUpdate";
+  msg.database_version = 42;
+  msg.is_remedial_update = true;
+  msg.patch = rmf_traffic_ros2::convert(
+    rmf_traffic::schedule::Patch{std::move(parts), std::nullopt, 3, 4});
+  return msg;
+}
+
+//==============================================================================
+std::size_t regular_size(const MirrorUpdate& msg)
+{
+  rclcpp::Serialization<MirrorUpdate> serialization;
+  rclcpp::SerializedMessage serialized;
+  serialization.serialize_message(&msg, &serialized);
+  return serialized.size();
+}
+
+//==============================================================================
+// Compare everything except the waypoint positions and velocities, which are
+// checked separately against the resolution of the compact format.
+void check_same_except_values(const MirrorUpdate& a, const MirrorUpdate& b)
+{
+  auto a_stripped = a;
+  auto b_stripped = b;
+  for (auto* msg : {&a_stripped, &b_stripped})
+  {
+    for (auto& participant : msg->patch.participants)
+    {
+      for (auto& item : participant.additions.items)
+      {
+        for (auto& wp : item.route.trajectory.waypoints)
+        {
+          wp.position = {0.0, 0.0, 0.0};
+          wp.velocity = {0.0, 0.0, 0.0};
+        }
+      }
+    }
+  }
+
+  CHECK(a_stripped == b_stripped);
+}
+
+//==============================================================================
+double max_value_error(const MirrorUpdate& a, const MirrorUpdate& b)
+{
+  double error = 0.0;
+  const auto& pa = a.patch.participants;
+  const auto& pb = b.patch.participants;
+  for (std::size_t p = 0; p < pa.size(); ++p)
+  {
+    for (std::size_t i = 0; i < pa[p].additions.items.size(); ++i)
+    {
+      const auto& wa = pa[p].additions.items[i].route.trajectory.waypoints;
+      const auto& wb = pb[p].additions.items[i].route.trajectory.waypoints;
+      for (std::size_t w = 0; w < wa.size(); ++w)
+      {
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+          error = std::max(
+            error, std::abs(wa[w].position[k] - wb[w].position[k]));
+          error = std::max(
+            error, std::abs(wa[w].velocity[k] - wb[w].velocity[k]));
+        }
+      }
+    }
+  }
+
+  return error;
+}
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("Compact mirror updates")
+{
+  const auto original = make_update();
+
+  WHEN("An update is encoded and decoded")
+  {
+    const auto data = encode_compact(original);
+    const auto decoded = decode_compact(data);
+
+    THEN("Everything but the rounded values is kept exactly")
+    {
+      check_same_except_values(original, decoded);
+      CHECK(
+        max_value_error(original, decoded)
+        <= CompactMirrorUpdateResolution/2.0 + 1e-12);
+    }
+
+    THEN("The encoding is smaller than the regular one")
+    {
+      CHECK(data.size() < regular_size(original));
+    }
+
+    THEN("Encoding again gives the same data")
+    {
+      CHECK(encode_compact(decoded) == data);
+    }
+  }
+
+  WHEN("An update has a value that cannot be rounded")
+  {
+    auto msg = original;
+    msg.patch.participants[1].additions.items[0].route.trajectory
+    .waypoints[2].position[0] = std::numeric_limits<double>::quiet_NaN();
+
+    const auto decoded = decode_compact(encode_compact(msg));
+
+    THEN("The update is sent without rounding")
+    {
+      CHECK(std::isnan(
+          decoded.patch.participants[1].additions.items[0].route.trajectory
+          .waypoints[2].position[0]));
+      CHECK(max_value_error(original, decoded) == 0.0);
+      check_same_except_values(original, decoded);
+    }
+  }
+
+  WHEN("An update has no trajectories")
+  {
+    MirrorUpdate msg;
+    msg.database_version = 7;
+    CHECK(decode_compact(encode_compact(msg)) == msg);
+  }
+
+  WHEN("The data is malformed")
+  {
+    auto data = encode_compact(original);
+
+    CHECK_THROWS(decode_compact({}));
+
+    auto truncated = data;
+    truncated.pop_back();
+    CHECK_THROWS(decode_compact(truncated));
+
+    auto extended = data;
+    extended.push_back(0);
+    CHECK_THROWS(decode_compact(extended));
+
+    auto unknown = data;
+    unknown[0] = 0xff;
+    CHECK_THROWS(decode_compact(unknown));
+  }
+}
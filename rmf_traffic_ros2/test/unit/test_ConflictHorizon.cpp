@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <rmf_traffic/geometry/Circle.hpp>
+#include <rmf_traffic/schedule/Database.hpp>
+
+#include "../../src/rmf_traffic_ros2/schedule/internal_ConflictHorizon.hpp"
+
+using namespace rmf_traffic_ros2::schedule;
+using namespace std::chrono_literals;
+
+namespace {
+rmf_traffic::Trajectory make_line(
+  const rmf_traffic::Time start,
+  const std::size_t num_waypoints)
+{
+  const Eigen::Vector3d zero = Eigen::Vector3d::Zero();
+  rmf_traffic::Trajectory trajectory;
+  for (std::size_t i = 0; i < num_waypoints; ++i)
+  {
+    trajectory.insert(
+      start + i*10s, Eigen::Vector3d(static_cast<double>(i), 0.0, 0.0), zero);
+  }
+
+  return trajectory;
+}
+
+rmf_traffic::schedule::ParticipantDescription make_description(
+  const std::string& name)
+{
+  return rmf_traffic::schedule::ParticipantDescription{
+    name,
+    "test_ConflictHorizon",
+    rmf_traffic::schedule::ParticipantDescription::Rx::Responsive,
+    rmf_traffic::Profile{
+      rmf_traffic::geometry::make_final_convex<
+        rmf_traffic::geometry::Circle>(1.0)
+    }
+  };
+}
+} // anonymous namespace
+
+SCENARIO("Clip trajectories to the conflict horizon")
+{
+  const auto now = std::chrono::steady_clock::now();
+  const auto trajectory = make_line(now, 5);
+
+  WHEN("The horizon falls between two waypoints")
+  {
+    const auto clipped = clip_to_horizon(trajectory, now + 15s);
+    REQUIRE(clipped.has_value());
+    CHECK(clipped->size() == 3);
+    CHECK(*clipped->finish_time() == now + 20s);
+  }
+
+  WHEN("The horizon falls right on a waypoint")
+  {
+    const auto clipped = clip_to_horizon(trajectory, now + 10s);
+    REQUIRE(clipped.has_value());
+    CHECK(clipped->size() == 2);
+    CHECK(*clipped->finish_time() == now + 10s);
+  }
+
+  WHEN("The horizon is beyond the whole trajectory")
+  {
+    const auto clipped = clip_to_horizon(trajectory, now + 1min);
+    REQUIRE(clipped.has_value());
+    CHECK(clipped->size() == trajectory.size());
+  }
+
+  WHEN("The trajectory starts at the horizon")
+  {
+    CHECK_FALSE(clip_to_horizon(trajectory, now).has_value());
+  }
+
+  WHEN("The trajectory starts beyond the horizon")
+  {
+    CHECK_FALSE(clip_to_horizon(trajectory, now - 5s).has_value());
+  }
+}
+
+SCENARIO("Decide how to check a pair of routes against the horizon")
+{
+  const auto now = std::chrono::steady_clock::now();
+  const auto a = RouteBounds::make(make_line(now, 3));
+  REQUIRE(a.has_value());
+
+  WHEN("Both routes finish before the horizon")
+  {
+    const auto b = RouteBounds::make(make_line(now, 3));
+    REQUIRE(b.has_value());
+    const auto check = HorizonCheck::decide(*a, *b, now + 1min, 10s);
+    CHECK(check.kind == HorizonCheck::Kind::Whole);
+  }
+
+  WHEN("The routes overlap across the horizon")
+  {
+    const auto b = RouteBounds::make(make_line(now, 3));
+    REQUIRE(b.has_value());
+    const auto check = HorizonCheck::decide(*a, *b, now + 5s, 10s);
+    CHECK(check.kind == HorizonCheck::Kind::Clipped);
+    CHECK(check.recheck_time == now + 15s);
+  }
+
+  WHEN("One route starts beyond the horizon")
+  {
+    const auto b = RouteBounds::make(make_line(now + 15s, 3));
+    REQUIRE(b.has_value());
+    const auto check = HorizonCheck::decide(*a, *b, now + 5s, 10s);
+    CHECK(check.kind == HorizonCheck::Kind::Defer);
+    CHECK(check.recheck_time == now + 15s);
+  }
+
+  WHEN("One route starts right at the horizon")
+  {
+    const auto b = RouteBounds::make(make_line(now + 5s, 3));
+    REQUIRE(b.has_value());
+    const auto check = HorizonCheck::decide(*a, *b, now + 5s, 10s);
+    CHECK(check.kind == HorizonCheck::Kind::Defer);
+    CHECK(check.recheck_time == now + 15s);
+  }
+}
+
+SCENARIO("Recheck deferred routes once the horizon reaches them")
+{
+  const auto now = std::chrono::steady_clock::now();
+  auto database = std::make_shared<rmf_traffic::schedule::Database>();
+  const auto description = make_description("participant");
+  auto participant =
+    rmf_traffic::schedule::make_participant(description, database);
+
+  const auto plan_id = participant.plan_id_assigner()->assign();
+  participant.set(plan_id, {{"test_map", make_line(now, 3)}});
+
+  const auto itinerary = database->get_itinerary(participant.id());
+  REQUIRE(itinerary.has_value());
+  REQUIRE(itinerary->size() == 1);
+
+  const ChangedRoute change{
+    participant.id(), plan_id, 0, itinerary->front(), description};
+
+  DeferredRoutes deferred;
+  defer_route(deferred, change, now + 30s);
+  defer_route(deferred, change, now + 20s);
+  defer_route(deferred, change, now + 40s);
+  REQUIRE(deferred.size() == 1);
+  CHECK(deferred.begin()->second.recheck_time == now + 20s);
+
+  ChangedRoutes view_changes;
+
+  WHEN("The horizon has not reached the recheck time")
+  {
+    recheck_deferred_routes(now + 10s, *database, view_changes, deferred);
+    CHECK(view_changes.empty());
+    CHECK(deferred.size() == 1);
+  }
+
+  WHEN("The horizon reaches the recheck time")
+  {
+    recheck_deferred_routes(now + 20s, *database, view_changes, deferred);
+    REQUIRE(view_changes.size() == 1);
+    CHECK(view_changes.front().participant == participant.id());
+    CHECK(view_changes.front().route == itinerary->front());
+    CHECK(deferred.empty());
+  }
+
+  WHEN("The route is already being checked as a new change")
+  {
+    view_changes.push_back(change);
+    recheck_deferred_routes(now + 20s, *database, view_changes, deferred);
+    CHECK(view_changes.size() == 1);
+    CHECK(deferred.empty());
+  }
+
+  WHEN("The participant has replaced its plan")
+  {
+    participant.set(
+      participant.plan_id_assigner()->assign(),
+      {{"test_map", make_line(now, 4)}});
+
+    recheck_deferred_routes(now + 20s, *database, view_changes, deferred);
+    CHECK(view_changes.empty());
+    CHECK(deferred.empty());
+  }
+}
+
+SCENARIO("Only report conflicts between new routes")
+{
+  const auto now = std::chrono::steady_clock::now();
+  auto database = std::make_shared<rmf_traffic::schedule::Database>();
+  auto p0 = rmf_traffic::schedule::make_participant(
+    make_description("p0"), database);
+  auto p1 = rmf_traffic::schedule::make_participant(
+    make_description("p1"), database);
+
+  p0.set(p0.plan_id_assigner()->assign(), {{"test_map", make_line(now, 3)}});
+  p1.set(p1.plan_id_assigner()->assign(), {{"test_map", make_line(now, 3)}});
+
+  const auto route_0 = database->get_itinerary(p0.id())->front();
+  const auto route_1 = database->get_itinerary(p1.id())->front();
+
+  ReportedConflicts reported;
+  CHECK(reported.report({p0.id(), 0, route_0, p1.id(), 0, route_1}));
+
+  // Finding the same conflict again, from either side, is not reported
+  CHECK_FALSE(reported.report({p0.id(), 0, route_0, p1.id(), 0, route_1}));
+  CHECK_FALSE(reported.report({p1.id(), 0, route_1, p0.id(), 0, route_0}));
+
+  reported.prune(*database);
+  CHECK(reported.size() == 1);
+
+  WHEN("One of the routes changes")
+  {
+    p1.set(
+      p1.plan_id_assigner()->assign(), {{"test_map", make_line(now, 4)}});
+    const auto new_route_1 = database->get_itinerary(p1.id())->front();
+
+    reported.prune(*database);
+    CHECK(reported.size() == 0);
+    CHECK(reported.report({p0.id(), 0, route_0, p1.id(), 0, new_route_1}));
+  }
+}
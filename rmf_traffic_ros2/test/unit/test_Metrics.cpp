@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include "../../src/rmf_traffic_ros2/schedule/internal_Metrics.hpp"
+
+#include <statistics_msgs/msg/statistic_data_type.hpp>
+
+#include <cmath>
+
+using rmf_traffic_ros2::schedule::Metrics;
+using DataType = statistics_msgs::msg::StatisticDataType;
+
+namespace {
+//==============================================================================
+double get_data(
+  const statistics_msgs::msg::MetricsMessage& msg,
+  const uint8_t type)
+{
+  for (const auto& point : msg.statistics)
+  {
+    if (point.data_type == type)
+      return point.data;
+  }
+
+  FAIL("Missing statistic type " << static_cast<int>(type));
+  return 0.0;
+}
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("Metrics summarize each reporting interval")
+{
+  Metrics metrics("test");
+  metrics.add_statistic("size", "count", {1.0, 5.0, 10.0});
+  metrics.add_counter("events");
+
+  metrics.record("size", 2.0);
+  metrics.record("size", 4.0);
+  metrics.record("size", 12.0);
+  metrics.record("unknown", 1.0);
+  metrics.increment("events");
+  metrics.increment("events", 2);
+  metrics.increment("unknown");
+  CHECK(metrics.counter("events") == 3);
+  CHECK(metrics.counter("unknown") == 0);
+
+  auto messages = metrics.flush(rclcpp::Time(10, 0));
+  REQUIRE(messages.size() == 2);
+
+  const auto& size = messages[0];
+  CHECK(size.measurement_source_name == "test");
+  CHECK(size.metrics_source == "size");
+  CHECK(size.unit == "count");
+  CHECK(get_data(size, DataType::STATISTICS_DATA_TYPE_AVERAGE)
+    == Approx(6.0));
+  CHECK(get_data(size, DataType::STATISTICS_DATA_TYPE_MINIMUM)
+    == Approx(2.0));
+  CHECK(get_data(size, DataType::STATISTICS_DATA_TYPE_MAXIMUM)
+    == Approx(12.0));
+  CHECK(get_data(size, DataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT)
+    == Approx(3.0));
+  CHECK(get_data(size, DataType::STATISTICS_DATA_TYPE_STDDEV)
+    == Approx(std::sqrt(56.0 / 3.0)));
+
+  CHECK(messages[1].metrics_source == "events");
+
+  // Statistics with no new samples are not reported again, but counters are
+  messages = metrics.flush(rclcpp::Time(20, 0));
+  REQUIRE(messages.size() == 1);
+  CHECK(messages[0].metrics_source == "events");
+  CHECK(messages[0].window_start.sec == 10);
+  CHECK(messages[0].window_stop.sec == 20);
+
+  // The Prometheus histogram is cumulative across intervals
+  metrics.record("size", 0.5);
+  const auto text = metrics.prometheus();
+  CHECK(text.find("# TYPE test_size histogram") != std::string::npos);
+  CHECK(text.find("test_size_bucket{le=\"1\"} 1\n") != std::string::npos);
+  CHECK(text.find("test_size_bucket{le=\"5\"} 3\n") != std::string::npos);
+  CHECK(text.find("test_size_bucket{le=\"10\"} 3\n") != std::string::npos);
+  CHECK(text.find("test_size_bucket{le=\"+Inf\"} 4\n") != std::string::npos);
+  CHECK(text.find("test_size_count 4\n") != std::string::npos);
+  CHECK(text.find("test_events_total 3\n") != std::string::npos);
+
+  CHECK(metrics.cumulative_count("size") == 4);
+  CHECK(metrics.cumulative_sum("size") == Approx(18.5));
+  CHECK(metrics.cumulative_count("unknown") == 0);
+}
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <rmf_traffic/geometry/Circle.hpp>
+#include <rmf_traffic/schedule/Database.hpp>
+
+#include <rmf_traffic_ros2/Route.hpp>
+
+#include "../../src/rmf_traffic_ros2/schedule/internal_MonitorNode.hpp"
+#include "../../src/rmf_traffic_ros2/schedule/internal_Node.hpp"
+
+using namespace rmf_traffic_ros2::schedule;
+using namespace std::chrono_literals;
+
+namespace {
+//==============================================================================
+rmf_traffic::schedule::ParticipantDescription make_description()
+{
+  return rmf_traffic::schedule::ParticipantDescription{
+    "replayed",
+    "test_MonitorReplay",
+    rmf_traffic::schedule::ParticipantDescription::Rx::Responsive,
+    rmf_traffic::Profile{
+      rmf_traffic::geometry::make_final_convex<
+        rmf_traffic::geometry::Circle>(1.0)
+    }
+  };
+}
+
+//==============================================================================
+rmf_traffic_msgs::msg::Route make_route(
+  const rmf_traffic::Time start,
+  const double y)
+{
+  rmf_traffic::Trajectory trajectory;
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    trajectory.insert(
+      start + i*10s,
+      Eigen::Vector3d(static_cast<double>(i), y, 0.0),
+      Eigen::Vector3d::Zero());
+  }
+
+  return rmf_traffic_ros2::convert(
+    rmf_traffic::Route("test_map", std::move(trajectory)));
+}
+
+//==============================================================================
+// The changes that a participant sends out over the course of its plans, in
+// the order that the schedule node receives them.
+std::vector<ScheduleNode::ItineraryChange> make_changes(
+  const rmf_traffic::schedule::ParticipantId participant,
+  const rmf_traffic::Time start)
+{
+  std::vector<ScheduleNode::ItineraryChange> changes;
+
+  ScheduleNode::ItinerarySet set;
+  set.participant = participant;
+  set.plan = 1;
+  set.itinerary = {make_route(start, 0.0), make_route(start, 5.0)};
+  set.storage_base = 0;
+  set.itinerary_version = 1;
+  changes.emplace_back(set);
+
+  ScheduleNode::ItineraryDelay delay;
+  delay.participant = participant;
+  delay.delay = std::chrono::nanoseconds(2s).count();
+  delay.itinerary_version = 2;
+  changes.emplace_back(delay);
+
+  ScheduleNode::ItineraryReached reached;
+  reached.participant = participant;
+  reached.plan = 1;
+  reached.reached_checkpoints = {0, 0};
+  reached.progress_version = 1;
+  changes.emplace_back(reached);
+
+  ScheduleNode::ItineraryExtend extend;
+  extend.participant = participant;
+  extend.routes = {make_route(start + 60s, 10.0)};
+  extend.itinerary_version = 3;
+  changes.emplace_back(extend);
+
+  ScheduleNode::ItineraryClear clear;
+  clear.participant = participant;
+  clear.itinerary_version = 4;
+  changes.emplace_back(clear);
+
+  set.plan = 2;
+  set.itinerary = {make_route(start + 120s, -5.0)};
+  set.storage_base = 10;
+  set.itinerary_version = 5;
+  changes.emplace_back(set);
+
+  changes.emplace_back(delay);
+  std::get<ScheduleNode::ItineraryDelay>(changes.back()).itinerary_version = 6;
+
+  return changes;
+}
+
+//==============================================================================
+void check_same_itinerary(
+  const rmf_traffic::schedule::Database& expected,
+  const rmf_traffic::schedule::Database& actual,
+  const rmf_traffic::schedule::ParticipantId participant)
+{
+  CHECK(
+    actual.itinerary_version(participant)
+    == expected.itinerary_version(participant));
+  CHECK(
+    actual.get_current_progress_version(participant)
+    == expected.get_current_progress_version(participant));
+
+  const auto expected_itinerary = expected.get_itinerary(participant);
+  const auto actual_itinerary = actual.get_itinerary(participant);
+  REQUIRE(expected_itinerary.has_value());
+  REQUIRE(actual_itinerary.has_value());
+  REQUIRE(actual_itinerary->size() == expected_itinerary->size());
+
+  for (std::size_t i = 0; i < expected_itinerary->size(); ++i)
+  {
+    const auto& e = *(*expected_itinerary)[i];
+    const auto& a = *(*actual_itinerary)[i];
+    CHECK(a.map() == e.map());
+
+    REQUIRE(a.trajectory().size() == e.trajectory().size());
+    auto a_wp = a.trajectory().begin();
+    for (const auto& e_wp : e.trajectory())
+    {
+      CHECK(a_wp->time() == e_wp.time());
+      CHECK((a_wp->position() - e_wp.position()).norm() == 0.0);
+      ++a_wp;
+    }
+  }
+}
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("Monitor replays itinerary changes into a replacement node")
+{
+  auto context = std::make_shared<rclcpp::Context>();
+  context->init(0, nullptr);
+  const auto options = rclcpp::NodeOptions().context(context);
+
+  const auto start = std::chrono::steady_clock::now();
+
+  // The primary schedule node applies each change as soon as it arrives
+  auto primary_db = std::make_shared<rmf_traffic::schedule::Database>();
+  const auto participant =
+    primary_db->register_participant(make_description()).id();
+  const auto primary = std::make_shared<ScheduleNode>(
+    primary_db, options, ScheduleNode::NoAutomaticSetup{});
+
+  // The monitor buffers the same changes while it is on standby
+  const auto monitor = std::make_shared<MonitorNode>(
+    [](std::shared_ptr<rclcpp::Node>) {}, options,
+    MonitorNode::NoAutomaticSetup{});
+
+  const auto changes = make_changes(participant, start);
+  for (const auto& change : changes)
+  {
+    primary->apply_itinerary_changes({change});
+    monitor->buffer_itinerary_change(change);
+  }
+
+  REQUIRE(primary_db->get_itinerary(participant).has_value());
+  REQUIRE(!primary_db->get_itinerary(participant)->empty());
+
+  WHEN("The forked database has none of the changes")
+  {
+    // The participant was registered before any of its changes arrived
+    auto forked_db = std::make_shared<rmf_traffic::schedule::Database>();
+    REQUIRE(
+      forked_db->register_participant(make_description()).id()
+      == participant);
+
+    const auto replacement = std::make_shared<ScheduleNode>(
+      forked_db, options, ScheduleNode::NoAutomaticSetup{});
+    monitor->replay_itinerary_changes(*replacement);
+
+    THEN("The replacement matches the primary")
+    {
+      check_same_itinerary(*primary_db, *forked_db, participant);
+      CHECK(monitor->itinerary_replay_buffer.empty());
+    }
+  }
+
+  WHEN("The forked database already has some of the changes")
+  {
+    // The mirror saw the first few changes before the primary went down
+    auto forked_db = std::make_shared<rmf_traffic::schedule::Database>();
+    REQUIRE(
+      forked_db->register_participant(make_description()).id()
+      == participant);
+
+    const auto replacement = std::make_shared<ScheduleNode>(
+      forked_db, options, ScheduleNode::NoAutomaticSetup{});
+    replacement->apply_itinerary_changes(
+      std::vector<ScheduleNode::ItineraryChange>(
+        changes.begin(), changes.begin() + 3));
+
+    monitor->replay_itinerary_changes(*replacement);
+
+    THEN("Replaying the changes it already has makes no difference")
+    {
+      check_same_itinerary(*primary_db, *forked_db, participant);
+    }
+  }
+
+  context->shutdown("test finished");
+}
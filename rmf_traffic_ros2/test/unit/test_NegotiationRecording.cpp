@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include "../../src/rmf_traffic_ros2/schedule/internal_NegotiationRecording.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+using rmf_traffic_ros2::schedule::NegotiationRecorder;
+using rmf_traffic_ros2::schedule::read_negotiation_recording;
+
+SCENARIO("Negotiation recordings can be read back")
+{
+  const auto filename = (std::filesystem::temp_directory_path()
+    / "test_NegotiationRecording.rmfneg").string();
+
+  {
+    const auto recorder = NegotiationRecorder::make(filename);
+    REQUIRE(recorder);
+
+    NegotiationRecorder::Notice notice;
+    notice.conflict_version = 3;
+    notice.participants = {1, 4};
+    recorder->record(notice);
+
+    NegotiationRecorder::Proposal proposal;
+    proposal.conflict_version = 3;
+    proposal.for_participant = 4;
+    proposal.proposal_version = 2;
+    proposal.plan_id = 17;
+    recorder->record(proposal);
+
+    NegotiationRecorder::Forfeit forfeit;
+    forfeit.conflict_version = 3;
+    forfeit.table.resize(2);
+    forfeit.table[0].participant = 1;
+    forfeit.table[1].participant = 4;
+    forfeit.table[1].version = 5;
+    recorder->record(forfeit);
+  }
+
+  auto records = read_negotiation_recording(filename);
+  REQUIRE(records.size() == 3);
+
+  CHECK(records[0].kind == NegotiationRecorder::Kind::Notice);
+  CHECK(records[1].kind == NegotiationRecorder::Kind::Proposal);
+  CHECK(records[2].kind == NegotiationRecorder::Kind::Forfeit);
+  CHECK(records[0].time <= records[1].time);
+  CHECK(records[1].time <= records[2].time);
+
+  const auto notice = records[0].get<NegotiationRecorder::Notice>();
+  CHECK(notice.conflict_version == 3);
+  CHECK(notice.participants == std::vector<uint64_t>{1, 4});
+
+  const auto proposal = records[1].get<NegotiationRecorder::Proposal>();
+  CHECK(proposal.for_participant == 4);
+  CHECK(proposal.proposal_version == 2);
+  CHECK(proposal.plan_id == 17);
+
+  const auto forfeit = records[2].get<NegotiationRecorder::Forfeit>();
+  REQUIRE(forfeit.table.size() == 2);
+  CHECK(forfeit.table[1].participant == 4);
+  CHECK(forfeit.table[1].version == 5);
+
+  WHEN("The last record was cut short")
+  {
+    const auto size = std::filesystem::file_size(filename);
+    std::filesystem::resize_file(filename, size - 3);
+
+    records = read_negotiation_recording(filename);
+    CHECK(records.size() == 2);
+  }
+
+  WHEN("The file is not a recording")
+  {
+    std::ofstream(filename, std::ios::trunc) << "not a recording";
+    CHECK_THROWS(read_negotiation_recording(filename));
+  }
+
+  std::filesystem::remove(filename);
+}
@@ -21,6 +21,7 @@
 #include <rmf_utils/catch.hpp>
 #include <fstream>
 #include <cstdio>
+#include <optional>
 
 #include "../../src/rmf_traffic_ros2/schedule/internal_YamlSerialization.hpp"
 
@@ -178,6 +179,45 @@ SCENARIO("Participant registry restores participants from logger")
   }
 }
 
+SCENARIO("Participants are told apart by both name and owner")
+{
+  using Database = rmf_traffic::schedule::Database;
+  const auto shape = rmf_traffic::geometry::make_final_convex<
+    rmf_traffic::geometry::Circle>(1.0);
+
+  // The names and owners of these participants concatenate into the same
+  // string, but they are different participants.
+  rmf_traffic::schedule::ParticipantDescription p1(
+    "robot_1",
+    "fleet",
+    rmf_traffic::schedule::ParticipantDescription::Rx::Responsive,
+    rmf_traffic::Profile{shape});
+
+  rmf_traffic::schedule::ParticipantDescription p2(
+    "robot_",
+    "1fleet",
+    rmf_traffic::schedule::ParticipantDescription::Rx::Responsive,
+    rmf_traffic::Profile{shape});
+
+  std::vector<AtomicOperation> journal;
+  auto db1 = std::make_shared<Database>();
+  ParticipantRegistry registry1(
+    std::make_unique<TestOperationLogger>(&journal), db1);
+  const auto id1 = registry1.add_or_retrieve_participant(p1).id();
+  const auto id2 = registry1.add_or_retrieve_participant(p2).id();
+  CHECK(id1 != id2);
+  CHECK(registry1.add_or_retrieve_participant(p1).id() == id1);
+  CHECK(registry1.add_or_retrieve_participant(p2).id() == id2);
+  CHECK(journal.size() == 2);
+
+  auto db2 = std::make_shared<Database>();
+  ParticipantRegistry registry2(
+    std::make_unique<TestOperationLogger>(&journal), db2);
+  REQUIRE(db2->participant_ids().size() == 2);
+  CHECK(*db2->get_participant(id1) == p1);
+  CHECK(*db2->get_participant(id2) == p2);
+}
+
 SCENARIO("Test file logger")
 {
   if (std::filesystem::exists("test_yamllogger.yaml"))
@@ -287,4 +327,50 @@ SCENARIO("Test file logger")
       }
     }
   }
+
+  GIVEN("a participant whose description keeps changing")
+  {
+    using Database = rmf_traffic::schedule::Database;
+    const std::size_t num_updates = 500;
+    rmf_traffic::schedule::ParticipantId p1_id;
+    rmf_traffic::schedule::ParticipantId p2_id;
+    std::optional<rmf_traffic::schedule::ParticipantDescription> last;
+    {
+      auto logger = std::make_unique<YamlLogger>("test_yamllogger.yaml");
+      ParticipantRegistry registry(std::move(logger),
+        std::make_shared<Database>());
+      p1_id = registry.add_or_retrieve_participant(p1).id();
+      p2_id = registry.add_or_retrieve_participant(p2).id();
+
+      for (std::size_t i = 0; i < num_updates; ++i)
+      {
+        last = rmf_traffic::schedule::ParticipantDescription(
+          "participant 1",
+          "test_Participant",
+          rmf_traffic::schedule::ParticipantDescription::Rx::Responsive,
+          rmf_traffic::Profile{
+            rmf_traffic::geometry::make_final_convex<
+              rmf_traffic::geometry::Circle>(1.0 + 0.01 * (i + 1))});
+        registry.add_or_retrieve_participant(*last);
+      }
+    }
+
+    THEN("the journal gets compacted")
+    {
+      const auto file = YAML::LoadFile("test_yamllogger.yaml");
+      REQUIRE(file.IsSequence());
+      CHECK(file.size() < num_updates);
+    }
+
+    THEN("the latest descriptions are restored")
+    {
+      auto db = std::make_shared<Database>();
+      ParticipantRegistry registry(
+        std::make_unique<YamlLogger>("test_yamllogger.yaml"), db);
+
+      REQUIRE(db->participant_ids().size() == 2);
+      CHECK(*db->get_participant(p1_id) == *last);
+      CHECK(*db->get_participant(p2_id) == p2);
+    }
+  }
 }
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <rmf_traffic/geometry/Circle.hpp>
+
+#include "../../src/rmf_traffic_ros2/schedule/internal_RouteBounds.hpp"
+
+using namespace rmf_traffic_ros2::schedule;
+using namespace std::chrono_literals;
+
+namespace {
+rmf_traffic::Trajectory make_straight_line(
+  const rmf_traffic::Time start,
+  const Eigen::Vector2d p0,
+  const Eigen::Vector2d p1)
+{
+  const Eigen::Vector3d zero = Eigen::Vector3d::Zero();
+  rmf_traffic::Trajectory trajectory;
+  trajectory.insert(start, Eigen::Vector3d(p0[0], p0[1], 0.0), zero);
+  trajectory.insert(start + 10s, Eigen::Vector3d(p1[0], p1[1], 0.0), zero);
+  return trajectory;
+}
+} // anonymous namespace
+
+SCENARIO("Route bounds filter out distant trajectories")
+{
+  const auto now = std::chrono::steady_clock::now();
+  const auto a = RouteBounds::make(
+    make_straight_line(now, {0.0, 0.0}, {10.0, 0.0}));
+  REQUIRE(a.has_value());
+  CHECK(a->min_x == Approx(0.0));
+  CHECK(a->max_x == Approx(10.0));
+
+  WHEN("The trajectories are far apart")
+  {
+    const auto b = RouteBounds::make(
+      make_straight_line(now, {0.0, 20.0}, {10.0, 20.0}));
+    REQUIRE(b.has_value());
+    CHECK_FALSE(a->may_overlap(1.0, *b, 1.0));
+  }
+
+  WHEN("The trajectories are within each other's radius")
+  {
+    const auto b = RouteBounds::make(
+      make_straight_line(now, {0.0, 1.5}, {10.0, 1.5}));
+    REQUIRE(b.has_value());
+    CHECK(a->may_overlap(1.0, *b, 1.0));
+    CHECK_FALSE(a->may_overlap(0.5, *b, 0.5));
+  }
+
+  WHEN("The trajectories overlap in space but not in time")
+  {
+    const auto b = RouteBounds::make(
+      make_straight_line(now + 1min, {0.0, 0.0}, {10.0, 0.0}));
+    REQUIRE(b.has_value());
+    CHECK_FALSE(a->may_overlap(1.0, *b, 1.0));
+  }
+
+  WHEN("The trajectory is empty")
+  {
+    CHECK_FALSE(RouteBounds::make(rmf_traffic::Trajectory()).has_value());
+  }
+}
+
+SCENARIO("Route bounds account for curved segments")
+{
+  const auto now = std::chrono::steady_clock::now();
+  rmf_traffic::Trajectory trajectory;
+  // The velocities at both ends push the spline above the line between them
+  trajectory.insert(now, {0.0, 0.0, 0.0}, {1.0, 3.0, 0.0});
+  trajectory.insert(now + 3s, {3.0, 0.0, 0.0}, {1.0, -3.0, 0.0});
+
+  const auto bounds = RouteBounds::make(trajectory);
+  REQUIRE(bounds.has_value());
+  // The midpoint of a cubic Hermite segment is (p0 + p1)/2 + (v0 - v1)*dt/8
+  const double midpoint_y = (3.0 - (-3.0)) * 3.0 / 8.0;
+  CHECK(bounds->max_y >= midpoint_y);
+  CHECK(bounds->min_y == Approx(0.0));
+}
+
+SCENARIO("Route bounds cache is pruned once routes are released")
+{
+  const auto now = std::chrono::steady_clock::now();
+  auto route = std::make_shared<rmf_traffic::Route>(
+    "test_map", make_straight_line(now, {0.0, 0.0}, {1.0, 1.0}));
+
+  RouteBoundsCache cache;
+  const auto& bounds = cache.insert(route);
+  CHECK(bounds.has_value());
+  CHECK(cache.find(route.get()) != nullptr);
+  CHECK(cache.size() == 1);
+
+  cache.prune();
+  CHECK(cache.size() == 1);
+
+  route.reset();
+  cache.prune();
+  CHECK(cache.size() == 0);
+
+  const auto shape = rmf_traffic::geometry::make_final_convex<
+    rmf_traffic::geometry::Circle>(0.5);
+  CHECK(profile_radius(rmf_traffic::Profile{shape}) == Approx(0.5));
+}
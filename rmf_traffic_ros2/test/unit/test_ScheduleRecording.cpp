@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include "../../src/rmf_traffic_ros2/schedule/internal_ScheduleRecording.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+using rmf_traffic_ros2::schedule::ScheduleRecorder;
+using rmf_traffic_ros2::schedule::read_schedule_recording;
+
+// The file format itself is covered by test_NegotiationRecording. This only
+// checks what is specific to schedule recordings.
+SCENARIO("Schedule recordings can be read back")
+{
+  const auto filename = (std::filesystem::temp_directory_path()
+    / "test_ScheduleRecording.rmfsch").string();
+
+  {
+    const auto recorder = ScheduleRecorder::make(filename);
+    REQUIRE(recorder);
+
+    ScheduleRecorder::Participant participant;
+    participant.id = 4;
+    participant.description.name = "robot";
+    recorder->record_registration(participant);
+
+    ScheduleRecorder::Set set;
+    set.participant = 4;
+    recorder->record(set);
+
+    ScheduleRecorder::Delay delay;
+    delay.participant = 4;
+    recorder->record(delay);
+
+    recorder->record_unregistration(participant);
+
+    // Nothing gets written until the records are flushed
+    const auto header_size = ScheduleRecorder::magic.size();
+    CHECK(std::filesystem::file_size(filename) == header_size);
+    recorder->flush();
+    CHECK(std::filesystem::file_size(filename) > header_size);
+
+    ScheduleRecorder::Clear clear;
+    clear.participant = 4;
+    recorder->record(clear);
+  }
+
+  // The last record gets written when the recorder is destroyed
+  const auto records = read_schedule_recording(filename);
+  REQUIRE(records.size() == 5);
+
+  // Registrations and unregistrations carry the same message, so only their
+  // kinds tell them apart
+  CHECK(records[0].kind == ScheduleRecorder::Kind::Register);
+  CHECK(records[1].kind == ScheduleRecorder::Kind::Set);
+  CHECK(records[2].kind == ScheduleRecorder::Kind::Delay);
+  CHECK(records[3].kind == ScheduleRecorder::Kind::Unregister);
+  CHECK(records[4].kind == ScheduleRecorder::Kind::Clear);
+
+  const auto registered = records[0].get<ScheduleRecorder::Participant>();
+  CHECK(registered.id == 4);
+  CHECK(registered.description.name == "robot");
+
+  WHEN("The file is a negotiation recording")
+  {
+    std::ofstream(filename, std::ios::trunc) << "RMFNEG01";
+    CHECK_THROWS(read_schedule_recording(filename));
+  }
+
+  std::filesystem::remove(filename);
+}
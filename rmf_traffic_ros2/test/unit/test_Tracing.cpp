@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <rmf_traffic_ros2/Tracing.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace tracing = rmf_traffic_ros2::tracing;
+
+//==============================================================================
+SCENARIO("Trace events are written in the Chrome trace format")
+{
+  const auto filename =
+    (std::filesystem::temp_directory_path() / "test_rmf_tracing.json").string();
+
+  tracing::disable();
+  CHECK_FALSE(tracing::enabled());
+  auto skipped = tracing::Span::begin("skipped", "task_0");
+  CHECK_FALSE(skipped.active());
+
+  REQUIRE(tracing::enable(filename));
+  CHECK(tracing::enabled());
+
+  auto span = tracing::Span::begin("plan", "task_1");
+  CHECK(span.active());
+  span.arg("robot", "robot_1");
+
+  // Moving a span hands over its event instead of ending it early
+  auto moved = std::move(span);
+  CHECK_FALSE(span.active());
+  CHECK(moved.active());
+
+  tracing::instant("award", "task_1");
+  moved.end();
+  CHECK_FALSE(moved.active());
+
+  {
+    const auto scoped = tracing::Span::begin("scoped", "task_2");
+  }
+
+  skipped.end();
+  tracing::disable();
+  CHECK_FALSE(tracing::enabled());
+
+  std::ifstream file(filename);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  const auto events = nlohmann::json::parse(contents.str());
+  REQUIRE(events.is_array());
+
+  std::vector<nlohmann::json> written;
+  for (const auto& event : events)
+  {
+    if (!event.empty())
+      written.push_back(event);
+  }
+
+  REQUIRE(written.size() == 3);
+  CHECK(written[0]["name"] == "award");
+  CHECK(written[0]["ph"] == "i");
+  CHECK(written[0]["args"]["trace"] == "task_1");
+
+  CHECK(written[1]["name"] == "plan");
+  CHECK(written[1]["ph"] == "X");
+  CHECK(written[1]["args"]["robot"] == "robot_1");
+  CHECK(written[1]["dur"].get<int64_t>() >= 0);
+  CHECK(written[1]["ts"].get<int64_t>() <= written[0]["ts"].get<int64_t>());
+
+  CHECK(written[2]["name"] == "scoped");
+  CHECK(written[2]["args"]["trace"] == "task_2");
+
+  std::filesystem::remove(filename);
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include "../../src/rmf_traffic_ros2/schedule/internal_WorkerPool.hpp"
+
+#include <chrono>
+#include <future>
+
+using rmf_traffic_ros2::schedule::WorkerPool;
+
+SCENARIO("Jobs with the same key run in the order they were posted")
+{
+  const std::size_t num_keys = 5;
+  const std::size_t jobs_per_key = 200;
+
+  std::mutex mutex;
+  std::vector<std::vector<std::size_t>> results(num_keys);
+  std::promise<void> finished;
+  std::size_t remaining = num_keys * jobs_per_key;
+
+  {
+    WorkerPool pool(3);
+    CHECK(pool.size() == 3);
+
+    for (std::size_t i = 0; i < jobs_per_key; ++i)
+    {
+      for (std::size_t k = 0; k < num_keys; ++k)
+      {
+        pool.post(
+          k, [&, k, i]()
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            results[k].push_back(i);
+            if (--remaining == 0)
+              finished.set_value();
+          });
+      }
+    }
+
+    const auto status =
+      finished.get_future().wait_for(std::chrono::seconds(10));
+    REQUIRE(status == std::future_status::ready);
+  }
+
+  for (const auto& r : results)
+  {
+    REQUIRE(r.size() == jobs_per_key);
+    for (std::size_t i = 0; i < jobs_per_key; ++i)
+      CHECK(r[i] == i);
+  }
+}
+
+SCENARIO("A worker pool always has at least one thread")
+{
+  WorkerPool pool(0);
+  CHECK(pool.size() == 1);
+
+  std::promise<void> ran;
+  pool.post(42, [&]() { ran.set_value(); });
+  CHECK(ran.get_future().wait_for(std::chrono::seconds(10))
+    == std::future_status::ready);
+}
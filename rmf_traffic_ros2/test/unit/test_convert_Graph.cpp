@@ -15,8 +15,11 @@
  *
 */
 
+#include <cstring>
 #include <fstream>
 
+#include <zlib.h>
+
 #include <rmf_utils/catch.hpp>
 
 #include <rmf_traffic_ros2/agv/Graph.hpp>
@@ -37,8 +40,50 @@ static auto make_map_message(const std::string& map_path)
   return msg;
 }
 
+static auto make_compressed_map_message(const std::string& map_path)
+{
+  auto msg = make_map_message(map_path);
+  z_stream strm;
+  memset(&strm, 0, sizeof(strm));
+  deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+    Z_DEFAULT_STRATEGY);
+
+  std::vector<uint8_t> compressed(deflateBound(&strm, msg.data.size()));
+  strm.next_in = msg.data.data();
+  strm.avail_in = msg.data.size();
+  strm.next_out = compressed.data();
+  strm.avail_out = compressed.size();
+  deflate(&strm, Z_FINISH);
+  compressed.resize(strm.total_out);
+  deflateEnd(&strm);
+
+  msg.encoding = msg.MAP_DATA_GEOJSON_GZ;
+  msg.data = std::move(compressed);
+  return msg;
+}
+
 SCENARIO("Test conversion from rmf_building_map_msgs to rmf_traffic")
 {
+  GIVEN("A compressed sample map from an office demo world")
+  {
+    const auto msg = make_compressed_map_message(MAP_PATH);
+    auto graph = rmf_traffic_ros2::convert(msg, 0);
+    THEN("Map has the same graph as the uncompressed map")
+    {
+      CHECK(graph.num_waypoints() == 68);
+      CHECK(graph.keys().size() == 7);
+      CHECK(graph.num_lanes() == 64);
+    }
+
+    THEN("A truncated map gives an empty graph")
+    {
+      auto truncated = msg;
+      truncated.data.resize(truncated.data.size() / 2);
+      const auto empty = rmf_traffic_ros2::convert(truncated, 0);
+      CHECK(empty.num_waypoints() == 0);
+    }
+  }
+
   GIVEN("A sample map from an office demo world")
   {
     auto graph = rmf_traffic_ros2::convert(make_map_message(MAP_PATH), 0);
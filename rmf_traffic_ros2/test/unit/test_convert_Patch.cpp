@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+
+#include <rmf_traffic_ros2/schedule/Patch.hpp>
+
+using Change = rmf_traffic::schedule::Change;
+
+namespace {
+//==============================================================================
+rmf_traffic::schedule::Patch make_patch()
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  std::vector<rmf_traffic::schedule::Patch::Participant> parts;
+  for (std::size_t p = 0; p < 3; ++p)
+  {
+    rmf_traffic::Trajectory trajectory;
+    for (std::size_t w = 0; w < 5; ++w)
+    {
+      trajectory.insert(
+        start + std::chrono::seconds(w),
+        Eigen::Vector3d(static_cast<double>(w), static_cast<double>(p), 0.0),
+        Eigen::Vector3d::Zero());
+    }
+
+    auto route = std::make_shared<rmf_traffic::Route>(
+      "L" + std::to_string(p), std::move(trajectory));
+    route->checkpoints({1, 3});
+
+    parts.emplace_back(
+      p, p + 10,
+      Change::Erase{{p, p + 1}},
+      std::vector<Change::Delay>{Change::Delay{std::chrono::seconds(p)}},
+      Change::Add{p, {{7, 8, std::move(route)}}},
+      Change::Progress(p, {0, 1}));
+  }
+
+  return rmf_traffic::schedule::Patch{
+    std::move(parts), std::nullopt, 3, 4};
+}
+
+//==============================================================================
+void check_same(
+  const rmf_traffic::schedule::Patch& a,
+  const rmf_traffic::schedule::Patch& b)
+{
+  CHECK(a.base_version() == b.base_version());
+  CHECK(a.latest_version() == b.latest_version());
+  REQUIRE(a.size() == b.size());
+
+  auto b_it = b.begin();
+  for (const auto& pa : a)
+  {
+    const auto& pb = *b_it++;
+    CHECK(pa.participant_id() == pb.participant_id());
+    CHECK(pa.itinerary_version() == pb.itinerary_version());
+    CHECK(pa.erasures().ids() == pb.erasures().ids());
+    REQUIRE(pa.delays().size() == pb.delays().size());
+    for (std::size_t i = 0; i < pa.delays().size(); ++i)
+      CHECK(pa.delays()[i].duration() == pb.delays()[i].duration());
+
+    REQUIRE(pa.additions().items().size() == pb.additions().items().size());
+    for (std::size_t i = 0; i < pa.additions().items().size(); ++i)
+    {
+      const auto& ra = *pa.additions().items()[i].route;
+      const auto& rb = *pb.additions().items()[i].route;
+      CHECK(ra.map() == rb.map());
+      CHECK(ra.checkpoints() == rb.checkpoints());
+      REQUIRE(ra.trajectory().size() == rb.trajectory().size());
+      auto wb = rb.trajectory().begin();
+      for (const auto& wa : ra.trajectory())
+      {
+        CHECK(wa.time() == wb->time());
+        CHECK((wa.position() - wb->position()).norm() == Approx(0.0));
+        ++wb;
+      }
+    }
+
+    REQUIRE(pa.progress().has_value() == pb.progress().has_value());
+    if (pa.progress().has_value())
+      CHECK(pa.progress()->checkpoints() == pb.progress()->checkpoints());
+  }
+}
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("Converting a patch by copying and by moving")
+{
+  const auto patch = make_patch();
+  const auto msg = rmf_traffic_ros2::convert(patch);
+  CHECK(msg.participants.size() == patch.size());
+
+  const auto copied = rmf_traffic_ros2::convert(msg);
+  check_same(patch, copied);
+
+  auto consumed = msg;
+  const auto moved = rmf_traffic_ros2::convert(std::move(consumed));
+  check_same(patch, moved);
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Measures how many messages per second a BroadcastServer can take in from
+// many clients at once. Each client sends a fixed number of task log updates
+// as fast as the connection allows.
+//
+// Usage:
+//   broadcast_server_benchmark [clients] [messages_per_client] [threads] [raw]
+//
+// The defaults are 50 clients, 2000 messages each, and 4 server threads. Give
+// "raw" as the last argument to use a raw string callback instead of having
+// the server parse each message.
+
+#include <rmf_websocket/BroadcastServer.hpp>
+
+#include <websocketpp/config/asio_no_tls_client.hpp>
+#include <websocketpp/client.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using WsClient = websocketpp::client<websocketpp::config::asio_client>;
+
+namespace {
+
+constexpr int Port = 9123;
+
+//==============================================================================
+std::string make_message(std::size_t client, std::size_t index)
+{
+  nlohmann::json entry;
+  entry["seq"] = index;
+  entry["tier"] = "info";
+  entry["unix_millis_time"] = 0;
+  entry["text"] = "Benchmark log entry from client " + std::to_string(client);
+
+  nlohmann::json msg;
+  msg["type"] = "task_log_update";
+  msg["data"]["task_id"] = "benchmark_task_" + std::to_string(client);
+  msg["data"]["phases"]["1"]["events"]["0"] = nlohmann::json::array({entry});
+  return msg.dump();
+}
+
+//==============================================================================
+std::size_t read_arg(int argc, char* argv[], int i, std::size_t fallback)
+{
+  if (argc <= i)
+    return fallback;
+
+  const long value = std::strtol(argv[i], nullptr, 10);
+  return value > 0 ? static_cast<std::size_t>(value) : fallback;
+}
+
+} // anonymous namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  const std::size_t num_clients = read_arg(argc, argv, 1, 50);
+  const std::size_t per_client = read_arg(argc, argv, 2, 2000);
+  const std::size_t num_threads = read_arg(argc, argv, 3, 4);
+  const bool raw = argc > 4 && std::string(argv[4]) == "raw";
+  const std::size_t total = num_clients * per_client;
+
+  std::atomic_size_t received{0};
+  std::shared_ptr<rmf_websocket::BroadcastServer> server;
+  if (raw)
+  {
+    server = rmf_websocket::BroadcastServer::make_raw(
+      Port, [&received](const std::string&) { ++received; });
+  }
+  else
+  {
+    server = rmf_websocket::BroadcastServer::make(
+      Port, [&received](const nlohmann::json&) { ++received; });
+  }
+
+  server->set_num_threads(num_threads);
+  server->start();
+
+  // The clients get their own threads so they are not what limits the rate
+  WsClient client;
+  client.clear_access_channels(websocketpp::log::alevel::all);
+  client.clear_error_channels(websocketpp::log::elevel::all);
+  client.init_asio();
+  client.start_perpetual();
+
+  std::vector<std::vector<std::string>> messages(num_clients);
+  for (std::size_t c = 0; c < num_clients; ++c)
+  {
+    for (std::size_t i = 0; i < per_client; ++i)
+      messages[c].push_back(make_message(c, i));
+  }
+
+  std::atomic_size_t opened{0};
+  std::vector<WsClient::connection_ptr> connections;
+  for (std::size_t c = 0; c < num_clients; ++c)
+  {
+    websocketpp::lib::error_code ec;
+    auto con = client.get_connection(
+      "ws://127.0.0.1:" + std::to_string(Port) + "/", ec);
+    if (ec)
+    {
+      std::cerr << "Failed to create a connection: " << ec.message()
+                << std::endl;
+      return 1;
+    }
+
+    con->set_open_handler([&opened](websocketpp::connection_hdl)
+      {
+        ++opened;
+      });
+    client.connect(con);
+    connections.push_back(con);
+  }
+
+  std::vector<std::thread> client_threads;
+  for (std::size_t i = 0; i < num_threads; ++i)
+    client_threads.emplace_back([&client]() { client.run(); });
+
+  while (opened < num_clients)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  std::cout << num_clients << " clients connected. Sending " << total
+            << " messages to a server with " << num_threads << " thread(s)"
+            << (raw ? " and a raw callback" : "") << std::endl;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t c = 0; c < num_clients; ++c)
+  {
+    client.get_io_service().post([&client, &messages, con = connections[c], c]()
+      {
+        for (const auto& msg : messages[c])
+        {
+          websocketpp::lib::error_code ec;
+          client.send(
+            con->get_handle(), msg, websocketpp::frame::opcode::text, ec);
+        }
+      });
+  }
+
+  const auto timeout = std::chrono::seconds(60);
+  while (received < total
+    && std::chrono::steady_clock::now() - start < timeout)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+
+  std::cout << "Received " << received << " of " << total << " messages in "
+            << seconds << " s (" << static_cast<double>(received) / seconds
+            << " messages/s)" << std::endl;
+
+  for (const auto& con : connections)
+  {
+    websocketpp::lib::error_code ec;
+    client.close(
+      con->get_handle(), websocketpp::close::status::normal, "", ec);
+  }
+  client.stop_perpetual();
+  client.stop();
+  for (auto& t : client_threads)
+    t.join();
+
+  server->stop();
+  return received == total ? 0 : 1;
+}
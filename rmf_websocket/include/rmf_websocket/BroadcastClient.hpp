@@ -22,10 +22,21 @@
 
 #include <rclcpp/node.hpp>
 #include <rmf_utils/impl_ptr.hpp>
+#include <rmf_websocket/Encoding.hpp>
 
+#include <chrono>
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace rmf_websocket {
+
+/// The topic that BroadcastClient publishes statistics_msgs/MetricsMessage
+/// on once BroadcastClient::set_diagnostics_period() has been given a period
+const std::string BroadcastClientDiagnosticsTopicName =
+  "broadcast_client_diagnostics";
+
 //==============================================================================
 // A wrapper around a websocket client for broadcasting states and logs for
 // fleets, robots and tasks. A queue of json msgs is maintained and published
@@ -34,6 +45,63 @@ class BroadcastClient : public std::enable_shared_from_this<BroadcastClient>
 {
 public:
   using ProvideJsonUpdates = std::function<std::vector<nlohmann::json>()>;
+  using ProvideJsonUpdatesSince =
+    std::function<std::vector<nlohmann::json>(const nlohmann::json&)>;
+  using SaturationCallback = std::function<void(bool saturated)>;
+
+  /// Statistics about the messages that a client has been sending. These
+  /// are totals since the client was made, unless stated otherwise.
+  struct Statistics
+  {
+    /// Number of messages that are currently waiting to be sent
+    std::size_t queue_depth = 0;
+
+    /// The most messages that have been waiting to be sent at once
+    std::size_t max_queue_depth = 0;
+
+    /// Number of messages that have been given to publish(). The ones that
+    /// were neither sent, dropped, nor still waiting were replaced by newer
+    /// state updates.
+    std::size_t messages_published = 0;
+
+    /// Number of published messages that have been sent
+    std::size_t messages_sent = 0;
+
+    /// Number of websocket frames that have been sent, including batches and
+    /// the messages sent when a connection opens
+    std::size_t frames_sent = 0;
+
+    /// Total size of the frames that have been sent
+    std::size_t bytes_sent = 0;
+
+    /// Number of messages that were pushed out of a full queue
+    std::size_t messages_dropped = 0;
+
+    /// Upper bounds, in seconds, of the buckets of send_latency_counts
+    std::vector<double> send_latency_buckets;
+
+    /// Number of sent messages whose time from publish() until being sent
+    /// fell in each bucket, plus one more bucket for anything slower
+    std::vector<std::size_t> send_latency_counts;
+
+    /// The longest time that a sent message waited
+    std::chrono::steady_clock::duration max_send_latency =
+      std::chrono::steady_clock::duration(0);
+
+    /// The sum of the waiting times of all sent messages
+    std::chrono::steady_clock::duration total_send_latency =
+      std::chrono::steady_clock::duration(0);
+
+    /// Number of times a connection to the server was attempted
+    std::size_t connection_attempts = 0;
+
+    /// Number of times an open connection to the server was lost
+    std::size_t connections_lost = 0;
+
+    /// Total time spent reconnecting after losing a connection
+    std::chrono::steady_clock::duration time_disconnected =
+      std::chrono::steady_clock::duration(0);
+  };
 
   /// \param[in] uri
   ///   "ws://localhost:9000"
@@ -43,10 +111,19 @@ public:
   /// \param[in] on_open_connection_fn
   ///   Provided function callback will be called whenever the ws client
   ///   is connected to the server
+  ///
+  /// \param[in] encoding
+  ///   The encoding to ask the server for, including for batches and resync
+  ///   requests. It is negotiated through the websocket subprotocol whenever
+  ///   a connection is opened. If the server does not accept it, like servers
+  ///   that only know JSON, that connection falls back to JSON. Binary
+  ///   encodings make the messages smaller and quicker to encode and decode.
+  ///   BroadcastServer accepts all of them.
   static std::shared_ptr<BroadcastClient> make(
     const std::string& uri,
     const std::shared_ptr<rclcpp::Node>& node,
-    ProvideJsonUpdates on_open_connection_fn = nullptr);
+    ProvideJsonUpdates on_open_connection_fn = nullptr,
+    Encoding encoding = Encoding::Json);
 
   // Publish a single message
   void publish(const nlohmann::json& msg);
@@ -57,6 +134,65 @@ public:
   /// Set a limit for how big the queue is allowed to get. Default is 1000.
   void set_queue_limit(std::optional<std::size_t> limit);
 
+  /// Turn on or off conflation of state updates while they wait in the queue.
+  /// When it is on, a fleet_state_update or task_state_update replaces any
+  /// update for the same fleet or task that has not been sent yet, so an
+  /// outage does not fill the queue with stale states and push out log
+  /// messages. All other messages are always kept. This is on by default.
+  void set_conflation(bool enabled);
+
+  /// Send up to this many queued messages together in a single websocket
+  /// frame, as {"type": "batch", "data": [...]}. This cuts down the per-frame
+  /// overhead when many updates are waiting, e.g. after reconnecting. Only
+  /// turn this on if the server is able to unpack batches, like
+  /// BroadcastServer does. A single waiting message is always sent as it is.
+  /// By default there is no batching.
+  void set_batch_limit(std::optional<std::size_t> limit);
+
+  /// Turn on or off a second connection to the server that carries
+  /// fleet_log_update and task_log_update messages with its own queue. State
+  /// updates then keep flowing over the first connection even while a burst
+  /// of logs is waiting to be sent. The queue limit applies to each
+  /// connection separately. This is off by default.
+  void set_bulk_channel(bool enabled);
+
+  /// Bring a newly connected server up to date incrementally instead of
+  /// resending everything. When this is set, it is used in place of
+  /// on_open_connection_fn. After connecting, the client sends
+  /// {"type": "resync_request"}, and the server is expected to answer with
+  /// {"type": "resync", "data": {...}} describing what it has already
+  /// received, like BroadcastServer does. The data is given to the callback,
+  /// which should return only the messages that the server is missing.
+  /// Queued updates keep being sent while waiting for the answer. If the
+  /// server does not answer within a second, the callback is given an empty
+  /// object. Only set this if the server understands resync requests.
+  void set_resync_callback(ProvideJsonUpdatesSince cb);
+
+  /// Get the number of messages that are waiting to be sent.
+  std::size_t queue_size() const;
+
+  /// True while the server is not keeping up with the messages being
+  /// published. This turns on when a queue reaches its limit, after which new
+  /// messages push out old ones, and turns off once every queue has drained
+  /// to half of its limit. Producers can check this to skip building messages
+  /// that would only be dropped.
+  bool saturated() const;
+
+  /// Get the statistics of this client. This may be called from any thread.
+  Statistics statistics() const;
+
+  /// Publish the statistics as statistics_msgs/MetricsMessage on the
+  /// BroadcastClientDiagnosticsTopicName topic of the node with this period.
+  /// The queue depth and send latency are summarized over each period, and
+  /// the counters are given as totals. Give std::nullopt to stop publishing.
+  /// Nothing is published by default.
+  void set_diagnostics_period(std::optional<std::chrono::nanoseconds> period);
+
+  /// Set a callback that is triggered whenever saturated() changes. It will
+  /// be called on the internal thread of the client, so it should return
+  /// quickly.
+  void set_saturation_callback(SaturationCallback cb);
+
   class Implementation;
 
 private:
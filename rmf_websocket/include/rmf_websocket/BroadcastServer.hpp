@@ -31,7 +31,16 @@ namespace rmf_websocket {
 /// This BroadcastServer is a wrapper of a websocket server. User need to
 /// specify the api_msg_type, and provide a callback function. The provided
 /// callback will be called when the specified msg_type is received. Note that
-/// this will spawn a seperate thread to host the web socket server
+/// this will spawn a seperate thread to host the web socket server.
+///
+/// The server remembers the last log entry it received for each event of each
+/// task, and gives that to any BroadcastClient that sends a resync request, so
+/// that a reconnecting client only needs to resend the entries that are
+/// missing.
+///
+/// Each connection is JSON unless its client asks for one of the binary
+/// encodings of rmf_websocket::Encoding, which the server accepts, except for
+/// servers made with make_raw().
 class BroadcastServer
 {
 public:
@@ -44,6 +53,7 @@ public:
   };
 
   using ApiMessageCallback = std::function<void(const nlohmann::json&)>;
+  using RawMessageCallback = std::function<void(const std::string&)>;
 
   /// Create a wrapper around a websocket server for receiving states and logs for
   /// fleets, robots and tasks
@@ -85,6 +95,42 @@ public:
       node_logging_interface,
     std::optional<ApiMsgType> msg_selection = std::nullopt);
 
+  /// Create a wrapper around a websocket server that hands over each message
+  /// exactly as it was received, without parsing it. This is for callers
+  /// that parse the messages themselves, so they are not parsed twice.
+  /// Batches are not unpacked and the message type is not checked. Resync
+  /// requests are still answered, but without any record of what was
+  /// received, so reconnecting clients send everything.
+  ///
+  /// \param[in] port
+  ///   server url port number
+  ///
+  /// \param[in] callback
+  ///   callback function when the message is received
+  ///
+  /// \param[in] node_logging_interface
+  ///   node interface for logging. Default as nullptr which will result
+  ///   in errors and additional debug information not being logged
+  ///
+  static std::shared_ptr<BroadcastServer> make_raw(
+    const int port,
+    RawMessageCallback callback,
+    const rclcpp::node_interfaces::NodeLoggingInterface::SharedPtr
+    node_logging_interface = nullptr);
+
+  /// Set how many threads serve the connections. This needs to be set before
+  /// start() is called. With more than one thread, the callback may be called
+  /// for different connections at the same time, but the messages of each
+  /// connection are still handled one at a time and in order. Default is 1.
+  void set_num_threads(std::size_t num_threads);
+
+  /// Limit how many messages each connection may send per second. When a
+  /// connection goes over the limit, the server stops reading from it for the
+  /// rest of that second, so that client is slowed down through its socket
+  /// instead of crowding out the other connections. There is no limit by
+  /// default.
+  void set_connection_rate_limit(std::optional<std::size_t> messages_per_sec);
+
   /// Start Server
   void start();
 
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef RMF_WEBSOCKET__ENCODING_HPP
+#define RMF_WEBSOCKET__ENCODING_HPP
+
+namespace rmf_websocket {
+
+//==============================================================================
+/// How the messages of a websocket connection are serialized. A client asks
+/// for a binary encoding through the websocket subprotocol of the connection,
+/// and the connection uses JSON text unless the server accepts it.
+enum class Encoding
+{
+  /// JSON text frames. Every server understands these.
+  Json,
+
+  /// CBOR binary frames, negotiated as the "rmf.cbor" subprotocol
+  Cbor,
+
+  /// MessagePack binary frames, negotiated as the "rmf.msgpack" subprotocol
+  MessagePack
+};
+
+} // namespace rmf_websocket
+
+#endif // RMF_WEBSOCKET__ENCODING_HPP
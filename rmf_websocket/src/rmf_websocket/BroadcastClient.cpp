@@ -16,15 +16,23 @@
 */
 
 #include <atomic>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
 #include <exception>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <rmf_websocket/BroadcastClient.hpp>
 #include <thread>
+#include <statistics_msgs/msg/metrics_message.hpp>
 #include <websocketpp/config/asio_no_tls_client.hpp>
 #include <websocketpp/client.hpp>
 
-#include "utils/RingBuffer.hpp"
+#include "utils/ClientMetrics.hpp"
+#include "utils/Codec.hpp"
+#include "utils/ConflatingQueue.hpp"
+#include "utils/MpscRingBuffer.hpp"
 #include "client/ClientWebSocketEndpoint.hpp"
 #include <vector>
 
@@ -34,20 +42,81 @@ namespace rmf_websocket {
 class BroadcastClient::Implementation
 {
 public:
+  using Clock = std::chrono::steady_clock;
+  using MetricsMsg = statistics_msgs::msg::MetricsMessage;
+
+  /// A serialized message and when it was published
+  struct Message
+  {
+    std::shared_ptr<const std::string> text;
+    Encoding encoding;
+    Clock::time_point published;
+  };
+
+  using Queue = ConflatingQueue<Message>;
+
+  /// A connection to the server with its own queue. Both channels run on the
+  /// same io service.
+  struct Channel
+  {
+    Channel(
+      const std::string& uri,
+      const std::shared_ptr<rclcpp::Node>& node,
+      boost::asio::io_service* io_service,
+      ClientWebSocketEndpoint::ConnectionCallback cb)
+    : queue(1000),
+      intake(1024),
+      endpoint(uri, node, io_service, std::move(cb)),
+      resync_timer(*io_service)
+    {
+      // Do nothing
+    }
+
+    Queue queue;
+    // Publishers push into this from any thread. Only the io service pops it.
+    MpscRingBuffer<Queue::Item> intake;
+    ClientWebSocketEndpoint endpoint;
+    bool connect_requested = false;
+    bool awaiting_resync = false;
+    boost::asio::steady_timer resync_timer;
+    // What the server agreed to for the current connection
+    Encoding encoding = Encoding::Json;
+  };
+
+  /// How long to wait for the server to answer a resync request before
+  /// sending everything
+  static constexpr auto ResyncTimeout = std::chrono::seconds(1);
+
+  /// How long a publisher waits for room in the intake before dropping its
+  /// message
+  static constexpr auto IntakeTimeout = std::chrono::milliseconds(100);
+
   Implementation(
     const std::string& uri,
     const std::shared_ptr<rclcpp::Node>& node,
-    ProvideJsonUpdates get_json_updates_cb)
+    ProvideJsonUpdates get_json_updates_cb,
+    Encoding encoding)
   : _uri{std::move(uri)},
     _node{std::move(node)},
+    _encoding{encoding},
     _get_json_updates_cb{std::move(get_json_updates_cb)},
-    _queue(1000),
-    _io_service{},
-    _endpoint(_uri,
-      _node,
-      &_io_service,
-      std::bind(&BroadcastClient::Implementation::on_connect, this))
+    _io_service{}
   {
+    _realtime = std::make_unique<Channel>(
+      _uri, _node, &_io_service, [this]() { on_connect(*_realtime); });
+    _bulk = std::make_unique<Channel>(
+      _uri, _node, &_io_service, [this]() { on_connect(*_bulk); });
+
+    for (auto* channel : {_realtime.get(), _bulk.get()})
+    {
+      channel->endpoint.set_subprotocol(subprotocol_of(_encoding));
+      channel->endpoint.set_message_handler(
+        [this, channel](const std::string& msg)
+        {
+          on_message(*channel, msg);
+        });
+    }
+
     _consumer_thread = std::thread([this]()
         {
           _io_service.run();
@@ -55,7 +124,7 @@ public:
 
     _io_service.dispatch([this]()
       {
-        _endpoint.connect();
+        _connect(*_realtime);
       });
   }
 
@@ -72,53 +141,61 @@ public:
   Implementation operator=(const Implementation& other) = delete;
 
   //============================================================================
-  void on_connect()
+  void on_connect(Channel& channel)
   {
     RCLCPP_INFO(_node->get_logger(), "Connected to server");
 
-    if (_get_json_updates_cb)
+    channel.encoding =
+      encoding_of(channel.endpoint.subprotocol()).value_or(Encoding::Json);
+    if (channel.encoding != _encoding)
     {
-      auto messages = _get_json_updates_cb();
-
-      for (auto queue_item : messages)
-      {
-        RCLCPP_INFO(
-          this->_node->get_logger(), "Sending initial message");
-        auto status = _endpoint.get_status();
-        if (!status.has_value())
-        {
-          log("Endpoint has not yet been initiallized.");
-          return;
-        }
-
-        if (status != ConnectionMetadata::ConnectionStatus::OPEN)
-        {
-          // Attempt reconnect
-          log("Disconnected during init.");
-          return;
-        }
+      RCLCPP_WARN(
+        _node->get_logger(),
+        "Server did not accept the requested encoding. Sending JSON instead.");
+    }
 
-        // Send
-        auto ec = _endpoint.send(queue_item.dump());
-        if (ec)
-        {
-          log("Send failed. Attempting reconnection.");
-          return;
-        }
-      }
-      RCLCPP_INFO(
-        this->_node->get_logger(),
-        "Sent all updates");
+    if (_get_json_updates_since_cb)
+    {
+      // The initial updates are sent once the server has told us what it
+      // already has. Queued updates do not need to wait for that.
+      if (!_request_resync(channel))
+        return;
+    }
+    else if (_get_json_updates_cb)
+    {
+      if (!_send_initial(channel, _get_json_updates_cb()))
+        return;
     }
     RCLCPP_INFO(
       this->_node->get_logger(),
       "Attempting queue flush if connected");
-    _io_service.dispatch([this]()
+    _io_service.dispatch([this, &channel]()
       {
-        _flush_queue_if_connected();
+        _flush_queue_if_connected(channel);
       });
   }
 
+  //============================================================================
+  void on_message(Channel& channel, const std::string& payload)
+  {
+    if (!channel.awaiting_resync)
+      return;
+
+    const auto msg = decode(payload, channel.encoding, false);
+    if (!msg.is_object())
+      return;
+
+    const auto type_it = msg.find("type");
+    if (type_it == msg.end() || *type_it != "resync")
+      return;
+
+    const auto data_it = msg.find("data");
+    _finish_resync(
+      channel,
+      data_it != msg.end() && data_it->is_object() ?
+      *data_it : nlohmann::json::object());
+  }
+
   //============================================================================
   void log(const std::string& str)
   {
@@ -132,37 +209,150 @@ public:
   //============================================================================
   void publish(const nlohmann::json& msg)
   {
-    /// _queue is thread safe. No need to lock.
-    _queue.push(msg);
-    _io_service.dispatch([this]()
+    /// Messages are serialized here on the caller's thread, so the queue only
+    /// holds payloads that can usually be sent as they are.
+    auto& channel = _channel_for(msg);
+    _enqueue(channel, _make_item(msg));
+    _io_service.dispatch([this, &channel]()
       {
-        _flush_queue_if_connected();
+        _flush_queue_if_connected(channel);
       });
   }
 
   //============================================================================
   void publish(const std::vector<nlohmann::json>& msgs)
   {
-    for (auto msg: msgs)
+    for (const auto& msg : msgs)
     {
-      bool full = _queue.push(msg);
-      if (full)
-      {
-        log("Buffer full dropping oldest message");
-      }
+      _enqueue(_channel_for(msg), _make_item(msg));
     }
     _io_service.dispatch([this]()
       {
-        _flush_queue_if_connected();
+        _flush_queue_if_connected(*_realtime);
+        _flush_queue_if_connected(*_bulk);
       });
   }
 
   //============================================================================
   void set_queue_limit(std::optional<std::size_t> limit)
   {
-    /// _queue is thread safe. No need to lock.
+    /// The queues are thread safe. No need to lock.
     if (limit.has_value())
-      _queue.resize(limit.value());
+    {
+      _realtime->queue.resize(limit.value());
+      _bulk->queue.resize(limit.value());
+    }
+  }
+
+  //============================================================================
+  void set_bulk_channel(bool enabled)
+  {
+    if (enabled)
+    {
+      _io_service.dispatch([this]()
+        {
+          _connect(*_bulk);
+        });
+    }
+
+    _use_bulk = enabled;
+  }
+
+  //============================================================================
+  void set_conflation(bool enabled)
+  {
+    _conflate = enabled;
+  }
+
+  //============================================================================
+  void set_batch_limit(std::optional<std::size_t> limit)
+  {
+    // The limit is only read while flushing, which happens on the io service
+    _io_service.dispatch([this, limit]()
+      {
+        _batch_limit = limit.value_or(1);
+        if (_batch_limit < 1)
+          _batch_limit = 1;
+      });
+  }
+
+  //============================================================================
+  void set_resync_callback(ProvideJsonUpdatesSince cb)
+  {
+    // The callback is only triggered on the io service
+    _io_service.dispatch([this, cb = std::move(cb)]()
+      {
+        _get_json_updates_since_cb = std::move(cb);
+      });
+  }
+
+  //============================================================================
+  std::size_t queue_size() const
+  {
+    return _realtime->queue.size() + _bulk->queue.size();
+  }
+
+  //============================================================================
+  bool saturated() const
+  {
+    return _saturated;
+  }
+
+  //============================================================================
+  void set_saturation_callback(SaturationCallback cb)
+  {
+    // The callback is only triggered on the io service
+    _io_service.dispatch([this, cb = std::move(cb)]()
+      {
+        _saturation_cb = std::move(cb);
+      });
+  }
+
+  //============================================================================
+  Statistics statistics() const
+  {
+    const auto totals = _metrics.totals();
+    Statistics stats;
+    stats.queue_depth = queue_size();
+    stats.max_queue_depth = totals.max_queue_depth;
+    stats.messages_published = _messages_published;
+    stats.messages_sent = totals.messages_sent;
+    stats.frames_sent = totals.frames_sent;
+    stats.bytes_sent = totals.bytes_sent;
+    stats.messages_dropped = totals.messages_dropped;
+    stats.send_latency_buckets = ClientMetrics::latency_buckets();
+    stats.send_latency_counts = totals.send_latency_counts;
+    stats.max_send_latency = totals.max_send_latency;
+    stats.total_send_latency = totals.total_send_latency;
+
+    for (const auto* channel : {_realtime.get(), _bulk.get()})
+    {
+      const auto endpoint = channel->endpoint.statistics();
+      stats.connection_attempts += endpoint.connection_attempts;
+      stats.connections_lost += endpoint.connections_lost;
+      stats.time_disconnected += endpoint.time_disconnected;
+    }
+
+    return stats;
+  }
+
+  //============================================================================
+  void set_diagnostics_period(std::optional<std::chrono::nanoseconds> period)
+  {
+    std::lock_guard<std::mutex> lock(_diagnostics_mutex);
+    _diagnostics_timer = nullptr;
+    if (!period.has_value() || period->count() <= 0)
+      return;
+
+    if (!_diagnostics_pub)
+    {
+      _diagnostics_pub = _node->create_publisher<MetricsMsg>(
+        BroadcastClientDiagnosticsTopicName,
+        rclcpp::SystemDefaultsQoS().reliable().keep_last(100));
+    }
+
+    _diagnostics_timer = _node->create_wall_timer(
+      *period, [this]() { _publish_diagnostics(); });
   }
 
   //============================================================================
@@ -174,11 +364,249 @@ public:
 
 private:
   //============================================================================
-  void _flush_queue_if_connected()
+  Queue::Item _make_item(const nlohmann::json& msg) const
   {
-    while (!_queue.empty())
+    return {
+      _conflation_key(msg),
+      Message{
+        std::make_shared<const std::string>(encode(msg, _encoding)),
+        _encoding,
+        Clock::now()
+      }
+    };
+  }
+
+  //============================================================================
+  /// Send a payload that is already in the encoding of the channel
+  static websocketpp::lib::error_code _send(
+    Channel& channel,
+    const std::string& payload)
+  {
+    return channel.endpoint.send(
+      payload,
+      is_binary(channel.encoding) ?
+      websocketpp::frame::opcode::binary : websocketpp::frame::opcode::text);
+  }
+
+  //============================================================================
+  /// Messages are encoded as they are published, before it is known what the
+  /// server will agree to. They only need to be converted when it does not
+  /// accept the encoding that was asked for.
+  static void _convert(Message& message, Encoding encoding)
+  {
+    if (message.encoding == encoding)
+      return;
+
+    message.text = std::make_shared<const std::string>(
+      encode(decode(*message.text, message.encoding), encoding));
+    message.encoding = encoding;
+  }
+
+  //============================================================================
+  /// Hand a message over to the io service without taking a lock. The intake
+  /// only fills up if the io service has fallen far behind, in which case the
+  /// publisher waits a short while for it to catch up and then drops the
+  /// message.
+  void _enqueue(Channel& channel, Queue::Item item)
+  {
+    ++_messages_published;
+    const auto give_up = Clock::now() + IntakeTimeout;
+    while (!channel.intake.try_push(item))
     {
-      auto status = _endpoint.get_status();
+      if (std::this_thread::get_id() == _consumer_thread.get_id())
+      {
+        _drain_intake(channel);
+      }
+      else if (give_up <= Clock::now())
+      {
+        log("Intake full, dropping newest message");
+        _metrics.record_dropped();
+        return;
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  //============================================================================
+  /// Move everything that has been published into the queue. This must only
+  /// be called on the io service.
+  void _drain_intake(Channel& channel)
+  {
+    bool any = false;
+    while (auto item = channel.intake.pop())
+    {
+      any = true;
+      if (!channel.queue.push(std::move(*item)))
+      {
+        log("Buffer full dropping oldest message");
+        _metrics.record_dropped();
+      }
+    }
+
+    if (any)
+      _metrics.record_queue_depth(queue_size());
+  }
+
+  //============================================================================
+  /// Send the messages that bring a newly connected server up to date. Each
+  /// channel only sends the ones that it would carry. Returns false if the
+  /// connection was lost.
+  bool _send_initial(
+    Channel& channel,
+    const std::vector<nlohmann::json>& messages)
+  {
+    for (const auto& queue_item : messages)
+    {
+      if (&_channel_for(queue_item) != &channel)
+        continue;
+
+      RCLCPP_INFO(
+        this->_node->get_logger(), "Sending initial message");
+      auto status = channel.endpoint.get_status();
+      if (!status.has_value())
+      {
+        log("Endpoint has not yet been initiallized.");
+        return false;
+      }
+
+      if (status != ConnectionMetadata::ConnectionStatus::OPEN)
+      {
+        // Attempt reconnect
+        log("Disconnected during init.");
+        return false;
+      }
+
+      // Send
+      const auto text = encode(queue_item, channel.encoding);
+      auto ec = _send(channel, text);
+      if (ec)
+      {
+        log("Send failed. Attempting reconnection.");
+        return false;
+      }
+      _metrics.record_frame(1, text.size());
+    }
+    RCLCPP_INFO(
+      this->_node->get_logger(),
+      "Sent all updates");
+    return true;
+  }
+
+  //============================================================================
+  /// Ask the server what it has already received. If it does not answer in
+  /// time, everything is sent as if it had nothing.
+  bool _request_resync(Channel& channel)
+  {
+    static const nlohmann::json request = {{"type", "resync_request"}};
+    if (_send(channel, encode(request, channel.encoding)))
+    {
+      log("Send failed. Attempting reconnection.");
+      return false;
+    }
+
+    channel.awaiting_resync = true;
+    channel.resync_timer.expires_from_now(ResyncTimeout);
+    channel.resync_timer.async_wait(
+      [this, &channel](const boost::system::error_code& ec)
+      {
+        if (ec || !channel.awaiting_resync)
+          return;
+
+        RCLCPP_WARN(
+          _node->get_logger(),
+          "Server did not answer the resync request. Sending all updates.");
+        _finish_resync(channel, nlohmann::json::object());
+      });
+
+    return true;
+  }
+
+  //============================================================================
+  void _finish_resync(Channel& channel, const nlohmann::json& last_seen)
+  {
+    channel.awaiting_resync = false;
+    channel.resync_timer.cancel();
+    if (_get_json_updates_since_cb)
+      _send_initial(channel, _get_json_updates_since_cb(last_seen));
+  }
+
+  //============================================================================
+  /// Log updates go over the bulk channel when it is turned on, so a burst of
+  /// them does not hold up state updates. Everything else is realtime.
+  Channel& _channel_for(const nlohmann::json& msg)
+  {
+    if (!_use_bulk || !msg.is_object())
+      return *_realtime;
+
+    const auto type_it = msg.find("type");
+    if (type_it == msg.end() || !type_it->is_string())
+      return *_realtime;
+
+    const auto& type = type_it->get_ref<const std::string&>();
+    if (type == "fleet_log_update" || type == "task_log_update")
+      return *_bulk;
+
+    return *_realtime;
+  }
+
+  //============================================================================
+  /// This must only be called on the io service.
+  void _connect(Channel& channel)
+  {
+    if (channel.connect_requested)
+      return;
+
+    channel.connect_requested = true;
+    channel.endpoint.connect();
+  }
+
+  //============================================================================
+  void _flush_queue_if_connected(Channel& channel)
+  {
+    _drain_intake(channel);
+    _send_queued(channel);
+    _update_saturation();
+  }
+
+  //============================================================================
+  /// Saturation turns on when any queue is full and only turns off again once
+  /// all of them are down to half, so it does not flicker while the server is
+  /// only just keeping up. This must only be called on the io service.
+  void _update_saturation()
+  {
+    bool saturated = false;
+    for (auto* channel : {_realtime.get(), _bulk.get()})
+    {
+      const std::size_t size = channel->queue.size();
+      const std::size_t capacity = channel->queue.capacity();
+      if (size >= capacity || (_saturated && size > capacity / 2))
+        saturated = true;
+    }
+
+    if (saturated == _saturated)
+      return;
+
+    _saturated = saturated;
+    RCLCPP_WARN(
+      _node->get_logger(),
+      "%s",
+      saturated ? "Websocket queue is saturated" :
+      "Websocket queue is no longer saturated");
+
+    if (_saturation_cb)
+      _saturation_cb(saturated);
+  }
+
+  //============================================================================
+  void _send_queued(Channel& channel)
+  {
+    auto& queue = channel.queue;
+    while (!queue.empty())
+    {
+      auto status = channel.endpoint.get_status();
       if (!status.has_value())
       {
         log("Endpoint has not yet been initiallized.");
@@ -190,39 +618,186 @@ private:
         log("Connection not yet established");
         return;
       }
-      auto queue_item = _queue.front();
-      if (!queue_item.has_value())
-      {
-        // Technically this should be unreachable as long as the client is
-        // single threaded
-        throw std::runtime_error(
-                "The queue was modified when it shouldnt have been");
+      auto queue_items = queue.take_front(_batch_limit);
+      if (queue_items.empty())
         return;
+
+      for (auto& item : queue_items)
+        _convert(item.value, channel.encoding);
+
+      std::string batch;
+      if (queue_items.size() > 1)
+      {
+        // The messages are already serialized, so they are joined as they
+        // are instead of being decoded back into an array.
+        std::vector<const std::string*> texts;
+        texts.reserve(queue_items.size());
+        for (const auto& item : queue_items)
+          texts.push_back(item.value.text.get());
+
+        batch = make_batch(texts, channel.encoding);
       }
-      auto ec = _endpoint.send(queue_item->dump());
+
+      const std::string& text = queue_items.size() == 1 ?
+        *queue_items.front().value.text : batch;
+
+      auto ec = _send(channel, text);
       if (ec)
       {
         log("Sending message failed. Maybe due to intermediate disconnection");
+        queue.restore_front(std::move(queue_items));
         return;
       }
       else
       {
         RCLCPP_DEBUG(
           this->_node->get_logger(), "Sent successfully");
+
+        const auto now = Clock::now();
+        for (const auto& item : queue_items)
+          _metrics.record_latency(now - item.value.published);
+
+        _metrics.record_frame(queue_items.size(), text.size());
       }
-      _queue.pop_item();
     }
     RCLCPP_DEBUG(
       this->_node->get_logger(), "Emptied queue");
   }
+
+  //============================================================================
+  /// Publish the statistics of the window since the last time this was called
+  /// along with the running totals. This runs on the executor of the node.
+  void _publish_diagnostics()
+  {
+    using DataType = statistics_msgs::msg::StatisticDataType;
+    using DataPoint = statistics_msgs::msg::StatisticDataPoint;
+
+    const rclcpp::Time now = _node->now();
+    const rclcpp::Time window_start = _diagnostics_window_start.value_or(now);
+    _diagnostics_window_start = now;
+
+    const auto make = [&](const std::string& name, const std::string& unit)
+      {
+        MetricsMsg msg;
+        msg.measurement_source_name = _uri;
+        msg.metrics_source = name;
+        msg.unit = unit;
+        msg.window_start = window_start;
+        msg.window_stop = now;
+        return msg;
+      };
+
+    const auto add = [](MetricsMsg& msg, uint8_t type, double data)
+      {
+        DataPoint point;
+        point.data_type = type;
+        point.data = data;
+        msg.statistics.push_back(point);
+      };
+
+    const auto window = _metrics.take_window();
+    const std::pair<const char*, const ClientMetrics::Summary*> summaries[] = {
+      {"queue_depth", &window.queue_depth},
+      {"send_latency", &window.send_latency}
+    };
+
+    for (const auto& [name, summary] : summaries)
+    {
+      if (summary->count == 0)
+        continue;
+
+      auto msg = make(name, name == std::string("queue_depth") ?
+          "messages" : "seconds");
+      add(msg, DataType::STATISTICS_DATA_TYPE_AVERAGE, summary->mean());
+      add(msg, DataType::STATISTICS_DATA_TYPE_MINIMUM, summary->min);
+      add(msg, DataType::STATISTICS_DATA_TYPE_MAXIMUM, summary->max);
+      add(msg, DataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT,
+        static_cast<double>(summary->count));
+      _diagnostics_pub->publish(msg);
+    }
+
+    const auto stats = statistics();
+    const std::pair<const char*, std::size_t> counters[] = {
+      {"messages_published", stats.messages_published},
+      {"messages_sent", stats.messages_sent},
+      {"messages_dropped", stats.messages_dropped},
+      {"bytes_sent", stats.bytes_sent},
+      {"connections_lost", stats.connections_lost}
+    };
+
+    for (const auto& [name, value] : counters)
+    {
+      auto msg = make(name, "count");
+      add(msg, DataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT,
+        static_cast<double>(value));
+      _diagnostics_pub->publish(msg);
+    }
+  }
+
+  //============================================================================
+  /// State updates are snapshots, so only the latest one for each fleet or
+  /// task needs to be sent. Everything else, such as logs, is kept.
+  std::optional<std::string> _conflation_key(const nlohmann::json& msg) const
+  {
+    if (!_conflate || !msg.is_object())
+      return std::nullopt;
+
+    const auto type_it = msg.find("type");
+    const auto data_it = msg.find("data");
+    if (type_it == msg.end() || !type_it->is_string()
+      || data_it == msg.end() || !data_it->is_object())
+      return std::nullopt;
+
+    const auto& type = type_it->get_ref<const std::string&>();
+    const nlohmann::json* id = nullptr;
+    if (type == "fleet_state_update")
+    {
+      const auto name_it = data_it->find("name");
+      if (name_it != data_it->end())
+        id = &*name_it;
+    }
+    else if (type == "task_state_update")
+    {
+      const auto booking_it = data_it->find("booking");
+      if (booking_it != data_it->end() && booking_it->is_object())
+      {
+        const auto id_it = booking_it->find("id");
+        if (id_it != booking_it->end())
+          id = &*id_it;
+      }
+    }
+
+    if (!id || !id->is_string())
+      return std::nullopt;
+
+    return type + "/" + id->get<std::string>();
+  }
+
   // create pimpl
   std::string _uri;
   boost::asio::io_service _io_service;
   std::shared_ptr<rclcpp::Node> _node;
-  RingBuffer<nlohmann::json> _queue;
+  std::atomic_bool _conflate{true};
+  std::atomic_bool _use_bulk{false};
+  std::atomic_bool _saturated{false};
+  const Encoding _encoding;
+  // Only touched on the io service
+  SaturationCallback _saturation_cb;
+  mutable ClientMetrics _metrics;
+  std::atomic_size_t _messages_published{0};
+  std::mutex _diagnostics_mutex;
+  rclcpp::Publisher<MetricsMsg>::SharedPtr _diagnostics_pub;
+  rclcpp::TimerBase::SharedPtr _diagnostics_timer;
+  // Only touched by the diagnostics timer
+  std::optional<rclcpp::Time> _diagnostics_window_start;
   ProvideJsonUpdates _get_json_updates_cb;
+  // Only touched on the io service
+  ProvideJsonUpdatesSince _get_json_updates_since_cb;
   std::atomic<bool> _stop;
-  ClientWebSocketEndpoint _endpoint;
+  // Only touched on the io service
+  std::size_t _batch_limit = 1;
+  std::unique_ptr<Channel> _realtime;
+  std::unique_ptr<Channel> _bulk;
 
   std::thread _consumer_thread;
 };
@@ -231,12 +806,13 @@ private:
 std::shared_ptr<BroadcastClient> BroadcastClient::make(
   const std::string& uri,
   const std::shared_ptr<rclcpp::Node>& node,
-  ProvideJsonUpdates on_open_connection_fn)
+  ProvideJsonUpdates on_open_connection_fn,
+  Encoding encoding)
 {
   auto client = std::shared_ptr<BroadcastClient>(new BroadcastClient());
   client->_pimpl =
     rmf_utils::make_unique_impl<Implementation>(
-    uri, node, on_open_connection_fn);
+    uri, node, on_open_connection_fn, encoding);
   return client;
 }
 
@@ -258,6 +834,61 @@ void BroadcastClient::set_queue_limit(std::optional<std::size_t> limit)
   _pimpl->set_queue_limit(limit);
 }
 
+//==============================================================================
+void BroadcastClient::set_conflation(bool enabled)
+{
+  _pimpl->set_conflation(enabled);
+}
+
+//==============================================================================
+void BroadcastClient::set_bulk_channel(bool enabled)
+{
+  _pimpl->set_bulk_channel(enabled);
+}
+
+//==============================================================================
+void BroadcastClient::set_resync_callback(ProvideJsonUpdatesSince cb)
+{
+  _pimpl->set_resync_callback(std::move(cb));
+}
+
+//==============================================================================
+auto BroadcastClient::statistics() const -> Statistics
+{
+  return _pimpl->statistics();
+}
+
+//==============================================================================
+void BroadcastClient::set_diagnostics_period(
+  std::optional<std::chrono::nanoseconds> period)
+{
+  _pimpl->set_diagnostics_period(period);
+}
+
+//==============================================================================
+std::size_t BroadcastClient::queue_size() const
+{
+  return _pimpl->queue_size();
+}
+
+//==============================================================================
+bool BroadcastClient::saturated() const
+{
+  return _pimpl->saturated();
+}
+
+//==============================================================================
+void BroadcastClient::set_saturation_callback(SaturationCallback cb)
+{
+  _pimpl->set_saturation_callback(std::move(cb));
+}
+
+//==============================================================================
+void BroadcastClient::set_batch_limit(std::optional<std::size_t> limit)
+{
+  _pimpl->set_batch_limit(limit);
+}
+
 //==============================================================================
 BroadcastClient::BroadcastClient()
 {
@@ -20,10 +20,18 @@
 #include <websocketpp/config/asio_no_tls.hpp>
 #include <websocketpp/server.hpp>
 
+#include "utils/Codec.hpp"
+
 #include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <functional>
+#include <map>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 namespace rmf_websocket {
 
@@ -39,11 +47,12 @@ public:
   Implementation(
     const int port,
     ApiMessageCallback callback,
+    RawMessageCallback raw_callback,
     std::optional<ApiMsgType> msg_selection,
     const rclcpp::node_interfaces::NodeLoggingInterface::SharedPtr
       node_logging_interface)
   : _data(std::make_shared<Data>(std::move(callback),
-        std::move(msg_selection))),
+        std::move(raw_callback), std::move(msg_selection))),
     _logger_interface(node_logging_interface)
   {
     if (_logger_interface)
@@ -71,6 +80,22 @@ public:
             data->on_message(hdl, msg);
         });
 
+      _data->echo_server.set_validate_handler(
+        [w = _data->weak_from_this()](const auto& hdl)
+        {
+          if (const auto data = w.lock())
+            data->choose_encoding(hdl);
+
+          return true;
+        });
+
+      _data->echo_server.set_close_handler(
+        [w = _data->weak_from_this()](const auto& hdl)
+        {
+          if (const auto data = w.lock())
+            data->forget(hdl);
+        });
+
       _data->echo_server.listen(port);
       _data->echo_server.start_accept();
     }
@@ -109,18 +134,32 @@ public:
       }
       RCLCPP_INFO_STREAM(
         _logger_interface->get_logger(),
-        "Starting BroadcastServer on port " << endpoint.port());
+        "Starting BroadcastServer on port " << endpoint.port()
+          << " with " << _num_threads << " thread(s)");
     }
 
     // Start the ASIO io_service run loop
-    _server_thread = std::thread(
-      [data = _data]() { data->echo_server.run(); });
+    for (std::size_t i = 0; i < _num_threads; ++i)
+    {
+      _server_threads.emplace_back(
+        [data = _data]() { data->echo_server.run(); });
+    }
+  }
+
+  void set_num_threads(std::size_t num_threads)
+  {
+    _num_threads = std::max<std::size_t>(1, num_threads);
+  }
+
+  void set_connection_rate_limit(std::optional<std::size_t> messages_per_sec)
+  {
+    _data->rate_limit = messages_per_sec.value_or(0);
   }
 
   /// Stop Server
   void stop()
   {
-    if (_server_thread.joinable())
+    if (!_server_threads.empty())
     {
       if (_logger_interface)
       {
@@ -134,7 +173,11 @@ public:
             data->echo_server.stop_listening();
             data->echo_server.stop();
           });
-      _server_thread.join();
+
+      for (auto& thread : _server_threads)
+        thread.join();
+
+      _server_threads.clear();
     }
   }
 
@@ -158,43 +201,261 @@ private:
 
   struct Data : public std::enable_shared_from_this<Data>
   {
-    Data(ApiMessageCallback callback, std::optional<ApiMsgType> msg_selection)
+    Data(
+      ApiMessageCallback callback,
+      RawMessageCallback raw,
+      std::optional<ApiMsgType> msg_selection)
     : selection(std::move(msg_selection)),
-      msg_callback(std::move(callback))
+      msg_callback(std::move(callback)),
+      raw_callback(std::move(raw))
     {
       // Do nothing
     }
 
+    /// How many messages a connection has sent in the current second
+    struct Budget
+    {
+      std::chrono::steady_clock::time_point window_start;
+      std::size_t count = 0;
+    };
+
     /// private class variables
     Server echo_server;
     std::optional<ApiMsgType> selection;
     ApiMessageCallback msg_callback;
+    RawMessageCallback raw_callback;
+
+    /// Messages per second allowed for each connection, or 0 for no limit
+    std::atomic_size_t rate_limit{0};
+
+    /// Protects the variables below, since several threads may be serving
+    /// connections
+    std::mutex mutex;
+
+    /// The highest log sequence number received for each event of each task,
+    /// as {task_id: {phase_id: {event_id: seq}}}
+    nlohmann::json task_logs_seen = nlohmann::json::object();
+
+    std::map<websocketpp::connection_hdl, Budget,
+      std::owner_less<websocketpp::connection_hdl>> budgets;
 
     /// Define an internal callback to handle incoming messages
-    void on_message(websocketpp::connection_hdl, Server::message_ptr msg)
+    void on_message(websocketpp::connection_hdl hdl, Server::message_ptr msg)
     {
-      const auto msg_string = msg->get_payload();
+      const auto& msg_string = msg->get_payload();
       if (!msg_string.empty())
       {
-        const nlohmann::json msg_json = nlohmann::json::parse(msg_string);
+        throttle(hdl);
+
+        if (raw_callback)
+        {
+          static const std::string resync_request =
+            "{\"type\":\"resync_request\"}";
+
+          if (msg_string == resync_request)
+            send_resync(hdl, Encoding::Json);
+          else
+            raw_callback(msg_string);
+
+          return;
+        }
+
+        const Encoding encoding = encoding_for(hdl);
+        const nlohmann::json msg_json = decode(msg_string, encoding);
+
+        const auto type_it = msg_json.find("type");
+        if (type_it != msg_json.end() && type_it.value() == "resync_request")
+        {
+          send_resync(hdl, encoding);
+          return;
+        }
+
+        // Clients may send several messages together in one batch
+        if (type_it != msg_json.end() && type_it.value() == "batch")
+        {
+          const auto data_it = msg_json.find("data");
+          if (data_it != msg_json.end() && data_it->is_array())
+          {
+            for (const auto& item : *data_it)
+              handle(item);
+          }
+          return;
+        }
+
+        handle(msg_json);
+      }
+    }
+
+    /// Accept the first binary encoding that a connecting client asks for.
+    /// Raw servers hand over messages as they were received, so they stay
+    /// with JSON.
+    void choose_encoding(websocketpp::connection_hdl hdl)
+    {
+      if (raw_callback)
+        return;
+
+      websocketpp::lib::error_code ec;
+      const auto con = echo_server.get_con_from_hdl(hdl, ec);
+      if (ec)
+        return;
+
+      for (const auto& subprotocol : con->get_requested_subprotocols())
+      {
+        if (encoding_of(subprotocol).has_value())
+        {
+          con->select_subprotocol(subprotocol, ec);
+          return;
+        }
+      }
+    }
+
+    /// The encoding that was agreed on for a connection
+    Encoding encoding_for(websocketpp::connection_hdl hdl)
+    {
+      websocketpp::lib::error_code ec;
+      const auto con = echo_server.get_con_from_hdl(hdl, ec);
+      if (ec)
+        return Encoding::Json;
+
+      return encoding_of(con->get_subprotocol())
+        .value_or(Encoding::Json);
+    }
+
+    /// Tell a client which log entries have already been received, so that
+    /// after reconnecting it only needs to send the ones that are missing
+    void send_resync(websocketpp::connection_hdl hdl, Encoding encoding)
+    {
+      nlohmann::json resync;
+      resync["type"] = "resync";
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        resync["data"]["task_logs"] = task_logs_seen;
+      }
+
+      websocketpp::lib::error_code ec;
+      echo_server.send(
+        hdl, encode(resync, encoding),
+        is_binary(encoding) ?
+        websocketpp::frame::opcode::binary : websocketpp::frame::opcode::text,
+        ec);
+    }
+
+    void record_task_log(const nlohmann::json& msg_json)
+    {
+      const auto data_it = msg_json.find("data");
+      if (data_it == msg_json.end() || !data_it->is_object())
+        return;
 
-        if (selection)
+      const auto task_it = data_it->find("task_id");
+      const auto phases_it = data_it->find("phases");
+      if (task_it == data_it->end() || !task_it->is_string()
+        || phases_it == data_it->end() || !phases_it->is_object())
+        return;
+
+      std::lock_guard<std::mutex> lock(mutex);
+      auto& task_seen = task_logs_seen[task_it->get<std::string>()];
+      for (const auto& [phase_id, phase] : phases_it->items())
+      {
+        const auto events_it = phase.find("events");
+        if (events_it == phase.end() || !events_it->is_object())
+          continue;
+
+        for (const auto& [event_id, entries] : events_it->items())
         {
-          const auto target_msg_type = to_string(*selection);
-          const auto type_it = msg_json.find("type");
-          if (type_it != msg_json.end())
+          if (!entries.is_array())
+            continue;
+
+          auto& seen = task_seen[phase_id][event_id];
+          for (const auto& entry : entries)
           {
-            if (type_it.value() == target_msg_type)
-              msg_callback(msg_json.at("data"));
+            const auto seq_it = entry.find("seq");
+            if (seq_it == entry.end() || !seq_it->is_number_unsigned())
+              continue;
+
+            if (!seen.is_number() || seen < *seq_it)
+              seen = *seq_it;
           }
         }
-        else
-          msg_callback(msg_json);
       }
     }
+
+    /// Stop reading from a connection for the rest of the second once it
+    /// has used up its budget of messages
+    void throttle(websocketpp::connection_hdl hdl)
+    {
+      const std::size_t limit = rate_limit;
+      if (limit == 0)
+        return;
+
+      using namespace std::chrono;
+      const auto now = steady_clock::now();
+      milliseconds resume_in;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& budget = budgets[hdl];
+        if (now - budget.window_start >= seconds(1))
+        {
+          budget.window_start = now;
+          budget.count = 0;
+        }
+
+        if (++budget.count < limit)
+          return;
+
+        resume_in = duration_cast<milliseconds>(
+          budget.window_start + seconds(1) - now);
+      }
+
+      websocketpp::lib::error_code ec;
+      const auto con = echo_server.get_con_from_hdl(hdl, ec);
+      if (ec)
+        return;
+
+      con->pause_reading();
+      echo_server.set_timer(
+        resume_in.count(),
+        [w = weak_from_this(), hdl](
+          const websocketpp::lib::error_code& timer_ec)
+        {
+          const auto data = w.lock();
+          if (timer_ec || !data)
+            return;
+
+          websocketpp::lib::error_code con_ec;
+          const auto con = data->echo_server.get_con_from_hdl(hdl, con_ec);
+          if (!con_ec)
+            con->resume_reading();
+        });
+    }
+
+    void forget(websocketpp::connection_hdl hdl)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      budgets.erase(hdl);
+    }
+
+    void handle(const nlohmann::json& msg_json)
+    {
+      const auto type_it = msg_json.find("type");
+      if (type_it != msg_json.end() && *type_it == "task_log_update")
+        record_task_log(msg_json);
+
+      if (selection)
+      {
+        const auto target_msg_type = to_string(*selection);
+        if (type_it != msg_json.end())
+        {
+          if (type_it.value() == target_msg_type)
+            msg_callback(msg_json.at("data"));
+        }
+      }
+      else
+        msg_callback(msg_json);
+    }
   };
   std::shared_ptr<Data> _data;
-  std::thread _server_thread;
+  std::size_t _num_threads = 1;
+  std::vector<std::thread> _server_threads;
   rclcpp::node_interfaces::NodeLoggingInterface::SharedPtr _logger_interface;
 };
 
@@ -207,7 +468,7 @@ std::shared_ptr<BroadcastServer> BroadcastServer::make(
   auto server = std::shared_ptr<BroadcastServer>(new BroadcastServer());
   server->_pimpl =
     rmf_utils::make_unique_impl<Implementation>(
-    port, callback, msg_selection, nullptr);
+    port, callback, nullptr, msg_selection, nullptr);
   return server;
 }
 
@@ -222,10 +483,38 @@ std::shared_ptr<BroadcastServer> BroadcastServer::make_with_logger(
   auto server = std::shared_ptr<BroadcastServer>(new BroadcastServer());
   server->_pimpl =
     rmf_utils::make_unique_impl<Implementation>(
-        port, callback, msg_selection, node_logging_interface);
+        port, callback, nullptr, msg_selection, node_logging_interface);
   return server;
 }
 
+//==============================================================================
+std::shared_ptr<BroadcastServer> BroadcastServer::make_raw(
+  const int port,
+  RawMessageCallback callback,
+  const rclcpp::node_interfaces::NodeLoggingInterface::SharedPtr
+    node_logging_interface)
+{
+  auto server = std::shared_ptr<BroadcastServer>(new BroadcastServer());
+  server->_pimpl =
+    rmf_utils::make_unique_impl<Implementation>(
+        port, nullptr, std::move(callback), std::nullopt,
+        node_logging_interface);
+  return server;
+}
+
+//==============================================================================
+void BroadcastServer::set_num_threads(std::size_t num_threads)
+{
+  _pimpl->set_num_threads(num_threads);
+}
+
+//==============================================================================
+void BroadcastServer::set_connection_rate_limit(
+  std::optional<std::size_t> messages_per_sec)
+{
+  _pimpl->set_connection_rate_limit(messages_per_sec);
+}
+
 //==============================================================================
 void BroadcastServer::start()
 {
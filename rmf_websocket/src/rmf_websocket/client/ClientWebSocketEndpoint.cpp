@@ -126,6 +126,7 @@ websocketpp::lib::error_code ClientWebSocketEndpoint::connect()
   websocketpp::lib::error_code ec;
 
   _init = true;
+  ++_connection_attempts;
   _con = _endpoint->get_connection(_uri, ec);
   RCLCPP_INFO(_node->get_logger(), "Attempting to connect to %s", _uri.c_str());
 
@@ -136,6 +137,18 @@ websocketpp::lib::error_code ClientWebSocketEndpoint::connect()
     return ec;
   }
 
+  _accepted_subprotocol.clear();
+  if (!_requested_subprotocol.empty())
+  {
+    _con->add_subprotocol(_requested_subprotocol, ec);
+    if (ec)
+    {
+      RCLCPP_ERROR(_node->get_logger(), "> Invalid subprotocol %s: %s",
+        _requested_subprotocol.c_str(), ec.message().c_str());
+      ec.clear();
+    }
+  }
+
   auto reconnect_socket = [this]()
     {
       // TODO(arjo) Parametrize the timeout.
@@ -172,6 +185,14 @@ websocketpp::lib::error_code ClientWebSocketEndpoint::connect()
     {
       RCLCPP_INFO(_node->get_logger(), "Succesfully connected to %s",
       _uri.c_str());
+      ++_connections_opened;
+      _accepted_subprotocol = _con->get_subprotocol();
+      const auto lost_since = _lost_since_ticks.exchange(0);
+      if (lost_since != 0)
+      {
+        _time_disconnected_ticks += std::chrono::steady_clock::now()
+        .time_since_epoch().count() - lost_since;
+      }
       _current_connection->on_open(_endpoint.get(), hdl);
     });
   _con->set_fail_handler([this](websocketpp::connection_hdl hdl)
@@ -183,11 +204,21 @@ websocketpp::lib::error_code ClientWebSocketEndpoint::connect()
 
   _con->set_close_handler([this](websocketpp::connection_hdl hdl)
     {
+      ++_connections_lost;
+      _lost_since_ticks = std::chrono::steady_clock::now()
+      .time_since_epoch().count();
       _current_connection->on_close(_endpoint.get(), hdl);
       RCLCPP_INFO(_node->get_logger(), "Connection to %s closed. Reason:\n %s",
       _uri.c_str(), _current_connection->debug_data().c_str());
     });
 
+  _con->set_message_handler(
+    [this](websocketpp::connection_hdl, WsClient::message_ptr msg)
+    {
+      if (_message_cb)
+        _message_cb(msg->get_payload());
+    });
+
 
   _endpoint->connect(_con);
 
@@ -207,13 +238,12 @@ get_status() const
 
 //=============================================================================
 websocketpp::lib::error_code ClientWebSocketEndpoint::send(
-  const std::string& message)
+  const std::string& message,
+  websocketpp::frame::opcode::value opcode)
 {
   websocketpp::lib::error_code ec;
 
-  _endpoint->send(
-    _current_connection->get_hdl(), message, websocketpp::frame::opcode::text,
-    ec);
+  _endpoint->send(_current_connection->get_hdl(), message, opcode, ec);
   if (ec)
   {
     return ec;
@@ -221,6 +251,45 @@ websocketpp::lib::error_code ClientWebSocketEndpoint::send(
   return ec;
 }
 
+//=============================================================================
+void ClientWebSocketEndpoint::set_message_handler(MessageCallback cb)
+{
+  _message_cb = std::move(cb);
+}
+
+//=============================================================================
+void ClientWebSocketEndpoint::set_subprotocol(std::string subprotocol)
+{
+  _requested_subprotocol = std::move(subprotocol);
+}
+
+//=============================================================================
+const std::string& ClientWebSocketEndpoint::subprotocol() const
+{
+  return _accepted_subprotocol;
+}
+
+//=============================================================================
+auto ClientWebSocketEndpoint::statistics() const -> Statistics
+{
+  Statistics stats;
+  stats.connection_attempts = _connection_attempts;
+  stats.connections_opened = _connections_opened;
+  stats.connections_lost = _connections_lost;
+
+  int64_t disconnected = _time_disconnected_ticks;
+  const int64_t lost_since = _lost_since_ticks;
+  if (lost_since != 0)
+  {
+    // Include the outage that is still going on
+    disconnected +=
+      std::chrono::steady_clock::now().time_since_epoch().count() - lost_since;
+  }
+
+  stats.time_disconnected = std::chrono::steady_clock::duration(disconnected);
+  return stats;
+}
+
 //=============================================================================
 ClientWebSocketEndpoint::~ClientWebSocketEndpoint()
 {
@@ -1,6 +1,8 @@
 #ifndef RMF_WEBSOCKET__CLIENT_CLIENTWEBSOCKETENDPOINT_HPP
 #define RMF_WEBSOCKET__CLIENT_CLIENTWEBSOCKETENDPOINT_HPP
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -95,6 +97,27 @@ class ClientWebSocketEndpoint
 {
 public:
   typedef std::function<void()> ConnectionCallback;
+
+  /// Message callback
+  typedef std::function<void(const std::string&)> MessageCallback;
+
+  /// Counters for how the connection to the server has been holding up
+  struct Statistics
+  {
+    /// Number of times a connection was attempted, including retries
+    std::size_t connection_attempts = 0;
+
+    /// Number of times a connection was opened
+    std::size_t connections_opened = 0;
+
+    /// Number of times an open connection was closed
+    std::size_t connections_lost = 0;
+
+    /// Total time spent reconnecting after a connection was lost
+    std::chrono::steady_clock::duration time_disconnected =
+      std::chrono::steady_clock::duration(0);
+  };
+
   /// Constructor
   /// Pass io service so that multiple endpoints
   /// can run on the same thread
@@ -130,7 +153,25 @@ public:
   std::optional<ConnectionMetadata::ConnectionStatus> get_status() const;
 
   /// Send a message.
-  websocketpp::lib::error_code send(const std::string& message);
+  websocketpp::lib::error_code send(
+    const std::string& message,
+    websocketpp::frame::opcode::value opcode =
+    websocketpp::frame::opcode::text);
+
+  /// Ask the server for this websocket subprotocol, or none if it is empty.
+  /// This takes effect from the next connection attempt.
+  void set_subprotocol(std::string subprotocol);
+
+  /// Get the subprotocol that the server accepted for the current
+  /// connection. This is empty if the server did not accept one.
+  const std::string& subprotocol() const;
+
+  /// Set a callback for messages that the server sends to this client. This
+  /// takes effect from the next connection attempt.
+  void set_message_handler(MessageCallback cb);
+
+  /// Get the connection statistics. This may be called from any thread.
+  Statistics statistics() const;
 
   /// Destructor
   ~ClientWebSocketEndpoint();
@@ -145,6 +186,17 @@ private:
   WsClient::connection_ptr _con;
   bool _init, _enqueued_conn, _reconnect_enqueued;
   ConnectionCallback _connection_cb;
+  MessageCallback _message_cb;
+  std::string _requested_subprotocol;
+  std::string _accepted_subprotocol;
+
+  // Updated by the handlers on the io service and read from any thread. Times
+  // are counted in steady_clock ticks, with zero meaning not disconnected.
+  std::atomic_size_t _connection_attempts{0};
+  std::atomic_size_t _connections_opened{0};
+  std::atomic_size_t _connections_lost{0};
+  std::atomic<int64_t> _lost_since_ticks{0};
+  std::atomic<int64_t> _time_disconnected_ticks{0};
 };
 }
 #endif
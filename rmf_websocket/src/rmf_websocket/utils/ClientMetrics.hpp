@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef RMF_WEBSOCKET__UTILS_CLIENTMETRICS_HPP
+#define RMF_WEBSOCKET__UTILS_CLIENTMETRICS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace rmf_websocket {
+
+//==============================================================================
+/// Thread safe record of how many messages a client has been sending and how
+/// long they waited. Everything is kept both as totals since the start and as
+/// a window that is reset whenever it is taken, e.g. for a diagnostics topic.
+class ClientMetrics
+{
+public: using Clock = std::chrono::steady_clock;
+
+//==============================================================================
+/// Summary of the samples of a value
+public: struct Summary
+  {
+    std::size_t count = 0;
+    double sum = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+
+    void add(double value)
+    {
+      min = count == 0 ? value : std::min(min, value);
+      max = count == 0 ? value : std::max(max, value);
+      sum += value;
+      ++count;
+    }
+
+    double mean() const
+    {
+      return count == 0 ? 0.0 : sum / static_cast<double>(count);
+    }
+  };
+
+//==============================================================================
+public: struct Totals
+  {
+    std::size_t max_queue_depth = 0;
+    std::size_t messages_sent = 0;
+    std::size_t frames_sent = 0;
+    std::size_t bytes_sent = 0;
+    std::size_t messages_dropped = 0;
+
+    /// Number of sent messages whose latency fell in each of the buckets of
+    /// latency_buckets(), plus one more for anything slower than the last
+    std::vector<std::size_t> send_latency_counts;
+    Clock::duration max_send_latency = Clock::duration(0);
+    Clock::duration total_send_latency = Clock::duration(0);
+  };
+
+//==============================================================================
+public: struct Window
+  {
+    /// Queue depths in messages
+    Summary queue_depth;
+
+    /// Enqueue to send latencies in seconds
+    Summary send_latency;
+
+    std::size_t bytes_sent = 0;
+    std::size_t messages_dropped = 0;
+  };
+
+//==============================================================================
+/// Upper bounds, in seconds, of the send latency histogram buckets
+public: static const std::vector<double>& latency_buckets()
+  {
+    static const std::vector<double> buckets = {
+      0.001, 0.01, 0.1, 1.0, 10.0
+    };
+    return buckets;
+  }
+
+//==============================================================================
+public: ClientMetrics()
+  {
+    _totals.send_latency_counts.resize(latency_buckets().size() + 1, 0);
+  }
+
+//==============================================================================
+public: void record_queue_depth(std::size_t depth)
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _totals.max_queue_depth = std::max(_totals.max_queue_depth, depth);
+    _window.queue_depth.add(static_cast<double>(depth));
+  }
+
+//==============================================================================
+/// Record a frame that was sent, which may carry several messages
+public: void record_frame(std::size_t messages, std::size_t bytes)
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _totals.messages_sent += messages;
+    _totals.frames_sent += 1;
+    _totals.bytes_sent += bytes;
+    _window.bytes_sent += bytes;
+  }
+
+//==============================================================================
+/// Record how long a message waited between being published and being sent
+public: void record_latency(Clock::duration latency)
+  {
+    const double seconds = std::chrono::duration<double>(latency).count();
+    const auto& buckets = latency_buckets();
+    const auto bucket = static_cast<std::size_t>(
+      std::lower_bound(buckets.begin(), buckets.end(), seconds)
+      - buckets.begin());
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    ++_totals.send_latency_counts[bucket];
+    _totals.max_send_latency = std::max(_totals.max_send_latency, latency);
+    _totals.total_send_latency += latency;
+    _window.send_latency.add(seconds);
+  }
+
+//==============================================================================
+public: void record_dropped(std::size_t count = 1)
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _totals.messages_dropped += count;
+    _window.messages_dropped += count;
+  }
+
+//==============================================================================
+public: Totals totals()
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _totals;
+  }
+
+//==============================================================================
+/// Get everything recorded since the last time this was called
+public: Window take_window()
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    Window window = _window;
+    _window = Window();
+    return window;
+  }
+
+private:
+  Totals _totals;
+  Window _window;
+  std::mutex _mtx;
+};
+
+} // namespace rmf_websocket
+
+#endif // RMF_WEBSOCKET__UTILS_CLIENTMETRICS_HPP
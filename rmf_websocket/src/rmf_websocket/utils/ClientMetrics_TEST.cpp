@@ -0,0 +1,49 @@
+#define CATCH_CONFIG_MAIN
+#include <rmf_utils/catch.hpp>
+
+#include <chrono>
+#include "ClientMetrics.hpp"
+
+using namespace rmf_websocket;
+using namespace std::chrono_literals;
+
+TEST_CASE("ClientMetrics keeps totals and resets the window",
+  "[ClientMetrics]") {
+  ClientMetrics metrics;
+
+  metrics.record_queue_depth(3);
+  metrics.record_queue_depth(7);
+  metrics.record_frame(2, 100);
+  metrics.record_latency(5ms);
+  metrics.record_latency(2s);
+  metrics.record_dropped();
+
+  auto window = metrics.take_window();
+  REQUIRE(window.queue_depth.count == 2);
+  CHECK(window.queue_depth.min == Approx(3.0));
+  CHECK(window.queue_depth.max == Approx(7.0));
+  CHECK(window.queue_depth.mean() == Approx(5.0));
+  CHECK(window.send_latency.count == 2);
+  CHECK(window.send_latency.max == Approx(2.0));
+  CHECK(window.bytes_sent == 100);
+  CHECK(window.messages_dropped == 1);
+
+  // The window starts over while the totals keep going
+  metrics.record_frame(1, 50);
+  window = metrics.take_window();
+  CHECK(window.queue_depth.count == 0);
+  CHECK(window.bytes_sent == 50);
+
+  const auto totals = metrics.totals();
+  CHECK(totals.max_queue_depth == 7);
+  CHECK(totals.messages_sent == 3);
+  CHECK(totals.frames_sent == 2);
+  CHECK(totals.bytes_sent == 150);
+  CHECK(totals.messages_dropped == 1);
+  CHECK(totals.max_send_latency == 2s);
+
+  // 5ms lands in the (1ms, 10ms] bucket and 2s in the (1s, 10s] bucket
+  REQUIRE(totals.send_latency_counts.size() == 6);
+  CHECK(totals.send_latency_counts[1] == 1);
+  CHECK(totals.send_latency_counts[4] == 1);
+}
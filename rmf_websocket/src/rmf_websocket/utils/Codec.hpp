@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef RMF_WEBSOCKET__UTILS_CODEC_HPP
+#define RMF_WEBSOCKET__UTILS_CODEC_HPP
+
+#include <rmf_websocket/Encoding.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace rmf_websocket {
+
+//==============================================================================
+/// The websocket subprotocol that asks for an encoding. JSON is what a
+/// connection uses without a subprotocol, so it has none.
+inline const std::string& subprotocol_of(Encoding encoding)
+{
+  static const std::string none;
+  static const std::string cbor = "rmf.cbor";
+  static const std::string msgpack = "rmf.msgpack";
+
+  switch (encoding)
+  {
+    case Encoding::Cbor:
+      return cbor;
+    case Encoding::MessagePack:
+      return msgpack;
+    default:
+      return none;
+  }
+}
+
+//==============================================================================
+/// The encoding of a connection that agreed on this subprotocol, or
+/// std::nullopt if the subprotocol is not one of ours.
+inline std::optional<Encoding> encoding_of(const std::string& subprotocol)
+{
+  if (subprotocol.empty())
+    return Encoding::Json;
+
+  for (const auto encoding : {Encoding::Cbor, Encoding::MessagePack})
+  {
+    if (subprotocol == subprotocol_of(encoding))
+      return encoding;
+  }
+
+  return std::nullopt;
+}
+
+//==============================================================================
+/// True if messages of this encoding go in binary frames
+inline bool is_binary(Encoding encoding)
+{
+  return encoding != Encoding::Json;
+}
+
+//==============================================================================
+/// Serialize a message. The binary encodings are returned as raw bytes in a
+/// string, since that is what websocketpp sends.
+inline std::string encode(const nlohmann::json& msg, Encoding encoding)
+{
+  if (encoding == Encoding::Json)
+    return msg.dump();
+
+  std::string output;
+  if (encoding == Encoding::Cbor)
+    nlohmann::json::to_cbor(msg, output);
+  else
+    nlohmann::json::to_msgpack(msg, output);
+
+  return output;
+}
+
+//==============================================================================
+/// Deserialize a message. Like nlohmann::json::parse, this throws if the
+/// payload is malformed unless allow_exceptions is false, in which case a
+/// discarded value is returned.
+inline nlohmann::json decode(
+  const std::string& payload,
+  Encoding encoding,
+  bool allow_exceptions = true)
+{
+  switch (encoding)
+  {
+    case Encoding::Cbor:
+      return nlohmann::json::from_cbor(payload, true, allow_exceptions);
+    case Encoding::MessagePack:
+      return nlohmann::json::from_msgpack(payload, true, allow_exceptions);
+    default:
+      return nlohmann::json::parse(payload, nullptr, allow_exceptions);
+  }
+}
+
+//==============================================================================
+/// Write the header of an array of this many elements. The elements of a
+/// CBOR or MessagePack array simply follow its header, so already encoded
+/// messages can be joined into an array without encoding them again.
+inline void append_array_header(
+  std::string& output,
+  std::size_t size,
+  Encoding encoding)
+{
+  const auto append_big_endian = [&output](uint64_t value, std::size_t bytes)
+    {
+      for (std::size_t i = bytes; i > 0; --i)
+        output.push_back(static_cast<char>((value >> (8 * (i - 1))) & 0xFF));
+    };
+
+  if (encoding == Encoding::Cbor)
+  {
+    if (size < 24)
+    {
+      output.push_back(static_cast<char>(0x80 + size));
+    }
+    else if (size <= 0xFF)
+    {
+      output.push_back(static_cast<char>(0x98));
+      append_big_endian(size, 1);
+    }
+    else if (size <= 0xFFFF)
+    {
+      output.push_back(static_cast<char>(0x99));
+      append_big_endian(size, 2);
+    }
+    else
+    {
+      output.push_back(static_cast<char>(0x9A));
+      append_big_endian(size, 4);
+    }
+  }
+  else if (encoding == Encoding::MessagePack)
+  {
+    if (size < 16)
+    {
+      output.push_back(static_cast<char>(0x90 | size));
+    }
+    else if (size <= 0xFFFF)
+    {
+      output.push_back(static_cast<char>(0xDC));
+      append_big_endian(size, 2);
+    }
+    else
+    {
+      output.push_back(static_cast<char>(0xDD));
+      append_big_endian(size, 4);
+    }
+  }
+}
+
+//==============================================================================
+/// Join messages that are already encoded into {"type": "batch",
+/// "data": [...]} without parsing them back.
+inline std::string make_batch(
+  const std::vector<const std::string*>& messages,
+  Encoding encoding)
+{
+  std::size_t size = 32 + messages.size();
+  for (const auto* msg : messages)
+    size += msg->size();
+
+  std::string batch;
+  batch.reserve(size);
+  if (encoding == Encoding::Json)
+  {
+    batch += "{\"type\":\"batch\",\"data\":[";
+    for (std::size_t i = 0; i < messages.size(); ++i)
+    {
+      if (i > 0)
+        batch += ',';
+
+      batch += *messages[i];
+    }
+    batch += "]}";
+    return batch;
+  }
+
+  // Everything in front of the array is always the same, so it is encoded
+  // once from an object without the data.
+  static const std::string cbor_prefix = encode(
+    nlohmann::json{{"type", "batch"}}, Encoding::Cbor);
+  static const std::string msgpack_prefix = encode(
+    nlohmann::json{{"type", "batch"}}, Encoding::MessagePack);
+
+  // Both encodings keep the number of fields of a small map in the low bits
+  // of its first byte, so bump it from one field to two.
+  batch += encoding == Encoding::Cbor ? cbor_prefix : msgpack_prefix;
+  batch[0] = static_cast<char>(batch[0] + 1);
+  batch += encode("data", encoding);
+  append_array_header(batch, messages.size(), encoding);
+  for (const auto* msg : messages)
+    batch += *msg;
+
+  return batch;
+}
+
+} // namespace rmf_websocket
+
+#endif // RMF_WEBSOCKET__UTILS_CODEC_HPP
@@ -0,0 +1,81 @@
+#define CATCH_CONFIG_MAIN
+#include <rmf_utils/catch.hpp>
+
+#include <string>
+#include <vector>
+#include "Codec.hpp"
+
+using namespace rmf_websocket;
+
+const std::vector<Encoding> all_encodings = {
+  Encoding::Json, Encoding::Cbor, Encoding::MessagePack
+};
+
+nlohmann::json fleet_state(std::size_t i)
+{
+  return {
+    {"type", "fleet_state_update"},
+    {"data", {
+        {"name", "fleet_" + std::to_string(i)},
+        {"robots", {{"robot", {{"battery", 0.5}, {"seq", i}}}}}
+      }}
+  };
+}
+
+TEST_CASE("Messages survive every encoding", "[Codec]") {
+  const auto msg = fleet_state(3);
+  for (const auto encoding : all_encodings)
+  {
+    CAPTURE(static_cast<int>(encoding));
+    REQUIRE(decode(encode(msg, encoding), encoding) == msg);
+  }
+
+  REQUIRE(encode(msg, Encoding::Cbor).size() < msg.dump().size());
+  REQUIRE(encode(msg, Encoding::MessagePack).size() < msg.dump().size());
+}
+
+TEST_CASE("Subprotocols map back to their encodings", "[Codec]") {
+  for (const auto encoding : all_encodings)
+    REQUIRE(encoding_of(subprotocol_of(encoding)) == encoding);
+
+  REQUIRE(!encoding_of("graphql-ws").has_value());
+  REQUIRE(subprotocol_of(Encoding::Json).empty());
+  REQUIRE(!is_binary(Encoding::Json));
+  REQUIRE(is_binary(Encoding::Cbor));
+}
+
+TEST_CASE("Malformed payloads can be rejected without throwing", "[Codec]") {
+  for (const auto encoding : all_encodings)
+  {
+    CAPTURE(static_cast<int>(encoding));
+    const auto truncated = encode(fleet_state(1), encoding).substr(0, 5);
+    REQUIRE(decode(truncated, encoding, false).is_discarded());
+    REQUIRE_THROWS(decode(truncated, encoding));
+  }
+}
+
+TEST_CASE("Encoded messages are joined into a batch", "[Codec]") {
+  // Cover each size of array header
+  for (const std::size_t n : {1u, 15u, 16u, 23u, 24u, 255u, 256u, 70000u})
+  {
+    for (const auto encoding : all_encodings)
+    {
+      CAPTURE(n, static_cast<int>(encoding));
+      std::vector<std::string> encoded;
+      nlohmann::json expected = nlohmann::json::array();
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        expected.push_back(fleet_state(i));
+        encoded.push_back(encode(expected.back(), encoding));
+      }
+
+      std::vector<const std::string*> messages;
+      for (const auto& msg : encoded)
+        messages.push_back(&msg);
+
+      const auto batch = decode(make_batch(messages, encoding), encoding);
+      REQUIRE(batch["type"] == "batch");
+      REQUIRE(batch["data"] == expected);
+    }
+  }
+}
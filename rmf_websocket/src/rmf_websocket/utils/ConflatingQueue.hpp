@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef RMF_WEBSOCKET__UTILS_CONFLATINGQUEUE_HPP
+#define RMF_WEBSOCKET__UTILS_CONFLATINGQUEUE_HPP
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rmf_websocket {
+
+//==============================================================================
+/// Thread safe queue with a fixed capacity where items may be given a key. An
+/// item with a key replaces any item with the same key that is still waiting
+/// in the queue, and goes to the back of the queue. Items without a key are
+/// always kept, unless the queue is full, in which case the oldest item is
+/// dropped.
+template<typename T>
+class ConflatingQueue
+{
+public: struct Item
+  {
+    std::optional<std::string> key;
+    T value;
+  };
+
+//==============================================================================
+public: ConflatingQueue(std::size_t capacity)
+  : _capacity(capacity)
+  {
+    // Do nothing
+  }
+
+//==============================================================================
+/// Change the capacity of the queue, dropping the oldest items if needed
+public: void resize(std::size_t capacity)
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _capacity = capacity;
+    _trim();
+  }
+
+//==============================================================================
+/// Push an item onto the queue. Returns false if the oldest item had to be
+/// dropped to make room for it.
+public: bool push(Item item)
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    if (item.key.has_value())
+    {
+      const auto it = _keyed.find(*item.key);
+      if (it != _keyed.end())
+      {
+        _items.erase(it->second);
+        _keyed.erase(it);
+      }
+    }
+
+    _items.push_back(std::move(item));
+    if (_items.back().key.has_value())
+      _keyed[*_items.back().key] = std::prev(_items.end());
+
+    return !_trim();
+  }
+
+//==============================================================================
+public: std::size_t capacity()
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _capacity;
+  }
+
+//==============================================================================
+public: bool empty()
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _items.empty();
+  }
+
+//==============================================================================
+public: std::size_t size()
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _items.size();
+  }
+
+//==============================================================================
+/// Remove up to the given number of items from the front of the queue and
+/// return them, oldest first.
+public: std::vector<Item> take_front(std::size_t count)
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    std::vector<Item> taken;
+    while (!_items.empty() && taken.size() < count)
+    {
+      if (_items.front().key.has_value())
+        _keyed.erase(*_items.front().key);
+
+      taken.push_back(std::move(_items.front()));
+      _items.pop_front();
+    }
+
+    return taken;
+  }
+
+//==============================================================================
+/// Put items that were taken from the front back where they were, e.g.
+/// because they could not be sent. Items whose key has been pushed again in
+/// the meantime are dropped, since a newer item has replaced them.
+public: void restore_front(std::vector<Item> items)
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    for (auto it = items.rbegin(); it != items.rend(); ++it)
+    {
+      if (it->key.has_value())
+      {
+        if (_keyed.count(*it->key) > 0)
+          continue;
+
+        _items.push_front(std::move(*it));
+        _keyed[*_items.front().key] = _items.begin();
+      }
+      else
+      {
+        _items.push_front(std::move(*it));
+      }
+    }
+
+    _trim();
+  }
+
+//==============================================================================
+// Returns true if anything was dropped
+private: bool _trim()
+  {
+    bool dropped = false;
+    while (_items.size() > _capacity)
+    {
+      if (_items.front().key.has_value())
+        _keyed.erase(*_items.front().key);
+
+      _items.pop_front();
+      dropped = true;
+    }
+
+    return dropped;
+  }
+
+private:
+  std::size_t _capacity;
+  std::list<Item> _items;
+  std::unordered_map<std::string, typename std::list<Item>::iterator> _keyed;
+  std::mutex _mtx;
+};
+
+} // namespace rmf_websocket
+
+#endif // RMF_WEBSOCKET__UTILS_CONFLATINGQUEUE_HPP
@@ -0,0 +1,68 @@
+#define CATCH_CONFIG_MAIN
+#include <rmf_utils/catch.hpp>
+
+#include <string>
+#include <vector>
+#include "ConflatingQueue.hpp"
+
+using namespace rmf_websocket;
+
+using Queue = ConflatingQueue<int>;
+
+std::vector<int> values(const std::vector<Queue::Item>& items)
+{
+  std::vector<int> output;
+  for (const auto& item : items)
+    output.push_back(item.value);
+
+  return output;
+}
+
+TEST_CASE("ConflatingQueue keeps the latest item for each key",
+  "[ConflatingQueue]") {
+  Queue queue(10);
+
+  queue.push({"fleet_a", 1});
+  queue.push({std::nullopt, 2});
+  queue.push({"fleet_b", 3});
+  queue.push({"fleet_a", 4});
+  queue.push({std::nullopt, 5});
+
+  REQUIRE(queue.size() == 4);
+  REQUIRE(values(queue.take_front(10)) == std::vector<int>({2, 3, 4, 5}));
+  REQUIRE(queue.empty());
+}
+
+TEST_CASE("ConflatingQueue drops the oldest items when full",
+  "[ConflatingQueue]") {
+  Queue queue(2);
+
+  REQUIRE(queue.push({"a", 1}));
+  REQUIRE(queue.push({std::nullopt, 2}));
+  REQUIRE(!queue.push({std::nullopt, 3}));
+
+  // The dropped item no longer replaces anything
+  REQUIRE(!queue.push({"a", 4}));
+  REQUIRE(values(queue.take_front(10)) == std::vector<int>({3, 4}));
+
+  queue.resize(5);
+  REQUIRE(queue.capacity() == 5);
+}
+
+TEST_CASE("ConflatingQueue restores items that were taken",
+  "[ConflatingQueue]") {
+  Queue queue(10);
+
+  queue.push({"a", 1});
+  queue.push({std::nullopt, 2});
+  queue.push({"b", 3});
+
+  auto taken = queue.take_front(2);
+  REQUIRE(values(taken) == std::vector<int>({1, 2}));
+
+  // A newer item for "a" arrived while the taken ones were being sent
+  queue.push({"a", 4});
+  queue.restore_front(std::move(taken));
+
+  REQUIRE(values(queue.take_front(10)) == std::vector<int>({2, 3, 4}));
+}
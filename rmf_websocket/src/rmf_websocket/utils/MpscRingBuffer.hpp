@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef RMF_WEBSOCKET__UTILS_MPSCRINGBUFFER_HPP
+#define RMF_WEBSOCKET__UTILS_MPSCRINGBUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace rmf_websocket {
+
+//==============================================================================
+/// Lock free ring buffer with a fixed capacity that any number of threads may
+/// push into while a single thread pops from it. Unlike RingBuffer, pushing
+/// into a full buffer fails instead of overwriting the oldest item, and items
+/// are moved out when they are popped. The capacity is rounded up to a power
+/// of two.
+template<typename T>
+class MpscRingBuffer
+{
+public: MpscRingBuffer(std::size_t capacity)
+  : _mask(_round_up(capacity) - 1),
+    _cells(new Cell[_mask + 1])
+  {
+    for (std::size_t i = 0; i <= _mask; ++i)
+      _cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+public: MpscRingBuffer(const MpscRingBuffer&) = delete;
+public: MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+//==============================================================================
+/// Push an item into the buffer. This may be called from any thread. Returns
+/// false, leaving the item untouched, if the buffer is full.
+public: bool try_push(T& item)
+  {
+    Cell* cell = nullptr;
+    std::size_t pos = _enqueue.load(std::memory_order_relaxed);
+    while (true)
+    {
+      cell = &_cells[pos & _mask];
+      const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+      const auto diff =
+        static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+      if (diff == 0)
+      {
+        if (_enqueue.compare_exchange_weak(
+            pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0)
+      {
+        // The consumer has not freed up this cell yet
+        return false;
+      }
+      else
+      {
+        pos = _enqueue.load(std::memory_order_relaxed);
+      }
+    }
+
+    cell->value = std::move(item);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+//==============================================================================
+/// Pop the oldest item from the buffer. This must only be called by one
+/// thread at a time. An item that is halfway through being pushed will be
+/// available to a later pop.
+public: std::optional<T> pop()
+  {
+    Cell& cell = _cells[_dequeue & _mask];
+    const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+    if (seq != _dequeue + 1)
+      return std::nullopt;
+
+    std::optional<T> item = std::move(cell.value);
+    cell.value = T();
+    cell.sequence.store(_dequeue + _mask + 1, std::memory_order_release);
+    ++_dequeue;
+    return item;
+  }
+
+//==============================================================================
+public: std::size_t capacity() const
+  {
+    return _mask + 1;
+  }
+
+private: static std::size_t _round_up(std::size_t capacity)
+  {
+    std::size_t n = 2;
+    while (n < capacity)
+      n *= 2;
+
+    return n;
+  }
+
+private:
+  struct Cell
+  {
+    std::atomic<std::size_t> sequence;
+    T value = T();
+  };
+
+  const std::size_t _mask;
+  std::unique_ptr<Cell[]> _cells;
+
+  // Producers and the consumer advance these separately, so keep them from
+  // sharing a cache line.
+  alignas(64) std::atomic<std::size_t> _enqueue{0};
+  alignas(64) std::size_t _dequeue = 0;
+};
+
+} // namespace rmf_websocket
+
+#endif // RMF_WEBSOCKET__UTILS_MPSCRINGBUFFER_HPP
@@ -1,11 +1,14 @@
 #ifndef RMF_WEBSOCKET__UTILS_RINGBUFFER_HPP
 #define RMF_WEBSOCKET__UTILS_RINGBUFFER_HPP
 
+#include <algorithm>
 #include <condition_variable>
 #include <cstddef>
 #include <optional>
 #include <boost/circular_buffer.hpp>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 namespace rmf_websocket {
 
@@ -65,12 +68,31 @@ public: std::optional<T> pop_item()
       return std::nullopt;
     }
 
-    T item = _vec.front();
+    T item = std::move(_vec.front());
     _vec.pop_front();
 
     return item;
   }
 
+//==============================================================================
+/// Get copies of up to the given number of items from the front of the queue,
+/// oldest first, without removing them.
+public: std::vector<T> front_items(std::size_t count)
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    const std::size_t n = std::min(count, _vec.size());
+    return std::vector<T>(_vec.begin(), _vec.begin() + n);
+  }
+
+//==============================================================================
+/// Remove up to the given number of items from the front of the queue.
+public: void pop_items(std::size_t count)
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    const std::size_t n = std::min(count, _vec.size());
+    _vec.erase_begin(n);
+  }
+
 private:
   boost::circular_buffer<T> _vec;
   std::mutex _mtx;
@@ -1,7 +1,14 @@
 #define CATCH_CONFIG_MAIN
 #include <rmf_utils/catch.hpp>
 
+#include <chrono>
 #include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MpscRingBuffer.hpp"
 #include "RingBuffer.hpp"
 
 using namespace rmf_websocket;
@@ -34,3 +41,157 @@ TEST_CASE("RingBuffer overwrites old values in correct order", "[RingBuffer]") {
   REQUIRE(buffer.pop_item().value() == 3);
   REQUIRE(buffer.pop_item() == std::nullopt);
 }
+
+TEST_CASE("RingBuffer hands back shared items without copying them",
+  "[RingBuffer]") {
+  RingBuffer<std::shared_ptr<const std::string>> buffer(2);
+
+  const auto message = std::make_shared<const std::string>("message");
+  buffer.push(message);
+
+  REQUIRE(buffer.front().value() == message);
+  REQUIRE(buffer.pop_item().value() == message);
+  REQUIRE(buffer.pop_item() == std::nullopt);
+}
+
+TEST_CASE("RingBuffer peeks and pops several items at once", "[RingBuffer]") {
+  RingBuffer<int> buffer(3);
+
+  REQUIRE(buffer.front_items(2).empty());
+
+  buffer.push(1);
+  buffer.push(2);
+  buffer.push(3);
+  REQUIRE(buffer.front_items(2) == std::vector<int>({1, 2}));
+  REQUIRE(buffer.front_items(5) == std::vector<int>({1, 2, 3}));
+
+  buffer.pop_items(2);
+  REQUIRE(buffer.pop_item().value() == 3);
+
+  buffer.pop_items(2);
+  REQUIRE(buffer.empty());
+}
+
+TEST_CASE("MpscRingBuffer pops items in order and refuses when full",
+  "[MpscRingBuffer]") {
+  MpscRingBuffer<std::unique_ptr<int>> buffer(3);
+  REQUIRE(buffer.capacity() == 4);
+  REQUIRE_FALSE(buffer.pop().has_value());
+
+  for (int i = 0; i < 4; ++i)
+  {
+    auto item = std::make_unique<int>(i);
+    REQUIRE(buffer.try_push(item));
+    REQUIRE(item == nullptr);
+  }
+
+  auto extra = std::make_unique<int>(4);
+  REQUIRE_FALSE(buffer.try_push(extra));
+  REQUIRE(extra != nullptr);
+
+  for (int i = 0; i < 4; ++i)
+    REQUIRE(*buffer.pop().value() == i);
+
+  REQUIRE_FALSE(buffer.pop().has_value());
+  REQUIRE(buffer.try_push(extra));
+  REQUIRE(*buffer.pop().value() == 4);
+}
+
+namespace {
+//==============================================================================
+struct Tagged
+{
+  std::size_t producer = 0;
+  std::size_t index = 0;
+};
+
+//==============================================================================
+/// Have several threads push into a queue while this thread pops everything,
+/// and return how long that took.
+template<typename Push, typename Pop>
+std::chrono::nanoseconds run_producers(
+  std::size_t num_producers,
+  std::size_t per_producer,
+  Push push,
+  Pop pop)
+{
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> producers;
+  for (std::size_t p = 0; p < num_producers; ++p)
+  {
+    producers.emplace_back([&push, p, per_producer]()
+      {
+        for (std::size_t i = 0; i < per_producer; ++i)
+          push(Tagged{p, i});
+      });
+  }
+
+  std::size_t received = 0;
+  while (received < num_producers * per_producer)
+  {
+    if (pop())
+      ++received;
+    else
+      std::this_thread::yield();
+  }
+
+  for (auto& t : producers)
+    t.join();
+
+  return std::chrono::steady_clock::now() - start;
+}
+} // anonymous namespace
+
+TEST_CASE("MpscRingBuffer keeps the order of each producer",
+  "[MpscRingBuffer]") {
+  constexpr std::size_t num_producers = 4;
+  constexpr std::size_t per_producer = 20000;
+  MpscRingBuffer<Tagged> buffer(64);
+  std::vector<std::size_t> next(num_producers, 0);
+
+  run_producers(num_producers, per_producer,
+    [&](Tagged item)
+    {
+      while (!buffer.try_push(item))
+        std::this_thread::yield();
+    },
+    [&]()
+    {
+      const auto item = buffer.pop();
+      if (!item.has_value())
+        return false;
+
+      REQUIRE(item->index == next[item->producer]);
+      ++next[item->producer];
+      return true;
+    });
+
+  for (const auto n : next)
+    REQUIRE(n == per_producer);
+}
+
+TEST_CASE("Benchmark RingBuffer against MpscRingBuffer",
+  "[.][benchmark]") {
+  constexpr std::size_t num_producers = 4;
+  constexpr std::size_t per_producer = 250000;
+
+  RingBuffer<Tagged> locked(num_producers * per_producer);
+  const auto locked_time = run_producers(num_producers, per_producer,
+    [&](Tagged item) { locked.push(item); },
+    [&]() { return locked.pop_item().has_value(); });
+
+  MpscRingBuffer<Tagged> lock_free(1024);
+  const auto lock_free_time = run_producers(num_producers, per_producer,
+    [&](Tagged item)
+    {
+      while (!lock_free.try_push(item))
+        std::this_thread::yield();
+    },
+    [&]() { return lock_free.pop().has_value(); });
+
+  using ms = std::chrono::duration<double, std::milli>;
+  std::cout << num_producers << " producers x " << per_producer
+            << " items\n  RingBuffer:     " << ms(locked_time).count()
+            << " ms\n  MpscRingBuffer: " << ms(lock_free_time).count()
+            << " ms" << std::endl;
+}